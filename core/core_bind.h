@@ -107,6 +107,7 @@ public:
 		FLAG_SAVE_BIG_ENDIAN = 16,
 		FLAG_COMPRESS = 32,
 		FLAG_REPLACE_SUBRESOURCE_PATHS = 64,
+		FLAG_ALIGN_PACKED_ARRAYS = 128,
 	};
 
 	static ResourceSaver *get_singleton() { return singleton; }
@@ -0,0 +1,217 @@
+/**************************************************************************/
+/*  async_file_reader.cpp                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "async_file_reader.h"
+
+void AsyncFileReader::_complete(Request *p_request, Error p_error) {
+	p_request->error = p_error;
+	p_request->file.unref();
+
+	if (p_request->callback) {
+		p_request->callback(p_request->userdata, p_error, p_request->read);
+		memdelete(p_request);
+
+		MutexLock lock(mutex);
+		pending_count--;
+		completed_cond.notify_all();
+	} else {
+		MutexLock lock(mutex);
+		p_request->completed = true;
+		pending_count--;
+		completed_cond.notify_all();
+	}
+}
+
+void AsyncFileReader::_wait_for_pending_reads() {
+	MutexLock lock(mutex);
+	while (pending_count > 0) {
+		completed_cond.wait(lock);
+	}
+}
+
+void AsyncFileReader::_read(Request *p_request) {
+	uint64_t read;
+	if (p_request->file->has_thread_safe_reads()) {
+		read = p_request->file->get_buffer_at(p_request->dst, p_request->position, p_request->length);
+	} else {
+		MutexLock lock(unsafe_read_mutex);
+		read = p_request->file->get_buffer_at(p_request->dst, p_request->position, p_request->length);
+	}
+
+	// The length is clamped to the end of the file, so reading less is an error.
+	if (read > p_request->length) {
+		p_request->read = 0;
+		_complete(p_request, ERR_FILE_CANT_READ);
+	} else {
+		p_request->read = read;
+		_complete(p_request, read == p_request->length ? OK : ERR_FILE_CANT_READ);
+	}
+}
+
+void AsyncFileReader::_thread_function(void *p_self) {
+	AsyncFileReader *self = (AsyncFileReader *)p_self;
+
+	while (true) {
+		Request *request = nullptr;
+		{
+			MutexLock lock(self->mutex);
+			while (self->queue_head == self->queue.size() && !self->exiting) {
+				self->queue_cond.wait(lock);
+			}
+			if (self->queue_head == self->queue.size()) {
+				break; // Exiting, and everything was read.
+			}
+
+			request = self->queue[self->queue_head++];
+			if (self->queue_head == self->queue.size()) {
+				self->queue.clear();
+				self->queue_head = 0;
+			}
+		}
+
+		self->_read(request);
+	}
+}
+
+AsyncFileReader *AsyncFileReader::create() {
+	if (create_func) {
+		return create_func();
+	}
+	return memnew(AsyncFileReader);
+}
+
+AsyncFileReader::ReadID AsyncFileReader::read(const Ref<FileAccess> &p_file, uint64_t p_position, uint8_t *p_dst, uint64_t p_length, FileAccess::AsyncReadCallback p_callback, void *p_userdata) {
+	ERR_FAIL_COND_V_MSG(p_file.is_null() || !p_file->is_open(), 0, "File must be opened before use.");
+	ERR_FAIL_COND_V(!p_dst && p_length > 0, 0);
+
+	Request *request = memnew(Request);
+	request->file = p_file;
+	request->position = p_position;
+	request->dst = p_dst;
+	request->callback = p_callback;
+	request->userdata = p_userdata;
+
+	// Never read past the end, native reads could read what follows the file in a pack otherwise.
+	const uint64_t file_length = p_file->get_length();
+	request->length = p_position < file_length ? MIN(p_length, file_length - p_position) : 0;
+
+	ReadID id;
+	{
+		MutexLock lock(mutex);
+		id = ++last_id;
+		request->id = id;
+		if (!p_callback) {
+			requests.insert(id, request);
+		}
+		pending_count++;
+	}
+
+	// The request may be gone once submitted, if it has a callback.
+	if (request->length == 0) {
+		_complete(request, OK);
+		return id;
+	}
+
+#ifdef THREADS_ENABLED
+	request->fd = p_file->get_native_fd(request->fd_offset);
+	if (request->fd >= 0 && _submit_native(request)) {
+		return id;
+	}
+
+	MutexLock lock(mutex);
+	if (threads.is_empty()) {
+		for (uint32_t i = 0; i < MAX(io_thread_count, 1u); i++) {
+			Thread *thread = memnew(Thread);
+			thread->start(&AsyncFileReader::_thread_function, this);
+			threads.push_back(thread);
+		}
+	}
+	queue.push_back(request);
+	queue_cond.notify_one();
+#else
+	_read(request);
+#endif
+
+	return id;
+}
+
+Error AsyncFileReader::wait(ReadID p_id, uint64_t *r_read) {
+	Request *request = nullptr;
+	{
+		MutexLock lock(mutex);
+		Request **request_ptr = requests.getptr(p_id);
+		ERR_FAIL_NULL_V_MSG(request_ptr, ERR_INVALID_PARAMETER, vformat("Invalid asynchronous read %d, it may have been awaited already, or have a callback.", p_id));
+		request = *request_ptr;
+		while (!request->completed) {
+			completed_cond.wait(lock);
+		}
+		requests.erase(p_id);
+	}
+
+	if (r_read) {
+		*r_read = request->read;
+	}
+	const Error err = request->error;
+	memdelete(request);
+	return err;
+}
+
+bool AsyncFileReader::is_completed(ReadID p_id) {
+	MutexLock lock(mutex);
+	Request **request_ptr = requests.getptr(p_id);
+	ERR_FAIL_NULL_V_MSG(request_ptr, false, vformat("Invalid asynchronous read %d, it may have been awaited already, or have a callback.", p_id));
+	return (*request_ptr)->completed;
+}
+
+AsyncFileReader::AsyncFileReader() {
+	singleton = this;
+}
+
+AsyncFileReader::~AsyncFileReader() {
+	// Native backends complete their reads before getting here.
+	_wait_for_pending_reads();
+	{
+		MutexLock lock(mutex);
+		exiting = true;
+		queue_cond.notify_all();
+	}
+	for (Thread *thread : threads) {
+		thread->wait_to_finish();
+		memdelete(thread);
+	}
+
+	if (!requests.is_empty()) {
+		WARN_PRINT(vformat("%d asynchronous reads were never awaited.", requests.size()));
+		for (KeyValue<ReadID, Request *> &E : requests) {
+			memdelete(E.value);
+		}
+	}
+	singleton = nullptr;
+}
@@ -0,0 +1,122 @@
+/**************************************************************************/
+/*  async_file_reader.h                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/io/file_access.h"
+#include "core/os/condition_variable.h"
+#include "core/os/mutex.h"
+#include "core/os/thread.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+
+// Reads parts of files asynchronously, so many reads can be in flight without a blocked thread for each of them.
+// Platforms can register a backend with make_default(), reading natively through file descriptors (see FileAccess::get_native_fd()).
+// Other reads are done by a few I/O threads, with FileAccess::get_buffer_at().
+// Every read must be waited for with wait(), unless it has a callback, which is then called from an I/O thread once it completes.
+// NOTE: The destination buffer must stay valid until the read completes. Files without thread-safe reads
+// (see FileAccess::has_thread_safe_reads()) must not be used otherwise until their reads complete.
+class AsyncFileReader {
+public:
+	typedef FileAccess::AsyncReadID ReadID;
+
+protected:
+	struct Request {
+		ReadID id = 0;
+		Ref<FileAccess> file;
+		uint64_t position = 0;
+		uint8_t *dst = nullptr;
+		uint64_t length = 0;
+		FileAccess::AsyncReadCallback callback = nullptr;
+		void *userdata = nullptr;
+
+		// For native backends.
+		int fd = -1;
+		uint64_t fd_offset = 0;
+
+		uint64_t read = 0;
+		Error error = OK;
+		bool completed = false;
+	};
+
+	// Takes the request if the backend can read it natively, and calls _complete() once done, from any thread.
+	virtual bool _submit_native(Request *p_request) { return false; }
+	void _complete(Request *p_request, Error p_error);
+	// Backends must call it before they are destroyed.
+	void _wait_for_pending_reads();
+
+private:
+	typedef AsyncFileReader *(*CreateFunc)();
+	static inline CreateFunc create_func = nullptr;
+	template <typename T>
+	static AsyncFileReader *_create_builtin() {
+		return memnew(T);
+	}
+
+	static inline AsyncFileReader *singleton = nullptr;
+
+	BinaryMutex mutex;
+	ConditionVariable completed_cond;
+	HashMap<ReadID, Request *> requests;
+	ReadID last_id = 0;
+	uint32_t pending_count = 0;
+
+	// Fallback I/O threads, started on demand.
+	LocalVector<Thread *> threads;
+	LocalVector<Request *> queue;
+	uint32_t queue_head = 0;
+	ConditionVariable queue_cond;
+	bool exiting = false;
+	// Files without thread-safe reads are read one at a time.
+	BinaryMutex unsafe_read_mutex;
+
+	static void _thread_function(void *p_self);
+	void _read(Request *p_request);
+
+public:
+	static inline uint32_t io_thread_count = 4;
+
+	static AsyncFileReader *get_singleton() { return singleton; }
+	static AsyncFileReader *create();
+
+	template <typename T>
+	static void make_default() {
+		create_func = _create_builtin<T>;
+	}
+
+	// Reads p_length bytes from p_position in the file to p_dst. Returns 0 on failure.
+	ReadID read(const Ref<FileAccess> &p_file, uint64_t p_position, uint8_t *p_dst, uint64_t p_length, FileAccess::AsyncReadCallback p_callback = nullptr, void *p_userdata = nullptr);
+	// Returns the error of the read, and the number of bytes read, which is lower than requested at the end of the file.
+	Error wait(ReadID p_id, uint64_t *r_read = nullptr);
+	bool is_completed(ReadID p_id);
+
+	AsyncFileReader();
+	virtual ~AsyncFileReader();
+};
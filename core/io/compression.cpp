@@ -40,11 +40,77 @@
 #include <brotli/decode.h>
 #endif
 
-// Caches for zstd.
-static BinaryMutex mutex;
-static ZSTD_DCtx *current_zstd_d_ctx = nullptr;
-static bool current_zstd_long_distance_matching;
-static int current_zstd_window_log_size;
+// Caches for zstd, kept per thread so streams can be decompressed in parallel.
+struct ZstdThreadContext {
+	ZSTD_DCtx *d_ctx = nullptr;
+	bool long_distance_matching = false;
+	int window_log_size = 0;
+
+	ZSTD_CCtx *c_ctx = nullptr;
+
+	// Digested dictionaries. The source is kept referenced, so it can be compared by address.
+	Vector<uint8_t> c_dictionary;
+	ZSTD_CDict *c_dict = nullptr;
+	int c_dict_level = 0;
+	Vector<uint8_t> d_dictionary;
+	ZSTD_DDict *d_dict = nullptr;
+
+	ZSTD_DCtx *get_d_ctx() {
+		if (!d_ctx || long_distance_matching != Compression::zstd_long_distance_matching || window_log_size != Compression::zstd_window_log_size) {
+			if (d_ctx) {
+				ZSTD_freeDCtx(d_ctx);
+			}
+
+			d_ctx = ZSTD_createDCtx();
+			if (Compression::zstd_long_distance_matching) {
+				ZSTD_DCtx_setParameter(d_ctx, ZSTD_d_windowLogMax, Compression::zstd_window_log_size);
+			}
+			long_distance_matching = Compression::zstd_long_distance_matching;
+			window_log_size = Compression::zstd_window_log_size;
+		}
+		return d_ctx;
+	}
+
+	ZSTD_CDict *get_c_dict(const Vector<uint8_t> &p_dictionary) {
+		if (!c_dict || c_dictionary.ptr() != p_dictionary.ptr() || c_dictionary.size() != p_dictionary.size() || c_dict_level != Compression::zstd_level) {
+			if (c_dict) {
+				ZSTD_freeCDict(c_dict);
+			}
+			c_dictionary = p_dictionary;
+			c_dict_level = Compression::zstd_level;
+			c_dict = ZSTD_createCDict(c_dictionary.ptr(), c_dictionary.size(), c_dict_level);
+		}
+		return c_dict;
+	}
+
+	ZSTD_DDict *get_d_dict(const Vector<uint8_t> &p_dictionary) {
+		if (!d_dict || d_dictionary.ptr() != p_dictionary.ptr() || d_dictionary.size() != p_dictionary.size()) {
+			if (d_dict) {
+				ZSTD_freeDDict(d_dict);
+			}
+			d_dictionary = p_dictionary;
+			d_dict = ZSTD_createDDict(d_dictionary.ptr(), d_dictionary.size());
+		}
+		return d_dict;
+	}
+
+	~ZstdThreadContext() {
+		if (d_ctx) {
+			ZSTD_freeDCtx(d_ctx);
+		}
+		if (c_ctx) {
+			ZSTD_freeCCtx(c_ctx);
+		}
+		if (c_dict) {
+			ZSTD_freeCDict(c_dict);
+		}
+		if (d_dict) {
+			ZSTD_freeDDict(d_dict);
+		}
+	}
+};
+
+static thread_local ZstdThreadContext zstd_thread_context;
 
 int64_t Compression::compress(uint8_t *p_dst, const uint8_t *p_src, int64_t p_src_size, Mode p_mode) {
 	switch (p_mode) {
@@ -197,22 +263,7 @@ int64_t Compression::decompress(uint8_t *p_dst, int64_t p_dst_max_size, const ui
 			return total;
 		} break;
 		case MODE_ZSTD: {
-			MutexLock lock(mutex);
-
-			if (!current_zstd_d_ctx || current_zstd_long_distance_matching != zstd_long_distance_matching || current_zstd_window_log_size != zstd_window_log_size) {
-				if (current_zstd_d_ctx) {
-					ZSTD_freeDCtx(current_zstd_d_ctx);
-				}
-
-				current_zstd_d_ctx = ZSTD_createDCtx();
-				if (zstd_long_distance_matching) {
-					ZSTD_DCtx_setParameter(current_zstd_d_ctx, ZSTD_d_windowLogMax, zstd_window_log_size);
-				}
-				current_zstd_long_distance_matching = zstd_long_distance_matching;
-				current_zstd_window_log_size = zstd_window_log_size;
-			}
-
-			size_t ret = ZSTD_decompressDCtx(current_zstd_d_ctx, p_dst, p_dst_max_size, p_src, p_src_size);
+			size_t ret = ZSTD_decompressDCtx(zstd_thread_context.get_d_ctx(), p_dst, p_dst_max_size, p_src, p_src_size);
 			return (int64_t)ret;
 		} break;
 	}
@@ -220,6 +271,37 @@ int64_t Compression::decompress(uint8_t *p_dst, int64_t p_dst_max_size, const ui
 	ERR_FAIL_V(-1);
 }
 
+int64_t Compression::compress_zstd_with_dictionary(uint8_t *p_dst, const uint8_t *p_src, int64_t p_src_size, const Vector<uint8_t> &p_dictionary) {
+	if (p_dictionary.is_empty()) {
+		return compress(p_dst, p_src, p_src_size, MODE_ZSTD);
+	}
+
+	ZstdThreadContext &context = zstd_thread_context;
+	ZSTD_CDict *c_dict = context.get_c_dict(p_dictionary);
+	ERR_FAIL_NULL_V_MSG(c_dict, -1, "Invalid Zstandard dictionary.");
+	if (!context.c_ctx) {
+		context.c_ctx = ZSTD_createCCtx();
+	}
+
+	const size_t ret = ZSTD_compress_usingCDict(context.c_ctx, p_dst, ZSTD_compressBound(p_src_size), p_src, p_src_size, c_dict);
+	ERR_FAIL_COND_V_MSG(ZSTD_isError(ret), -1, vformat("Zstandard compression failed: %s.", ZSTD_getErrorName(ret)));
+	return (int64_t)ret;
+}
+
+int64_t Compression::decompress_zstd_with_dictionary(uint8_t *p_dst, int64_t p_dst_max_size, const uint8_t *p_src, int64_t p_src_size, const Vector<uint8_t> &p_dictionary) {
+	if (p_dictionary.is_empty()) {
+		return decompress(p_dst, p_dst_max_size, p_src, p_src_size, MODE_ZSTD);
+	}
+
+	ZstdThreadContext &context = zstd_thread_context;
+	ZSTD_DDict *d_dict = context.get_d_dict(p_dictionary);
+	ERR_FAIL_NULL_V_MSG(d_dict, -1, "Invalid Zstandard dictionary.");
+
+	const size_t ret = ZSTD_decompress_usingDDict(context.get_d_ctx(), p_dst, p_dst_max_size, p_src, p_src_size, d_dict);
+	ERR_FAIL_COND_V_MSG(ZSTD_isError(ret), -1, vformat("Zstandard decompression failed: %s.", ZSTD_getErrorName(ret)));
+	return (int64_t)ret;
+}
+
 /**
 	This will handle both Gzip and Deflate streams. It will automatically allocate the output buffer into the provided p_dst_vect Vector.
 	This is required for compressed data whose final uncompressed size is unknown, as is the case for HTTP response bodies.
@@ -56,4 +56,9 @@ public:
 	static int64_t get_max_compressed_buffer_size(int64_t p_src_size, Mode p_mode = MODE_ZSTD);
 	static int64_t decompress(uint8_t *p_dst, int64_t p_dst_max_size, const uint8_t *p_src, int64_t p_src_size, Mode p_mode = MODE_ZSTD);
 	static int decompress_dynamic(Vector<uint8_t> *p_dst_vect, int64_t p_max_dst_size, const uint8_t *p_src, int64_t p_src_size, Mode p_mode);
+
+	// Zstandard with a shared dictionary, either trained with `zstd --train` or raw content similar to the data.
+	// Data must be decompressed with the same dictionary it was compressed with. An empty dictionary disables it.
+	static int64_t compress_zstd_with_dictionary(uint8_t *p_dst, const uint8_t *p_src, int64_t p_src_size, const Vector<uint8_t> &p_dictionary);
+	static int64_t decompress_zstd_with_dictionary(uint8_t *p_dst, int64_t p_dst_max_size, const uint8_t *p_src, int64_t p_src_size, const Vector<uint8_t> &p_dictionary);
 };
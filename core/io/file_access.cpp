@@ -33,6 +33,7 @@
 
 #include "core/config/project_settings.h"
 #include "core/crypto/crypto_core.h"
+#include "core/io/async_file_reader.h"
 #include "core/io/file_access_compressed.h"
 #include "core/io/file_access_encrypted.h"
 #include "core/io/file_access_pack.h"
@@ -563,6 +564,29 @@ String FileAccess::get_as_text() const {
 	return text;
 }
 
+uint64_t FileAccess::get_buffer_at(uint8_t *p_dst, uint64_t p_position, uint64_t p_length) const {
+	const uint64_t original_pos = get_position();
+	const_cast<FileAccess *>(this)->seek(p_position);
+	const uint64_t read = get_buffer(p_dst, p_length);
+	const_cast<FileAccess *>(this)->seek(original_pos);
+	return read;
+}
+
+FileAccess::AsyncReadID FileAccess::read_async(uint64_t p_position, uint8_t *p_dst, uint64_t p_length, AsyncReadCallback p_callback, void *p_userdata) {
+	ERR_FAIL_NULL_V(AsyncFileReader::get_singleton(), 0);
+	return AsyncFileReader::get_singleton()->read(Ref<FileAccess>(this), p_position, p_dst, p_length, p_callback, p_userdata);
+}
+
+Error FileAccess::wait_for_async_read(AsyncReadID p_id, uint64_t *r_read) {
+	ERR_FAIL_NULL_V(AsyncFileReader::get_singleton(), ERR_UNCONFIGURED);
+	return AsyncFileReader::get_singleton()->wait(p_id, r_read);
+}
+
+bool FileAccess::is_async_read_completed(AsyncReadID p_id) {
+	ERR_FAIL_NULL_V(AsyncFileReader::get_singleton(), false);
+	return AsyncFileReader::get_singleton()->is_completed(p_id);
+}
+
 Vector<uint8_t> FileAccess::get_buffer(int64_t p_length) const {
 	Vector<uint8_t> data;
 
@@ -193,6 +193,11 @@ public:
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const = 0; ///< get an array of bytes, needs to be overwritten by children.
 	Vector<uint8_t> get_buffer(int64_t p_length) const;
+	virtual Span<uint8_t> get_buffer_view(uint64_t p_length) const { return Span<uint8_t>(); } ///< get an array of bytes without copying them, only for memory mapped files. Returns an empty view and doesn't move the position when unsupported.
+	virtual uint8_t *get_persistent_buffer(uint64_t p_length) const { return nullptr; } ///< like get_buffer_view(), but the bytes stay valid after closing the file and writes to them are private. Only for files in memory mapped packs, returns nullptr and doesn't move the position otherwise.
+	virtual uint64_t get_buffer_at(uint8_t *p_dst, uint64_t p_position, uint64_t p_length) const; ///< get an array of bytes at a given position, without moving the cursor.
+	virtual bool has_thread_safe_reads() const { return false; } ///< true when get_buffer_at() can be called from several threads at once, while the file is used otherwise.
+	virtual int get_native_fd(uint64_t &r_base_offset) const { return -1; } ///< POSIX file descriptor of the data, and the offset of the file in it, for asynchronous I/O backends. -1 when unavailable.
 	virtual String get_line() const;
 	virtual String get_token() const;
 	virtual Vector<String> get_csv_line(const String &p_delim = ",") const;
@@ -250,6 +255,13 @@ public:
 	static Ref<FileAccess> open_compressed(const String &p_path, ModeFlags p_mode_flags, CompressionMode p_compress_mode = COMPRESSION_FASTLZ);
 	static Error get_open_error();
 
+	// Asynchronous reads, see AsyncFileReader.
+	typedef uint64_t AsyncReadID;
+	typedef void (*AsyncReadCallback)(void *p_userdata, Error p_error, uint64_t p_read);
+	AsyncReadID read_async(uint64_t p_position, uint8_t *p_dst, uint64_t p_length, AsyncReadCallback p_callback = nullptr, void *p_userdata = nullptr);
+	static Error wait_for_async_read(AsyncReadID p_id, uint64_t *r_read = nullptr);
+	static bool is_async_read_completed(AsyncReadID p_id);
+
 	static CreateFunc get_create_func(AccessType p_access);
 	static bool exists(const String &p_name); ///< return true if a file exists
 	static uint64_t get_modified_time(const String &p_file);
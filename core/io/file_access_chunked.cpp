@@ -0,0 +1,214 @@
+/**************************************************************************/
+/*  file_access_chunked.cpp                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "file_access_chunked.h"
+
+uint32_t FileAccessChunked::_find_chunk(uint64_t p_position) const {
+	// Reads are mostly sequential, check the current and the next chunk first.
+	for (uint32_t i = current_chunk; i < MIN(current_chunk + 2, chunks.size()); i++) {
+		if (p_position >= chunks[i].position && p_position - chunks[i].position < chunks[i].size) {
+			current_chunk = i;
+			return i;
+		}
+	}
+
+	// Last chunk starting before the position.
+	uint32_t low = 0;
+	uint32_t high = chunks.size();
+	while (low < high) {
+		uint32_t middle = (low + high) / 2;
+		if (chunks[middle].position <= p_position) {
+			low = middle + 1;
+		} else {
+			high = middle;
+		}
+	}
+
+	current_chunk = low > 0 ? low - 1 : 0;
+	return current_chunk;
+}
+
+uint8_t *FileAccessChunked::_get_mapped_data(const Chunk &p_chunk, uint64_t p_offset, uint64_t p_length) const {
+	return PackedData::get_singleton()->get_mapped_pack_data(p_chunk.pack, p_chunk.offset + p_offset, p_length);
+}
+
+Error FileAccessChunked::open_chunks(const String &p_path, const PackedData::PackedFile &p_file) {
+	close();
+
+	uint64_t position = 0;
+	chunks.resize(p_file.chunks.size());
+	for (uint32_t i = 0; i < chunks.size(); i++) {
+		PackedData::Chunk chunk = PackedData::get_singleton()->get_chunk(p_file.chunks[i]);
+		ERR_FAIL_COND_V(chunk.pack.is_empty(), ERR_FILE_CORRUPT);
+
+		chunks[i].pack = chunk.pack;
+		chunks[i].offset = chunk.offset;
+		chunks[i].position = position;
+		chunks[i].size = chunk.size;
+		position += chunk.size;
+	}
+	ERR_FAIL_COND_V_MSG(position != p_file.size, ERR_FILE_CORRUPT, vformat(R"(The chunks of "%s" don't match its size.)", p_path));
+
+	path = p_path;
+	length = position;
+	open = true;
+
+	return OK;
+}
+
+void FileAccessChunked::seek(uint64_t p_position) {
+	ERR_FAIL_COND_MSG(!open, "File must be opened before use.");
+
+	eof = p_position > length;
+	pos = p_position;
+}
+
+void FileAccessChunked::seek_end(int64_t p_position) {
+	seek(length + p_position);
+}
+
+uint64_t FileAccessChunked::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
+	ERR_FAIL_COND_V_MSG(!open, -1, "File must be opened before use.");
+	ERR_FAIL_COND_V(!p_dst && p_length > 0, -1);
+
+	if (eof) {
+		return 0;
+	}
+
+	uint64_t to_read = p_length;
+	if (pos >= length) {
+		to_read = 0;
+	} else if (to_read > length - pos) {
+		to_read = length - pos;
+	}
+	if (to_read < p_length) {
+		eof = true;
+	}
+
+	uint64_t read = 0;
+	while (read < to_read) {
+		const Chunk &chunk = chunks[_find_chunk(pos)];
+		const uint64_t offset = pos - chunk.position;
+		const uint64_t size = MIN(chunk.size - offset, to_read - read);
+
+		const uint8_t *data = _get_mapped_data(chunk, offset, size);
+		if (data) {
+			memcpy(p_dst + read, data, size);
+		} else {
+			if (pack_path != chunk.pack) {
+				pack_path = chunk.pack;
+				pack_file = FileAccess::open(chunk.pack, FileAccess::READ);
+			}
+			ERR_FAIL_COND_V_MSG(pack_file.is_null(), read, vformat(R"(Can't open pack "%s" to read a chunk of "%s".)", chunk.pack, path));
+
+			pack_file->seek(chunk.offset + offset);
+			if (pack_file->get_buffer(p_dst + read, size) != size) {
+				eof = true;
+				ERR_FAIL_V_MSG(read, vformat(R"(Can't read a chunk of "%s" from pack "%s".)", path, chunk.pack));
+			}
+		}
+
+		pos += size;
+		read += size;
+	}
+
+	return read;
+}
+
+Span<uint8_t> FileAccessChunked::get_buffer_view(uint64_t p_length) const {
+	ERR_FAIL_COND_V_MSG(!open, Span<uint8_t>(), "File must be opened before use.");
+
+	if (eof) {
+		return Span<uint8_t>();
+	}
+
+	uint64_t to_read = p_length;
+	if (pos >= length) {
+		to_read = 0;
+	} else if (to_read > length - pos) {
+		to_read = length - pos;
+	}
+
+	const uint8_t *data = nullptr;
+	if (to_read > 0) {
+		// Only data within a single mapped chunk can be viewed, the position doesn't change otherwise.
+		const Chunk &chunk = chunks[_find_chunk(pos)];
+		const uint64_t offset = pos - chunk.position;
+		if (to_read > chunk.size - offset) {
+			return Span<uint8_t>();
+		}
+		data = _get_mapped_data(chunk, offset, to_read);
+		if (!data) {
+			return Span<uint8_t>();
+		}
+	}
+
+	if (to_read < p_length) {
+		eof = true;
+	}
+	pos += to_read;
+	return Span<uint8_t>(data, to_read);
+}
+
+uint8_t *FileAccessChunked::get_persistent_buffer(uint64_t p_length) const {
+	ERR_FAIL_COND_V_MSG(!open, nullptr, "File must be opened before use.");
+
+	if (eof || p_length == 0 || pos >= length || p_length > length - pos) {
+		return nullptr;
+	}
+
+	const Chunk &chunk = chunks[_find_chunk(pos)];
+	const uint64_t offset = pos - chunk.position;
+	if (p_length > chunk.size - offset) {
+		return nullptr;
+	}
+
+	uint8_t *data = _get_mapped_data(chunk, offset, p_length);
+	if (data) {
+		pos += p_length;
+	}
+	return data;
+}
+
+bool FileAccessChunked::store_buffer(const uint8_t *p_src, uint64_t p_length) {
+	ERR_FAIL_V_MSG(false, "Files of packs are read-only.");
+}
+
+void FileAccessChunked::close() {
+	path = String();
+	chunks.clear();
+	length = 0;
+	open = false;
+	pos = 0;
+	eof = false;
+	current_chunk = 0;
+	pack_path = String();
+	pack_file.unref();
+}
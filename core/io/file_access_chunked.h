@@ -0,0 +1,107 @@
+/**************************************************************************/
+/*  file_access_chunked.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/io/file_access.h"
+#include "core/io/file_access_pack.h"
+#include "core/templates/local_vector.h"
+
+// Read-only access to a file of a chunked pack, assembled from chunks which may be stored in several packs.
+class FileAccessChunked : public FileAccess {
+	GDSOFTCLASS(FileAccessChunked, FileAccess);
+
+	struct Chunk {
+		String pack;
+		uint64_t offset = 0; // In the pack.
+		uint64_t position = 0; // In the file.
+		uint32_t size = 0;
+	};
+
+	String path;
+	LocalVector<Chunk> chunks;
+	uint64_t length = 0;
+	bool open = false;
+
+	mutable uint64_t pos = 0;
+	mutable bool eof = false;
+	mutable uint32_t current_chunk = 0;
+
+	// Pack used for reads when it can't be memory mapped.
+	mutable String pack_path;
+	mutable Ref<FileAccess> pack_file;
+
+	uint32_t _find_chunk(uint64_t p_position) const;
+	uint8_t *_get_mapped_data(const Chunk &p_chunk, uint64_t p_offset, uint64_t p_length) const;
+
+protected:
+	virtual BitField<UnixPermissionFlags> _get_unix_permissions(const String &p_file) override { return 0; }
+	virtual Error _set_unix_permissions(const String &p_file, BitField<UnixPermissionFlags> p_permissions) override { return FAILED; }
+
+	virtual bool _get_hidden_attribute(const String &p_file) override { return false; }
+	virtual Error _set_hidden_attribute(const String &p_file, bool p_hidden) override { return ERR_UNAVAILABLE; }
+
+	virtual bool _get_read_only_attribute(const String &p_file) override { return false; }
+	virtual Error _set_read_only_attribute(const String &p_file, bool p_ro) override { return ERR_UNAVAILABLE; }
+
+	virtual uint64_t _get_modified_time(const String &p_file) override { return 0; }
+	virtual uint64_t _get_access_time(const String &p_file) override { return 0; }
+	virtual int64_t _get_size(const String &p_file) override { return -1; }
+
+	virtual Error open_internal(const String &p_path, int p_mode_flags) override { return ERR_UNAVAILABLE; }
+
+public:
+	Error open_chunks(const String &p_path, const PackedData::PackedFile &p_file);
+
+	virtual bool is_open() const override { return open; }
+
+	virtual String get_path() const override { return path; }
+	virtual String get_path_absolute() const override { return path; }
+
+	virtual void seek(uint64_t p_position) override;
+	virtual void seek_end(int64_t p_position = 0) override;
+
+	virtual uint64_t get_position() const override { return pos; }
+	virtual uint64_t get_length() const override { return length; }
+	virtual bool eof_reached() const override { return eof; }
+	virtual Error get_error() const override { return eof ? ERR_FILE_EOF : OK; }
+
+	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override;
+	virtual Span<uint8_t> get_buffer_view(uint64_t p_length) const override;
+	virtual uint8_t *get_persistent_buffer(uint64_t p_length) const override;
+
+	virtual bool store_buffer(const uint8_t *p_src, uint64_t p_length) override;
+	virtual Error resize(int64_t p_length) override { return ERR_UNAVAILABLE; }
+
+	virtual void flush() override {}
+	virtual void close() override;
+
+	virtual bool file_exists(const String &p_name) override { return false; }
+};
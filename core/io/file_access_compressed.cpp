@@ -31,6 +31,7 @@
 #include "file_access_compressed.h"
 
 #include "core/math/math_funcs_binary.h"
+#include "core/object/worker_thread_pool.h"
 
 void FileAccessCompressed::configure(const String &p_magic, Compression::Mode p_mode, uint32_t p_block_size) {
 	magic = p_magic.ascii().get_data();
@@ -40,6 +41,93 @@ void FileAccessCompressed::configure(const String &p_magic, Compression::Mode p_
 	block_size = p_block_size;
 }
 
+void FileAccessCompressed::set_block_cache_size(uint32_t p_blocks) {
+	ERR_FAIL_COND(p_blocks == 0);
+	block_cache.set_capacity(p_blocks);
+}
+
+int64_t FileAccessCompressed::_decompress(uint8_t *p_dst, int64_t p_dst_size, const uint8_t *p_src, int64_t p_src_size) const {
+	if (cmode == Compression::MODE_ZSTD && !dictionary.is_empty()) {
+		return Compression::decompress_zstd_with_dictionary(p_dst, p_dst_size, p_src, p_src_size, dictionary);
+	}
+	return Compression::decompress(p_dst, p_dst_size, p_src, p_src_size, cmode);
+}
+
+void FileAccessCompressed::_decompress_block_task(void *p_userdata, uint32_t p_index) {
+	DecompressBlocks *data = (DecompressBlocks *)p_userdata;
+	const FileAccessCompressed *file = data->file;
+	const uint32_t block = data->first_block + p_index;
+	const ReadBlock &rb = file->read_blocks[block];
+	const uint32_t size = file->_get_block_size(block);
+
+	Vector<uint8_t> &dst = data->blocks[p_index];
+	dst.resize(size);
+	if (size == 0) {
+		return;
+	}
+	const int64_t ret = file->_decompress(dst.ptrw(), size, file->comp_buffer.ptr() + (rb.offset - data->first_offset), rb.csize);
+	if (ret != size) {
+		data->failed.set();
+	}
+}
+
+bool FileAccessCompressed::_load_block(uint32_t p_block) const {
+	const Vector<uint8_t> *cached = block_cache.getptr(p_block);
+	if (cached) {
+		buffer = *cached;
+	} else {
+		// When reading sequentially, decompress the upcoming blocks along with this one.
+		uint32_t count = 1;
+		if (p_block == read_block + 1) {
+			const uint32_t max_count = MIN(MIN(read_ahead + 1, read_block_count - p_block), (uint32_t)block_cache.get_capacity());
+			while (count < max_count && !block_cache.has(p_block + count)) {
+				count++;
+			}
+		}
+
+		// Blocks are stored contiguously, so they can be read at once.
+		const uint64_t offset = read_blocks[p_block].offset;
+		const ReadBlock &last = read_blocks[p_block + count - 1];
+		const uint64_t csize = last.offset + last.csize - offset;
+		if ((uint64_t)comp_buffer.size() < csize) {
+			comp_buffer.resize(csize);
+		}
+		if (f->get_position() != offset) {
+			f->seek(offset);
+		}
+		ERR_FAIL_COND_V_MSG(f->get_buffer(comp_buffer.ptrw(), csize) != csize, false, "Compressed file is truncated.");
+
+		LocalVector<Vector<uint8_t>> blocks;
+		blocks.resize(count);
+		DecompressBlocks data;
+		data.file = this;
+		data.first_block = p_block;
+		data.first_offset = offset;
+		data.blocks = blocks.ptr();
+
+		WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+		if (count > 1 && pool != nullptr && pool->get_thread_count() > 1 && pool->get_thread_index() == -1) {
+			WorkerThreadPool::GroupID group = pool->add_native_group_task(&_decompress_block_task, &data, count, -1, true, SNAME("FileAccessCompressed"));
+			pool->wait_for_group_task_completion(group);
+		} else {
+			for (uint32_t i = 0; i < count; i++) {
+				_decompress_block_task(&data, i);
+			}
+		}
+		ERR_FAIL_COND_V_MSG(data.failed.is_set(), false, "Compressed file is corrupt.");
+
+		for (uint32_t i = 0; i < count; i++) {
+			block_cache.insert(p_block + i, blocks[i]);
+		}
+		buffer = blocks[0];
+	}
+
+	read_ptr = buffer.ptr();
+	read_block = p_block;
+	read_block_size = _get_block_size(p_block);
+	return true;
+}
+
 Error FileAccessCompressed::open_after_magic(Ref<FileAccess> p_base) {
 	f = p_base;
 	cmode = (Compression::Mode)f->get_32();
@@ -62,19 +150,14 @@ Error FileAccessCompressed::open_after_magic(Ref<FileAccess> p_base) {
 	}
 
 	comp_buffer.resize(max_bs);
-	buffer.resize(block_size);
-	read_ptr = buffer.ptrw();
-	f->get_buffer(comp_buffer.ptrw(), read_blocks[0].csize);
+	block_cache.clear();
 	at_end = false;
 	read_eof = false;
 	read_block_count = bc;
-	read_block_size = read_blocks.size() == 1 ? read_total : block_size;
-
-	const int64_t ret = Compression::decompress(buffer.ptrw(), read_block_size, comp_buffer.ptr(), read_blocks[0].csize, cmode);
 	read_block = 0;
 	read_pos = 0;
 
-	return ret == -1 ? ERR_FILE_CORRUPT : OK;
+	return _load_block(0) ? OK : ERR_FILE_CORRUPT;
 }
 
 Error FileAccessCompressed::open_internal(const String &p_path, int p_mode_flags) {
@@ -145,7 +228,12 @@ void FileAccessCompressed::_close() {
 			uint32_t bl = i == (bc - 1) ? last_block_size : block_size;
 			uint8_t *bp = &write_ptr[i * block_size];
 
-			const int64_t compressed_size = Compression::compress(temp_cblock_ptr, bp, bl, cmode);
+			int64_t compressed_size;
+			if (cmode == Compression::MODE_ZSTD && !dictionary.is_empty()) {
+				compressed_size = Compression::compress_zstd_with_dictionary(temp_cblock_ptr, bp, bl, dictionary);
+			} else {
+				compressed_size = Compression::compress(temp_cblock_ptr, bp, bl, cmode);
+			}
 			ERR_FAIL_COND_MSG(compressed_size < 0, "FileAccessCompressed: Error compressing data.");
 
 			f->store_buffer(temp_cblock_ptr, (uint64_t)compressed_size);
@@ -161,6 +249,8 @@ void FileAccessCompressed::_close() {
 	} else {
 		comp_buffer.clear();
 		read_blocks.clear();
+		block_cache.clear();
+		read_ptr = nullptr;
 	}
 	buffer.clear();
 	f.unref();
@@ -202,13 +292,8 @@ void FileAccessCompressed::seek(uint64_t p_position) {
 			at_end = false;
 			read_eof = false;
 			uint32_t block_idx = p_position / block_size;
-			if (block_idx != read_block) {
-				read_block = block_idx;
-				f->seek(read_blocks[read_block].offset);
-				f->get_buffer(comp_buffer.ptrw(), read_blocks[read_block].csize);
-				const int64_t ret = Compression::decompress(buffer.ptrw(), read_blocks.size() == 1 ? read_total : block_size, comp_buffer.ptr(), read_blocks[read_block].csize, cmode);
-				ERR_FAIL_COND_MSG(ret == -1, "Compressed file is corrupt.");
-				read_block_size = read_block == read_block_count - 1 ? read_total % block_size : block_size;
+			if (block_idx != read_block && !_load_block(block_idx)) {
+				return;
 			}
 
 			read_pos = p_position % block_size;
@@ -270,7 +355,9 @@ uint64_t FileAccessCompressed::get_buffer(uint8_t *p_dst, uint64_t p_length) con
 	while (true) {
 		// Copy over as much of our current block as possible.
 		const uint32_t copied_bytes_count = MIN(p_length - dst_idx, read_block_size - read_pos);
-		memcpy(p_dst + dst_idx, read_ptr + read_pos, copied_bytes_count);
+		if (copied_bytes_count > 0) {
+			memcpy(p_dst + dst_idx, read_ptr + read_pos, copied_bytes_count);
+		}
 		dst_idx += copied_bytes_count;
 		read_pos += copied_bytes_count;
 
@@ -280,23 +367,17 @@ uint64_t FileAccessCompressed::get_buffer(uint8_t *p_dst, uint64_t p_length) con
 		}
 
 		// We're not done yet; try reading the next block.
-		read_block++;
-
-		if (read_block >= read_block_count) {
+		if (read_block + 1 >= read_block_count) {
 			// We're done! We read back the whole file.
-			read_block--;
 			at_end = true;
-			if (dst_idx + 1 < p_length) {
-				read_eof = true;
-			}
+			read_eof = true;
 			return dst_idx;
 		}
 
-		// Read the next block of compressed data.
-		f->get_buffer(comp_buffer.ptrw(), read_blocks[read_block].csize);
-		const int64_t ret = Compression::decompress(buffer.ptrw(), read_blocks.size() == 1 ? read_total : block_size, comp_buffer.ptr(), read_blocks[read_block].csize, cmode);
-		ERR_FAIL_COND_V_MSG(ret == -1, -1, "Compressed file is corrupt.");
-		read_block_size = read_block == read_block_count - 1 ? read_total % block_size : block_size;
+		// Decompress the next block, unless it's cached.
+		if (!_load_block(read_block + 1)) {
+			return -1;
+		}
 		read_pos = 0;
 	}
 
@@ -413,6 +494,10 @@ void FileAccessCompressed::close() {
 	_close();
 }
 
+FileAccessCompressed::FileAccessCompressed() :
+		block_cache(16) {
+}
+
 FileAccessCompressed::~FileAccessCompressed() {
 	_close();
 }
@@ -32,6 +32,7 @@
 
 #include "core/io/compression.h"
 #include "core/io/file_access.h"
+#include "core/templates/lru.h"
 
 class FileAccessCompressed : public FileAccess {
 	GDSOFTCLASS(FileAccessCompressed, FileAccess);
@@ -51,7 +52,7 @@ class FileAccessCompressed : public FileAccess {
 	};
 
 	mutable Vector<uint8_t> comp_buffer;
-	uint8_t *read_ptr = nullptr;
+	mutable const uint8_t *read_ptr = nullptr;
 	mutable uint32_t read_block = 0;
 	uint32_t read_block_count = 0;
 	mutable uint32_t read_block_size = 0;
@@ -59,10 +60,28 @@ class FileAccessCompressed : public FileAccess {
 	Vector<ReadBlock> read_blocks;
 	uint64_t read_total = 0;
 
+	// Decompressed blocks, shared with the current block buffer.
+	mutable LRUCache<uint32_t, Vector<uint8_t>> block_cache;
+	uint32_t read_ahead = 8;
+	Vector<uint8_t> dictionary;
+
 	String magic = "GCMP";
 	mutable Vector<uint8_t> buffer;
 	Ref<FileAccess> f;
 
+	struct DecompressBlocks {
+		const FileAccessCompressed *file = nullptr;
+		uint32_t first_block = 0;
+		uint64_t first_offset = 0;
+		Vector<uint8_t> *blocks = nullptr;
+		SafeFlag failed;
+	};
+
+	static void _decompress_block_task(void *p_userdata, uint32_t p_index);
+
+	uint32_t _get_block_size(uint32_t p_block) const { return p_block == read_block_count - 1 ? read_total % block_size : block_size; }
+	int64_t _decompress(uint8_t *p_dst, int64_t p_dst_size, const uint8_t *p_src, int64_t p_src_size) const;
+	bool _load_block(uint32_t p_block) const;
 	void _close();
 
 public:
@@ -70,6 +89,16 @@ public:
 
 	Error open_after_magic(Ref<FileAccess> p_base);
 
+	// Number of decompressed blocks kept around for random access, at least 1.
+	void set_block_cache_size(uint32_t p_blocks);
+	uint32_t get_block_cache_size() const { return block_cache.get_capacity(); }
+	// Number of upcoming blocks decompressed in parallel when reading sequentially, 0 to disable.
+	void set_read_ahead(uint32_t p_blocks) { read_ahead = p_blocks; }
+	uint32_t get_read_ahead() const { return read_ahead; }
+	// Zstandard dictionary, must be the same for writing and reading. Set before opening.
+	void set_dictionary(const Vector<uint8_t> &p_dictionary) { dictionary = p_dictionary; }
+	const Vector<uint8_t> &get_dictionary() const { return dictionary; }
+
 	virtual Error open_internal(const String &p_path, int p_mode_flags) override; ///< open a file
 	virtual bool is_open() const override; ///< true when file is open
 
@@ -106,5 +135,6 @@ public:
 
 	virtual void close() override;
 
+	FileAccessCompressed();
 	virtual ~FileAccessCompressed();
 };
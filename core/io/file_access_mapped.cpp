@@ -0,0 +1,161 @@
+/**************************************************************************/
+/*  file_access_mapped.cpp                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "file_access_mapped.h"
+
+#include "core/io/file_access_pack.h"
+
+Ref<FileAccessMapped> FileAccessMapped::open_range(const String &p_path, uint64_t p_offset, int64_t p_length, Error *r_error, bool p_copy_on_write) {
+	Error err = ERR_UNAVAILABLE;
+	Ref<FileAccessMapped> ret;
+
+	// Files inside packs have no file of their own to map, they can be read through FileAccessPack instead.
+	bool in_pack = PackedData::get_singleton() && !PackedData::get_singleton()->is_disabled() && PackedData::get_singleton()->has_path(p_path);
+	if (create_mapped_func && !in_pack && !p_path.begins_with("pipe://")) {
+		ret = create_mapped_func();
+		if (p_path.begins_with("res://") || p_path.begins_with("uid://")) {
+			ret->_set_access_type(ACCESS_RESOURCES);
+		} else if (p_path.begins_with("user://")) {
+			ret->_set_access_type(ACCESS_USERDATA);
+		} else {
+			ret->_set_access_type(ACCESS_FILESYSTEM);
+		}
+		err = ret->_open_range(p_path, p_offset, p_length, p_copy_on_write);
+		if (err != OK) {
+			ret.unref();
+		}
+	}
+
+	if (r_error) {
+		*r_error = err;
+	}
+	return ret;
+}
+
+Error FileAccessMapped::_open_range(const String &p_path, uint64_t p_offset, int64_t p_length, bool p_copy_on_write) {
+	close();
+
+	const String fixed_path = fix_path(p_path);
+	Error err = _map(fixed_path, p_offset, p_length, p_copy_on_write);
+	if (err != OK) {
+		data = nullptr;
+		length = 0;
+		return err;
+	}
+
+	path_src = p_path;
+	path = fixed_path;
+	copy_on_write = p_copy_on_write;
+	return OK;
+}
+
+Error FileAccessMapped::open_internal(const String &p_path, int p_mode_flags) {
+	ERR_FAIL_COND_V_MSG(p_mode_flags != READ, ERR_UNAVAILABLE, "Memory mapped files can only be opened for reading.");
+	return _open_range(p_path, 0, -1, false);
+}
+
+void FileAccessMapped::seek(uint64_t p_position) {
+	ERR_FAIL_COND_MSG(!is_open(), "File must be opened before use.");
+
+	pos = p_position;
+	eof = false;
+}
+
+void FileAccessMapped::seek_end(int64_t p_position) {
+	ERR_FAIL_COND_MSG(!is_open(), "File must be opened before use.");
+
+	seek(length + p_position);
+}
+
+uint8_t FileAccessMapped::get_8() const {
+	ERR_FAIL_COND_V_MSG(!is_open(), 0, "File must be opened before use.");
+
+	if (pos >= length) {
+		eof = true;
+		return 0;
+	}
+	return data[pos++];
+}
+
+uint64_t FileAccessMapped::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
+	ERR_FAIL_COND_V(!p_dst && p_length > 0, -1);
+
+	Span<uint8_t> view = get_buffer_view(p_length);
+	if (!view.is_empty()) {
+		memcpy(p_dst, view.ptr(), view.size());
+	}
+	return view.size();
+}
+
+uint64_t FileAccessMapped::get_buffer_at(uint8_t *p_dst, uint64_t p_position, uint64_t p_length) const {
+	ERR_FAIL_COND_V_MSG(!is_open(), -1, "File must be opened before use.");
+	ERR_FAIL_COND_V(!p_dst && p_length > 0, -1);
+
+	if (p_position >= length) {
+		return 0;
+	}
+	const uint64_t to_read = MIN(p_length, length - p_position);
+	memcpy(p_dst, data + p_position, to_read);
+	return to_read;
+}
+
+Span<uint8_t> FileAccessMapped::get_buffer_view(uint64_t p_length) const {
+	ERR_FAIL_COND_V_MSG(!is_open(), Span<uint8_t>(), "File must be opened before use.");
+
+	uint64_t left = pos < length ? length - pos : 0;
+	if (p_length > left) {
+		eof = true;
+		p_length = left;
+	}
+	if (p_length == 0) {
+		return Span<uint8_t>();
+	}
+
+	Span<uint8_t> view(data + pos, p_length);
+	pos += p_length;
+	return view;
+}
+
+bool FileAccessMapped::store_buffer(const uint8_t *p_src, uint64_t p_length) {
+	ERR_FAIL_V_MSG(false, "Memory mapped files are read-only.");
+}
+
+void FileAccessMapped::close() {
+	if (is_open()) {
+		_unmap();
+	}
+	data = nullptr;
+	length = 0;
+	pos = 0;
+	eof = false;
+	copy_on_write = false;
+	path = String();
+	path_src = String();
+}
@@ -0,0 +1,130 @@
+/**************************************************************************/
+/*  file_access_mapped.h                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/io/file_access.h"
+
+// Read-only access to a memory mapped file, or to a range of it.
+// Reads are served straight from the mapping, and get_buffer_view() returns the mapped bytes without copying them.
+// Mapping is platform specific, platforms which support it register their implementation with make_default().
+// NOTE: The file must not be truncated while it is mapped.
+class FileAccessMapped : public FileAccess {
+	GDSOFTCLASS(FileAccessMapped, FileAccess);
+
+public:
+	enum AccessHint {
+		ACCESS_HINT_NORMAL,
+		ACCESS_HINT_SEQUENTIAL,
+		ACCESS_HINT_RANDOM,
+	};
+
+private:
+	typedef Ref<FileAccessMapped> (*CreateMappedFunc)();
+	static inline CreateMappedFunc create_mapped_func = nullptr;
+	template <typename T>
+	static Ref<FileAccessMapped> _create_builtin() {
+		return memnew(T);
+	}
+
+	String path;
+	String path_src;
+	mutable uint64_t pos = 0;
+	mutable bool eof = false;
+	bool copy_on_write = false;
+
+	Error _open_range(const String &p_path, uint64_t p_offset, int64_t p_length, bool p_copy_on_write);
+
+protected:
+	const uint8_t *data = nullptr;
+	uint64_t length = 0;
+
+	// Maps p_length bytes of the file from p_offset, or up to the end of the file if p_length is negative, and sets data and length.
+	// Copy-on-write mappings can be written to, without changing the file.
+	virtual Error _map(const String &p_path, uint64_t p_offset, int64_t p_length, bool p_copy_on_write) = 0;
+	virtual void _unmap() = 0;
+
+	virtual uint64_t _get_modified_time(const String &p_file) override { return FileAccess::get_modified_time(p_file); }
+	virtual uint64_t _get_access_time(const String &p_file) override { return FileAccess::get_access_time(p_file); }
+	virtual int64_t _get_size(const String &p_file) override { return FileAccess::get_size(p_file); }
+	virtual BitField<FileAccess::UnixPermissionFlags> _get_unix_permissions(const String &p_file) override { return FileAccess::get_unix_permissions(p_file); }
+	virtual Error _set_unix_permissions(const String &p_file, BitField<FileAccess::UnixPermissionFlags> p_permissions) override { return ERR_UNAVAILABLE; }
+
+	virtual bool _get_hidden_attribute(const String &p_file) override { return FileAccess::get_hidden_attribute(p_file); }
+	virtual Error _set_hidden_attribute(const String &p_file, bool p_hidden) override { return ERR_UNAVAILABLE; }
+	virtual bool _get_read_only_attribute(const String &p_file) override { return FileAccess::get_read_only_attribute(p_file); }
+	virtual Error _set_read_only_attribute(const String &p_file, bool p_ro) override { return ERR_UNAVAILABLE; }
+
+public:
+	static bool is_supported() { return create_mapped_func != nullptr; }
+	static Ref<FileAccessMapped> open_range(const String &p_path, uint64_t p_offset = 0, int64_t p_length = -1, Error *r_error = nullptr, bool p_copy_on_write = false);
+
+	template <typename T>
+	static void make_default() {
+		create_mapped_func = _create_builtin<T>;
+	}
+
+	// Hints how the mapped range is going to be read, so the OS can adapt its read-ahead.
+	virtual void set_access_hint(AccessHint p_hint) {}
+	// Asks the OS to start reading the given range in the background.
+	virtual void prefetch(uint64_t p_offset, uint64_t p_length) {}
+
+	// Writes are private to this mapping, and only copy the pages they touch.
+	_FORCE_INLINE_ uint8_t *get_copy_on_write_data() const { return copy_on_write ? (uint8_t *)data : nullptr; }
+
+	virtual Error open_internal(const String &p_path, int p_mode_flags) override;
+	virtual bool is_open() const override { return !path.is_empty(); }
+
+	virtual String get_path() const override { return path_src; }
+	virtual String get_path_absolute() const override { return path; }
+
+	virtual void seek(uint64_t p_position) override;
+	virtual void seek_end(int64_t p_position = 0) override;
+	virtual uint64_t get_position() const override { return pos; }
+	virtual uint64_t get_length() const override { return length; }
+
+	virtual bool eof_reached() const override { return eof; }
+
+	virtual uint8_t get_8() const override;
+	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override;
+	virtual Span<uint8_t> get_buffer_view(uint64_t p_length) const override;
+	virtual uint64_t get_buffer_at(uint8_t *p_dst, uint64_t p_position, uint64_t p_length) const override;
+	virtual bool has_thread_safe_reads() const override { return true; }
+
+	virtual Error get_error() const override { return eof ? ERR_FILE_EOF : OK; }
+
+	virtual Error resize(int64_t p_length) override { return ERR_UNAVAILABLE; }
+	virtual void flush() override {}
+	virtual bool store_buffer(const uint8_t *p_src, uint64_t p_length) override;
+
+	virtual bool file_exists(const String &p_name) override { return FileAccess::exists(p_name); }
+
+	virtual void close() override;
+};
@@ -30,6 +30,7 @@
 
 #include "file_access_pack.h"
 
+#include "core/io/file_access_chunked.h"
 #include "core/io/file_access_encrypted.h"
 #include "core/io/file_access_patched.h"
 #include "core/object/script_language.h"
@@ -37,6 +38,18 @@
 #include "core/version.h"
 
 Error PackedData::add_pack(const String &p_path, bool p_replace_files, uint64_t p_offset, const Vector<uint8_t> &p_decryption_key) {
+	{
+		// The pack may have been rewritten since it was mapped. Loaded data may still reference the old mapping, so keep it alive.
+		MutexLock lock(mapped_packs_mutex);
+		HashMap<String, Ref<FileAccessMapped>>::Iterator E = mapped_packs.find(p_path);
+		if (E) {
+			if (E->value.is_valid()) {
+				retired_mapped_packs.push_back(E->value);
+			}
+			mapped_packs.remove(E);
+		}
+	}
+
 	for (int i = 0; i < sources.size(); i++) {
 		if (sources[i]->try_open_pack(p_path, p_replace_files, p_offset, p_decryption_key)) {
 			return OK;
@@ -46,7 +59,7 @@ Error PackedData::add_pack(const String &p_path, bool p_replace_files, uint64_t
 	return ERR_FILE_UNRECOGNIZED;
 }
 
-void PackedData::add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted, bool p_bundle, bool p_delta, const String &p_salt) {
+void PackedData::add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted, bool p_bundle, bool p_delta, const String &p_salt, const Vector<uint32_t> *p_chunks) {
 	String simplified_path = p_path.simplify_path().trim_prefix("res://");
 	PathMD5 pmd5(simplified_path.md5_buffer());
 
@@ -64,6 +77,10 @@ void PackedData::add_path(const String &p_pkg_path, const String &p_path, uint64
 		pf.md5[i] = p_md5[i];
 	}
 	pf.src = p_src;
+	if (p_chunks) {
+		pf.chunked = true;
+		pf.chunks = *p_chunks;
+	}
 
 	if (p_delta) {
 		delta_patches[pmd5].push_back(pf);
@@ -181,9 +198,57 @@ void PackedData::_get_file_paths(PackedDir *p_dir, const String &p_parent_dir, H
 	}
 }
 
+uint32_t PackedData::add_chunk(const ChunkHash &p_hash, const String &p_pack, uint64_t p_offset, uint32_t p_size) {
+	HashMap<ChunkHash, uint32_t, ChunkHash>::Iterator E = chunk_ids.find(p_hash);
+	if (E) {
+		return E->value;
+	}
+
+	Chunk chunk;
+	chunk.pack = p_pack;
+	chunk.offset = p_offset;
+	chunk.size = p_size;
+	chunks.push_back(chunk);
+	chunk_ids.insert(p_hash, chunks.size() - 1);
+	return chunks.size() - 1;
+}
+
+int64_t PackedData::find_chunk(const ChunkHash &p_hash) const {
+	HashMap<ChunkHash, uint32_t, ChunkHash>::ConstIterator E = chunk_ids.find(p_hash);
+	return E ? int64_t(E->value) : -1;
+}
+
+PackedData::Chunk PackedData::get_chunk(uint32_t p_id) const {
+	ERR_FAIL_UNSIGNED_INDEX_V(p_id, chunks.size(), Chunk());
+	return chunks[p_id];
+}
+
+uint8_t *PackedData::get_mapped_pack_data(const String &p_pack, uint64_t p_offset, uint64_t p_length) {
+	if (!memory_mapping) {
+		return nullptr;
+	}
+
+	MutexLock lock(mapped_packs_mutex);
+
+	Ref<FileAccessMapped> *mapped = mapped_packs.getptr(p_pack);
+	if (!mapped) {
+		// Packs which can't be mapped are remembered too.
+		mapped = &mapped_packs.insert(p_pack, FileAccessMapped::open_range(p_pack, 0, -1, nullptr, true))->value;
+	}
+	if (mapped->is_null()) {
+		return nullptr;
+	}
+
+	const uint64_t length = (*mapped)->get_length();
+	ERR_FAIL_COND_V(p_offset > length || p_length > length - p_offset, nullptr);
+	return (*mapped)->get_copy_on_write_data() + p_offset;
+}
+
 void PackedData::clear() {
 	files.clear();
 	delta_patches.clear();
+	chunks.clear();
+	chunk_ids.clear();
 	_free_packed_dirs(root);
 	root = memnew(PackedDir);
 }
@@ -292,27 +357,51 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files,
 	uint32_t ver_minor = f->get_32();
 	uint32_t ver_patch = f->get_32(); // Not used for validation.
 
-	ERR_FAIL_COND_V_MSG(version != PACK_FORMAT_VERSION_V4 && version != PACK_FORMAT_VERSION_V3 && version != PACK_FORMAT_VERSION_V2, false, vformat("Pack version unsupported: %d.", version));
+	ERR_FAIL_COND_V_MSG(version != PACK_FORMAT_VERSION_V5 && version != PACK_FORMAT_VERSION_V4 && version != PACK_FORMAT_VERSION_V3 && version != PACK_FORMAT_VERSION_V2, false, vformat("Pack version unsupported: %d.", version));
 	ERR_FAIL_COND_V_MSG(ver_major > GODOT_VERSION_MAJOR || (ver_major == GODOT_VERSION_MAJOR && ver_minor > GODOT_VERSION_MINOR), false, vformat("Pack created with a newer version of the engine: %d.%d.%d.", ver_major, ver_minor, ver_patch));
 
 	uint32_t pack_flags = f->get_32();
 	bool enc_directory = (pack_flags & PACK_DIR_ENCRYPTED);
 	bool rel_filebase = (pack_flags & PACK_REL_FILEBASE); // Note: Always enabled for V3.
 	bool sparse_bundle = (pack_flags & PACK_SPARSE_BUNDLE);
+	bool chunked = (pack_flags & PACK_CHUNKED) && version == PACK_FORMAT_VERSION_V5;
+	ERR_FAIL_COND_V_MSG(chunked && sparse_bundle, false, "Chunked packs can't be sparse bundles.");
 	String salt;
 
+	// Global IDs of the chunks of the pack, and the lists of chunks of its files.
+	LocalVector<uint32_t> chunk_ids;
+	LocalVector<uint32_t> chunk_lists;
+
 	uint64_t file_base = f->get_64();
-	if ((version == PACK_FORMAT_VERSION_V4) || (version == PACK_FORMAT_VERSION_V3) || (version == PACK_FORMAT_VERSION_V2 && rel_filebase)) {
+	if ((version == PACK_FORMAT_VERSION_V5) || (version == PACK_FORMAT_VERSION_V4) || (version == PACK_FORMAT_VERSION_V3) || (version == PACK_FORMAT_VERSION_V2 && rel_filebase)) {
 		file_base += pck_start_pos;
 	}
 
-	if (version == PACK_FORMAT_VERSION_V3 || version == PACK_FORMAT_VERSION_V4) {
-		// V3/V4: Read directory offset and skip reserved part of the header.
+	if (version == PACK_FORMAT_VERSION_V3 || version == PACK_FORMAT_VERSION_V4 || version == PACK_FORMAT_VERSION_V5) {
+		// V3/V4/V5: Read directory offset and skip reserved part of the header.
 		uint64_t dir_offset = f->get_64() + pck_start_pos;
-		if (sparse_bundle && enc_directory && version == PACK_FORMAT_VERSION_V4) {
+		if (sparse_bundle && enc_directory && version >= PACK_FORMAT_VERSION_V4) {
 			// V4: Read encrypted directory salt.
 			Vector<uint8_t> salt_data = f->get_buffer(32);
 			salt.append_latin1(Span((const char *)salt_data.ptr(), salt_data.size()));
+		} else if (chunked) {
+			// V5: Read the chunk table, chunks are shared with the packs loaded before and after this one.
+			uint64_t chunk_table_offset = f->get_64() + pck_start_pos;
+
+			LocalVector<PackedData::ChunkHash> hashes;
+			LocalVector<PackedData::Chunk> pack_chunks;
+			Error err = read_chunk_table(f, chunk_table_offset, hashes, pack_chunks, chunk_lists);
+			ERR_FAIL_COND_V_MSG(err != OK, false, vformat("Can't read the chunk table of pack \"%s\".", p_path));
+
+			chunk_ids.resize(pack_chunks.size());
+			for (uint32_t i = 0; i < pack_chunks.size(); i++) {
+				if (pack_chunks[i].offset == PACK_CHUNK_EXTERNAL) {
+					int64_t id = PackedData::get_singleton()->find_chunk(hashes[i]);
+					chunk_ids[i] = id < 0 ? UINT32_MAX : uint32_t(id);
+				} else {
+					chunk_ids[i] = PackedData::get_singleton()->add_chunk(hashes[i], p_path, file_base + pack_chunks[i].offset, pack_chunks[i].size);
+				}
+			}
 		}
 		f->seek(dir_offset);
 	} else if (version == PACK_FORMAT_VERSION_V2) {
@@ -365,6 +454,27 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files,
 
 		if (flags & PACK_FILE_REMOVAL) { // The file was removed.
 			PackedData::get_singleton()->remove_path(path);
+		} else if (flags & PACK_FILE_CHUNKED) {
+			// The offset is the one of the chunk list of the file.
+			ERR_CONTINUE_MSG(!chunked || ofs >= chunk_lists.size() || chunk_lists[ofs] > chunk_lists.size() - ofs - 1, vformat("Invalid chunk list for \"%s\" in pack \"%s\".", path, p_path));
+
+			Vector<uint32_t> file_chunks;
+			file_chunks.resize(chunk_lists[ofs]);
+			uint64_t chunks_size = 0;
+			bool missing = false;
+			for (uint32_t j = 0; j < chunk_lists[ofs]; j++) {
+				uint32_t index = chunk_lists[ofs + 1 + j];
+				if (index >= chunk_ids.size() || chunk_ids[index] == UINT32_MAX) {
+					missing = true;
+					break;
+				}
+				file_chunks.write[j] = chunk_ids[index];
+				chunks_size += PackedData::get_singleton()->get_chunk(chunk_ids[index]).size;
+			}
+			ERR_CONTINUE_MSG(missing, vformat("Can't add \"%s\" from pack \"%s\", some of its chunks are stored in a pack which isn't loaded.", path, p_path));
+			ERR_CONTINUE_MSG(chunks_size != size, vformat("Invalid chunk list for \"%s\" in pack \"%s\".", path, p_path));
+
+			PackedData::get_singleton()->add_path(p_path, path, file_base, size, md5, this, p_replace_files, false, false, (flags & PACK_FILE_DELTA), salt, &file_chunks);
 		} else {
 			PackedData::get_singleton()->add_path(p_path, path, file_base + ofs, size, md5, this, p_replace_files, (flags & PACK_FILE_ENCRYPTED), sparse_bundle, (flags & PACK_FILE_DELTA), salt);
 		}
@@ -373,8 +483,46 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files,
 	return true;
 }
 
+Error PackedSourcePCK::read_chunk_table(const Ref<FileAccess> &p_file, uint64_t p_offset, LocalVector<PackedData::ChunkHash> &r_hashes, LocalVector<PackedData::Chunk> &r_chunks, LocalVector<uint32_t> &r_chunk_lists) {
+	const uint64_t length = p_file->get_length();
+	ERR_FAIL_COND_V(p_offset > length, ERR_FILE_CORRUPT);
+	p_file->seek(p_offset);
+
+	// Hash, offset and size.
+	constexpr uint64_t CHUNK_ENTRY_SIZE = 32 + 8 + 4;
+	uint32_t chunk_count = p_file->get_32();
+	ERR_FAIL_COND_V(p_file->get_error() != OK || uint64_t(chunk_count) * CHUNK_ENTRY_SIZE > length - p_file->get_position(), ERR_FILE_CORRUPT);
+
+	r_hashes.resize(chunk_count);
+	r_chunks.resize(chunk_count);
+	for (uint32_t i = 0; i < chunk_count; i++) {
+		p_file->get_buffer(r_hashes[i].sha256, sizeof(r_hashes[i].sha256));
+		r_chunks[i].offset = p_file->get_64();
+		r_chunks[i].size = p_file->get_32();
+	}
+
+	uint32_t list_size = p_file->get_32();
+	ERR_FAIL_COND_V(p_file->get_error() != OK || uint64_t(list_size) * 4 > length - p_file->get_position(), ERR_FILE_CORRUPT);
+
+	r_chunk_lists.resize(list_size);
+	for (uint32_t i = 0; i < list_size; i++) {
+		r_chunk_lists[i] = p_file->get_32();
+	}
+
+	return p_file->get_error() == OK ? OK : ERR_FILE_CORRUPT;
+}
+
 Ref<FileAccess> PackedSourcePCK::get_file(const String &p_path, PackedData::PackedFile *p_file, const Vector<uint8_t> &p_decryption_key) {
-	Ref<FileAccess> file(memnew(FileAccessPack(p_path, *p_file, p_decryption_key)));
+	Ref<FileAccess> file;
+	if (p_file->chunked) {
+		Ref<FileAccessChunked> file_chunked;
+		file_chunked.instantiate();
+		Error err = file_chunked->open_chunks(p_path, *p_file);
+		ERR_FAIL_COND_V(err != OK, Ref<FileAccess>());
+		file = file_chunked;
+	} else {
+		file = memnew(FileAccessPack(p_path, *p_file, p_decryption_key));
+	}
 
 	if (PackedData::get_singleton()->has_delta_patches(p_path)) {
 		Ref<FileAccessPatched> file_patched;
@@ -493,6 +641,77 @@ uint64_t FileAccessPack::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
 	return to_read;
 }
 
+Span<uint8_t> FileAccessPack::get_buffer_view(uint64_t p_length) const {
+	ERR_FAIL_COND_V_MSG(f.is_null(), Span<uint8_t>(), "File must be opened before use.");
+
+	if (eof) {
+		return Span<uint8_t>();
+	}
+
+	uint64_t to_read = p_length;
+	if (pos >= pf.size) {
+		to_read = 0;
+	} else if (to_read > pf.size - pos) {
+		to_read = pf.size - pos;
+	}
+
+	// Only mapped files can return a view, the position doesn't change otherwise.
+	Span<uint8_t> view = f->get_buffer_view(to_read);
+	if (view.size() == to_read && to_read < p_length) {
+		eof = true;
+	}
+	pos += view.size();
+	return view;
+}
+
+uint8_t *FileAccessPack::get_persistent_buffer(uint64_t p_length) const {
+	ERR_FAIL_COND_V_MSG(f.is_null(), nullptr, "File must be opened before use.");
+
+	if (eof || pf.encrypted || pf.bundle || pos > pf.size || p_length > pf.size - pos) {
+		return nullptr;
+	}
+
+	uint8_t *data = PackedData::get_singleton()->get_mapped_pack_data(pf.pack, pf.offset + pos, p_length);
+	if (!data) {
+		return nullptr;
+	}
+
+	pos += p_length;
+	f->seek(off + pos);
+	return data;
+}
+
+uint64_t FileAccessPack::get_buffer_at(uint8_t *p_dst, uint64_t p_position, uint64_t p_length) const {
+	ERR_FAIL_COND_V_MSG(f.is_null(), -1, "File must be opened before use.");
+	ERR_FAIL_COND_V(!p_dst && p_length > 0, -1);
+
+	if (p_position >= pf.size) {
+		return 0;
+	}
+	const uint64_t to_read = MIN(p_length, pf.size - p_position);
+	if (pf.encrypted) {
+		// Goes through the decrypted stream, which has no positional reads.
+		return FileAccess::get_buffer_at(p_dst, p_position, to_read);
+	}
+	return f->get_buffer_at(p_dst, off + p_position, to_read);
+}
+
+bool FileAccessPack::has_thread_safe_reads() const {
+	return f.is_valid() && !pf.encrypted && f->has_thread_safe_reads();
+}
+
+int FileAccessPack::get_native_fd(uint64_t &r_base_offset) const {
+	if (f.is_null() || pf.encrypted) {
+		return -1;
+	}
+	uint64_t base_offset = 0;
+	const int fd = f->get_native_fd(base_offset);
+	if (fd >= 0) {
+		r_base_offset = base_offset + off;
+	}
+	return fd;
+}
+
 void FileAccessPack::set_big_endian(bool p_big_endian) {
 	ERR_FAIL_COND_MSG(f.is_null(), "File must be opened before use.");
 
@@ -544,10 +763,21 @@ FileAccessPack::FileAccessPack(const String &p_path, const PackedData::PackedFil
 		ERR_FAIL_COND_MSG(f.is_null(), vformat(R"(Can't open pack-referenced file "%s" from sparse pack "%s".)", simplified_path, pf.pack));
 		off = 0; // For the sparse pack offset is always zero.
 	} else {
-		f = FileAccess::open(pf.pack, FileAccess::READ);
-		ERR_FAIL_COND_MSG(f.is_null(), vformat(R"(Can't open pack-referenced file "%s" from pack "%s".)", p_path, pf.pack));
-		f->seek(pf.offset);
-		off = pf.offset;
+		if (!pf.encrypted && PackedData::get_singleton()->is_memory_mapping_enabled()) {
+			// Map only this file, reads then don't have to go through the buffered pack file.
+			Ref<FileAccessMapped> fam = FileAccessMapped::open_range(pf.pack, pf.offset, pf.size);
+			if (fam.is_valid()) {
+				fam->set_access_hint(FileAccessMapped::ACCESS_HINT_SEQUENTIAL);
+				f = fam;
+				off = 0;
+			}
+		}
+		if (f.is_null()) {
+			f = FileAccess::open(pf.pack, FileAccess::READ);
+			ERR_FAIL_COND_MSG(f.is_null(), vformat(R"(Can't open pack-referenced file "%s" from pack "%s".)", p_path, pf.pack));
+			f->seek(pf.offset);
+			off = pf.offset;
+		}
 	}
 
 	if (pf.encrypted) {
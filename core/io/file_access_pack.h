@@ -32,10 +32,13 @@
 
 #include "core/io/dir_access.h"
 #include "core/io/file_access.h"
+#include "core/io/file_access_mapped.h"
 #include "core/io/resource_uid.h"
+#include "core/os/mutex.h"
 #include "core/string/print_string.h"
 #include "core/templates/hash_set.h"
 #include "core/templates/list.h"
+#include "core/templates/local_vector.h"
 
 // Godot's packed file magic header ("GDPC" in ASCII).
 #define PACK_HEADER_MAGIC 0x43504447
@@ -43,20 +46,27 @@
 #define PACK_FORMAT_VERSION_V2 2
 #define PACK_FORMAT_VERSION_V3 3
 #define PACK_FORMAT_VERSION_V4 4
+#define PACK_FORMAT_VERSION_V5 5
 
 // The current packed file format version number.
+// Chunked packs use V5, older versions can't read their chunked files.
 #define PACK_FORMAT_VERSION PACK_FORMAT_VERSION_V4
 
+// Offset of the chunks which are stored in another pack.
+#define PACK_CHUNK_EXTERNAL UINT64_MAX
+
 enum PackFlags {
 	PACK_DIR_ENCRYPTED = 1 << 0,
 	PACK_REL_FILEBASE = 1 << 1,
 	PACK_SPARSE_BUNDLE = 1 << 2,
+	PACK_CHUNKED = 1 << 3,
 };
 
 enum PackFileFlags {
 	PACK_FILE_ENCRYPTED = 1 << 0,
 	PACK_FILE_REMOVAL = 1 << 1,
 	PACK_FILE_DELTA = 1 << 2,
+	PACK_FILE_CHUNKED = 1 << 3,
 };
 
 class PackSource;
@@ -77,6 +87,29 @@ public:
 		bool bundle;
 		bool delta;
 		String salt;
+		bool chunked = false;
+		Vector<uint32_t> chunks; // Chunk IDs of chunked files.
+	};
+
+	// SHA-256 of the data of a chunk.
+	struct ChunkHash {
+		uint8_t sha256[32] = {};
+
+		bool operator==(const ChunkHash &p_val) const {
+			return memcmp(sha256, p_val.sha256, sizeof(sha256)) == 0;
+		}
+		static uint32_t hash(const ChunkHash &p_val) {
+			// The bytes of the hash are already uniformly distributed.
+			uint32_t h;
+			memcpy(&h, p_val.sha256, sizeof(h));
+			return h;
+		}
+	};
+
+	struct Chunk {
+		String pack;
+		uint64_t offset = 0;
+		uint32_t size = 0;
 	};
 
 private:
@@ -110,12 +143,23 @@ private:
 	HashMap<PathMD5, PackedFile, PathMD5> files;
 	HashMap<PathMD5, Vector<PackedFile>, PathMD5> delta_patches;
 
+	// Chunks of all the chunked packs, stored once per content so packs loaded later can reference them.
+	LocalVector<Chunk> chunks;
+	HashMap<ChunkHash, uint32_t, ChunkHash> chunk_ids;
+
 	Vector<PackSource *> sources;
 
 	PackedDir *root = nullptr;
 
 	static inline PackedData *singleton = nullptr;
 	bool disabled = false;
+	bool memory_mapping = true;
+
+	// Whole packs mapped for get_mapped_pack_data(), only unmapped when PackedData is destroyed.
+	// Mappings of packs added again are retired rather than unmapped, as loaded data may still reference them.
+	HashMap<String, Ref<FileAccessMapped>> mapped_packs;
+	LocalVector<Ref<FileAccessMapped>> retired_mapped_packs;
+	Mutex mapped_packs_mutex;
 
 	void _free_packed_dirs(PackedDir *p_dir);
 	void _get_file_paths(PackedDir *p_dir, const String &p_parent_dir, HashSet<String> &r_paths) const;
@@ -131,16 +175,27 @@ private:
 
 public:
 	void add_pack_source(PackSource *p_source);
-	void add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted = false, bool p_bundle = false, bool p_delta = false, const String &p_salt = String()); // for PackSource
+	void add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted = false, bool p_bundle = false, bool p_delta = false, const String &p_salt = String(), const Vector<uint32_t> *p_chunks = nullptr); // for PackSource
 	void remove_path(const String &p_path);
 	uint8_t *get_file_hash(const String &p_path);
 	Vector<PackedFile> get_delta_patches(const String &p_path) const;
 	bool has_delta_patches(const String &p_path) const;
 	HashSet<String> get_file_paths() const;
 
+	// Returns the ID of the chunk, which is the one of the chunk already added with the same hash if any.
+	uint32_t add_chunk(const ChunkHash &p_hash, const String &p_pack, uint64_t p_offset, uint32_t p_size);
+	int64_t find_chunk(const ChunkHash &p_hash) const;
+	Chunk get_chunk(uint32_t p_id) const;
+
 	void set_disabled(bool p_disabled) { disabled = p_disabled; }
 	_FORCE_INLINE_ bool is_disabled() const { return disabled; }
 
+	// When supported, plain (not encrypted nor sparse) files are read from a memory mapping of the pack.
+	void set_memory_mapping_enabled(bool p_enabled) { memory_mapping = p_enabled; }
+	_FORCE_INLINE_ bool is_memory_mapping_enabled() const { return memory_mapping; }
+	// Returns copy-on-write memory mapped data of a pack, which stays valid until PackedData is destroyed, or nullptr if the pack can't be mapped.
+	uint8_t *get_mapped_pack_data(const String &p_pack, uint64_t p_offset, uint64_t p_length);
+
 	static PackedData *get_singleton() { return singleton; }
 	Error add_pack(const String &p_path, bool p_replace_files, uint64_t p_offset, const Vector<uint8_t> &p_decryption_key = Vector<uint8_t>());
 
@@ -167,6 +222,9 @@ public:
 
 class PackedSourcePCK : public PackSource {
 public:
+	// Reads the chunk table of a chunked pack. Chunk offsets are relative to the files base of the pack.
+	static Error read_chunk_table(const Ref<FileAccess> &p_file, uint64_t p_offset, LocalVector<PackedData::ChunkHash> &r_hashes, LocalVector<PackedData::Chunk> &r_chunks, LocalVector<uint32_t> &r_chunk_lists);
+
 	virtual bool try_open_pack(const String &p_path, bool p_replace_files, uint64_t p_offset, const Vector<uint8_t> &p_decryption_key = Vector<uint8_t>()) override;
 	virtual Ref<FileAccess> get_file(const String &p_path, PackedData::PackedFile *p_file, const Vector<uint8_t> &p_decryption_key = Vector<uint8_t>()) override;
 };
@@ -215,6 +273,11 @@ public:
 	virtual bool eof_reached() const override;
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override;
+	virtual Span<uint8_t> get_buffer_view(uint64_t p_length) const override;
+	virtual uint8_t *get_persistent_buffer(uint64_t p_length) const override;
+	virtual uint64_t get_buffer_at(uint8_t *p_dst, uint64_t p_position, uint64_t p_length) const override;
+	virtual bool has_thread_safe_reads() const override;
+	virtual int get_native_fd(uint64_t &r_base_offset) const override;
 
 	virtual void set_big_endian(bool p_big_endian) override;
 
@@ -36,9 +36,19 @@
 #include "core/io/resource_loader.h"
 #include "core/math/math_funcs.h"
 #include "core/object/class_db.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
 #include "core/variant/dictionary.h"
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define IMAGE_SSE2
+#include <emmintrin.h>
+#elif (defined(__aarch64__) && defined(__ARM_NEON)) || defined(_M_ARM64)
+#define IMAGE_NEON
+#include <arm_neon.h>
+#endif
+
 const char *Image::format_names[Image::FORMAT_MAX] = {
 	"Lum8",
 	"LumAlpha8",
@@ -883,6 +893,186 @@ static double _bicubic_interp_kernel(double x) {
 	return bc;
 }
 
+// Resizing and mipmap generation of large images is split in bands of rows,
+// which are processed by the worker thread pool.
+#define IMAGE_PARALLEL_MIN_PIXELS (256 * 256)
+
+struct _ImageRowBands {
+	const void *func = nullptr;
+	void (*call)(const void *, uint32_t, uint32_t) = nullptr;
+	uint32_t rows = 0;
+	uint32_t band_rows = 0;
+
+	static void process_band(void *p_userdata, uint32_t p_band) {
+		const _ImageRowBands *bands = (const _ImageRowBands *)p_userdata;
+		uint32_t from = p_band * bands->band_rows;
+		bands->call(bands->func, from, MIN(from + bands->band_rows, bands->rows));
+	}
+};
+
+// Calls `p_func(from, to)` on ranges of rows covering `[0, p_rows)`, in parallel if there are enough pixels.
+// Threads of the pool process all the rows themselves, as waiting for other tasks from there can deadlock.
+template <typename F>
+static void _process_row_bands(uint32_t p_rows, uint64_t p_pixels, const F &p_func) {
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	if (p_rows < 2 || p_pixels < IMAGE_PARALLEL_MIN_PIXELS || pool == nullptr || pool->get_thread_count() < 2 || pool->get_thread_index() != -1) {
+		p_func(0u, p_rows);
+		return;
+	}
+
+	// A few bands per thread, so threads finishing early can take some work from the slower ones.
+	uint32_t band_count = MIN(p_rows, uint32_t(pool->get_thread_count()) * 4);
+
+	_ImageRowBands bands;
+	bands.func = &p_func;
+	bands.call = [](const void *p_f, uint32_t p_from, uint32_t p_to) {
+		(*(const F *)p_f)(p_from, p_to);
+	};
+	bands.rows = p_rows;
+	bands.band_rows = Math::division_round_up(p_rows, band_count);
+	band_count = Math::division_round_up(p_rows, bands.band_rows);
+
+	WorkerThreadPool::GroupID group = pool->add_native_group_task(&_ImageRowBands::process_band, &bands, band_count, -1, true, "Process image rows");
+	pool->wait_for_group_task_completion(group);
+}
+
+struct _ImageBilinearColumn {
+	// Offsets of the source pixels, in components.
+	uint32_t left = 0;
+	uint32_t right = 0;
+	uint32_t frac = 0;
+};
+
+#if defined(IMAGE_SSE2) || defined(IMAGE_NEON)
+
+// The four channels of a pixel are processed in one vector, with the exact same arithmetic as the scalar
+// paths of _scale_bilinear() and average_4_*(), so results don't depend on the platform.
+
+#ifdef IMAGE_SSE2
+// Low 32 bits of the products of each lane with `p_b`, as SSE2 has no 32-bit multiplication.
+static _FORCE_INLINE_ __m128i _mul_lo_u32(__m128i p_a, uint32_t p_b) {
+	const __m128i b = _mm_set1_epi32(p_b);
+	const __m128i even = _mm_mul_epu32(p_a, b);
+	const __m128i odd = _mm_mul_epu32(_mm_srli_epi64(p_a, 32), b);
+	return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)), _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+}
+
+static _FORCE_INLINE_ __m128i _load_rgba8_fixed(const uint8_t *p_src) {
+	int32_t pixel;
+	memcpy(&pixel, p_src, sizeof(pixel));
+	const __m128i zero = _mm_setzero_si128();
+	return _mm_slli_epi32(_mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(pixel), zero), zero), 8);
+}
+#else
+static _FORCE_INLINE_ uint32x4_t _load_rgba8_fixed(const uint8_t *p_src) {
+	uint32_t pixel;
+	memcpy(&pixel, p_src, sizeof(pixel));
+	return vshlq_n_u32(vmovl_u16(vget_low_u16(vmovl_u8(vcreate_u8(pixel)))), 8);
+}
+#endif
+
+static void _scale_bilinear_row_rgba8(const uint8_t *__restrict p_up, const uint8_t *__restrict p_down, uint8_t *__restrict p_dst, const _ImageBilinearColumn *p_columns, uint32_t p_count, uint32_t p_yfrac) {
+	// 8 bits of fixed point precision, like _scale_bilinear().
+	for (uint32_t j = 0; j < p_count; j++) {
+		const _ImageBilinearColumn &column = p_columns[j];
+		uint32_t pixel;
+#ifdef IMAGE_SSE2
+		const __m128i p00 = _load_rgba8_fixed(p_up + column.left);
+		const __m128i p10 = _load_rgba8_fixed(p_up + column.right);
+		const __m128i p01 = _load_rgba8_fixed(p_down + column.left);
+		const __m128i p11 = _load_rgba8_fixed(p_down + column.right);
+
+		const __m128i interp_up = _mm_add_epi32(p00, _mm_srli_epi32(_mul_lo_u32(_mm_sub_epi32(p10, p00), column.frac), 8));
+		const __m128i interp_down = _mm_add_epi32(p01, _mm_srli_epi32(_mul_lo_u32(_mm_sub_epi32(p11, p01), column.frac), 8));
+		__m128i interp = _mm_add_epi32(interp_up, _mm_srli_epi32(_mul_lo_u32(_mm_sub_epi32(interp_down, interp_up), p_yfrac), 8));
+		interp = _mm_and_si128(_mm_srli_epi32(interp, 8), _mm_set1_epi32(0xFF));
+		interp = _mm_packs_epi32(interp, interp);
+		pixel = _mm_cvtsi128_si32(_mm_packus_epi16(interp, interp));
+#else
+		const uint32x4_t p00 = _load_rgba8_fixed(p_up + column.left);
+		const uint32x4_t p10 = _load_rgba8_fixed(p_up + column.right);
+		const uint32x4_t p01 = _load_rgba8_fixed(p_down + column.left);
+		const uint32x4_t p11 = _load_rgba8_fixed(p_down + column.right);
+
+		const uint32x4_t interp_up = vaddq_u32(p00, vshrq_n_u32(vmulq_n_u32(vsubq_u32(p10, p00), column.frac), 8));
+		const uint32x4_t interp_down = vaddq_u32(p01, vshrq_n_u32(vmulq_n_u32(vsubq_u32(p11, p01), column.frac), 8));
+		const uint32x4_t interp = vaddq_u32(interp_up, vshrq_n_u32(vmulq_n_u32(vsubq_u32(interp_down, interp_up), p_yfrac), 8));
+		const uint16x4_t narrow = vmovn_u32(vshrq_n_u32(interp, 8));
+		pixel = vget_lane_u32(vreinterpret_u32_u8(vmovn_u16(vcombine_u16(narrow, narrow))), 0);
+#endif
+		memcpy(p_dst + j * 4, &pixel, sizeof(pixel));
+	}
+}
+
+static void _scale_bilinear_row_rgbaf(const float *__restrict p_up, const float *__restrict p_down, float *__restrict p_dst, const _ImageBilinearColumn *p_columns, uint32_t p_count, float p_yfrac) {
+	for (uint32_t j = 0; j < p_count; j++) {
+		const _ImageBilinearColumn &column = p_columns[j];
+		const float xofs_frac = float(column.frac) / (1 << 8);
+#ifdef IMAGE_SSE2
+		const __m128 p00 = _mm_loadu_ps(p_up + column.left);
+		const __m128 p10 = _mm_loadu_ps(p_up + column.right);
+		const __m128 p01 = _mm_loadu_ps(p_down + column.left);
+		const __m128 p11 = _mm_loadu_ps(p_down + column.right);
+
+		const __m128 interp_up = _mm_add_ps(p00, _mm_mul_ps(_mm_sub_ps(p10, p00), _mm_set1_ps(xofs_frac)));
+		const __m128 interp_down = _mm_add_ps(p01, _mm_mul_ps(_mm_sub_ps(p11, p01), _mm_set1_ps(xofs_frac)));
+		_mm_storeu_ps(p_dst + j * 4, _mm_add_ps(interp_up, _mm_mul_ps(_mm_sub_ps(interp_down, interp_up), _mm_set1_ps(p_yfrac))));
+#else
+		const float32x4_t p00 = vld1q_f32(p_up + column.left);
+		const float32x4_t p10 = vld1q_f32(p_up + column.right);
+		const float32x4_t p01 = vld1q_f32(p_down + column.left);
+		const float32x4_t p11 = vld1q_f32(p_down + column.right);
+
+		// No fused multiply-add, to round like the scalar code.
+		const float32x4_t interp_up = vaddq_f32(p00, vmulq_f32(vsubq_f32(p10, p00), vdupq_n_f32(xofs_frac)));
+		const float32x4_t interp_down = vaddq_f32(p01, vmulq_f32(vsubq_f32(p11, p01), vdupq_n_f32(xofs_frac)));
+		vst1q_f32(p_dst + j * 4, vaddq_f32(interp_up, vmulq_f32(vsubq_f32(interp_down, interp_up), vdupq_n_f32(p_yfrac))));
+#endif
+	}
+}
+
+// Box filters 2x2 blocks of RGBA8 pixels from two rows, two destination pixels at a time.
+// Returns the number of destination pixels written.
+static uint32_t _average_4_row_rgba(const uint8_t *__restrict p_up, const uint8_t *__restrict p_down, uint8_t *__restrict p_dst, uint32_t p_count) {
+	uint32_t i = 0;
+	for (; i + 2 <= p_count; i += 2) {
+#ifdef IMAGE_SSE2
+		const __m128i zero = _mm_setzero_si128();
+		const __m128i up = _mm_loadu_si128((const __m128i *)(p_up + i * 8));
+		const __m128i down = _mm_loadu_si128((const __m128i *)(p_down + i * 8));
+		// Vertical sums of the source pixels 0 and 1, then 2 and 3, followed by the horizontal ones.
+		const __m128i lo = _mm_add_epi16(_mm_unpacklo_epi8(up, zero), _mm_unpacklo_epi8(down, zero));
+		const __m128i hi = _mm_add_epi16(_mm_unpackhi_epi8(up, zero), _mm_unpackhi_epi8(down, zero));
+		const __m128i sum = _mm_add_epi16(_mm_unpacklo_epi64(lo, hi), _mm_unpackhi_epi64(lo, hi));
+		const __m128i avg = _mm_srli_epi16(_mm_add_epi16(sum, _mm_set1_epi16(2)), 2);
+		_mm_storel_epi64((__m128i *)(p_dst + i * 4), _mm_packus_epi16(avg, avg));
+#else
+		const uint8x16_t up = vld1q_u8(p_up + i * 8);
+		const uint8x16_t down = vld1q_u8(p_down + i * 8);
+		const uint16x8_t lo = vaddl_u8(vget_low_u8(up), vget_low_u8(down));
+		const uint16x8_t hi = vaddl_u8(vget_high_u8(up), vget_high_u8(down));
+		const uint16x8_t sum = vaddq_u16(vcombine_u16(vget_low_u16(lo), vget_low_u16(hi)), vcombine_u16(vget_high_u16(lo), vget_high_u16(hi)));
+		vst1_u8(p_dst + i * 4, vmovn_u16(vshrq_n_u16(vaddq_u16(sum, vdupq_n_u16(2)), 2)));
+#endif
+	}
+	return i;
+}
+
+static uint32_t _average_4_row_rgba(const float *__restrict p_up, const float *__restrict p_down, float *__restrict p_dst, uint32_t p_count) {
+	for (uint32_t i = 0; i < p_count; i++) {
+#ifdef IMAGE_SSE2
+		const __m128 sum = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_loadu_ps(p_up + i * 8), _mm_loadu_ps(p_up + i * 8 + 4)), _mm_loadu_ps(p_down + i * 8)), _mm_loadu_ps(p_down + i * 8 + 4));
+		_mm_storeu_ps(p_dst + i * 4, _mm_mul_ps(sum, _mm_set1_ps(0.25f)));
+#else
+		const float32x4_t sum = vaddq_f32(vaddq_f32(vaddq_f32(vld1q_f32(p_up + i * 8), vld1q_f32(p_up + i * 8 + 4)), vld1q_f32(p_down + i * 8)), vld1q_f32(p_down + i * 8 + 4));
+		vst1q_f32(p_dst + i * 4, vmulq_f32(sum, vdupq_n_f32(0.25f)));
+#endif
+	}
+	return p_count;
+}
+
+#endif // IMAGE_SSE2 || IMAGE_NEON
+
 template <int CC, typename T, ImageScaleType TYPE>
 static void _scale_cubic(const uint8_t *__restrict p_src, uint8_t *__restrict p_dst, uint32_t p_src_width, uint32_t p_src_height, uint32_t p_dst_width, uint32_t p_dst_height) {
 	// get source image size
@@ -890,85 +1080,86 @@ static void _scale_cubic(const uint8_t *__restrict p_src, uint8_t *__restrict p_
 	int height = p_src_height;
 	double xfac = (double)width / p_dst_width;
 	double yfac = (double)height / p_dst_height;
-	// coordinates of source points and coefficients
-	double ox, oy, dx, dy;
-	int ox1, oy1, ox2, oy2;
-	// destination pixel values
 	// width and height decreased by 1
 	int ymax = height - 1;
 	int xmax = width - 1;
-	// temporary pointer
-
-	for (uint32_t y = 0; y < p_dst_height; y++) {
-		// Y coordinates
-		oy = (double)(y + 0.5) * yfac - 0.5;
-		oy1 = (int)oy;
-		dy = oy - (double)oy1;
 
-		for (uint32_t x = 0; x < p_dst_width; x++) {
-			// X coordinates
-			ox = (double)(x + 0.5) * xfac - 0.5;
-			ox1 = (int)ox;
-			dx = ox - (double)ox1;
+	_process_row_bands(p_dst_height, uint64_t(p_dst_width) * p_dst_height, [&](uint32_t p_from, uint32_t p_to) {
+		// coordinates of source points and coefficients
+		double ox, oy, dx, dy;
+		int ox1, oy1, ox2, oy2;
 
-			// initial pixel value
+		for (uint32_t y = p_from; y < p_to; y++) {
+			// Y coordinates
+			oy = (double)(y + 0.5) * yfac - 0.5;
+			oy1 = (int)oy;
+			dy = oy - (double)oy1;
 
-			T *__restrict dst = ((T *)p_dst) + (y * p_dst_width + x) * CC;
+			for (uint32_t x = 0; x < p_dst_width; x++) {
+				// X coordinates
+				ox = (double)(x + 0.5) * xfac - 0.5;
+				ox1 = (int)ox;
+				dx = ox - (double)ox1;
 
-			double color[CC] = {};
+				// initial pixel value
 
-			for (int n = -1; n < 3; n++) {
-				// get Y coefficient
-				[[maybe_unused]] double k1 = _bicubic_interp_kernel(dy - (double)n);
+				T *__restrict dst = ((T *)p_dst) + (y * p_dst_width + x) * CC;
 
-				oy2 = oy1 + n;
-				if (oy2 < 0) {
-					oy2 = 0;
-				}
-				if (oy2 > ymax) {
-					oy2 = ymax;
-				}
+				double color[CC] = {};
 
-				for (int m = -1; m < 3; m++) {
-					// get X coefficient
-					[[maybe_unused]] double k2 = k1 * _bicubic_interp_kernel((double)m - dx);
+				for (int n = -1; n < 3; n++) {
+					// get Y coefficient
+					[[maybe_unused]] double k1 = _bicubic_interp_kernel(dy - (double)n);
 
-					ox2 = ox1 + m;
-					if (ox2 < 0) {
-						ox2 = 0;
+					oy2 = oy1 + n;
+					if (oy2 < 0) {
+						oy2 = 0;
 					}
-					if (ox2 > xmax) {
-						ox2 = xmax;
+					if (oy2 > ymax) {
+						oy2 = ymax;
 					}
 
-					// get pixel of original image
-					const T *__restrict p = ((T *)p_src) + (oy2 * p_src_width + ox2) * CC;
+					for (int m = -1; m < 3; m++) {
+						// get X coefficient
+						[[maybe_unused]] double k2 = k1 * _bicubic_interp_kernel((double)m - dx);
 
-					for (int i = 0; i < CC; i++) {
-						if constexpr (sizeof(T) == 2 && TYPE == IMAGE_SCALING_FLOAT) { //half float
-							color[i] = Math::half_to_float(p[i]);
-						} else {
-							color[i] += p[i] * k2;
+						ox2 = ox1 + m;
+						if (ox2 < 0) {
+							ox2 = 0;
+						}
+						if (ox2 > xmax) {
+							ox2 = xmax;
+						}
+
+						// get pixel of original image
+						const T *__restrict p = ((T *)p_src) + (oy2 * p_src_width + ox2) * CC;
+
+						for (int i = 0; i < CC; i++) {
+							if constexpr (sizeof(T) == 2 && TYPE == IMAGE_SCALING_FLOAT) { //half float
+								color[i] = Math::half_to_float(p[i]);
+							} else {
+								color[i] += p[i] * k2;
+							}
 						}
 					}
 				}
-			}
 
-			for (int i = 0; i < CC; i++) {
-				if constexpr (sizeof(T) == 1) { //byte
-					dst[i] = CLAMP(Math::fast_ftoi(color[i]), 0, 255);
-				} else if constexpr (sizeof(T) == 2) {
-					if constexpr (TYPE == IMAGE_SCALING_FLOAT) {
-						dst[i] = Math::make_half_float(color[i]); //half float
+				for (int i = 0; i < CC; i++) {
+					if constexpr (sizeof(T) == 1) { //byte
+						dst[i] = CLAMP(Math::fast_ftoi(color[i]), 0, 255);
+					} else if constexpr (sizeof(T) == 2) {
+						if constexpr (TYPE == IMAGE_SCALING_FLOAT) {
+							dst[i] = Math::make_half_float(color[i]); //half float
+						} else {
+							dst[i] = CLAMP(Math::fast_ftoi(color[i]), 0, 65535); // uint16
+						}
 					} else {
-						dst[i] = CLAMP(Math::fast_ftoi(color[i]), 0, 65535); // uint16
+						dst[i] = color[i];
 					}
-				} else {
-					dst[i] = color[i];
 				}
 			}
 		}
-	}
+	});
 }
 
 template <int CC, typename T, ImageScaleType TYPE>
@@ -978,65 +1169,105 @@ static void _scale_bilinear(const uint8_t *__restrict p_src, uint8_t *__restrict
 	constexpr uint32_t FRAC_HALF = (FRAC_LEN >> 1);
 	constexpr uint32_t FRAC_MASK = FRAC_LEN - 1;
 
-	for (uint32_t i = 0; i < p_dst_height; i++) {
-		// Add 0.5 in order to interpolate based on pixel center
-		uint32_t src_yofs_up_fp = (i + 0.5) * p_src_height * FRAC_LEN / p_dst_height;
-		// Calculate nearest src pixel center above current, and truncate to get y index
-		uint32_t src_yofs_up = src_yofs_up_fp >= FRAC_HALF ? (src_yofs_up_fp - FRAC_HALF) >> FRAC_BITS : 0;
-		uint32_t src_yofs_down = (src_yofs_up_fp + FRAC_HALF) >> FRAC_BITS;
-		if (src_yofs_down >= p_src_height) {
-			src_yofs_down = p_src_height - 1;
+	// The horizontal sampling positions are the same for all rows.
+	LocalVector<_ImageBilinearColumn> columns;
+	columns.resize(p_dst_width);
+	for (uint32_t j = 0; j < p_dst_width; j++) {
+		uint32_t src_xofs_left_fp = (j + 0.5) * p_src_width * FRAC_LEN / p_dst_width;
+		uint32_t src_xofs_left = src_xofs_left_fp >= FRAC_HALF ? (src_xofs_left_fp - FRAC_HALF) >> FRAC_BITS : 0;
+		uint32_t src_xofs_right = (src_xofs_left_fp + FRAC_HALF) >> FRAC_BITS;
+		if (src_xofs_right >= p_src_width) {
+			src_xofs_right = p_src_width - 1;
 		}
-		// Calculate distance to pixel center of src_yofs_up
-		uint32_t src_yofs_frac = src_yofs_up_fp & FRAC_MASK;
-		src_yofs_frac = src_yofs_frac >= FRAC_HALF ? src_yofs_frac - FRAC_HALF : src_yofs_frac + FRAC_HALF;
-
-		uint32_t y_ofs_up = src_yofs_up * p_src_width * CC;
-		uint32_t y_ofs_down = src_yofs_down * p_src_width * CC;
-
-		for (uint32_t j = 0; j < p_dst_width; j++) {
-			uint32_t src_xofs_left_fp = (j + 0.5) * p_src_width * FRAC_LEN / p_dst_width;
-			uint32_t src_xofs_left = src_xofs_left_fp >= FRAC_HALF ? (src_xofs_left_fp - FRAC_HALF) >> FRAC_BITS : 0;
-			uint32_t src_xofs_right = (src_xofs_left_fp + FRAC_HALF) >> FRAC_BITS;
-			if (src_xofs_right >= p_src_width) {
-				src_xofs_right = p_src_width - 1;
+		uint32_t src_xofs_frac = src_xofs_left_fp & FRAC_MASK;
+		src_xofs_frac = src_xofs_frac >= FRAC_HALF ? src_xofs_frac - FRAC_HALF : src_xofs_frac + FRAC_HALF;
+
+		columns[j].left = src_xofs_left * CC;
+		columns[j].right = src_xofs_right * CC;
+		columns[j].frac = src_xofs_frac;
+	}
+
+	_process_row_bands(p_dst_height, uint64_t(p_dst_width) * p_dst_height, [&](uint32_t p_from, uint32_t p_to) {
+		for (uint32_t i = p_from; i < p_to; i++) {
+			// Add 0.5 in order to interpolate based on pixel center
+			uint32_t src_yofs_up_fp = (i + 0.5) * p_src_height * FRAC_LEN / p_dst_height;
+			// Calculate nearest src pixel center above current, and truncate to get y index
+			uint32_t src_yofs_up = src_yofs_up_fp >= FRAC_HALF ? (src_yofs_up_fp - FRAC_HALF) >> FRAC_BITS : 0;
+			uint32_t src_yofs_down = (src_yofs_up_fp + FRAC_HALF) >> FRAC_BITS;
+			if (src_yofs_down >= p_src_height) {
+				src_yofs_down = p_src_height - 1;
 			}
-			uint32_t src_xofs_frac = src_xofs_left_fp & FRAC_MASK;
-			src_xofs_frac = src_xofs_frac >= FRAC_HALF ? src_xofs_frac - FRAC_HALF : src_xofs_frac + FRAC_HALF;
-
-			src_xofs_left *= CC;
-			src_xofs_right *= CC;
-
-			for (uint32_t l = 0; l < CC; l++) {
-				if constexpr (sizeof(T) == 1) { //uint8
-					uint32_t p00 = p_src[y_ofs_up + src_xofs_left + l] << FRAC_BITS;
-					uint32_t p10 = p_src[y_ofs_up + src_xofs_right + l] << FRAC_BITS;
-					uint32_t p01 = p_src[y_ofs_down + src_xofs_left + l] << FRAC_BITS;
-					uint32_t p11 = p_src[y_ofs_down + src_xofs_right + l] << FRAC_BITS;
-
-					uint32_t interp_up = p00 + (((p10 - p00) * src_xofs_frac) >> FRAC_BITS);
-					uint32_t interp_down = p01 + (((p11 - p01) * src_xofs_frac) >> FRAC_BITS);
-					uint32_t interp = interp_up + (((interp_down - interp_up) * src_yofs_frac) >> FRAC_BITS);
-					interp >>= FRAC_BITS;
-					p_dst[i * p_dst_width * CC + j * CC + l] = uint8_t(interp);
-				} else if constexpr (sizeof(T) == 2) {
-					if constexpr (TYPE == IMAGE_SCALING_FLOAT) { //half float
-						float xofs_frac = float(src_xofs_frac) / (1 << FRAC_BITS);
-						float yofs_frac = float(src_yofs_frac) / (1 << FRAC_BITS);
-						const T *src = ((const T *)p_src);
-						T *dst = ((T *)p_dst);
+			// Calculate distance to pixel center of src_yofs_up
+			uint32_t src_yofs_frac = src_yofs_up_fp & FRAC_MASK;
+			src_yofs_frac = src_yofs_frac >= FRAC_HALF ? src_yofs_frac - FRAC_HALF : src_yofs_frac + FRAC_HALF;
 
-						float p00 = Math::half_to_float(src[y_ofs_up + src_xofs_left + l]);
-						float p10 = Math::half_to_float(src[y_ofs_up + src_xofs_right + l]);
-						float p01 = Math::half_to_float(src[y_ofs_down + src_xofs_left + l]);
-						float p11 = Math::half_to_float(src[y_ofs_down + src_xofs_right + l]);
+			uint32_t y_ofs_up = src_yofs_up * p_src_width * CC;
+			uint32_t y_ofs_down = src_yofs_down * p_src_width * CC;
 
-						float interp_up = p00 + (p10 - p00) * xofs_frac;
-						float interp_down = p01 + (p11 - p01) * xofs_frac;
-						float interp = interp_up + ((interp_down - interp_up) * yofs_frac);
+#if defined(IMAGE_SSE2) || defined(IMAGE_NEON)
+			if constexpr (CC == 4 && sizeof(T) == 1) {
+				_scale_bilinear_row_rgba8(p_src + y_ofs_up, p_src + y_ofs_down, p_dst + i * p_dst_width * CC, columns.ptr(), p_dst_width, src_yofs_frac);
+				continue;
+			} else if constexpr (CC == 4 && sizeof(T) == 4) {
+				const T *src = ((const T *)p_src);
+				_scale_bilinear_row_rgbaf(src + y_ofs_up, src + y_ofs_down, ((T *)p_dst) + i * p_dst_width * CC, columns.ptr(), p_dst_width, float(src_yofs_frac) / (1 << FRAC_BITS));
+				continue;
+			}
+#endif
+
+			for (uint32_t j = 0; j < p_dst_width; j++) {
+				uint32_t src_xofs_left = columns[j].left;
+				uint32_t src_xofs_right = columns[j].right;
+				uint32_t src_xofs_frac = columns[j].frac;
+
+				for (uint32_t l = 0; l < CC; l++) {
+					if constexpr (sizeof(T) == 1) { //uint8
+						uint32_t p00 = p_src[y_ofs_up + src_xofs_left + l] << FRAC_BITS;
+						uint32_t p10 = p_src[y_ofs_up + src_xofs_right + l] << FRAC_BITS;
+						uint32_t p01 = p_src[y_ofs_down + src_xofs_left + l] << FRAC_BITS;
+						uint32_t p11 = p_src[y_ofs_down + src_xofs_right + l] << FRAC_BITS;
+
+						uint32_t interp_up = p00 + (((p10 - p00) * src_xofs_frac) >> FRAC_BITS);
+						uint32_t interp_down = p01 + (((p11 - p01) * src_xofs_frac) >> FRAC_BITS);
+						uint32_t interp = interp_up + (((interp_down - interp_up) * src_yofs_frac) >> FRAC_BITS);
+						interp >>= FRAC_BITS;
+						p_dst[i * p_dst_width * CC + j * CC + l] = uint8_t(interp);
+					} else if constexpr (sizeof(T) == 2) {
+						if constexpr (TYPE == IMAGE_SCALING_FLOAT) { //half float
+							float xofs_frac = float(src_xofs_frac) / (1 << FRAC_BITS);
+							float yofs_frac = float(src_yofs_frac) / (1 << FRAC_BITS);
+							const T *src = ((const T *)p_src);
+							T *dst = ((T *)p_dst);
+
+							float p00 = Math::half_to_float(src[y_ofs_up + src_xofs_left + l]);
+							float p10 = Math::half_to_float(src[y_ofs_up + src_xofs_right + l]);
+							float p01 = Math::half_to_float(src[y_ofs_down + src_xofs_left + l]);
+							float p11 = Math::half_to_float(src[y_ofs_down + src_xofs_right + l]);
+
+							float interp_up = p00 + (p10 - p00) * xofs_frac;
+							float interp_down = p01 + (p11 - p01) * xofs_frac;
+							float interp = interp_up + ((interp_down - interp_up) * yofs_frac);
+
+							dst[i * p_dst_width * CC + j * CC + l] = Math::make_half_float(interp);
+						} else { //uint16
+							float xofs_frac = float(src_xofs_frac) / (1 << FRAC_BITS);
+							float yofs_frac = float(src_yofs_frac) / (1 << FRAC_BITS);
+							const T *src = ((const T *)p_src);
+							T *dst = ((T *)p_dst);
+
+							float p00 = src[y_ofs_up + src_xofs_left + l];
+							float p10 = src[y_ofs_up + src_xofs_right + l];
+							float p01 = src[y_ofs_down + src_xofs_left + l];
+							float p11 = src[y_ofs_down + src_xofs_right + l];
+
+							float interp_up = p00 + (p10 - p00) * xofs_frac;
+							float interp_down = p01 + (p11 - p01) * xofs_frac;
+							float interp = interp_up + ((interp_down - interp_up) * yofs_frac);
+
+							dst[i * p_dst_width * CC + j * CC + l] = uint16_t(interp);
+						}
+					} else if constexpr (sizeof(T) == 4) { //float
 
-						dst[i * p_dst_width * CC + j * CC + l] = Math::make_half_float(interp);
-					} else { //uint16
 						float xofs_frac = float(src_xofs_frac) / (1 << FRAC_BITS);
 						float yofs_frac = float(src_yofs_frac) / (1 << FRAC_BITS);
 						const T *src = ((const T *)p_src);
@@ -1051,50 +1282,35 @@ static void _scale_bilinear(const uint8_t *__restrict p_src, uint8_t *__restrict
 						float interp_down = p01 + (p11 - p01) * xofs_frac;
 						float interp = interp_up + ((interp_down - interp_up) * yofs_frac);
 
-						dst[i * p_dst_width * CC + j * CC + l] = uint16_t(interp);
+						dst[i * p_dst_width * CC + j * CC + l] = interp;
 					}
-				} else if constexpr (sizeof(T) == 4) { //float
-
-					float xofs_frac = float(src_xofs_frac) / (1 << FRAC_BITS);
-					float yofs_frac = float(src_yofs_frac) / (1 << FRAC_BITS);
-					const T *src = ((const T *)p_src);
-					T *dst = ((T *)p_dst);
-
-					float p00 = src[y_ofs_up + src_xofs_left + l];
-					float p10 = src[y_ofs_up + src_xofs_right + l];
-					float p01 = src[y_ofs_down + src_xofs_left + l];
-					float p11 = src[y_ofs_down + src_xofs_right + l];
-
-					float interp_up = p00 + (p10 - p00) * xofs_frac;
-					float interp_down = p01 + (p11 - p01) * xofs_frac;
-					float interp = interp_up + ((interp_down - interp_up) * yofs_frac);
-
-					dst[i * p_dst_width * CC + j * CC + l] = interp;
 				}
 			}
 		}
-	}
+	});
 }
 
 template <int CC, typename T>
 static void _scale_nearest(const uint8_t *__restrict p_src, uint8_t *__restrict p_dst, uint32_t p_src_width, uint32_t p_src_height, uint32_t p_dst_width, uint32_t p_dst_height) {
-	for (uint32_t i = 0; i < p_dst_height; i++) {
-		uint32_t src_yofs = (i + 0.5) * p_src_height / p_dst_height;
-		uint32_t y_ofs = src_yofs * p_src_width * CC;
+	_process_row_bands(p_dst_height, uint64_t(p_dst_width) * p_dst_height, [&](uint32_t p_from, uint32_t p_to) {
+		for (uint32_t i = p_from; i < p_to; i++) {
+			uint32_t src_yofs = (i + 0.5) * p_src_height / p_dst_height;
+			uint32_t y_ofs = src_yofs * p_src_width * CC;
 
-		for (uint32_t j = 0; j < p_dst_width; j++) {
-			uint32_t src_xofs = (j + 0.5) * p_src_width / p_dst_width;
-			src_xofs *= CC;
+			for (uint32_t j = 0; j < p_dst_width; j++) {
+				uint32_t src_xofs = (j + 0.5) * p_src_width / p_dst_width;
+				src_xofs *= CC;
 
-			for (uint32_t l = 0; l < CC; l++) {
-				const T *src = ((const T *)p_src);
-				T *dst = ((T *)p_dst);
+				for (uint32_t l = 0; l < CC; l++) {
+					const T *src = ((const T *)p_src);
+					T *dst = ((T *)p_dst);
 
-				T p = src[y_ofs + src_xofs + l];
-				dst[i * p_dst_width * CC + j * CC + l] = p;
+					T p = src[y_ofs + src_xofs + l];
+					dst[i * p_dst_width * CC + j * CC + l] = p;
+				}
 			}
 		}
-	}
+	});
 }
 
 #define LANCZOS_TYPE 3
@@ -1120,47 +1336,59 @@ static void _scale_lanczos(const uint8_t *__restrict p_src, uint8_t *__restrict
 		float scale_factor = MAX(x_scale, 1); // A larger kernel is required only when downscaling
 		int32_t half_kernel = LANCZOS_TYPE * scale_factor;
 
-		float *kernel = memnew_arr(float, half_kernel * 2);
+		// Create the kernels used by all the pixels of each column, so the rows can be processed independently.
+		LocalVector<int32_t> starts;
+		LocalVector<int32_t> ends;
+		LocalVector<float> kernels;
+		starts.resize(dst_width);
+		ends.resize(dst_width);
+		kernels.resize(dst_width * half_kernel * 2);
 
 		for (int32_t buffer_x = 0; buffer_x < dst_width; buffer_x++) {
 			// The corresponding point on the source image
 			float src_x = (buffer_x + 0.5f) * x_scale; // Offset by 0.5 so it uses the pixel's center
-			int32_t start_x = MAX(0, int32_t(src_x) - half_kernel + 1);
-			int32_t end_x = MIN(src_width - 1, int32_t(src_x) + half_kernel);
+			starts[buffer_x] = MAX(0, int32_t(src_x) - half_kernel + 1);
+			ends[buffer_x] = MIN(src_width - 1, int32_t(src_x) + half_kernel);
 
-			// Create the kernel used by all the pixels of the column
-			for (int32_t target_x = start_x; target_x <= end_x; target_x++) {
-				kernel[target_x - start_x] = _lanczos((target_x + 0.5f - src_x) / scale_factor);
+			float *kernel = &kernels[buffer_x * half_kernel * 2];
+			for (int32_t target_x = starts[buffer_x]; target_x <= ends[buffer_x]; target_x++) {
+				kernel[target_x - starts[buffer_x]] = _lanczos((target_x + 0.5f - src_x) / scale_factor);
 			}
+		}
 
-			for (int32_t buffer_y = 0; buffer_y < src_height; buffer_y++) {
-				float pixel[CC] = { 0 };
-				float weight = 0;
+		_process_row_bands(src_height, uint64_t(dst_width) * src_height * half_kernel, [&](uint32_t p_from, uint32_t p_to) {
+			for (int32_t buffer_y = p_from; buffer_y < int32_t(p_to); buffer_y++) {
+				for (int32_t buffer_x = 0; buffer_x < dst_width; buffer_x++) {
+					const int32_t start_x = starts[buffer_x];
+					const int32_t end_x = ends[buffer_x];
+					const float *kernel = &kernels[buffer_x * half_kernel * 2];
 
-				for (int32_t target_x = start_x; target_x <= end_x; target_x++) {
-					float lanczos_val = kernel[target_x - start_x];
-					weight += lanczos_val;
+					float pixel[CC] = { 0 };
+					float weight = 0;
 
-					const T *__restrict src_data = ((const T *)p_src) + (buffer_y * src_width + target_x) * CC;
+					for (int32_t target_x = start_x; target_x <= end_x; target_x++) {
+						float lanczos_val = kernel[target_x - start_x];
+						weight += lanczos_val;
 
-					for (uint32_t i = 0; i < CC; i++) {
-						if constexpr (sizeof(T) == 2 && TYPE == IMAGE_SCALING_FLOAT) { //half float
-							pixel[i] += Math::half_to_float(src_data[i]) * lanczos_val;
-						} else {
-							pixel[i] += src_data[i] * lanczos_val;
+						const T *__restrict src_data = ((const T *)p_src) + (buffer_y * src_width + target_x) * CC;
+
+						for (uint32_t i = 0; i < CC; i++) {
+							if constexpr (sizeof(T) == 2 && TYPE == IMAGE_SCALING_FLOAT) { //half float
+								pixel[i] += Math::half_to_float(src_data[i]) * lanczos_val;
+							} else {
+								pixel[i] += src_data[i] * lanczos_val;
+							}
 						}
 					}
-				}
 
-				float *dst_data = ((float *)buffer) + (buffer_y * dst_width + buffer_x) * CC;
+					float *dst_data = ((float *)buffer) + (buffer_y * dst_width + buffer_x) * CC;
 
-				for (uint32_t i = 0; i < CC; i++) {
-					dst_data[i] = pixel[i] / weight; // Normalize the sum of all the samples
+					for (uint32_t i = 0; i < CC; i++) {
+						dst_data[i] = pixel[i] / weight; // Normalize the sum of all the samples
+					}
 				}
 			}
-		}
-
-		memdelete_arr(kernel);
+		});
 	} // End of first pass
 
 	{ // SECOND PASS (vertical + result)
@@ -1170,54 +1398,56 @@ static void _scale_lanczos(const uint8_t *__restrict p_src, uint8_t *__restrict
 		float scale_factor = MAX(y_scale, 1);
 		int32_t half_kernel = LANCZOS_TYPE * scale_factor;
 
-		float *kernel = memnew_arr(float, half_kernel * 2);
+		_process_row_bands(dst_height, uint64_t(dst_width) * dst_height * half_kernel, [&](uint32_t p_from, uint32_t p_to) {
+			float *kernel = memnew_arr(float, half_kernel * 2);
 
-		for (int32_t dst_y = 0; dst_y < dst_height; dst_y++) {
-			float buffer_y = (dst_y + 0.5f) * y_scale;
-			int32_t start_y = MAX(0, int32_t(buffer_y) - half_kernel + 1);
-			int32_t end_y = MIN(src_height - 1, int32_t(buffer_y) + half_kernel);
+			for (int32_t dst_y = p_from; dst_y < int32_t(p_to); dst_y++) {
+				float buffer_y = (dst_y + 0.5f) * y_scale;
+				int32_t start_y = MAX(0, int32_t(buffer_y) - half_kernel + 1);
+				int32_t end_y = MIN(src_height - 1, int32_t(buffer_y) + half_kernel);
 
-			for (int32_t target_y = start_y; target_y <= end_y; target_y++) {
-				kernel[target_y - start_y] = _lanczos((target_y + 0.5f - buffer_y) / scale_factor);
-			}
+				for (int32_t target_y = start_y; target_y <= end_y; target_y++) {
+					kernel[target_y - start_y] = _lanczos((target_y + 0.5f - buffer_y) / scale_factor);
+				}
 
-			for (int32_t dst_x = 0; dst_x < dst_width; dst_x++) {
-				float pixel[CC] = { 0 };
-				float weight = 0;
+				for (int32_t dst_x = 0; dst_x < dst_width; dst_x++) {
+					float pixel[CC] = { 0 };
+					float weight = 0;
 
-				for (int32_t target_y = start_y; target_y <= end_y; target_y++) {
-					float lanczos_val = kernel[target_y - start_y];
-					weight += lanczos_val;
+					for (int32_t target_y = start_y; target_y <= end_y; target_y++) {
+						float lanczos_val = kernel[target_y - start_y];
+						weight += lanczos_val;
 
-					float *buffer_data = ((float *)buffer) + (target_y * dst_width + dst_x) * CC;
+						float *buffer_data = ((float *)buffer) + (target_y * dst_width + dst_x) * CC;
 
-					for (uint32_t i = 0; i < CC; i++) {
-						pixel[i] += buffer_data[i] * lanczos_val;
+						for (uint32_t i = 0; i < CC; i++) {
+							pixel[i] += buffer_data[i] * lanczos_val;
+						}
 					}
-				}
 
-				T *dst_data = ((T *)p_dst) + (dst_y * dst_width + dst_x) * CC;
+					T *dst_data = ((T *)p_dst) + (dst_y * dst_width + dst_x) * CC;
 
-				for (uint32_t i = 0; i < CC; i++) {
-					pixel[i] /= weight;
+					for (uint32_t i = 0; i < CC; i++) {
+						pixel[i] /= weight;
+
+						if constexpr (sizeof(T) == 1) { //byte
+							dst_data[i] = CLAMP(Math::fast_ftoi(pixel[i]), 0, 255);
+						} else if constexpr (sizeof(T) == 2) {
+							if constexpr (TYPE == IMAGE_SCALING_FLOAT) { //half float
+								dst_data[i] = Math::make_half_float(pixel[i]);
+							} else { //uint16
+								dst_data[i] = CLAMP(Math::fast_ftoi(pixel[i]), 0, 65535);
+							}
 
-					if constexpr (sizeof(T) == 1) { //byte
-						dst_data[i] = CLAMP(Math::fast_ftoi(pixel[i]), 0, 255);
-					} else if constexpr (sizeof(T) == 2) {
-						if constexpr (TYPE == IMAGE_SCALING_FLOAT) { //half float
-							dst_data[i] = Math::make_half_float(pixel[i]);
-						} else { //uint16
-							dst_data[i] = CLAMP(Math::fast_ftoi(pixel[i]), 0, 65535);
+						} else { // float
+							dst_data[i] = pixel[i];
 						}
-
-					} else { // float
-						dst_data[i] = pixel[i];
 					}
 				}
 			}
-		}
 
-		memdelete_arr(kernel);
+			memdelete_arr(kernel);
+		});
 	} // End of second pass
 
 	memdelete_arr(buffer);
@@ -1968,27 +2198,42 @@ static void _generate_po2_mipmap(const Component *p_src, Component *p_dst, uint3
 	int right_step = (p_width == 1) ? 0 : CC;
 	int down_step = (p_height == 1) ? 0 : (p_width * CC);
 
-	for (uint32_t i = 0; i < dst_h; i++) {
-		const Component *rup_ptr = &p_src[i * 2 * down_step];
-		const Component *rdown_ptr = rup_ptr + down_step;
-		Component *dst_ptr = &p_dst[i * dst_w * CC];
-		uint32_t count = dst_w;
-
-		while (count) {
-			count--;
-			for (int j = 0; j < CC; j++) {
-				average_func(dst_ptr[j], rup_ptr[j], rup_ptr[j + right_step], rdown_ptr[j], rdown_ptr[j + right_step]);
+	_process_row_bands(dst_h, uint64_t(dst_w) * dst_h, [&](uint32_t p_from, uint32_t p_to) {
+		for (uint32_t i = p_from; i < p_to; i++) {
+			const Component *rup_ptr = &p_src[i * 2 * down_step];
+			const Component *rdown_ptr = rup_ptr + down_step;
+			Component *dst_ptr = &p_dst[i * dst_w * CC];
+			uint32_t count = dst_w;
+
+#if defined(IMAGE_SSE2) || defined(IMAGE_NEON)
+			// RGBA8 and RGBAF, the only formats of four uint8_t or float components.
+			if constexpr (CC == 4 && !renormalize && (std::is_same_v<Component, uint8_t> || std::is_same_v<Component, float>)) {
+				if (right_step != 0) {
+					uint32_t done = _average_4_row_rgba(rup_ptr, rdown_ptr, dst_ptr, count);
+					count -= done;
+					dst_ptr += done * CC;
+					rup_ptr += done * CC * 2;
+					rdown_ptr += done * CC * 2;
+				}
 			}
+#endif
 
-			if constexpr (renormalize) {
-				renormalize_func(dst_ptr);
-			}
+			while (count) {
+				count--;
+				for (int j = 0; j < CC; j++) {
+					average_func(dst_ptr[j], rup_ptr[j], rup_ptr[j + right_step], rdown_ptr[j], rdown_ptr[j + right_step]);
+				}
 
-			dst_ptr += CC;
-			rup_ptr += right_step * 2;
-			rdown_ptr += right_step * 2;
+				if constexpr (renormalize) {
+					renormalize_func(dst_ptr);
+				}
+
+				dst_ptr += CC;
+				rup_ptr += right_step * 2;
+				rdown_ptr += right_step * 2;
+			}
 		}
-	}
+	});
 }
 
 void Image::_generate_mipmap_from_format(Image::Format p_format, const uint8_t *p_src, uint8_t *p_dst, uint32_t p_width, uint32_t p_height, bool p_renormalize) {
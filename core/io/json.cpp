@@ -32,6 +32,7 @@
 
 #include "core/config/engine.h"
 #include "core/io/file_access.h"
+#include "core/io/json_stream_parser.h"
 #include "core/object/class_db.h"
 #include "core/object/script_language.h"
 #include "core/variant/container_type_validate.h"
@@ -1569,9 +1570,29 @@ Ref<Resource> ResourceFormatLoaderJSON::load(const String &p_path, const String
 	Ref<JSON> json;
 	json.instantiate();
 
-	Error err = json->parse(FileAccess::get_file_as_string(p_path), Engine::get_singleton()->is_editor_hint());
+	Error err;
+	int err_line = 0;
+	String err_str;
+	if (Engine::get_singleton()->is_editor_hint()) {
+		// The editor needs the text too.
+		err = json->parse(FileAccess::get_file_as_string(p_path), true);
+		err_line = json->get_error_line();
+		err_str = json->get_error_message();
+	} else {
+		// Parse the file as it is read, instead of decoding it all to a String first.
+		Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::READ, &err);
+		if (f.is_null()) {
+			if (r_error) {
+				*r_error = err;
+			}
+			return Ref<Resource>();
+		}
+		Variant data;
+		err = JSONStreamParser::parse_file(f, data, 0, &err_str, &err_line);
+		json->set_data(data);
+	}
 	if (err != OK) {
-		String err_text = "Error parsing JSON file at '" + p_path + "', on line " + itos(json->get_error_line()) + ": " + json->get_error_message();
+		String err_text = "Error parsing JSON file at '" + p_path + "', on line " + itos(err_line) + ": " + err_str;
 
 		if (Engine::get_singleton()->is_editor_hint()) {
 			// If running on editor, still allow opening the JSON so the code editor can edit it.
@@ -0,0 +1,776 @@
+/**************************************************************************/
+/*  json_stream_parser.cpp                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "json_stream_parser.h"
+
+// Big enough for most files to need few reads, small enough to not matter for memory usage.
+static constexpr uint64_t FILE_CHUNK_SIZE = 65536;
+
+const char *JSONStreamParser::tk_name[TK_MAX] = {
+	"'{'",
+	"'}'",
+	"'['",
+	"']'",
+	"identifier",
+	"string",
+	"number",
+	"':'",
+	"','",
+	"EOF",
+};
+
+static _FORCE_INLINE_ void _append_utf8(LocalVector<char> &r_buffer, char32_t p_char) {
+	if (p_char < 0x80) {
+		r_buffer.push_back(p_char);
+	} else if (p_char < 0x800) {
+		r_buffer.push_back(0xC0 | (p_char >> 6));
+		r_buffer.push_back(0x80 | (p_char & 0x3F));
+	} else if (p_char < 0x10000) {
+		r_buffer.push_back(0xE0 | (p_char >> 12));
+		r_buffer.push_back(0x80 | ((p_char >> 6) & 0x3F));
+		r_buffer.push_back(0x80 | (p_char & 0x3F));
+	} else {
+		r_buffer.push_back(0xF0 | (p_char >> 18));
+		r_buffer.push_back(0x80 | ((p_char >> 12) & 0x3F));
+		r_buffer.push_back(0x80 | ((p_char >> 6) & 0x3F));
+		r_buffer.push_back(0x80 | (p_char & 0x3F));
+	}
+}
+
+static _FORCE_INLINE_ bool _parse_hex(const uint8_t *p_hex, char32_t &r_value) {
+	r_value = 0;
+	for (int i = 0; i < 4; i++) {
+		const uint8_t c = p_hex[i];
+		char32_t v;
+		if (is_digit(c)) {
+			v = c - '0';
+		} else if (c >= 'a' && c <= 'f') {
+			v = c - 'a' + 10;
+		} else if (c >= 'A' && c <= 'F') {
+			v = c - 'A' + 10;
+		} else {
+			return false;
+		}
+		r_value = (r_value << 4) | v;
+	}
+	return true;
+}
+
+Error JSONStreamParser::_error(const String &p_message, Error p_error) {
+	err_str = p_message;
+	err_line = line;
+	error = p_error;
+	state = STATE_ERROR;
+	event = EVENT_NONE;
+	return p_error;
+}
+
+void JSONStreamParser::_keep_pending(uint64_t p_from) {
+	const uint64_t size = input_size - p_from;
+	if (input == pending.ptr()) {
+		if (p_from == 0) {
+			return;
+		}
+		memmove(pending.ptr(), pending.ptr() + p_from, size);
+		pending.resize(size);
+	} else {
+		pending.resize(size);
+		memcpy(pending.ptr(), input + p_from, size);
+	}
+	input = pending.ptr();
+	input_size = size;
+	pos = 0;
+}
+
+void JSONStreamParser::feed(const uint8_t *p_data, uint64_t p_size) {
+	ERR_FAIL_COND_MSG(finished, "Can't feed more data after finish().");
+	if (p_size == 0) {
+		return;
+	}
+
+	if (pos == input_size) {
+		// Everything was read, use the data as is.
+		input = p_data;
+		input_size = p_size;
+		pos = 0;
+		return;
+	}
+
+	_keep_pending(pos);
+	pending.resize(input_size + p_size);
+	memcpy(pending.ptr() + input_size, p_data, p_size);
+	input = pending.ptr();
+	input_size = pending.size();
+}
+
+void JSONStreamParser::finish() {
+	finished = true;
+}
+
+Error JSONStreamParser::_scan_string() {
+	const uint64_t start = pos;
+
+	// Find the end of the string first, so escapes are never split between chunks.
+	uint64_t end = start + 1 + string_scan;
+	while (true) {
+		if (end >= input_size) {
+			if (!finished) {
+				string_scan = end - start - 1;
+				_keep_pending(start);
+				return ERR_UNAVAILABLE;
+			}
+			return _error("Unterminated string");
+		}
+
+		const uint8_t c = input[end];
+		if (c == '"') {
+			break;
+		} else if (c == 0) {
+			return _error("Unterminated string");
+		} else if (c == '\\') {
+			if (end + 1 >= input_size && !finished) {
+				string_scan = end - start - 1;
+				_keep_pending(start);
+				return ERR_UNAVAILABLE;
+			}
+			end += 2;
+		} else {
+			end++;
+		}
+	}
+	string_scan = 0;
+
+	string_buffer.clear();
+	uint64_t i = start + 1;
+	while (i < end) {
+		const uint8_t c = input[i];
+		if (c != '\\') {
+			if (c == '\n') {
+				line++;
+			}
+			string_buffer.push_back(c);
+			i++;
+			continue;
+		}
+
+		// Escaped characters.
+		i++;
+		char32_t res = 0;
+		switch (input[i]) {
+			case 'b':
+				res = 8;
+				break;
+			case 't':
+				res = 9;
+				break;
+			case 'n':
+				res = 10;
+				break;
+			case 'f':
+				res = 12;
+				break;
+			case 'r':
+				res = 13;
+				break;
+			case 'u': {
+				if (i + 4 >= end || !_parse_hex(input + i + 1, res)) {
+					return _error("Malformed hex constant in string");
+				}
+				i += 4;
+
+				if ((res & 0xfffffc00) == 0xd800) {
+					if (i + 2 >= end || input[i + 1] != '\\' || input[i + 2] != 'u') {
+						return _error("Invalid UTF-16 sequence in string, unpaired lead surrogate");
+					}
+					i += 2;
+					char32_t trail;
+					if (i + 4 >= end || !_parse_hex(input + i + 1, trail)) {
+						return _error("Malformed hex constant in string");
+					}
+					if ((trail & 0xfffffc00) != 0xdc00) {
+						return _error("Invalid UTF-16 sequence in string, unpaired lead surrogate");
+					}
+					res = (res << 10UL) + trail - ((0xd800 << 10UL) + 0xdc00 - 0x10000);
+					i += 4;
+				} else if ((res & 0xfffffc00) == 0xdc00) {
+					return _error("Invalid UTF-16 sequence in string, unpaired trail surrogate");
+				}
+			} break;
+			case '"':
+			case '\\':
+			case '/': {
+				res = input[i];
+			} break;
+			default: {
+				return _error("Invalid escape sequence");
+			}
+		}
+		_append_utf8(string_buffer, res);
+		i++;
+	}
+	pos = end + 1;
+
+	string_value = String();
+	uint32_t from = 0;
+	// String::append_utf8() skips byte order marks, keep them as characters instead.
+	while (string_buffer.size() - from >= 3 && uint8_t(string_buffer[from]) == 0xef && uint8_t(string_buffer[from + 1]) == 0xbb && uint8_t(string_buffer[from + 2]) == 0xbf) {
+		string_value += char32_t(0xfeff);
+		from += 3;
+	}
+	if (from < string_buffer.size()) {
+		string_value.append_utf8(string_buffer.ptr() + from, string_buffer.size() - from);
+	}
+	return OK;
+}
+
+Error JSONStreamParser::_scan_number() {
+	const uint64_t start = pos;
+	uint64_t end = start;
+	while (end < input_size) {
+		const uint8_t c = input[end];
+		if (!is_digit(c) && c != '-' && c != '+' && c != '.' && c != 'e' && c != 'E') {
+			break;
+		}
+		end++;
+	}
+	if (end == input_size && !finished) {
+		_keep_pending(start);
+		return ERR_UNAVAILABLE;
+	}
+
+	const uint64_t length = end - start;
+	const uint8_t *number = input + start;
+
+	// Integers are parsed exactly, which is also faster.
+	const bool negative = number[0] == '-';
+	uint64_t digits = negative ? 1 : 0;
+	uint64_t value = 0;
+	integer = length > digits && length - digits <= 19;
+	for (; integer && digits < length; digits++) {
+		const uint8_t c = number[digits];
+		if (!is_digit(c) || value > (UINT64_MAX - (c - '0')) / 10) {
+			integer = false;
+			break;
+		}
+		value = value * 10 + (c - '0');
+	}
+	integer = integer && value <= (negative ? uint64_t(INT64_MAX) + 1 : uint64_t(INT64_MAX));
+
+	if (integer) {
+		integer_value = negative ? int64_t(0 - value) : int64_t(value);
+		number_value = negative && value == 0 ? -0.0 : double(integer_value);
+		pos = end;
+		return OK;
+	}
+
+	// Numbers are short, copy them to get the terminating zero expected by String::to_float().
+	char buffer[64];
+	CharString long_number;
+	char *str = buffer;
+	if (length >= sizeof(buffer)) {
+		long_number.resize_uninitialized(length + 1);
+		str = long_number.ptrw();
+	}
+	memcpy(str, number, length);
+	str[length] = 0;
+
+	const char *str_end = str;
+	number_value = String::to_float(str, &str_end);
+	if (str_end == str) {
+		return _error("Unexpected character");
+	}
+	integer_value = int64_t(number_value);
+	pos = start + (str_end - str);
+	return OK;
+}
+
+Error JSONStreamParser::_scan_identifier() {
+	const uint64_t start = pos;
+	uint64_t end = start;
+	while (end < input_size && is_ascii_alphabet_char(input[end])) {
+		end++;
+	}
+	if (end == input_size && !finished) {
+		_keep_pending(start);
+		return ERR_UNAVAILABLE;
+	}
+
+	string_value = String::ascii(Span<char>((const char *)input + start, end - start));
+	pos = end;
+	return OK;
+}
+
+Error JSONStreamParser::_get_token(TokenType &r_type) {
+	if (at_start) {
+		// Skip the byte order mark.
+		static const uint8_t bom[3] = { 0xef, 0xbb, 0xbf };
+		const uint64_t available = MIN(input_size - pos, uint64_t(3));
+		if (available == 0 || memcmp(input + pos, bom, available) == 0) {
+			if (available < 3 && !finished) {
+				_keep_pending(pos);
+				return ERR_UNAVAILABLE;
+			}
+			if (available == 3) {
+				pos += 3;
+			}
+		}
+		at_start = false;
+	}
+
+	while (true) {
+		if (pos >= input_size) {
+			if (!finished) {
+				_keep_pending(pos);
+				return ERR_UNAVAILABLE;
+			}
+			r_type = TK_EOF;
+			return OK;
+		}
+
+		const uint8_t c = input[pos];
+		switch (c) {
+			case '\n': {
+				line++;
+				pos++;
+			} break;
+			case 0: {
+				r_type = TK_EOF;
+				return OK;
+			}
+			case '{': {
+				r_type = TK_CURLY_BRACKET_OPEN;
+				pos++;
+				return OK;
+			}
+			case '}': {
+				r_type = TK_CURLY_BRACKET_CLOSE;
+				pos++;
+				return OK;
+			}
+			case '[': {
+				r_type = TK_BRACKET_OPEN;
+				pos++;
+				return OK;
+			}
+			case ']': {
+				r_type = TK_BRACKET_CLOSE;
+				pos++;
+				return OK;
+			}
+			case ':': {
+				r_type = TK_COLON;
+				pos++;
+				return OK;
+			}
+			case ',': {
+				r_type = TK_COMMA;
+				pos++;
+				return OK;
+			}
+			case '"': {
+				r_type = TK_STRING;
+				return _scan_string();
+			}
+			default: {
+				if (c <= 32) {
+					pos++;
+					break;
+				}
+				if (c == '-' || is_digit(c)) {
+					r_type = TK_NUMBER;
+					return _scan_number();
+				}
+				if (is_ascii_alphabet_char(c)) {
+					r_type = TK_IDENTIFIER;
+					return _scan_identifier();
+				}
+				return _error("Unexpected character");
+			}
+		}
+	}
+}
+
+void JSONStreamParser::_end_value() {
+	if (containers.is_empty()) {
+		state = STATE_END;
+	} else {
+		state = containers[containers.size() - 1] ? STATE_OBJECT_NEXT : STATE_ARRAY_NEXT;
+	}
+}
+
+Error JSONStreamParser::_begin_value(TokenType p_type) {
+	if (containers.size() > Variant::MAX_RECURSION_DEPTH) {
+		return _error("JSON structure is too deep", ERR_OUT_OF_MEMORY);
+	}
+
+	switch (p_type) {
+		case TK_CURLY_BRACKET_OPEN: {
+			containers.push_back(true);
+			state = STATE_OBJECT_KEY;
+			event = EVENT_OBJECT_BEGIN;
+			return OK;
+		}
+		case TK_BRACKET_OPEN: {
+			containers.push_back(false);
+			state = STATE_ARRAY_VALUE;
+			event = EVENT_ARRAY_BEGIN;
+			return OK;
+		}
+		case TK_STRING: {
+			event = EVENT_STRING;
+		} break;
+		case TK_NUMBER: {
+			event = EVENT_NUMBER;
+		} break;
+		case TK_IDENTIFIER: {
+			if (string_value == "true") {
+				event = EVENT_BOOL;
+				bool_value = true;
+			} else if (string_value == "false") {
+				event = EVENT_BOOL;
+				bool_value = false;
+			} else if (string_value == "null") {
+				event = EVENT_NULL;
+			} else {
+				return _error(vformat("Expected 'true', 'false', or 'null', got '%s'", string_value));
+			}
+		} break;
+		default: {
+			return _error(vformat("Expected value, got '%s'", String(tk_name[p_type])));
+		}
+	}
+
+	_end_value();
+	return OK;
+}
+
+Error JSONStreamParser::read() {
+	if (state == STATE_ERROR) {
+		return error;
+	}
+	if (state == STATE_DONE) {
+		return ERR_FILE_EOF;
+	}
+
+	while (true) {
+		TokenType type;
+		Error err = _get_token(type);
+		if (err != OK) {
+			return err;
+		}
+
+		switch (state) {
+			case STATE_VALUE:
+			case STATE_OBJECT_VALUE: {
+				return _begin_value(type);
+			}
+			case STATE_ARRAY_VALUE:
+			case STATE_ARRAY_NEXT: {
+				if (type == TK_BRACKET_CLOSE) {
+					containers.resize(containers.size() - 1);
+					event = EVENT_ARRAY_END;
+					_end_value();
+					return OK;
+				}
+				if (type == TK_EOF) {
+					return _error("Expected ']'");
+				}
+				if (state == STATE_ARRAY_VALUE) {
+					return _begin_value(type);
+				}
+				if (type != TK_COMMA) {
+					return _error("Expected ','");
+				}
+				state = STATE_ARRAY_VALUE;
+			} break;
+			case STATE_OBJECT_KEY:
+			case STATE_OBJECT_NEXT: {
+				if (type == TK_CURLY_BRACKET_CLOSE) {
+					containers.resize(containers.size() - 1);
+					event = EVENT_OBJECT_END;
+					_end_value();
+					return OK;
+				}
+				if (type == TK_EOF) {
+					return _error("Expected '}'");
+				}
+				if (state == STATE_OBJECT_NEXT) {
+					if (type != TK_COMMA) {
+						return _error("Expected '}' or ','");
+					}
+					state = STATE_OBJECT_KEY;
+					break;
+				}
+				if (type != TK_STRING) {
+					return _error("Expected key");
+				}
+				event = EVENT_KEY;
+				state = STATE_OBJECT_COLON;
+				return OK;
+			}
+			case STATE_OBJECT_COLON: {
+				if (type != TK_COLON) {
+					return _error("Expected ':'");
+				}
+				state = STATE_OBJECT_VALUE;
+			} break;
+			case STATE_END: {
+				if (type != TK_EOF) {
+					return _error("Expected 'EOF'");
+				}
+				state = STATE_DONE;
+				event = EVENT_END;
+				return OK;
+			}
+			case STATE_DONE:
+			case STATE_ERROR: {
+				// Handled above.
+			} break;
+		}
+	}
+}
+
+Variant JSONStreamParser::_get_number_variant(uint32_t p_flags) const {
+	if ((p_flags & PARSE_INTEGERS) && integer) {
+		return integer_value;
+	}
+	return number_value;
+}
+
+void JSONStreamParser::_frame_push(bool p_object, uint32_t p_flags) {
+	if (frame_count == frames.size()) {
+		frames.push_back(Frame());
+	}
+	Frame &frame = frames[frame_count++];
+	frame.is_object = p_object;
+	frame.numeric = !p_object && (p_flags & PARSE_TYPED_ARRAYS);
+	frame.integers = !p_object && (p_flags & PARSE_INTEGERS);
+}
+
+void JSONStreamParser::_frame_add(const Variant &p_value, uint32_t p_flags) {
+	Frame &frame = frames[frame_count - 1];
+	if (frame.is_object) {
+		frame.dictionary[frame.key] = p_value;
+		return;
+	}
+
+	if (frame.numeric) {
+		// Not only numbers after all.
+		frame.array.resize(frame.numbers.size());
+		for (uint32_t i = 0; i < frame.numbers.size(); i++) {
+			if (frame.integers) {
+				frame.array[i] = frame.integer_numbers[i];
+			} else {
+				frame.array[i] = frame.numbers[i];
+			}
+		}
+		frame.numeric = false;
+		frame.numbers.clear();
+		frame.integer_numbers.clear();
+	}
+	frame.array.push_back(p_value);
+}
+
+void JSONStreamParser::_frame_add_number(uint32_t p_flags) {
+	Frame &frame = frames[frame_count - 1];
+	if (!frame.numeric) {
+		_frame_add(_get_number_variant(p_flags), p_flags);
+		return;
+	}
+
+	frame.numbers.push_back(number_value);
+	if (frame.integers) {
+		if (integer) {
+			frame.integer_numbers.push_back(integer_value);
+		} else {
+			frame.integers = false;
+			frame.integer_numbers.clear();
+		}
+	}
+}
+
+Variant JSONStreamParser::_frame_pop(uint32_t p_flags) {
+	Frame &frame = frames[--frame_count];
+	Variant value;
+	if (frame.is_object) {
+		value = frame.dictionary;
+	} else if (frame.numeric && !frame.numbers.is_empty()) {
+		if (frame.integers) {
+			PackedInt64Array packed;
+			packed.resize(frame.integer_numbers.size());
+			memcpy(packed.ptrw(), frame.integer_numbers.ptr(), frame.integer_numbers.size() * sizeof(int64_t));
+			value = packed;
+		} else {
+			PackedFloat64Array packed;
+			packed.resize(frame.numbers.size());
+			memcpy(packed.ptrw(), frame.numbers.ptr(), frame.numbers.size() * sizeof(double));
+			value = packed;
+		}
+	} else {
+		value = frame.array;
+	}
+
+	// Keep the frame for reuse, but not its contents.
+	frame.dictionary = Dictionary();
+	frame.array = Array();
+	frame.key = String();
+	frame.numbers.clear();
+	frame.integer_numbers.clear();
+	return value;
+}
+
+Error JSONStreamParser::read_value(Variant &r_value, uint32_t p_flags) {
+	while (true) {
+		Error err = read();
+		if (err != OK) {
+			return err;
+		}
+
+		Variant value;
+		switch (event) {
+			case EVENT_OBJECT_BEGIN:
+			case EVENT_ARRAY_BEGIN: {
+				_frame_push(event == EVENT_OBJECT_BEGIN, p_flags);
+				continue;
+			}
+			case EVENT_OBJECT_END:
+			case EVENT_ARRAY_END: {
+				ERR_FAIL_COND_V_MSG(frame_count == 0, ERR_INVALID_PARAMETER, "Expected a value, not the end of an object or array.");
+				value = _frame_pop(p_flags);
+			} break;
+			case EVENT_KEY: {
+				ERR_FAIL_COND_V_MSG(frame_count == 0, ERR_INVALID_PARAMETER, "Expected a value, not an object key.");
+				frames[frame_count - 1].key = string_value;
+				continue;
+			}
+			case EVENT_STRING: {
+				value = string_value;
+			} break;
+			case EVENT_NUMBER: {
+				if (frame_count > 0) {
+					_frame_add_number(p_flags);
+					continue;
+				}
+				value = _get_number_variant(p_flags);
+			} break;
+			case EVENT_BOOL: {
+				value = bool_value;
+			} break;
+			case EVENT_NULL: {
+			} break;
+			case EVENT_END:
+			case EVENT_NONE: {
+				return ERR_FILE_EOF;
+			}
+		}
+
+		if (frame_count == 0) {
+			r_value = value;
+			return OK;
+		}
+		_frame_add(value, p_flags);
+	}
+}
+
+void JSONStreamParser::reset() {
+	input = nullptr;
+	input_size = 0;
+	pos = 0;
+	pending.clear();
+	finished = false;
+	at_start = true;
+	string_scan = 0;
+	state = STATE_VALUE;
+	containers.clear();
+	line = 0;
+	event = EVENT_NONE;
+	string_value = String();
+	error = OK;
+	err_str = String();
+	err_line = 0;
+	frames.clear();
+	frame_count = 0;
+}
+
+Error JSONStreamParser::_finish_parse(JSONStreamParser &p_parser, Error p_error, Variant &r_value, String *r_err_str, int *r_err_line) {
+	if (p_error != OK) {
+		r_value = Variant();
+	}
+	if (r_err_str) {
+		*r_err_str = p_parser.err_str;
+	}
+	if (r_err_line) {
+		*r_err_line = p_parser.err_line;
+	}
+	return p_error;
+}
+
+Error JSONStreamParser::parse_utf8(Span<uint8_t> p_utf8, Variant &r_value, uint32_t p_flags, String *r_err_str, int *r_err_line) {
+	JSONStreamParser parser;
+	parser.feed(p_utf8);
+	parser.finish();
+
+	Error err = parser.read_value(r_value, p_flags);
+	if (err == OK) {
+		// Only whitespace may follow.
+		err = parser.read();
+	}
+	return _finish_parse(parser, err, r_value, r_err_str, r_err_line);
+}
+
+Error JSONStreamParser::parse_file(const Ref<FileAccess> &p_file, Variant &r_value, uint32_t p_flags, String *r_err_str, int *r_err_line) {
+	ERR_FAIL_COND_V(p_file.is_null(), ERR_INVALID_PARAMETER);
+
+	JSONStreamParser parser;
+	LocalVector<uint8_t> chunk;
+	chunk.resize(FILE_CHUNK_SIZE);
+	bool has_value = false;
+
+	while (true) {
+		const uint64_t size = p_file->get_buffer(chunk.ptr(), FILE_CHUNK_SIZE);
+		parser.feed(chunk.ptr(), size);
+		if (size < FILE_CHUNK_SIZE) {
+			parser.finish();
+		}
+
+		Error err = OK;
+		if (!has_value) {
+			err = parser.read_value(r_value, p_flags);
+			has_value = err == OK;
+		}
+		if (has_value) {
+			// Only whitespace may follow.
+			err = parser.read();
+		}
+		if (err != ERR_UNAVAILABLE) {
+			return _finish_parse(parser, err, r_value, r_err_str, r_err_line);
+		}
+	}
+}
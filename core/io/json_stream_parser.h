@@ -0,0 +1,184 @@
+/**************************************************************************/
+/*  json_stream_parser.h                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/io/file_access.h"
+#include "core/templates/local_vector.h"
+#include "core/variant/variant.h"
+
+// Incremental JSON parser working directly on UTF-8 input.
+// Input is given in chunks of any size with feed(), and read() returns one event at a time (pull parsing).
+// When more input is needed, read() returns ERR_UNAVAILABLE; feed the next chunk, or call finish() at the end of the input.
+// It accepts the same syntax as JSON::parse(), and reports the same error messages and lines.
+class JSONStreamParser {
+public:
+	enum Event {
+		EVENT_NONE,
+		EVENT_OBJECT_BEGIN,
+		EVENT_OBJECT_END,
+		EVENT_ARRAY_BEGIN,
+		EVENT_ARRAY_END,
+		EVENT_KEY, // Object key, see get_string().
+		EVENT_STRING, // See get_string().
+		EVENT_NUMBER, // See get_number(), is_integer() and get_integer().
+		EVENT_BOOL, // See get_bool().
+		EVENT_NULL,
+		EVENT_END, // The whole document was read.
+	};
+
+	enum ParseFlags {
+		// Arrays containing only numbers are returned as PackedFloat64Array (or PackedInt64Array with PARSE_INTEGERS).
+		PARSE_TYPED_ARRAYS = 1,
+		// Numbers written without fraction nor exponent, and fitting in 64 bits, are returned as int instead of float.
+		PARSE_INTEGERS = 2,
+	};
+
+private:
+	enum State {
+		STATE_VALUE,
+		STATE_ARRAY_VALUE, // After '[' or ','.
+		STATE_ARRAY_NEXT, // After a value in an array.
+		STATE_OBJECT_KEY, // After '{' or ','.
+		STATE_OBJECT_COLON,
+		STATE_OBJECT_VALUE,
+		STATE_OBJECT_NEXT, // After a value in an object.
+		STATE_END, // After the root value.
+		STATE_DONE,
+		STATE_ERROR,
+	};
+
+	enum TokenType {
+		TK_CURLY_BRACKET_OPEN,
+		TK_CURLY_BRACKET_CLOSE,
+		TK_BRACKET_OPEN,
+		TK_BRACKET_CLOSE,
+		TK_IDENTIFIER,
+		TK_STRING,
+		TK_NUMBER,
+		TK_COLON,
+		TK_COMMA,
+		TK_EOF,
+		TK_MAX
+	};
+
+	static const char *tk_name[];
+
+	// Unread input, either the last chunk given to feed() or a copy of what was left of previous chunks.
+	const uint8_t *input = nullptr;
+	uint64_t input_size = 0;
+	uint64_t pos = 0;
+	LocalVector<uint8_t> pending;
+	bool finished = false;
+	bool at_start = true;
+
+	// Where to resume scanning a string token, relative to its opening quote, to not scan long strings again for each chunk.
+	uint64_t string_scan = 0;
+
+	State state = STATE_VALUE;
+	LocalVector<bool> containers; // true for objects.
+	int line = 0;
+
+	Event event = EVENT_NONE;
+	String string_value;
+	LocalVector<char> string_buffer;
+	double number_value = 0.0;
+	int64_t integer_value = 0;
+	bool integer = false;
+	bool bool_value = false;
+
+	Error error = OK;
+	String err_str;
+	int err_line = 0;
+
+	// Values being built by read_value().
+	struct Frame {
+		Dictionary dictionary;
+		Array array;
+		String key;
+		bool is_object = false;
+		// With PARSE_TYPED_ARRAYS, numbers are accumulated here until something else is found.
+		bool numeric = true;
+		bool integers = true;
+		LocalVector<double> numbers;
+		LocalVector<int64_t> integer_numbers;
+	};
+	LocalVector<Frame> frames;
+	uint32_t frame_count = 0;
+
+	Error _error(const String &p_message, Error p_error = ERR_PARSE_ERROR);
+	Error _get_token(TokenType &r_type);
+	Error _scan_string();
+	Error _scan_number();
+	Error _scan_identifier();
+	void _keep_pending(uint64_t p_from);
+	Error _begin_value(TokenType p_type);
+	void _end_value();
+
+	Variant _get_number_variant(uint32_t p_flags) const;
+	void _frame_push(bool p_object, uint32_t p_flags);
+	void _frame_add(const Variant &p_value, uint32_t p_flags);
+	void _frame_add_number(uint32_t p_flags);
+	Variant _frame_pop(uint32_t p_flags);
+
+	static Error _finish_parse(JSONStreamParser &p_parser, Error p_error, Variant &r_value, String *r_err_str, int *r_err_line);
+
+public:
+	// The data is only copied when needed, so it must stay valid until read() returns ERR_UNAVAILABLE.
+	void feed(const uint8_t *p_data, uint64_t p_size);
+	void feed(Span<uint8_t> p_data) { feed(p_data.ptr(), p_data.size()); }
+	// Marks the end of the input.
+	void finish();
+
+	// Reads the next event. Returns OK, ERR_UNAVAILABLE when more input is needed, ERR_FILE_EOF after EVENT_END, or a parse error.
+	Error read();
+	Event get_event() const { return event; }
+	// Number of objects and arrays containing the current event.
+	int get_depth() const { return containers.size(); }
+
+	const String &get_string() const { return string_value; }
+	double get_number() const { return number_value; }
+	bool is_integer() const { return integer; }
+	int64_t get_integer() const { return integer_value; }
+	bool get_bool() const { return bool_value; }
+
+	// Reads the next value as a whole (e.g. the root, or a value after EVENT_KEY).
+	// Can be called again after ERR_UNAVAILABLE to resume, once more input has been fed.
+	Error read_value(Variant &r_value, uint32_t p_flags = 0);
+
+	int get_error_line() const { return err_line; }
+	String get_error_message() const { return err_str; }
+
+	void reset();
+
+	static Error parse_utf8(Span<uint8_t> p_utf8, Variant &r_value, uint32_t p_flags = 0, String *r_err_str = nullptr, int *r_err_line = nullptr);
+	// Parses a file in chunks, without loading it all in memory first.
+	static Error parse_file(const Ref<FileAccess> &p_file, Variant &r_value, uint32_t p_flags = 0, String *r_err_str = nullptr, int *r_err_line = nullptr);
+};
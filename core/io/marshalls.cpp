@@ -79,6 +79,162 @@ ObjectID EncodedObjectAsID::get_object_id() const {
 #define HEADER_DATA_FIELD_TYPED_DICTIONARY_VALUE_MASK (0b11 << 18)
 #define HEADER_DATA_FIELD_TYPED_DICTIONARY_VALUE_SHIFT 18
 
+// For `Variant::PACKED_INT32_ARRAY` and `Variant::PACKED_INT64_ARRAY`.
+// The count is followed by the size of the elements in bytes, then by the elements as zigzag varints.
+#define HEADER_DATA_FLAG_VARINT (1 << 16)
+
+// Packed arrays store their elements (or the components of their elements) as little-endian
+// 32-bit or 64-bit words, so on little-endian hosts they are copied as they are in memory.
+static_assert(sizeof(Vector2) == sizeof(real_t) * 2 && sizeof(Vector3) == sizeof(real_t) * 3 && sizeof(Vector4) == sizeof(real_t) * 4 && sizeof(Color) == sizeof(float) * 4);
+
+template <typename W>
+static void _encode_words(const void *p_src, uint8_t *p_dst, int64_t p_count) {
+	if (p_count == 0) {
+		return; // Empty arrays have no data.
+	}
+#ifdef BIG_ENDIAN_ENABLED
+	const uint8_t *src = (const uint8_t *)p_src;
+	for (int64_t i = 0; i < p_count; i++) {
+		W word;
+		memcpy(&word, src + i * sizeof(W), sizeof(W));
+		if constexpr (sizeof(W) == 8) {
+			encode_uint64(word, p_dst + i * sizeof(W));
+		} else {
+			encode_uint32(word, p_dst + i * sizeof(W));
+		}
+	}
+#else
+	memcpy(p_dst, p_src, p_count * sizeof(W));
+#endif
+}
+
+template <typename W>
+static void _decode_words(const uint8_t *p_src, void *p_dst, int64_t p_count) {
+#ifdef BIG_ENDIAN_ENABLED
+	uint8_t *dst = (uint8_t *)p_dst;
+	for (int64_t i = 0; i < p_count; i++) {
+		W word;
+		if constexpr (sizeof(W) == 8) {
+			word = decode_uint64(p_src + i * sizeof(W));
+		} else {
+			word = decode_uint32(p_src + i * sizeof(W));
+		}
+		memcpy(dst + i * sizeof(W), &word, sizeof(W));
+	}
+#else
+	memcpy(p_dst, p_src, p_count * sizeof(W));
+#endif
+}
+
+// Reals are converted when they weren't encoded with the precision of `real_t`.
+static void _decode_reals(const uint8_t *p_src, real_t *p_dst, int64_t p_count, bool p_64) {
+	if (p_64 == (sizeof(real_t) == sizeof(double))) {
+		_decode_words<uintr_t>(p_src, p_dst, p_count);
+	} else if (p_64) {
+		for (int64_t i = 0; i < p_count; i++) {
+			p_dst[i] = decode_double(p_src + i * sizeof(double));
+		}
+	} else {
+		for (int64_t i = 0; i < p_count; i++) {
+			p_dst[i] = decode_float(p_src + i * sizeof(float));
+		}
+	}
+}
+
+static _FORCE_INLINE_ uint64_t _zigzag_encode(int64_t p_value) {
+	return (uint64_t(p_value) << 1) ^ uint64_t(p_value >> 63);
+}
+
+static _FORCE_INLINE_ int64_t _zigzag_decode(uint64_t p_value) {
+	return int64_t(p_value >> 1) ^ -int64_t(p_value & 1);
+}
+
+// Returns the size of the varint, and writes it if `p_dst` isn't null.
+static _FORCE_INLINE_ int _encode_varint(uint64_t p_value, uint8_t *p_dst) {
+	int size = 1;
+	while (p_value >= 0x80) {
+		if (p_dst) {
+			*(p_dst++) = uint8_t(p_value) | 0x80;
+		}
+		p_value >>= 7;
+		size++;
+	}
+	if (p_dst) {
+		*p_dst = uint8_t(p_value);
+	}
+	return size;
+}
+
+template <typename T>
+static int64_t _get_varint_array_size(const Vector<T> &p_array) {
+	int64_t size = 0;
+	for (const T &value : p_array) {
+		size += _encode_varint(_zigzag_encode(value), nullptr);
+	}
+	return size;
+}
+
+template <typename T>
+static void _encode_varint_array(const Vector<T> &p_array, int p_size, uint8_t *&buf, int &r_len) {
+	if (buf) {
+		encode_uint32(p_array.size(), buf);
+		encode_uint32(p_size, buf + 4);
+		buf += 8;
+		for (const T &value : p_array) {
+			buf += _encode_varint(_zigzag_encode(value), buf);
+		}
+	}
+
+	r_len += 8 + p_size;
+	while (r_len % 4) {
+		r_len++; // Pad.
+		if (buf) {
+			*(buf++) = 0;
+		}
+	}
+}
+
+template <typename T>
+static Error _decode_varint_array(const uint8_t *buf, int len, int *r_len, Vector<T> &r_array) {
+	ERR_FAIL_COND_V(len < 8, ERR_INVALID_DATA);
+	int32_t count = decode_uint32(buf);
+	int32_t size = decode_uint32(buf + 4);
+	buf += 8;
+	len -= 8;
+	// Every element takes at least one byte.
+	ERR_FAIL_COND_V(count < 0 || size < count || size > len, ERR_INVALID_DATA);
+
+	const uint8_t *end = buf + size;
+	r_array.resize(count);
+	T *w = r_array.ptrw();
+
+	for (int32_t i = 0; i < count; i++) {
+		uint64_t value = 0;
+		int shift = 0;
+		uint8_t byte;
+		do {
+			ERR_FAIL_COND_V(buf == end || shift >= int(sizeof(T) * 8), ERR_INVALID_DATA);
+			byte = *(buf++);
+			value |= uint64_t(byte & 0x7F) << shift;
+			shift += 7;
+		} while (byte & 0x80);
+
+		if constexpr (sizeof(T) < sizeof(uint64_t)) {
+			ERR_FAIL_COND_V(value >> (sizeof(T) * 8), ERR_INVALID_DATA);
+		}
+		w[i] = T(_zigzag_decode(value));
+	}
+	ERR_FAIL_COND_V(buf != end, ERR_INVALID_DATA);
+
+	if (r_len) {
+		(*r_len) += 8 + size;
+		if (size % 4) {
+			(*r_len) += 4 - size % 4;
+		}
+	}
+	return OK;
+}
+
 enum ContainerTypeKind {
 	CONTAINER_TYPE_KIND_NONE = 0b00,
 	CONTAINER_TYPE_KIND_BUILTIN = 0b01,
@@ -929,10 +1085,7 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 
 			if (count) {
 				data.resize(count);
-				uint8_t *w = data.ptrw();
-				for (int32_t i = 0; i < count; i++) {
-					w[i] = buf[i];
-				}
+				memcpy(data.ptrw(), buf, count);
 			}
 
 			r_variant = data;
@@ -946,6 +1099,17 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 
 		} break;
 		case Variant::PACKED_INT32_ARRAY: {
+			Vector<int32_t> data;
+
+			if (header & HEADER_DATA_FLAG_VARINT) {
+				Error err = _decode_varint_array(buf, len, r_len, data);
+				if (err) {
+					return err;
+				}
+				r_variant = Variant(data);
+				break;
+			}
+
 			ERR_FAIL_COND_V(len < 4, ERR_INVALID_DATA);
 			int32_t count = decode_uint32(buf);
 			buf += 4;
@@ -953,15 +1117,9 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 			ERR_FAIL_MUL_OF(count, 4, ERR_INVALID_DATA);
 			ERR_FAIL_COND_V(count < 0 || count * 4 > len, ERR_INVALID_DATA);
 
-			Vector<int32_t> data;
-
 			if (count) {
-				//const int *rbuf = (const int *)buf;
 				data.resize(count);
-				int32_t *w = data.ptrw();
-				for (int32_t i = 0; i < count; i++) {
-					w[i] = decode_uint32(&buf[i * 4]);
-				}
+				_decode_words<uint32_t>(buf, data.ptrw(), count);
 			}
 			r_variant = Variant(data);
 			if (r_len) {
@@ -970,6 +1128,17 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 
 		} break;
 		case Variant::PACKED_INT64_ARRAY: {
+			Vector<int64_t> data;
+
+			if (header & HEADER_DATA_FLAG_VARINT) {
+				Error err = _decode_varint_array(buf, len, r_len, data);
+				if (err) {
+					return err;
+				}
+				r_variant = Variant(data);
+				break;
+			}
+
 			ERR_FAIL_COND_V(len < 4, ERR_INVALID_DATA);
 			int32_t count = decode_uint32(buf);
 			buf += 4;
@@ -977,15 +1146,9 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 			ERR_FAIL_MUL_OF(count, 8, ERR_INVALID_DATA);
 			ERR_FAIL_COND_V(count < 0 || count * 8 > len, ERR_INVALID_DATA);
 
-			Vector<int64_t> data;
-
 			if (count) {
-				//const int *rbuf = (const int *)buf;
 				data.resize(count);
-				int64_t *w = data.ptrw();
-				for (int64_t i = 0; i < count; i++) {
-					w[i] = decode_uint64(&buf[i * 8]);
-				}
+				_decode_words<uint64_t>(buf, data.ptrw(), count);
 			}
 			r_variant = Variant(data);
 			if (r_len) {
@@ -1004,12 +1167,8 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 			Vector<float> data;
 
 			if (count) {
-				//const float *rbuf = (const float *)buf;
 				data.resize(count);
-				float *w = data.ptrw();
-				for (int32_t i = 0; i < count; i++) {
-					w[i] = decode_float(&buf[i * 4]);
-				}
+				_decode_words<uint32_t>(buf, data.ptrw(), count);
 			}
 			r_variant = data;
 
@@ -1030,10 +1189,7 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 
 			if (count) {
 				data.resize(count);
-				double *w = data.ptrw();
-				for (int64_t i = 0; i < count; i++) {
-					w[i] = decode_double(&buf[i * 8]);
-				}
+				_decode_words<uint64_t>(buf, data.ptrw(), count);
 			}
 			r_variant = data;
 
@@ -1073,59 +1229,22 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 			buf += 4;
 			len -= 4;
 
-			Vector<Vector2> varray;
-
-			if (header & HEADER_DATA_FLAG_64) {
-				ERR_FAIL_MUL_OF(count, sizeof(double) * 2, ERR_INVALID_DATA);
-				ERR_FAIL_COND_V(count < 0 || count * sizeof(double) * 2 > (size_t)len, ERR_INVALID_DATA);
-
-				if (r_len) {
-					(*r_len) += 4; // Size of count number.
-				}
-
-				if (count) {
-					varray.resize(count);
-					Vector2 *w = varray.ptrw();
-
-					for (int32_t i = 0; i < count; i++) {
-						w[i].x = decode_double(buf + i * sizeof(double) * 2 + sizeof(double) * 0);
-						w[i].y = decode_double(buf + i * sizeof(double) * 2 + sizeof(double) * 1);
-					}
-
-					int adv = sizeof(double) * 2 * count;
+			const int element_size = (header & HEADER_DATA_FLAG_64) ? sizeof(double) * 2 : sizeof(float) * 2;
+			ERR_FAIL_MUL_OF(count, element_size, ERR_INVALID_DATA);
+			ERR_FAIL_COND_V(count < 0 || count * element_size > len, ERR_INVALID_DATA);
 
-					if (r_len) {
-						(*r_len) += adv;
-					}
-					len -= adv;
-					buf += adv;
-				}
-			} else {
-				ERR_FAIL_MUL_OF(count, sizeof(float) * 2, ERR_INVALID_DATA);
-				ERR_FAIL_COND_V(count < 0 || count * sizeof(float) * 2 > (size_t)len, ERR_INVALID_DATA);
-
-				if (r_len) {
-					(*r_len) += 4; // Size of count number.
-				}
-
-				if (count) {
-					varray.resize(count);
-					Vector2 *w = varray.ptrw();
-
-					for (int32_t i = 0; i < count; i++) {
-						w[i].x = decode_float(buf + i * sizeof(float) * 2 + sizeof(float) * 0);
-						w[i].y = decode_float(buf + i * sizeof(float) * 2 + sizeof(float) * 1);
-					}
-
-					int adv = sizeof(float) * 2 * count;
+			Vector<Vector2> varray;
 
-					if (r_len) {
-						(*r_len) += adv;
-					}
-				}
+			if (count) {
+				varray.resize(count);
+				_decode_reals(buf, &varray.ptrw()[0].x, count * 2, header & HEADER_DATA_FLAG_64);
 			}
 			r_variant = varray;
 
+			if (r_len) {
+				(*r_len) += 4 + count * element_size;
+			}
+
 		} break;
 		case Variant::PACKED_VECTOR3_ARRAY: {
 			ERR_FAIL_COND_V(len < 4, ERR_INVALID_DATA);
@@ -1133,63 +1252,22 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 			buf += 4;
 			len -= 4;
 
-			Vector<Vector3> varray;
-
-			if (header & HEADER_DATA_FLAG_64) {
-				ERR_FAIL_MUL_OF(count, sizeof(double) * 3, ERR_INVALID_DATA);
-				ERR_FAIL_COND_V(count < 0 || count * sizeof(double) * 3 > (size_t)len, ERR_INVALID_DATA);
-
-				if (r_len) {
-					(*r_len) += 4; // Size of count number.
-				}
-
-				if (count) {
-					varray.resize(count);
-					Vector3 *w = varray.ptrw();
-
-					for (int32_t i = 0; i < count; i++) {
-						w[i].x = decode_double(buf + i * sizeof(double) * 3 + sizeof(double) * 0);
-						w[i].y = decode_double(buf + i * sizeof(double) * 3 + sizeof(double) * 1);
-						w[i].z = decode_double(buf + i * sizeof(double) * 3 + sizeof(double) * 2);
-					}
-
-					int adv = sizeof(double) * 3 * count;
-
-					if (r_len) {
-						(*r_len) += adv;
-					}
-					len -= adv;
-					buf += adv;
-				}
-			} else {
-				ERR_FAIL_MUL_OF(count, sizeof(float) * 3, ERR_INVALID_DATA);
-				ERR_FAIL_COND_V(count < 0 || count * sizeof(float) * 3 > (size_t)len, ERR_INVALID_DATA);
+			const int element_size = (header & HEADER_DATA_FLAG_64) ? sizeof(double) * 3 : sizeof(float) * 3;
+			ERR_FAIL_MUL_OF(count, element_size, ERR_INVALID_DATA);
+			ERR_FAIL_COND_V(count < 0 || count * element_size > len, ERR_INVALID_DATA);
 
-				if (r_len) {
-					(*r_len) += 4; // Size of count number.
-				}
-
-				if (count) {
-					varray.resize(count);
-					Vector3 *w = varray.ptrw();
-
-					for (int32_t i = 0; i < count; i++) {
-						w[i].x = decode_float(buf + i * sizeof(float) * 3 + sizeof(float) * 0);
-						w[i].y = decode_float(buf + i * sizeof(float) * 3 + sizeof(float) * 1);
-						w[i].z = decode_float(buf + i * sizeof(float) * 3 + sizeof(float) * 2);
-					}
-
-					int adv = sizeof(float) * 3 * count;
+			Vector<Vector3> varray;
 
-					if (r_len) {
-						(*r_len) += adv;
-					}
-					len -= adv;
-					buf += adv;
-				}
+			if (count) {
+				varray.resize(count);
+				_decode_reals(buf, &varray.ptrw()[0].x, count * 3, header & HEADER_DATA_FLAG_64);
 			}
 			r_variant = varray;
 
+			if (r_len) {
+				(*r_len) += 4 + count * element_size;
+			}
+
 		} break;
 		case Variant::PACKED_COLOR_ARRAY: {
 			ERR_FAIL_COND_V(len < 4, ERR_INVALID_DATA);
@@ -1202,31 +1280,18 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 
 			Vector<Color> carray;
 
-			if (r_len) {
-				(*r_len) += 4; // Size of count number.
-			}
-
 			if (count) {
 				carray.resize(count);
-				Color *w = carray.ptrw();
-
-				for (int32_t i = 0; i < count; i++) {
-					// Colors should always be in single-precision.
-					w[i].r = decode_float(buf + i * 4 * 4 + 4 * 0);
-					w[i].g = decode_float(buf + i * 4 * 4 + 4 * 1);
-					w[i].b = decode_float(buf + i * 4 * 4 + 4 * 2);
-					w[i].a = decode_float(buf + i * 4 * 4 + 4 * 3);
-				}
-
-				int adv = 4 * 4 * count;
-
-				if (r_len) {
-					(*r_len) += adv;
-				}
+				// Colors should always be in single-precision.
+				_decode_words<uint32_t>(buf, carray.ptrw(), count * 4);
 			}
 
 			r_variant = carray;
 
+			if (r_len) {
+				(*r_len) += 4 + 4 * 4 * count;
+			}
+
 		} break;
 
 		case Variant::PACKED_VECTOR4_ARRAY: {
@@ -1235,65 +1300,22 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 			buf += 4;
 			len -= 4;
 
-			Vector<Vector4> varray;
-
-			if (header & HEADER_DATA_FLAG_64) {
-				ERR_FAIL_MUL_OF(count, sizeof(double) * 4, ERR_INVALID_DATA);
-				ERR_FAIL_COND_V(count < 0 || count * sizeof(double) * 4 > (size_t)len, ERR_INVALID_DATA);
-
-				if (r_len) {
-					(*r_len) += 4; // Size of count number.
-				}
-
-				if (count) {
-					varray.resize(count);
-					Vector4 *w = varray.ptrw();
-
-					for (int32_t i = 0; i < count; i++) {
-						w[i].x = decode_double(buf + i * sizeof(double) * 4 + sizeof(double) * 0);
-						w[i].y = decode_double(buf + i * sizeof(double) * 4 + sizeof(double) * 1);
-						w[i].z = decode_double(buf + i * sizeof(double) * 4 + sizeof(double) * 2);
-						w[i].w = decode_double(buf + i * sizeof(double) * 4 + sizeof(double) * 3);
-					}
-
-					int adv = sizeof(double) * 4 * count;
-
-					if (r_len) {
-						(*r_len) += adv;
-					}
-					len -= adv;
-					buf += adv;
-				}
-			} else {
-				ERR_FAIL_MUL_OF(count, sizeof(float) * 4, ERR_INVALID_DATA);
-				ERR_FAIL_COND_V(count < 0 || count * sizeof(float) * 4 > (size_t)len, ERR_INVALID_DATA);
-
-				if (r_len) {
-					(*r_len) += 4; // Size of count number.
-				}
-
-				if (count) {
-					varray.resize(count);
-					Vector4 *w = varray.ptrw();
-
-					for (int32_t i = 0; i < count; i++) {
-						w[i].x = decode_float(buf + i * sizeof(float) * 4 + sizeof(float) * 0);
-						w[i].y = decode_float(buf + i * sizeof(float) * 4 + sizeof(float) * 1);
-						w[i].z = decode_float(buf + i * sizeof(float) * 4 + sizeof(float) * 2);
-						w[i].w = decode_float(buf + i * sizeof(float) * 4 + sizeof(float) * 3);
-					}
+			const int element_size = (header & HEADER_DATA_FLAG_64) ? sizeof(double) * 4 : sizeof(float) * 4;
+			ERR_FAIL_MUL_OF(count, element_size, ERR_INVALID_DATA);
+			ERR_FAIL_COND_V(count < 0 || count * element_size > len, ERR_INVALID_DATA);
 
-					int adv = sizeof(float) * 4 * count;
+			Vector<Vector4> varray;
 
-					if (r_len) {
-						(*r_len) += adv;
-					}
-					len -= adv;
-					buf += adv;
-				}
+			if (count) {
+				varray.resize(count);
+				_decode_reals(buf, &varray.ptrw()[0].x, count * 4, header & HEADER_DATA_FLAG_64);
 			}
 			r_variant = varray;
 
+			if (r_len) {
+				(*r_len) += 4 + count * element_size;
+			}
+
 		} break;
 		default: {
 			ERR_FAIL_V(ERR_BUG);
@@ -1359,13 +1381,14 @@ static Error _encode_container_type(const ContainerType &p_type, uint8_t *&buf,
 	return OK;
 }
 
-Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bool p_full_objects, int p_depth) {
+Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bool p_full_objects, int p_depth, bool p_compact_ints) {
 	ERR_FAIL_COND_V_MSG(p_depth > Variant::MAX_RECURSION_DEPTH, ERR_OUT_OF_MEMORY, "Potential infinite recursion detected. Bailing.");
 	uint8_t *buf = r_buffer;
 
 	r_len = 0;
 
 	uint32_t header = p_variant.get_type();
+	int64_t varint_size = 0;
 
 	switch (p_variant.get_type()) {
 		case Variant::INT: {
@@ -1406,6 +1429,25 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 			const Array array = p_variant;
 			_encode_container_type_header(array.get_element_type(), header, HEADER_DATA_FIELD_TYPED_ARRAY_SHIFT, p_full_objects);
 		} break;
+		case Variant::PACKED_INT32_ARRAY: {
+			if (p_compact_ints) {
+				// Only worth it when it saves more than the size field.
+				const Vector<int32_t> data = p_variant;
+				varint_size = _get_varint_array_size(data);
+				if (varint_size + 4 < int64_t(data.size() * sizeof(int32_t))) {
+					header |= HEADER_DATA_FLAG_VARINT;
+				}
+			}
+		} break;
+		case Variant::PACKED_INT64_ARRAY: {
+			if (p_compact_ints) {
+				const Vector<int64_t> data = p_variant;
+				varint_size = _get_varint_array_size(data);
+				if (varint_size + 4 < int64_t(data.size() * sizeof(int64_t))) {
+					header |= HEADER_DATA_FLAG_VARINT;
+				}
+			}
+		} break;
 #ifdef REAL_T_IS_DOUBLE
 		case Variant::VECTOR2:
 		case Variant::VECTOR3:
@@ -1793,7 +1835,7 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 						}
 
 						int len;
-						Error err = encode_variant(value, buf, len, p_full_objects, p_depth + 1);
+						Error err = encode_variant(value, buf, len, p_full_objects, p_depth + 1, p_compact_ints);
 						ERR_FAIL_COND_V(err, err);
 						ERR_FAIL_COND_V(len % 4, ERR_BUG);
 						r_len += len;
@@ -1854,14 +1896,14 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 
 			for (const KeyValue<Variant, Variant> &kv : dict) {
 				int len;
-				Error err = encode_variant(kv.key, buf, len, p_full_objects, p_depth + 1);
+				Error err = encode_variant(kv.key, buf, len, p_full_objects, p_depth + 1, p_compact_ints);
 				ERR_FAIL_COND_V(err, err);
 				ERR_FAIL_COND_V(len % 4, ERR_BUG);
 				r_len += len;
 				if (buf) {
 					buf += len;
 				}
-				err = encode_variant(kv.value, buf, len, p_full_objects, p_depth + 1);
+				err = encode_variant(kv.value, buf, len, p_full_objects, p_depth + 1, p_compact_ints);
 				ERR_FAIL_COND_V(err, err);
 				ERR_FAIL_COND_V(len % 4, ERR_BUG);
 				r_len += len;
@@ -1889,7 +1931,7 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 
 			for (const Variant &elem : array) {
 				int len;
-				Error err = encode_variant(elem, buf, len, p_full_objects, p_depth + 1);
+				Error err = encode_variant(elem, buf, len, p_full_objects, p_depth + 1, p_compact_ints);
 				ERR_FAIL_COND_V(err, err);
 				ERR_FAIL_COND_V(len % 4, ERR_BUG);
 				if (buf) {
@@ -1927,16 +1969,20 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 		} break;
 		case Variant::PACKED_INT32_ARRAY: {
 			Vector<int32_t> data = p_variant;
+
+			if (header & HEADER_DATA_FLAG_VARINT) {
+				_encode_varint_array(data, varint_size, buf, r_len);
+				break;
+			}
+
 			int datalen = data.size();
 			int datasize = sizeof(int32_t);
 
 			if (buf) {
 				encode_uint32(datalen, buf);
 				buf += 4;
-				const int32_t *r = data.ptr();
-				for (int32_t i = 0; i < datalen; i++) {
-					encode_uint32(r[i], &buf[i * datasize]);
-				}
+				_encode_words<uint32_t>(data.ptr(), buf, datalen);
+				buf += datalen * datasize;
 			}
 
 			r_len += 4 + datalen * datasize;
@@ -1944,16 +1990,20 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 		} break;
 		case Variant::PACKED_INT64_ARRAY: {
 			Vector<int64_t> data = p_variant;
+
+			if (header & HEADER_DATA_FLAG_VARINT) {
+				_encode_varint_array(data, varint_size, buf, r_len);
+				break;
+			}
+
 			int datalen = data.size();
 			int datasize = sizeof(int64_t);
 
 			if (buf) {
 				encode_uint32(datalen, buf);
 				buf += 4;
-				const int64_t *r = data.ptr();
-				for (int64_t i = 0; i < datalen; i++) {
-					encode_uint64(r[i], &buf[i * datasize]);
-				}
+				_encode_words<uint64_t>(data.ptr(), buf, datalen);
+				buf += datalen * datasize;
 			}
 
 			r_len += 4 + datalen * datasize;
@@ -1967,10 +2017,8 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 			if (buf) {
 				encode_uint32(datalen, buf);
 				buf += 4;
-				const float *r = data.ptr();
-				for (int i = 0; i < datalen; i++) {
-					encode_float(r[i], &buf[i * datasize]);
-				}
+				_encode_words<uint32_t>(data.ptr(), buf, datalen);
+				buf += datalen * datasize;
 			}
 
 			r_len += 4 + datalen * datasize;
@@ -1984,10 +2032,8 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 			if (buf) {
 				encode_uint32(datalen, buf);
 				buf += 4;
-				const double *r = data.ptr();
-				for (int i = 0; i < datalen; i++) {
-					encode_double(r[i], &buf[i * datasize]);
-				}
+				_encode_words<uint64_t>(data.ptr(), buf, datalen);
+				buf += datalen * datasize;
 			}
 
 			r_len += 4 + datalen * datasize;
@@ -2031,21 +2077,11 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 			if (buf) {
 				encode_uint32(len, buf);
 				buf += 4;
+				_encode_words<uintr_t>(data.ptr(), buf, len * 2);
+				buf += sizeof(real_t) * 2 * len;
 			}
 
-			r_len += 4;
-
-			if (buf) {
-				for (int i = 0; i < len; i++) {
-					Vector2 v = data.get(i);
-
-					encode_real(v.x, &buf[0]);
-					encode_real(v.y, &buf[sizeof(real_t)]);
-					buf += sizeof(real_t) * 2;
-				}
-			}
-
-			r_len += sizeof(real_t) * 2 * len;
+			r_len += 4 + sizeof(real_t) * 2 * len;
 
 		} break;
 		case Variant::PACKED_VECTOR3_ARRAY: {
@@ -2055,22 +2091,11 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 			if (buf) {
 				encode_uint32(len, buf);
 				buf += 4;
+				_encode_words<uintr_t>(data.ptr(), buf, len * 3);
+				buf += sizeof(real_t) * 3 * len;
 			}
 
-			r_len += 4;
-
-			if (buf) {
-				for (int i = 0; i < len; i++) {
-					Vector3 v = data.get(i);
-
-					encode_real(v.x, &buf[0]);
-					encode_real(v.y, &buf[sizeof(real_t)]);
-					encode_real(v.z, &buf[sizeof(real_t) * 2]);
-					buf += sizeof(real_t) * 3;
-				}
-			}
-
-			r_len += sizeof(real_t) * 3 * len;
+			r_len += 4 + sizeof(real_t) * 3 * len;
 
 		} break;
 		case Variant::PACKED_COLOR_ARRAY: {
@@ -2080,23 +2105,11 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 			if (buf) {
 				encode_uint32(len, buf);
 				buf += 4;
+				_encode_words<uint32_t>(data.ptr(), buf, len * 4); // Colors should always be in single-precision.
+				buf += sizeof(float) * 4 * len;
 			}
 
-			r_len += 4;
-
-			if (buf) {
-				for (int i = 0; i < len; i++) {
-					Color c = data.get(i);
-
-					encode_float(c.r, &buf[0]);
-					encode_float(c.g, &buf[4]);
-					encode_float(c.b, &buf[8]);
-					encode_float(c.a, &buf[12]);
-					buf += 4 * 4; // Colors should always be in single-precision.
-				}
-			}
-
-			r_len += 4 * 4 * len;
+			r_len += 4 + sizeof(float) * 4 * len;
 
 		} break;
 		case Variant::PACKED_VECTOR4_ARRAY: {
@@ -2106,23 +2119,11 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 			if (buf) {
 				encode_uint32(len, buf);
 				buf += 4;
+				_encode_words<uintr_t>(data.ptr(), buf, len * 4);
+				buf += sizeof(real_t) * 4 * len;
 			}
 
-			r_len += 4;
-
-			if (buf) {
-				for (int i = 0; i < len; i++) {
-					Vector4 v = data.get(i);
-
-					encode_real(v.x, &buf[0]);
-					encode_real(v.y, &buf[sizeof(real_t)]);
-					encode_real(v.z, &buf[sizeof(real_t) * 2]);
-					encode_real(v.w, &buf[sizeof(real_t) * 3]);
-					buf += sizeof(real_t) * 4;
-				}
-			}
-
-			r_len += sizeof(real_t) * 4 * len;
+			r_len += 4 + sizeof(real_t) * 4 * len;
 
 		} break;
 		default: {
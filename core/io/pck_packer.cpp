@@ -33,7 +33,6 @@
 #include "core/crypto/crypto_core.h"
 #include "core/io/file_access.h"
 #include "core/io/file_access_encrypted.h"
-#include "core/io/file_access_pack.h" // PACK_HEADER_MAGIC, PACK_FORMAT_VERSION
 #include "core/object/class_db.h"
 #include "core/version.h"
 
@@ -47,12 +46,69 @@ static int _get_pad(int p_alignment, int p_n) {
 	return pad;
 }
 
+// Content-defined chunking (FastCDC): the boundaries of chunks depend on a rolling hash of the last bytes,
+// so editing a part of a file only changes the chunks around it, and the other ones keep their hashes.
+static constexpr uint32_t CHUNK_MIN_SIZE = 16 * 1024;
+static constexpr uint32_t CHUNK_AVERAGE_SIZE = 64 * 1024;
+static constexpr uint32_t CHUNK_MAX_SIZE = 256 * 1024;
+
+// Harder to match before the average size and easier after it, so chunk sizes stay close to the average.
+static constexpr uint64_t CHUNK_MASK_SMALL = ~uint64_t(0) << (64 - 18);
+static constexpr uint64_t CHUNK_MASK_LARGE = ~uint64_t(0) << (64 - 14);
+
+struct ChunkGearTable {
+	uint64_t values[256];
+
+	ChunkGearTable() {
+		// Fixed values, the chunks of packs made by different versions must match.
+		uint64_t state = 0x6a09e667f3bcc908;
+		for (int i = 0; i < 256; i++) {
+			state += 0x9e3779b97f4a7c15;
+			uint64_t z = state;
+			z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+			z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+			values[i] = z ^ (z >> 31);
+		}
+	}
+};
+
+static uint32_t _get_chunk_size(const uint8_t *p_data, uint64_t p_size) {
+	static const ChunkGearTable gear;
+
+	if (p_size <= CHUNK_MIN_SIZE) {
+		return p_size;
+	}
+
+	const uint32_t size = MIN(p_size, (uint64_t)CHUNK_MAX_SIZE);
+	const uint32_t average = MIN(size, CHUNK_AVERAGE_SIZE);
+	uint64_t hash = 0;
+	uint32_t i = CHUNK_MIN_SIZE;
+	for (; i < average; i++) {
+		hash = (hash << 1) + gear.values[p_data[i]];
+		if (!(hash & CHUNK_MASK_SMALL)) {
+			return i + 1;
+		}
+	}
+	for (; i < size; i++) {
+		hash = (hash << 1) + gear.values[p_data[i]];
+		if (!(hash & CHUNK_MASK_LARGE)) {
+			return i + 1;
+		}
+	}
+	return size;
+}
+
 void PCKPacker::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("pck_start", "pck_path", "alignment", "key", "encrypt_directory"), &PCKPacker::pck_start, DEFVAL(32), DEFVAL("0000000000000000000000000000000000000000000000000000000000000000"), DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("add_file", "target_path", "source_path", "encrypt"), &PCKPacker::add_file, DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("add_file_from_buffer", "target_path", "data", "encrypt"), &PCKPacker::add_file_from_buffer, DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("add_file_removal", "target_path"), &PCKPacker::add_file_removal);
+	ClassDB::bind_method(D_METHOD("set_chunking_enabled", "enabled"), &PCKPacker::set_chunking_enabled);
+	ClassDB::bind_method(D_METHOD("is_chunking_enabled"), &PCKPacker::is_chunking_enabled);
+	ClassDB::bind_method(D_METHOD("add_base_pack", "pck_path"), &PCKPacker::add_base_pack);
 	ClassDB::bind_method(D_METHOD("flush", "verbose"), &PCKPacker::flush, DEFVAL(false));
+
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "chunking_enabled"), "set_chunking_enabled", "is_chunking_enabled");
 }
 
 Error PCKPacker::pck_start(const String &p_pck_path, int p_alignment, const String &p_key, bool p_encrypt_directory) {
@@ -92,15 +148,17 @@ Error PCKPacker::pck_start(const String &p_pck_path, int p_alignment, const Stri
 	alignment = p_alignment;
 
 	file->store_32(PACK_HEADER_MAGIC);
+	version_ofs = file->get_position();
 	file->store_32(PACK_FORMAT_VERSION);
 	file->store_32(GODOT_VERSION_MAJOR);
 	file->store_32(GODOT_VERSION_MINOR);
 	file->store_32(GODOT_VERSION_PATCH);
 
-	uint32_t pack_flags = PACK_REL_FILEBASE;
+	pack_flags = PACK_REL_FILEBASE;
 	if (enc_dir) {
 		pack_flags |= PACK_DIR_ENCRYPTED;
 	}
+	flags_ofs = file->get_position();
 	file->store_32(pack_flags); // flags
 
 	file_base_ofs = file->get_position();
@@ -125,6 +183,9 @@ Error PCKPacker::pck_start(const String &p_pck_path, int p_alignment, const Stri
 	file->seek(file_base);
 
 	files.clear();
+	chunks.clear();
+	chunk_indices.clear();
+	base_chunks.clear();
 
 	return OK;
 }
@@ -147,6 +208,47 @@ Error PCKPacker::add_file_removal(const String &p_target_path) {
 	return OK;
 }
 
+void PCKPacker::set_chunking_enabled(bool p_enabled) {
+	chunking = p_enabled;
+}
+
+bool PCKPacker::is_chunking_enabled() const {
+	return chunking;
+}
+
+Error PCKPacker::add_base_pack(const String &p_pck_path) {
+	ERR_FAIL_COND_V_MSG(file.is_null(), ERR_INVALID_PARAMETER, "File must be opened before use.");
+
+	Ref<FileAccess> f = FileAccess::open(p_pck_path, FileAccess::READ);
+	ERR_FAIL_COND_V_MSG(f.is_null(), ERR_FILE_CANT_OPEN, vformat("Can't open base pack '%s'.", p_pck_path));
+	ERR_FAIL_COND_V_MSG(f->get_32() != PACK_HEADER_MAGIC, ERR_FILE_UNRECOGNIZED, vformat("'%s' isn't a standalone PCK file.", p_pck_path));
+
+	uint32_t version = f->get_32();
+	f->get_32(); // Engine version.
+	f->get_32();
+	f->get_32();
+	uint32_t base_flags = f->get_32();
+	ERR_FAIL_COND_V_MSG(version != PACK_FORMAT_VERSION_V5 || !(base_flags & PACK_CHUNKED), ERR_INVALID_PARAMETER, vformat("Base pack '%s' isn't chunked.", p_pck_path));
+	f->get_64(); // Files base.
+	f->get_64(); // Directory offset.
+	uint64_t chunk_table_offset = f->get_64();
+
+	LocalVector<PackedData::ChunkHash> hashes;
+	LocalVector<PackedData::Chunk> base_pack_chunks;
+	LocalVector<uint32_t> chunk_lists;
+	Error err = PackedSourcePCK::read_chunk_table(f, chunk_table_offset, hashes, base_pack_chunks, chunk_lists);
+	ERR_FAIL_COND_V_MSG(err != OK, err, vformat("Can't read the chunk table of base pack '%s'.", p_pck_path));
+
+	// Only the chunks stored in the base pack itself, others come from its own base packs, which can be added too.
+	for (uint32_t i = 0; i < hashes.size(); i++) {
+		if (base_pack_chunks[i].offset != PACK_CHUNK_EXTERNAL) {
+			base_chunks.insert(hashes[i]);
+		}
+	}
+
+	return OK;
+}
+
 Error PCKPacker::add_file(const String &p_target_path, const String &p_source_path, bool p_encrypt) {
 	ERR_FAIL_COND_V_MSG(file.is_null(), ERR_INVALID_PARAMETER, "File must be opened before use.");
 
@@ -184,6 +286,23 @@ Error PCKPacker::_add_file(const String &p_target_path, const String &p_source_p
 	}
 	pf.encrypted = p_encrypt;
 
+	// Encrypted files can't share their data, they are always stored whole.
+	if (chunking && !p_encrypt) {
+		pf.chunked = true;
+
+		const uint8_t *data = p_data.ptr();
+		uint64_t remaining = p_data.size();
+		while (remaining > 0) {
+			uint32_t size = _get_chunk_size(data, remaining);
+			pf.chunks.push_back(_add_chunk(data, size));
+			data += size;
+			remaining -= size;
+		}
+
+		files.push_back(pf);
+		return OK;
+	}
+
 	Ref<FileAccess> ftmp = file;
 
 	Ref<FileAccessEncrypted> fae;
@@ -213,6 +332,33 @@ Error PCKPacker::_add_file(const String &p_target_path, const String &p_source_p
 	return OK;
 }
 
+uint32_t PCKPacker::_add_chunk(const uint8_t *p_data, uint32_t p_size) {
+	Chunk chunk;
+	CryptoCore::sha256(p_data, p_size, chunk.hash.sha256);
+
+	HashMap<PackedData::ChunkHash, uint32_t, PackedData::ChunkHash>::Iterator E = chunk_indices.find(chunk.hash);
+	if (E) {
+		return E->value;
+	}
+
+	chunk.size = p_size;
+	if (base_chunks.has(chunk.hash)) {
+		chunk.ofs = PACK_CHUNK_EXTERNAL;
+	} else {
+		chunk.ofs = file->get_position() - file_base;
+		file->store_buffer(p_data, p_size);
+
+		int pad = _get_pad(alignment, file->get_position());
+		for (int i = 0; i < pad; i++) {
+			file->store_8(0);
+		}
+	}
+
+	chunks.push_back(chunk);
+	chunk_indices.insert(chunk.hash, chunks.size() - 1);
+	return chunks.size() - 1;
+}
+
 Error PCKPacker::flush(bool p_verbose) {
 	ERR_FAIL_COND_V_MSG(file.is_null(), ERR_INVALID_PARAMETER, "File must be opened before use.");
 
@@ -221,6 +367,46 @@ Error PCKPacker::flush(bool p_verbose) {
 		file->store_8(0);
 	}
 
+	bool chunked = chunking || !chunks.is_empty();
+	uint64_t chunk_table_offset = 0;
+	if (chunked) {
+		// Write the chunk table, then the chunk lists of the files, which the directory points to.
+		chunk_table_offset = file->get_position();
+
+		file->store_32(chunks.size());
+		for (const Chunk &chunk : chunks) {
+			file->store_buffer(chunk.hash.sha256, sizeof(chunk.hash.sha256));
+			file->store_64(chunk.ofs);
+			file->store_32(chunk.size);
+		}
+
+		uint32_t list_size = 0;
+		for (const File &pf : files) {
+			if (pf.chunked) {
+				list_size += 1 + pf.chunks.size();
+			}
+		}
+		file->store_32(list_size);
+
+		uint32_t list_ofs = 0;
+		for (int i = 0; i < files.size(); i++) {
+			if (!files[i].chunked) {
+				continue;
+			}
+			files.write[i].chunk_list_ofs = list_ofs;
+			file->store_32(files[i].chunks.size());
+			for (uint32_t index : files[i].chunks) {
+				file->store_32(index);
+			}
+			list_ofs += 1 + files[i].chunks.size();
+		}
+
+		dir_padding = _get_pad(alignment, file->get_position());
+		for (int i = 0; i < dir_padding; i++) {
+			file->store_8(0);
+		}
+	}
+
 	// Write directory.
 	uint64_t dir_offset = file->get_position();
 	file->seek(dir_base_ofs);
@@ -254,7 +440,7 @@ Error PCKPacker::flush(bool p_verbose) {
 			fhead->store_8(0);
 		}
 
-		fhead->store_64(files[i].ofs - file_base);
+		fhead->store_64(files[i].chunked ? files[i].chunk_list_ofs : files[i].ofs - file_base);
 		fhead->store_64(files[i].size);
 		fhead->store_buffer(files[i].md5.ptr(), 16);
 
@@ -265,6 +451,9 @@ Error PCKPacker::flush(bool p_verbose) {
 		if (files[i].removal) {
 			flags |= PACK_FILE_REMOVAL;
 		}
+		if (files[i].chunked) {
+			flags |= PACK_FILE_CHUNKED;
+		}
 		fhead->store_32(flags);
 
 		if (p_verbose) {
@@ -277,6 +466,16 @@ Error PCKPacker::flush(bool p_verbose) {
 		fae.unref();
 	}
 
+	if (chunked) {
+		// Chunked packs can't be read by older versions.
+		file->seek(version_ofs);
+		file->store_32(PACK_FORMAT_VERSION_V5);
+		file->seek(flags_ofs);
+		file->store_32(pack_flags | PACK_CHUNKED);
+		file->seek(dir_base_ofs + 8);
+		file->store_64(chunk_table_offset);
+	}
+
 	file.unref();
 	return OK;
 }
@@ -30,6 +30,7 @@
 
 #pragma once
 
+#include "core/io/file_access_pack.h"
 #include "core/object/ref_counted.h"
 
 class FileAccess;
@@ -46,6 +47,9 @@ class PCKPacker : public RefCounted {
 	uint64_t file_base = 0;
 	uint64_t file_base_ofs = 0;
 	uint64_t dir_base_ofs = 0;
+	uint64_t version_ofs = 0;
+	uint64_t flags_ofs = 0;
+	uint32_t pack_flags = 0;
 
 	static void _bind_methods();
 
@@ -57,9 +61,25 @@ class PCKPacker : public RefCounted {
 		bool encrypted = false;
 		bool removal = false;
 		Vector<uint8_t> md5;
+		bool chunked = false;
+		Vector<uint32_t> chunks;
+		uint32_t chunk_list_ofs = 0;
 	};
 	Vector<File> files;
 
+	struct Chunk {
+		PackedData::ChunkHash hash;
+		uint64_t ofs = 0; // PACK_CHUNK_EXTERNAL for chunks of the base packs.
+		uint32_t size = 0;
+	};
+
+	// Files are split in content-defined chunks, each chunk is stored once.
+	bool chunking = false;
+	LocalVector<Chunk> chunks;
+	HashMap<PackedData::ChunkHash, uint32_t, PackedData::ChunkHash> chunk_indices;
+	HashSet<PackedData::ChunkHash, PackedData::ChunkHash> base_chunks;
+
+	uint32_t _add_chunk(const uint8_t *p_data, uint32_t p_size);
 	Error _add_file(const String &p_target_path, const String &p_source_path, const Vector<uint8_t> &p_data, bool p_encrypt = false);
 
 public:
@@ -67,6 +87,11 @@ public:
 	Error add_file(const String &p_target_path, const String &p_source_path, bool p_encrypt = false);
 	Error add_file_from_buffer(const String &p_target_path, const Vector<uint8_t> &p_data, bool p_encrypt = false);
 	Error add_file_removal(const String &p_target_path);
+
+	void set_chunking_enabled(bool p_enabled);
+	bool is_chunking_enabled() const;
+	Error add_base_pack(const String &p_pck_path);
+
 	Error flush(bool p_verbose = false);
 
 	~PCKPacker();
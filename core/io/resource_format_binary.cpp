@@ -96,11 +96,23 @@ enum {
 	// Version 4: New string ID for ext/subresources, breaks forward compat.
 	// Version 5: Ability to store script class in the header.
 	// Version 6: Added PackedVector4Array Variant type.
-	FORMAT_VERSION = 6,
+	// Version 7: Added padding before packed arrays of fixed-size elements, breaks forward compat.
+	//            Only written when saving with ResourceSaver::FLAG_ALIGN_PACKED_ARRAYS, other files keep version 6.
+	FORMAT_VERSION = 7,
 	FORMAT_VERSION_CAN_RENAME_DEPS = 1,
 	FORMAT_VERSION_NO_NODEPATH_PROPERTY = 3,
+	FORMAT_VERSION_NO_ARRAY_PADDING = 6,
+	FORMAT_VERSION_ARRAY_PADDING = 7,
 };
 
+// Large packed arrays are padded so that their data is aligned, with enough room for a Vector header in front of it.
+// This lets the loader use them in place from memory mapped packs, instead of copying them.
+static constexpr uint64_t ARRAY_PADDING_MIN_SIZE = 4096;
+static constexpr uint64_t ARRAY_PADDING_ALIGNMENT = 16;
+static constexpr uint64_t ARRAY_PADDING_HEADER_SIZE = 32;
+static_assert(ARRAY_PADDING_ALIGNMENT % Memory::MAX_ALIGN == 0);
+static_assert(ARRAY_PADDING_HEADER_SIZE >= Vector<uint8_t>::EXTERNAL_HEADER_SIZE);
+
 void ResourceLoaderBinary::_advance_padding(uint32_t p_len) {
 	uint32_t extra = 4 - (p_len % 4);
 	if (extra < 4) {
@@ -110,6 +122,34 @@ void ResourceLoaderBinary::_advance_padding(uint32_t p_len) {
 	}
 }
 
+template <typename T>
+bool ResourceLoaderBinary::_read_array_in_place(Vector<T> &r_array, uint32_t p_len, uint64_t p_size) {
+	if (ver_format < FORMAT_VERSION_ARRAY_PADDING) {
+		return false;
+	}
+
+	const uint32_t padding = f->get_32();
+
+#ifndef BIG_ENDIAN_ENABLED
+	// Only if the data is stored exactly like in memory.
+	if (p_len > 0 && padding >= Vector<T>::EXTERNAL_HEADER_SIZE && p_size == p_len * sizeof(T)) {
+		uint8_t *data = f->get_persistent_buffer(padding + p_size);
+		if (data) {
+			T *elements = (T *)(data + padding);
+			if (((uintptr_t)elements % Memory::MAX_ALIGN) != 0 || r_array.use_external(elements, p_len) != OK) {
+				// E.g. in a pack which doesn't align its files.
+				r_array.resize(p_len);
+				memcpy(r_array.ptrw(), elements, p_size);
+			}
+			return true;
+		}
+	}
+#endif
+
+	f->seek(f->get_position() + padding);
+	return false;
+}
+
 static Error read_reals(real_t *dst, Ref<FileAccess> &f, size_t count) {
 	if (f->real_is_double) {
 		if constexpr (sizeof(real_t) == 8) {
@@ -511,9 +551,11 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 			uint32_t len = f->get_32();
 
 			Vector<uint8_t> array;
-			array.resize(len);
-			uint8_t *w = array.ptrw();
-			f->get_buffer(w, len);
+			if (!_read_array_in_place(array, len, len)) {
+				array.resize(len);
+				uint8_t *w = array.ptrw();
+				f->get_buffer(w, len);
+			}
 			_advance_padding(len);
 
 			r_v = array;
@@ -523,18 +565,20 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 			uint32_t len = f->get_32();
 
 			Vector<int32_t> array;
-			array.resize(len);
-			int32_t *w = array.ptrw();
-			f->get_buffer((uint8_t *)w, len * sizeof(int32_t));
+			if (!_read_array_in_place(array, len, len * sizeof(int32_t))) {
+				array.resize(len);
+				int32_t *w = array.ptrw();
+				f->get_buffer((uint8_t *)w, len * sizeof(int32_t));
 #ifdef BIG_ENDIAN_ENABLED
-			{
-				uint32_t *ptr = (uint32_t *)w.ptr();
-				for (int i = 0; i < len; i++) {
-					ptr[i] = BSWAP32(ptr[i]);
+				{
+					uint32_t *ptr = (uint32_t *)w.ptr();
+					for (int i = 0; i < len; i++) {
+						ptr[i] = BSWAP32(ptr[i]);
+					}
 				}
-			}
 
 #endif
+			}
 
 			r_v = array;
 		} break;
@@ -542,18 +586,20 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 			uint32_t len = f->get_32();
 
 			Vector<int64_t> array;
-			array.resize(len);
-			int64_t *w = array.ptrw();
-			f->get_buffer((uint8_t *)w, len * sizeof(int64_t));
+			if (!_read_array_in_place(array, len, len * sizeof(int64_t))) {
+				array.resize(len);
+				int64_t *w = array.ptrw();
+				f->get_buffer((uint8_t *)w, len * sizeof(int64_t));
 #ifdef BIG_ENDIAN_ENABLED
-			{
-				uint64_t *ptr = (uint64_t *)w.ptr();
-				for (int i = 0; i < len; i++) {
-					ptr[i] = BSWAP64(ptr[i]);
+				{
+					uint64_t *ptr = (uint64_t *)w.ptr();
+					for (int i = 0; i < len; i++) {
+						ptr[i] = BSWAP64(ptr[i]);
+					}
 				}
-			}
 
 #endif
+			}
 
 			r_v = array;
 		} break;
@@ -561,18 +607,20 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 			uint32_t len = f->get_32();
 
 			Vector<float> array;
-			array.resize(len);
-			float *w = array.ptrw();
-			f->get_buffer((uint8_t *)w, len * sizeof(float));
+			if (!_read_array_in_place(array, len, len * sizeof(float))) {
+				array.resize(len);
+				float *w = array.ptrw();
+				f->get_buffer((uint8_t *)w, len * sizeof(float));
 #ifdef BIG_ENDIAN_ENABLED
-			{
-				uint32_t *ptr = (uint32_t *)w.ptr();
-				for (int i = 0; i < len; i++) {
-					ptr[i] = BSWAP32(ptr[i]);
+				{
+					uint32_t *ptr = (uint32_t *)w.ptr();
+					for (int i = 0; i < len; i++) {
+						ptr[i] = BSWAP32(ptr[i]);
+					}
 				}
-			}
 
 #endif
+			}
 
 			r_v = array;
 		} break;
@@ -580,18 +628,20 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 			uint32_t len = f->get_32();
 
 			Vector<double> array;
-			array.resize(len);
-			double *w = array.ptrw();
-			f->get_buffer((uint8_t *)w, len * sizeof(double));
+			if (!_read_array_in_place(array, len, len * sizeof(double))) {
+				array.resize(len);
+				double *w = array.ptrw();
+				f->get_buffer((uint8_t *)w, len * sizeof(double));
 #ifdef BIG_ENDIAN_ENABLED
-			{
-				uint64_t *ptr = (uint64_t *)w.ptr();
-				for (int i = 0; i < len; i++) {
-					ptr[i] = BSWAP64(ptr[i]);
+				{
+					uint64_t *ptr = (uint64_t *)w.ptr();
+					for (int i = 0; i < len; i++) {
+						ptr[i] = BSWAP64(ptr[i]);
+					}
 				}
-			}
 
 #endif
+			}
 
 			r_v = array;
 		} break;
@@ -611,11 +661,13 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 			uint32_t len = f->get_32();
 
 			Vector<Vector2> array;
-			array.resize(len);
-			Vector2 *w = array.ptrw();
 			static_assert(sizeof(Vector2) == 2 * sizeof(real_t));
-			const Error err = read_reals(reinterpret_cast<real_t *>(w), f, len * 2);
-			ERR_FAIL_COND_V(err != OK, err);
+			if (!_read_array_in_place(array, len, (uint64_t)len * 2 * (f->real_is_double ? sizeof(double) : sizeof(float)))) {
+				array.resize(len);
+				Vector2 *w = array.ptrw();
+				const Error err = read_reals(reinterpret_cast<real_t *>(w), f, len * 2);
+				ERR_FAIL_COND_V(err != OK, err);
+			}
 
 			r_v = array;
 
@@ -624,11 +676,13 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 			uint32_t len = f->get_32();
 
 			Vector<Vector3> array;
-			array.resize(len);
-			Vector3 *w = array.ptrw();
 			static_assert(sizeof(Vector3) == 3 * sizeof(real_t));
-			const Error err = read_reals(reinterpret_cast<real_t *>(w), f, len * 3);
-			ERR_FAIL_COND_V(err != OK, err);
+			if (!_read_array_in_place(array, len, (uint64_t)len * 3 * (f->real_is_double ? sizeof(double) : sizeof(float)))) {
+				array.resize(len);
+				Vector3 *w = array.ptrw();
+				const Error err = read_reals(reinterpret_cast<real_t *>(w), f, len * 3);
+				ERR_FAIL_COND_V(err != OK, err);
+			}
 
 			r_v = array;
 
@@ -637,20 +691,22 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 			uint32_t len = f->get_32();
 
 			Vector<Color> array;
-			array.resize(len);
-			Color *w = array.ptrw();
 			// Colors always use `float` even with double-precision support enabled
 			static_assert(sizeof(Color) == 4 * sizeof(float));
-			f->get_buffer((uint8_t *)w, len * sizeof(float) * 4);
+			if (!_read_array_in_place(array, len, len * sizeof(float) * 4)) {
+				array.resize(len);
+				Color *w = array.ptrw();
+				f->get_buffer((uint8_t *)w, len * sizeof(float) * 4);
 #ifdef BIG_ENDIAN_ENABLED
-			{
-				uint32_t *ptr = (uint32_t *)w.ptr();
-				for (int i = 0; i < len * 4; i++) {
-					ptr[i] = BSWAP32(ptr[i]);
+				{
+					uint32_t *ptr = (uint32_t *)w.ptr();
+					for (int i = 0; i < len * 4; i++) {
+						ptr[i] = BSWAP32(ptr[i]);
+					}
 				}
-			}
 
 #endif
+			}
 
 			r_v = array;
 		} break;
@@ -658,11 +714,13 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 			uint32_t len = f->get_32();
 
 			Vector<Vector4> array;
-			array.resize(len);
-			Vector4 *w = array.ptrw();
 			static_assert(sizeof(Vector4) == 4 * sizeof(real_t));
-			const Error err = read_reals(reinterpret_cast<real_t *>(w), f, len * 4);
-			ERR_FAIL_COND_V(err != OK, err);
+			if (!_read_array_in_place(array, len, (uint64_t)len * 4 * (f->real_is_double ? sizeof(double) : sizeof(float)))) {
+				array.resize(len);
+				Vector4 *w = array.ptrw();
+				const Error err = read_reals(reinterpret_cast<real_t *>(w), f, len * 4);
+				ERR_FAIL_COND_V(err != OK, err);
+			}
 
 			r_v = array;
 
@@ -1622,7 +1680,24 @@ void ResourceFormatSaverBinaryInstance::_pad_buffer(Ref<FileAccess> f, int p_byt
 	}
 }
 
-void ResourceFormatSaverBinaryInstance::write_variant(Ref<FileAccess> f, const Variant &p_property, HashMap<Ref<Resource>, int> &resource_map, HashMap<Ref<Resource>, int> &external_resources, HashMap<StringName, int> &string_map, const PropertyInfo &p_hint) {
+void ResourceFormatSaverBinaryInstance::_store_array_padding(Ref<FileAccess> f, uint64_t p_size, bool p_pad_arrays) {
+	if (!p_pad_arrays) {
+		return; // Not part of the format before version 7.
+	}
+
+	uint32_t padding = 0;
+	if (p_size >= ARRAY_PADDING_MIN_SIZE) {
+		const uint64_t data_pos = f->get_position() + sizeof(uint32_t) + ARRAY_PADDING_HEADER_SIZE;
+		padding = ARRAY_PADDING_HEADER_SIZE + (ARRAY_PADDING_ALIGNMENT - data_pos % ARRAY_PADDING_ALIGNMENT) % ARRAY_PADDING_ALIGNMENT;
+	}
+
+	f->store_32(padding);
+	for (uint32_t i = 0; i < padding; i++) {
+		f->store_8(0);
+	}
+}
+
+void ResourceFormatSaverBinaryInstance::write_variant(Ref<FileAccess> f, const Variant &p_property, HashMap<Ref<Resource>, int> &resource_map, HashMap<Ref<Resource>, int> &external_resources, HashMap<StringName, int> &string_map, const PropertyInfo &p_hint, bool p_pad_arrays) {
 	switch (p_property.get_type()) {
 		case Variant::NIL: {
 			f->store_32(VARIANT_NIL);
@@ -1907,8 +1982,8 @@ void ResourceFormatSaverBinaryInstance::write_variant(Ref<FileAccess> f, const V
 			f->store_32(uint32_t(d.size()));
 
 			for (const KeyValue<Variant, Variant> &kv : d) {
-				write_variant(f, kv.key, resource_map, external_resources, string_map);
-				write_variant(f, kv.value, resource_map, external_resources, string_map);
+				write_variant(f, kv.key, resource_map, external_resources, string_map, PropertyInfo(), p_pad_arrays);
+				write_variant(f, kv.value, resource_map, external_resources, string_map, PropertyInfo(), p_pad_arrays);
 			}
 
 		} break;
@@ -1917,7 +1992,7 @@ void ResourceFormatSaverBinaryInstance::write_variant(Ref<FileAccess> f, const V
 			Array a = p_property;
 			f->store_32(uint32_t(a.size()));
 			for (const Variant &var : a) {
-				write_variant(f, var, resource_map, external_resources, string_map);
+				write_variant(f, var, resource_map, external_resources, string_map, PropertyInfo(), p_pad_arrays);
 			}
 
 		} break;
@@ -1926,6 +2001,7 @@ void ResourceFormatSaverBinaryInstance::write_variant(Ref<FileAccess> f, const V
 			Vector<uint8_t> arr = p_property;
 			int len = arr.size();
 			f->store_32(uint32_t(len));
+			_store_array_padding(f, len, p_pad_arrays);
 			const uint8_t *r = arr.ptr();
 			f->store_buffer(r, len);
 			_pad_buffer(f, len);
@@ -1936,6 +2012,7 @@ void ResourceFormatSaverBinaryInstance::write_variant(Ref<FileAccess> f, const V
 			Vector<int32_t> arr = p_property;
 			int len = arr.size();
 			f->store_32(uint32_t(len));
+			_store_array_padding(f, len * sizeof(int32_t), p_pad_arrays);
 			const int32_t *r = arr.ptr();
 			for (int i = 0; i < len; i++) {
 				f->store_32(uint32_t(r[i]));
@@ -1947,6 +2024,7 @@ void ResourceFormatSaverBinaryInstance::write_variant(Ref<FileAccess> f, const V
 			Vector<int64_t> arr = p_property;
 			int len = arr.size();
 			f->store_32(uint32_t(len));
+			_store_array_padding(f, len * sizeof(int64_t), p_pad_arrays);
 			const int64_t *r = arr.ptr();
 			for (int i = 0; i < len; i++) {
 				f->store_64(uint64_t(r[i]));
@@ -1958,6 +2036,7 @@ void ResourceFormatSaverBinaryInstance::write_variant(Ref<FileAccess> f, const V
 			Vector<float> arr = p_property;
 			int len = arr.size();
 			f->store_32(uint32_t(len));
+			_store_array_padding(f, len * sizeof(float), p_pad_arrays);
 			const float *r = arr.ptr();
 			for (int i = 0; i < len; i++) {
 				f->store_float(r[i]);
@@ -1969,6 +2048,7 @@ void ResourceFormatSaverBinaryInstance::write_variant(Ref<FileAccess> f, const V
 			Vector<double> arr = p_property;
 			int len = arr.size();
 			f->store_32(uint32_t(len));
+			_store_array_padding(f, len * sizeof(double), p_pad_arrays);
 			const double *r = arr.ptr();
 			for (int i = 0; i < len; i++) {
 				f->store_double(r[i]);
@@ -1991,6 +2071,7 @@ void ResourceFormatSaverBinaryInstance::write_variant(Ref<FileAccess> f, const V
 			Vector<Vector2> arr = p_property;
 			int len = arr.size();
 			f->store_32(uint32_t(len));
+			_store_array_padding(f, (uint64_t)len * 2 * sizeof(real_t), p_pad_arrays);
 			const Vector2 *r = arr.ptr();
 			for (int i = 0; i < len; i++) {
 				f->store_real(r[i].x);
@@ -2003,6 +2084,7 @@ void ResourceFormatSaverBinaryInstance::write_variant(Ref<FileAccess> f, const V
 			Vector<Vector3> arr = p_property;
 			int len = arr.size();
 			f->store_32(uint32_t(len));
+			_store_array_padding(f, (uint64_t)len * 3 * sizeof(real_t), p_pad_arrays);
 			const Vector3 *r = arr.ptr();
 			for (int i = 0; i < len; i++) {
 				f->store_real(r[i].x);
@@ -2016,6 +2098,7 @@ void ResourceFormatSaverBinaryInstance::write_variant(Ref<FileAccess> f, const V
 			Vector<Color> arr = p_property;
 			int len = arr.size();
 			f->store_32(uint32_t(len));
+			_store_array_padding(f, (uint64_t)len * 4 * sizeof(float), p_pad_arrays);
 			const Color *r = arr.ptr();
 			for (int i = 0; i < len; i++) {
 				f->store_float(r[i].r);
@@ -2030,6 +2113,7 @@ void ResourceFormatSaverBinaryInstance::write_variant(Ref<FileAccess> f, const V
 			Vector<Vector4> arr = p_property;
 			int len = arr.size();
 			f->store_32(uint32_t(len));
+			_store_array_padding(f, (uint64_t)len * 4 * sizeof(real_t), p_pad_arrays);
 			const Vector4 *r = arr.ptr();
 			for (int i = 0; i < len; i++) {
 				f->store_real(r[i].x);
@@ -2186,6 +2270,7 @@ Error ResourceFormatSaverBinaryInstance::save(const String &p_path, const Ref<Re
 	bundle_resources = p_flags & ResourceSaver::FLAG_BUNDLE_RESOURCES;
 	big_endian = p_flags & ResourceSaver::FLAG_SAVE_BIG_ENDIAN;
 	takeover_paths = p_flags & ResourceSaver::FLAG_REPLACE_SUBRESOURCE_PATHS;
+	pad_arrays = p_flags & ResourceSaver::FLAG_ALIGN_PACKED_ARRAYS;
 
 	if (!p_path.begins_with("res://")) {
 		takeover_paths = false;
@@ -2212,7 +2297,7 @@ Error ResourceFormatSaverBinaryInstance::save(const String &p_path, const Ref<Re
 
 	f->store_32(GODOT_VERSION_MAJOR);
 	f->store_32(GODOT_VERSION_MINOR);
-	f->store_32(FORMAT_VERSION);
+	f->store_32(pad_arrays ? FORMAT_VERSION_ARRAY_PADDING : FORMAT_VERSION_NO_ARRAY_PADDING);
 
 	if (f->get_error() != OK && f->get_error() != ERR_FILE_EOF) {
 		return ERR_CANT_CREATE;
@@ -2389,7 +2474,7 @@ Error ResourceFormatSaverBinaryInstance::save(const String &p_path, const Ref<Re
 
 		for (const Property &p : rd.properties) {
 			f->store_32(uint32_t(p.name_idx));
-			write_variant(f, p.value, resource_map, external_resources, string_map, p.pi);
+			write_variant(f, p.value, resource_map, external_resources, string_map, p.pi, pad_arrays);
 		}
 	}
 
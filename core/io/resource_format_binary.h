@@ -80,6 +80,8 @@ class ResourceLoaderBinary {
 
 	String get_unicode_string();
 	void _advance_padding(uint32_t p_len);
+	template <typename T>
+	bool _read_array_in_place(Vector<T> &r_array, uint32_t p_len, uint64_t p_size);
 
 	HashMap<String, String> remaps;
 	Error error = OK;
@@ -132,6 +134,7 @@ class ResourceFormatSaverBinaryInstance {
 	bool skip_editor;
 	bool big_endian;
 	bool takeover_paths;
+	bool pad_arrays;
 	String magic;
 	HashSet<Ref<Resource>> resource_set;
 
@@ -160,6 +163,7 @@ class ResourceFormatSaverBinaryInstance {
 	};
 
 	static void _pad_buffer(Ref<FileAccess> f, int p_bytes);
+	static void _store_array_padding(Ref<FileAccess> f, uint64_t p_size, bool p_pad_arrays);
 	void _find_resources(const Variant &p_variant, bool p_main = false);
 	static void save_unicode_string(Ref<FileAccess> f, const String &p_string, bool p_bit_on_len = false);
 	int get_string_index(const String &p_string);
@@ -176,7 +180,7 @@ public:
 	};
 	Error save(const String &p_path, const Ref<Resource> &p_resource, uint32_t p_flags = 0);
 	Error set_uid(const String &p_path, ResourceUID::ID p_uid);
-	static void write_variant(Ref<FileAccess> f, const Variant &p_property, HashMap<Ref<Resource>, int> &resource_map, HashMap<Ref<Resource>, int> &external_resources, HashMap<StringName, int> &string_map, const PropertyInfo &p_hint = PropertyInfo());
+	static void write_variant(Ref<FileAccess> f, const Variant &p_property, HashMap<Ref<Resource>, int> &resource_map, HashMap<Ref<Resource>, int> &external_resources, HashMap<StringName, int> &string_map, const PropertyInfo &p_hint = PropertyInfo(), bool p_pad_arrays = false);
 };
 
 class ResourceFormatSaverBinary : public ResourceFormatSaver {
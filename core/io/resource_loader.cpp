@@ -343,6 +343,9 @@ void ResourceLoader::_run_load_task(void *p_userdata) {
 			load_task.status = THREAD_LOAD_FAILED;
 			return;
 		}
+		if (load_task.load_start_usec == 0) {
+			load_task.load_start_usec = OS::get_singleton()->get_ticks_usec();
+		}
 	}
 
 	ThreadLoadTask *curr_load_task_backup = curr_load_task;
@@ -365,8 +368,17 @@ void ResourceLoader::_run_load_task(void *p_userdata) {
 	bool xl_remapped = false;
 	const String &remapped_path = _path_remap(load_task.local_path, &xl_remapped);
 
+	// Start the whole dependency list up front, so dependencies load on the pool while this resource
+	// is being parsed, and their own dependencies get started as soon as their tasks run.
+	// The loader finds these tasks already started when it gets to its external resources.
+	LocalVector<Ref<LoadToken>> dependency_tokens;
+	if (load_task.use_sub_threads) {
+		_start_dependency_loads(load_task, dependency_tokens);
+	}
+
 	Error load_err = OK;
 	Ref<Resource> res = _load(remapped_path, remapped_path != load_task.local_path ? load_task.local_path : String(), load_task.type_hint, load_task.cache_mode, &load_err, load_task.use_sub_threads, &load_task.progress);
+	dependency_tokens.clear();
 	if (MessageQueue::get_singleton() != MessageQueue::get_main_singleton()) {
 		MessageQueue::get_singleton()->flush();
 	}
@@ -374,6 +386,7 @@ void ResourceLoader::_run_load_task(void *p_userdata) {
 	thread_load_mutex.lock();
 
 	load_task.resource = res;
+	load_task.load_usec = OS::get_singleton()->get_ticks_usec() - load_task.load_start_usec;
 
 	load_task.progress = 1.0; // It was fully loaded at this point, so force progress to 1.0.
 	load_task.error = load_err;
@@ -474,6 +487,37 @@ void ResourceLoader::_run_load_task(void *p_userdata) {
 	curr_load_task = curr_load_task_backup;
 }
 
+void ResourceLoader::_start_dependency_loads(const ThreadLoadTask &p_load_task, LocalVector<Ref<LoadToken>> &r_tokens) {
+	if (p_load_task.cache_mode == ResourceFormatLoader::CACHE_MODE_IGNORE_DEEP) {
+		// Loaders would start their own tasks for the dependencies instead of reusing these.
+		return;
+	}
+	// Same as what loaders use for their external resources.
+	const ResourceFormatLoader::CacheMode cache_mode_for_external = p_load_task.cache_mode == ResourceFormatLoader::CACHE_MODE_REPLACE_DEEP ? ResourceFormatLoader::CACHE_MODE_REPLACE_DEEP : ResourceFormatLoader::CACHE_MODE_REUSE;
+
+	List<String> dependencies;
+	get_dependencies(p_load_task.local_path, &dependencies, true);
+	for (const String &dependency : dependencies) {
+		// Formatted as "path_or_uid::type::fallback_path", see ResourceFormatLoader::get_dependencies().
+		const Vector<String> parts = dependency.split("::");
+		String path = parts[0];
+		const String type = parts.size() > 1 ? parts[1] : String();
+		const ResourceUID::ID uid = ResourceUID::get_singleton()->text_to_id(path);
+		if (uid != ResourceUID::INVALID_ID) {
+			path = ResourceUID::get_singleton()->has_id(uid) ? ResourceUID::get_singleton()->get_id_path(uid) : (parts.size() > 2 ? parts[2] : String());
+		}
+		if (path.is_empty() || path.is_relative_path()) {
+			// Left to the loader, which knows how to resolve it.
+			continue;
+		}
+
+		Ref<LoadToken> token = _load_start(path, type, LOAD_THREAD_DISTRIBUTE, cache_mode_for_external);
+		if (token.is_valid()) {
+			r_tokens.push_back(token);
+		}
+	}
+}
+
 String ResourceLoader::_validate_local_path(const String &p_path) {
 	ResourceUID::ID uid = ResourceUID::get_singleton()->text_to_id(p_path);
 	if (uid != ResourceUID::INVALID_ID) {
@@ -672,7 +716,30 @@ float ResourceLoader::_dependency_get_progress(const String &p_path) {
 	}
 }
 
-ResourceLoader::ThreadLoadStatus ResourceLoader::load_threaded_get_status(const String &p_path, float *r_progress) {
+void ResourceLoader::_dependency_get_load_times(ThreadLoadTask &p_load_task, HashMap<String, uint64_t> &r_load_times) {
+	if (p_load_task.in_progress_check) {
+		// See _dependency_get_progress().
+		return;
+	}
+	p_load_task.in_progress_check = true;
+
+	if (p_load_task.load_start_usec != 0) {
+		r_load_times[p_load_task.local_path] = p_load_task.status == THREAD_LOAD_IN_PROGRESS ? OS::get_singleton()->get_ticks_usec() - p_load_task.load_start_usec : p_load_task.load_usec;
+	}
+	for (const KeyValue<String, uint64_t> &E : p_load_task.dependency_load_usec) {
+		r_load_times[E.key] = E.value;
+	}
+	for (const String &E : p_load_task.sub_tasks) {
+		HashMap<String, ThreadLoadTask>::Iterator sub_task = thread_load_tasks.find(E);
+		if (sub_task) {
+			_dependency_get_load_times(sub_task->value, r_load_times);
+		}
+	}
+
+	p_load_task.in_progress_check = false;
+}
+
+ResourceLoader::ThreadLoadStatus ResourceLoader::load_threaded_get_status(const String &p_path, float *r_progress, HashMap<String, uint64_t> *r_load_times) {
 	bool ensure_progress = false;
 	ThreadLoadStatus status = THREAD_LOAD_IN_PROGRESS;
 	{
@@ -698,6 +765,9 @@ ResourceLoader::ThreadLoadStatus ResourceLoader::load_threaded_get_status(const
 		if (r_progress) {
 			*r_progress = _dependency_get_progress(local_path);
 		}
+		if (r_load_times) {
+			_dependency_get_load_times(*load_task_ptr, *r_load_times);
+		}
 
 		// Support userland polling in a loop on the main thread.
 		if (Thread::is_main_thread() && status == THREAD_LOAD_IN_PROGRESS) {
@@ -905,6 +975,17 @@ Ref<Resource> ResourceLoader::_load_complete_inner(LoadToken &p_load_token, Erro
 		*r_error = load_task_ptr->error;
 	}
 
+	if (load_task_ptr->parent_task && load_task_ptr->parent_task != load_task_ptr) {
+		// Let the awaiter accumulate the load times, so they can be reported for the whole dependency graph.
+		HashMap<String, uint64_t> &parent_load_usec = load_task_ptr->parent_task->dependency_load_usec;
+		if (load_task_ptr->load_start_usec != 0) {
+			parent_load_usec[load_task_ptr->local_path] = load_task_ptr->load_usec;
+		}
+		for (const KeyValue<String, uint64_t> &E : load_task_ptr->dependency_load_usec) {
+			parent_load_usec[E.key] = E.value;
+		}
+	}
+
 	if (resource.is_valid()) {
 		if (load_task_ptr->parent_task) {
 			// A task awaiting another => Let the awaiter accumulate the resource changed connections.
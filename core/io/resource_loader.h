@@ -190,6 +190,9 @@ private:
 		Ref<Resource> resource;
 		ThreadLoadTask *parent_task = nullptr;
 		HashSet<String> sub_tasks;
+		uint64_t load_start_usec = 0; // Zero if it didn't need loading (e.g., cached).
+		uint64_t load_usec = 0; // Wall clock time spent loading, including waiting for dependencies.
+		HashMap<String, uint64_t> dependency_load_usec; // Accumulated from awaited dependencies, as their tasks may be gone by the time it's queried.
 
 		bool awaited : 1; // If it's in the pool, this helps not awaiting from more than one dependent thread.
 		bool need_wait : 1;
@@ -210,6 +213,7 @@ private:
 				use_sub_threads(false) {}
 	};
 	static void _run_load_task(void *p_userdata);
+	static void _start_dependency_loads(const ThreadLoadTask &p_load_task, LocalVector<Ref<LoadToken>> &r_tokens);
 
 	static thread_local bool import_thread;
 	static thread_local int load_nesting;
@@ -225,6 +229,7 @@ private:
 	static HashMap<String, LoadToken *> user_load_tokens;
 
 	static float _dependency_get_progress(const String &p_path);
+	static void _dependency_get_load_times(ThreadLoadTask &p_load_task, HashMap<String, uint64_t> &r_load_times);
 
 	static bool _ensure_load_progress();
 
@@ -232,7 +237,8 @@ private:
 
 public:
 	static Error load_threaded_request(const String &p_path, const String &p_type_hint = "", bool p_use_sub_threads = false, ResourceFormatLoader::CacheMode p_cache_mode = ResourceFormatLoader::CACHE_MODE_REUSE);
-	static ThreadLoadStatus load_threaded_get_status(const String &p_path, float *r_progress = nullptr);
+	// r_load_times receives the wall clock time spent loading the resource and each of its dependencies (so far if still in progress), by path.
+	static ThreadLoadStatus load_threaded_get_status(const String &p_path, float *r_progress = nullptr, HashMap<String, uint64_t> *r_load_times = nullptr);
 	static Ref<Resource> load_threaded_get(const String &p_path, Error *r_error = nullptr);
 
 	static bool is_within_load() { return load_nesting > 0; }
@@ -63,6 +63,10 @@ ClassDB::APIType ClassDB::get_current_api() {
 }
 
 HashMap<StringName, ClassDB::ClassInfo> ClassDB::classes;
+BinaryMutex ClassDB::lookup_table_mutex;
+uint32_t ClassDB::lookup_table_count = 0;
+LocalVector<ClassDB::LookupTable *> ClassDB::retired_lookup_tables;
+SafeNumeric<uint64_t> ClassDB::lookup_version;
 HashMap<StringName, StringName> ClassDB::resource_base_extensions;
 HashMap<StringName, StringName> ClassDB::compat_classes;
 
@@ -878,6 +882,7 @@ void ClassDB::_add_class(GDType &p_class, const GDType *p_inherits) {
 	if (p_inherits) {
 		ERR_FAIL_COND(!classes.has(ti.gdtype->get_super_type_name())); //it MUST be registered.
 		ti.inherits_ptr = &classes[ti.gdtype->get_super_type_name()];
+		ti.inherits_ptr->inheriters.push_back(&ti);
 	} else {
 		ti.inherits_ptr = nullptr;
 	}
@@ -1064,6 +1069,15 @@ MethodBind *ClassDB::get_method(const StringName &p_class, const StringName &p_n
 	Locker::Lock lock(Locker::STATE_READ);
 
 	ClassInfo *type = classes.getptr(p_class);
+	if (!type) {
+		return nullptr;
+	}
+
+	const LookupTable *table = _get_lookup_table(type);
+	if (table) {
+		MethodBind *const *method = table->methods.getptr(p_name);
+		return method ? *method : nullptr;
+	}
 
 	while (type) {
 		MethodBind **method = type->method_map.getptr(p_name);
@@ -1408,6 +1422,7 @@ void ClassDB::add_property(const StringName &p_class, const PropertyInfo &p_pinf
 	psg.type = p_pinfo.type;
 
 	type->property_setget[p_pinfo.name] = psg;
+	_invalidate_lookup_tables(type);
 }
 
 void ClassDB::set_property_default_value(const StringName &p_class, const StringName &p_name, const Variant &p_default) {
@@ -1497,103 +1512,255 @@ bool ClassDB::get_property_info(const StringName &p_class, const StringName &p_p
 	return false;
 }
 
-bool ClassDB::set_property(Object *p_object, const StringName &p_property, const Variant &p_value, bool *r_valid) {
-	ERR_FAIL_NULL_V(p_object, false);
-
-	ClassInfo *type = classes.getptr(p_object->get_class_name());
-	ClassInfo *check = type;
-	while (check) {
-		const PropertySetGet *psg = check->property_setget.getptr(p_property);
+bool ClassDB::_resolve_member(const ClassInfo *p_type, const StringName &p_name, LookupTable::Member &r_member) {
+	bool found = false;
+	for (const ClassInfo *check = p_type; check; check = check->inherits_ptr) {
+		const PropertySetGet *psg = check->property_setget.getptr(p_name);
 		if (psg) {
-			if (!psg->setter) {
-				if (r_valid) {
-					*r_valid = false;
-				}
-				return true; //return true but do nothing
+			r_member.setter = psg;
+			if (!found) {
+				r_member.getter_type = LookupTable::MEMBER_PROPERTY;
+				r_member.getter = psg;
+				found = true;
 			}
+			break;
+		}
 
-			Callable::CallError ce;
+		if (found) {
+			// Only looking for a property to set now.
+			continue;
+		}
 
-			if (psg->index >= 0) {
-				Variant index = psg->index;
-				const Variant *arg[2] = { &index, &p_value };
-				//p_object->call(psg->setter,arg,2,ce);
-				if (psg->_setptr) {
-					psg->_setptr->call(p_object, arg, 2, ce);
-				} else {
-					p_object->callp(psg->setter, arg, 2, ce);
-				}
+		const int64_t *c = check->gdtype->get_integer_constant_map(true).getptr(p_name); //constants count
+		if (c) {
+			r_member.getter_type = LookupTable::MEMBER_CONSTANT;
+			r_member.constant = *c;
+			found = true;
+		} else if (check->method_map.has(p_name)) { //methods count
+			r_member.getter_type = LookupTable::MEMBER_METHOD;
+			found = true;
+		} else if (check->gdtype->get_signal_map(true).has(p_name)) { //signals count
+			r_member.getter_type = LookupTable::MEMBER_SIGNAL;
+			found = true;
+		}
+	}
+	return found;
+}
 
-			} else {
-				const Variant *arg[1] = { &p_value };
-				if (psg->_setptr) {
-					psg->_setptr->call(p_object, arg, 1, ce);
-				} else {
-					p_object->callp(psg->setter, arg, 1, ce);
-				}
-			}
+const ClassDB::LookupTable *ClassDB::_get_lookup_table(ClassInfo *p_type) {
+	LookupTable *table = p_type->lookup_table.table.load(std::memory_order_acquire);
+	if (likely(table)) {
+		return table;
+	}
 
-			if (r_valid) {
-				*r_valid = ce.error == Callable::CallError::CALL_OK;
-			}
+	if (Locker::get_thread_state() == Locker::STATE_WRITE) {
+		// This thread is registering members, which would invalidate the table right away.
+		return nullptr;
+	}
 
-			return true;
+	Locker::Lock lock(Locker::STATE_READ);
+	MutexLock table_lock(lookup_table_mutex);
+
+	table = p_type->lookup_table.table.load(std::memory_order_relaxed);
+	if (table) {
+		return table;
+	}
+
+	table = memnew(LookupTable);
+	for (const ClassInfo *check = p_type; check; check = check->inherits_ptr) {
+		for (const KeyValue<StringName, PropertySetGet> &E : check->property_setget) {
+			if (!table->members.has(E.key)) {
+				_resolve_member(p_type, E.key, table->members[E.key]);
+			}
+		}
+		for (const KeyValue<StringName, int64_t> &E : check->gdtype->get_integer_constant_map(true)) {
+			if (!table->members.has(E.key)) {
+				_resolve_member(p_type, E.key, table->members[E.key]);
+			}
+		}
+		for (const KeyValue<StringName, MethodBind *> &E : check->method_map) {
+			if (!table->members.has(E.key)) {
+				_resolve_member(p_type, E.key, table->members[E.key]);
+			}
+			if (E.value && !table->methods.has(E.key)) {
+				table->methods.insert(E.key, E.value);
+			}
+		}
+		for (const KeyValue<StringName, const MethodInfo *> &E : check->gdtype->get_signal_map(true)) {
+			if (!table->members.has(E.key)) {
+				_resolve_member(p_type, E.key, table->members[E.key]);
+			}
 		}
+	}
 
-		check = check->inherits_ptr;
+	lookup_table_count++;
+	p_type->lookup_table.table.store(table, std::memory_order_release);
+	return table;
+}
+
+void ClassDB::_retire_lookup_tables(ClassInfo *p_type) {
+	LookupTable *table = p_type->lookup_table.table.exchange(nullptr, std::memory_order_acq_rel);
+	if (table) {
+		retired_lookup_tables.push_back(table);
+		lookup_table_count--;
+	}
+	for (ClassInfo *inheriter : p_type->inheriters) {
+		_retire_lookup_tables(inheriter);
 	}
+}
 
-	return false;
+void ClassDB::_invalidate_lookup_tables(ClassInfo *p_type) {
+	// Must be called with at least the read lock held, so the class hierarchy doesn't change meanwhile.
+	// Tables are read without locking, so the invalidated ones are retired instead of freed.
+	MutexLock table_lock(lookup_table_mutex);
+	if (lookup_table_count > 0) {
+		_retire_lookup_tables(p_type);
+	}
+	// Only bumped once the tables are gone, otherwise a concurrent lookup could cache
+	// a member of a retired table with the new version.
+	lookup_version.increment();
 }
 
-bool ClassDB::get_property(Object *p_object, const StringName &p_property, Variant &r_value) {
+void ClassDB::_gdtype_members_changed(const GDType &p_type) {
+	// Invalidating only needs to read `classes`. This doesn't lock again if the thread
+	// already holds the read or the write lock.
+	Locker::Lock lock(Locker::STATE_READ);
+
+	ClassInfo *type = classes.getptr(p_type.get_name());
+	if (type) {
+		_invalidate_lookup_tables(type);
+	}
+}
+
+const ClassDB::LookupTable::Member *ClassDB::_get_member(Object *p_object, const StringName &p_property, PropertyCache *r_cache, LookupTable::Member &r_uncached) {
+	const GDType *gdtype = &p_object->get_gdtype();
+	const uint64_t version = r_cache ? lookup_version.get() : 0;
+	if (r_cache && likely(r_cache->type == gdtype && r_cache->name == p_property && r_cache->version == version)) {
+		return r_cache->member;
+	}
+
+	ClassInfo *type = classes.getptr(gdtype->get_name());
+	if (!type) {
+		return nullptr;
+	}
+
+	const LookupTable *table = _get_lookup_table(type);
+	if (!table) {
+		return _resolve_member(type, p_property, r_uncached) ? &r_uncached : nullptr;
+	}
+
+	const LookupTable::Member *member = table->members.getptr(p_property);
+	if (r_cache) {
+		r_cache->type = gdtype;
+		r_cache->name = p_property;
+		r_cache->version = version;
+		r_cache->member = member;
+	}
+	return member;
+}
+
+bool ClassDB::set_property(Object *p_object, const StringName &p_property, const Variant &p_value, bool *r_valid) {
+	return _set_property(p_object, p_property, p_value, nullptr, r_valid);
+}
+
+bool ClassDB::set_property(Object *p_object, const StringName &p_property, const Variant &p_value, PropertyCache &r_cache, bool *r_valid) {
+	return _set_property(p_object, p_property, p_value, &r_cache, r_valid);
+}
+
+bool ClassDB::_set_property(Object *p_object, const StringName &p_property, const Variant &p_value, PropertyCache *r_cache, bool *r_valid) {
 	ERR_FAIL_NULL_V(p_object, false);
 
-	ClassInfo *type = classes.getptr(p_object->get_class_name());
-	ClassInfo *check = type;
-	while (check) {
-		const PropertySetGet *psg = check->property_setget.getptr(p_property);
-		if (psg) {
-			if (!psg->getter) {
-				return true; //return true but do nothing
-			}
+	LookupTable::Member uncached;
+	const LookupTable::Member *member = _get_member(p_object, p_property, r_cache, uncached);
+	if (!member || !member->setter) {
+		return false;
+	}
 
-			if (psg->index >= 0) {
-				Variant index = psg->index;
-				const Variant *arg[1] = { &index };
-				Callable::CallError ce;
-				const Variant value = p_object->callp(psg->getter, arg, 1, ce);
-				r_value = (ce.error == Callable::CallError::CALL_OK) ? value : Variant();
-
-			} else {
-				Callable::CallError ce;
-				if (psg->_getptr) {
-					r_value = psg->_getptr->call(p_object, nullptr, 0, ce);
-				} else {
-					const Variant value = p_object->callp(psg->getter, nullptr, 0, ce);
-					r_value = (ce.error == Callable::CallError::CALL_OK) ? value : Variant();
-				}
-			}
-			return true;
+	const PropertySetGet *psg = member->setter;
+	if (!psg->setter) {
+		if (r_valid) {
+			*r_valid = false;
 		}
+		return true; //return true but do nothing
+	}
 
-		const int64_t *c = check->gdtype->get_integer_constant_map(true).getptr(p_property); //constants count
-		if (c) {
-			r_value = *c;
-			return true;
-		}
+	Callable::CallError ce;
 
-		if (check->method_map.has(p_property)) { //methods count
-			r_value = Callable(p_object, p_property);
-			return true;
+	if (psg->index >= 0) {
+		Variant index = psg->index;
+		const Variant *arg[2] = { &index, &p_value };
+		//p_object->call(psg->setter,arg,2,ce);
+		if (psg->_setptr) {
+			psg->_setptr->call(p_object, arg, 2, ce);
+		} else {
+			p_object->callp(psg->setter, arg, 2, ce);
 		}
 
-		if (check->gdtype->get_signal_map(true).has(p_property)) { //signals count
-			r_value = Signal(p_object, p_property);
-			return true;
+	} else {
+		const Variant *arg[1] = { &p_value };
+		if (psg->_setptr) {
+			psg->_setptr->call(p_object, arg, 1, ce);
+		} else {
+			p_object->callp(psg->setter, arg, 1, ce);
 		}
+	}
 
-		check = check->inherits_ptr;
+	if (r_valid) {
+		*r_valid = ce.error == Callable::CallError::CALL_OK;
+	}
+
+	return true;
+}
+
+bool ClassDB::get_property(Object *p_object, const StringName &p_property, Variant &r_value) {
+	return _get_property(p_object, p_property, r_value, nullptr);
+}
+
+bool ClassDB::get_property(Object *p_object, const StringName &p_property, Variant &r_value, PropertyCache &r_cache) {
+	return _get_property(p_object, p_property, r_value, &r_cache);
+}
+
+bool ClassDB::_get_property(Object *p_object, const StringName &p_property, Variant &r_value, PropertyCache *r_cache) {
+	ERR_FAIL_NULL_V(p_object, false);
+
+	LookupTable::Member uncached;
+	const LookupTable::Member *member = _get_member(p_object, p_property, r_cache, uncached);
+	if (member) {
+		switch (member->getter_type) {
+			case LookupTable::MEMBER_PROPERTY: {
+				const PropertySetGet *psg = member->getter;
+				if (!psg->getter) {
+					return true; //return true but do nothing
+				}
+
+				if (psg->index >= 0) {
+					Variant index = psg->index;
+					const Variant *arg[1] = { &index };
+					Callable::CallError ce;
+					const Variant value = p_object->callp(psg->getter, arg, 1, ce);
+					r_value = (ce.error == Callable::CallError::CALL_OK) ? value : Variant();
+
+				} else {
+					Callable::CallError ce;
+					if (psg->_getptr) {
+						r_value = psg->_getptr->call(p_object, nullptr, 0, ce);
+					} else {
+						const Variant value = p_object->callp(psg->getter, nullptr, 0, ce);
+						r_value = (ce.error == Callable::CallError::CALL_OK) ? value : Variant();
+					}
+				}
+			} break;
+			case LookupTable::MEMBER_CONSTANT: {
+				r_value = member->constant;
+			} break;
+			case LookupTable::MEMBER_METHOD: {
+				r_value = Callable(p_object, p_property);
+			} break;
+			case LookupTable::MEMBER_SIGNAL: {
+				r_value = Signal(p_object, p_property);
+			} break;
+		}
+		return true;
 	}
 
 	// The "free()" method is special, so we assume it exists and return a Callable.
@@ -1787,6 +1954,7 @@ void ClassDB::_bind_method_custom(const StringName &p_class, MethodBind *p_metho
 #endif // DEBUG_ENABLED
 
 	type->method_map[method_name] = p_method;
+	_invalidate_lookup_tables(type);
 }
 
 MethodBind *ClassDB::_bind_vararg_method(MethodBind *p_bind, const StringName &p_name, const Vector<Variant> &p_default_args, bool p_compatibility) {
@@ -1813,6 +1981,7 @@ MethodBind *ClassDB::_bind_vararg_method(MethodBind *p_bind, const StringName &p
 		ERR_FAIL_V_MSG(nullptr, vformat("Method already bound: '%s::%s'.", instance_type, p_name));
 	}
 	type->method_map[p_name] = bind;
+	_invalidate_lookup_tables(type);
 #ifdef DEBUG_ENABLED
 	// FIXME: <reduz> set_return_type is no longer in MethodBind, so I guess it should be moved to vararg method bind
 	//bind->set_return_type("Variant");
@@ -1876,6 +2045,7 @@ MethodBind *ClassDB::bind_methodfi(uint32_t p_flags, MethodBind *p_bind, bool p_
 		_bind_compatibility(type, p_bind);
 	} else {
 		type->method_map[mdname] = p_bind;
+		_invalidate_lookup_tables(type);
 	}
 
 	Vector<Variant> defvals;
@@ -2220,11 +2390,18 @@ void ClassDB::register_extension_class(ObjectGDExtension *p_extension) {
 	c.gdtype = p_extension->gdtype;
 
 	classes[p_extension->class_name] = c;
+	c.inherits_ptr->inheriters.push_back(&classes[p_extension->class_name]);
 }
 
 void ClassDB::unregister_extension_class(const StringName &p_class, bool p_free_method_binds) {
+	Locker::Lock lock(Locker::STATE_WRITE);
+
 	ClassInfo *c = classes.getptr(p_class);
 	ERR_FAIL_NULL_MSG(c, vformat("Class '%s' does not exist.", String(p_class)));
+	_invalidate_lookup_tables(c);
+	if (c->inherits_ptr) {
+		c->inherits_ptr->inheriters.erase(c);
+	}
 	if (p_free_method_binds) {
 		for (KeyValue<StringName, MethodBind *> &F : c->method_map) {
 			memdelete(F.value);
@@ -2278,6 +2455,11 @@ void ClassDB::cleanup() {
 	for (KeyValue<StringName, ClassInfo> &E : classes) {
 		ClassInfo &ti = E.value;
 
+		LookupTable *table = ti.lookup_table.table.exchange(nullptr, std::memory_order_relaxed);
+		if (table) {
+			memdelete(table);
+		}
+
 		for (KeyValue<StringName, MethodBind *> &F : ti.method_map) {
 			memdelete(F.value);
 		}
@@ -2302,6 +2484,11 @@ void ClassDB::cleanup() {
 		*type = nullptr;
 	}
 	gdtype_autorelease_pool.clear();
+	for (LookupTable *table : retired_lookup_tables) {
+		memdelete(table);
+	}
+	retired_lookup_tables.clear();
+	lookup_table_count = 0;
 }
 
 // Array to use in optional parameters on methods and the DEFVAL_ARRAY macro.
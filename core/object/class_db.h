@@ -107,6 +107,10 @@ public:
 		API_NONE
 	};
 
+	// Kept by callers for each place a property is accessed, see set_property() and get_property().
+	// A cache must not be shared between threads.
+	using PropertyCache = Object::PropertyCache;
+
 public:
 	struct PropertySetGet {
 		int index;
@@ -117,6 +121,38 @@ public:
 		Variant::Type type;
 	};
 
+	// All members of a class and its ancestors, resolved the same way set_property(),
+	// get_property() and get_method() would by walking the inheritance chain.
+	struct LookupTable {
+		enum MemberType {
+			MEMBER_PROPERTY,
+			MEMBER_CONSTANT,
+			MEMBER_METHOD,
+			MEMBER_SIGNAL,
+		};
+
+		struct Member {
+			// First property with this name up the inheritance chain, used for setting.
+			const PropertySetGet *setter = nullptr;
+			// What getting this name returns. Inherited properties can be shadowed by constants, methods and signals.
+			MemberType getter_type = MEMBER_PROPERTY;
+			const PropertySetGet *getter = nullptr;
+			int64_t constant = 0;
+		};
+
+		AHashMap<StringName, Member> members;
+		AHashMap<StringName, MethodBind *> methods;
+	};
+
+	// Tables are built on demand and published without locking, so copying a ClassInfo doesn't copy them.
+	struct LookupTablePtr {
+		std::atomic<LookupTable *> table = nullptr;
+
+		LookupTablePtr() {}
+		LookupTablePtr(const LookupTablePtr &p_other) {}
+		LookupTablePtr &operator=(const LookupTablePtr &p_other) { return *this; }
+	};
+
 	struct ClassInfo {
 		APIType api = API_NONE;
 		ClassInfo *inherits_ptr = nullptr;
@@ -147,6 +183,10 @@ public:
 		AHashMap<StringName, PropertySetGet> property_setget;
 		HashMap<StringName, Vector<uint32_t>> virtual_methods_compat;
 
+		LookupTablePtr lookup_table;
+		// Classes inheriting directly from this one, whose lookup tables depend on it.
+		LocalVector<ClassInfo *> inheriters;
+
 		bool disabled = false;
 		bool exposed = false;
 		bool reloadable = false;
@@ -181,6 +221,8 @@ public:
 		inline thread_local static State thread_state = STATE_UNLOCKED;
 
 	public:
+		static State get_thread_state() { return thread_state; }
+
 		class Lock {
 			State state = STATE_UNLOCKED;
 
@@ -234,6 +276,22 @@ private:
 	static MethodBind *_bind_vararg_method(MethodBind *p_bind, const StringName &p_name, const Vector<Variant> &p_default_args, bool p_compatibility);
 	static void _bind_method_custom(const StringName &p_class, MethodBind *p_method, bool p_compatibility);
 
+	static BinaryMutex lookup_table_mutex;
+	static uint32_t lookup_table_count;
+	// Invalidated tables may still be read by other threads, so they are only freed on cleanup.
+	static LocalVector<LookupTable *> retired_lookup_tables;
+	static SafeNumeric<uint64_t> lookup_version;
+
+	static bool _resolve_member(const ClassInfo *p_type, const StringName &p_name, LookupTable::Member &r_member);
+	static const LookupTable *_get_lookup_table(ClassInfo *p_type);
+	static void _retire_lookup_tables(ClassInfo *p_type);
+	static void _invalidate_lookup_tables(ClassInfo *p_type);
+	friend class GDType;
+	static void _gdtype_members_changed(const GDType &p_type);
+	static const LookupTable::Member *_get_member(Object *p_object, const StringName &p_property, PropertyCache *r_cache, LookupTable::Member &r_uncached);
+	static bool _set_property(Object *p_object, const StringName &p_property, const Variant &p_value, PropertyCache *r_cache, bool *r_valid);
+	static bool _get_property(Object *p_object, const StringName &p_property, Variant &r_value, PropertyCache *r_cache);
+
 	static Object *_instantiate_internal(const StringName &p_class, bool p_require_real_class = false, bool p_notify_postinitialize = true, bool p_exposed_only = true);
 
 	static bool _can_instantiate(ClassInfo *p_class_info, bool p_exposed_only = true);
@@ -470,6 +528,10 @@ public:
 	static void get_linked_properties_info(const StringName &p_class, const StringName &p_property, List<StringName> *r_properties, bool p_no_inheritance = false);
 	static bool set_property(Object *p_object, const StringName &p_property, const Variant &p_value, bool *r_valid = nullptr);
 	static bool get_property(Object *p_object, const StringName &p_property, Variant &r_value);
+	// Same as above, but remember how the property was resolved in r_cache, so repeated accesses to
+	// the same property of objects of the same class don't need to look it up again.
+	static bool set_property(Object *p_object, const StringName &p_property, const Variant &p_value, PropertyCache &r_cache, bool *r_valid = nullptr);
+	static bool get_property(Object *p_object, const StringName &p_property, Variant &r_value, PropertyCache &r_cache);
 	static bool has_property(const StringName &p_class, const StringName &p_property, bool p_no_inheritance = false);
 	static int get_property_index(const StringName &p_class, const StringName &p_property, bool *r_is_valid = nullptr);
 	static Variant::Type get_property_type(const StringName &p_class, const StringName &p_property, bool *r_is_valid = nullptr);
@@ -541,6 +603,14 @@ public:
 	static Object *_instantiate_allow_unexposed(const StringName &p_class); // Used to create unexposed classes from GDExtension, typically for unexposed EditorPlugin.
 };
 
+struct Object::PropertyCache {
+	const GDType *type = nullptr;
+	StringName name;
+	uint64_t version = 0;
+	// Null if the class has no member with this name.
+	const ClassDB::LookupTable::Member *member = nullptr;
+};
+
 #define BIND_ENUM_CONSTANT(m_constant) \
 	get_gdtype_static_mutable().bind_integer_constant(__constant_get_enum_name(m_constant), __constant_get_enum_value_name(#m_constant), m_constant);
 
@@ -30,6 +30,7 @@
 
 #include "gdtype.h"
 
+#include "core/object/class_db.h"
 #include "core/os/memory.h"
 #include "core/os/thread.h"
 
@@ -100,6 +101,8 @@ void GDType::bind_integer_constant(const StringName &p_enum, const StringName &p
 			enum_map[enum_name] = enum_info;
 		}
 	}
+
+	ClassDB::_gdtype_members_changed(*this);
 }
 
 const GDType::EnumInfo *GDType::get_integer_constant_enum(const StringName &p_name, bool p_no_inheritance) const {
@@ -123,4 +126,6 @@ void GDType::add_signal(MethodInfo p_signal) {
 
 	signal_map[signal_name] = ptr;
 	self_signal_map[std::move(signal_name)] = ptr;
+
+	ClassDB::_gdtype_members_changed(*this);
 }
@@ -56,13 +56,112 @@
 		mutex.unlock(); \
 	}
 
-void CallQueue::_add_page() {
-	if (pages_used == page_bytes.size()) {
-		pages.push_back(allocator->alloc());
-		page_bytes.push_back(0);
+static SafeNumeric<uint64_t> last_call_queue_id;
+
+thread_local uint64_t CallQueue::cached_queue_id = 0;
+thread_local CallQueue::Producer *CallQueue::cached_producer = nullptr;
+thread_local CallQueue::ProducerReleaser CallQueue::producer_releaser;
+
+CallQueue::ProducerReleaser::~ProducerReleaser() {
+	for (Producer *producer : producers) {
+		producer->thread_exited.set();
+		if (producer->refcount.unref()) {
+			memdelete(producer);
+		}
+	}
+}
+
+void CallQueue::_add_page(PageChain &p_chain) {
+	if (p_chain.pages_used == p_chain.page_bytes.size()) {
+		p_chain.pages.push_back(allocator->alloc());
+		p_chain.page_bytes.push_back(0);
+	}
+	p_chain.page_bytes[p_chain.pages_used] = 0;
+	p_chain.pages_used++;
+}
+
+uint8_t *CallQueue::_alloc_message(PageChain &p_chain, uint32_t p_room_needed) {
+	_ensure_first_page(p_chain);
+
+	if ((p_chain.page_bytes[p_chain.pages_used - 1] + p_room_needed) > uint32_t(PAGE_SIZE_BYTES)) {
+		if (p_chain.pages_used == max_pages) {
+			return nullptr;
+		}
+		_add_page(p_chain);
+	}
+
+	uint8_t *buffer_end = &p_chain.pages[p_chain.pages_used - 1]->data[p_chain.page_bytes[p_chain.pages_used - 1]];
+	p_chain.page_bytes[p_chain.pages_used - 1] += p_room_needed;
+	p_chain.pushed_messages++;
+	p_chain.pushed_bytes += p_room_needed;
+	return buffer_end;
+}
+
+CallQueue::Producer *CallQueue::_get_producer() {
+	if (likely(cached_queue_id == queue_id)) {
+		return cached_producer;
+	}
+
+	const Thread::ID thread_id = Thread::get_caller_id();
+	Producer *producer = nullptr;
+	{
+		MutexLock lock(producers_mutex);
+		for (Producer *E : producers) {
+			if (E->thread_id == thread_id && !E->thread_exited.is_set()) {
+				producer = E;
+				break;
+			}
+		}
+		if (!producer) {
+			producer = memnew(Producer);
+			producer->thread_id = thread_id;
+			producer->refcount.init(2);
+			producers.push_back(producer);
+			producer_releaser.producers.push_back(producer);
+		}
+	}
+
+	cached_queue_id = queue_id;
+	cached_producer = producer;
+	return producer;
+}
+
+void CallQueue::_release_producer(Producer *p_producer) {
+	for (PageChain &page_chain : p_producer->chains) {
+		_destroy_messages(page_chain);
+		released_pushed_messages += page_chain.pushed_messages;
+		released_pushed_bytes += page_chain.pushed_bytes;
+		for (uint32_t i = 0; i < page_chain.pages.size(); i++) {
+			allocator->free(page_chain.pages[i]);
+		}
+		page_chain.pages.clear();
+		page_chain.page_bytes.clear();
+	}
+
+	if (p_producer->refcount.unref()) {
+		memdelete(p_producer);
+	}
+}
+
+CallQueue::PageChain &CallQueue::_lock_chain(Producer *&r_producer) {
+	if (multi_producer) {
+		r_producer = _get_producer();
+		r_producer->mutex.lock();
+		return r_producer->chains[r_producer->active];
+	}
+
+	r_producer = nullptr;
+	LOCK_MUTEX;
+	return chain;
+}
+
+void CallQueue::_unlock_chain(Producer *p_producer) {
+	if (p_producer) {
+		p_producer->mutex.unlock();
+		return;
 	}
-	page_bytes[pages_used] = 0;
-	pages_used++;
+
+	UNLOCK_MUTEX;
 }
 
 Error CallQueue::push_callp(ObjectID p_id, const StringName &p_method, const Variant **p_args, int p_argcount, bool p_show_error) {
@@ -86,24 +185,17 @@ Error CallQueue::push_callablep(const Callable &p_callable, const Variant **p_ar
 
 	ERR_FAIL_COND_V_MSG(room_needed > uint32_t(PAGE_SIZE_BYTES), ERR_INVALID_PARAMETER, "Message is too large to fit on a page (" + itos(PAGE_SIZE_BYTES) + " bytes), consider passing less arguments.");
 
-	LOCK_MUTEX;
-
-	_ensure_first_page();
+	Producer *producer;
+	PageChain &page_chain = _lock_chain(producer);
 
-	if ((page_bytes[pages_used - 1] + room_needed) > uint32_t(PAGE_SIZE_BYTES)) {
-		if (pages_used == max_pages) {
-			fprintf(stderr, "Failed method: %s. Message queue out of memory. %s\n", String(p_callable).utf8().get_data(), error_text.utf8().get_data());
-			statistics();
-			UNLOCK_MUTEX;
-			return ERR_OUT_OF_MEMORY;
-		}
-		_add_page();
+	uint8_t *buffer_end = _alloc_message(page_chain, room_needed);
+	if (unlikely(!buffer_end)) {
+		_unlock_chain(producer);
+		fprintf(stderr, "Failed method: %s. Message queue out of memory. %s\n", String(p_callable).utf8().get_data(), error_text.utf8().get_data());
+		statistics();
+		return ERR_OUT_OF_MEMORY;
 	}
 
-	Page *page = pages[pages_used - 1];
-
-	uint8_t *buffer_end = &page->data[page_bytes[pages_used - 1]];
-
 	Message *msg = memnew_placement(buffer_end, Message);
 	msg->args = p_argcount;
 	msg->callable = p_callable;
@@ -124,37 +216,29 @@ Error CallQueue::push_callablep(const Callable &p_callable, const Variant **p_ar
 		*v = *p_args[i];
 	}
 
-	page_bytes[pages_used - 1] += room_needed;
-
-	UNLOCK_MUTEX;
+	_unlock_chain(producer);
 
 	return OK;
 }
 
 Error CallQueue::push_set(ObjectID p_id, const StringName &p_prop, const Variant &p_value) {
-	LOCK_MUTEX;
 	uint32_t room_needed = sizeof(Message) + sizeof(Variant);
 
-	_ensure_first_page();
-
-	if ((page_bytes[pages_used - 1] + room_needed) > uint32_t(PAGE_SIZE_BYTES)) {
-		if (pages_used == max_pages) {
-			String type;
-			if (ObjectDB::get_instance(p_id)) {
-				type = ObjectDB::get_instance(p_id)->get_class();
-			}
-			fprintf(stderr, "Failed set: %s: %s target ID: %s. Message queue out of memory. %s\n", type.utf8().get_data(), String(p_prop).utf8().get_data(), itos(p_id).utf8().get_data(), error_text.utf8().get_data());
-			statistics();
+	Producer *producer;
+	PageChain &page_chain = _lock_chain(producer);
 
-			UNLOCK_MUTEX;
-			return ERR_OUT_OF_MEMORY;
+	uint8_t *buffer_end = _alloc_message(page_chain, room_needed);
+	if (unlikely(!buffer_end)) {
+		_unlock_chain(producer);
+		String type;
+		if (ObjectDB::get_instance(p_id)) {
+			type = ObjectDB::get_instance(p_id)->get_class();
 		}
-		_add_page();
+		fprintf(stderr, "Failed set: %s: %s target ID: %s. Message queue out of memory. %s\n", type.utf8().get_data(), String(p_prop).utf8().get_data(), itos(p_id).utf8().get_data(), error_text.utf8().get_data());
+		statistics();
+		return ERR_OUT_OF_MEMORY;
 	}
 
-	Page *page = pages[pages_used - 1];
-	uint8_t *buffer_end = &page->data[page_bytes[pages_used - 1]];
-
 	Message *msg = memnew_placement(buffer_end, Message);
 	msg->args = 1;
 	msg->callable = Callable(p_id, p_prop);
@@ -165,32 +249,26 @@ Error CallQueue::push_set(ObjectID p_id, const StringName &p_prop, const Variant
 	Variant *v = memnew_placement(buffer_end, Variant);
 	*v = p_value;
 
-	page_bytes[pages_used - 1] += room_needed;
-	UNLOCK_MUTEX;
+	_unlock_chain(producer);
 
 	return OK;
 }
 
 Error CallQueue::push_notification(ObjectID p_id, int p_notification) {
 	ERR_FAIL_COND_V(p_notification < 0, ERR_INVALID_PARAMETER);
-	LOCK_MUTEX;
 	uint32_t room_needed = sizeof(Message);
 
-	_ensure_first_page();
+	Producer *producer;
+	PageChain &page_chain = _lock_chain(producer);
 
-	if ((page_bytes[pages_used - 1] + room_needed) > uint32_t(PAGE_SIZE_BYTES)) {
-		if (pages_used == max_pages) {
-			fprintf(stderr, "Failed notification: %d target ID: %s. Message queue out of memory. %s\n", p_notification, itos(p_id).utf8().get_data(), error_text.utf8().get_data());
-			statistics();
-			UNLOCK_MUTEX;
-			return ERR_OUT_OF_MEMORY;
-		}
-		_add_page();
+	uint8_t *buffer_end = _alloc_message(page_chain, room_needed);
+	if (unlikely(!buffer_end)) {
+		_unlock_chain(producer);
+		fprintf(stderr, "Failed notification: %d target ID: %s. Message queue out of memory. %s\n", p_notification, itos(p_id).utf8().get_data(), error_text.utf8().get_data());
+		statistics();
+		return ERR_OUT_OF_MEMORY;
 	}
 
-	Page *page = pages[pages_used - 1];
-	uint8_t *buffer_end = &page->data[page_bytes[pages_used - 1]];
-
 	Message *msg = memnew_placement(buffer_end, Message);
 
 	msg->type = TYPE_NOTIFICATION;
@@ -198,8 +276,7 @@ Error CallQueue::push_notification(ObjectID p_id, int p_notification) {
 	//msg->target;
 	msg->notification = p_notification;
 
-	page_bytes[pages_used - 1] += room_needed;
-	UNLOCK_MUTEX;
+	_unlock_chain(producer);
 
 	return OK;
 }
@@ -221,10 +298,148 @@ void CallQueue::_call_function(const Callable &p_callable, const Variant *p_args
 	}
 }
 
+uint32_t CallQueue::_get_message_size(const Message *p_message) {
+	uint32_t size = sizeof(Message);
+	if ((p_message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
+		size += sizeof(Variant) * p_message->args;
+	}
+	return size;
+}
+
+void CallQueue::_destroy_message(Message *p_message) {
+	if ((p_message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
+		Variant *args = (Variant *)(p_message + 1);
+		for (int k = 0; k < p_message->args; k++) {
+			args[k].~Variant();
+		}
+	}
+
+	p_message->~Message();
+}
+
+void CallQueue::_process_message(Message *p_message) {
+	Object *target = p_message->callable.get_object();
+
+	switch (p_message->type & FLAG_MASK) {
+		case TYPE_CALL: {
+			if (target || (p_message->type & FLAG_NULL_IS_OK)) {
+				Variant *args = (Variant *)(p_message + 1);
+				_call_function(p_message->callable, args, p_message->args, p_message->type & FLAG_SHOW_ERROR);
+			}
+		} break;
+		case TYPE_NOTIFICATION: {
+			if (target) {
+				target->notification(p_message->notification);
+			}
+		} break;
+		case TYPE_SET: {
+			if (target) {
+				Variant *arg = (Variant *)(p_message + 1);
+				target->set(p_message->callable.get_method(), *arg);
+			}
+		} break;
+	}
+
+	_destroy_message(p_message);
+}
+
+void CallQueue::_destroy_messages(PageChain &p_chain) {
+	if (p_chain.pages.is_empty()) {
+		return;
+	}
+
+	for (uint32_t i = 0; i < p_chain.pages_used; i++) {
+		uint32_t offset = 0;
+		while (offset < p_chain.page_bytes[i]) {
+			Message *message = (Message *)&p_chain.pages[i]->data[offset];
+			offset += _get_message_size(message);
+			_destroy_message(message);
+		}
+	}
+
+	p_chain.pages_used = 1;
+	p_chain.page_bytes[0] = 0;
+}
+
+uint32_t CallQueue::_flush_chain(PageChain &p_chain) {
+	// The chain is no longer reachable by its producer, so no lock is needed here.
+	uint32_t flushed = 0;
+	for (uint32_t i = 0; i < p_chain.pages_used; i++) {
+		uint32_t offset = 0;
+		while (offset < p_chain.page_bytes[i]) {
+			Message *message = (Message *)&p_chain.pages[i]->data[offset];
+			offset += _get_message_size(message);
+			_process_message(message);
+			flushed++;
+		}
+	}
+
+	p_chain.pages_used = 1;
+	p_chain.page_bytes[0] = 0;
+	return flushed;
+}
+
+Error CallQueue::_flush_multi_producer() {
+	{
+		MutexLock lock(mutex);
+		if (flushing) {
+			return ERR_BUSY;
+		}
+		flushing = true;
+	}
+
+	uint64_t flushed = 0;
+	LocalVector<PageChain *> pending;
+
+	// Keep going until no producer has anything left, so calls pushed while flushing
+	// (including by the flushed calls themselves) are processed in this same flush.
+	while (true) {
+		{
+			MutexLock lock(producers_mutex);
+			for (uint32_t i = 0; i < producers.size(); i++) {
+				Producer *producer = producers[i];
+				if (producer->thread_exited.is_set() && !producer->chains[producer->active].has_messages()) {
+					// Nothing can be pushed to it anymore, and the other chain was processed by a previous round.
+					_release_producer(producer);
+					producers.remove_at(i);
+					i--;
+					continue;
+				}
+
+				MutexLock producer_lock(producer->mutex);
+				PageChain &active = producer->chains[producer->active];
+				if (active.has_messages()) {
+					// The other chain was emptied by a previous round, the producer continues there.
+					pending.push_back(&active);
+					producer->active ^= 1;
+				}
+			}
+		}
+
+		if (pending.is_empty()) {
+			break;
+		}
+
+		for (PageChain *page_chain : pending) {
+			flushed += _flush_chain(*page_chain);
+		}
+		pending.clear();
+	}
+
+	MutexLock lock(mutex);
+	flushed_messages += flushed;
+	flushing = false;
+	return OK;
+}
+
 Error CallQueue::flush() {
+	if (multi_producer) {
+		return _flush_multi_producer();
+	}
+
 	LOCK_MUTEX;
 
-	if (pages.is_empty()) {
+	if (chain.pages.is_empty()) {
 		// Never allocated
 		UNLOCK_MUTEX;
 		return OK; // Do nothing.
@@ -239,65 +454,34 @@ Error CallQueue::flush() {
 
 	uint32_t i = 0;
 	uint32_t offset = 0;
+	uint64_t flushed = 0;
 
-	while (i < pages_used && offset < page_bytes[i]) {
-		Page *page = pages[i];
+	while (i < chain.pages_used && offset < chain.page_bytes[i]) {
+		Page *page = chain.pages[i];
 
 		//lock on each iteration, so a call can re-add itself to the message queue
 
 		Message *message = (Message *)&page->data[offset];
 
-		uint32_t advance = sizeof(Message);
-		if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-			advance += sizeof(Variant) * message->args;
-		}
-
 		//pre-advance so this function is reentrant
-		offset += advance;
-
-		Object *target = message->callable.get_object();
+		offset += _get_message_size(message);
 
 		UNLOCK_MUTEX;
 
-		switch (message->type & FLAG_MASK) {
-			case TYPE_CALL: {
-				if (target || (message->type & FLAG_NULL_IS_OK)) {
-					Variant *args = (Variant *)(message + 1);
-					_call_function(message->callable, args, message->args, message->type & FLAG_SHOW_ERROR);
-				}
-			} break;
-			case TYPE_NOTIFICATION: {
-				if (target) {
-					target->notification(message->notification);
-				}
-			} break;
-			case TYPE_SET: {
-				if (target) {
-					Variant *arg = (Variant *)(message + 1);
-					target->set(message->callable.get_method(), *arg);
-				}
-			} break;
-		}
-
-		if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-			Variant *args = (Variant *)(message + 1);
-			for (int k = 0; k < message->args; k++) {
-				args[k].~Variant();
-			}
-		}
-
-		message->~Message();
+		_process_message(message);
+		flushed++;
 
 		LOCK_MUTEX;
-		if (offset == page_bytes[i]) {
+		if (offset == chain.page_bytes[i]) {
 			i++;
 			offset = 0;
 		}
 	}
 
-	page_bytes[0] = 0;
-	pages_used = 1;
+	chain.page_bytes[0] = 0;
+	chain.pages_used = 1;
 
+	flushed_messages += flushed;
 	flushing = false;
 	UNLOCK_MUTEX;
 	return OK;
@@ -305,123 +489,93 @@ Error CallQueue::flush() {
 
 void CallQueue::clear() {
 	LOCK_MUTEX;
+	_destroy_messages(chain);
+	UNLOCK_MUTEX;
 
-	if (pages.is_empty()) {
-		UNLOCK_MUTEX;
-		return; // Nothing to clear.
-	}
-
-	for (uint32_t i = 0; i < pages_used; i++) {
-		uint32_t offset = 0;
-		while (offset < page_bytes[i]) {
-			Page *page = pages[i];
-
-			//lock on each iteration, so a call can re-add itself to the message queue
-
-			Message *message = (Message *)&page->data[offset];
-
-			uint32_t advance = sizeof(Message);
-			if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-				advance += sizeof(Variant) * message->args;
-			}
-
-			offset += advance;
-
-			if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-				Variant *args = (Variant *)(message + 1);
-				for (int k = 0; k < message->args; k++) {
-					args[k].~Variant();
-				}
-			}
-
-			message->~Message();
+	if (multi_producer) {
+		MutexLock lock(producers_mutex);
+		for (Producer *producer : producers) {
+			MutexLock producer_lock(producer->mutex);
+			// The inactive chain is either empty or being processed by flush().
+			_destroy_messages(producer->chains[producer->active]);
 		}
 	}
-
-	pages_used = 1;
-	page_bytes[0] = 0;
-
-	UNLOCK_MUTEX;
 }
 
 void CallQueue::statistics() {
-	LOCK_MUTEX;
 	HashMap<StringName, int> set_count;
 	HashMap<int, int> notify_count;
 	HashMap<Callable, int> call_count;
 	int null_count = 0;
-
-	for (uint32_t i = 0; i < pages_used; i++) {
-		uint32_t offset = 0;
-		while (offset < page_bytes[i]) {
-			Page *page = pages[i];
-
-			//lock on each iteration, so a call can re-add itself to the message queue
-
-			Message *message = (Message *)&page->data[offset];
-
-			uint32_t advance = sizeof(Message);
-			if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-				advance += sizeof(Variant) * message->args;
-			}
-
-			Object *target = message->callable.get_object();
-
-			bool null_target = true;
-			switch (message->type & FLAG_MASK) {
-				case TYPE_CALL: {
-					if (target || (message->type & FLAG_NULL_IS_OK)) {
-						if (!call_count.has(message->callable)) {
-							call_count[message->callable] = 0;
+	uint32_t total_pages = 0;
+
+	auto count_chain = [&](const PageChain &p_chain) {
+		total_pages += p_chain.pages_used;
+		for (uint32_t i = 0; i < p_chain.pages_used; i++) {
+			uint32_t offset = 0;
+			while (offset < p_chain.page_bytes[i]) {
+				Message *message = (Message *)&p_chain.pages[i]->data[offset];
+				offset += _get_message_size(message);
+
+				Object *target = message->callable.get_object();
+
+				bool null_target = true;
+				switch (message->type & FLAG_MASK) {
+					case TYPE_CALL: {
+						if (target || (message->type & FLAG_NULL_IS_OK)) {
+							if (!call_count.has(message->callable)) {
+								call_count[message->callable] = 0;
+							}
+
+							call_count[message->callable]++;
+							null_target = false;
 						}
-
-						call_count[message->callable]++;
-						null_target = false;
-					}
-				} break;
-				case TYPE_NOTIFICATION: {
-					if (target) {
-						if (!notify_count.has(message->notification)) {
-							notify_count[message->notification] = 0;
+					} break;
+					case TYPE_NOTIFICATION: {
+						if (target) {
+							if (!notify_count.has(message->notification)) {
+								notify_count[message->notification] = 0;
+							}
+
+							notify_count[message->notification]++;
+							null_target = false;
 						}
-
-						notify_count[message->notification]++;
-						null_target = false;
-					}
-				} break;
-				case TYPE_SET: {
-					if (target) {
-						StringName t = message->callable.get_method();
-						if (!set_count.has(t)) {
-							set_count[t] = 0;
+					} break;
+					case TYPE_SET: {
+						if (target) {
+							StringName t = message->callable.get_method();
+							if (!set_count.has(t)) {
+								set_count[t] = 0;
+							}
+
+							set_count[t]++;
+							null_target = false;
 						}
+					} break;
+				}
+				if (null_target) {
+					// Object was deleted.
+					fprintf(stdout, "Object was deleted while awaiting a callback.\n");
 
-						set_count[t]++;
-						null_target = false;
-					}
-				} break;
-			}
-			if (null_target) {
-				// Object was deleted.
-				fprintf(stdout, "Object was deleted while awaiting a callback.\n");
-
-				null_count++;
-			}
-
-			offset += advance;
-
-			if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-				Variant *args = (Variant *)(message + 1);
-				for (int k = 0; k < message->args; k++) {
-					args[k].~Variant();
+					null_count++;
 				}
 			}
+		}
+	};
 
-			message->~Message();
+	LOCK_MUTEX;
+	count_chain(chain);
+	UNLOCK_MUTEX;
+
+	if (multi_producer) {
+		MutexLock lock(producers_mutex);
+		for (Producer *producer : producers) {
+			MutexLock producer_lock(producer->mutex);
+			count_chain(producer->chains[producer->active]);
 		}
 	}
 
-	fprintf(stdout, "TOTAL PAGES: %d (%d bytes).\n", pages_used, pages_used * PAGE_SIZE_BYTES);
+	fprintf(stdout, "TOTAL PAGES: %d (%d bytes).\n", total_pages, total_pages * PAGE_SIZE_BYTES);
 	fprintf(stdout, "NULL count: %d.\n", null_count);
 
 	for (const KeyValue<StringName, int> &E : set_count) {
@@ -435,8 +589,6 @@ void CallQueue::statistics() {
 	for (const KeyValue<int, int> &E : notify_count) {
 		fprintf(stdout, "NOTIFY %d: %d.\n", E.key, E.value);
 	}
-
-	UNLOCK_MUTEX;
 }
 
 bool CallQueue::is_flushing() const {
@@ -444,21 +596,71 @@ bool CallQueue::is_flushing() const {
 }
 
 bool CallQueue::has_messages() const {
-	if (pages_used == 0) {
-		return false;
+	if (chain.has_messages()) {
+		return true;
 	}
-	if (pages_used == 1 && page_bytes[0] == 0) {
-		return false;
+
+	if (multi_producer) {
+		MutexLock lock(producers_mutex);
+		for (Producer *producer : producers) {
+			MutexLock producer_lock(producer->mutex);
+			if (producer->chains[producer->active].has_messages()) {
+				return true;
+			}
+		}
 	}
 
-	return true;
+	return false;
 }
 
 int CallQueue::get_max_buffer_usage() const {
-	return pages.size() * PAGE_SIZE_BYTES;
+	uint32_t page_count = chain.pages.size();
+
+	if (multi_producer) {
+		MutexLock lock(producers_mutex);
+		for (Producer *producer : producers) {
+			MutexLock producer_lock(producer->mutex);
+			page_count += producer->chains[0].pages.size() + producer->chains[1].pages.size();
+		}
+	}
+
+	return page_count * PAGE_SIZE_BYTES;
 }
 
-CallQueue::CallQueue(Allocator *p_custom_allocator, uint32_t p_max_pages, const String &p_error_text) {
+CallQueue::Statistics CallQueue::get_statistics() {
+	Statistics statistics;
+
+	LOCK_MUTEX;
+	statistics.pushed_messages = chain.pushed_messages;
+	statistics.pushed_bytes = chain.pushed_bytes;
+	statistics.flushed_messages = flushed_messages;
+	UNLOCK_MUTEX;
+
+	if (multi_producer) {
+		MutexLock lock(producers_mutex);
+		statistics.pushed_messages += released_pushed_messages;
+		statistics.pushed_bytes += released_pushed_bytes;
+		for (Producer *producer : producers) {
+			MutexLock producer_lock(producer->mutex);
+			for (const PageChain &page_chain : producer->chains) {
+				statistics.pushed_messages += page_chain.pushed_messages;
+				statistics.pushed_bytes += page_chain.pushed_bytes;
+			}
+		}
+	}
+
+	return statistics;
+}
+
+void CallQueue::update_frame_statistics() {
+	const Statistics statistics = get_statistics();
+	frame_statistics.pushed_messages = statistics.pushed_messages - last_statistics.pushed_messages;
+	frame_statistics.pushed_bytes = statistics.pushed_bytes - last_statistics.pushed_bytes;
+	frame_statistics.flushed_messages = statistics.flushed_messages - last_statistics.flushed_messages;
+	last_statistics = statistics;
+}
+
+CallQueue::CallQueue(Allocator *p_custom_allocator, uint32_t p_max_pages, const String &p_error_text, bool p_multi_producer) {
 	if (p_custom_allocator) {
 		allocator = p_custom_allocator;
 		allocator_is_custom = true;
@@ -468,13 +670,19 @@ CallQueue::CallQueue(Allocator *p_custom_allocator, uint32_t p_max_pages, const
 	}
 	max_pages = p_max_pages;
 	error_text = p_error_text;
+	multi_producer = p_multi_producer;
+	queue_id = last_call_queue_id.increment();
 }
 
 CallQueue::~CallQueue() {
 	clear();
 	// Let go of pages.
-	for (uint32_t i = 0; i < pages.size(); i++) {
-		allocator->free(pages[i]);
+	for (uint32_t i = 0; i < chain.pages.size(); i++) {
+		allocator->free(chain.pages[i]);
+	}
+	for (Producer *producer : producers) {
+		// The thread may still hold the producer, in which case it's freed when the thread exits.
+		_release_producer(producer);
 	}
 	if (!allocator_is_custom) {
 		memdelete(allocator);
@@ -504,7 +712,8 @@ void MessageQueue::set_thread_singleton_override(CallQueue *p_thread_singleton)
 MessageQueue::MessageQueue() :
 		CallQueue(nullptr,
 				int(GLOBAL_DEF_RST(PropertyInfo(Variant::INT, "memory/limits/message_queue/max_size_mb", PROPERTY_HINT_RANGE, "1,512,1,or_greater"), 32)) * 1024 * 1024 / PAGE_SIZE_BYTES,
-				"Message queue out of memory. Try increasing 'memory/limits/message_queue/max_size_mb' in project settings.") {
+				"Message queue out of memory. Try increasing 'memory/limits/message_queue/max_size_mb' in project settings.",
+				GLOBAL_DEF_RST("threading/message_queue/multi_producer", false)) {
 	ERR_FAIL_COND_MSG(main_singleton != nullptr, "A MessageQueue singleton already exists.");
 	main_singleton = this;
 }
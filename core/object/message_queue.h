@@ -32,6 +32,7 @@
 
 #include "core/object/object_id.h"
 #include "core/os/mutex.h"
+#include "core/os/thread.h"
 #include "core/templates/local_vector.h"
 #include "core/templates/paged_allocator.h"
 #include "core/variant/variant.h"
@@ -54,6 +55,12 @@ public:
 	// Needs to lock because there can be multiple of these allocators in several threads.
 	typedef PagedAllocator<Page, true> Allocator;
 
+	struct Statistics {
+		uint64_t pushed_messages = 0;
+		uint64_t pushed_bytes = 0;
+		uint64_t flushed_messages = 0;
+	};
+
 private:
 	enum {
 		TYPE_CALL,
@@ -65,17 +72,63 @@ private:
 		FLAG_MASK = FLAG_NULL_IS_OK - 1,
 	};
 
+	struct PageChain {
+		LocalVector<Page *> pages;
+		LocalVector<uint32_t> page_bytes;
+		uint32_t pages_used = 0;
+		// Totals since creation, updated with the lock protecting the chain held.
+		uint64_t pushed_messages = 0;
+		uint64_t pushed_bytes = 0;
+
+		_FORCE_INLINE_ bool has_messages() const {
+			return pages_used > 1 || (pages_used == 1 && page_bytes[0] > 0);
+		}
+	};
+
+	// In multi-producer mode, every thread pushes into its own pair of chains.
+	// flush() swaps the active chain under the producer mutex and processes the
+	// other one without holding any lock, so producers only ever contend with
+	// that swap and never with each other or with the calls being flushed.
+	struct Producer {
+		BinaryMutex mutex;
+		Thread::ID thread_id = 0;
+		PageChain chains[2];
+		uint32_t active = 0;
+		// Referenced by the queue and by its thread. Once the thread exits, flush() drops the producer
+		// as soon as everything it pushed was processed.
+		SafeRefCount refcount;
+		SafeFlag thread_exited;
+	};
+
+	struct ProducerReleaser {
+		LocalVector<Producer *> producers;
+		~ProducerReleaser();
+	};
+
 	Mutex mutex;
 
 	Allocator *allocator = nullptr;
 	bool allocator_is_custom = false;
 
-	LocalVector<Page *> pages;
-	LocalVector<uint32_t> page_bytes;
+	PageChain chain;
 	uint32_t max_pages = 0;
-	uint32_t pages_used = 0;
 	bool flushing = false;
 
+	bool multi_producer = false;
+	uint64_t queue_id = 0;
+	mutable BinaryMutex producers_mutex;
+	LocalVector<Producer *> producers;
+	// Statistics of the producers which were dropped.
+	uint64_t released_pushed_messages = 0;
+	uint64_t released_pushed_bytes = 0;
+
+	// Last queue each thread pushed to in multi-producer mode, so the producer lookup usually skips producers_mutex.
+	static thread_local uint64_t cached_queue_id;
+	static thread_local Producer *cached_producer;
+	static thread_local ProducerReleaser producer_releaser;
+
+	uint64_t flushed_messages = 0;
+
 #ifdef DEV_ENABLED
 	bool is_current_thread_override = false;
 #endif
@@ -89,20 +142,36 @@ private:
 		};
 	};
 
-	_FORCE_INLINE_ void _ensure_first_page() {
-		if (unlikely(pages.is_empty())) {
-			pages.push_back(allocator->alloc());
-			page_bytes.push_back(0);
-			pages_used = 1;
+	_FORCE_INLINE_ void _ensure_first_page(PageChain &p_chain) {
+		if (unlikely(p_chain.pages.is_empty())) {
+			p_chain.pages.push_back(allocator->alloc());
+			p_chain.page_bytes.push_back(0);
+			p_chain.pages_used = 1;
 		}
 	}
 
-	void _add_page();
+	void _add_page(PageChain &p_chain);
+	uint8_t *_alloc_message(PageChain &p_chain, uint32_t p_room_needed);
+
+	Producer *_get_producer();
+	void _release_producer(Producer *p_producer);
+	PageChain &_lock_chain(Producer *&r_producer);
+	void _unlock_chain(Producer *p_producer);
+
+	static uint32_t _get_message_size(const Message *p_message);
+	void _process_message(Message *p_message);
+	static void _destroy_message(Message *p_message);
+	void _destroy_messages(PageChain &p_chain);
+	uint32_t _flush_chain(PageChain &p_chain);
+	Error _flush_multi_producer();
 
 	void _call_function(const Callable &p_callable, const Variant *p_args, int p_argcount, bool p_show_error);
 
 	String error_text;
 
+	Statistics frame_statistics;
+	Statistics last_statistics;
+
 public:
 	Error push_callp(ObjectID p_id, const StringName &p_method, const Variant **p_args, int p_argcount, bool p_show_error = false);
 	template <typename... VarArgs>
@@ -143,7 +212,15 @@ public:
 	bool is_flushing() const;
 	int get_max_buffer_usage() const;
 
-	CallQueue(Allocator *p_custom_allocator = nullptr, uint32_t p_max_pages = 8192, const String &p_error_text = String());
+	bool is_multi_producer() const { return multi_producer; }
+
+	// Totals since the queue was created.
+	Statistics get_statistics();
+	// Takes the difference with the totals of the previous call. Main::iteration() calls it once per frame on the main queue.
+	void update_frame_statistics();
+	const Statistics &get_frame_statistics() const { return frame_statistics; }
+
+	CallQueue(Allocator *p_custom_allocator = nullptr, uint32_t p_max_pages = 8192, const String &p_error_text = String(), bool p_multi_producer = false);
 	virtual ~CallQueue();
 };
 
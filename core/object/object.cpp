@@ -217,6 +217,14 @@ void Object::_postinitialize() {
 }
 
 void Object::set(const StringName &p_name, const Variant &p_value, bool *r_valid) {
+	_set_cached(p_name, p_value, nullptr, r_valid);
+}
+
+void Object::set(const StringName &p_name, const Variant &p_value, PropertyCache &r_cache, bool *r_valid) {
+	_set_cached(p_name, p_value, &r_cache, r_valid);
+}
+
+void Object::_set_cached(const StringName &p_name, const Variant &p_value, PropertyCache *r_cache, bool *r_valid) {
 #ifdef TOOLS_ENABLED
 
 	_edited = true;
@@ -242,7 +250,7 @@ void Object::set(const StringName &p_name, const Variant &p_value, bool *r_valid
 
 	// Try built-in setter.
 	{
-		if (ClassDB::set_property(this, p_name, p_value, r_valid)) {
+		if (r_cache ? ClassDB::set_property(this, p_name, p_value, *r_cache, r_valid) : ClassDB::set_property(this, p_name, p_value, r_valid)) {
 			return;
 		}
 	}
@@ -300,6 +308,14 @@ void Object::set(const StringName &p_name, const Variant &p_value, bool *r_valid
 }
 
 Variant Object::get(const StringName &p_name, bool *r_valid) const {
+	return _get_cached(p_name, nullptr, r_valid);
+}
+
+Variant Object::get(const StringName &p_name, PropertyCache &r_cache, bool *r_valid) const {
+	return _get_cached(p_name, &r_cache, r_valid);
+}
+
+Variant Object::_get_cached(const StringName &p_name, PropertyCache *r_cache, bool *r_valid) const {
 	Variant ret;
 
 	if (script_instance) {
@@ -321,7 +337,7 @@ Variant Object::get(const StringName &p_name, bool *r_valid) const {
 
 	// Try built-in getter.
 	{
-		if (ClassDB::get_property(const_cast<Object *>(this), p_name, ret)) {
+		if (r_cache ? ClassDB::get_property(const_cast<Object *>(this), p_name, ret, *r_cache) : ClassDB::get_property(const_cast<Object *>(this), p_name, ret)) {
 			if (r_valid) {
 				*r_valid = true;
 			}
@@ -1161,19 +1177,59 @@ Error Object::_emit_signal(const Variant **p_args, int p_argcount, Callable::Cal
 	return emit_signalp(signal, args, argc);
 }
 
+struct Object::SlotSnapshot {
+	SafeRefCount refcount;
+	uint32_t count = 0;
+	Callable *callables = nullptr;
+	uint32_t *flags = nullptr;
+
+	static SlotSnapshot *create(const HashMap<Callable, SignalData::Slot> &p_slot_map) {
+		const uint32_t count = p_slot_map.size();
+		static_assert(sizeof(SlotSnapshot) % alignof(Callable) == 0 && sizeof(Callable) % alignof(uint32_t) == 0);
+		// Single allocation: the header, then the callables, then the flags.
+		uint8_t *mem = (uint8_t *)memalloc(sizeof(SlotSnapshot) + (sizeof(Callable) + sizeof(uint32_t)) * count);
+		SlotSnapshot *snapshot = memnew_placement(mem, SlotSnapshot);
+		snapshot->refcount.init();
+		snapshot->count = count;
+		snapshot->callables = (Callable *)(mem + sizeof(SlotSnapshot));
+		snapshot->flags = (uint32_t *)(mem + sizeof(SlotSnapshot) + sizeof(Callable) * count);
+
+		uint32_t i = 0;
+		for (const KeyValue<Callable, SignalData::Slot> &slot_kv : p_slot_map) {
+			memnew_placement(&snapshot->callables[i], Callable(slot_kv.value.conn.callable));
+			snapshot->flags[i] = slot_kv.value.conn.flags;
+			i++;
+		}
+		return snapshot;
+	}
+
+	void unref() {
+		if (refcount.unref()) {
+			for (uint32_t i = 0; i < count; i++) {
+				callables[i].~Callable();
+			}
+			this->~SlotSnapshot();
+			memfree(this);
+		}
+	}
+};
+
+void Object::SlotSnapshotRef::release() {
+	if (snapshot) {
+		snapshot->unref();
+		snapshot = nullptr;
+	}
+}
+
 Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int p_argcount) {
 	if (_block_signals) {
 		return ERR_CANT_ACQUIRE_RESOURCE; //no emit, signals blocked
 	}
 
-	constexpr int MAX_SLOTS_ON_STACK = 5;
-	// Don't default initialize the Callable objects on the stack, just reserve the space - we'll memnew_placement() them later.
-	alignas(Callable) uint8_t slot_callable_stack[sizeof(Callable) * MAX_SLOTS_ON_STACK];
-	uint32_t slot_flags_stack[MAX_SLOTS_ON_STACK];
-
-	Callable *slot_callables = (Callable *)slot_callable_stack;
-	uint32_t *slot_flags = slot_flags_stack;
-	uint32_t slot_count = 0;
+	// The connections are not copied on every emission. Instead, all emissions share a snapshot
+	// that is only rebuilt after the connections changed. Holding a reference to it ensures that
+	// disconnecting the signal or even deleting the object will not affect the signal calling.
+	SlotSnapshot *snapshot = nullptr;
 
 	{
 		ObjectSignalLock signal_lock(this);
@@ -1189,22 +1245,21 @@ Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int
 			return ERR_UNAVAILABLE;
 		}
 
-		if (s->slot_map.size() > MAX_SLOTS_ON_STACK) {
-			slot_callables = (Callable *)memalloc(sizeof(Callable) * s->slot_map.size());
-			slot_flags = (uint32_t *)memalloc(sizeof(uint32_t) * s->slot_map.size());
+		if (s->slot_map.is_empty()) {
+			return OK;
 		}
 
-		// Ensure that disconnecting the signal or even deleting the object
-		// will not affect the signal calling.
-		for (const KeyValue<Callable, SignalData::Slot> &slot_kv : s->slot_map) {
-			memnew_placement(&slot_callables[slot_count], Callable(slot_kv.value.conn.callable));
-			slot_flags[slot_count] = slot_kv.value.conn.flags;
-			++slot_count;
+		if (!s->slots.snapshot) {
+			s->slots.snapshot = SlotSnapshot::create(s->slot_map);
 		}
-
-		DEV_ASSERT(slot_count == s->slot_map.size());
+		snapshot = s->slots.snapshot;
+		snapshot->refcount.ref();
 	}
 
+	const uint32_t slot_count = snapshot->count;
+	const Callable *slot_callables = snapshot->callables;
+	const uint32_t *slot_flags = snapshot->flags;
+
 	// Disconnect all one-shot connections before emitting to prevent recursion.
 	for (uint32_t i = 0; i < slot_count; ++i) {
 		bool disconnect = slot_flags[i] & CONNECT_ONE_SHOT;
@@ -1230,8 +1285,11 @@ Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int
 
 	Error err = OK;
 
-	Vector<const Variant *> append_source_mem;
-	Variant source = this;
+	constexpr int MAX_ARGS_ON_STACK = 16;
+	const Variant *append_source_stack[MAX_ARGS_ON_STACK + 1];
+	LocalVector<const Variant *> append_source_heap;
+	// Only converted when a connection asks for it, as it references the object if it's ref-counted.
+	Variant source;
 
 	for (uint32_t i = 0; i < slot_count; ++i) {
 		const Callable &callable = slot_callables[i];
@@ -1250,8 +1308,14 @@ Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int
 			// Implemented by inserting before the first to-be-unbinded arg.
 			int source_index = p_argcount - callable.get_unbound_arguments_count();
 			if (source_index >= 0) {
-				append_source_mem.resize(p_argcount + 1);
-				const Variant **args_mem = append_source_mem.ptrw();
+				const Variant **args_mem = append_source_stack;
+				if (unlikely(p_argcount > MAX_ARGS_ON_STACK)) {
+					append_source_heap.resize(p_argcount + 1);
+					args_mem = append_source_heap.ptr();
+				}
+				if (source.get_type() == Variant::NIL) {
+					source = this;
+				}
 
 				for (int j = 0; j < source_index; j++) {
 					args_mem[j] = p_args[j];
@@ -1300,14 +1364,7 @@ Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int
 		}
 	}
 
-	for (uint32_t i = 0; i < slot_count; ++i) {
-		slot_callables[i].~Callable();
-	}
-
-	if (slot_callables != (Callable *)slot_callable_stack) {
-		memfree(slot_callables);
-		memfree(slot_flags);
-	}
+	snapshot->unref();
 
 	if (pending_unref) {
 		// We have to do the same Ref<T> would do. We can't just use Ref<T>
@@ -1564,6 +1621,7 @@ Error Object::connect(const StringName &p_signal, const Callable &p_callable, ui
 
 	//use callable version as key, so binds can be ignored
 	s->slot_map[*p_callable.get_base_comparator()] = slot;
+	s->slots.release();
 
 	return OK;
 }
@@ -1642,6 +1700,7 @@ bool Object::_disconnect(const StringName &p_signal, const Callable &p_callable,
 	}
 
 	s->slot_map.erase(*p_callable.get_base_comparator());
+	s->slots.release();
 
 	if (s->slot_map.is_empty() && ClassDB::has_signal(get_class_name(), p_signal)) {
 		//not user signal, delete
@@ -358,6 +358,8 @@ public:
 		CONNECT_INHERITED = 32, // Used in editor builds.
 	};
 
+	struct PropertyCache; // Defined in class_db.h, see ClassDB::PropertyCache.
+
 	// Store on each object a bitfield to quickly test whether it is derived from some "key" classes
 	// that are commonly tested in performance sensitive code.
 	// Ensure unsigned to bitpack.
@@ -407,6 +409,25 @@ private:
 	ObjectGDExtension *_extension = nullptr;
 	GDExtensionClassInstancePtr _extension_instance = nullptr;
 
+	// Immutable copy of the connections of a signal, shared by every emission
+	// until the connections change. Defined in object.cpp.
+	struct SlotSnapshot;
+
+	// Owns a reference to a SlotSnapshot. Copies start empty, since the snapshot is only a cache.
+	struct SlotSnapshotRef {
+		SlotSnapshot *snapshot = nullptr;
+
+		void release();
+
+		SlotSnapshotRef() {}
+		SlotSnapshotRef(const SlotSnapshotRef &p_other) {}
+		SlotSnapshotRef &operator=(const SlotSnapshotRef &p_other) {
+			release();
+			return *this;
+		}
+		~SlotSnapshotRef() { release(); }
+	};
+
 	struct SignalData {
 		struct Slot {
 			int reference_count = 0;
@@ -416,6 +437,8 @@ private:
 
 		MethodInfo user;
 		HashMap<Callable, Slot> slot_map;
+		// Built by emit_signalp() on demand, must be released whenever slot_map changes.
+		SlotSnapshotRef slots;
 		bool removable = false;
 	};
 	mutable Mutex *signal_mutex = nullptr;
@@ -476,6 +499,9 @@ private:
 	TypedArray<Dictionary> _get_signal_list() const;
 	TypedArray<Dictionary> _get_signal_connection_list(const StringName &p_signal) const;
 	TypedArray<Dictionary> _get_incoming_connections() const;
+	// Shared by set() and get(), r_cache is null when the caller doesn't keep one.
+	void _set_cached(const StringName &p_name, const Variant &p_value, PropertyCache *r_cache, bool *r_valid);
+	Variant _get_cached(const StringName &p_name, PropertyCache *r_cache, bool *r_valid) const;
 	void _set_bind(const StringName &p_set, const Variant &p_value);
 	Variant _get_bind(const StringName &p_name) const;
 	void _set_indexed_bind(const NodePath &p_name, const Variant &p_value);
@@ -683,6 +709,9 @@ public:
 
 	void set(const StringName &p_name, const Variant &p_value, bool *r_valid = nullptr);
 	Variant get(const StringName &p_name, bool *r_valid = nullptr) const;
+	// Same as above, but built-in properties are looked up through r_cache, which callers keep for each property they access repeatedly.
+	void set(const StringName &p_name, const Variant &p_value, PropertyCache &r_cache, bool *r_valid = nullptr);
+	Variant get(const StringName &p_name, PropertyCache &r_cache, bool *r_valid = nullptr) const;
 	void set_indexed(const Vector<StringName> &p_names, const Variant &p_value, bool *r_valid = nullptr);
 	Variant get_indexed(const Vector<StringName> &p_names, bool *r_valid = nullptr) const;
 
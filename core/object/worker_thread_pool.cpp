@@ -36,6 +36,7 @@
 #include "core/os/os.h"
 #include "core/os/safe_binary_mutex.h"
 #include "core/os/thread_safe.h"
+#include "core/profiling/profiling.h"
 
 WorkerThreadPool::Task *const WorkerThreadPool::ThreadData::YIELDING = (Task *)1;
 
@@ -137,6 +138,52 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 
 		task_mutex.lock();
 		task_allocator.free(p_task);
+	} else if (p_task->graph) {
+		TaskGraph *graph = p_task->graph;
+		TaskGraph::Node &node = graph->nodes[p_task->graph_node];
+
+		node.start_usec = OS::get_singleton()->get_ticks_usec();
+		{
+			GodotProfileZone("WorkerThreadPool::TaskGraph node");
+			if (node.native_func) {
+				node.native_func(node.native_func_userdata);
+			} else if (node.template_userdata) {
+				node.template_userdata->callback(); // Owned by the graph, since it can be run again.
+			} else {
+				node.callable.call();
+			}
+		}
+		node.end_usec = OS::get_singleton()->get_ticks_usec();
+
+		{
+			MutexLock lock(task_mutex);
+
+			// Post the successors that were only waiting for this node.
+			// Not on the stack, the number of successors is up to the caller.
+			LocalVector<Task *> ready_tasks;
+			for (TaskGraph::NodeID successor : node.successors) {
+				graph->pending_dependencies[successor]--;
+				if (graph->pending_dependencies[successor] == 0) {
+					ready_tasks.push_back(_alloc_graph_task(graph, successor));
+				}
+			}
+
+			// Like for groups, graph tasks get rid of themselves.
+			task_allocator.free(p_task);
+
+			if (!ready_tasks.is_empty()) {
+				_post_tasks(ready_tasks.ptr(), ready_tasks.size(), graph->high_priority, lock, false);
+			}
+
+			graph->pending_nodes--;
+			if (graph->pending_nodes == 0) {
+				// The graph may be freed by its owner as soon as this is known, so it must not be touched anymore.
+				graph->running = false;
+				_mark_task_completed(&graph->completion);
+			}
+		}
+
+		task_mutex.lock();
 	} else {
 		if (p_task->native_func) {
 			p_task->native_func(p_task->native_func_userdata);
@@ -148,18 +195,7 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 		}
 
 		task_mutex.lock();
-		p_task->completed = true;
-		p_task->pool_thread_index = -1;
-		if (p_task->waiting_user) {
-			p_task->done_semaphore.post(p_task->waiting_user);
-		}
-		// Let awaiters know.
-		for (uint32_t i = 0; i < threads.size(); i++) {
-			if (threads[i].awaited_task == p_task) {
-				threads[i].cond_var.notify_one();
-				threads[i].signaled = true;
-			}
-		}
+		_mark_task_completed(p_task);
 	}
 
 #ifdef THREADS_ENABLED
@@ -189,7 +225,11 @@ void WorkerThreadPool::_thread_function(void *p_user) {
 
 	while (true) {
 		Task *task_to_process = nullptr;
-		{
+		if (thread_data->pool->work_stealing) {
+			// Fast path: own deque first, then other threads' ones, all without locking.
+			task_to_process = thread_data->pool->_pop_or_steal_local_task(thread_data);
+		}
+		if (!task_to_process) {
 			// Create the lock outside the inner loop so it isn't needlessly unlocked and relocked
 			//  when no task was found to process, and the loop is re-entered.
 			MutexLock lock(thread_data->pool->task_mutex);
@@ -202,17 +242,24 @@ void WorkerThreadPool::_thread_function(void *p_user) {
 
 				thread_data->signaled = false;
 
-				if (!thread_data->pool->task_queue.first()) {
-					// There wasn't a task available yet.
-					// Let's wait for the next notification, then recheck.
-					thread_data->cond_var.wait(lock);
-					continue;
+				if (thread_data->pool->task_queue.first()) {
+					// Got a task to process! Remove it from the queue, then break into the task handling section.
+					task_to_process = thread_data->pool->task_queue.first()->self();
+					thread_data->pool->task_queue.remove(thread_data->pool->task_queue.first());
+					break;
 				}
 
-				// Got a task to process! Remove it from the queue, then break into the task handling section.
-				task_to_process = thread_data->pool->task_queue.first()->self();
-				thread_data->pool->task_queue.remove(thread_data->pool->task_queue.first());
-				break;
+				if (thread_data->pool->work_stealing) {
+					// Local tasks are only pushed with the lock held, so checking again here means no notification can be missed.
+					task_to_process = thread_data->pool->_pop_or_steal_local_task(thread_data);
+					if (task_to_process) {
+						break;
+					}
+				}
+
+				// There wasn't a task available yet.
+				// Let's wait for the next notification, then recheck.
+				thread_data->cond_var.wait(lock);
 			}
 		}
 
@@ -246,9 +293,18 @@ void WorkerThreadPool::_post_tasks(Task **p_tasks, uint32_t p_count, bool p_high
 
 	ThreadData *caller_pool_thread = thread_ids.has(Thread::get_caller_id()) ? &threads[thread_ids[Thread::get_caller_id()]] : nullptr;
 
+	// In work-stealing mode, high-priority tasks posted from a pool thread stay local to it, where they
+	// can be popped without locking. Pump tasks always go through the global queue, since they need special handling.
+	bool use_local_queue = work_stealing && caller_pool_thread && p_high_priority && !p_pump_task;
+
 	for (uint32_t i = 0; i < p_count; i++) {
 		p_tasks[i]->low_priority = !p_high_priority;
-		if (p_high_priority || low_priority_threads_used < max_low_priority_threads) {
+		if (use_local_queue) {
+			if (!caller_pool_thread->local_queue.push(p_tasks[i])) {
+				task_queue.add_last(&p_tasks[i]->task_elem); // Full; spill over to the global queue.
+			}
+			to_process++;
+		} else if (p_high_priority || low_priority_threads_used < max_low_priority_threads) {
 			task_queue.add_last(&p_tasks[i]->task_elem);
 			if (!p_high_priority) {
 				low_priority_threads_used++;
@@ -328,6 +384,21 @@ void WorkerThreadPool::_notify_threads(const ThreadData *p_current_thread_data,
 	}
 }
 
+void WorkerThreadPool::_mark_task_completed(Task *p_task) {
+	p_task->completed = true;
+	p_task->pool_thread_index = -1;
+	if (p_task->waiting_user) {
+		p_task->done_semaphore.post(p_task->waiting_user);
+	}
+	// Let awaiters know.
+	for (uint32_t i = 0; i < threads.size(); i++) {
+		if (threads[i].awaited_task == p_task) {
+			threads[i].cond_var.notify_one();
+			threads[i].signaled = true;
+		}
+	}
+}
+
 bool WorkerThreadPool::_try_promote_low_priority_task() {
 	if (low_priority_task_queue.first()) {
 		Task *low_prio_task = low_priority_task_queue.first()->self();
@@ -340,6 +411,35 @@ bool WorkerThreadPool::_try_promote_low_priority_task() {
 	}
 }
 
+WorkerThreadPool::Task *WorkerThreadPool::_pop_or_steal_local_task(ThreadData *p_thread_data) {
+	Task *task = nullptr;
+	if (p_thread_data->local_queue.pop(task)) {
+		return task;
+	}
+
+	// Threads storage is reserved up front and never relocated, so it's fine to peek at it without locking.
+	uint32_t thread_count = threads.size();
+	for (uint32_t i = 1; i < thread_count; i++) {
+		ThreadData &victim = threads[(p_thread_data->index + i) % thread_count];
+		if (victim.local_queue.steal(task)) {
+			return task;
+		}
+	}
+	return nullptr;
+}
+
+bool WorkerThreadPool::_has_local_tasks() const {
+	if (!work_stealing) {
+		return false;
+	}
+	for (uint32_t i = 0; i < threads.size(); i++) {
+		if (!threads[i].local_queue.is_empty()) {
+			return true;
+		}
+	}
+	return false;
+}
+
 WorkerThreadPool::TaskID WorkerThreadPool::add_native_task(void (*p_func)(void *), void *p_userdata, bool p_high_priority, const String &p_description) {
 	return _add_task(Callable(), p_func, p_userdata, nullptr, p_high_priority, p_description);
 }
@@ -518,7 +618,7 @@ void WorkerThreadPool::_wait_collaboratively(ThreadData *p_caller_pool_thread, T
 				if (was_signaled) {
 					// This thread was awaken for some additional reason, but it's about to exit.
 					// Let's find out what may be pending and forward the requests.
-					uint32_t to_process = task_queue.first() ? 1 : 0;
+					uint32_t to_process = (task_queue.first() || _has_local_tasks()) ? 1 : 0;
 					uint32_t to_promote = p_caller_pool_thread->current_task->low_priority && low_priority_task_queue.first() ? 1 : 0;
 					if (to_process || to_promote) {
 						// This thread must be left alone since it won't loop again.
@@ -536,7 +636,13 @@ void WorkerThreadPool::_wait_collaboratively(ThreadData *p_caller_pool_thread, T
 				}
 			}
 
-			if (p_caller_pool_thread->pool->task_queue.first()) {
+			if (work_stealing) {
+				// Tasks this thread posted itself are the most likely ones to be awaited, so try those first.
+				// Local tasks are never pump tasks, so there's no need to check for that.
+				task_to_process = _pop_or_steal_local_task(p_caller_pool_thread);
+			}
+
+			if (!task_to_process && p_caller_pool_thread->pool->task_queue.first()) {
 				task_to_process = task_queue.first()->self();
 				if ((p_task == ThreadData::YIELDING || p_caller_pool_thread->has_pump_task == true) && task_to_process->is_pump_task) {
 					task_to_process = nullptr;
@@ -589,7 +695,7 @@ bool WorkerThreadPool::_handle_runlevel(ThreadData *p_thread_data, MutexLock<Bin
 		} break;
 		case RUNLEVEL_PRE_EXIT_LANGUAGES: {
 			if (!p_thread_data->pre_exited_languages) {
-				if (!task_queue.first() && !low_priority_task_queue.first()) {
+				if (!task_queue.first() && !low_priority_task_queue.first() && !_has_local_tasks()) {
 					p_thread_data->pre_exited_languages = true;
 					runlevel_data.pre_exit_languages.num_idle_threads++;
 					control_cond_var.notify_all();
@@ -759,6 +865,81 @@ void WorkerThreadPool::wait_for_group_task_completion(GroupID p_group) {
 #endif
 }
 
+WorkerThreadPool::Task *WorkerThreadPool::_alloc_graph_task(TaskGraph *p_graph, uint32_t p_node) {
+	Task *task = task_allocator.alloc();
+	task->graph = p_graph;
+	task->graph_node = p_node;
+	task->description = p_graph->nodes[p_node].description;
+	// No task ID is used.
+	return task;
+}
+
+void WorkerThreadPool::_submit_task_graph(TaskGraph *p_graph, bool p_high_priority) {
+	uint32_t node_count = p_graph->nodes.size();
+
+	MutexLock<BinaryMutex> lock(task_mutex);
+
+	ERR_FAIL_COND_MSG(p_graph->running, "Task graph was already submitted and hasn't completed yet.");
+
+	p_graph->completion.completed = false;
+	p_graph->high_priority = p_high_priority;
+
+	if (node_count == 0) {
+		_mark_task_completed(&p_graph->completion);
+		return;
+	}
+
+	p_graph->running = true;
+	p_graph->pending_nodes = node_count;
+	p_graph->pending_dependencies.resize(node_count);
+
+	// Not on the stack, graphs can be arbitrarily large.
+	LocalVector<Task *> root_tasks;
+	for (uint32_t i = 0; i < node_count; i++) {
+		p_graph->pending_dependencies[i] = p_graph->nodes[i].dependency_count;
+		if (p_graph->nodes[i].dependency_count == 0) {
+			root_tasks.push_back(_alloc_graph_task(p_graph, i));
+		}
+	}
+	DEV_ASSERT(!root_tasks.is_empty()); // Cycles are rejected when adding dependencies.
+
+	_post_tasks(root_tasks.ptr(), root_tasks.size(), p_high_priority, lock, false);
+}
+
+void WorkerThreadPool::_wait_for_task_graph(TaskGraph *p_graph) {
+	task_mutex.lock();
+	Task *task = &p_graph->completion;
+
+	if (task->completed) {
+		task_mutex.unlock();
+		return;
+	}
+
+	ThreadData *caller_pool_thread = thread_ids.has(Thread::get_caller_id()) ? &threads[thread_ids[Thread::get_caller_id()]] : nullptr;
+	if (caller_pool_thread) {
+		// Help running the graph (or anything else) meanwhile.
+		task->waiting_pool++;
+		task_mutex.unlock();
+		_wait_collaboratively(caller_pool_thread, task);
+		task_mutex.lock();
+		task->waiting_pool--;
+	} else {
+		task->waiting_user++;
+		task_mutex.unlock();
+		if (this == singleton) {
+			_unlock_unlockable_mutexes();
+		}
+		task->done_semaphore.wait();
+		if (this == singleton) {
+			_lock_unlockable_mutexes();
+		}
+		task_mutex.lock();
+		task->waiting_user--;
+	}
+
+	task_mutex.unlock();
+}
+
 int WorkerThreadPool::get_thread_index() const {
 	Thread::ID tid = Thread::get_caller_id();
 	return thread_ids.has(tid) ? thread_ids[tid] : -1;
@@ -808,10 +989,11 @@ void WorkerThreadPool::thread_exit_unlock_allowance_zone(uint32_t p_zone_id) {
 }
 #endif
 
-void WorkerThreadPool::init(int p_thread_count, float p_low_priority_task_ratio) {
+void WorkerThreadPool::init(int p_thread_count, float p_low_priority_task_ratio, bool p_work_stealing) {
 	ERR_FAIL_COND(threads.size() > 0);
 
 	runlevel = RUNLEVEL_NORMAL;
+	work_stealing = p_work_stealing;
 
 	if (p_thread_count < 0) {
 		p_thread_count = OS::get_singleton()->get_default_thread_pool_size();
@@ -819,7 +1001,7 @@ void WorkerThreadPool::init(int p_thread_count, float p_low_priority_task_ratio)
 
 	max_low_priority_threads = CLAMP(p_thread_count * p_low_priority_task_ratio, 1, p_thread_count - 1);
 
-	print_verbose(vformat("WorkerThreadPool: %d threads, %d max low-priority.", p_thread_count, max_low_priority_threads));
+	print_verbose(vformat("WorkerThreadPool: %d threads, %d max low-priority%s.", p_thread_count, max_low_priority_threads, work_stealing ? ", work-stealing" : ""));
 
 #ifdef THREADS_ENABLED
 	// Reserve 5 threads in case we need separate threads for 1) 2D physics 2) 3D physics 3) rendering 4) GPU texture compression, 5) all other tasks.
@@ -899,6 +1081,113 @@ void WorkerThreadPool::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_caller_group_id"), &WorkerThreadPool::get_caller_group_id);
 }
 
+WorkerThreadPool::TaskGraph::NodeID WorkerThreadPool::TaskGraph::_add_node(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, const String &p_description) {
+	if (unlikely(running)) {
+		if (p_template_userdata) {
+			memdelete(p_template_userdata);
+		}
+		ERR_FAIL_V_MSG(UINT32_MAX, "Can't add nodes to a task graph while it's running.");
+	}
+
+	Node node;
+	node.callable = p_callable;
+	node.native_func = p_func;
+	node.native_func_userdata = p_userdata;
+	node.template_userdata = p_template_userdata;
+	node.description = p_description;
+	nodes.push_back(node);
+	return nodes.size() - 1;
+}
+
+WorkerThreadPool::TaskGraph::NodeID WorkerThreadPool::TaskGraph::add_native_node(void (*p_func)(void *), void *p_userdata, const String &p_description) {
+	return _add_node(Callable(), p_func, p_userdata, nullptr, p_description);
+}
+
+WorkerThreadPool::TaskGraph::NodeID WorkerThreadPool::TaskGraph::add_node(const Callable &p_action, const String &p_description) {
+	return _add_node(p_action, nullptr, nullptr, nullptr, p_description);
+}
+
+void WorkerThreadPool::TaskGraph::depends_on(NodeID p_node, NodeID p_dependency) {
+	ERR_FAIL_COND_MSG(running, "Can't add dependencies to a task graph while it's running.");
+	ERR_FAIL_UNSIGNED_INDEX(p_node, nodes.size());
+	ERR_FAIL_UNSIGNED_INDEX(p_dependency, nodes.size());
+	ERR_FAIL_COND_MSG(p_node == p_dependency, "A task graph node can't depend on itself.");
+
+	if (nodes[p_dependency].successors.has(p_node)) {
+		return; // Already there.
+	}
+
+	// Reject cycles, i.e., the dependency being reachable from the node.
+	LocalVector<NodeID> stack;
+	LocalVector<bool> visited;
+	visited.resize_initialized(nodes.size());
+	stack.push_back(p_node);
+	while (!stack.is_empty()) {
+		NodeID current = stack[stack.size() - 1];
+		stack.remove_at(stack.size() - 1);
+		ERR_FAIL_COND_MSG(current == p_dependency, "Adding this dependency would create a cycle in the task graph.");
+		for (NodeID successor : nodes[current].successors) {
+			if (!visited[successor]) {
+				visited[successor] = true;
+				stack.push_back(successor);
+			}
+		}
+	}
+
+	nodes[p_dependency].successors.push_back(p_node);
+	nodes[p_node].dependency_count++;
+}
+
+void WorkerThreadPool::TaskGraph::submit(bool p_high_priority) {
+	pool->_submit_task_graph(this, p_high_priority);
+}
+
+bool WorkerThreadPool::TaskGraph::is_completed() const {
+	MutexLock task_lock(pool->task_mutex);
+	return completion.completed;
+}
+
+void WorkerThreadPool::TaskGraph::wait() {
+	pool->_wait_for_task_graph(this);
+}
+
+uint64_t WorkerThreadPool::TaskGraph::get_node_start_usec(NodeID p_node) const {
+	ERR_FAIL_UNSIGNED_INDEX_V(p_node, nodes.size(), 0);
+	return nodes[p_node].start_usec;
+}
+
+uint64_t WorkerThreadPool::TaskGraph::get_node_time_usec(NodeID p_node) const {
+	ERR_FAIL_UNSIGNED_INDEX_V(p_node, nodes.size(), 0);
+	return nodes[p_node].end_usec - nodes[p_node].start_usec;
+}
+
+const String &WorkerThreadPool::TaskGraph::get_node_description(NodeID p_node) const {
+	static const String empty;
+	ERR_FAIL_UNSIGNED_INDEX_V(p_node, nodes.size(), empty);
+	return nodes[p_node].description;
+}
+
+void WorkerThreadPool::TaskGraph::clear() {
+	ERR_FAIL_COND_MSG(running, "Can't clear a task graph while it's running.");
+	for (Node &node : nodes) {
+		if (node.template_userdata) {
+			memdelete(node.template_userdata);
+		}
+	}
+	nodes.clear();
+	pending_dependencies.clear();
+}
+
+WorkerThreadPool::TaskGraph::TaskGraph(WorkerThreadPool *p_pool) {
+	pool = p_pool ? p_pool : WorkerThreadPool::get_singleton();
+	completion.completed = true; // Nothing to wait for until submitted.
+}
+
+WorkerThreadPool::TaskGraph::~TaskGraph() {
+	wait();
+	clear();
+}
+
 WorkerThreadPool *WorkerThreadPool::get_named_pool(const StringName &p_name) {
 	WorkerThreadPool **pool_ptr = named_pools.getptr(p_name);
 	if (pool_ptr) {
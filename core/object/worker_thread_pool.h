@@ -39,6 +39,7 @@
 #include "core/templates/paged_allocator.h"
 #include "core/templates/safe_refcount.h"
 #include "core/templates/self_list.h"
+#include "core/templates/work_stealing_deque.h"
 #include "core/variant/callable.h"
 
 class WorkerThreadPool : public Object {
@@ -51,6 +52,8 @@ public:
 	typedef int64_t TaskID;
 	typedef int64_t GroupID;
 
+	class TaskGraph;
+
 private:
 	struct Task;
 
@@ -89,6 +92,8 @@ private:
 		bool low_priority = false;
 		BaseTemplateUserdata *template_userdata = nullptr;
 		int pool_thread_index = -1;
+		TaskGraph *graph = nullptr;
+		uint32_t graph_node = 0;
 
 		void free_template_userdata();
 		Task() :
@@ -100,6 +105,7 @@ private:
 
 	static const uint32_t TASKS_PAGE_SIZE = 1024;
 	static const uint32_t GROUPS_PAGE_SIZE = 256;
+	static const uint32_t LOCAL_QUEUE_SIZE = 256;
 
 	PagedAllocator<Task, false, TASKS_PAGE_SIZE> task_allocator;
 	PagedAllocator<Group, false, GROUPS_PAGE_SIZE> group_allocator;
@@ -123,6 +129,8 @@ private:
 		Task *awaited_task = nullptr; // Null if not awaiting the condition variable, or special value (YIELDING).
 		ConditionVariable cond_var;
 		WorkerThreadPool *pool = nullptr;
+		// Only used in work-stealing mode. Holds high-priority tasks posted by this thread.
+		WorkStealingDeque<Task *, LOCAL_QUEUE_SIZE> local_queue;
 
 		ThreadData() :
 				signaled(false),
@@ -172,6 +180,10 @@ private:
 	uint64_t last_task = 1;
 	int pump_task_count = 0;
 
+	// In work-stealing mode, high-priority tasks posted from pool threads go to per-thread deques
+	// instead of the global queue, which is then only used by external submitters.
+	bool work_stealing = false;
+
 	static HashMap<StringName, WorkerThreadPool *> named_pools;
 
 	static void _thread_function(void *p_user);
@@ -182,6 +194,14 @@ private:
 	void _notify_threads(const ThreadData *p_current_thread_data, uint32_t p_process_count, uint32_t p_promote_count);
 
 	bool _try_promote_low_priority_task();
+	void _mark_task_completed(Task *p_task);
+
+	Task *_alloc_graph_task(TaskGraph *p_graph, uint32_t p_node);
+	void _submit_task_graph(TaskGraph *p_graph, bool p_high_priority);
+	void _wait_for_task_graph(TaskGraph *p_graph);
+
+	Task *_pop_or_steal_local_task(ThreadData *p_thread_data);
+	bool _has_local_tasks() const;
 
 	static WorkerThreadPool *singleton;
 
@@ -233,6 +253,70 @@ protected:
 	static void _bind_methods();
 
 public:
+	// A set of tasks with dependencies among them. Once submitted, each node is posted to the pool
+	// as soon as all the nodes it depends on have finished, so no thread has to block in between.
+	// A graph can be submitted again once it has completed, but it can't be modified while running.
+	class TaskGraph {
+		friend class WorkerThreadPool;
+
+	public:
+		typedef uint32_t NodeID;
+
+	private:
+		struct Node {
+			Callable callable;
+			void (*native_func)(void *) = nullptr;
+			void *native_func_userdata = nullptr;
+			BaseTemplateUserdata *template_userdata = nullptr;
+			String description;
+			LocalVector<NodeID> successors;
+			uint32_t dependency_count = 0;
+			uint64_t start_usec = 0;
+			uint64_t end_usec = 0;
+		};
+
+		WorkerThreadPool *pool = nullptr;
+		LocalVector<Node> nodes;
+		// These are only accessed with the pool's task mutex held.
+		LocalVector<uint32_t> pending_dependencies;
+		uint32_t pending_nodes = 0;
+		bool running = false;
+		bool high_priority = true;
+		Task completion; // Not run; only used to let the pool's waiting logic await the whole graph.
+
+		NodeID _add_node(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, const String &p_description);
+
+	public:
+		template <typename C, typename M, typename U>
+		NodeID add_template_node(C *p_instance, M p_method, U p_userdata, const String &p_description = String()) {
+			typedef TaskUserData<C, M, U> TUD;
+			TUD *ud = memnew(TUD);
+			ud->instance = p_instance;
+			ud->method = p_method;
+			ud->userdata = p_userdata;
+			return _add_node(Callable(), nullptr, nullptr, ud, p_description);
+		}
+		NodeID add_native_node(void (*p_func)(void *), void *p_userdata, const String &p_description = String());
+		NodeID add_node(const Callable &p_action, const String &p_description = String());
+		// Makes `p_node` start only after `p_dependency` has finished.
+		void depends_on(NodeID p_node, NodeID p_dependency);
+
+		void submit(bool p_high_priority = true);
+		bool is_completed() const;
+		void wait();
+
+		_FORCE_INLINE_ uint32_t get_node_count() const { return nodes.size(); }
+		// Timings of the last run, as given by `OS::get_ticks_usec()`.
+		uint64_t get_node_start_usec(NodeID p_node) const;
+		uint64_t get_node_time_usec(NodeID p_node) const;
+		const String &get_node_description(NodeID p_node) const;
+
+		void clear();
+
+		TaskGraph(WorkerThreadPool *p_pool = nullptr);
+		~TaskGraph();
+	};
+
 	template <typename C, typename M, typename U>
 	TaskID add_template_task(C *p_instance, M p_method, U p_userdata, bool p_high_priority = false, const String &p_description = String()) {
 		typedef TaskUserData<C, M, U> TUD;
@@ -295,7 +379,9 @@ public:
 	static void thread_exit_unlock_allowance_zone(uint32_t p_zone_id) {}
 #endif
 
-	void init(int p_thread_count = -1, float p_low_priority_task_ratio = 0.3);
+	_FORCE_INLINE_ bool is_work_stealing() const { return work_stealing; }
+
+	void init(int p_thread_count = -1, float p_low_priority_task_ratio = 0.3, bool p_work_stealing = false);
 	void exit_languages_threads();
 	void finish();
 	WorkerThreadPool(bool p_singleton = true);
@@ -246,3 +246,214 @@ _GlobalNil::_GlobalNil() {
 }
 
 _GlobalNil _GlobalNilClass::_nil;
+
+// FrameArena
+
+static constexpr size_t FRAME_ARENA_BLOCK_SIZE = 64 * 1024;
+static constexpr uint32_t FRAME_ARENA_MAX_SPARE_BLOCKS = 16;
+// Each allocation is preceded by its size, padded to keep the data aligned.
+static constexpr size_t FRAME_ARENA_HEADER_SIZE = Memory::MAX_ALIGN;
+
+static SafeNumeric<uint64_t> frame_arena_frame;
+static SafeNumeric<uint64_t> frame_arena_bytes;
+static SafeNumeric<uint64_t> frame_arena_last_frame_bytes;
+static SafeNumeric<uint64_t> frame_arena_peak_frame_bytes;
+
+namespace {
+
+class FrameArenaThread {
+	struct Block {
+		Block *next = nullptr;
+		size_t capacity = 0;
+		size_t used = 0;
+
+		_FORCE_INLINE_ uint8_t *get_data() { return (uint8_t *)this + Memory::get_aligned_address(sizeof(Block), Memory::MAX_ALIGN); }
+	};
+
+	// Allocations of even and odd frames are kept apart, so they remain valid during the next frame.
+	struct Chain {
+		Block *blocks = nullptr; // Latest first.
+		uint64_t frame = 0;
+	};
+
+	Chain chains[2];
+	Block *spare_blocks = nullptr;
+	uint32_t spare_block_count = 0;
+
+	// Only the latest allocation can be grown in place or given back.
+	uint8_t *last_allocation = nullptr;
+	Block *last_block = nullptr;
+
+	uint64_t unreported_bytes = 0;
+
+	void _free_block(Block *p_block) {
+		if (p_block->capacity == FRAME_ARENA_BLOCK_SIZE && spare_block_count < FRAME_ARENA_MAX_SPARE_BLOCKS) {
+			p_block->next = spare_blocks;
+			spare_blocks = p_block;
+			spare_block_count++;
+		} else {
+			Memory::free_static(p_block);
+		}
+	}
+
+	Block *_add_block(Chain &p_chain, size_t p_size) {
+		report_bytes();
+
+		Block *block;
+		if (p_size <= FRAME_ARENA_BLOCK_SIZE && spare_blocks) {
+			block = spare_blocks;
+			spare_blocks = block->next;
+			spare_block_count--;
+		} else {
+			const size_t capacity = MAX(p_size, FRAME_ARENA_BLOCK_SIZE);
+			block = (Block *)Memory::alloc_static(Memory::get_aligned_address(sizeof(Block), Memory::MAX_ALIGN) + capacity);
+			ERR_FAIL_NULL_V(block, nullptr);
+			block->capacity = capacity;
+		}
+		block->used = 0;
+		block->next = p_chain.blocks;
+		p_chain.blocks = block;
+		return block;
+	}
+
+	_FORCE_INLINE_ Chain &_get_chain() {
+		const uint64_t frame = frame_arena_frame.get();
+		Chain &chain = chains[frame & 1];
+		if (unlikely(chain.frame != frame)) {
+			// Everything in this chain was allocated at least two frames ago.
+			report_bytes();
+			while (chain.blocks) {
+				Block *next = chain.blocks->next;
+				_free_block(chain.blocks);
+				chain.blocks = next;
+			}
+			chain.frame = frame;
+			last_allocation = nullptr;
+			last_block = nullptr;
+		}
+		return chain;
+	}
+
+	_FORCE_INLINE_ static uint64_t &_get_size(uint8_t *p_memory) {
+		return *(uint64_t *)(p_memory - FRAME_ARENA_HEADER_SIZE);
+	}
+
+public:
+	void report_bytes() {
+		if (unreported_bytes) {
+			frame_arena_bytes.add(unreported_bytes);
+			unreported_bytes = 0;
+		}
+	}
+
+	void *alloc(size_t p_bytes) {
+		Chain &chain = _get_chain();
+
+		const size_t size = FRAME_ARENA_HEADER_SIZE + Memory::get_aligned_address(p_bytes, Memory::MAX_ALIGN);
+		Block *block = chain.blocks;
+		if (!block || block->capacity - block->used < size) {
+			block = _add_block(chain, size);
+			ERR_FAIL_NULL_V(block, nullptr);
+		}
+
+		uint8_t *mem = block->get_data() + block->used + FRAME_ARENA_HEADER_SIZE;
+		_get_size(mem) = p_bytes;
+		block->used += size;
+		unreported_bytes += size;
+
+		last_allocation = mem;
+		last_block = block;
+		return mem;
+	}
+
+	void *realloc(void *p_memory, size_t p_bytes) {
+		if (!p_memory) {
+			return alloc(p_bytes);
+		}
+		// Switch frames first, so memory from a previous frame is never grown in place.
+		_get_chain();
+
+		uint8_t *mem = (uint8_t *)p_memory;
+		const uint64_t old_bytes = _get_size(mem);
+
+		if (mem == last_allocation) {
+			const size_t old_size = Memory::get_aligned_address(old_bytes, Memory::MAX_ALIGN);
+			const size_t new_size = Memory::get_aligned_address(p_bytes, Memory::MAX_ALIGN);
+			if (new_size <= old_size || last_block->capacity - last_block->used >= new_size - old_size) {
+				last_block->used = last_block->used - old_size + new_size;
+				if (new_size > old_size) {
+					unreported_bytes += new_size - old_size;
+				}
+				_get_size(mem) = p_bytes;
+				return mem;
+			}
+		} else if (p_bytes <= old_bytes) {
+			_get_size(mem) = p_bytes;
+			return mem;
+		}
+
+		void *new_mem = alloc(p_bytes);
+		ERR_FAIL_NULL_V(new_mem, nullptr);
+		memcpy(new_mem, mem, MIN(old_bytes, (uint64_t)p_bytes));
+		return new_mem;
+	}
+
+	void free(void *p_memory) {
+		if (p_memory && p_memory == last_allocation) {
+			last_block->used -= FRAME_ARENA_HEADER_SIZE + Memory::get_aligned_address(_get_size(last_allocation), Memory::MAX_ALIGN);
+			last_allocation = nullptr;
+		}
+	}
+
+	~FrameArenaThread() {
+		report_bytes();
+		for (Chain &chain : chains) {
+			while (chain.blocks) {
+				Block *next = chain.blocks->next;
+				Memory::free_static(chain.blocks);
+				chain.blocks = next;
+			}
+		}
+		while (spare_blocks) {
+			Block *next = spare_blocks->next;
+			Memory::free_static(spare_blocks);
+			spare_blocks = next;
+		}
+	}
+};
+
+thread_local FrameArenaThread frame_arena_thread;
+
+} // namespace
+
+void *FrameArena::alloc(size_t p_bytes) {
+	return frame_arena_thread.alloc(p_bytes);
+}
+
+void *FrameArena::realloc(void *p_memory, size_t p_bytes) {
+	return frame_arena_thread.realloc(p_memory, p_bytes);
+}
+
+void FrameArena::free(void *p_memory) {
+	frame_arena_thread.free(p_memory);
+}
+
+void FrameArena::next_frame() {
+	// Other threads report their usage lazily, but the main thread is usually the biggest user.
+	frame_arena_thread.report_bytes();
+
+	const uint64_t bytes = frame_arena_bytes.get();
+	frame_arena_bytes.sub(bytes);
+	frame_arena_last_frame_bytes.set(bytes);
+	frame_arena_peak_frame_bytes.exchange_if_greater(bytes);
+
+	frame_arena_frame.increment();
+}
+
+uint64_t FrameArena::get_frame_bytes() {
+	return frame_arena_last_frame_bytes.get();
+}
+
+uint64_t FrameArena::get_peak_frame_bytes() {
+	return frame_arena_peak_frame_bytes.get();
+}
@@ -101,9 +101,34 @@ uint64_t get_mem_max_usage();
 class DefaultAllocator {
 public:
 	_FORCE_INLINE_ static void *alloc(size_t p_memory) { return Memory::alloc_static(p_memory, false); }
+	_FORCE_INLINE_ static void *realloc(void *p_ptr, size_t p_memory) { return Memory::realloc_static(p_ptr, p_memory, false); }
 	_FORCE_INLINE_ static void free(void *p_ptr) { Memory::free_static(p_ptr, false); }
 };
 
+// Bump allocator for temporary data that is rebuilt every frame, to avoid going through the
+// system allocator for it. Each thread allocates from its own arena without any locking.
+//
+// Memory allocated during a frame stays valid until the end of the next frame; after that,
+// the thread that allocated it reuses it. Never keep allocations around for longer, and
+// don't use it for anything that may outlive the frame, like data owned by resources.
+// Freeing only reclaims memory if it was the latest allocation of the thread.
+//
+// Can be used as allocator of containers, e.g. List<T, FrameArena>, FrameLocalVector or FrameHashMap.
+class FrameArena {
+public:
+	static void *alloc(size_t p_bytes);
+	static void *realloc(void *p_memory, size_t p_bytes);
+	static void free(void *p_memory);
+
+	// Called by Main::iteration() at the start of every frame.
+	static void next_frame();
+
+	// Bytes allocated from the arenas of all threads during the last frame, and the most in any frame.
+	// Threads report their usage in blocks, so these are accurate to about one block per thread.
+	static uint64_t get_frame_bytes();
+	static uint64_t get_peak_frame_bytes();
+};
+
 // Works around an issue where memnew_placement (char *) would call the p_description version.
 inline void *operator new(size_t p_size, char *p_dest) {
 	return operator new(p_size, (void *)p_dest);
@@ -301,3 +326,11 @@ public:
 	_FORCE_INLINE_ T *new_allocation(const Args &&...p_args) { return memnew(T(p_args...)); }
 	_FORCE_INLINE_ void delete_allocation(T *p_allocation) { memdelete(p_allocation); }
 };
+
+template <typename T>
+class FrameArenaTypedAllocator {
+public:
+	template <typename... Args>
+	_FORCE_INLINE_ T *new_allocation(const Args &&...p_args) { return memnew_allocator(T(p_args...), FrameArena); }
+	_FORCE_INLINE_ void delete_allocation(T *p_allocation) { memdelete_allocator<T, FrameArena>(p_allocation); }
+};
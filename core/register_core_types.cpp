@@ -43,6 +43,7 @@
 #include "core/input/input.h"
 #include "core/input/input_map.h"
 #include "core/input/shortcut.h"
+#include "core/io/async_file_reader.h"
 #include "core/io/config_file.h"
 #include "core/io/dir_access.h"
 #include "core/io/dtls_server.h"
@@ -113,6 +114,7 @@ static CoreBind::Geometry2D *_geometry_2d = nullptr;
 static CoreBind::Geometry3D *_geometry_3d = nullptr;
 
 static WorkerThreadPool *worker_thread_pool = nullptr;
+static AsyncFileReader *async_file_reader = nullptr;
 
 extern Mutex _global_mutex;
 
@@ -340,6 +342,7 @@ void register_core_types() {
 	GDREGISTER_NATIVE_STRUCT(ScriptLanguageExtensionProfilingInfo, "StringName signature;uint64_t call_count;uint64_t total_time;uint64_t self_time");
 
 	worker_thread_pool = memnew(WorkerThreadPool);
+	async_file_reader = AsyncFileReader::create();
 
 	OS::get_singleton()->benchmark_end_measure("Core", "Register Types");
 }
@@ -353,6 +356,7 @@ void register_core_settings() {
 
 	GLOBAL_DEF("threading/worker_pool/max_threads", -1);
 	GLOBAL_DEF("threading/worker_pool/low_priority_thread_ratio", 0.3);
+	GLOBAL_DEF_RST("threading/worker_pool/work_stealing", false);
 }
 
 void register_early_core_singletons() {
@@ -412,6 +416,7 @@ void unregister_core_types() {
 	// Destroy singletons in reverse order to ensure dependencies are not broken.
 
 	memdelete(worker_thread_pool);
+	memdelete(async_file_reader);
 
 	memdelete(_engine_debugger);
 	memdelete(_marshalls);
@@ -32,38 +32,188 @@
 
 #include "core/os/mutex.h"
 #include "core/os/os.h"
+#include "core/os/thread.h"
 #include "core/string/print_string.h"
 #include "core/templates/paged_allocator.h"
 
+// The intern table is a fixed array of hash buckets split into shards.
+// Lookups walk the bucket chains without locking: an entry is only returned
+// after a successful conditional increment of its refcount, and its hash and
+// name are validated afterwards, since an entry that reached zero may have been
+// recycled for another string in the meantime. Entries are never given back to
+// the allocator while the table is configured, so a stale pointer always points
+// to a valid _Data.
+// Insertions, removals and recycling happen with the lock of the shard owning
+// the bucket held, so threads interning unrelated names rarely contend.
 struct StringName::Table {
 	constexpr static uint32_t TABLE_BITS = 16;
 	constexpr static uint32_t TABLE_LEN = 1 << TABLE_BITS;
 	constexpr static uint32_t TABLE_MASK = TABLE_LEN - 1;
 
-	static inline _Data *table[TABLE_LEN];
-	static inline BinaryMutex mutex;
-	static inline PagedAllocator<_Data> allocator;
+	constexpr static uint32_t SHARD_BITS = 6;
+	constexpr static uint32_t SHARD_COUNT = 1 << SHARD_BITS;
+	constexpr static uint32_t SHARD_MASK = SHARD_COUNT - 1;
+
+	struct alignas(Thread::CACHE_LINE_BYTES) Shard {
+		BinaryMutex mutex;
+		PagedAllocator<_Data, false, 256> allocator;
+		_Data *free_list = nullptr;
+	};
+
+	static std::atomic<_Data *> table[TABLE_LEN];
+	static Shard shards[SHARD_COUNT];
+
+	_FORCE_INLINE_ static Shard &get_shard(uint32_t p_hash) {
+		return shards[p_hash & SHARD_MASK];
+	}
+
+	template <typename T>
+	static _Data *lookup(uint32_t p_hash, const T &p_name);
+	template <typename T>
+	static _Data *intern(uint32_t p_hash, const T &p_name, bool p_static);
+	static void release(_Data *p_data);
 };
 
+std::atomic<StringName::_Data *> StringName::Table::table[StringName::Table::TABLE_LEN];
+StringName::Table::Shard StringName::Table::shards[StringName::Table::SHARD_COUNT];
+
+template <typename T>
+StringName::_Data *StringName::Table::lookup(uint32_t p_hash, const T &p_name) {
+	_Data *d = table[p_hash & TABLE_MASK].load(std::memory_order_acquire);
+	while (d) {
+		// Reference first: hash and name are only stable while the entry is alive.
+		if (d->refcount.ref()) {
+			if (d->hash == p_hash && d->name == p_name) {
+				return d;
+			}
+			if (d->refcount.unref()) {
+				release(d);
+			}
+		}
+		d = d->next.load(std::memory_order_acquire);
+	}
+	return nullptr;
+}
+
+template <typename T>
+StringName::_Data *StringName::Table::intern(uint32_t p_hash, const T &p_name, bool p_static) {
+	const uint32_t idx = p_hash & TABLE_MASK;
+
+#ifdef DEBUG_ENABLED
+	if (likely(!debug_stringname)) {
+#endif
+		_Data *d = lookup(p_hash, p_name);
+		if (d) {
+			if (p_static) {
+				d->static_count.increment();
+			}
+			return d;
+		}
+#ifdef DEBUG_ENABLED
+	}
+#endif
+
+	Shard &shard = get_shard(p_hash);
+	MutexLock lock(shard.mutex);
+
+	// Search again, another thread may have inserted it before the lock was acquired.
+	_Data *d = table[idx].load(std::memory_order_relaxed);
+	while (d) {
+		// compare hash first
+		if (d->hash == p_hash && d->name == p_name) {
+			break;
+		}
+		d = d->next.load(std::memory_order_relaxed);
+	}
+
+	if (d && d->refcount.ref()) {
+		// exists
+		if (p_static) {
+			d->static_count.increment();
+		}
+#ifdef DEBUG_ENABLED
+		if (unlikely(debug_stringname)) {
+			d->debug_references++;
+		}
+#endif
+		return d;
+	}
+
+	if (shard.free_list) {
+		d = shard.free_list;
+		shard.free_list = d->prev;
+	} else {
+		d = shard.allocator.alloc();
+	}
+	d->name = p_name;
+	d->static_count.set(p_static ? 1 : 0);
+	d->hash = p_hash;
+	d->prev = nullptr;
+	_Data *head = table[idx].load(std::memory_order_relaxed);
+	d->next.store(head, std::memory_order_relaxed);
+	// Publishes the fields above to lock-free lookups that still hold a stale pointer to this entry.
+	d->refcount.init();
+
+#ifdef DEBUG_ENABLED
+	if (unlikely(debug_stringname)) {
+		// Keep in memory, force static.
+		d->refcount.ref();
+		d->static_count.increment();
+	}
+#endif
+	if (head) {
+		head->prev = d;
+	}
+	table[idx].store(d, std::memory_order_release);
+	return d;
+}
+
+void StringName::Table::release(_Data *p_data) {
+	Shard &shard = get_shard(p_data->hash);
+	MutexLock lock(shard.mutex);
+
+	if (CoreGlobals::leak_reporting_enabled && p_data->static_count.get() > 0) {
+		ERR_PRINT("BUG: Unreferenced static string to 0: " + p_data->name);
+	}
+
+	_Data *next = p_data->next.load(std::memory_order_relaxed);
+	if (p_data->prev) {
+		p_data->prev->next.store(next, std::memory_order_release);
+	} else {
+		table[p_data->hash & TABLE_MASK].store(next, std::memory_order_release);
+	}
+	if (next) {
+		next->prev = p_data->prev;
+	}
+
+	// Lookups may still be walking through this entry, so it is recycled instead of freed.
+	p_data->name = String();
+	p_data->next.store(nullptr, std::memory_order_release);
+	p_data->prev = shard.free_list;
+	shard.free_list = p_data;
+}
+
 void StringName::setup() {
 	ERR_FAIL_COND(configured);
 	for (uint32_t i = 0; i < Table::TABLE_LEN; i++) {
-		Table::table[i] = nullptr;
+		Table::table[i].store(nullptr, std::memory_order_relaxed);
 	}
 	configured = true;
 }
 
 void StringName::cleanup() {
-	MutexLock lock(Table::mutex);
+	for (uint32_t i = 0; i < Table::SHARD_COUNT; i++) {
+		Table::shards[i].mutex.lock();
+	}
 
 #ifdef DEBUG_ENABLED
 	if (unlikely(debug_stringname)) {
 		Vector<_Data *> data;
 		for (uint32_t i = 0; i < Table::TABLE_LEN; i++) {
-			_Data *d = Table::table[i];
+			_Data *d = Table::table[i].load(std::memory_order_relaxed);
 			while (d) {
 				data.push_back(d);
-				d = d->next;
+				d = d->next.load(std::memory_order_relaxed);
 			}
 		}
 
@@ -87,8 +237,8 @@ void StringName::cleanup() {
 #endif
 	int lost_strings = 0;
 	for (uint32_t i = 0; i < Table::TABLE_LEN; i++) {
-		while (Table::table[i]) {
-			_Data *d = Table::table[i];
+		_Data *d = Table::table[i].load(std::memory_order_relaxed);
+		while (d) {
 			if (d->static_count.get() != d->refcount.get()) {
 				lost_strings++;
 
@@ -97,36 +247,35 @@ void StringName::cleanup() {
 				}
 			}
 
-			Table::table[i] = Table::table[i]->next;
-			Table::allocator.free(d);
+			_Data *next = d->next.load(std::memory_order_relaxed);
+			Table::get_shard(d->hash).allocator.free(d);
+			d = next;
+		}
+		Table::table[i].store(nullptr, std::memory_order_relaxed);
+	}
+	for (uint32_t i = 0; i < Table::SHARD_COUNT; i++) {
+		Table::Shard &shard = Table::shards[i];
+		while (shard.free_list) {
+			_Data *d = shard.free_list;
+			shard.free_list = d->prev;
+			shard.allocator.free(d);
 		}
 	}
 	if (lost_strings) {
 		print_verbose(vformat("StringName: %d unclaimed string names at exit.", lost_strings));
 	}
 	configured = false;
+
+	for (uint32_t i = 0; i < Table::SHARD_COUNT; i++) {
+		Table::shards[i].mutex.unlock();
+	}
 }
 
 void StringName::unref() {
 	ERR_FAIL_COND(!configured);
 
 	if (_data && _data->refcount.unref()) {
-		MutexLock lock(Table::mutex);
-
-		if (CoreGlobals::leak_reporting_enabled && _data->static_count.get() > 0) {
-			ERR_PRINT("BUG: Unreferenced static string to 0: " + _data->name);
-		}
-		if (_data->prev) {
-			_data->prev->next = _data->next;
-		} else {
-			const uint32_t idx = _data->hash & Table::TABLE_MASK;
-			Table::table[idx] = _data->next;
-		}
-
-		if (_data->next) {
-			_data->next->prev = _data->prev;
-		}
-		Table::allocator.free(_data);
+		Table::release(_data);
 	}
 
 	_data = nullptr;
@@ -211,52 +360,7 @@ StringName::StringName(const char *p_name, bool p_static) {
 		return; //empty, ignore
 	}
 
-	const uint32_t hash = String::hash(p_name);
-	const uint32_t idx = hash & Table::TABLE_MASK;
-
-	MutexLock lock(Table::mutex);
-	_data = Table::table[idx];
-
-	while (_data) {
-		// compare hash first
-		if (_data->hash == hash && _data->name == p_name) {
-			break;
-		}
-		_data = _data->next;
-	}
-
-	if (_data && _data->refcount.ref()) {
-		// exists
-		if (p_static) {
-			_data->static_count.increment();
-		}
-#ifdef DEBUG_ENABLED
-		if (unlikely(debug_stringname)) {
-			_data->debug_references++;
-		}
-#endif
-		return;
-	}
-
-	_data = Table::allocator.alloc();
-	_data->name = p_name;
-	_data->refcount.init();
-	_data->static_count.set(p_static ? 1 : 0);
-	_data->hash = hash;
-	_data->next = Table::table[idx];
-	_data->prev = nullptr;
-
-#ifdef DEBUG_ENABLED
-	if (unlikely(debug_stringname)) {
-		// Keep in memory, force static.
-		_data->refcount.ref();
-		_data->static_count.increment();
-	}
-#endif
-	if (Table::table[idx]) {
-		Table::table[idx]->prev = _data;
-	}
-	Table::table[idx] = _data;
+	_data = Table::intern(String::hash(p_name), p_name, p_static);
 }
 
 StringName::StringName(const String &p_name, bool p_static) {
@@ -268,51 +372,7 @@ StringName::StringName(const String &p_name, bool p_static) {
 		return;
 	}
 
-	const uint32_t hash = p_name.hash();
-	const uint32_t idx = hash & Table::TABLE_MASK;
-
-	MutexLock lock(Table::mutex);
-	_data = Table::table[idx];
-
-	while (_data) {
-		if (_data->hash == hash && _data->name == p_name) {
-			break;
-		}
-		_data = _data->next;
-	}
-
-	if (_data && _data->refcount.ref()) {
-		// exists
-		if (p_static) {
-			_data->static_count.increment();
-		}
-#ifdef DEBUG_ENABLED
-		if (unlikely(debug_stringname)) {
-			_data->debug_references++;
-		}
-#endif
-		return;
-	}
-
-	_data = Table::allocator.alloc();
-	_data->name = p_name;
-	_data->refcount.init();
-	_data->static_count.set(p_static ? 1 : 0);
-	_data->hash = hash;
-	_data->next = Table::table[idx];
-	_data->prev = nullptr;
-#ifdef DEBUG_ENABLED
-	if (unlikely(debug_stringname)) {
-		// Keep in memory, force static.
-		_data->refcount.ref();
-		_data->static_count.increment();
-	}
-#endif
-
-	if (Table::table[idx]) {
-		Table::table[idx]->prev = _data;
-	}
-	Table::table[idx] = _data;
+	_data = Table::intern(p_name.hash(), p_name, p_static);
 }
 
 bool operator==(const String &p_name, const StringName &p_string_name) {
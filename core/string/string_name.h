@@ -49,8 +49,10 @@ class [[nodiscard]] StringName {
 #endif
 
 		uint32_t hash = 0;
+		// Only accessed with the shard lock held. Doubles as the free list link of recycled entries.
 		_Data *prev = nullptr;
-		_Data *next = nullptr;
+		// Traversed without locking by lookups, see StringName::Table.
+		std::atomic<_Data *> next = nullptr;
 	};
 
 	_Data *_data = nullptr;
@@ -216,6 +216,17 @@ public:
 	_FORCE_INLINE_ operator Span<T>() const { return Span<T>(ptr(), size()); }
 	_FORCE_INLINE_ Span<T> span() const { return operator Span<T>(); }
 
+	/// Space needed in front of external elements for the header, see use_external().
+	static constexpr size_t EXTERNAL_HEADER_SIZE = DATA_OFFSET;
+
+	/// References elements stored outside of CowData, e.g. in a memory mapped file, without copying them.
+	/// The header is written into the EXTERNAL_HEADER_SIZE bytes in front of p_data, which are expected to be zeroed before the first use.
+	/// The first use adds a reference which is never released, so the elements are never freed nor modified in place, but forked on the first modification.
+	/// It is the responsibility of the caller to:
+	/// - Ensure p_data is aligned to Memory::MAX_ALIGN, and the header bytes are writable.
+	/// - Keep the memory valid for as long as any CowData may reference it.
+	Error use_external(T *p_data, USize p_size);
+
 	_FORCE_INLINE_ CowData() {}
 	_FORCE_INLINE_ ~CowData() { _unref(); }
 	_FORCE_INLINE_ CowData(std::initializer_list<T> p_init);
@@ -547,6 +558,37 @@ Error CowData<T>::_copy_on_write() {
 	return _copy_to_new_buffer_exact(capacity(), size(), 0, 0);
 }
 
+template <typename T>
+Error CowData<T>::use_external(T *p_data, USize p_size) {
+	static_assert(std::is_trivially_destructible_v<T>, "External elements are never destructed.");
+
+	_unref();
+	if (p_size == 0) {
+		return OK;
+	}
+	ERR_FAIL_COND_V(((uintptr_t)p_data % Memory::MAX_ALIGN) != 0, ERR_INVALID_PARAMETER);
+
+	uint8_t *mem = (uint8_t *)p_data - DATA_OFFSET;
+	std::atomic<USize> *refcount = (std::atomic<USize> *)(mem + REF_COUNT_OFFSET);
+	std::atomic<USize> *size = (std::atomic<USize> *)(mem + SIZE_OFFSET);
+	std::atomic<USize> *capacity = (std::atomic<USize> *)(mem + CAPACITY_OFFSET);
+
+	USize count = refcount->load(std::memory_order_acquire);
+	if (count == 0) {
+		// First use. Threads racing here all write the same values.
+		size->store(p_size, std::memory_order_relaxed);
+		capacity->store(p_size, std::memory_order_relaxed);
+	} else {
+		ERR_FAIL_COND_V(size->load(std::memory_order_relaxed) != p_size || capacity->load(std::memory_order_relaxed) != p_size, ERR_INVALID_DATA);
+	}
+
+	while (!refcount->compare_exchange_weak(count, count == 0 ? 2 : count + 1, std::memory_order_acq_rel, std::memory_order_acquire)) {
+	}
+
+	_ptr = p_data;
+	return OK;
+}
+
 template <typename T>
 void CowData<T>::_ref(const CowData *p_from) {
 	_ref(*p_from);
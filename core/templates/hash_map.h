@@ -699,3 +699,10 @@ public:
 		}
 	}
 };
+
+// Allocates its elements from the FrameArena, so it must not be kept beyond the next frame.
+// The bucket arrays still come from the regular allocator.
+template <typename TKey, typename TValue,
+		typename Hasher = HashMapHasherDefault,
+		typename Comparator = HashMapComparatorDefault<TKey>>
+using FrameHashMap = HashMap<TKey, TValue, Hasher, Comparator, FrameArenaTypedAllocator<HashMapElement<TKey, TValue>>>;
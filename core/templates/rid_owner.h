@@ -40,10 +40,6 @@
 #include <cstdio>
 #include <typeinfo> // IWYU pragma: keep // Used in macro.
 
-#ifdef TSAN_ENABLED
-#include <sanitizer/tsan_interface.h>
-#endif
-
 // The following macros would need to be implemented somehow
 // for purely weakly ordered architectures. There's a test case
 // ("[RID_Owner] Thread safety") with potential to catch issues
@@ -106,6 +102,33 @@ class RID_Alloc : public RID_AllocBase {
 
 	mutable Mutex mutex;
 
+	// In the thread-safe variant, get_or_null() and owns() don't lock the mutex. They rely on
+	// chunks never being moved or freed while the allocator is alive, and on the validator
+	// of each element being published with release semantics once its data is ready.
+	_FORCE_INLINE_ uint32_t _load_max_alloc() const {
+		if constexpr (THREAD_SAFE) {
+			return ((const std::atomic<uint32_t> *)&max_alloc)->load(std::memory_order_acquire);
+		} else {
+			return max_alloc;
+		}
+	}
+
+	_FORCE_INLINE_ static uint32_t _load_validator(const Chunk &p_chunk) {
+		if constexpr (THREAD_SAFE) {
+			return ((const std::atomic<uint32_t> *)&p_chunk.validator)->load(std::memory_order_acquire);
+		} else {
+			return p_chunk.validator;
+		}
+	}
+
+	_FORCE_INLINE_ static void _store_validator(Chunk &p_chunk, uint32_t p_validator) {
+		if constexpr (THREAD_SAFE) {
+			((std::atomic<uint32_t> *)&p_chunk.validator)->store(p_validator, std::memory_order_release);
+		} else {
+			p_chunk.validator = p_validator;
+		}
+	}
+
 	_FORCE_INLINE_ RID _allocate_rid() {
 		if constexpr (THREAD_SAFE) {
 			mutex.lock();
@@ -142,8 +165,8 @@ class RID_Alloc : public RID_AllocBase {
 			}
 
 			if constexpr (THREAD_SAFE) {
-				// Store atomically to avoid data race with the load in get_or_null().
-				((std::atomic<uint32_t> *)&max_alloc)->store(max_alloc + elements_in_chunk, std::memory_order_relaxed);
+				// Publishes the new chunk to get_or_null() and owns().
+				((std::atomic<uint32_t> *)&max_alloc)->store(max_alloc + elements_in_chunk, std::memory_order_release);
 			} else {
 				max_alloc += elements_in_chunk;
 			}
@@ -159,8 +182,7 @@ class RID_Alloc : public RID_AllocBase {
 		id <<= 32;
 		id |= free_index;
 
-		chunks[free_chunk][free_element].validator = validator;
-		chunks[free_chunk][free_element].validator |= 0x80000000; //mark uninitialized bit
+		_store_validator(chunks[free_chunk][free_element], validator | 0x80000000); //mark uninitialized bit
 
 		alloc_count++;
 
@@ -171,6 +193,22 @@ class RID_Alloc : public RID_AllocBase {
 		return _make_from_id(id);
 	}
 
+	Chunk *_get_uninitialized(const RID &p_rid) {
+		uint64_t id = p_rid.get_id();
+		uint32_t idx = uint32_t(id & 0xFFFFFFFF);
+		ERR_FAIL_COND_V(p_rid == RID() || idx >= _load_max_alloc(), nullptr);
+
+		Chunk &c = chunks[idx / elements_in_chunk][idx % elements_in_chunk];
+		uint32_t current_validator = _load_validator(c);
+		if (unlikely(!(current_validator & 0x80000000))) {
+			ERR_FAIL_V_MSG(nullptr, "Initializing already initialized RID");
+		}
+		if (unlikely((current_validator & 0x7FFFFFFF) != uint32_t(id >> 32))) {
+			ERR_FAIL_V_MSG(nullptr, "Attempting to initialize the wrong RID");
+		}
+		return &c;
+	}
+
 public:
 	RID make_rid() {
 		RID rid = _allocate_rid();
@@ -193,19 +231,9 @@ public:
 			return nullptr;
 		}
 
-		if constexpr (THREAD_SAFE) {
-			SYNC_ACQUIRE;
-		}
-
 		uint64_t id = p_rid.get_id();
 		uint32_t idx = uint32_t(id & 0xFFFFFFFF);
-		uint32_t ma;
-		if constexpr (THREAD_SAFE) { // Read atomically to avoid data race with the store in _allocate_rid().
-			ma = ((std::atomic<uint32_t> *)&max_alloc)->load(std::memory_order_relaxed);
-		} else {
-			ma = max_alloc;
-		}
-		if (unlikely(idx >= ma)) {
+		if (unlikely(idx >= _load_max_alloc())) {
 			return nullptr;
 		}
 
@@ -214,102 +242,53 @@ public:
 
 		uint32_t validator = uint32_t(id >> 32);
 
-		if constexpr (THREAD_SAFE) {
-#ifdef TSAN_ENABLED
-			__tsan_acquire(&chunks[idx_chunk]); // We know not a race in practice.
-			__tsan_acquire(&chunks[idx_chunk][idx_element]); // We know not a race in practice.
-#endif
-		}
-
 		Chunk &c = chunks[idx_chunk][idx_element];
-
-		if constexpr (THREAD_SAFE) {
-#ifdef TSAN_ENABLED
-			__tsan_release(&chunks[idx_chunk]);
-			__tsan_release(&chunks[idx_chunk][idx_element]);
-			__tsan_acquire(&c.validator); // We know not a race in practice.
-#endif
-		}
+		uint32_t current_validator = _load_validator(c);
 
 		if (unlikely(p_initialize)) {
-			if (unlikely(!(c.validator & 0x80000000))) {
+			if (unlikely(!(current_validator & 0x80000000))) {
 				ERR_FAIL_V_MSG(nullptr, "Initializing already initialized RID");
 			}
 
-			if (unlikely((c.validator & 0x7FFFFFFF) != validator)) {
+			if (unlikely((current_validator & 0x7FFFFFFF) != validator)) {
 				ERR_FAIL_V_MSG(nullptr, "Attempting to initialize the wrong RID");
 			}
 
-			c.validator &= 0x7FFFFFFF; //initialized
+			_store_validator(c, current_validator & 0x7FFFFFFF); //initialized
 
-		} else if (unlikely(c.validator != validator)) {
-			if ((c.validator & 0x80000000) && c.validator != 0xFFFFFFFF) {
+		} else if (unlikely(current_validator != validator)) {
+			if ((current_validator & 0x80000000) && current_validator != 0xFFFFFFFF) {
 				ERR_FAIL_V_MSG(nullptr, "Attempting to use an uninitialized RID");
 			}
 			return nullptr;
 		}
 
-		if constexpr (THREAD_SAFE) {
-#ifdef TSAN_ENABLED
-			__tsan_release(&c.validator);
-#endif
-		}
-
 		T *ptr = &c.data;
 
 		return ptr;
 	}
 	void initialize_rid(RID p_rid) {
-		T *mem = get_or_null(p_rid, true);
-		ERR_FAIL_NULL(mem);
-
-		if constexpr (THREAD_SAFE) {
-#ifdef TSAN_ENABLED
-			__tsan_acquire(mem); // We know not a race in practice.
-#endif
-		}
-
-		memnew_placement(mem, T);
+		Chunk *c = _get_uninitialized(p_rid);
+		ERR_FAIL_NULL(c);
 
-		if constexpr (THREAD_SAFE) {
-#ifdef TSAN_ENABLED
-			__tsan_release(mem);
-#endif
-			SYNC_RELEASE;
-		}
+		memnew_placement(&c->data, T);
+		// Only now other threads can get the element.
+		_store_validator(*c, _load_validator(*c) & 0x7FFFFFFF);
 	}
 
 	void initialize_rid(RID p_rid, const T &p_value) {
-		T *mem = get_or_null(p_rid, true);
-		ERR_FAIL_NULL(mem);
-
-		if constexpr (THREAD_SAFE) {
-#ifdef TSAN_ENABLED
-			__tsan_acquire(mem); // We know not a race in practice.
-#endif
-		}
-
-		memnew_placement(mem, T(p_value));
+		Chunk *c = _get_uninitialized(p_rid);
+		ERR_FAIL_NULL(c);
 
-		if constexpr (THREAD_SAFE) {
-#ifdef TSAN_ENABLED
-			__tsan_release(mem);
-#endif
-			SYNC_RELEASE;
-		}
+		memnew_placement(&c->data, T(p_value));
+		// Only now other threads can get the element.
+		_store_validator(*c, _load_validator(*c) & 0x7FFFFFFF);
 	}
 
 	_FORCE_INLINE_ bool owns(const RID &p_rid) const {
-		if constexpr (THREAD_SAFE) {
-			mutex.lock();
-		}
-
 		uint64_t id = p_rid.get_id();
 		uint32_t idx = uint32_t(id & 0xFFFFFFFF);
-		if (unlikely(idx >= max_alloc)) {
-			if constexpr (THREAD_SAFE) {
-				mutex.unlock();
-			}
+		if (unlikely(idx >= _load_max_alloc())) {
 			return false;
 		}
 
@@ -318,13 +297,7 @@ public:
 
 		uint32_t validator = uint32_t(id >> 32);
 
-		bool owned = (chunks[idx_chunk][idx_element].validator & 0x7FFFFFFF) == validator;
-
-		if constexpr (THREAD_SAFE) {
-			mutex.unlock();
-		}
-
-		return owned;
+		return (_load_validator(chunks[idx_chunk][idx_element]) & 0x7FFFFFFF) == validator;
 	}
 
 	_FORCE_INLINE_ void free(const RID &p_rid) {
@@ -345,20 +318,22 @@ public:
 		uint32_t idx_element = idx % elements_in_chunk;
 
 		uint32_t validator = uint32_t(id >> 32);
-		if (unlikely(chunks[idx_chunk][idx_element].validator & 0x80000000)) {
+		uint32_t current_validator = _load_validator(chunks[idx_chunk][idx_element]);
+		if (unlikely(current_validator & 0x80000000)) {
 			if constexpr (THREAD_SAFE) {
 				mutex.unlock();
 			}
 			ERR_FAIL_MSG("Attempted to free an uninitialized or invalid RID");
-		} else if (unlikely(chunks[idx_chunk][idx_element].validator != validator)) {
+		} else if (unlikely(current_validator != validator)) {
 			if constexpr (THREAD_SAFE) {
 				mutex.unlock();
 			}
 			ERR_FAIL();
 		}
 
+		// Invalidate before destroying, so lookups from other threads fail from now on.
+		_store_validator(chunks[idx_chunk][idx_element], 0xFFFFFFFF); // go invalid
 		chunks[idx_chunk][idx_element].data.~T();
-		chunks[idx_chunk][idx_element].validator = 0xFFFFFFFF; // go invalid
 
 		alloc_count--;
 		free_list_chunks[alloc_count / elements_in_chunk][alloc_count % elements_in_chunk] = idx;
@@ -377,7 +352,7 @@ public:
 			mutex.lock();
 		}
 		for (size_t i = 0; i < max_alloc; i++) {
-			uint64_t validator = chunks[i / elements_in_chunk][i % elements_in_chunk].validator;
+			uint64_t validator = _load_validator(chunks[i / elements_in_chunk][i % elements_in_chunk]);
 			if (validator != 0xFFFFFFFF) {
 				owned.push_back(_make_from_id((validator << 32) | i));
 			}
@@ -395,7 +370,7 @@ public:
 		}
 		uint32_t idx = 0;
 		for (size_t i = 0; i < max_alloc; i++) {
-			uint64_t validator = chunks[i / elements_in_chunk][i % elements_in_chunk].validator;
+			uint64_t validator = _load_validator(chunks[i / elements_in_chunk][i % elements_in_chunk]);
 			if (validator != 0xFFFFFFFF) {
 				p_rid_buffer[idx] = _make_from_id((validator << 32) | i);
 				idx++;
@@ -431,7 +406,7 @@ public:
 					alloc_count, description ? description : typeid(T).name()));
 
 			for (size_t i = 0; i < max_alloc; i++) {
-				uint32_t validator = chunks[i / elements_in_chunk][i % elements_in_chunk].validator;
+				uint32_t validator = _load_validator(chunks[i / elements_in_chunk][i % elements_in_chunk]);
 				if (validator & 0x80000000) {
 					continue; //uninitialized
 				}
@@ -0,0 +1,804 @@
+/**************************************************************************/
+/*  swiss_hash_map.h                                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/math/math_funcs_binary.h"
+#include "core/os/memory.h"
+#include "core/string/print_string.h"
+#include "core/templates/hashfuncs.h"
+#include "core/templates/pair.h"
+
+#include <initializer_list>
+
+class String;
+class StringName;
+class Variant;
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SWISS_HASH_MAP_SSE2
+#include <emmintrin.h>
+#elif (defined(__aarch64__) && defined(__ARM_NEON)) || defined(_M_ARM64)
+#define SWISS_HASH_MAP_NEON
+#include <arm_neon.h>
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+// Operations on groups of 16 control bytes, using SIMD where available.
+// Results are bit masks with one bit per slot of the group.
+struct SwissHashMapGroup {
+	static constexpr uint32_t SIZE = 16;
+	static constexpr uint8_t CTRL_EMPTY = 0x80;
+
+	// Slots whose control byte is `p_h2`.
+	static _FORCE_INLINE_ uint32_t match(const uint8_t *p_ctrl, uint8_t p_h2) {
+#if defined(SWISS_HASH_MAP_SSE2)
+		const __m128i ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p_ctrl));
+		return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8((char)p_h2)));
+#elif defined(SWISS_HASH_MAP_NEON)
+		return _to_mask(vceqq_u8(vld1q_u8(p_ctrl), vdupq_n_u8(p_h2)));
+#else
+		uint32_t mask = 0;
+		for (uint32_t i = 0; i < SIZE; i++) {
+			mask |= uint32_t(p_ctrl[i] == p_h2) << i;
+		}
+		return mask;
+#endif
+	}
+
+	// Empty slots. Since there are no tombstones, these are the only ones with the high bit set.
+	static _FORCE_INLINE_ uint32_t match_empty(const uint8_t *p_ctrl) {
+#if defined(SWISS_HASH_MAP_SSE2)
+		return (uint32_t)_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p_ctrl)));
+#elif defined(SWISS_HASH_MAP_NEON)
+		return _to_mask(vtstq_u8(vld1q_u8(p_ctrl), vdupq_n_u8(CTRL_EMPTY)));
+#else
+		uint32_t mask = 0;
+		for (uint32_t i = 0; i < SIZE; i++) {
+			mask |= uint32_t(p_ctrl[i] >> 7) << i;
+		}
+		return mask;
+#endif
+	}
+
+	static _FORCE_INLINE_ uint32_t first_bit(uint32_t p_mask) {
+#if defined(__GNUC__) || defined(__clang__)
+		return __builtin_ctz(p_mask);
+#elif defined(_MSC_VER)
+		unsigned long index;
+		_BitScanForward(&index, p_mask);
+		return index;
+#else
+		uint32_t index = 0;
+		while (!(p_mask & 1)) {
+			p_mask >>= 1;
+			index++;
+		}
+		return index;
+#endif
+	}
+
+#if defined(SWISS_HASH_MAP_NEON)
+	static _FORCE_INLINE_ uint32_t _to_mask(uint8x16_t p_bytes) {
+		static const uint8_t weights[SIZE] = { 1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128 };
+		const uint8x16_t bits = vandq_u8(p_bytes, vld1q_u8(weights));
+		return uint32_t(vaddv_u8(vget_low_u8(bits))) | (uint32_t(vaddv_u8(vget_high_u8(bits))) << 8);
+	}
+#endif
+};
+
+/**
+ * A Swiss table style hash map, with the same interface as `AHashMap`.
+ *
+ * Slots are arranged in groups of 16, each slot having a control byte that holds either
+ * an "empty" marker or 7 bits of the key's hash. A lookup compares a whole group of control
+ * bytes at once (with SSE2 or NEON, when available), and only compares keys for the few slots
+ * whose control byte matches. Probing goes linearly from group to group.
+ *
+ * Like in `AHashMap`, key-value pairs are kept in a dense array, so iteration is as fast as
+ * iterating over an array and elements can be accessed by index. When an element is erased,
+ * its place is taken by the element from the end.
+ *
+ * Erasing doesn't leave tombstones behind. Instead, elements whose probe sequence went through
+ * the erased slot's group are shifted back into it, so lookups never need to skip deleted slots
+ * and the table never needs to be rehashed to clean them up.
+ */
+template <typename TKey, typename TValue,
+		typename Hasher = HashMapHasherDefault,
+		typename Comparator = HashMapComparatorDefault<TKey>>
+class SwissHashMap {
+public:
+	static constexpr uint32_t GROUP_SIZE = SwissHashMapGroup::SIZE;
+	// Must be a power of two, and a multiple of GROUP_SIZE.
+	static constexpr uint32_t INITIAL_CAPACITY = 16;
+
+private:
+	typedef KeyValue<TKey, TValue> MapKeyValue;
+	MapKeyValue *_elements = nullptr;
+	uint32_t *_hashes = nullptr; // Full hash of each element, to avoid hashing keys again on rehash or erase.
+	uint8_t *_ctrl = nullptr; // One control byte per slot, followed by the element index of each slot.
+	uint32_t *_slots = nullptr; // Points inside the _ctrl allocation.
+
+	// Due to optimization, this is `group count - 1`.
+	uint32_t _group_mask = 0;
+	uint32_t _size = 0;
+
+	static _FORCE_INLINE_ uint8_t _h2(uint32_t p_hash) {
+		return p_hash & 0x7F;
+	}
+
+	_FORCE_INLINE_ uint32_t _home_group(uint32_t p_hash) const {
+		return (p_hash >> 7) & _group_mask;
+	}
+
+	// Load factor is 7/8.
+	static _FORCE_INLINE_ uint32_t _get_max_elements(uint32_t p_group_mask) {
+		uint32_t capacity = (p_group_mask + 1) * GROUP_SIZE;
+		return capacity - capacity / 8;
+	}
+
+	static _FORCE_INLINE_ uint32_t _get_group_mask_for(uint32_t p_elements) {
+		uint32_t capacity = MAX(INITIAL_CAPACITY, Math::next_power_of_2(p_elements + p_elements / 7 + 1));
+		return capacity / GROUP_SIZE - 1;
+	}
+
+	bool _lookup_slot(const TKey &p_key, uint32_t p_hash, uint32_t &r_slot) const {
+		if (unlikely(_elements == nullptr)) {
+			return false; // Failed lookups, no _elements.
+		}
+
+		const uint8_t h2 = _h2(p_hash);
+		uint32_t group = _home_group(p_hash);
+		while (true) {
+			const uint8_t *ctrl = _ctrl + group * GROUP_SIZE;
+			uint32_t match = SwissHashMapGroup::match(ctrl, h2);
+			while (match) {
+				uint32_t slot = group * GROUP_SIZE + SwissHashMapGroup::first_bit(match);
+				uint32_t element_idx = _slots[slot];
+				if (_hashes[element_idx] == p_hash && Comparator::compare(_elements[element_idx].key, p_key)) {
+					r_slot = slot;
+					return true;
+				}
+				match &= match - 1;
+			}
+
+			// Probing stops at the first group with an empty slot; the table is never full, so there's always one.
+			if (SwissHashMapGroup::match_empty(ctrl)) {
+				return false;
+			}
+			group = (group + 1) & _group_mask;
+		}
+	}
+
+	_FORCE_INLINE_ bool _lookup_idx(const TKey &p_key, uint32_t &r_element_idx) const {
+		if (unlikely(_elements == nullptr)) {
+			return false; // Failed lookups, no _elements.
+		}
+		uint32_t slot = 0;
+		if (_lookup_slot(p_key, Hasher::hash(p_key), slot)) {
+			r_element_idx = _slots[slot];
+			return true;
+		}
+		return false;
+	}
+
+	// Finds the slot pointing to a given element, without comparing keys.
+	uint32_t _find_slot_of_element(uint32_t p_element_idx) const {
+		const uint32_t hash = _hashes[p_element_idx];
+		const uint8_t h2 = _h2(hash);
+		uint32_t group = _home_group(hash);
+		while (true) {
+			uint32_t match = SwissHashMapGroup::match(_ctrl + group * GROUP_SIZE, h2);
+			while (match) {
+				uint32_t slot = group * GROUP_SIZE + SwissHashMapGroup::first_bit(match);
+				if (_slots[slot] == p_element_idx) {
+					return slot;
+				}
+				match &= match - 1;
+			}
+			group = (group + 1) & _group_mask;
+		}
+	}
+
+	void _insert_slot(uint32_t p_hash, uint32_t p_element_idx) {
+		uint32_t group = _home_group(p_hash);
+#ifdef DEV_ENABLED
+		uint32_t distance = 0;
+#endif
+		while (true) {
+			uint32_t empty = SwissHashMapGroup::match_empty(_ctrl + group * GROUP_SIZE);
+			if (empty) {
+				uint32_t slot = group * GROUP_SIZE + SwissHashMapGroup::first_bit(empty);
+				_ctrl[slot] = _h2(p_hash);
+				_slots[slot] = p_element_idx;
+				return;
+			}
+			group = (group + 1) & _group_mask;
+#ifdef DEV_ENABLED
+			if (unlikely(++distance == 8)) {
+				WARN_PRINT("Excessive collision count, is the right hash function being used?");
+			}
+#endif
+		}
+	}
+
+	// Empties a slot, then moves back into the hole any elements that relied on its group
+	// being full in order to be found, so no tombstone is needed.
+	void _erase_slot(uint32_t p_slot) {
+		uint32_t hole = p_slot;
+		_ctrl[hole] = SwissHashMapGroup::CTRL_EMPTY;
+
+		while (true) {
+			const uint32_t hole_group = hole / GROUP_SIZE;
+			const uint32_t hole_group_empty = SwissHashMapGroup::match_empty(_ctrl + hole_group * GROUP_SIZE);
+			if (hole_group_empty & (hole_group_empty - 1)) {
+				// The group already had an empty slot, so no probe sequence went past it.
+				return;
+			}
+
+			// Look for an element in the following groups whose probe sequence went through the hole's group.
+			uint32_t group = (hole_group + 1) & _group_mask;
+			bool moved = false;
+			while (!moved) {
+				const uint8_t *ctrl = _ctrl + group * GROUP_SIZE;
+				const uint32_t empty = SwissHashMapGroup::match_empty(ctrl);
+				const uint32_t distance_to_hole = (group - hole_group) & _group_mask;
+
+				uint32_t full = ~empty & ((1u << GROUP_SIZE) - 1);
+				while (full) {
+					uint32_t slot = group * GROUP_SIZE + SwissHashMapGroup::first_bit(full);
+					uint32_t home = _home_group(_hashes[_slots[slot]]);
+					if (((group - home) & _group_mask) >= distance_to_hole) {
+						_ctrl[hole] = _ctrl[slot];
+						_slots[hole] = _slots[slot];
+						_ctrl[slot] = SwissHashMapGroup::CTRL_EMPTY;
+						hole = slot;
+						moved = true;
+						break;
+					}
+					full &= full - 1;
+				}
+
+				if (!moved) {
+					if (empty) {
+						// Probe sequences stop here, so nothing beyond can rely on the hole's group.
+						return;
+					}
+					group = (group + 1) & _group_mask;
+				}
+			}
+		}
+	}
+
+	void _allocate_slots(uint32_t p_group_mask) {
+		_group_mask = p_group_mask;
+		uint32_t capacity = get_capacity();
+		// Control bytes, then slot indices; capacity is a multiple of 16, so the indices stay aligned.
+		_ctrl = reinterpret_cast<uint8_t *>(Memory::alloc_static(capacity * (sizeof(uint8_t) + sizeof(uint32_t))));
+		_slots = reinterpret_cast<uint32_t *>(_ctrl + capacity);
+		memset(_ctrl, SwissHashMapGroup::CTRL_EMPTY, capacity);
+	}
+
+	void _resize_and_rehash(uint32_t p_new_group_mask) {
+		uint8_t *old_ctrl = _ctrl;
+		_allocate_slots(p_new_group_mask);
+
+		uint32_t max_elements = _get_max_elements(_group_mask);
+		_elements = reinterpret_cast<MapKeyValue *>(Memory::realloc_static(_elements, sizeof(MapKeyValue) * max_elements));
+		_hashes = reinterpret_cast<uint32_t *>(Memory::realloc_static(_hashes, sizeof(uint32_t) * max_elements));
+
+		for (uint32_t i = 0; i < _size; i++) {
+			_insert_slot(_hashes[i], i);
+		}
+
+		Memory::free_static(old_ctrl);
+	}
+
+	int32_t _insert_element(const TKey &p_key, const TValue &p_value, uint32_t p_hash) {
+		if (unlikely(_elements == nullptr)) {
+			// Allocate on demand to save memory.
+			_allocate_slots(_group_mask);
+			uint32_t max_elements = _get_max_elements(_group_mask);
+			_elements = reinterpret_cast<MapKeyValue *>(Memory::alloc_static(sizeof(MapKeyValue) * max_elements));
+			_hashes = reinterpret_cast<uint32_t *>(Memory::alloc_static(sizeof(uint32_t) * max_elements));
+		}
+
+		if (unlikely(_size >= _get_max_elements(_group_mask))) {
+			_resize_and_rehash(_group_mask * 2 + 1);
+		}
+
+		memnew_placement(&_elements[_size], MapKeyValue(p_key, p_value));
+		_hashes[_size] = p_hash;
+
+		_insert_slot(p_hash, _size);
+		_size++;
+		return _size - 1;
+	}
+
+	void _init_from(const SwissHashMap &p_other) {
+		_group_mask = p_other._group_mask;
+		_size = p_other._size;
+
+		if (p_other._size == 0) {
+			return;
+		}
+
+		uint32_t capacity = get_capacity();
+		uint32_t max_elements = _get_max_elements(_group_mask);
+		_ctrl = reinterpret_cast<uint8_t *>(Memory::alloc_static(capacity * (sizeof(uint8_t) + sizeof(uint32_t))));
+		_slots = reinterpret_cast<uint32_t *>(_ctrl + capacity);
+		_elements = reinterpret_cast<MapKeyValue *>(Memory::alloc_static(sizeof(MapKeyValue) * max_elements));
+		_hashes = reinterpret_cast<uint32_t *>(Memory::alloc_static(sizeof(uint32_t) * max_elements));
+
+		if constexpr (std::is_trivially_copyable_v<TKey> && std::is_trivially_copyable_v<TValue>) {
+			void *destination = _elements;
+			const void *source = p_other._elements;
+			memcpy(destination, source, sizeof(MapKeyValue) * _size);
+		} else {
+			for (uint32_t i = 0; i < _size; i++) {
+				memnew_placement(&_elements[i], MapKeyValue(p_other._elements[i]));
+			}
+		}
+
+		memcpy(_hashes, p_other._hashes, sizeof(uint32_t) * _size);
+		memcpy(_ctrl, p_other._ctrl, capacity * (sizeof(uint8_t) + sizeof(uint32_t)));
+	}
+
+public:
+	/* Standard Godot Container API */
+
+	_FORCE_INLINE_ uint32_t get_capacity() const { return (_group_mask + 1) * GROUP_SIZE; }
+	_FORCE_INLINE_ uint32_t size() const { return _size; }
+
+	_FORCE_INLINE_ bool is_empty() const {
+		return _size == 0;
+	}
+
+	void clear() {
+		if (_elements == nullptr || _size == 0) {
+			return;
+		}
+
+		memset(_ctrl, SwissHashMapGroup::CTRL_EMPTY, get_capacity());
+		if constexpr (!(std::is_trivially_destructible_v<TKey> && std::is_trivially_destructible_v<TValue>)) {
+			for (uint32_t i = 0; i < _size; i++) {
+				_elements[i].key.~TKey();
+				_elements[i].value.~TValue();
+			}
+		}
+
+		_size = 0;
+	}
+
+	TValue &get(const TKey &p_key) {
+		uint32_t element_idx = 0;
+		bool exists = _lookup_idx(p_key, element_idx);
+		CRASH_COND_MSG(!exists, "SwissHashMap key not found.");
+		return _elements[element_idx].value;
+	}
+
+	const TValue &get(const TKey &p_key) const {
+		uint32_t element_idx = 0;
+		bool exists = _lookup_idx(p_key, element_idx);
+		CRASH_COND_MSG(!exists, "SwissHashMap key not found.");
+		return _elements[element_idx].value;
+	}
+
+	const TValue *getptr(const TKey &p_key) const {
+		uint32_t element_idx = 0;
+		if (_lookup_idx(p_key, element_idx)) {
+			return &_elements[element_idx].value;
+		}
+		return nullptr;
+	}
+
+	TValue *getptr(const TKey &p_key) {
+		uint32_t element_idx = 0;
+		if (_lookup_idx(p_key, element_idx)) {
+			return &_elements[element_idx].value;
+		}
+		return nullptr;
+	}
+
+	bool has(const TKey &p_key) const {
+		uint32_t element_idx = 0;
+		return _lookup_idx(p_key, element_idx);
+	}
+
+	bool erase(const TKey &p_key) {
+		if (unlikely(_elements == nullptr)) {
+			return false;
+		}
+
+		uint32_t slot = 0;
+		if (!_lookup_slot(p_key, Hasher::hash(p_key), slot)) {
+			return false;
+		}
+
+		uint32_t element_idx = _slots[slot];
+		_erase_slot(slot);
+
+		_elements[element_idx].key.~TKey();
+		_elements[element_idx].value.~TValue();
+		_size--;
+
+		if (element_idx < _size) {
+			// Fill the gap with the last element.
+			uint32_t moved_slot = _find_slot_of_element(_size);
+			memcpy((void *)&_elements[element_idx], (const void *)&_elements[_size], sizeof(MapKeyValue));
+			_hashes[element_idx] = _hashes[_size];
+			_slots[moved_slot] = element_idx;
+		}
+
+		return true;
+	}
+
+	// Replace the key of an entry in-place, without invalidating iterators or changing the entries position during iteration.
+	// p_old_key must exist in the map and p_new_key must not, unless it is equal to p_old_key.
+	bool replace_key(const TKey &p_old_key, const TKey &p_new_key) {
+		if (p_old_key == p_new_key) {
+			return true;
+		}
+		uint32_t slot = 0;
+		const uint32_t new_hash = Hasher::hash(p_new_key);
+		ERR_FAIL_COND_V(_lookup_slot(p_new_key, new_hash, slot), false);
+		ERR_FAIL_COND_V(!_lookup_slot(p_old_key, Hasher::hash(p_old_key), slot), false);
+
+		uint32_t element_idx = _slots[slot];
+		_erase_slot(slot);
+
+		const_cast<TKey &>(_elements[element_idx].key) = p_new_key;
+		_hashes[element_idx] = new_hash;
+		_insert_slot(new_hash, element_idx);
+
+		return true;
+	}
+
+	// Reserves space for a number of elements, useful to avoid many resizes and rehashes.
+	// Unlike in AHashMap, the load factor is taken into account, so that many elements can be added without rehashing.
+	void reserve(uint32_t p_new_capacity) {
+		uint32_t new_group_mask = _get_group_mask_for(p_new_capacity);
+		if (_elements == nullptr) {
+			_group_mask = MAX(_group_mask, new_group_mask);
+			return; // Unallocated yet.
+		}
+		if (new_group_mask <= _group_mask) {
+			if (p_new_capacity < size()) {
+				WARN_VERBOSE("reserve() called with a capacity smaller than the current size. This is likely a mistake.");
+			}
+			return;
+		}
+		_resize_and_rehash(new_group_mask);
+	}
+
+	/** Iterator API **/
+
+	struct ConstIterator {
+		_FORCE_INLINE_ const MapKeyValue &operator*() const {
+			return *pair;
+		}
+		_FORCE_INLINE_ const MapKeyValue *operator->() const {
+			return pair;
+		}
+		_FORCE_INLINE_ ConstIterator &operator++() {
+			pair++;
+			return *this;
+		}
+
+		_FORCE_INLINE_ ConstIterator &operator--() {
+			pair--;
+			if (pair < begin) {
+				pair = end;
+			}
+			return *this;
+		}
+
+		_FORCE_INLINE_ bool operator==(const ConstIterator &b) const { return pair == b.pair; }
+		_FORCE_INLINE_ bool operator!=(const ConstIterator &b) const { return pair != b.pair; }
+
+		_FORCE_INLINE_ explicit operator bool() const {
+			return pair != end;
+		}
+
+		_FORCE_INLINE_ ConstIterator(MapKeyValue *p_key, MapKeyValue *p_begin, MapKeyValue *p_end) {
+			pair = p_key;
+			begin = p_begin;
+			end = p_end;
+		}
+		_FORCE_INLINE_ ConstIterator() {}
+		_FORCE_INLINE_ ConstIterator(const ConstIterator &p_it) {
+			pair = p_it.pair;
+			begin = p_it.begin;
+			end = p_it.end;
+		}
+		_FORCE_INLINE_ void operator=(const ConstIterator &p_it) {
+			pair = p_it.pair;
+			begin = p_it.begin;
+			end = p_it.end;
+		}
+
+	private:
+		MapKeyValue *pair = nullptr;
+		MapKeyValue *begin = nullptr;
+		MapKeyValue *end = nullptr;
+	};
+
+	struct Iterator {
+		_FORCE_INLINE_ MapKeyValue &operator*() const {
+			return *pair;
+		}
+		_FORCE_INLINE_ MapKeyValue *operator->() const {
+			return pair;
+		}
+		_FORCE_INLINE_ Iterator &operator++() {
+			pair++;
+			return *this;
+		}
+		_FORCE_INLINE_ Iterator &operator--() {
+			pair--;
+			if (pair < begin) {
+				pair = end;
+			}
+			return *this;
+		}
+
+		_FORCE_INLINE_ bool operator==(const Iterator &b) const { return pair == b.pair; }
+		_FORCE_INLINE_ bool operator!=(const Iterator &b) const { return pair != b.pair; }
+
+		_FORCE_INLINE_ explicit operator bool() const {
+			return pair != end;
+		}
+
+		_FORCE_INLINE_ Iterator(MapKeyValue *p_key, MapKeyValue *p_begin, MapKeyValue *p_end) {
+			pair = p_key;
+			begin = p_begin;
+			end = p_end;
+		}
+		_FORCE_INLINE_ Iterator() {}
+		_FORCE_INLINE_ Iterator(const Iterator &p_it) {
+			pair = p_it.pair;
+			begin = p_it.begin;
+			end = p_it.end;
+		}
+		_FORCE_INLINE_ void operator=(const Iterator &p_it) {
+			pair = p_it.pair;
+			begin = p_it.begin;
+			end = p_it.end;
+		}
+
+		operator ConstIterator() const {
+			return ConstIterator(pair, begin, end);
+		}
+
+	private:
+		MapKeyValue *pair = nullptr;
+		MapKeyValue *begin = nullptr;
+		MapKeyValue *end = nullptr;
+	};
+
+	_FORCE_INLINE_ Iterator begin() {
+		return Iterator(_elements, _elements, _elements + _size);
+	}
+	_FORCE_INLINE_ Iterator end() {
+		return Iterator(_elements + _size, _elements, _elements + _size);
+	}
+	_FORCE_INLINE_ Iterator last() {
+		if (unlikely(_size == 0)) {
+			return Iterator(nullptr, nullptr, nullptr);
+		}
+		return Iterator(_elements + _size - 1, _elements, _elements + _size);
+	}
+
+	Iterator find(const TKey &p_key) {
+		uint32_t element_idx = 0;
+		if (!_lookup_idx(p_key, element_idx)) {
+			return end();
+		}
+		return Iterator(_elements + element_idx, _elements, _elements + _size);
+	}
+
+	void remove(const Iterator &p_iter) {
+		if (p_iter) {
+			erase(p_iter->key);
+		}
+	}
+
+	_FORCE_INLINE_ ConstIterator begin() const {
+		return ConstIterator(_elements, _elements, _elements + _size);
+	}
+	_FORCE_INLINE_ ConstIterator end() const {
+		return ConstIterator(_elements + _size, _elements, _elements + _size);
+	}
+	_FORCE_INLINE_ ConstIterator last() const {
+		if (unlikely(_size == 0)) {
+			return ConstIterator(nullptr, nullptr, nullptr);
+		}
+		return ConstIterator(_elements + _size - 1, _elements, _elements + _size);
+	}
+
+	ConstIterator find(const TKey &p_key) const {
+		uint32_t element_idx = 0;
+		if (!_lookup_idx(p_key, element_idx)) {
+			return end();
+		}
+		return ConstIterator(_elements + element_idx, _elements, _elements + _size);
+	}
+
+	/* Indexing */
+
+	const TValue &operator[](const TKey &p_key) const {
+		uint32_t element_idx = 0;
+		bool exists = _lookup_idx(p_key, element_idx);
+		CRASH_COND(!exists);
+		return _elements[element_idx].value;
+	}
+
+	TValue &operator[](const TKey &p_key) {
+		uint32_t slot = 0;
+		uint32_t hash = Hasher::hash(p_key);
+		if (_lookup_slot(p_key, hash, slot)) {
+			return _elements[_slots[slot]].value;
+		} else {
+			uint32_t element_idx = _insert_element(p_key, TValue(), hash);
+			return _elements[element_idx].value;
+		}
+	}
+
+	/* Insert */
+
+	Iterator insert(const TKey &p_key, const TValue &p_value) {
+		uint32_t slot = 0;
+		uint32_t element_idx = 0;
+		uint32_t hash = Hasher::hash(p_key);
+
+		if (!_lookup_slot(p_key, hash, slot)) {
+			element_idx = _insert_element(p_key, p_value, hash);
+		} else {
+			element_idx = _slots[slot];
+			_elements[element_idx].value = p_value;
+		}
+		return Iterator(_elements + element_idx, _elements, _elements + _size);
+	}
+
+	// Inserts an element without checking if it already exists.
+	Iterator insert_new(const TKey &p_key, const TValue &p_value) {
+		DEV_ASSERT(!has(p_key));
+		uint32_t hash = Hasher::hash(p_key);
+		uint32_t element_idx = _insert_element(p_key, p_value, hash);
+		return Iterator(_elements + element_idx, _elements, _elements + _size);
+	}
+
+	/* Array methods. */
+
+	// Unsafe. Changing keys and going outside the bounds of an array can lead to undefined behavior.
+	KeyValue<TKey, TValue> *get_elements_ptr() {
+		return _elements;
+	}
+
+	// Returns the element index. If not found, returns -1.
+	int get_index(const TKey &p_key) {
+		uint32_t element_idx = 0;
+		if (!_lookup_idx(p_key, element_idx)) {
+			return -1;
+		}
+		return element_idx;
+	}
+
+	KeyValue<TKey, TValue> &get_by_index(uint32_t p_index) {
+		CRASH_BAD_UNSIGNED_INDEX(p_index, _size);
+		return _elements[p_index];
+	}
+
+	bool erase_by_index(uint32_t p_index) {
+		if (p_index >= size()) {
+			return false;
+		}
+		return erase(_elements[p_index].key);
+	}
+
+	/* Constructors */
+
+	SwissHashMap(SwissHashMap &&p_other) {
+		_elements = p_other._elements;
+		_hashes = p_other._hashes;
+		_ctrl = p_other._ctrl;
+		_slots = p_other._slots;
+		_group_mask = p_other._group_mask;
+		_size = p_other._size;
+
+		p_other._elements = nullptr;
+		p_other._hashes = nullptr;
+		p_other._ctrl = nullptr;
+		p_other._slots = nullptr;
+		p_other._group_mask = INITIAL_CAPACITY / GROUP_SIZE - 1;
+		p_other._size = 0;
+	}
+
+	explicit SwissHashMap(const SwissHashMap &p_other) {
+		_init_from(p_other);
+	}
+
+	void operator=(const SwissHashMap &p_other) {
+		if (this == &p_other) {
+			return; // Ignore self assignment.
+		}
+
+		reset();
+
+		_init_from(p_other);
+	}
+
+	SwissHashMap(uint32_t p_initial_capacity) :
+			_group_mask(_get_group_mask_for(p_initial_capacity)) {
+	}
+	SwissHashMap() :
+			_group_mask(INITIAL_CAPACITY / GROUP_SIZE - 1) {
+	}
+
+	SwissHashMap(std::initializer_list<KeyValue<TKey, TValue>> p_init) :
+			_group_mask(_get_group_mask_for(p_init.size())) {
+		for (const KeyValue<TKey, TValue> &E : p_init) {
+			insert(E.key, E.value);
+		}
+	}
+
+	void reset() {
+		if (_elements != nullptr) {
+			if constexpr (!(std::is_trivially_destructible_v<TKey> && std::is_trivially_destructible_v<TValue>)) {
+				for (uint32_t i = 0; i < _size; i++) {
+					_elements[i].key.~TKey();
+					_elements[i].value.~TValue();
+				}
+			}
+			Memory::free_static(_elements);
+			Memory::free_static(_hashes);
+			Memory::free_static(_ctrl);
+			_elements = nullptr;
+			_hashes = nullptr;
+			_ctrl = nullptr;
+			_slots = nullptr;
+		}
+		_group_mask = INITIAL_CAPACITY / GROUP_SIZE - 1;
+		_size = 0;
+	}
+
+	~SwissHashMap() {
+		reset();
+	}
+};
+
+extern template class SwissHashMap<int, int>;
+extern template class SwissHashMap<String, int>;
+extern template class SwissHashMap<StringName, StringName>;
+extern template class SwissHashMap<StringName, Variant>;
+extern template class SwissHashMap<StringName, int>;
@@ -95,6 +95,10 @@ public:
 	_FORCE_INLINE_ operator Span<T>() const { return _cowdata.span(); }
 	_FORCE_INLINE_ Span<T> span() const { return _cowdata.span(); }
 
+	static constexpr size_t EXTERNAL_HEADER_SIZE = CowData<T>::EXTERNAL_HEADER_SIZE;
+	/// Uses elements stored elsewhere without copying them, until the first modification. See CowData::use_external().
+	_FORCE_INLINE_ Error use_external(T *p_data, Size p_size) { return _cowdata.use_external(p_data, p_size); }
+
 	_FORCE_INLINE_ void clear() { _cowdata.clear(); }
 	_FORCE_INLINE_ bool is_empty() const { return _cowdata.is_empty(); }
 
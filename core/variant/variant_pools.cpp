@@ -30,11 +30,13 @@
 
 #include "core/variant/variant_pools.h"
 
+#include "core/core_globals.h"
 #include "core/math/aabb.h"
 #include "core/math/projection.h"
 #include "core/math/transform_2d.h"
 #include "core/math/transform_3d.h"
-#include "core/templates/paged_allocator.h"
+#include "core/os/spin_lock.h"
+#include "core/string/ustring.h"
 
 namespace VariantPools {
 union BucketSmall {
@@ -64,9 +66,185 @@ static_assert(sizeof(BucketLarge) == VariantPools::BUCKET_LARGE);
 static_assert(alignof(BucketLarge) == alignof(real_t));
 } //namespace VariantPools
 
-static PagedAllocator<VariantPools::BucketSmall, true> _bucket_small;
-static PagedAllocator<VariantPools::BucketMedium, true> _bucket_medium;
-static PagedAllocator<VariantPools::BucketLarge, true> _bucket_large;
+// Allocates fixed size blocks for one bucket. Each thread keeps its own free
+// list, so allocating and freeing boxed math types normally takes no lock.
+// Threads exchange blocks with the shared free list in batches, taking the
+// spin lock once per batch. Blocks freed on a different thread than the one
+// that allocated them simply join the freeing thread's list.
+// Everything here is constant-initialized, so Variants may use the pools
+// during static initialization of other translation units.
+template <typename T>
+class BucketAllocator {
+	static constexpr uint32_t BATCH_SIZE = 32;
+	static constexpr uint32_t MAX_CACHED = BATCH_SIZE * 2;
+	static constexpr uint32_t BLOCKS_PER_PAGE = 256;
+
+	struct Block {
+		Block *next;
+	};
+	static_assert(sizeof(T) >= sizeof(Block) && sizeof(T) % alignof(Block) == 0);
+
+	// Trivially destructible, so it stays usable after ThreadCacheReleaser ran,
+	// e.g. for Variants destroyed during static destruction on the main thread.
+	enum ThreadCacheState : uint8_t {
+		CACHE_UNREGISTERED,
+		CACHE_ACTIVE,
+		CACHE_RELEASED,
+	};
+
+	struct ThreadCache {
+		Block *head = nullptr;
+		uint32_t count = 0;
+		ThreadCacheState state = CACHE_UNREGISTERED;
+	};
+
+	struct ThreadCacheReleaser {
+		BucketAllocator *allocator = nullptr;
+		~ThreadCacheReleaser() {
+			if (allocator) {
+				allocator->_release_thread_cache();
+			}
+		}
+	};
+
+	static thread_local ThreadCache cache;
+	static thread_local ThreadCacheReleaser releaser;
+
+	SpinLock spin_lock;
+	Block *free_list = nullptr;
+	uint32_t free_count = 0;
+	uint32_t total_count = 0;
+	// The first block of every page links to the previous page.
+	Block *pages = nullptr;
+
+	void _add_page() {
+		Block *page = (Block *)memalloc(sizeof(T) * BLOCKS_PER_PAGE);
+		page->next = pages;
+		pages = page;
+		for (uint32_t i = 1; i < BLOCKS_PER_PAGE; i++) {
+			Block *block = (Block *)((uint8_t *)page + sizeof(T) * i);
+			block->next = free_list;
+			free_list = block;
+		}
+		free_count += BLOCKS_PER_PAGE - 1;
+		total_count += BLOCKS_PER_PAGE - 1;
+	}
+
+	void _register_thread_cache(ThreadCache &p_cache) {
+		// Constructs the releaser for this thread, so the cache is given back when the thread exits.
+		releaser.allocator = this;
+		p_cache.state = CACHE_ACTIVE;
+	}
+
+	_NO_INLINE_ void _refill(ThreadCache &p_cache) {
+		uint32_t count = BATCH_SIZE;
+		if (unlikely(p_cache.state == CACHE_RELEASED)) {
+			// The thread is exiting, don't cache anything anymore.
+			count = 1;
+		} else if (p_cache.state == CACHE_UNREGISTERED) {
+			_register_thread_cache(p_cache);
+		}
+
+		spin_lock.lock();
+		for (uint32_t i = 0; i < count; i++) {
+			if (!free_list) {
+				_add_page();
+			}
+			Block *block = free_list;
+			free_list = block->next;
+			block->next = p_cache.head;
+			p_cache.head = block;
+		}
+		free_count -= count;
+		spin_lock.unlock();
+
+		p_cache.count += count;
+	}
+
+	_NO_INLINE_ void _free_slow(ThreadCache &p_cache) {
+		if (p_cache.state == CACHE_RELEASED) {
+			_release(p_cache, p_cache.count);
+			return;
+		}
+		if (p_cache.state == CACHE_UNREGISTERED) {
+			_register_thread_cache(p_cache);
+		}
+		if (p_cache.count > MAX_CACHED) {
+			_release(p_cache, BATCH_SIZE);
+		}
+	}
+
+	void _release(ThreadCache &p_cache, uint32_t p_count) {
+		Block *first = p_cache.head;
+		Block *last = first;
+		for (uint32_t i = 1; i < p_count; i++) {
+			last = last->next;
+		}
+		p_cache.head = last->next;
+		p_cache.count -= p_count;
+
+		spin_lock.lock();
+		last->next = free_list;
+		free_list = first;
+		free_count += p_count;
+		spin_lock.unlock();
+	}
+
+	void _release_thread_cache() {
+		ThreadCache &c = cache;
+		if (c.count) {
+			_release(c, c.count);
+		}
+		c.state = CACHE_RELEASED;
+	}
+
+public:
+	_FORCE_INLINE_ void *alloc() {
+		ThreadCache &c = cache;
+		if (unlikely(!c.head)) {
+			_refill(c);
+		}
+		Block *block = c.head;
+		c.head = block->next;
+		c.count--;
+		return block;
+	}
+
+	_FORCE_INLINE_ void free(void *p_ptr) {
+		ThreadCache &c = cache;
+		Block *block = static_cast<Block *>(p_ptr);
+		block->next = c.head;
+		c.head = block;
+		c.count++;
+		if (unlikely(c.count > MAX_CACHED || c.state != CACHE_ACTIVE)) {
+			_free_slow(c);
+		}
+	}
+
+	~BucketAllocator() {
+		// Thread caches are released before static destruction, for all threads that exited properly.
+		if (free_count != total_count) {
+			if (CoreGlobals::leak_reporting_enabled) {
+				ERR_PRINT("Blocks in use exist at exit in Variant pool of " + itos(sizeof(T)) + " bytes: " + itos(total_count - free_count) + ".");
+			}
+			return;
+		}
+		while (pages) {
+			Block *page = pages;
+			pages = page->next;
+			memfree(page);
+		}
+	}
+};
+
+template <typename T>
+thread_local typename BucketAllocator<T>::ThreadCache BucketAllocator<T>::cache;
+template <typename T>
+thread_local typename BucketAllocator<T>::ThreadCacheReleaser BucketAllocator<T>::releaser;
+
+static BucketAllocator<VariantPools::BucketSmall> _bucket_small;
+static BucketAllocator<VariantPools::BucketMedium> _bucket_medium;
+static BucketAllocator<VariantPools::BucketLarge> _bucket_large;
 
 void *VariantPools::alloc_small() {
 	return _bucket_small.alloc();
@@ -81,13 +259,13 @@ void *VariantPools::alloc_large() {
 }
 
 void VariantPools::free_small(void *p_ptr) {
-	_bucket_small.free(static_cast<BucketSmall *>(p_ptr));
+	_bucket_small.free(p_ptr);
 }
 
 void VariantPools::free_medium(void *p_ptr) {
-	_bucket_medium.free(static_cast<BucketMedium *>(p_ptr));
+	_bucket_medium.free(p_ptr);
 }
 
 void VariantPools::free_large(void *p_ptr) {
-	_bucket_large.free(static_cast<BucketLarge *>(p_ptr));
+	_bucket_large.free(p_ptr);
 }
@@ -0,0 +1,273 @@
+/**************************************************************************/
+/*  async_file_reader_io_uring.cpp                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "async_file_reader_io_uring.h"
+
+#if defined(UNIX_ENABLED) && defined(__linux__) && defined(THREADS_ENABLED)
+
+#include "core/os/os.h"
+
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+
+static int _io_uring_enter(int p_ring_fd, uint32_t p_to_submit, uint32_t p_min_complete, uint32_t p_flags) {
+	int ret;
+	do {
+		ret = (int)syscall(__NR_io_uring_enter, p_ring_fd, p_to_submit, p_min_complete, p_flags, nullptr, 0);
+	} while (ret < 0 && errno == EINTR);
+	return ret;
+}
+
+bool AsyncFileReaderIOUring::_setup() {
+	io_uring_params params = {};
+	ring_fd = (int)syscall(__NR_io_uring_setup, QUEUE_DEPTH, &params);
+	if (ring_fd < 0) {
+		print_verbose(vformat("io_uring is unavailable (%s), reading files asynchronously with threads.", strerror(errno)));
+		return false;
+	}
+
+	sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+	cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+	const bool single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+	if (single_mmap) {
+		sq_ring_size = MAX(sq_ring_size, cq_ring_size);
+		cq_ring_size = sq_ring_size;
+	}
+
+	sq_ring = mmap(nullptr, sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_SQ_RING);
+	if (sq_ring == MAP_FAILED) {
+		sq_ring = nullptr;
+		return false;
+	}
+	if (single_mmap) {
+		cq_ring = sq_ring;
+	} else {
+		cq_ring = mmap(nullptr, cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_CQ_RING);
+		if (cq_ring == MAP_FAILED) {
+			cq_ring = nullptr;
+			return false;
+		}
+	}
+	sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+	void *sqes_ptr = mmap(nullptr, sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_SQES);
+	if (sqes_ptr == MAP_FAILED) {
+		return false;
+	}
+	sqes = (io_uring_sqe *)sqes_ptr;
+
+	uint8_t *sq = (uint8_t *)sq_ring;
+	sq_head = (uint32_t *)(sq + params.sq_off.head);
+	sq_tail = (uint32_t *)(sq + params.sq_off.tail);
+	sq_mask = *(uint32_t *)(sq + params.sq_off.ring_mask);
+	sq_array = (uint32_t *)(sq + params.sq_off.array);
+	sq_entries = params.sq_entries;
+
+	uint8_t *cq = (uint8_t *)cq_ring;
+	cq_head = (uint32_t *)(cq + params.cq_off.head);
+	cq_tail = (uint32_t *)(cq + params.cq_off.tail);
+	cq_mask = *(uint32_t *)(cq + params.cq_off.ring_mask);
+	cqes = (io_uring_cqe *)(cq + params.cq_off.cqes);
+
+	return true;
+}
+
+void AsyncFileReaderIOUring::_teardown() {
+	if (sqes) {
+		munmap(sqes, sqes_size);
+		sqes = nullptr;
+	}
+	if (cq_ring && cq_ring != sq_ring) {
+		munmap(cq_ring, cq_ring_size);
+	}
+	cq_ring = nullptr;
+	if (sq_ring) {
+		munmap(sq_ring, sq_ring_size);
+		sq_ring = nullptr;
+	}
+	if (ring_fd >= 0) {
+		close(ring_fd);
+		ring_fd = -1;
+	}
+}
+
+// Queues a read of what's left of the request, or a no-op to stop the completion thread if it's null.
+// The submit mutex must be locked.
+bool AsyncFileReaderIOUring::_push(Request *p_request) {
+	// Completions can't overflow, the completion queue is larger than the submission queue.
+	const uint32_t tail = *sq_tail;
+	if (in_flight >= sq_entries || tail - __atomic_load_n(sq_head, __ATOMIC_ACQUIRE) >= sq_entries) {
+		return false;
+	}
+
+	const uint32_t index = tail & sq_mask;
+	io_uring_sqe *sqe = &sqes[index];
+	memset(sqe, 0, sizeof(io_uring_sqe));
+	if (p_request) {
+		sqe->opcode = IORING_OP_READ;
+		sqe->fd = p_request->fd;
+		sqe->off = p_request->fd_offset + p_request->position + p_request->read;
+		sqe->addr = (uint64_t)(uintptr_t)(p_request->dst + p_request->read);
+		sqe->len = (uint32_t)MIN(p_request->length - p_request->read, (uint64_t)MAX_READ_SIZE);
+		sqe->user_data = (uint64_t)(uintptr_t)p_request;
+	} else {
+		sqe->opcode = IORING_OP_NOP;
+		sqe->user_data = 0;
+	}
+	sq_array[index] = index;
+	__atomic_store_n(sq_tail, tail + 1, __ATOMIC_RELEASE);
+
+	if (_io_uring_enter(ring_fd, 1, 0, 0) < 0) {
+		// Nothing was submitted, so take the entry back and let the caller read some other way.
+		ERR_PRINT(vformat("Can't submit to io_uring: %s.", strerror(errno)));
+		__atomic_store_n(sq_tail, tail, __ATOMIC_RELEASE);
+		return false;
+	}
+	in_flight++;
+	return true;
+}
+
+// Synchronous fallback, when a short read can't be queued again.
+void AsyncFileReaderIOUring::_read_remaining(Request *p_request) {
+	while (p_request->read < p_request->length) {
+		const ssize_t ret = pread(p_request->fd, p_request->dst + p_request->read, MIN(p_request->length - p_request->read, (uint64_t)MAX_READ_SIZE), p_request->fd_offset + p_request->position + p_request->read);
+		if (ret < 0 && errno == EINTR) {
+			continue;
+		}
+		if (ret <= 0) {
+			_complete(p_request, ERR_FILE_CANT_READ);
+			return;
+		}
+		p_request->read += ret;
+	}
+	_complete(p_request, OK);
+}
+
+void AsyncFileReaderIOUring::_handle_completion(Request *p_request, int p_result) {
+	if (p_result > 0) {
+		p_request->read += p_result;
+		if (p_request->read >= p_request->length) {
+			_complete(p_request, OK);
+			return;
+		}
+	} else if (p_result != -EINTR && p_result != -EAGAIN) {
+		// The length is clamped to the end of the file, so reaching it is an error too.
+		_complete(p_request, ERR_FILE_CANT_READ);
+		return;
+	}
+
+	// Short or interrupted read, queue the rest.
+	{
+		MutexLock lock(submit_mutex);
+		if (_push(p_request)) {
+			return;
+		}
+	}
+	_read_remaining(p_request);
+}
+
+void AsyncFileReaderIOUring::_completion_thread_function(void *p_self) {
+	AsyncFileReaderIOUring *self = (AsyncFileReaderIOUring *)p_self;
+
+	bool exiting = false;
+	while (!exiting) {
+		if (_io_uring_enter(self->ring_fd, 0, 1, IORING_ENTER_GETEVENTS) < 0) {
+			ERR_PRINT(vformat("Can't wait for io_uring completions: %s.", strerror(errno)));
+			break;
+		}
+
+		uint32_t head = *self->cq_head;
+		const uint32_t tail = __atomic_load_n(self->cq_tail, __ATOMIC_ACQUIRE);
+		while (head != tail) {
+			const io_uring_cqe &cqe = self->cqes[head & self->cq_mask];
+			Request *request = (Request *)(uintptr_t)cqe.user_data;
+			const int result = cqe.res;
+
+			// Give the entry back before handling it, handling may queue more.
+			head++;
+			__atomic_store_n(self->cq_head, head, __ATOMIC_RELEASE);
+			{
+				MutexLock lock(self->submit_mutex);
+				self->in_flight--;
+			}
+
+			if (request) {
+				self->_handle_completion(request, result);
+			} else {
+				exiting = true;
+			}
+		}
+	}
+	self->completion_thread_exited.set();
+}
+
+bool AsyncFileReaderIOUring::_submit_native(Request *p_request) {
+	if (ring_fd < 0) {
+		return false;
+	}
+	MutexLock lock(submit_mutex);
+	return _push(p_request);
+}
+
+AsyncFileReaderIOUring::AsyncFileReaderIOUring() {
+	if (!_setup()) {
+		_teardown();
+		return;
+	}
+	completion_thread.start(&AsyncFileReaderIOUring::_completion_thread_function, this);
+}
+
+AsyncFileReaderIOUring::~AsyncFileReaderIOUring() {
+	if (ring_fd < 0) {
+		return;
+	}
+
+	_wait_for_pending_reads();
+
+	// The completion thread must be gone before the ring is unmapped. Keep trying to wake it up,
+	// unless it already stopped on its own because the ring failed.
+	while (!completion_thread_exited.is_set()) {
+		{
+			MutexLock lock(submit_mutex);
+			if (_push(nullptr)) {
+				break;
+			}
+		}
+		OS::get_singleton()->delay_usec(1000);
+	}
+	completion_thread.wait_to_finish();
+	_teardown();
+}
+
+#endif // UNIX_ENABLED && __linux__ && THREADS_ENABLED
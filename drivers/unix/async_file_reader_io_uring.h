@@ -0,0 +1,86 @@
+/**************************************************************************/
+/*  async_file_reader_io_uring.h                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#if defined(UNIX_ENABLED) && defined(__linux__) && defined(THREADS_ENABLED)
+
+#include "core/io/async_file_reader.h"
+#include "core/templates/safe_refcount.h"
+
+struct io_uring_sqe;
+struct io_uring_cqe;
+
+// Reads files through io_uring, a single thread waits for all the completions.
+// Falls back to the I/O threads when io_uring is unavailable (e.g. kernels older than 5.6, or seccomp filters), or the ring is full.
+class AsyncFileReaderIOUring : public AsyncFileReader {
+	static constexpr uint32_t QUEUE_DEPTH = 256;
+	static constexpr uint32_t MAX_READ_SIZE = 1 << 30;
+
+	int ring_fd = -1;
+
+	void *sq_ring = nullptr;
+	size_t sq_ring_size = 0;
+	uint32_t *sq_head = nullptr;
+	uint32_t *sq_tail = nullptr;
+	uint32_t sq_mask = 0;
+	uint32_t sq_entries = 0;
+	uint32_t *sq_array = nullptr;
+	io_uring_sqe *sqes = nullptr;
+	size_t sqes_size = 0;
+
+	void *cq_ring = nullptr;
+	size_t cq_ring_size = 0;
+	uint32_t *cq_head = nullptr;
+	uint32_t *cq_tail = nullptr;
+	uint32_t cq_mask = 0;
+	io_uring_cqe *cqes = nullptr;
+
+	BinaryMutex submit_mutex;
+	uint32_t in_flight = 0;
+	Thread completion_thread;
+	SafeFlag completion_thread_exited;
+
+	bool _setup();
+	void _teardown();
+	bool _push(Request *p_request);
+	void _read_remaining(Request *p_request);
+	void _handle_completion(Request *p_request, int p_result);
+	static void _completion_thread_function(void *p_self);
+
+protected:
+	virtual bool _submit_native(Request *p_request) override;
+
+public:
+	AsyncFileReaderIOUring();
+	virtual ~AsyncFileReaderIOUring();
+};
+
+#endif // UNIX_ENABLED && __linux__ && THREADS_ENABLED
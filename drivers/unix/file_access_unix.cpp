@@ -308,6 +308,39 @@ uint64_t FileAccessUnix::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
 	return read;
 }
 
+uint64_t FileAccessUnix::get_buffer_at(uint8_t *p_dst, uint64_t p_position, uint64_t p_length) const {
+	ERR_FAIL_NULL_V_MSG(f, -1, "File must be opened before use.");
+	ERR_FAIL_COND_V(!p_dst && p_length > 0, -1);
+
+	if (flags != READ) {
+		// Buffered writes have to be seen.
+		return FileAccess::get_buffer_at(p_dst, p_position, p_length);
+	}
+
+	// Doesn't use the stream, so it's safe from any thread.
+	const int fd = fileno(f);
+	uint64_t read = 0;
+	while (read < p_length) {
+		const ssize_t ret = pread(fd, p_dst + read, p_length - read, p_position + read);
+		if (ret < 0 && errno == EINTR) {
+			continue;
+		}
+		if (ret <= 0) {
+			break;
+		}
+		read += ret;
+	}
+	return read;
+}
+
+int FileAccessUnix::get_native_fd(uint64_t &r_base_offset) const {
+	if (!f || flags != READ) {
+		return -1;
+	}
+	r_base_offset = 0;
+	return fileno(f);
+}
+
 Error FileAccessUnix::get_error() const {
 	return last_error;
 }
@@ -70,6 +70,9 @@ public:
 	virtual bool eof_reached() const override; ///< reading passed EOF
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override;
+	virtual uint64_t get_buffer_at(uint8_t *p_dst, uint64_t p_position, uint64_t p_length) const override;
+	virtual bool has_thread_safe_reads() const override { return f && flags == READ; }
+	virtual int get_native_fd(uint64_t &r_base_offset) const override;
 
 	virtual Error get_error() const override; ///< get last error
 
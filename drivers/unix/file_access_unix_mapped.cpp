@@ -0,0 +1,143 @@
+/**************************************************************************/
+/*  file_access_unix_mapped.cpp                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "file_access_unix_mapped.h"
+
+#if defined(UNIX_ENABLED)
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+
+Error FileAccessUnixMapped::_map(const String &p_path, uint64_t p_offset, int64_t p_length, bool p_copy_on_write) {
+	int fd = ::open(p_path.utf8().get_data(), O_RDONLY | O_CLOEXEC);
+	if (fd < 0) {
+		switch (errno) {
+			case ENOENT:
+				return ERR_FILE_NOT_FOUND;
+			case EACCES:
+				return ERR_FILE_NO_PERMISSION;
+			default:
+				return ERR_FILE_CANT_OPEN;
+		}
+	}
+
+	struct stat st = {};
+	if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+		::close(fd);
+		return ERR_FILE_CANT_OPEN;
+	}
+
+	const uint64_t file_size = st.st_size;
+	const uint64_t size = p_length < 0 ? (p_offset < file_size ? file_size - p_offset : 0) : (uint64_t)p_length;
+	if (p_offset > file_size || size > file_size - p_offset) {
+		::close(fd);
+		ERR_FAIL_V_MSG(ERR_INVALID_PARAMETER, vformat("Can't map %d bytes from offset %d of \"%s\", the file is only %d bytes long.", size, p_offset, p_path, file_size));
+	}
+
+	if (size == 0) {
+		// Nothing to map, but it's still a valid (empty) file.
+		::close(fd);
+		data = nullptr;
+		length = 0;
+		return OK;
+	}
+
+	const uint64_t page_size = sysconf(_SC_PAGESIZE);
+	const uint64_t map_offset = p_offset - p_offset % page_size;
+	const uint64_t total_size = size + (p_offset - map_offset);
+	if (total_size > SIZE_MAX) {
+		// Doesn't fit in the address space.
+		::close(fd);
+		return ERR_OUT_OF_MEMORY;
+	}
+
+	// Private mappings only copy the pages which are written to.
+	void *address = mmap(nullptr, total_size, p_copy_on_write ? PROT_READ | PROT_WRITE : PROT_READ, MAP_PRIVATE, fd, map_offset);
+	// The mapping stays valid after closing the descriptor.
+	::close(fd);
+	if (address == MAP_FAILED) {
+		return ERR_OUT_OF_MEMORY;
+	}
+
+	map_address = address;
+	map_size = total_size;
+	data = (const uint8_t *)address + (p_offset - map_offset);
+	length = size;
+	return OK;
+}
+
+void FileAccessUnixMapped::_unmap() {
+	if (map_address) {
+		munmap(map_address, map_size);
+		map_address = nullptr;
+		map_size = 0;
+	}
+}
+
+void FileAccessUnixMapped::_madvise(uint64_t p_offset, uint64_t p_length, int p_advice) {
+	if (!map_address || p_offset >= length) {
+		return;
+	}
+
+	// madvise() requires a page aligned address.
+	const uint64_t page_size = sysconf(_SC_PAGESIZE);
+	const uint64_t start = (data - (const uint8_t *)map_address) + p_offset;
+	const uint64_t aligned_start = start - start % page_size;
+	const uint64_t end = MIN(start + p_length, (uint64_t)map_size);
+	madvise((uint8_t *)map_address + aligned_start, end - aligned_start, p_advice);
+}
+
+void FileAccessUnixMapped::set_access_hint(AccessHint p_hint) {
+	switch (p_hint) {
+		case ACCESS_HINT_NORMAL: {
+			_madvise(0, length, MADV_NORMAL);
+		} break;
+		case ACCESS_HINT_SEQUENTIAL: {
+			_madvise(0, length, MADV_SEQUENTIAL);
+		} break;
+		case ACCESS_HINT_RANDOM: {
+			_madvise(0, length, MADV_RANDOM);
+		} break;
+	}
+}
+
+void FileAccessUnixMapped::prefetch(uint64_t p_offset, uint64_t p_length) {
+	_madvise(p_offset, p_length, MADV_WILLNEED);
+}
+
+FileAccessUnixMapped::~FileAccessUnixMapped() {
+	close();
+}
+
+#endif // UNIX_ENABLED
@@ -0,0 +1,58 @@
+/**************************************************************************/
+/*  file_access_unix_mapped.h                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#if defined(UNIX_ENABLED)
+
+#include "core/io/file_access_mapped.h"
+
+class FileAccessUnixMapped : public FileAccessMapped {
+	GDSOFTCLASS(FileAccessUnixMapped, FileAccessMapped);
+
+	// The mapping starts at a page boundary, before the requested range.
+	void *map_address = nullptr;
+	size_t map_size = 0;
+
+	void _madvise(uint64_t p_offset, uint64_t p_length, int p_advice);
+
+protected:
+	virtual Error _map(const String &p_path, uint64_t p_offset, int64_t p_length, bool p_copy_on_write) override;
+	virtual void _unmap() override;
+
+public:
+	virtual void set_access_hint(AccessHint p_hint) override;
+	virtual void prefetch(uint64_t p_offset, uint64_t p_length) override;
+
+	FileAccessUnixMapped() {}
+	virtual ~FileAccessUnixMapped();
+};
+
+#endif // UNIX_ENABLED
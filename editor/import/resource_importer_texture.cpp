@@ -33,6 +33,7 @@
 #include "core/config/project_settings.h"
 #include "core/io/config_file.h"
 #include "core/io/image_loader.h"
+#include "core/object/worker_thread_pool.h"
 #include "editor/file_system/editor_file_system.h"
 #include "editor/import/resource_importer_texture_settings.h"
 #include "editor/settings/editor_settings.h"
@@ -269,83 +270,148 @@ void ResourceImporterTexture::get_import_options(const String &p_path, List<Impo
 	}
 }
 
-void ResourceImporterTexture::save_to_ctex_format(Ref<FileAccess> f, const Ref<Image> &p_image, CompressMode p_compress_mode, Image::UsedChannels p_channels, Image::CompressMode p_compress_format, float p_lossy_quality, const Image::BasisUniversalPackerParams &p_basisu_params) {
+// Packs the mipmaps of a lossless or lossy texture, in parallel unless called from a thread of the pool.
+// Each mipmap goes to its own buffer, so the result doesn't depend on the number of threads.
+template <typename F>
+static void _pack_mipmaps(LocalVector<Vector<uint8_t>> &r_data, const Ref<Image> &p_image, const F &p_packer) {
+	struct PackMipmaps {
+		const Ref<Image> *image = nullptr;
+		const F *packer = nullptr;
+		Vector<uint8_t> *data = nullptr;
+
+		static void pack(void *p_userdata, uint32_t p_mipmap) {
+			const PackMipmaps *job = static_cast<const PackMipmaps *>(p_userdata);
+			const Ref<Image> &image = *job->image;
+			job->data[p_mipmap] = (*job->packer)(p_mipmap ? image->get_image_from_mipmap(p_mipmap) : image);
+		}
+	};
+
+	const uint32_t mipmap_count = p_image->get_mipmap_count() + 1;
+	r_data.resize(mipmap_count);
+
+	PackMipmaps job;
+	job.image = &p_image;
+	job.packer = &p_packer;
+	job.data = r_data.ptr();
+
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	if (mipmap_count < 2 || pool == nullptr || pool->get_thread_count() < 2 || pool->get_thread_index() != -1) {
+		for (uint32_t i = 0; i < mipmap_count; i++) {
+			PackMipmaps::pack(&job, i);
+		}
+		return;
+	}
+
+	WorkerThreadPool::GroupID group_task = pool->add_native_group_task(&PackMipmaps::pack, &job, mipmap_count, -1, true, SNAME("Pack texture mipmaps"));
+	pool->wait_for_group_task_completion(group_task);
+}
+
+void ResourceImporterTexture::_encode_ctex_format(EncodedImage &r_encoded, const Ref<Image> &p_image, CompressMode p_compress_mode, Image::UsedChannels p_channels, Image::CompressMode p_compress_format, float p_lossy_quality, const Image::BasisUniversalPackerParams &p_basisu_params) {
+	r_encoded.width = p_image->get_width();
+	r_encoded.height = p_image->get_height();
+	r_encoded.mipmap_count = p_image->get_mipmap_count();
+	r_encoded.format = p_image->get_format();
+
 	switch (p_compress_mode) {
 		case COMPRESS_LOSSLESS: {
 			bool lossless_force_png = GLOBAL_GET("rendering/textures/lossless_compression/force_png") || !Image::_webp_mem_loader_func; // WebP module disabled or png is forced.
 			bool use_webp = !lossless_force_png && p_image->get_width() <= 16383 && p_image->get_height() <= 16383; // WebP has a size limit.
 
-			f->store_32(use_webp ? CompressedTexture2D::DATA_FORMAT_WEBP : CompressedTexture2D::DATA_FORMAT_PNG);
-			f->store_16(p_image->get_width());
-			f->store_16(p_image->get_height());
-			f->store_32(p_image->get_mipmap_count());
-			f->store_32(p_image->get_format());
-
-			for (int i = 0; i < p_image->get_mipmap_count() + 1; i++) {
-				Vector<uint8_t> data;
-				if (use_webp) {
-					data = Image::webp_lossless_packer(i ? p_image->get_image_from_mipmap(i) : p_image);
-				} else {
-					data = Image::png_packer(i ? p_image->get_image_from_mipmap(i) : p_image);
-				}
-
-				const uint64_t data_size = data.size();
-
-				f->store_32(data_size);
-				f->store_buffer(data.ptr(), data_size);
-			}
+			r_encoded.data_format = use_webp ? CompressedTexture2D::DATA_FORMAT_WEBP : CompressedTexture2D::DATA_FORMAT_PNG;
+			_pack_mipmaps(r_encoded.data, p_image, [use_webp](const Ref<Image> &p_mipmap) {
+				return use_webp ? Image::webp_lossless_packer(p_mipmap) : Image::png_packer(p_mipmap);
+			});
 
 		} break;
 		case COMPRESS_LOSSY: {
-			f->store_32(CompressedTexture2D::DATA_FORMAT_WEBP);
-			f->store_16(p_image->get_width());
-			f->store_16(p_image->get_height());
-			f->store_32(p_image->get_mipmap_count());
-			f->store_32(p_image->get_format());
-
-			for (int i = 0; i < p_image->get_mipmap_count() + 1; i++) {
-				Vector<uint8_t> data = Image::webp_lossy_packer(i ? p_image->get_image_from_mipmap(i) : p_image, p_lossy_quality);
-				const uint64_t data_size = data.size();
-
-				f->store_32(data_size);
-				f->store_buffer(data.ptr(), data_size);
-			}
+			r_encoded.data_format = CompressedTexture2D::DATA_FORMAT_WEBP;
+			_pack_mipmaps(r_encoded.data, p_image, [p_lossy_quality](const Ref<Image> &p_mipmap) {
+				return Image::webp_lossy_packer(p_mipmap, p_lossy_quality);
+			});
 
 		} break;
 		case COMPRESS_VRAM_COMPRESSED: {
 			Ref<Image> image = p_image->duplicate();
 			image->compress_from_channels(p_compress_format, p_channels);
 
-			f->store_32(CompressedTexture2D::DATA_FORMAT_IMAGE);
-			f->store_16(image->get_width());
-			f->store_16(image->get_height());
-			f->store_32(image->get_mipmap_count());
-			f->store_32(image->get_format());
-			f->store_buffer(image->get_data());
+			r_encoded.data_format = CompressedTexture2D::DATA_FORMAT_IMAGE;
+			r_encoded.width = image->get_width();
+			r_encoded.height = image->get_height();
+			r_encoded.mipmap_count = image->get_mipmap_count();
+			r_encoded.format = image->get_format();
+			r_encoded.data.push_back(image->get_data());
 
 		} break;
 		case COMPRESS_VRAM_UNCOMPRESSED: {
-			f->store_32(CompressedTexture2D::DATA_FORMAT_IMAGE);
-			f->store_16(p_image->get_width());
-			f->store_16(p_image->get_height());
-			f->store_32(p_image->get_mipmap_count());
-			f->store_32(p_image->get_format());
-			f->store_buffer(p_image->get_data());
+			r_encoded.data_format = CompressedTexture2D::DATA_FORMAT_IMAGE;
+			r_encoded.data.push_back(p_image->get_data());
 
 		} break;
 		case COMPRESS_BASIS_UNIVERSAL: {
-			f->store_32(CompressedTexture2D::DATA_FORMAT_BASIS_UNIVERSAL);
-			f->store_16(p_image->get_width());
-			f->store_16(p_image->get_height());
-			f->store_32(p_image->get_mipmap_count());
-			f->store_32(p_image->get_format());
+			r_encoded.data_format = CompressedTexture2D::DATA_FORMAT_BASIS_UNIVERSAL;
+			r_encoded.data.push_back(Image::basis_universal_packer(p_image, p_channels, p_basisu_params));
+		} break;
+	}
+}
+
+void ResourceImporterTexture::_store_ctex_format(Ref<FileAccess> f, const EncodedImage &p_encoded) {
+	f->store_32(p_encoded.data_format);
+	f->store_16(p_encoded.width);
+	f->store_16(p_encoded.height);
+	f->store_32(p_encoded.mipmap_count);
+	f->store_32(p_encoded.format);
 
-			Vector<uint8_t> data = Image::basis_universal_packer(p_image, p_channels, p_basisu_params);
+	for (const Vector<uint8_t> &data : p_encoded.data) {
+		if (p_encoded.data_format == CompressedTexture2D::DATA_FORMAT_IMAGE) {
+			f->store_buffer(data);
+		} else {
 			const uint64_t data_size = data.size();
 
 			f->store_32(data_size);
 			f->store_buffer(data.ptr(), data_size);
-		} break;
+		}
+	}
+}
+
+void ResourceImporterTexture::save_to_ctex_format(Ref<FileAccess> f, const Ref<Image> &p_image, CompressMode p_compress_mode, Image::UsedChannels p_channels, Image::CompressMode p_compress_format, float p_lossy_quality, const Image::BasisUniversalPackerParams &p_basisu_params) {
+	EncodedImage encoded;
+	_encode_ctex_format(encoded, p_image, p_compress_mode, p_channels, p_compress_format, p_lossy_quality, p_basisu_params);
+	_store_ctex_format(f, encoded);
+}
+
+void ResourceImporterTexture::EncodeImagesJob::encode_image(void *p_userdata, uint32_t p_index) {
+	const EncodeImagesJob *job = static_cast<const EncodeImagesJob *>(p_userdata);
+	_encode_ctex_format(job->encoded[p_index], job->images[p_index], job->compress_mode, job->channels, job->compress_format, job->lossy_quality, *job->basisu_params);
+}
+
+void ResourceImporterTexture::save_images_to_ctex_format(Ref<FileAccess> f, const Vector<Ref<Image>> &p_images, CompressMode p_compress_mode, Image::UsedChannels p_channels, Image::CompressMode p_compress_format, float p_lossy_quality, const Image::BasisUniversalPackerParams &p_basisu_params) {
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	// Basis Universal already uses all the cores for each image.
+	if (p_images.size() < 2 || p_compress_mode == COMPRESS_BASIS_UNIVERSAL || pool == nullptr || pool->get_thread_count() < 2 || pool->get_thread_index() != -1) {
+		for (const Ref<Image> &image : p_images) {
+			save_to_ctex_format(f, image, p_compress_mode, p_channels, p_compress_format, p_lossy_quality, p_basisu_params);
+		}
+		return;
+	}
+
+	// Each image is compressed by a thread of the pool, which compresses it alone.
+	LocalVector<EncodedImage> encoded;
+	encoded.resize(p_images.size());
+
+	EncodeImagesJob job;
+	job.images = p_images.ptr();
+	job.encoded = encoded.ptr();
+	job.compress_mode = p_compress_mode;
+	job.channels = p_channels;
+	job.compress_format = p_compress_format;
+	job.lossy_quality = p_lossy_quality;
+	job.basisu_params = &p_basisu_params;
+
+	WorkerThreadPool::GroupID group_task = pool->add_native_group_task(&EncodeImagesJob::encode_image, &job, p_images.size(), -1, true, SNAME("Compress texture layers"));
+	pool->wait_for_group_task_completion(group_task);
+
+	for (const EncodedImage &encoded_image : encoded) {
+		_store_ctex_format(f, encoded_image);
 	}
 }
 
@@ -94,8 +94,36 @@ protected:
 	static inline void _clamp_hdr_exposure(Ref<Image> &r_image);
 	static inline void _invert_y_channel(Ref<Image> &r_image);
 
+	// An image compressed in one of the data formats of CompressedTexture2D, ready to be stored.
+	struct EncodedImage {
+		uint32_t data_format = 0;
+		int width = 0;
+		int height = 0;
+		int mipmap_count = 0;
+		Image::Format format = Image::FORMAT_L8;
+		// One buffer per mipmap for the lossless and lossy formats, or a single one for the others.
+		LocalVector<Vector<uint8_t>> data;
+	};
+
+	struct EncodeImagesJob {
+		const Ref<Image> *images = nullptr;
+		EncodedImage *encoded = nullptr;
+		CompressMode compress_mode = COMPRESS_LOSSLESS;
+		Image::UsedChannels channels = Image::USED_CHANNELS_RGBA;
+		Image::CompressMode compress_format = Image::COMPRESS_S3TC;
+		float lossy_quality = 0.0;
+		const Image::BasisUniversalPackerParams *basisu_params = nullptr;
+
+		static void encode_image(void *p_userdata, uint32_t p_index);
+	};
+
+	static void _encode_ctex_format(EncodedImage &r_encoded, const Ref<Image> &p_image, CompressMode p_compress_mode, Image::UsedChannels p_channels, Image::CompressMode p_compress_format, float p_lossy_quality, const Image::BasisUniversalPackerParams &p_basisu_params);
+	static void _store_ctex_format(Ref<FileAccess> f, const EncodedImage &p_encoded);
+
 public:
 	static void save_to_ctex_format(Ref<FileAccess> f, const Ref<Image> &p_image, CompressMode p_compress_mode, Image::UsedChannels p_channels, Image::CompressMode p_compress_format, float p_lossy_quality, const Image::BasisUniversalPackerParams &p_basisu_params);
+	// Same as calling save_to_ctex_format() for each image in order, but the images are compressed in parallel.
+	static void save_images_to_ctex_format(Ref<FileAccess> f, const Vector<Ref<Image>> &p_images, CompressMode p_compress_mode, Image::UsedChannels p_channels, Image::CompressMode p_compress_format, float p_lossy_quality, const Image::BasisUniversalPackerParams &p_basisu_params);
 
 	static ResourceImporterTexture *get_singleton() { return singleton; }
 	virtual String get_importer_name() const override;
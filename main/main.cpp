@@ -2090,7 +2090,8 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 		} else {
 			int worker_threads = GLOBAL_GET("threading/worker_pool/max_threads");
 			float low_priority_ratio = GLOBAL_GET("threading/worker_pool/low_priority_thread_ratio");
-			WorkerThreadPool::get_singleton()->init(worker_threads, low_priority_ratio);
+			bool work_stealing = GLOBAL_GET("threading/worker_pool/work_stealing");
+			WorkerThreadPool::get_singleton()->init(worker_threads, low_priority_ratio, work_stealing);
 		}
 #else
 		WorkerThreadPool::get_singleton()->init(0, 0);
@@ -4869,6 +4870,9 @@ bool Main::iteration() {
 	GodotProfileZoneGroupedFirst(_profile_zone, "prepare");
 	iterating++;
 
+	// Before anything in this iteration allocates, so the whole frame uses the same arena generation.
+	FrameArena::next_frame();
+
 	const uint64_t ticks = OS::get_singleton()->get_ticks_usec();
 	Engine::get_singleton()->_frame_ticks = ticks;
 	main_timer_sync.set_cpu_ticks_usec(ticks);
@@ -5057,6 +5061,8 @@ bool Main::iteration() {
 	GodotProfileZoneGrouped(_profile_zone, "AudioServer::update");
 	AudioServer::get_singleton()->update();
 
+	message_queue->update_frame_statistics();
+
 	if (EngineDebugger::is_active()) {
 		EngineDebugger::get_singleton()->iteration(frame_time, process_ticks, physics_process_ticks, physics_step);
 	}
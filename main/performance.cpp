@@ -33,6 +33,7 @@
 
 #include "core/config/engine.h"
 #include "core/object/class_db.h"
+#include "core/object/message_queue.h"
 #include "core/os/os.h"
 #include "core/variant/typed_array.h"
 #include "scene/main/node.h"
@@ -135,6 +136,11 @@ void Performance::_bind_methods() {
 	BIND_ENUM_CONSTANT(NAVIGATION_3D_EDGE_FREE_COUNT);
 	BIND_ENUM_CONSTANT(NAVIGATION_3D_OBSTACLE_COUNT);
 #endif // NAVIGATION_3D_DISABLED
+	BIND_ENUM_CONSTANT(MESSAGE_QUEUE_PUSHES_IN_FRAME);
+	BIND_ENUM_CONSTANT(MESSAGE_QUEUE_FLUSHED_CALLS_IN_FRAME);
+	BIND_ENUM_CONSTANT(MESSAGE_QUEUE_BYTES_IN_FRAME);
+	BIND_ENUM_CONSTANT(FRAME_ARENA_BYTES_IN_FRAME);
+	BIND_ENUM_CONSTANT(FRAME_ARENA_PEAK_BYTES_IN_FRAME);
 	BIND_ENUM_CONSTANT(MONITOR_MAX);
 
 	BIND_ENUM_CONSTANT(MONITOR_TYPE_QUANTITY);
@@ -230,6 +236,11 @@ String Performance::get_monitor_name(Monitor p_monitor) const {
 		PNAME("navigation_3d/edges_free"),
 		PNAME("navigation_3d/obstacles"),
 #endif // NAVIGATION_3D_DISABLED
+		PNAME("message_queue/pushes"),
+		PNAME("message_queue/flushed_calls"),
+		PNAME("message_queue/bytes"),
+		PNAME("memory/frame_arena"),
+		PNAME("memory/frame_arena_peak"),
 	};
 	static_assert(std_size(names) == MONITOR_MAX);
 
@@ -455,6 +466,17 @@ double Performance::get_monitor(Monitor p_monitor) const {
 			return NavigationServer3D::get_singleton()->get_process_info(NavigationServer3D::INFO_OBSTACLE_COUNT);
 #endif // NAVIGATION_3D_DISABLED
 
+		case MESSAGE_QUEUE_PUSHES_IN_FRAME:
+			return MessageQueue::get_main_singleton()->get_frame_statistics().pushed_messages;
+		case MESSAGE_QUEUE_FLUSHED_CALLS_IN_FRAME:
+			return MessageQueue::get_main_singleton()->get_frame_statistics().flushed_messages;
+		case MESSAGE_QUEUE_BYTES_IN_FRAME:
+			return MessageQueue::get_main_singleton()->get_frame_statistics().pushed_bytes;
+		case FRAME_ARENA_BYTES_IN_FRAME:
+			return FrameArena::get_frame_bytes();
+		case FRAME_ARENA_PEAK_BYTES_IN_FRAME:
+			return FrameArena::get_peak_frame_bytes();
+
 		default: {
 		}
 	}
@@ -527,7 +549,11 @@ Performance::MonitorType Performance::get_monitor_type(Monitor p_monitor) const
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_QUANTITY,
 #endif // _3D_DISABLED
-
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_MEMORY,
 	};
 	static_assert((sizeof(types) / sizeof(MonitorType)) == MONITOR_MAX);
 
@@ -122,6 +122,11 @@ public:
 		NAVIGATION_3D_EDGE_FREE_COUNT,
 		NAVIGATION_3D_OBSTACLE_COUNT,
 #endif // _3D_DISABLED
+		MESSAGE_QUEUE_PUSHES_IN_FRAME,
+		MESSAGE_QUEUE_FLUSHED_CALLS_IN_FRAME,
+		MESSAGE_QUEUE_BYTES_IN_FRAME,
+		FRAME_ARENA_BYTES_IN_FRAME,
+		FRAME_ARENA_PEAK_BYTES_IN_FRAME,
 		MONITOR_MAX
 	};
 
@@ -30,12 +30,28 @@
 
 #include "image_compress_astcenc.h"
 
+#include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
 #include "core/string/print_string.h"
 
 #include <astcenc.h>
 
 #ifdef TOOLS_ENABLED
+struct ASTCEncodeJob {
+	astcenc_context *context = nullptr;
+	astcenc_image *image = nullptr;
+	const astcenc_swizzle *swizzle = nullptr;
+	uint8_t *dest = nullptr;
+	size_t dest_size = 0;
+	LocalVector<astcenc_error> status;
+};
+
+// Every thread of the context must enter astcenc_compress_image(), which hands out the blocks.
+static void _compress_astc_thread(void *p_job, uint32_t p_index) {
+	ASTCEncodeJob *job = static_cast<ASTCEncodeJob *>(p_job);
+	job->status[p_index] = astcenc_compress_image(job->context, job->image, job->swizzle, job->dest, job->dest_size, p_index);
+}
+
 void _compress_astc(Image *r_img, Image::ASTCFormat p_format) {
 	const uint64_t start_time = OS::get_singleton()->get_ticks_msec();
 
@@ -111,7 +127,11 @@ void _compress_astc(Image *r_img, Image::ASTCFormat p_format) {
 
 	// Context allocation.
 	astcenc_context *context;
-	const unsigned int thread_count = 1; // Godot compresses multiple images each on a thread, which is more efficient for large amount of images imported.
+	// When importing many images at once, Godot compresses each of them on a thread of the pool, which compresses its image alone.
+	// Otherwise the blocks of each mip level are shared among the threads of the pool, which astcenc does deterministically.
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	const bool use_pool = pool != nullptr && pool->get_thread_count() > 1 && pool->get_thread_index() == -1;
+	const unsigned int thread_count = use_pool ? pool->get_thread_count() : 1;
 	status = astcenc_context_alloc(&config, thread_count, &context);
 	ERR_FAIL_COND_MSG(status != ASTCENC_SUCCESS,
 			vformat("astcenc: Context allocation failed: %s.", astcenc_get_error_string(status)));
@@ -158,7 +178,28 @@ void _compress_astc(Image *r_img, Image::ASTCFormat p_format) {
 			ASTCENC_SWZ_R, ASTCENC_SWZ_G, ASTCENC_SWZ_B, ASTCENC_SWZ_A
 		};
 
-		status = astcenc_compress_image(context, &image, &swizzle, dest_mip_write, comp_len, 0);
+		if (use_pool) {
+			ASTCEncodeJob job;
+			job.context = context;
+			job.image = &image;
+			job.swizzle = &swizzle;
+			job.dest = dest_mip_write;
+			job.dest_size = comp_len;
+			job.status.resize(thread_count);
+
+			WorkerThreadPool::GroupID group_task = pool->add_native_group_task(&_compress_astc_thread, &job, thread_count, thread_count, true, SNAME("ASTC Compress"));
+			pool->wait_for_group_task_completion(group_task);
+
+			status = ASTCENC_SUCCESS;
+			for (const astcenc_error thread_status : job.status) {
+				if (thread_status != ASTCENC_SUCCESS) {
+					status = thread_status;
+					break;
+				}
+			}
+		} else {
+			status = astcenc_compress_image(context, &image, &swizzle, dest_mip_write, comp_len, 0);
+		}
 		ERR_BREAK_MSG(status != ASTCENC_SUCCESS,
 				vformat("astcenc: ASTC image compression failed: %s.", astcenc_get_error_string(status)));
 
@@ -32,6 +32,7 @@
 
 #ifdef TOOLS_ENABLED
 
+#include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
 #include "core/string/print_string.h"
 
@@ -78,6 +79,70 @@ EtcpakType _determine_dxt_type(Image::UsedChannels p_channels) {
 	}
 }
 
+// Blocks compressed by each task of the worker thread pool.
+#define ETCPAK_BAND_BLOCKS 4096
+
+struct EtcpakBand {
+	const uint32_t *src = nullptr;
+	uint64_t *dst = nullptr;
+	uint32_t blocks = 0;
+	uint32_t width = 0;
+};
+
+struct EtcpakJob {
+	EtcpakType type = EtcpakType::ETCPAK_TYPE_ETC1;
+	LocalVector<EtcpakBand> bands;
+};
+
+static void _compress_etcpak_band(void *p_job, uint32_t p_index) {
+	const EtcpakJob *job = static_cast<const EtcpakJob *>(p_job);
+	const EtcpakBand &band = job->bands[p_index];
+
+	switch (job->type) {
+		case EtcpakType::ETCPAK_TYPE_ETC1:
+			CompressEtc1RgbDither(band.src, band.dst, band.blocks, band.width);
+			break;
+
+		case EtcpakType::ETCPAK_TYPE_ETC2:
+			CompressEtc2Rgb(band.src, band.dst, band.blocks, band.width, true);
+			break;
+
+		case EtcpakType::ETCPAK_TYPE_ETC2_ALPHA:
+		case EtcpakType::ETCPAK_TYPE_ETC2_RA_AS_RG:
+			CompressEtc2Rgba(band.src, band.dst, band.blocks, band.width, true);
+			break;
+
+		case EtcpakType::ETCPAK_TYPE_ETC2_R:
+			CompressEacR(band.src, band.dst, band.blocks, band.width);
+			break;
+
+		case EtcpakType::ETCPAK_TYPE_ETC2_RG:
+			CompressEacRg(band.src, band.dst, band.blocks, band.width);
+			break;
+
+		case EtcpakType::ETCPAK_TYPE_DXT1:
+			CompressBc1Dither(band.src, band.dst, band.blocks, band.width);
+			break;
+
+		case EtcpakType::ETCPAK_TYPE_DXT5:
+		case EtcpakType::ETCPAK_TYPE_DXT5_RA_AS_RG:
+			CompressBc3(band.src, band.dst, band.blocks, band.width);
+			break;
+
+		case EtcpakType::ETCPAK_TYPE_RGTC_R:
+			CompressBc4(band.src, band.dst, band.blocks, band.width);
+			break;
+
+		case EtcpakType::ETCPAK_TYPE_RGTC_RG:
+			CompressBc5(band.src, band.dst, band.blocks, band.width);
+			break;
+
+		default:
+			ERR_FAIL_MSG("etcpak: Invalid or unsupported compression format.");
+			break;
+	}
+}
+
 void _compress_etc1(Image *r_img) {
 	_compress_etcpak(EtcpakType::ETCPAK_TYPE_ETC1, r_img);
 }
@@ -202,7 +267,14 @@ void _compress_etcpak(EtcpakType p_compress_type, Image *r_img) {
 	const uint8_t *src_read = r_img->get_data().ptr();
 
 	const int mip_count = has_mipmaps ? Image::get_image_required_mipmaps(width, height, target_format) : 0;
-	Vector<uint32_t> padded_src;
+
+	// Size of a compressed block, in 64-bit words (BC3, BC5, ETC2 RGBA and EAC RG use two).
+	const uint32_t block_words = Image::get_image_data_size(4, 4, target_format, false) / sizeof(uint64_t);
+
+	EtcpakJob job;
+	job.type = p_compress_type;
+	LocalVector<Vector<uint32_t>> padded_mips;
+	padded_mips.resize(mip_count + 1);
 
 	for (int i = 0; i < mip_count + 1; i++) {
 		// Get write mip metrics for target image.
@@ -216,7 +288,6 @@ void _compress_etcpak(EtcpakType p_compress_type, Image *r_img) {
 		// Block size.
 		dest_mip_w = (dest_mip_w + 3) & ~3;
 		dest_mip_h = (dest_mip_h + 3) & ~3;
-		const uint32_t blocks = dest_mip_w * dest_mip_h / 16;
 
 		// Get mip data from source image for reading.
 		int64_t src_mip_ofs, src_mip_size;
@@ -229,6 +300,7 @@ void _compress_etcpak(EtcpakType p_compress_type, Image *r_img) {
 		// Pad textures to nearest block by smearing.
 		if (dest_mip_w != src_mip_w || dest_mip_h != src_mip_h) {
 			// Reserve the buffer for padded image data.
+			Vector<uint32_t> &padded_src = padded_mips[i];
 			padded_src.resize(dest_mip_w * dest_mip_h);
 			uint32_t *ptrw = padded_src.ptrw();
 
@@ -255,49 +327,31 @@ void _compress_etcpak(EtcpakType p_compress_type, Image *r_img) {
 			src_mip_read = padded_src.ptr();
 		}
 
-		switch (p_compress_type) {
-			case EtcpakType::ETCPAK_TYPE_ETC1:
-				CompressEtc1RgbDither(src_mip_read, dest_mip_write, blocks, dest_mip_w);
-				break;
-
-			case EtcpakType::ETCPAK_TYPE_ETC2:
-				CompressEtc2Rgb(src_mip_read, dest_mip_write, blocks, dest_mip_w, true);
-				break;
-
-			case EtcpakType::ETCPAK_TYPE_ETC2_ALPHA:
-			case EtcpakType::ETCPAK_TYPE_ETC2_RA_AS_RG:
-				CompressEtc2Rgba(src_mip_read, dest_mip_write, blocks, dest_mip_w, true);
-				break;
-
-			case EtcpakType::ETCPAK_TYPE_ETC2_R:
-				CompressEacR(src_mip_read, dest_mip_write, blocks, dest_mip_w);
-				break;
-
-			case EtcpakType::ETCPAK_TYPE_ETC2_RG:
-				CompressEacRg(src_mip_read, dest_mip_write, blocks, dest_mip_w);
-				break;
-
-			case EtcpakType::ETCPAK_TYPE_DXT1:
-				CompressBc1Dither(src_mip_read, dest_mip_write, blocks, dest_mip_w);
-				break;
-
-			case EtcpakType::ETCPAK_TYPE_DXT5:
-			case EtcpakType::ETCPAK_TYPE_DXT5_RA_AS_RG:
-				CompressBc3(src_mip_read, dest_mip_write, blocks, dest_mip_w);
-				break;
-
-			case EtcpakType::ETCPAK_TYPE_RGTC_R:
-				CompressBc4(src_mip_read, dest_mip_write, blocks, dest_mip_w);
-				break;
-
-			case EtcpakType::ETCPAK_TYPE_RGTC_RG:
-				CompressBc5(src_mip_read, dest_mip_write, blocks, dest_mip_w);
-				break;
+		// Split the mip in bands of block rows. Blocks are compressed independently of each other,
+		// so the result doesn't depend on how the bands are distributed.
+		const uint32_t row_blocks = dest_mip_w / 4;
+		const uint32_t block_rows = dest_mip_h / 4;
+		const uint32_t band_rows = CLAMP(ETCPAK_BAND_BLOCKS / row_blocks, 1u, block_rows);
+
+		for (uint32_t row = 0; row < block_rows; row += band_rows) {
+			EtcpakBand band;
+			band.src = src_mip_read + uint64_t(row) * 4 * dest_mip_w;
+			band.dst = dest_mip_write + uint64_t(row) * row_blocks * block_words;
+			band.blocks = MIN(band_rows, block_rows - row) * row_blocks;
+			band.width = dest_mip_w;
+			job.bands.push_back(band);
+		}
+	}
 
-			default:
-				ERR_FAIL_MSG("etcpak: Invalid or unsupported compression format.");
-				break;
+	// Threads of the pool compress their images serially, as waiting for other tasks from there can deadlock.
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	if (job.bands.size() < 2 || pool == nullptr || pool->get_thread_count() < 2 || pool->get_thread_index() != -1) {
+		for (uint32_t i = 0; i < job.bands.size(); i++) {
+			_compress_etcpak_band(&job, i);
 		}
+	} else {
+		WorkerThreadPool::GroupID group_task = pool->add_native_group_task(&_compress_etcpak_band, &job, job.bands.size(), -1, true, SNAME("Etcpak Compress"));
+		pool->wait_for_group_task_completion(group_task);
 	}
 
 	// Replace original image with compressed one.
@@ -3,6 +3,14 @@ def can_build(env, platform):
     return True
 
 
+def get_opts(platform):
+    from SCons.Variables import BoolVariable
+
+    return [
+        BoolVariable("gdscript_jit", "Build the GDScript JIT compiler (x86-64 only)", True),
+    ]
+
+
 def configure(env):
     pass
 
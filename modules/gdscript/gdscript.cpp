@@ -31,6 +31,7 @@
 #include "gdscript.h"
 
 #include "gdscript_analyzer.h"
+#include "gdscript_bytecode_cache.h"
 #include "gdscript_cache.h"
 #include "gdscript_compiler.h"
 #include "gdscript_parser.h"
@@ -814,6 +815,28 @@ Error GDScript::reload(bool p_keep_state) {
 #endif
 
 	valid = false;
+
+	if (!bytecode_cache.is_empty()) {
+		// The cache only replaces the first compilation of an exported script.
+		Error err = ERR_ALREADY_IN_USE;
+		if (!has_instances && member_functions.is_empty() && !binary_tokens.is_empty()) {
+			err = GDScriptBytecodeCache::load(this, bytecode_cache);
+		}
+		bytecode_cache.clear();
+
+		if (err == OK) {
+			if (can_run) {
+				err = _static_init();
+				if (err) {
+					return err;
+				}
+			}
+			reloading = false;
+			return OK;
+		}
+		print_verbose(vformat(R"(GDScript: Compiling "%s" instead of loading its bytecode cache.)", get_script_path()));
+	}
+
 	GDScriptParser parser;
 	Error err;
 	if (!binary_tokens.is_empty()) {
@@ -1174,6 +1197,14 @@ Vector<uint8_t> GDScript::get_as_binary_tokens() const {
 	return tokenizer.parse_code_string(source, GDScriptTokenizerBuffer::COMPRESS_NONE);
 }
 
+void GDScript::set_bytecode_cache(const Vector<uint8_t> &p_bytecode_cache) {
+	bytecode_cache = p_bytecode_cache;
+}
+
+const Vector<uint8_t> &GDScript::get_bytecode_cache() const {
+	return bytecode_cache;
+}
+
 const HashMap<StringName, GDScriptFunction *> &GDScript::debug_get_member_functions() const {
 	return member_functions;
 }
@@ -2225,6 +2256,8 @@ void GDScriptLanguage::finish() {
 	script_list.clear();
 	function_list.clear();
 
+	GDScriptFunction::clear_frame_pool();
+
 	finishing = false;
 }
 
@@ -2832,6 +2865,11 @@ GDScriptLanguage::GDScriptLanguage() {
 	_debug_max_call_stack = GLOBAL_DEF_RST(PropertyInfo(Variant::INT, "debug/settings/gdscript/max_call_stack", PROPERTY_HINT_RANGE, "512," + itos(GDScriptFunction::MAX_CALL_DEPTH - 1) + ",1"), 1024);
 	track_call_stack = GLOBAL_DEF_RST("debug/settings/gdscript/always_track_call_stacks", false);
 	track_locals = GLOBAL_DEF_RST("debug/settings/gdscript/always_track_local_variables", false);
+	jit_enabled = GLOBAL_DEF_RST("gdscript/jit/enabled", false);
+	if (jit_enabled && !GDScriptJIT::is_supported()) {
+		print_verbose("GDScript: The JIT isn't available in this build (it's only implemented for x86-64), scripts run in the VM.");
+		jit_enabled = false;
+	}
 
 #ifdef DEBUG_ENABLED
 	track_call_stack = true;
@@ -431,6 +431,66 @@ void GDScriptByteCodeGenerator::set_initial_line(int p_line) {
 #define IS_BUILTIN_TYPE(m_var, m_type) \
 	(m_var.type.kind == GDScriptDataType::BUILTIN && m_var.type.builtin_type == m_type && m_type != Variant::NIL)
 
+// Validated operators with their own opcode. Returns `OPCODE_END` if there's none for these operand types.
+static GDScriptFunction::Opcode _get_typed_operator_opcode(Variant::Operator p_operator, Variant::Type p_left_type, Variant::Type p_right_type) {
+	struct TypedOperator {
+		Variant::Operator op;
+		Variant::Type left_type;
+		Variant::Type right_type;
+		GDScriptFunction::Opcode opcode;
+	};
+	static const TypedOperator typed_operators[] = {
+		{ Variant::OP_ADD, Variant::INT, Variant::INT, GDScriptFunction::OPCODE_ADD_INT },
+		{ Variant::OP_SUBTRACT, Variant::INT, Variant::INT, GDScriptFunction::OPCODE_SUBTRACT_INT },
+		{ Variant::OP_MULTIPLY, Variant::INT, Variant::INT, GDScriptFunction::OPCODE_MULTIPLY_INT },
+		{ Variant::OP_EQUAL, Variant::INT, Variant::INT, GDScriptFunction::OPCODE_EQUAL_INT },
+		{ Variant::OP_NOT_EQUAL, Variant::INT, Variant::INT, GDScriptFunction::OPCODE_NOT_EQUAL_INT },
+		{ Variant::OP_LESS, Variant::INT, Variant::INT, GDScriptFunction::OPCODE_LESS_INT },
+		{ Variant::OP_LESS_EQUAL, Variant::INT, Variant::INT, GDScriptFunction::OPCODE_LESS_EQUAL_INT },
+		{ Variant::OP_GREATER, Variant::INT, Variant::INT, GDScriptFunction::OPCODE_GREATER_INT },
+		{ Variant::OP_GREATER_EQUAL, Variant::INT, Variant::INT, GDScriptFunction::OPCODE_GREATER_EQUAL_INT },
+		{ Variant::OP_ADD, Variant::FLOAT, Variant::FLOAT, GDScriptFunction::OPCODE_ADD_FLOAT },
+		{ Variant::OP_SUBTRACT, Variant::FLOAT, Variant::FLOAT, GDScriptFunction::OPCODE_SUBTRACT_FLOAT },
+		{ Variant::OP_MULTIPLY, Variant::FLOAT, Variant::FLOAT, GDScriptFunction::OPCODE_MULTIPLY_FLOAT },
+		{ Variant::OP_DIVIDE, Variant::FLOAT, Variant::FLOAT, GDScriptFunction::OPCODE_DIVIDE_FLOAT },
+		{ Variant::OP_LESS, Variant::FLOAT, Variant::FLOAT, GDScriptFunction::OPCODE_LESS_FLOAT },
+		{ Variant::OP_LESS_EQUAL, Variant::FLOAT, Variant::FLOAT, GDScriptFunction::OPCODE_LESS_EQUAL_FLOAT },
+		{ Variant::OP_GREATER, Variant::FLOAT, Variant::FLOAT, GDScriptFunction::OPCODE_GREATER_FLOAT },
+		{ Variant::OP_GREATER_EQUAL, Variant::FLOAT, Variant::FLOAT, GDScriptFunction::OPCODE_GREATER_EQUAL_FLOAT },
+		{ Variant::OP_ADD, Variant::VECTOR2, Variant::VECTOR2, GDScriptFunction::OPCODE_ADD_VECTOR2 },
+		{ Variant::OP_SUBTRACT, Variant::VECTOR2, Variant::VECTOR2, GDScriptFunction::OPCODE_SUBTRACT_VECTOR2 },
+		{ Variant::OP_MULTIPLY, Variant::VECTOR2, Variant::VECTOR2, GDScriptFunction::OPCODE_MULTIPLY_VECTOR2 },
+		{ Variant::OP_MULTIPLY, Variant::VECTOR2, Variant::FLOAT, GDScriptFunction::OPCODE_MULTIPLY_VECTOR2_FLOAT },
+		{ Variant::OP_ADD, Variant::VECTOR3, Variant::VECTOR3, GDScriptFunction::OPCODE_ADD_VECTOR3 },
+		{ Variant::OP_SUBTRACT, Variant::VECTOR3, Variant::VECTOR3, GDScriptFunction::OPCODE_SUBTRACT_VECTOR3 },
+		{ Variant::OP_MULTIPLY, Variant::VECTOR3, Variant::VECTOR3, GDScriptFunction::OPCODE_MULTIPLY_VECTOR3 },
+		{ Variant::OP_MULTIPLY, Variant::VECTOR3, Variant::FLOAT, GDScriptFunction::OPCODE_MULTIPLY_VECTOR3_FLOAT },
+	};
+
+	for (const TypedOperator &typed_operator : typed_operators) {
+		if (typed_operator.op == p_operator && typed_operator.left_type == p_left_type && typed_operator.right_type == p_right_type) {
+			return typed_operator.opcode;
+		}
+	}
+	return GDScriptFunction::OPCODE_END;
+}
+
+// Assignments between values of the same type with their own opcode. Returns `OPCODE_END` if there's none for this type.
+static GDScriptFunction::Opcode _get_typed_assign_opcode(Variant::Type p_type) {
+	switch (p_type) {
+		case Variant::INT:
+			return GDScriptFunction::OPCODE_ASSIGN_INT;
+		case Variant::FLOAT:
+			return GDScriptFunction::OPCODE_ASSIGN_FLOAT;
+		case Variant::VECTOR2:
+			return GDScriptFunction::OPCODE_ASSIGN_VECTOR2;
+		case Variant::VECTOR3:
+			return GDScriptFunction::OPCODE_ASSIGN_VECTOR3;
+		default:
+			return GDScriptFunction::OPCODE_END;
+	}
+}
+
 void GDScriptByteCodeGenerator::write_type_adjust(const Address &p_target, Variant::Type p_new_type) {
 	switch (p_new_type) {
 		case Variant::BOOL:
@@ -613,6 +673,16 @@ void GDScriptByteCodeGenerator::write_binary_operator(const Address &p_target, V
 			}
 		}
 
+		// Operate on the values directly when there's an opcode for these types.
+		const GDScriptFunction::Opcode typed_opcode = _get_typed_operator_opcode(p_operator, p_left_operand.type.builtin_type, p_right_operand.type.builtin_type);
+		if (typed_opcode != GDScriptFunction::OPCODE_END) {
+			append_opcode(typed_opcode);
+			append(p_left_operand);
+			append(p_right_operand);
+			append(p_target);
+			return;
+		}
+
 		// Gather specific operator.
 		Variant::ValidatedOperatorEvaluator op_func = Variant::get_validated_operator_evaluator(p_operator, p_left_operand.type.builtin_type, p_right_operand.type.builtin_type);
 
@@ -931,6 +1001,11 @@ void GDScriptByteCodeGenerator::write_assign_with_conversion(const Address &p_ta
 				append(key_type.native_type);
 				append(value_type.builtin_type);
 				append(value_type.native_type);
+			} else if (IS_BUILTIN_TYPE(p_source, p_target.type.builtin_type) && _get_typed_assign_opcode(p_target.type.builtin_type) != GDScriptFunction::OPCODE_END) {
+				// Same type, no conversion needed.
+				append_opcode(_get_typed_assign_opcode(p_target.type.builtin_type));
+				append(p_target);
+				append(p_source);
 			} else {
 				append_opcode(GDScriptFunction::OPCODE_ASSIGN_TYPED_BUILTIN);
 				append(p_target);
@@ -995,6 +1070,10 @@ void GDScriptByteCodeGenerator::write_assign(const Address &p_target, const Addr
 		append(p_target);
 		append(p_source);
 		append(p_target.type.builtin_type);
+	} else if (IS_BUILTIN_TYPE(p_target, p_target.type.builtin_type) && IS_BUILTIN_TYPE(p_source, p_target.type.builtin_type) && _get_typed_assign_opcode(p_target.type.builtin_type) != GDScriptFunction::OPCODE_END) {
+		append_opcode(_get_typed_assign_opcode(p_target.type.builtin_type));
+		append(p_target);
+		append(p_source);
 	} else {
 		append_opcode(GDScriptFunction::OPCODE_ASSIGN);
 		append(p_target);
@@ -1027,12 +1106,14 @@ void GDScriptByteCodeGenerator::write_assign_default_parameter(const Address &p_
 }
 
 void GDScriptByteCodeGenerator::write_store_global(const Address &p_dst, int p_global_index) {
+	function->global_accesses.push_back(opcodes.size());
 	append_opcode(GDScriptFunction::OPCODE_STORE_GLOBAL);
 	append(p_dst);
 	append(p_global_index);
 }
 
 void GDScriptByteCodeGenerator::write_store_named_global(const Address &p_dst, const StringName &p_global) {
+	function->global_accesses.push_back(opcodes.size());
 	append_opcode(GDScriptFunction::OPCODE_STORE_NAMED_GLOBAL);
 	append(p_dst);
 	append(p_global);
@@ -1505,6 +1586,7 @@ void GDScriptByteCodeGenerator::write_construct_typed_dictionary(const Address &
 }
 
 void GDScriptByteCodeGenerator::write_await(const Address &p_target, const Address &p_operand) {
+	function->_is_coroutine = true;
 	append_opcode(GDScriptFunction::OPCODE_AWAIT);
 	append(p_operand);
 	append_opcode(GDScriptFunction::OPCODE_AWAIT_RESUME);
@@ -0,0 +1,1578 @@
+/**************************************************************************/
+/*  gdscript_bytecode_cache.cpp                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_bytecode_cache.h"
+
+#include "gdscript.h"
+#include "gdscript_cache.h"
+#include "gdscript_function.h"
+
+#include "core/debugger/engine_debugger.h"
+#include "core/io/marshalls.h"
+#include "core/io/resource_loader.h"
+#include "core/object/class_db.h"
+#include "core/version.h"
+
+static constexpr uint8_t CACHE_MAGIC[4] = { 'G', 'D', 'B', 'C' };
+static constexpr int MAX_VALUE_DEPTH = 256;
+
+enum CacheValue : uint8_t {
+	VALUE_ENCODED, // Value without objects, saved with `encode_variant()`.
+	VALUE_NULL_OBJECT,
+	VALUE_ARRAY,
+	VALUE_DICTIONARY,
+	VALUE_CLASS, // Class of the cached script itself, or one of its inner classes.
+	VALUE_SCRIPT, // Class from another GDScript file.
+	VALUE_GLOBAL, // Native class, singleton or other global constant.
+	VALUE_RESOURCE,
+};
+
+enum CacheClassFlags : uint8_t {
+	CLASS_TOOL = 1 << 0,
+	CLASS_ABSTRACT = 1 << 1,
+	CLASS_HAS_BASE = 1 << 2,
+	CLASS_IMPLICIT_INITIALIZER = 1 << 3,
+	CLASS_IMPLICIT_READY = 1 << 4,
+	CLASS_STATIC_INITIALIZER = 1 << 5,
+};
+
+static uint32_t _get_engine_hash() {
+	uint32_t hash = String(GODOT_VERSION_FULL_CONFIG).hash();
+	hash = hash_murmur3_one_32(String(GODOT_VERSION_HASH).hash(), hash);
+	hash = hash_murmur3_one_32(GDScriptBytecodeCache::FORMAT_VERSION, hash);
+	hash = hash_murmur3_one_32(GDScriptFunction::OPCODE_END, hash);
+	hash = hash_murmur3_one_32(Variant::VARIANT_MAX, hash);
+	hash = hash_murmur3_one_32(Variant::OP_MAX, hash);
+	return hash_fmix32(hash);
+}
+
+template <typename K, typename V>
+static const V *_find(const RBMap<K, V> &p_map, const K &p_key) {
+	const typename RBMap<K, V>::Element *E = p_map.find(p_key);
+	return E ? &E->value() : nullptr;
+}
+
+/////////////////////
+
+class GDScriptBytecodeCache::Writer {
+	const GDScriptBytecodeCache *cache = nullptr;
+	GDScript *root = nullptr;
+
+	LocalVector<uint8_t> data;
+	HashMap<StringName, uint32_t> string_map;
+	LocalVector<StringName> strings;
+
+	void put_8(uint8_t p_value) {
+		data.push_back(p_value);
+	}
+
+	void put_32(uint32_t p_value) {
+		const uint32_t pos = data.size();
+		data.resize(pos + 4);
+		encode_uint32(p_value, &data[pos]);
+	}
+
+	void put_buffer(const uint8_t *p_buffer, uint32_t p_size) {
+		const uint32_t pos = data.size();
+		data.resize(pos + p_size);
+		if (p_size > 0) {
+			memcpy(&data[pos], p_buffer, p_size);
+		}
+	}
+
+	void put_string(const String &p_string) {
+		const CharString utf8 = p_string.utf8();
+		put_32(utf8.length());
+		put_buffer((const uint8_t *)utf8.get_data(), utf8.length());
+	}
+
+	// Names are stored once in a table and referenced by index.
+	void put_name(const StringName &p_name) {
+		const uint32_t *index = string_map.getptr(p_name);
+		if (index) {
+			put_32(*index);
+			return;
+		}
+		put_32(strings.size());
+		string_map.insert(p_name, strings.size());
+		strings.push_back(p_name);
+	}
+
+	bool fail(const String &p_error) {
+		if (error.is_empty()) {
+			error = p_error;
+		}
+		return false;
+	}
+
+	bool put_object(Object *p_object);
+	bool put_value(const Variant &p_value, int p_depth = 0);
+	bool put_data_type(const GDScriptDataType &p_type);
+	void put_property_info(const PropertyInfo &p_info);
+	bool put_method_info(const MethodInfo &p_info);
+	bool put_member_info(const GDScript::MemberInfo &p_info);
+	bool put_function(const GDScriptFunction *p_function);
+	void put_class_tree(const GDScript *p_script);
+	bool put_class(const GDScript *p_script);
+
+public:
+	String error;
+
+	bool write(const Vector<uint8_t> &p_binary_tokens, Vector<uint8_t> &r_cache);
+
+	Writer(const GDScriptBytecodeCache *p_cache, GDScript *p_root) :
+			cache(p_cache), root(p_root) {}
+};
+
+bool GDScriptBytecodeCache::Writer::put_object(Object *p_object) {
+	GDScript *script = Object::cast_to<GDScript>(p_object);
+	if (script) {
+		GDScript *script_root = script->get_root_script();
+		if (script_root == root) {
+			put_8(VALUE_CLASS);
+			put_name(script->fully_qualified_name);
+			return true;
+		}
+		const String path = script_root->get_script_path();
+		if (path.is_empty() || !path.is_resource_file()) {
+			return fail(vformat(R"(Built-in script "%s" can't be referenced.)", script->fully_qualified_name));
+		}
+		put_8(VALUE_SCRIPT);
+		put_name(path);
+		put_name(script->fully_qualified_name);
+		return true;
+	}
+
+	const StringName *global = cache->global_objects.getptr(p_object->get_instance_id());
+	if (global) {
+		put_8(VALUE_GLOBAL);
+		put_name(*global);
+		return true;
+	}
+
+	GDScriptNativeClass *native_class = Object::cast_to<GDScriptNativeClass>(p_object);
+	if (native_class) {
+		put_8(VALUE_GLOBAL);
+		put_name(native_class->get_name());
+		return true;
+	}
+
+	Resource *resource = Object::cast_to<Resource>(p_object);
+	if (resource && !resource->is_built_in()) {
+		put_8(VALUE_RESOURCE);
+		put_name(resource->get_path());
+		return true;
+	}
+
+	return fail(vformat(R"(Object of class "%s" can't be saved.)", p_object->get_class()));
+}
+
+bool GDScriptBytecodeCache::Writer::put_value(const Variant &p_value, int p_depth) {
+	if (p_depth > MAX_VALUE_DEPTH) {
+		return fail("Constant is nested too deeply.");
+	}
+
+	switch (p_value.get_type()) {
+		case Variant::OBJECT: {
+			Object *object = p_value.get_validated_object();
+			if (!object) {
+				put_8(VALUE_NULL_OBJECT);
+				return true;
+			}
+			return put_object(object);
+		}
+		case Variant::ARRAY: {
+			const Array array = p_value;
+			put_8(VALUE_ARRAY);
+			put_8(array.is_read_only());
+			put_8(array.get_typed_builtin());
+			put_name(array.get_typed_class_name());
+			if (!put_value(array.get_typed_script(), p_depth + 1)) {
+				return false;
+			}
+			put_32(array.size());
+			for (int i = 0; i < array.size(); i++) {
+				if (!put_value(array[i], p_depth + 1)) {
+					return false;
+				}
+			}
+			return true;
+		}
+		case Variant::DICTIONARY: {
+			const Dictionary dictionary = p_value;
+			put_8(VALUE_DICTIONARY);
+			put_8(dictionary.is_read_only());
+			put_8(dictionary.get_typed_key_builtin());
+			put_name(dictionary.get_typed_key_class_name());
+			if (!put_value(dictionary.get_typed_key_script(), p_depth + 1)) {
+				return false;
+			}
+			put_8(dictionary.get_typed_value_builtin());
+			put_name(dictionary.get_typed_value_class_name());
+			if (!put_value(dictionary.get_typed_value_script(), p_depth + 1)) {
+				return false;
+			}
+			put_32(dictionary.size());
+			for (const KeyValue<Variant, Variant> &E : dictionary) {
+				if (!put_value(E.key, p_depth + 1) || !put_value(E.value, p_depth + 1)) {
+					return false;
+				}
+			}
+			return true;
+		}
+		case Variant::CALLABLE:
+		case Variant::SIGNAL:
+		case Variant::RID: {
+			return fail(vformat(R"(Constant of type "%s" can't be saved.)", Variant::get_type_name(p_value.get_type())));
+		}
+		default: {
+			int size = 0;
+			Error err = encode_variant(p_value, nullptr, size);
+			if (err != OK) {
+				return fail(vformat(R"(Constant of type "%s" can't be saved.)", Variant::get_type_name(p_value.get_type())));
+			}
+			put_8(VALUE_ENCODED);
+			put_32(size);
+			const uint32_t pos = data.size();
+			data.resize(pos + size);
+			encode_variant(p_value, &data[pos], size);
+			return true;
+		}
+	}
+}
+
+bool GDScriptBytecodeCache::Writer::put_data_type(const GDScriptDataType &p_type) {
+	put_8(p_type.kind);
+	put_8(p_type.builtin_type);
+	put_name(p_type.native_type);
+	if (p_type.kind == GDScriptDataType::SCRIPT || p_type.kind == GDScriptDataType::GDSCRIPT) {
+		if (!put_value(p_type.script_type)) {
+			return false;
+		}
+	}
+	put_32(p_type.container_element_types.size());
+	for (const GDScriptDataType &element_type : p_type.container_element_types) {
+		if (!put_data_type(element_type)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void GDScriptBytecodeCache::Writer::put_property_info(const PropertyInfo &p_info) {
+	put_8(p_info.type);
+	put_name(p_info.name);
+	put_name(p_info.class_name);
+	put_32(p_info.hint);
+	put_name(p_info.hint_string);
+	put_32(p_info.usage);
+}
+
+bool GDScriptBytecodeCache::Writer::put_method_info(const MethodInfo &p_info) {
+	put_name(p_info.name);
+	put_property_info(p_info.return_val);
+	put_32(p_info.flags);
+	put_32(p_info.id);
+	put_32(p_info.arguments.size());
+	for (const PropertyInfo &argument : p_info.arguments) {
+		put_property_info(argument);
+	}
+	put_32(p_info.default_arguments.size());
+	for (const Variant &default_argument : p_info.default_arguments) {
+		if (!put_value(default_argument)) {
+			return false;
+		}
+	}
+	put_32(p_info.return_val_metadata);
+	put_32(p_info.arguments_metadata.size());
+	for (int metadata : p_info.arguments_metadata) {
+		put_32(metadata);
+	}
+	return true;
+}
+
+bool GDScriptBytecodeCache::Writer::put_member_info(const GDScript::MemberInfo &p_info) {
+	put_32(p_info.index);
+	put_name(p_info.setter);
+	put_name(p_info.getter);
+	put_property_info(p_info.property_info);
+	return put_data_type(p_info.data_type);
+}
+
+bool GDScriptBytecodeCache::Writer::put_function(const GDScriptFunction *p_function) {
+	put_name(p_function->name);
+	put_8(p_function->_static);
+	put_8(p_function->_is_coroutine);
+	put_32(p_function->_initial_line);
+	put_32(p_function->_argument_count);
+	put_32(p_function->_vararg_index);
+	put_32(p_function->_stack_size);
+	put_32(p_function->_instruction_args_size);
+
+	if (!put_data_type(p_function->return_type)) {
+		return false;
+	}
+	put_32(p_function->argument_types.size());
+	for (const GDScriptDataType &type : p_function->argument_types) {
+		if (!put_data_type(type)) {
+			return false;
+		}
+	}
+	if (!put_method_info(p_function->method_info) || !put_value(p_function->rpc_config)) {
+		return false;
+	}
+
+	put_32(p_function->code.size());
+	put_buffer((const uint8_t *)p_function->code.ptr(), p_function->code.size() * sizeof(int));
+	put_32(p_function->default_arguments.size());
+	for (int address : p_function->default_arguments) {
+		put_32(address);
+	}
+
+	put_32(p_function->constants.size());
+	for (const Variant &constant : p_function->constants) {
+		if (!put_value(constant)) {
+			return false;
+		}
+	}
+	put_32(p_function->constant_map.size());
+	for (const KeyValue<StringName, Variant> &E : p_function->constant_map) {
+		put_name(E.key);
+		if (!put_value(E.value)) {
+			return false;
+		}
+	}
+	put_32(p_function->global_names.size());
+	for (const StringName &name : p_function->global_names) {
+		put_name(name);
+	}
+
+	put_32(p_function->operator_funcs.size());
+	for (Variant::ValidatedOperatorEvaluator evaluator : p_function->operator_funcs) {
+		const OperatorKey *key = _find(cache->operators, evaluator);
+		if (!key) {
+			return fail("Unknown operator evaluator.");
+		}
+		put_8(key->op);
+		put_8(key->left);
+		put_8(key->right);
+	}
+	put_32(p_function->setters.size());
+	for (Variant::ValidatedSetter setter : p_function->setters) {
+		const Pair<Variant::Type, StringName> *key = _find(cache->setters, setter);
+		if (!key) {
+			return fail("Unknown member setter.");
+		}
+		put_8(key->first);
+		put_name(key->second);
+	}
+	put_32(p_function->getters.size());
+	for (Variant::ValidatedGetter getter : p_function->getters) {
+		const Pair<Variant::Type, StringName> *key = _find(cache->getters, getter);
+		if (!key) {
+			return fail("Unknown member getter.");
+		}
+		put_8(key->first);
+		put_name(key->second);
+	}
+	put_32(p_function->keyed_setters.size());
+	for (Variant::ValidatedKeyedSetter setter : p_function->keyed_setters) {
+		const Variant::Type *type = _find(cache->keyed_setters, setter);
+		if (!type) {
+			return fail("Unknown keyed setter.");
+		}
+		put_8(*type);
+	}
+	put_32(p_function->keyed_getters.size());
+	for (Variant::ValidatedKeyedGetter getter : p_function->keyed_getters) {
+		const Variant::Type *type = _find(cache->keyed_getters, getter);
+		if (!type) {
+			return fail("Unknown keyed getter.");
+		}
+		put_8(*type);
+	}
+	put_32(p_function->indexed_setters.size());
+	for (Variant::ValidatedIndexedSetter setter : p_function->indexed_setters) {
+		const Variant::Type *type = _find(cache->indexed_setters, setter);
+		if (!type) {
+			return fail("Unknown indexed setter.");
+		}
+		put_8(*type);
+	}
+	put_32(p_function->indexed_getters.size());
+	for (Variant::ValidatedIndexedGetter getter : p_function->indexed_getters) {
+		const Variant::Type *type = _find(cache->indexed_getters, getter);
+		if (!type) {
+			return fail("Unknown indexed getter.");
+		}
+		put_8(*type);
+	}
+	put_32(p_function->builtin_methods.size());
+	for (Variant::ValidatedBuiltInMethod method : p_function->builtin_methods) {
+		const Pair<Variant::Type, StringName> *key = _find(cache->builtin_methods, method);
+		if (!key) {
+			return fail("Unknown built-in method.");
+		}
+		put_8(key->first);
+		put_name(key->second);
+	}
+	put_32(p_function->constructors.size());
+	for (Variant::ValidatedConstructor constructor : p_function->constructors) {
+		const Pair<Variant::Type, int> *key = _find(cache->constructors, constructor);
+		if (!key) {
+			return fail("Unknown constructor.");
+		}
+		put_8(key->first);
+		put_32(key->second);
+	}
+	put_32(p_function->utilities.size());
+	for (Variant::ValidatedUtilityFunction utility : p_function->utilities) {
+		const StringName *name = _find(cache->utilities, utility);
+		if (!name) {
+			return fail("Unknown utility function.");
+		}
+		put_name(*name);
+	}
+	put_32(p_function->gds_utilities.size());
+	for (GDScriptUtilityFunctions::FunctionPtr utility : p_function->gds_utilities) {
+		const StringName *name = _find(cache->gds_utilities, utility);
+		if (!name) {
+			return fail("Unknown GDScript utility function.");
+		}
+		put_name(*name);
+	}
+	put_32(p_function->methods.size());
+	for (const MethodBind *method : p_function->methods) {
+		put_name(method->get_instance_class());
+		put_name(method->get_name());
+	}
+
+	put_32(p_function->temporary_slots.size());
+	for (const KeyValue<int, Variant::Type> &E : p_function->temporary_slots) {
+		put_32(E.key);
+		put_8(E.value);
+	}
+
+	put_32(p_function->global_accesses.size());
+	for (int position : p_function->global_accesses) {
+		const int index = p_function->code[position + 2];
+		const StringName *name = nullptr;
+		if (p_function->code[position] == GDScriptFunction::OPCODE_STORE_GLOBAL) {
+			name = cache->global_names.getptr(index);
+		} else if (index >= 0 && index < p_function->global_names.size()) {
+			name = &p_function->global_names[index];
+		}
+		if (!name) {
+			return fail("Unknown global constant.");
+		}
+		put_32(position);
+		put_name(*name);
+	}
+
+	put_32(p_function->lambdas.size());
+	for (const GDScriptFunction *lambda : p_function->lambdas) {
+		const GDScript::LambdaInfo *info = lambda->_script->lambda_info.getptr(const_cast<GDScriptFunction *>(lambda));
+		put_8(info != nullptr);
+		put_32(info ? info->capture_count : 0);
+		put_8(info ? info->use_self : false);
+		if (!put_function(lambda)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void GDScriptBytecodeCache::Writer::put_class_tree(const GDScript *p_script) {
+	put_string(p_script->fully_qualified_name);
+	put_string(p_script->local_name);
+	put_string(p_script->global_name);
+	put_string(p_script->simplified_icon_path);
+	put_32(p_script->subclasses.size());
+	for (const KeyValue<StringName, Ref<GDScript>> &E : p_script->subclasses) {
+		put_class_tree(E.value.ptr());
+	}
+}
+
+bool GDScriptBytecodeCache::Writer::put_class(const GDScript *p_script) {
+	if (!p_script->valid || p_script->native.is_null()) {
+		return fail(vformat(R"(Class "%s" isn't compiled.)", p_script->fully_qualified_name));
+	}
+
+	uint8_t flags = 0;
+	flags |= p_script->tool ? CLASS_TOOL : 0;
+	flags |= p_script->_is_abstract ? CLASS_ABSTRACT : 0;
+	flags |= p_script->base.is_valid() ? CLASS_HAS_BASE : 0;
+	flags |= p_script->implicit_initializer ? CLASS_IMPLICIT_INITIALIZER : 0;
+	flags |= p_script->implicit_ready ? CLASS_IMPLICIT_READY : 0;
+	flags |= p_script->static_initializer ? CLASS_STATIC_INITIALIZER : 0;
+	put_8(flags);
+
+	put_name(p_script->native->get_name());
+	if (p_script->base.is_valid() && !put_value(p_script->base)) {
+		return false;
+	}
+
+	put_32(p_script->member_indices.size());
+	for (const KeyValue<StringName, GDScript::MemberInfo> &E : p_script->member_indices) {
+		put_name(E.key);
+		if (!put_member_info(E.value)) {
+			return false;
+		}
+	}
+	put_32(p_script->members.size());
+	for (const StringName &member : p_script->members) {
+		put_name(member);
+	}
+	put_32(p_script->static_variables_indices.size());
+	for (const KeyValue<StringName, GDScript::MemberInfo> &E : p_script->static_variables_indices) {
+		put_name(E.key);
+		if (!put_member_info(E.value)) {
+			return false;
+		}
+	}
+	put_32(p_script->constants.size());
+	for (const KeyValue<StringName, Variant> &E : p_script->constants) {
+		put_name(E.key);
+		if (!put_value(E.value)) {
+			return false;
+		}
+	}
+	put_32(p_script->_signals.size());
+	for (const KeyValue<StringName, MethodInfo> &E : p_script->_signals) {
+		put_name(E.key);
+		if (!put_method_info(E.value)) {
+			return false;
+		}
+	}
+	if (!put_value(p_script->rpc_config)) {
+		return false;
+	}
+
+	put_32(p_script->member_functions.size());
+	for (const KeyValue<StringName, GDScriptFunction *> &E : p_script->member_functions) {
+		if (!put_function(E.value)) {
+			return false;
+		}
+	}
+	for (const GDScriptFunction *function : { p_script->implicit_initializer, p_script->implicit_ready, p_script->static_initializer }) {
+		if (function && !put_function(function)) {
+			return false;
+		}
+	}
+
+	for (const KeyValue<StringName, Ref<GDScript>> &E : p_script->subclasses) {
+		if (!put_class(E.value.ptr())) {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool GDScriptBytecodeCache::Writer::write(const Vector<uint8_t> &p_binary_tokens, Vector<uint8_t> &r_cache) {
+	bool has_static_data = false;
+	LocalVector<const GDScript *> classes = { root };
+	for (uint32_t i = 0; i < classes.size(); i++) {
+		has_static_data = has_static_data || classes[i]->static_initializer;
+		for (const KeyValue<StringName, Ref<GDScript>> &E : classes[i]->subclasses) {
+			classes.push_back(E.value.ptr());
+		}
+	}
+
+	// The body is written first, to know which names go in the table.
+	put_8(has_static_data && GDScriptCache::has_static_script(root->fully_qualified_name));
+	if (!put_class(root)) {
+		return false;
+	}
+	LocalVector<uint8_t> body = std::move(data);
+
+	data.clear();
+	put_buffer(CACHE_MAGIC, 4);
+	put_32(FORMAT_VERSION);
+	put_32(_get_engine_hash());
+	put_32(hash_djb2_buffer(p_binary_tokens.ptr(), p_binary_tokens.size()));
+	put_class_tree(root);
+	put_32(strings.size());
+	for (const StringName &string : strings) {
+		put_string(string);
+	}
+	put_buffer(body.ptr(), body.size());
+
+	r_cache.resize(data.size());
+	memcpy(r_cache.ptrw(), data.ptr(), data.size());
+	return true;
+}
+
+/////////////////////
+
+class GDScriptBytecodeCache::Reader {
+	struct ClassData {
+		GDScript *script = nullptr;
+		uint8_t flags = 0;
+		Ref<GDScriptNativeClass> native;
+		Ref<GDScript> base;
+		HashMap<StringName, GDScript::MemberInfo> member_indices;
+		HashSet<StringName> members;
+		HashMap<StringName, GDScript::MemberInfo> static_variables_indices;
+		HashMap<StringName, Variant> constants;
+		HashMap<StringName, MethodInfo> signals;
+		Dictionary rpc_config;
+		HashMap<StringName, GDScriptFunction *> member_functions;
+		GDScriptFunction *implicit_initializer = nullptr;
+		GDScriptFunction *implicit_ready = nullptr;
+		GDScriptFunction *static_initializer = nullptr;
+	};
+
+	GDScript *root = nullptr;
+	const uint8_t *data = nullptr;
+	uint32_t size = 0;
+	uint32_t position = 0;
+	bool failed = false;
+
+	Vector<StringName> strings;
+	LocalVector<GDScript *> classes;
+	LocalVector<ClassData> class_data;
+	LocalVector<Pair<GDScriptFunction *, GDScript::LambdaInfo>> lambda_info;
+
+	bool fail(const String &p_error) {
+		if (!failed) {
+			failed = true;
+			error = p_error;
+		}
+		return false;
+	}
+
+	bool has_space(uint32_t p_size) {
+		if (failed || p_size > size - position) {
+			return fail("Unexpected end of cache.");
+		}
+		return true;
+	}
+
+	uint8_t get_8() {
+		if (!has_space(1)) {
+			return 0;
+		}
+		return data[position++];
+	}
+
+	uint32_t get_32() {
+		if (!has_space(4)) {
+			return 0;
+		}
+		const uint32_t value = decode_uint32(&data[position]);
+		position += 4;
+		return value;
+	}
+
+	// Reads an element count, checking it against the data left so a corrupt cache can't make huge allocations.
+	uint32_t get_count() {
+		const uint32_t count = get_32();
+		return has_space(count) ? count : 0;
+	}
+
+	String get_string() {
+		const uint32_t length = get_32();
+		if (!has_space(length)) {
+			return String();
+		}
+		String string = String::utf8((const char *)&data[position], length);
+		position += length;
+		return string;
+	}
+
+	StringName get_name() {
+		const uint32_t index = get_32();
+		if (index >= (uint32_t)strings.size()) {
+			fail("Invalid name index.");
+			return StringName();
+		}
+		return strings[index];
+	}
+
+	template <typename T>
+	T get_type() {
+		const uint8_t type = get_8();
+		if (type >= Variant::VARIANT_MAX) {
+			fail("Invalid type.");
+			return T(Variant::NIL);
+		}
+		return T(type);
+	}
+
+	bool get_object(uint8_t p_tag, Variant &r_value);
+	bool get_value(Variant &r_value, int p_depth = 0);
+	bool get_data_type(GDScriptDataType &r_type);
+	void get_property_info(PropertyInfo &r_info);
+	bool get_method_info(MethodInfo &r_info);
+	bool get_member_info(GDScript::MemberInfo &r_info);
+	GDScriptFunction *get_function(GDScript *p_script);
+	bool get_class_tree(GDScript *p_script, const String &p_fully_qualified_name);
+	bool get_class(ClassData &r_data);
+	void clear_functions();
+
+	static void collect_functions(GDScriptFunction *p_function, LocalVector<GDScriptFunction *> &r_functions) {
+		if (!p_function) {
+			return;
+		}
+		r_functions.push_back(p_function);
+		for (GDScriptFunction *lambda : p_function->lambdas) {
+			collect_functions(lambda, r_functions);
+		}
+	}
+
+public:
+	String error;
+
+	bool read_header();
+	bool read_class_tree();
+	Error read_and_apply();
+
+	Reader(GDScript *p_root, const Vector<uint8_t> &p_cache) :
+			root(p_root), data(p_cache.ptr()), size(p_cache.size()) {}
+	~Reader() { clear_functions(); }
+};
+
+bool GDScriptBytecodeCache::Reader::get_object(uint8_t p_tag, Variant &r_value) {
+	switch (p_tag) {
+		case VALUE_NULL_OBJECT: {
+			r_value = Variant((Object *)nullptr);
+			return true;
+		}
+		case VALUE_CLASS: {
+			const StringName name = get_name();
+			GDScript *script = failed ? nullptr : root->find_class(name);
+			if (!script) {
+				return fail(vformat(R"(Inner class "%s" not found.)", name));
+			}
+			r_value = script;
+			return true;
+		}
+		case VALUE_SCRIPT: {
+			const String path = get_name();
+			const String name = get_name();
+			if (failed) {
+				return false;
+			}
+			Error err = OK;
+			// Like the compiler, only a shallow script is needed. Dependencies are fully loaded when this script is done.
+			Ref<GDScript> script = GDScriptCache::get_shallow_script(path, err, root->path);
+			GDScript *found = script.is_valid() ? script->find_class(name) : nullptr;
+			if (!found) {
+				return fail(vformat(R"(Class "%s" not found in "%s".)", name, path));
+			}
+			r_value = found;
+			return true;
+		}
+		case VALUE_GLOBAL: {
+			const StringName name = get_name();
+			const int *index = failed ? nullptr : GDScriptLanguage::get_singleton()->get_global_map().getptr(name);
+			if (!index) {
+				return fail(vformat(R"(Global "%s" not found.)", name));
+			}
+			r_value = GDScriptLanguage::get_singleton()->get_global_array()[*index];
+			return true;
+		}
+		case VALUE_RESOURCE: {
+			const String path = get_name();
+			Ref<Resource> resource = failed ? Ref<Resource>() : ResourceLoader::load(path);
+			if (resource.is_null()) {
+				return fail(vformat(R"(Can't load resource "%s".)", path));
+			}
+			r_value = resource;
+			return true;
+		}
+		default: {
+			return fail("Invalid value.");
+		}
+	}
+}
+
+bool GDScriptBytecodeCache::Reader::get_value(Variant &r_value, int p_depth) {
+	if (p_depth > MAX_VALUE_DEPTH) {
+		return fail("Value is nested too deeply.");
+	}
+
+	const uint8_t tag = get_8();
+	switch (tag) {
+		case VALUE_ENCODED: {
+			const uint32_t length = get_32();
+			if (!has_space(length)) {
+				return false;
+			}
+			if (decode_variant(r_value, &data[position], length) != OK) {
+				return fail("Can't decode value.");
+			}
+			position += length;
+			return true;
+		}
+		case VALUE_ARRAY: {
+			const bool read_only = get_8();
+			const Variant::Type type = get_type<Variant::Type>();
+			const StringName class_name = get_name();
+			Variant script;
+			if (!get_value(script, p_depth + 1)) {
+				return false;
+			}
+			Array array;
+			if (type != Variant::NIL) {
+				array.set_typed(type, class_name, script);
+			}
+			const uint32_t count = get_count();
+			array.resize(count);
+			for (uint32_t i = 0; i < count; i++) {
+				Variant element;
+				if (!get_value(element, p_depth + 1)) {
+					return false;
+				}
+				array[i] = element;
+			}
+			if (read_only) {
+				array.make_read_only();
+			}
+			r_value = array;
+			return !failed;
+		}
+		case VALUE_DICTIONARY: {
+			const bool read_only = get_8();
+			const Variant::Type key_type = get_type<Variant::Type>();
+			const StringName key_class_name = get_name();
+			Variant key_script;
+			if (!get_value(key_script, p_depth + 1)) {
+				return false;
+			}
+			const Variant::Type value_type = get_type<Variant::Type>();
+			const StringName value_class_name = get_name();
+			Variant value_script;
+			if (!get_value(value_script, p_depth + 1)) {
+				return false;
+			}
+			Dictionary dictionary;
+			if (key_type != Variant::NIL || value_type != Variant::NIL) {
+				dictionary.set_typed(key_type, key_class_name, key_script, value_type, value_class_name, value_script);
+			}
+			const uint32_t count = get_count();
+			for (uint32_t i = 0; i < count; i++) {
+				Variant key;
+				Variant value;
+				if (!get_value(key, p_depth + 1) || !get_value(value, p_depth + 1)) {
+					return false;
+				}
+				dictionary[key] = value;
+			}
+			if (read_only) {
+				dictionary.make_read_only();
+			}
+			r_value = dictionary;
+			return !failed;
+		}
+		default: {
+			return get_object(tag, r_value);
+		}
+	}
+}
+
+bool GDScriptBytecodeCache::Reader::get_data_type(GDScriptDataType &r_type) {
+	const uint8_t kind = get_8();
+	if (kind > GDScriptDataType::GDSCRIPT) {
+		return fail("Invalid data type.");
+	}
+	r_type.kind = GDScriptDataType::Kind(kind);
+	r_type.builtin_type = get_type<Variant::Type>();
+	r_type.native_type = get_name();
+
+	if (r_type.kind == GDScriptDataType::SCRIPT || r_type.kind == GDScriptDataType::GDSCRIPT) {
+		Variant value;
+		if (!get_value(value)) {
+			return false;
+		}
+		Script *script = Object::cast_to<Script>(value);
+		r_type.script_type = script;
+		// Like the compiler, only hold a strong reference to classes from other files, to avoid cyclic references.
+		GDScript *gdscript = Object::cast_to<GDScript>(script);
+		if (!gdscript || gdscript->get_root_script() != root) {
+			r_type.script_type_ref = Ref<Script>(script);
+		}
+	}
+
+	const uint32_t count = get_count();
+	r_type.container_element_types.resize(count);
+	for (uint32_t i = 0; i < count; i++) {
+		if (!get_data_type(r_type.container_element_types.write[i])) {
+			return false;
+		}
+	}
+	return !failed;
+}
+
+void GDScriptBytecodeCache::Reader::get_property_info(PropertyInfo &r_info) {
+	r_info.type = get_type<Variant::Type>();
+	r_info.name = get_name();
+	r_info.class_name = get_name();
+	r_info.hint = PropertyHint(get_32());
+	r_info.hint_string = get_name();
+	r_info.usage = get_32();
+}
+
+bool GDScriptBytecodeCache::Reader::get_method_info(MethodInfo &r_info) {
+	r_info.name = get_name();
+	get_property_info(r_info.return_val);
+	r_info.flags = get_32();
+	r_info.id = get_32();
+	r_info.arguments.resize(get_count());
+	for (PropertyInfo &argument : r_info.arguments) {
+		get_property_info(argument);
+	}
+	r_info.default_arguments.resize(get_count());
+	for (Variant &default_argument : r_info.default_arguments) {
+		if (!get_value(default_argument)) {
+			return false;
+		}
+	}
+	r_info.return_val_metadata = get_32();
+	r_info.arguments_metadata.resize(get_count());
+	for (int &metadata : r_info.arguments_metadata) {
+		metadata = get_32();
+	}
+	return !failed;
+}
+
+bool GDScriptBytecodeCache::Reader::get_member_info(GDScript::MemberInfo &r_info) {
+	r_info.index = get_32();
+	r_info.setter = get_name();
+	r_info.getter = get_name();
+	get_property_info(r_info.property_info);
+	return get_data_type(r_info.data_type);
+}
+
+// Returns a function which, like the ones made by `GDScriptByteCodeGenerator::write_end()`, points to its own tables.
+GDScriptFunction *GDScriptBytecodeCache::Reader::get_function(GDScript *p_script) {
+	GDScriptFunction *function = memnew(GDScriptFunction);
+	function->_script = p_script;
+	function->name = get_name();
+	function->source = p_script->get_script_path();
+	function->_static = get_8();
+	function->_is_coroutine = get_8();
+	function->_initial_line = get_32();
+	function->_argument_count = get_32();
+	function->_vararg_index = get_32();
+	function->_stack_size = get_32();
+	function->_instruction_args_size = get_32();
+
+	bool ok = get_data_type(function->return_type);
+	function->argument_types.resize(get_count());
+	for (int i = 0; ok && i < function->argument_types.size(); i++) {
+		ok = get_data_type(function->argument_types.write[i]);
+	}
+	ok = ok && get_method_info(function->method_info) && get_value(function->rpc_config);
+
+	const uint32_t code_size = get_count();
+	if (ok && has_space(code_size * sizeof(int))) {
+		function->code.resize(code_size);
+		memcpy(function->code.ptrw(), &data[position], code_size * sizeof(int));
+		position += code_size * sizeof(int);
+	}
+	function->default_arguments.resize(get_count());
+	for (int i = 0; i < function->default_arguments.size(); i++) {
+		function->default_arguments.write[i] = get_32();
+	}
+
+	function->constants.resize(get_count());
+	for (int i = 0; ok && i < function->constants.size(); i++) {
+		ok = get_value(function->constants.write[i]);
+	}
+	const uint32_t constant_map_size = get_count();
+	for (uint32_t i = 0; ok && i < constant_map_size; i++) {
+		const StringName name = get_name();
+		ok = get_value(function->constant_map[name]);
+	}
+	function->global_names.resize(get_count());
+	for (int i = 0; i < function->global_names.size(); i++) {
+		function->global_names.write[i] = get_name();
+	}
+
+#ifdef DEBUG_ENABLED
+#define ADD_DEBUG_NAME(m_names, m_name) m_names.push_back(m_name)
+#else
+#define ADD_DEBUG_NAME(m_names, m_name)
+#endif
+
+	const uint32_t operator_count = get_count();
+	for (uint32_t i = 0; ok && i < operator_count; i++) {
+		const Variant::Operator op = Variant::Operator(get_8());
+		const Variant::Type left = get_type<Variant::Type>();
+		const Variant::Type right = get_type<Variant::Type>();
+		Variant::ValidatedOperatorEvaluator evaluator = failed || op >= Variant::OP_MAX ? nullptr : Variant::get_validated_operator_evaluator(op, left, right);
+		ok = evaluator != nullptr || fail("Operator evaluator not found.");
+		function->operator_funcs.push_back(evaluator);
+		ADD_DEBUG_NAME(function->operator_names, Variant::get_operator_name(op));
+	}
+	const uint32_t setter_count = get_count();
+	for (uint32_t i = 0; ok && i < setter_count; i++) {
+		const Variant::Type type = get_type<Variant::Type>();
+		const StringName name = get_name();
+		Variant::ValidatedSetter setter = failed ? nullptr : Variant::get_member_validated_setter(type, name);
+		ok = setter != nullptr || fail(vformat(R"(Setter "%s" not found.)", name));
+		function->setters.push_back(setter);
+		ADD_DEBUG_NAME(function->setter_names, name);
+	}
+	const uint32_t getter_count = get_count();
+	for (uint32_t i = 0; ok && i < getter_count; i++) {
+		const Variant::Type type = get_type<Variant::Type>();
+		const StringName name = get_name();
+		Variant::ValidatedGetter getter = failed ? nullptr : Variant::get_member_validated_getter(type, name);
+		ok = getter != nullptr || fail(vformat(R"(Getter "%s" not found.)", name));
+		function->getters.push_back(getter);
+		ADD_DEBUG_NAME(function->getter_names, name);
+	}
+	const uint32_t keyed_setter_count = get_count();
+	for (uint32_t i = 0; ok && i < keyed_setter_count; i++) {
+		Variant::ValidatedKeyedSetter setter = Variant::get_member_validated_keyed_setter(get_type<Variant::Type>());
+		ok = setter != nullptr || fail("Keyed setter not found.");
+		function->keyed_setters.push_back(setter);
+	}
+	const uint32_t keyed_getter_count = get_count();
+	for (uint32_t i = 0; ok && i < keyed_getter_count; i++) {
+		Variant::ValidatedKeyedGetter getter = Variant::get_member_validated_keyed_getter(get_type<Variant::Type>());
+		ok = getter != nullptr || fail("Keyed getter not found.");
+		function->keyed_getters.push_back(getter);
+	}
+	const uint32_t indexed_setter_count = get_count();
+	for (uint32_t i = 0; ok && i < indexed_setter_count; i++) {
+		Variant::ValidatedIndexedSetter setter = Variant::get_member_validated_indexed_setter(get_type<Variant::Type>());
+		ok = setter != nullptr || fail("Indexed setter not found.");
+		function->indexed_setters.push_back(setter);
+	}
+	const uint32_t indexed_getter_count = get_count();
+	for (uint32_t i = 0; ok && i < indexed_getter_count; i++) {
+		Variant::ValidatedIndexedGetter getter = Variant::get_member_validated_indexed_getter(get_type<Variant::Type>());
+		ok = getter != nullptr || fail("Indexed getter not found.");
+		function->indexed_getters.push_back(getter);
+	}
+	const uint32_t builtin_method_count = get_count();
+	for (uint32_t i = 0; ok && i < builtin_method_count; i++) {
+		const Variant::Type type = get_type<Variant::Type>();
+		const StringName name = get_name();
+		Variant::ValidatedBuiltInMethod method = failed ? nullptr : Variant::get_validated_builtin_method(type, name);
+		ok = method != nullptr || fail(vformat(R"(Built-in method "%s" not found.)", name));
+		function->builtin_methods.push_back(method);
+		ADD_DEBUG_NAME(function->builtin_methods_names, name);
+	}
+	const uint32_t constructor_count = get_count();
+	for (uint32_t i = 0; ok && i < constructor_count; i++) {
+		const Variant::Type type = get_type<Variant::Type>();
+		const int index = get_32();
+		Variant::ValidatedConstructor constructor = failed || index < 0 || index >= Variant::get_constructor_count(type) ? nullptr : Variant::get_validated_constructor(type, index);
+		ok = constructor != nullptr || fail("Constructor not found.");
+		function->constructors.push_back(constructor);
+		ADD_DEBUG_NAME(function->constructors_names, Variant::get_type_name(type));
+	}
+	const uint32_t utility_count = get_count();
+	for (uint32_t i = 0; ok && i < utility_count; i++) {
+		const StringName name = get_name();
+		Variant::ValidatedUtilityFunction utility = !failed && Variant::has_utility_function(name) ? Variant::get_validated_utility_function(name) : nullptr;
+		ok = utility != nullptr || fail(vformat(R"(Utility function "%s" not found.)", name));
+		function->utilities.push_back(utility);
+		ADD_DEBUG_NAME(function->utilities_names, name);
+	}
+	const uint32_t gds_utility_count = get_count();
+	for (uint32_t i = 0; ok && i < gds_utility_count; i++) {
+		const StringName name = get_name();
+		GDScriptUtilityFunctions::FunctionPtr utility = !failed && GDScriptUtilityFunctions::function_exists(name) ? GDScriptUtilityFunctions::get_function(name) : nullptr;
+		ok = utility != nullptr || fail(vformat(R"(GDScript utility function "%s" not found.)", name));
+		function->gds_utilities.push_back(utility);
+		ADD_DEBUG_NAME(function->gds_utilities_names, name);
+	}
+
+#undef ADD_DEBUG_NAME
+
+	const uint32_t method_count = get_count();
+	for (uint32_t i = 0; ok && i < method_count; i++) {
+		const StringName class_name = get_name();
+		const StringName name = get_name();
+		MethodBind *method = failed ? nullptr : ClassDB::get_method(class_name, name);
+		ok = method != nullptr || fail(vformat(R"(Method "%s::%s" not found.)", class_name, name));
+		function->methods.push_back(method);
+	}
+
+	const uint32_t temporary_count = get_count();
+	for (uint32_t i = 0; ok && i < temporary_count; i++) {
+		const int slot = get_32();
+		function->temporary_slots[slot] = get_type<Variant::Type>();
+	}
+
+	// Global constant indices depend on the classes and singletons registered, so they're looked up by name again.
+	const uint32_t global_access_count = get_count();
+	for (uint32_t i = 0; ok && i < global_access_count; i++) {
+		const uint32_t position = get_32();
+		const StringName name = get_name();
+		const int *index = failed ? nullptr : GDScriptLanguage::get_singleton()->get_global_map().getptr(name);
+		if (!index || position + 2 >= (uint32_t)function->code.size()) {
+			ok = fail(vformat(R"(Global "%s" not found.)", name));
+			break;
+		}
+		int *code = function->code.ptrw();
+		code[position] = GDScriptFunction::OPCODE_STORE_GLOBAL;
+		code[position + 2] = *index;
+		function->global_accesses.push_back(position);
+	}
+
+	const uint32_t lambda_count = get_count();
+	for (uint32_t i = 0; ok && i < lambda_count; i++) {
+		const bool has_info = get_8();
+		GDScript::LambdaInfo info;
+		info.capture_count = get_32();
+		info.use_self = get_8();
+		GDScriptFunction *lambda = get_function(p_script);
+		if (!lambda) {
+			ok = false;
+			break;
+		}
+		// Owned by the function from now on, so it's freed with it.
+		function->lambdas.push_back(lambda);
+		if (has_info) {
+			lambda_info.push_back({ lambda, info });
+		}
+	}
+
+	if (!ok || failed) {
+		fail("Invalid function.");
+		memdelete(function);
+		return nullptr;
+	}
+
+	function->_code_ptr = function->code.is_empty() ? nullptr : function->code.ptrw();
+	function->_code_size = function->code.size();
+	function->_default_arg_count = function->default_arguments.is_empty() ? 0 : function->default_arguments.size() - 1;
+	function->_default_arg_ptr = function->default_arguments.is_empty() ? nullptr : function->default_arguments.ptr();
+	function->_constant_count = function->constants.size();
+	function->_constants_ptr = function->constants.is_empty() ? nullptr : function->constants.ptrw();
+	function->_global_names_count = function->global_names.size();
+	function->_global_names_ptr = function->global_names.is_empty() ? nullptr : function->global_names.ptr();
+	function->_operator_funcs_count = function->operator_funcs.size();
+	function->_operator_funcs_ptr = function->operator_funcs.is_empty() ? nullptr : function->operator_funcs.ptr();
+	function->_setters_count = function->setters.size();
+	function->_setters_ptr = function->setters.is_empty() ? nullptr : function->setters.ptr();
+	function->_getters_count = function->getters.size();
+	function->_getters_ptr = function->getters.is_empty() ? nullptr : function->getters.ptr();
+	function->_keyed_setters_count = function->keyed_setters.size();
+	function->_keyed_setters_ptr = function->keyed_setters.is_empty() ? nullptr : function->keyed_setters.ptr();
+	function->_keyed_getters_count = function->keyed_getters.size();
+	function->_keyed_getters_ptr = function->keyed_getters.is_empty() ? nullptr : function->keyed_getters.ptr();
+	function->_indexed_setters_count = function->indexed_setters.size();
+	function->_indexed_setters_ptr = function->indexed_setters.is_empty() ? nullptr : function->indexed_setters.ptr();
+	function->_indexed_getters_count = function->indexed_getters.size();
+	function->_indexed_getters_ptr = function->indexed_getters.is_empty() ? nullptr : function->indexed_getters.ptr();
+	function->_builtin_methods_count = function->builtin_methods.size();
+	function->_builtin_methods_ptr = function->builtin_methods.is_empty() ? nullptr : function->builtin_methods.ptr();
+	function->_constructors_count = function->constructors.size();
+	function->_constructors_ptr = function->constructors.is_empty() ? nullptr : function->constructors.ptr();
+	function->_utilities_count = function->utilities.size();
+	function->_utilities_ptr = function->utilities.is_empty() ? nullptr : function->utilities.ptr();
+	function->_gds_utilities_count = function->gds_utilities.size();
+	function->_gds_utilities_ptr = function->gds_utilities.is_empty() ? nullptr : function->gds_utilities.ptr();
+	function->_methods_count = function->methods.size();
+	function->_methods_ptr = function->methods.is_empty() ? nullptr : function->methods.ptrw();
+	function->_lambdas_count = function->lambdas.size();
+	function->_lambdas_ptr = function->lambdas.is_empty() ? nullptr : function->lambdas.ptrw();
+
+#ifdef DEBUG_ENABLED
+	function->func_cname = (String(function->source) + " - " + String(function->name)).utf8();
+	function->_func_cname = function->func_cname.get_data();
+#endif
+
+	return function;
+}
+
+bool GDScriptBytecodeCache::Reader::get_class_tree(GDScript *p_script, const String &p_fully_qualified_name) {
+	classes.push_back(p_script);
+
+	p_script->fully_qualified_name = p_fully_qualified_name;
+	p_script->local_name = get_string();
+	p_script->global_name = get_string();
+	p_script->simplified_icon_path = get_string();
+
+	// Same as `GDScriptCompiler::make_scripts()`, existing inner classes are kept.
+	HashMap<StringName, Ref<GDScript>> old_subclasses;
+	old_subclasses = p_script->subclasses;
+	p_script->subclasses.clear();
+
+	const uint32_t count = get_count();
+	for (uint32_t i = 0; i < count && !failed; i++) {
+		const String fully_qualified_name = get_string();
+		const StringName name = fully_qualified_name.get_slice("::", fully_qualified_name.get_slice_count("::") - 1);
+
+		Ref<GDScript> subclass;
+		if (old_subclasses.has(name)) {
+			subclass = old_subclasses[name];
+		} else {
+			subclass = GDScriptLanguage::get_singleton()->get_orphan_subclass(fully_qualified_name);
+		}
+		if (subclass.is_null()) {
+			subclass.instantiate();
+		}
+
+		subclass->_owner = p_script;
+		subclass->path = p_script->path;
+		p_script->subclasses.insert(name, subclass);
+
+		if (!get_class_tree(subclass.ptr(), fully_qualified_name)) {
+			return false;
+		}
+	}
+	return !failed;
+}
+
+bool GDScriptBytecodeCache::Reader::get_class(ClassData &r_data) {
+	GDScript *script = r_data.script;
+	r_data.flags = get_8();
+
+	const StringName native = get_name();
+	const int *native_index = failed ? nullptr : GDScriptLanguage::get_singleton()->get_global_map().getptr(native);
+	if (native_index) {
+		r_data.native = GDScriptLanguage::get_singleton()->get_global_array()[*native_index];
+	}
+	if (r_data.native.is_null()) {
+		return fail(vformat(R"(Native class "%s" not found.)", native));
+	}
+
+	if (r_data.flags & CLASS_HAS_BASE) {
+		Variant base;
+		if (!get_value(base)) {
+			return false;
+		}
+		r_data.base = base;
+		if (r_data.base.is_null()) {
+			return fail("Base class not found.");
+		}
+	}
+
+	const uint32_t member_count = get_count();
+	for (uint32_t i = 0; i < member_count && !failed; i++) {
+		const StringName name = get_name();
+		get_member_info(r_data.member_indices[name]);
+	}
+	const uint32_t own_member_count = get_count();
+	for (uint32_t i = 0; i < own_member_count && !failed; i++) {
+		r_data.members.insert(get_name());
+	}
+	const uint32_t static_variable_count = get_count();
+	for (uint32_t i = 0; i < static_variable_count && !failed; i++) {
+		const StringName name = get_name();
+		get_member_info(r_data.static_variables_indices[name]);
+	}
+	const uint32_t constant_count = get_count();
+	for (uint32_t i = 0; i < constant_count && !failed; i++) {
+		const StringName name = get_name();
+		get_value(r_data.constants[name]);
+	}
+	const uint32_t signal_count = get_count();
+	for (uint32_t i = 0; i < signal_count && !failed; i++) {
+		const StringName name = get_name();
+		get_method_info(r_data.signals[name]);
+	}
+	Variant rpc_config;
+	if (!get_value(rpc_config)) {
+		return false;
+	}
+	r_data.rpc_config = rpc_config;
+
+	const uint32_t function_count = get_count();
+	for (uint32_t i = 0; i < function_count && !failed; i++) {
+		GDScriptFunction *function = get_function(script);
+		if (function) {
+			r_data.member_functions.insert(function->name, function);
+		}
+	}
+	if (r_data.flags & CLASS_IMPLICIT_INITIALIZER) {
+		r_data.implicit_initializer = get_function(script);
+	}
+	if (r_data.flags & CLASS_IMPLICIT_READY) {
+		r_data.implicit_ready = get_function(script);
+	}
+	if (r_data.flags & CLASS_STATIC_INITIALIZER) {
+		r_data.static_initializer = get_function(script);
+	}
+	return !failed;
+}
+
+void GDScriptBytecodeCache::Reader::clear_functions() {
+	for (ClassData &data : class_data) {
+		for (const KeyValue<StringName, GDScriptFunction *> &E : data.member_functions) {
+			memdelete(E.value);
+		}
+		data.member_functions.clear();
+		for (GDScriptFunction **function : { &data.implicit_initializer, &data.implicit_ready, &data.static_initializer }) {
+			if (*function) {
+				memdelete(*function);
+				*function = nullptr;
+			}
+		}
+	}
+	class_data.clear();
+}
+
+bool GDScriptBytecodeCache::Reader::read_header() {
+	if (!has_space(4) || memcmp(data, CACHE_MAGIC, 4) != 0) {
+		return fail("Invalid bytecode cache.");
+	}
+	position += 4;
+	if (get_32() != FORMAT_VERSION) {
+		return fail("Unsupported bytecode cache version.");
+	}
+	if (get_32() != _get_engine_hash()) {
+		return fail("Bytecode cache was made with another engine version.");
+	}
+	const Vector<uint8_t> &tokens = root->binary_tokens;
+	if (get_32() != hash_djb2_buffer(tokens.ptr(), tokens.size())) {
+		return fail("Bytecode cache doesn't match the script.");
+	}
+	return !failed;
+}
+
+bool GDScriptBytecodeCache::Reader::read_class_tree() {
+	const String fully_qualified_name = get_string();
+	return get_class_tree(root, fully_qualified_name);
+}
+
+Error GDScriptBytecodeCache::Reader::read_and_apply() {
+	if (!read_header() || !read_class_tree()) {
+		return ERR_FILE_UNRECOGNIZED;
+	}
+
+	strings.resize(get_count());
+	for (int i = 0; i < strings.size(); i++) {
+		strings.write[i] = get_string();
+	}
+	const bool has_static_data = get_8();
+
+	class_data.resize(classes.size());
+	for (uint32_t i = 0; i < classes.size(); i++) {
+		class_data[i].script = classes[i];
+		if (!get_class(class_data[i])) {
+			return ERR_FILE_CORRUPT;
+		}
+	}
+	if (failed || position != size) {
+		return ERR_FILE_CORRUPT;
+	}
+
+	// Everything was read, nothing can fail from here on.
+	const StringName &init_name = GDScriptLanguage::get_singleton()->strings._init;
+	for (ClassData &data : class_data) {
+		GDScript *script = data.script;
+		script->tool = data.flags & CLASS_TOOL;
+		script->_is_abstract = data.flags & CLASS_ABSTRACT;
+		script->native = data.native;
+		script->base = data.base;
+		script->member_indices = std::move(data.member_indices);
+		script->members = std::move(data.members);
+		script->static_variables_indices = std::move(data.static_variables_indices);
+		script->static_variables.resize(script->static_variables_indices.size());
+		script->constants = std::move(data.constants);
+		script->_signals = std::move(data.signals);
+		script->rpc_config = data.rpc_config;
+		script->member_functions = std::move(data.member_functions);
+		data.member_functions.clear();
+		GDScriptFunction **initializer = script->member_functions.getptr(init_name);
+		script->initializer = initializer ? *initializer : nullptr;
+		script->implicit_initializer = data.implicit_initializer;
+		script->implicit_ready = data.implicit_ready;
+		script->static_initializer = data.static_initializer;
+		data.implicit_initializer = nullptr;
+		data.implicit_ready = nullptr;
+		data.static_initializer = nullptr;
+	}
+	for (const Pair<GDScriptFunction *, GDScript::LambdaInfo> &E : lambda_info) {
+		E.first->_script->lambda_info.insert(E.first, E.second);
+	}
+	for (GDScript *script : classes) {
+		script->_static_default_init();
+		script->valid = true;
+	}
+
+	if (GDScriptLanguage::get_singleton()->is_jit_enabled()) {
+		LocalVector<GDScriptFunction *> functions;
+		for (GDScript *script : classes) {
+			collect_functions(script->implicit_initializer, functions);
+			collect_functions(script->implicit_ready, functions);
+			collect_functions(script->static_initializer, functions);
+			for (const KeyValue<StringName, GDScriptFunction *> &E : script->member_functions) {
+				collect_functions(E.value, functions);
+			}
+		}
+		GDScriptJIT::compile(functions);
+	}
+
+	if (has_static_data) {
+		GDScriptCache::add_static_script(root);
+	}
+	return GDScriptCache::finish_compiling(root->path);
+}
+
+/////////////////////
+
+String GDScriptBytecodeCache::get_cache_path(const String &p_path) {
+	return p_path.get_basename() + ".gdbc";
+}
+
+bool GDScriptBytecodeCache::is_usable() {
+	return !EngineDebugger::is_active() && !GDScriptLanguage::get_singleton()->should_track_locals();
+}
+
+Error GDScriptBytecodeCache::make_scripts(GDScript *p_script, const Vector<uint8_t> &p_cache) {
+	ERR_FAIL_NULL_V(p_script, ERR_INVALID_PARAMETER);
+	if (!is_usable()) {
+		return ERR_UNAVAILABLE;
+	}
+
+	Reader reader(p_script, p_cache);
+	if (!reader.read_header() || !reader.read_class_tree()) {
+		print_verbose(vformat(R"(GDScript: Not using the bytecode cache of "%s": %s)", p_script->get_script_path(), reader.error));
+		return ERR_FILE_UNRECOGNIZED;
+	}
+	return OK;
+}
+
+Error GDScriptBytecodeCache::load(GDScript *p_script, const Vector<uint8_t> &p_cache) {
+	ERR_FAIL_NULL_V(p_script, ERR_INVALID_PARAMETER);
+	if (!is_usable()) {
+		return ERR_UNAVAILABLE;
+	}
+	ERR_FAIL_COND_V_MSG(!p_script->member_functions.is_empty(), ERR_ALREADY_IN_USE, "Bytecode caches can only be loaded into scripts that weren't compiled yet.");
+
+	Reader reader(p_script, p_cache);
+	Error err = reader.read_and_apply();
+	if (err == ERR_FILE_UNRECOGNIZED || err == ERR_FILE_CORRUPT) {
+		print_verbose(vformat(R"(GDScript: Not using the bytecode cache of "%s": %s)", p_script->get_script_path(), reader.error));
+	}
+	return err;
+}
+
+Vector<uint8_t> GDScriptBytecodeCache::save(const Ref<GDScript> &p_script, const Vector<uint8_t> &p_binary_tokens, String *r_error) const {
+	ERR_FAIL_COND_V(p_script.is_null(), Vector<uint8_t>());
+	ERR_FAIL_COND_V_MSG(!p_script->is_root_script(), Vector<uint8_t>(), "Only root scripts can be saved, inner classes are saved with them.");
+
+	Writer writer(this, p_script.ptr());
+	Vector<uint8_t> cache;
+	if (!writer.write(p_binary_tokens, cache)) {
+		if (r_error) {
+			*r_error = writer.error;
+		}
+		return Vector<uint8_t>();
+	}
+	return cache;
+}
+
+GDScriptBytecodeCache::GDScriptBytecodeCache() {
+	for (int i = 0; i < Variant::VARIANT_MAX; i++) {
+		const Variant::Type type = Variant::Type(i);
+
+		for (int op = 0; op < Variant::OP_MAX; op++) {
+			for (int j = 0; j < Variant::VARIANT_MAX; j++) {
+				Variant::ValidatedOperatorEvaluator evaluator = Variant::get_validated_operator_evaluator(Variant::Operator(op), type, Variant::Type(j));
+				if (evaluator && !operators.has(evaluator)) {
+					operators.insert(evaluator, { Variant::Operator(op), type, Variant::Type(j) });
+				}
+			}
+		}
+
+		List<StringName> members;
+		Variant::get_member_list(type, &members);
+		for (const StringName &member : members) {
+			Variant::ValidatedSetter setter = Variant::get_member_validated_setter(type, member);
+			if (setter && !setters.has(setter)) {
+				setters.insert(setter, { type, member });
+			}
+			Variant::ValidatedGetter getter = Variant::get_member_validated_getter(type, member);
+			if (getter && !getters.has(getter)) {
+				getters.insert(getter, { type, member });
+			}
+		}
+
+		Variant::ValidatedKeyedSetter keyed_setter = Variant::get_member_validated_keyed_setter(type);
+		if (keyed_setter && !keyed_setters.has(keyed_setter)) {
+			keyed_setters.insert(keyed_setter, type);
+		}
+		Variant::ValidatedKeyedGetter keyed_getter = Variant::get_member_validated_keyed_getter(type);
+		if (keyed_getter && !keyed_getters.has(keyed_getter)) {
+			keyed_getters.insert(keyed_getter, type);
+		}
+		Variant::ValidatedIndexedSetter indexed_setter = Variant::get_member_validated_indexed_setter(type);
+		if (indexed_setter && !indexed_setters.has(indexed_setter)) {
+			indexed_setters.insert(indexed_setter, type);
+		}
+		Variant::ValidatedIndexedGetter indexed_getter = Variant::get_member_validated_indexed_getter(type);
+		if (indexed_getter && !indexed_getters.has(indexed_getter)) {
+			indexed_getters.insert(indexed_getter, type);
+		}
+
+		List<StringName> methods;
+		Variant::get_builtin_method_list(type, &methods);
+		for (const StringName &method : methods) {
+			Variant::ValidatedBuiltInMethod validated = Variant::get_validated_builtin_method(type, method);
+			if (validated && !builtin_methods.has(validated)) {
+				builtin_methods.insert(validated, { type, method });
+			}
+		}
+
+		for (int j = 0; j < Variant::get_constructor_count(type); j++) {
+			Variant::ValidatedConstructor constructor = Variant::get_validated_constructor(type, j);
+			if (constructor && !constructors.has(constructor)) {
+				constructors.insert(constructor, { type, j });
+			}
+		}
+	}
+
+	List<StringName> functions;
+	Variant::get_utility_function_list(&functions);
+	for (const StringName &function : functions) {
+		Variant::ValidatedUtilityFunction utility = Variant::get_validated_utility_function(function);
+		if (utility && !utilities.has(utility)) {
+			utilities.insert(utility, function);
+		}
+	}
+	functions.clear();
+	GDScriptUtilityFunctions::get_function_list(&functions);
+	for (const StringName &function : functions) {
+		GDScriptUtilityFunctions::FunctionPtr utility = GDScriptUtilityFunctions::get_function(function);
+		if (utility && !gds_utilities.has(utility)) {
+			gds_utilities.insert(utility, function);
+		}
+	}
+
+	GDScriptLanguage *language = GDScriptLanguage::get_singleton();
+	for (const KeyValue<StringName, int> &E : language->get_global_map()) {
+		global_names.insert(E.value, E.key);
+		Object *object = language->get_global_array()[E.value].get_validated_object();
+		if (object && !global_objects.has(object->get_instance_id())) {
+			global_objects.insert(object->get_instance_id(), E.key);
+		}
+	}
+}
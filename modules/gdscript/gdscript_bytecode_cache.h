@@ -0,0 +1,92 @@
+/**************************************************************************/
+/*  gdscript_bytecode_cache.h                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "gdscript_utility_functions.h"
+
+#include "core/object/object_id.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/pair.h"
+#include "core/templates/rb_map.h"
+#include "core/variant/variant.h"
+
+class GDScript;
+
+// Compiled GDScript classes saved next to their binary tokens when exporting, so exported projects can skip parsing,
+// analyzing and compiling scripts when they start.
+//
+// The cache holds the class layout (members, constants, signals and inner classes) and the bytecode, constants and
+// type information of every function. Engine functions the bytecode calls through pointers (validated operators,
+// setters, getters, constructors, utilities and method binds) are saved by name and looked up again when loading, as
+// are references to other scripts, resources and global constants. A cache is only used with the engine version and
+// binary tokens it was made from, otherwise the script is compiled from its tokens as usual.
+class GDScriptBytecodeCache {
+	class Reader;
+	class Writer;
+
+	struct OperatorKey {
+		Variant::Operator op = Variant::OP_EQUAL;
+		Variant::Type left = Variant::NIL;
+		Variant::Type right = Variant::NIL;
+	};
+
+	// Reverse lookups of the engine functions and global constants referenced by compiled code, to save caches.
+	RBMap<Variant::ValidatedOperatorEvaluator, OperatorKey> operators;
+	RBMap<Variant::ValidatedSetter, Pair<Variant::Type, StringName>> setters;
+	RBMap<Variant::ValidatedGetter, Pair<Variant::Type, StringName>> getters;
+	RBMap<Variant::ValidatedKeyedSetter, Variant::Type> keyed_setters;
+	RBMap<Variant::ValidatedKeyedGetter, Variant::Type> keyed_getters;
+	RBMap<Variant::ValidatedIndexedSetter, Variant::Type> indexed_setters;
+	RBMap<Variant::ValidatedIndexedGetter, Variant::Type> indexed_getters;
+	RBMap<Variant::ValidatedBuiltInMethod, Pair<Variant::Type, StringName>> builtin_methods;
+	RBMap<Variant::ValidatedConstructor, Pair<Variant::Type, int>> constructors;
+	RBMap<Variant::ValidatedUtilityFunction, StringName> utilities;
+	RBMap<GDScriptUtilityFunctions::FunctionPtr, StringName> gds_utilities;
+	HashMap<int, StringName> global_names;
+	HashMap<ObjectID, StringName> global_objects;
+
+public:
+	static constexpr uint32_t FORMAT_VERSION = 2;
+
+	static String get_cache_path(const String &p_path);
+	// Caches lack the debug information needed when debugging or tracking local variables.
+	static bool is_usable();
+
+	// Creates the inner class scripts, so other scripts can reference them before this one is loaded.
+	static Error make_scripts(GDScript *p_script, const Vector<uint8_t> &p_cache);
+	// Fills the script and its inner classes from the cache, like `GDScriptCompiler::compile()` does.
+	static Error load(GDScript *p_script, const Vector<uint8_t> &p_cache);
+
+	// Returns an empty buffer if the script uses something that can't be saved.
+	Vector<uint8_t> save(const Ref<GDScript> &p_script, const Vector<uint8_t> &p_binary_tokens, String *r_error = nullptr) const;
+
+	GDScriptBytecodeCache();
+};
@@ -32,6 +32,7 @@
 
 #include "gdscript.h"
 #include "gdscript_analyzer.h"
+#include "gdscript_bytecode_cache.h"
 #include "gdscript_compiler.h"
 #include "gdscript_parser.h"
 
@@ -79,16 +80,7 @@ Error GDScriptParserRef::raise_status(Status p_new_status) {
 				// It's ok if its the first thing done here.
 				get_parser()->clear();
 				status = PARSED;
-				String remapped_path = ResourceLoader::path_remap(path);
-				if (remapped_path.has_extension("gdc")) {
-					Vector<uint8_t> tokens = GDScriptCache::get_binary_tokens(remapped_path);
-					source_hash = hash_djb2_buffer(tokens.ptr(), tokens.size());
-					result = get_parser()->parse_binary(tokens, path);
-				} else {
-					String source = GDScriptCache::get_source_code(remapped_path);
-					source_hash = source.hash();
-					result = get_parser()->parse(source, path, false);
-				}
+				result = GDScriptCache::_parse_script(path, get_parser(), source_hash);
 			} break;
 			case PARSED: {
 				status = INHERITANCE_SOLVED;
@@ -241,6 +233,180 @@ Ref<GDScriptParserRef> GDScriptCache::get_parser(const String &p_path, GDScriptP
 	return ref;
 }
 
+// Adds the scripts a class depends on for its declarations, which the analyzer is going to need.
+static void _add_script_dependency(const String &p_path, const String &p_base_dir, HashSet<String> &r_visited, LocalVector<String> &r_pending) {
+	String path = p_path;
+	if (path.is_relative_path()) {
+		path = p_base_dir.path_join(path);
+	}
+	path = path.simplify_path();
+	if (path.get_extension() != "gd" || r_visited.has(path)) {
+		return;
+	}
+	r_visited.insert(path);
+	r_pending.push_back(path);
+}
+
+static void _add_global_class_dependency(const StringName &p_name, HashSet<String> &r_visited, LocalVector<String> &r_pending) {
+	if (ScriptServer::is_global_class(p_name)) {
+		_add_script_dependency(ScriptServer::get_global_class_path(p_name), String(), r_visited, r_pending);
+	}
+}
+
+static void _add_type_dependencies(const GDScriptParser::TypeNode *p_type, HashSet<String> &r_visited, LocalVector<String> &r_pending) {
+	if (p_type == nullptr) {
+		return;
+	}
+	if (!p_type->type_chain.is_empty()) {
+		_add_global_class_dependency(p_type->type_chain[0]->name, r_visited, r_pending);
+	}
+	for (const GDScriptParser::TypeNode *container_type : p_type->container_types) {
+		_add_type_dependencies(container_type, r_visited, r_pending);
+	}
+}
+
+static void _add_assignable_dependencies(const GDScriptParser::AssignableNode *p_assignable, const String &p_base_dir, HashSet<String> &r_visited, LocalVector<String> &r_pending) {
+	_add_type_dependencies(p_assignable->datatype_specifier, r_visited, r_pending);
+
+	const GDScriptParser::ExpressionNode *initializer = p_assignable->initializer;
+	if (initializer && initializer->type == GDScriptParser::Node::PRELOAD) {
+		const GDScriptParser::ExpressionNode *path = static_cast<const GDScriptParser::PreloadNode *>(initializer)->path;
+		if (path && path->type == GDScriptParser::Node::LITERAL) {
+			const Variant &value = static_cast<const GDScriptParser::LiteralNode *>(path)->value;
+			if (value.get_type() == Variant::STRING) {
+				_add_script_dependency(value, p_base_dir, r_visited, r_pending);
+			}
+		}
+	}
+}
+
+static void _add_class_dependencies(const GDScriptParser::ClassNode *p_class, const String &p_base_dir, HashSet<String> &r_visited, LocalVector<String> &r_pending) {
+	if (!p_class->extends_path.is_empty()) {
+		_add_script_dependency(p_class->extends_path, p_base_dir, r_visited, r_pending);
+	} else if (!p_class->extends.is_empty()) {
+		_add_global_class_dependency(p_class->extends[0]->name, r_visited, r_pending);
+	}
+
+	for (const GDScriptParser::ClassNode::Member &member : p_class->members) {
+		switch (member.type) {
+			case GDScriptParser::ClassNode::Member::CLASS:
+				_add_class_dependencies(member.m_class, p_base_dir, r_visited, r_pending);
+				break;
+			case GDScriptParser::ClassNode::Member::CONSTANT:
+				_add_assignable_dependencies(member.constant, p_base_dir, r_visited, r_pending);
+				break;
+			case GDScriptParser::ClassNode::Member::VARIABLE:
+				_add_assignable_dependencies(member.variable, p_base_dir, r_visited, r_pending);
+				break;
+			case GDScriptParser::ClassNode::Member::FUNCTION:
+				_add_type_dependencies(member.function->return_type, r_visited, r_pending);
+				for (const GDScriptParser::ParameterNode *parameter : member.function->parameters) {
+					_add_type_dependencies(parameter->datatype_specifier, r_visited, r_pending);
+				}
+				break;
+			case GDScriptParser::ClassNode::Member::SIGNAL:
+				for (const GDScriptParser::ParameterNode *parameter : member.signal->parameters) {
+					_add_type_dependencies(parameter->datatype_specifier, r_visited, r_pending);
+				}
+				break;
+			default:
+				break;
+		}
+	}
+}
+
+Error GDScriptCache::_parse_script(const String &p_path, GDScriptParser *p_parser, uint32_t &r_source_hash) {
+	String remapped_path = ResourceLoader::path_remap(p_path);
+	if (remapped_path.has_extension("gdc")) {
+		Vector<uint8_t> tokens = get_binary_tokens(remapped_path);
+		r_source_hash = hash_djb2_buffer(tokens.ptr(), tokens.size());
+		return p_parser->parse_binary(tokens, p_path);
+	} else {
+		String source = get_source_code(remapped_path);
+		r_source_hash = source.hash();
+		return p_parser->parse(source, p_path, false);
+	}
+}
+
+void GDScriptCache::_parse_script_task(void *p_userdata) {
+	ParseTask &task = *static_cast<ParseTask *>(p_userdata);
+	task.result = _parse_script(task.path, task.parser, task.source_hash);
+}
+
+Vector<Ref<GDScriptParserRef>> GDScriptCache::parse_scripts(const Vector<String> &p_paths) {
+	MutexLock lock(singleton->mutex);
+
+	Vector<Ref<GDScriptParserRef>> parsers;
+	HashSet<String> visited;
+	LocalVector<String> pending;
+	for (const String &path : p_paths) {
+		_add_script_dependency(path, String(), visited, pending);
+	}
+
+	// Scripts are parsed in waves: the dependencies found in one wave are parsed in the next one.
+	// Only parsing happens in parallel. Analysis and compilation still happen in dependency order
+	// when the scripts are loaded, since they resolve other scripts through the cache.
+	while (!pending.is_empty()) {
+		LocalVector<ParseTask> tasks;
+		for (const String &path : pending) {
+			if (singleton->parser_map.has(path) || singleton->full_gdscript_cache.has(path)) {
+				continue;
+			}
+			const String remapped_path = ResourceLoader::path_remap(path);
+			if (!FileAccess::exists(remapped_path)) {
+				continue;
+			}
+			if (remapped_path.has_extension("gdc") && GDScriptBytecodeCache::is_usable() && FileAccess::exists(GDScriptBytecodeCache::get_cache_path(remapped_path))) {
+				continue; // Scripts loaded from a bytecode cache aren't parsed at all.
+			}
+			ParseTask task;
+			task.path = path;
+			// Created on this thread, which also fills the static tables of the parser the first time.
+			task.parser = memnew(GDScriptParser);
+			tasks.push_back(task);
+		}
+		pending.clear();
+
+		if (tasks.size() == 1) {
+			_parse_script_task(&tasks[0]);
+		} else if (tasks.size() > 1) {
+			// The cache stays locked, parsing doesn't use it. A task graph is used rather than a group, since
+			// waiting for it from a pool thread (e.g. a threaded resource load) runs its nodes too. Its nodes
+			// are high priority, so low priority load tasks waiting for the cache can't hold them back.
+			WorkerThreadPool::TaskGraph graph;
+			for (ParseTask &task : tasks) {
+				graph.add_native_node(&_parse_script_task, &task, SNAME("GDScriptParse"));
+			}
+			graph.submit();
+			graph.wait();
+		}
+
+		for (ParseTask &task : tasks) {
+			if (task.result == OK) {
+				_add_class_dependencies(task.parser->get_tree(), task.path.get_base_dir(), visited, pending);
+			}
+
+			if (singleton->parser_map.has(task.path)) {
+				// Parsed meanwhile by another task this thread ran while waiting.
+				memdelete(task.parser);
+				continue;
+			}
+
+			Ref<GDScriptParserRef> ref;
+			ref.instantiate();
+			ref->path = task.path;
+			ref->parser = task.parser;
+			ref->status = GDScriptParserRef::PARSED;
+			ref->result = task.result;
+			ref->source_hash = task.source_hash;
+			singleton->parser_map[task.path] = ref.ptr();
+			parsers.push_back(ref);
+		}
+	}
+
+	return parsers;
+}
+
 bool GDScriptCache::has_parser(const String &p_path) {
 	MutexLock lock(singleton->mutex);
 	return singleton->parser_map.has(p_path);
@@ -299,6 +465,14 @@ Vector<uint8_t> GDScriptCache::get_binary_tokens(const String &p_path) {
 	return buffer;
 }
 
+Vector<uint8_t> GDScriptCache::get_bytecode_cache(const String &p_path) {
+	const String cache_path = GDScriptBytecodeCache::get_cache_path(p_path);
+	if (!GDScriptBytecodeCache::is_usable() || !FileAccess::exists(cache_path)) {
+		return Vector<uint8_t>();
+	}
+	return FileAccess::get_file_as_bytes(cache_path);
+}
+
 Ref<GDScript> GDScriptCache::get_shallow_script(const String &p_path, Error &r_error, const String &p_owner) {
 	MutexLock lock(singleton->mutex);
 
@@ -324,6 +498,7 @@ Ref<GDScript> GDScriptCache::get_shallow_script(const String &p_path, Error &r_e
 			r_error = ERR_FILE_CANT_READ;
 		}
 		script->set_binary_tokens_source(buffer);
+		script->set_bytecode_cache(get_bytecode_cache(remapped_path));
 	} else {
 		r_error = script->load_source_code(remapped_path);
 	}
@@ -332,6 +507,15 @@ Ref<GDScript> GDScriptCache::get_shallow_script(const String &p_path, Error &r_e
 		return Ref<GDScript>(); // Returns null and does not cache when the script fails to load.
 	}
 
+	if (!script->get_bytecode_cache().is_empty()) {
+		// The class tree is stored in the cache too, so the script doesn't need to be parsed.
+		if (GDScriptBytecodeCache::make_scripts(script.ptr(), script->get_bytecode_cache()) == OK) {
+			singleton->shallow_gdscript_cache[p_path] = script;
+			return script;
+		}
+		script->set_bytecode_cache(Vector<uint8_t>());
+	}
+
 	Ref<GDScriptParserRef> parser_ref = get_parser(p_path, GDScriptParserRef::PARSED, r_error);
 	if (r_error == OK) {
 		GDScriptCompiler::make_scripts(script.ptr(), parser_ref->get_parser()->get_tree(), true);
@@ -358,6 +542,20 @@ Ref<GDScript> GDScriptCache::get_full_script(const String &p_path, Error &r_erro
 		}
 	}
 
+	// Parse the script and what it depends on ahead, so compiling them below only has to analyze them.
+	Vector<Ref<GDScriptParserRef>> parsers;
+	if (script.is_null() && !singleton->shallow_gdscript_cache.has(p_path)) {
+		parsers = parse_scripts({ p_path });
+
+		// The lock may have been lifted while parsing, and another thread may have loaded the script meanwhile.
+		if (singleton->full_gdscript_cache.has(p_path)) {
+			script = singleton->full_gdscript_cache[p_path];
+			if (!p_update_from_disk) {
+				return script;
+			}
+		}
+	}
+
 	if (script.is_null()) {
 		script = get_shallow_script(p_path, r_error);
 		// Only exit early if script failed to load, otherwise let reload report errors.
@@ -376,6 +574,7 @@ Ref<GDScript> GDScriptCache::get_full_script(const String &p_path, Error &r_erro
 				goto finish;
 			}
 			script->set_binary_tokens_source(buffer);
+			script->set_bytecode_cache(get_bytecode_cache(remapped_path));
 		} else {
 			r_error = script->load_source_code(remapped_path);
 			if (r_error) {
@@ -455,6 +654,11 @@ void GDScriptCache::remove_static_script(const String &p_fqcn) {
 	singleton->static_gdscript_cache.erase(p_fqcn);
 }
 
+bool GDScriptCache::has_static_script(const String &p_fqcn) {
+	MutexLock lock(singleton->mutex);
+	return singleton->static_gdscript_cache.has(p_fqcn);
+}
+
 void GDScriptCache::clear() {
 	if (singleton == nullptr) {
 		return;
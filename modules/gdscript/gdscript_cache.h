@@ -108,14 +108,27 @@ private:
 	static SafeBinaryMutex<BINARY_MUTEX_TAG> mutex;
 	friend SafeBinaryMutex<BINARY_MUTEX_TAG> &_get_gdscript_cache_mutex();
 
+	struct ParseTask {
+		String path;
+		GDScriptParser *parser = nullptr;
+		uint32_t source_hash = 0;
+		Error result = OK;
+	};
+
+	static Error _parse_script(const String &p_path, GDScriptParser *p_parser, uint32_t &r_source_hash);
+	static void _parse_script_task(void *p_userdata);
+
 public:
 	static void move_script(const String &p_from, const String &p_to);
 	static void remove_script(const String &p_path);
 	static Ref<GDScriptParserRef> get_parser(const String &p_path, GDScriptParserRef::Status status, Error &r_error, const String &p_owner = String());
+	// Parses the scripts and the ones they depend on in parallel. The parsers stay cached while the returned references are kept.
+	static Vector<Ref<GDScriptParserRef>> parse_scripts(const Vector<String> &p_paths);
 	static bool has_parser(const String &p_path);
 	static void remove_parser(const String &p_path);
 	static String get_source_code(const String &p_path);
 	static Vector<uint8_t> get_binary_tokens(const String &p_path);
+	static Vector<uint8_t> get_bytecode_cache(const String &p_path);
 	static Ref<GDScript> get_shallow_script(const String &p_path, Error &r_error, const String &p_owner = String());
 	/**
 	 * Returns a fully loaded GDScript using an already cached script if one exists.
@@ -127,6 +140,7 @@ public:
 	static Error finish_compiling(const String &p_owner);
 	static void add_static_script(Ref<GDScript> p_script);
 	static void remove_static_script(const String &p_fqcn);
+	static bool has_static_script(const String &p_fqcn);
 
 	static void clear();
 
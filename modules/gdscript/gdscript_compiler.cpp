@@ -3319,6 +3319,28 @@ void GDScriptCompiler::_get_function_ptr_replacements(HashMap<GDScriptFunction *
 	}
 }
 
+void GDScriptCompiler::_collect_functions(GDScriptFunction *p_func, LocalVector<GDScriptFunction *> &r_functions) {
+	if (!p_func || r_functions.has(p_func)) {
+		return;
+	}
+	r_functions.push_back(p_func);
+	for (GDScriptFunction *lambda : p_func->lambdas) {
+		_collect_functions(lambda, r_functions);
+	}
+}
+
+void GDScriptCompiler::_collect_functions(GDScript *p_script, LocalVector<GDScriptFunction *> &r_functions) {
+	_collect_functions(p_script->implicit_initializer, r_functions);
+	_collect_functions(p_script->implicit_ready, r_functions);
+	_collect_functions(p_script->static_initializer, r_functions);
+	for (const KeyValue<StringName, GDScriptFunction *> &E : p_script->member_functions) {
+		_collect_functions(E.value, r_functions);
+	}
+	for (const KeyValue<StringName, Ref<GDScript>> &E : p_script->subclasses) {
+		_collect_functions(E.value.ptr(), r_functions);
+	}
+}
+
 Error GDScriptCompiler::compile(const GDScriptParser *p_parser, GDScript *p_script, bool p_keep_state) {
 	err_line = -1;
 	err_column = -1;
@@ -3352,6 +3374,12 @@ Error GDScriptCompiler::compile(const GDScriptParser *p_parser, GDScript *p_scri
 	_get_function_ptr_replacements(func_ptr_replacements, old_lambda_info, &new_lambda_info);
 	main_script->_recurse_replace_function_ptrs(func_ptr_replacements);
 
+	if (GDScriptLanguage::get_singleton()->is_jit_enabled()) {
+		LocalVector<GDScriptFunction *> functions;
+		_collect_functions(main_script, functions);
+		GDScriptJIT::compile(functions);
+	}
+
 	if (has_static_data && !root->annotated_static_unload) {
 		GDScriptCache::add_static_script(p_script);
 	}
@@ -142,6 +142,45 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 
 				incr += 5;
 			} break;
+
+#define DISASSEMBLE_TYPED_OPERATOR(m_opcode, m_operator) \
+	case OPCODE_##m_opcode: { \
+		text += "typed operator ("; \
+		text += #m_opcode; \
+		text += ") "; \
+		text += DADDR(3); \
+		text += " = "; \
+		text += DADDR(1); \
+		text += " " m_operator " "; \
+		text += DADDR(2); \
+		incr += 4; \
+	} break
+
+				DISASSEMBLE_TYPED_OPERATOR(ADD_INT, "+");
+				DISASSEMBLE_TYPED_OPERATOR(SUBTRACT_INT, "-");
+				DISASSEMBLE_TYPED_OPERATOR(MULTIPLY_INT, "*");
+				DISASSEMBLE_TYPED_OPERATOR(EQUAL_INT, "==");
+				DISASSEMBLE_TYPED_OPERATOR(NOT_EQUAL_INT, "!=");
+				DISASSEMBLE_TYPED_OPERATOR(LESS_INT, "<");
+				DISASSEMBLE_TYPED_OPERATOR(LESS_EQUAL_INT, "<=");
+				DISASSEMBLE_TYPED_OPERATOR(GREATER_INT, ">");
+				DISASSEMBLE_TYPED_OPERATOR(GREATER_EQUAL_INT, ">=");
+				DISASSEMBLE_TYPED_OPERATOR(ADD_FLOAT, "+");
+				DISASSEMBLE_TYPED_OPERATOR(SUBTRACT_FLOAT, "-");
+				DISASSEMBLE_TYPED_OPERATOR(MULTIPLY_FLOAT, "*");
+				DISASSEMBLE_TYPED_OPERATOR(DIVIDE_FLOAT, "/");
+				DISASSEMBLE_TYPED_OPERATOR(LESS_FLOAT, "<");
+				DISASSEMBLE_TYPED_OPERATOR(LESS_EQUAL_FLOAT, "<=");
+				DISASSEMBLE_TYPED_OPERATOR(GREATER_FLOAT, ">");
+				DISASSEMBLE_TYPED_OPERATOR(GREATER_EQUAL_FLOAT, ">=");
+				DISASSEMBLE_TYPED_OPERATOR(ADD_VECTOR2, "+");
+				DISASSEMBLE_TYPED_OPERATOR(SUBTRACT_VECTOR2, "-");
+				DISASSEMBLE_TYPED_OPERATOR(MULTIPLY_VECTOR2, "*");
+				DISASSEMBLE_TYPED_OPERATOR(MULTIPLY_VECTOR2_FLOAT, "*");
+				DISASSEMBLE_TYPED_OPERATOR(ADD_VECTOR3, "+");
+				DISASSEMBLE_TYPED_OPERATOR(SUBTRACT_VECTOR3, "-");
+				DISASSEMBLE_TYPED_OPERATOR(MULTIPLY_VECTOR3, "*");
+				DISASSEMBLE_TYPED_OPERATOR(MULTIPLY_VECTOR3_FLOAT, "*");
 			case OPCODE_TYPE_TEST_BUILTIN: {
 				text += "type test ";
 				text += DADDR(1);
@@ -412,6 +451,22 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 
 				incr += 3;
 			} break;
+
+#define DISASSEMBLE_ASSIGN_TYPED_VALUE(m_v_type) \
+	case OPCODE_ASSIGN_##m_v_type: { \
+		text += "assign ("; \
+		text += #m_v_type; \
+		text += ") "; \
+		text += DADDR(1); \
+		text += " = "; \
+		text += DADDR(2); \
+		incr += 3; \
+	} break
+
+				DISASSEMBLE_ASSIGN_TYPED_VALUE(INT);
+				DISASSEMBLE_ASSIGN_TYPED_VALUE(FLOAT);
+				DISASSEMBLE_ASSIGN_TYPED_VALUE(VECTOR2);
+				DISASSEMBLE_ASSIGN_TYPED_VALUE(VECTOR3);
 			case OPCODE_ASSIGN_NULL: {
 				text += "assign ";
 				text += DADDR(1);
@@ -33,6 +33,7 @@
 #include "gdscript.h"
 
 #include "core/object/class_db.h"
+#include "core/os/spin_lock.h"
 
 bool GDScriptDataType::is_type(const Variant &p_variant, bool p_allow_implicit_conversion) const {
 	switch (kind) {
@@ -223,6 +224,69 @@ void GDScriptFunction::debug_get_stack_member_state(int p_line, List<Pair<String
 	}
 }
 
+// Free frames are kept per size class, linked through their first bytes. Frames bigger than
+// the largest class are rare enough to go straight to the allocator.
+static constexpr uint32_t FRAME_GRANULARITY = 64;
+static constexpr uint32_t FRAME_CLASS_COUNT = 64;
+static constexpr uint32_t FRAME_MAX_CACHED_BYTES = 256 * 1024; // Per size class.
+
+struct FramePoolClass {
+	SpinLock spin_lock;
+	uint8_t *free_list = nullptr;
+	uint32_t free_count = 0;
+};
+
+static FramePoolClass frame_pool[FRAME_CLASS_COUNT];
+
+uint8_t *GDScriptFunction::_alloc_frame(uint32_t p_size) {
+	const uint32_t size_class = (p_size + FRAME_GRANULARITY - 1) / FRAME_GRANULARITY;
+	if (size_class > FRAME_CLASS_COUNT) {
+		return (uint8_t *)Memory::alloc_static(p_size);
+	}
+
+	FramePoolClass &pool = frame_pool[size_class - 1];
+	pool.spin_lock.lock();
+	uint8_t *frame = pool.free_list;
+	if (frame) {
+		pool.free_list = *(uint8_t **)frame;
+		pool.free_count--;
+		pool.spin_lock.unlock();
+		return frame;
+	}
+	pool.spin_lock.unlock();
+	return (uint8_t *)Memory::alloc_static(size_class * FRAME_GRANULARITY);
+}
+
+void GDScriptFunction::_free_frame(uint8_t *p_frame, uint32_t p_size) {
+	const uint32_t size_class = (p_size + FRAME_GRANULARITY - 1) / FRAME_GRANULARITY;
+	if (size_class <= FRAME_CLASS_COUNT) {
+		FramePoolClass &pool = frame_pool[size_class - 1];
+		pool.spin_lock.lock();
+		if (pool.free_count < FRAME_MAX_CACHED_BYTES / (size_class * FRAME_GRANULARITY)) {
+			*(uint8_t **)p_frame = pool.free_list;
+			pool.free_list = p_frame;
+			pool.free_count++;
+			pool.spin_lock.unlock();
+			return;
+		}
+		pool.spin_lock.unlock();
+	}
+	Memory::free_static(p_frame);
+}
+
+void GDScriptFunction::clear_frame_pool() {
+	for (FramePoolClass &pool : frame_pool) {
+		pool.spin_lock.lock();
+		while (pool.free_list) {
+			uint8_t *frame = pool.free_list;
+			pool.free_list = *(uint8_t **)frame;
+			Memory::free_static(frame);
+		}
+		pool.free_count = 0;
+		pool.spin_lock.unlock();
+	}
+}
+
 GDScriptFunction::GDScriptFunction() {
 	name = "<anonymous>";
 #ifdef DEBUG_ENABLED
@@ -245,6 +309,10 @@ GDScriptFunction::~GDScriptFunction() {
 	}
 	return_type.script_type_ref = Ref<Script>();
 
+	if (_jit_block) {
+		GDScriptJIT::release(_jit_block);
+	}
+
 #ifdef DEBUG_ENABLED
 	MutexLock lock(GDScriptLanguage::get_singleton()->mutex);
 	GDScriptLanguage::get_singleton()->function_list.remove(&function_list);
@@ -341,13 +409,15 @@ Variant GDScriptFunctionState::resume(const Variant &p_arg) {
 }
 
 void GDScriptFunctionState::_clear_stack() {
-	if (state.stack_size) {
-		Variant *stack = (Variant *)state.stack.ptr();
+	if (state.stack) {
+		Variant *stack = (Variant *)state.stack;
 		// First `GDScriptFunction::FIXED_ADDRESSES_MAX` stack addresses are special
-		// and not copied to the state, so we skip them here.
+		// and rebuilt on resume, so we skip them here.
 		for (int i = GDScriptFunction::FIXED_ADDRESSES_MAX; i < state.stack_size; i++) {
 			stack[i].~Variant();
 		}
+		GDScriptFunction::_free_frame(state.stack, state.stack_alloc_size);
+		state.stack = nullptr;
 		state.stack_size = 0;
 	}
 }
@@ -30,6 +30,7 @@
 
 #pragma once
 
+#include "gdscript_jit.h"
 #include "gdscript_utility_functions.h"
 
 #include "core/object/ref_counted.h"
@@ -152,6 +153,34 @@ public:
 	enum Opcode {
 		OPCODE_OPERATOR,
 		OPCODE_OPERATOR_VALIDATED,
+		// Validated operators on int, float and vector operands. They read and write the values inside
+		// the Variant slots directly, instead of calling the evaluator of OPCODE_OPERATOR_VALIDATED.
+		// Typed locals still live in Variant slots, they don't have raw int64_t/double/vector slots yet.
+		OPCODE_ADD_INT,
+		OPCODE_SUBTRACT_INT,
+		OPCODE_MULTIPLY_INT,
+		OPCODE_EQUAL_INT,
+		OPCODE_NOT_EQUAL_INT,
+		OPCODE_LESS_INT,
+		OPCODE_LESS_EQUAL_INT,
+		OPCODE_GREATER_INT,
+		OPCODE_GREATER_EQUAL_INT,
+		OPCODE_ADD_FLOAT,
+		OPCODE_SUBTRACT_FLOAT,
+		OPCODE_MULTIPLY_FLOAT,
+		OPCODE_DIVIDE_FLOAT,
+		OPCODE_LESS_FLOAT,
+		OPCODE_LESS_EQUAL_FLOAT,
+		OPCODE_GREATER_FLOAT,
+		OPCODE_GREATER_EQUAL_FLOAT,
+		OPCODE_ADD_VECTOR2,
+		OPCODE_SUBTRACT_VECTOR2,
+		OPCODE_MULTIPLY_VECTOR2,
+		OPCODE_MULTIPLY_VECTOR2_FLOAT,
+		OPCODE_ADD_VECTOR3,
+		OPCODE_SUBTRACT_VECTOR3,
+		OPCODE_MULTIPLY_VECTOR3,
+		OPCODE_MULTIPLY_VECTOR3_FLOAT,
 		OPCODE_TYPE_TEST_BUILTIN,
 		OPCODE_TYPE_TEST_ARRAY,
 		OPCODE_TYPE_TEST_DICTIONARY,
@@ -175,6 +204,11 @@ public:
 		OPCODE_ASSIGN_NULL,
 		OPCODE_ASSIGN_TRUE,
 		OPCODE_ASSIGN_FALSE,
+		// Assignments between values of the same type, copying the value directly.
+		OPCODE_ASSIGN_INT,
+		OPCODE_ASSIGN_FLOAT,
+		OPCODE_ASSIGN_VECTOR2,
+		OPCODE_ASSIGN_VECTOR3,
 		OPCODE_ASSIGN_TYPED_BUILTIN,
 		OPCODE_ASSIGN_TYPED_ARRAY,
 		OPCODE_ASSIGN_TYPED_DICTIONARY,
@@ -339,13 +373,17 @@ public:
 
 private:
 	friend class GDScript;
+	friend class GDScriptBytecodeCache;
 	friend class GDScriptCompiler;
 	friend class GDScriptByteCodeGenerator;
 	friend class GDScriptLanguage;
+	friend class GDScriptFunctionState;
+	friend class GDScriptJIT;
 
 	StringName name;
 	StringName source;
 	bool _static = false;
+	bool _is_coroutine = false;
 	Vector<GDScriptDataType> argument_types;
 	GDScriptDataType return_type;
 	MethodInfo method_info;
@@ -381,6 +419,7 @@ private:
 	Vector<GDScriptUtilityFunctions::FunctionPtr> gds_utilities;
 	Vector<MethodBind *> methods;
 	Vector<GDScriptFunction *> lambdas;
+	Vector<int> global_accesses; // Positions of the global load instructions, which the bytecode cache relocates.
 
 	int _code_size = 0;
 	int _default_arg_count = 0;
@@ -418,6 +457,9 @@ private:
 	MethodBind **_methods_ptr = nullptr;
 	GDScriptFunction **_lambdas_ptr = nullptr;
 
+	GDScriptJIT::Code _jit_code = nullptr;
+	GDScriptJIT::CodeBlock *_jit_block = nullptr;
+
 #ifdef DEBUG_ENABLED
 	CharString func_cname;
 	const char *_func_cname = nullptr;
@@ -455,6 +497,11 @@ private:
 	String _get_callable_call_error(const String &p_where, const Callable &p_callable, const Variant **p_argptrs, int p_argcount, const Variant &p_ret, const Callable::CallError &p_err) const;
 	Variant _get_default_variant_for_data_type(const GDScriptDataType &p_data_type);
 
+	// Frames of functions containing `await` are taken from a pool instead of the native stack,
+	// so a suspended call can hand its frame to the `GDScriptFunctionState` and be resumed in place.
+	static uint8_t *_alloc_frame(uint32_t p_size);
+	static void _free_frame(uint8_t *p_frame, uint32_t p_size);
+
 public:
 	static constexpr int MAX_CALL_DEPTH = 2048; // Limit to try to avoid crash because of a stack overflow.
 
@@ -466,7 +513,9 @@ public:
 		StringName function_name;
 		String script_path;
 #endif
-		Vector<uint8_t> stack;
+		// The frame of the suspended call, owned by the state until the call is resumed.
+		uint8_t *stack = nullptr;
+		uint32_t stack_alloc_size = 0;
 		int stack_size = 0;
 		int ip = 0;
 		int line = 0;
@@ -479,10 +528,12 @@ public:
 	_FORCE_INLINE_ GDScript *get_script() const { return _script; }
 	_FORCE_INLINE_ bool is_static() const { return _static; }
 	_FORCE_INLINE_ bool is_vararg() const { return _vararg_index >= 0; }
+	_FORCE_INLINE_ bool is_coroutine() const { return _is_coroutine; }
 	_FORCE_INLINE_ MethodInfo get_method_info() const { return method_info; }
 	_FORCE_INLINE_ int get_argument_count() const { return _argument_count; }
 	_FORCE_INLINE_ Variant get_rpc_config() const { return rpc_config; }
 	_FORCE_INLINE_ int get_max_stack_size() const { return _stack_size; }
+	_FORCE_INLINE_ bool is_jit_compiled() const { return _jit_code != nullptr; }
 
 	Variant get_constant(int p_idx) const;
 	StringName get_global_name(int p_idx) const;
@@ -490,6 +541,8 @@ public:
 	Variant call(GDScriptInstance *p_instance, const Variant **p_args, int p_argcount, Callable::CallError &r_err, CallState *p_state = nullptr);
 	void debug_get_stack_member_state(int p_line, List<Pair<StringName, int>> *r_stackvars) const;
 
+	static void clear_frame_pool();
+
 #ifdef DEBUG_ENABLED
 	void _profile_native_call(uint64_t p_t_taken, const String &p_function_name, const String &p_instance_class_name = String());
 	void disassemble(const Vector<String> &p_code_lines) const;
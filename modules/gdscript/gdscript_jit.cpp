@@ -0,0 +1,1627 @@
+/**************************************************************************/
+/*  gdscript_jit.cpp                                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_jit.h"
+
+#include "gdscript_function.h"
+
+#include "core/object/method_bind.h"
+#include "core/templates/hash_map.h"
+#include "core/variant/variant_internal.h"
+
+// GDSCRIPT_JIT_ENABLED comes from the SCsub, for x86-64 builds with the `gdscript_jit` option.
+// There is no AArch64 backend, so ARM builds (e.g. Android and iOS devices) always use the VM.
+#if defined(GDSCRIPT_JIT_ENABLED) && !((defined(__x86_64__) || defined(_M_X64)) && (defined(WINDOWS_ENABLED) || defined(UNIX_ENABLED)))
+#undef GDSCRIPT_JIT_ENABLED
+#endif
+
+#ifdef GDSCRIPT_JIT_ENABLED
+
+#ifdef WINDOWS_ENABLED
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+namespace {
+
+enum Reg {
+	RAX,
+	RCX,
+	RDX,
+	RBX,
+	RSP,
+	RBP,
+	RSI,
+	RDI,
+	R8,
+	R9,
+	R10,
+	R11,
+	R12,
+	R13,
+	R14,
+	R15,
+};
+
+enum XMMReg {
+	XMM0,
+	XMM1,
+};
+
+enum Cond {
+	COND_B = 0x2,
+	COND_AE = 0x3,
+	COND_E = 0x4,
+	COND_NE = 0x5,
+	COND_A = 0x7,
+	COND_S = 0x8,
+	COND_P = 0xA,
+	COND_NP = 0xB,
+	COND_L = 0xC,
+	COND_GE = 0xD,
+	COND_LE = 0xE,
+	COND_G = 0xF,
+};
+
+enum ALUOp {
+	ALU_ADD = 0x01,
+	ALU_OR = 0x09,
+	ALU_AND = 0x21,
+	ALU_SUB = 0x29,
+	ALU_XOR = 0x31,
+	ALU_CMP = 0x39,
+};
+
+enum SSEOp {
+	SSE_ADD = 0x58,
+	SSE_MUL = 0x59,
+	SSE_SUB = 0x5C,
+	SSE_DIV = 0x5E,
+};
+
+#ifdef _WIN32
+constexpr Reg ARG_REGS[4] = { RCX, RDX, R8, R9 };
+#else
+constexpr Reg ARG_REGS[4] = { RDI, RSI, RDX, RCX };
+#endif
+
+// Registers holding the state of the call, callee-saved in both the System V and the Windows ABI.
+constexpr Reg REG_STACK = RBX;
+constexpr Reg REG_MEMBERS = R12;
+constexpr Reg REG_INSTRUCTION_ARGS = R13;
+constexpr Reg REG_FRAME = R14;
+constexpr Reg REG_CONSTANTS = R15;
+
+// Shadow space required by the Windows ABI, followed by scratch space for out parameters.
+constexpr int32_t STACK_SHADOW_SIZE = 32;
+constexpr int32_t STACK_FRAME_SIZE = 48;
+
+struct Mem {
+	Reg base = RAX;
+	int32_t disp = 0;
+
+	Mem offset(int32_t p_offset) const { return { base, disp + p_offset }; }
+};
+
+// Minimal x86-64 encoder for the instructions the compiler needs.
+// Memory operands are always `[base + disp32]`.
+class Assembler {
+	LocalVector<uint8_t> &code;
+
+	void _byte(uint8_t p_byte) { code.push_back(p_byte); }
+
+	void _dword(uint32_t p_dword) {
+		for (int i = 0; i < 4; i++) {
+			code.push_back((p_dword >> (i * 8)) & 0xFF);
+		}
+	}
+
+	void _rex(bool p_wide, int p_reg, int p_base) {
+		const uint8_t rex = 0x40 | (p_wide ? 0x08 : 0) | ((p_reg & 8) >> 1) | ((p_base & 8) >> 3);
+		if (rex != 0x40) {
+			_byte(rex);
+		}
+	}
+
+	void _mem(int p_prefix, bool p_wide, std::initializer_list<uint8_t> p_opcode, int p_reg, const Mem &p_mem) {
+		if (p_prefix) {
+			_byte(p_prefix);
+		}
+		_rex(p_wide, p_reg, p_mem.base);
+		for (uint8_t b : p_opcode) {
+			_byte(b);
+		}
+		_byte(0x80 | ((p_reg & 7) << 3) | (p_mem.base & 7));
+		if ((p_mem.base & 7) == RSP) {
+			_byte(0x24); // SIB byte, needed for RSP and R12.
+		}
+		_dword(p_mem.disp);
+	}
+
+	void _reg(int p_prefix, bool p_wide, std::initializer_list<uint8_t> p_opcode, int p_reg, int p_rm) {
+		if (p_prefix) {
+			_byte(p_prefix);
+		}
+		_rex(p_wide, p_reg, p_rm);
+		for (uint8_t b : p_opcode) {
+			_byte(b);
+		}
+		_byte(0xC0 | ((p_reg & 7) << 3) | (p_rm & 7));
+	}
+
+public:
+	uint32_t position() const { return code.size(); }
+
+	void align(uint32_t p_alignment) {
+		while (code.size() % p_alignment) {
+			_byte(0xCC);
+		}
+	}
+
+	void push(Reg p_reg) {
+		_rex(false, 0, p_reg);
+		_byte(0x50 + (p_reg & 7));
+	}
+
+	void pop(Reg p_reg) {
+		_rex(false, 0, p_reg);
+		_byte(0x58 + (p_reg & 7));
+	}
+
+	void ret() { _byte(0xC3); }
+
+	void mov(Reg p_dst, Reg p_src) { _reg(0, true, { 0x89 }, p_src, p_dst); }
+
+	void mov_imm(Reg p_dst, uint64_t p_imm) {
+		if (p_imm <= UINT32_MAX) {
+			_rex(false, 0, p_dst);
+			_byte(0xB8 + (p_dst & 7));
+			_dword(p_imm);
+		} else {
+			_rex(true, 0, p_dst);
+			_byte(0xB8 + (p_dst & 7));
+			_dword(p_imm & UINT32_MAX);
+			_dword(p_imm >> 32);
+		}
+	}
+
+	void mov_ptr(Reg p_dst, const void *p_ptr) { mov_imm(p_dst, (uint64_t)(uintptr_t)p_ptr); }
+
+	void load(Reg p_dst, const Mem &p_src) { _mem(0, true, { 0x8B }, p_dst, p_src); }
+	void load32(Reg p_dst, const Mem &p_src) { _mem(0, false, { 0x8B }, p_dst, p_src); }
+	void store(const Mem &p_dst, Reg p_src) { _mem(0, true, { 0x89 }, p_src, p_dst); }
+	// Only the low byte of RAX, RCX, RDX and RBX can be stored, others need a REX prefix with a different meaning.
+	void store8(const Mem &p_dst, Reg p_src) { _mem(0, false, { 0x88 }, p_src, p_dst); }
+	void lea(Reg p_dst, const Mem &p_src) { _mem(0, true, { 0x8D }, p_dst, p_src); }
+
+	// `op dst, [mem]`, the register forms of the ALU opcodes are 2 above the memory destination ones.
+	void alu(ALUOp p_op, Reg p_dst, const Mem &p_src) { _mem(0, true, { uint8_t(p_op + 2) }, p_dst, p_src); }
+	void alu(ALUOp p_op, Reg p_dst, Reg p_src) { _reg(0, true, { uint8_t(p_op) }, p_src, p_dst); }
+	void alu8(ALUOp p_op, Reg p_dst, Reg p_src) { _reg(0, false, { uint8_t(p_op - 1) }, p_src, p_dst); }
+	void imul(Reg p_dst, const Mem &p_src) { _mem(0, true, { 0x0F, 0xAF }, p_dst, p_src); }
+	void neg(Reg p_reg) { _reg(0, true, { 0xF7 }, 3, p_reg); }
+	void btc(Reg p_reg, uint8_t p_bit) {
+		_reg(0, true, { 0x0F, 0xBA }, 7, p_reg);
+		_byte(p_bit);
+	}
+	void add_imm(Reg p_reg, int32_t p_imm) {
+		_reg(0, true, { 0x81 }, 0, p_reg);
+		_dword(p_imm);
+	}
+	void sub_imm(Reg p_reg, int32_t p_imm) {
+		_reg(0, true, { 0x81 }, 5, p_reg);
+		_dword(p_imm);
+	}
+	void cmp32_imm(Reg p_reg, int32_t p_imm) {
+		_reg(0, false, { 0x81 }, 7, p_reg);
+		_dword(p_imm);
+	}
+	void cmp32_imm(const Mem &p_mem, int32_t p_imm) {
+		_mem(0, false, { 0x81 }, 7, p_mem);
+		_dword(p_imm);
+	}
+	void store32_imm(const Mem &p_mem, int32_t p_imm) {
+		_mem(0, false, { 0xC7 }, 0, p_mem);
+		_dword(p_imm);
+	}
+	void cmp8_imm(const Mem &p_mem, uint8_t p_imm) {
+		_mem(0, false, { 0x80 }, 7, p_mem);
+		_byte(p_imm);
+	}
+	void cmp32(Reg p_reg, const Mem &p_mem) { _mem(0, false, { 0x3B }, p_reg, p_mem); }
+	void test(Reg p_a, Reg p_b) { _reg(0, true, { 0x85 }, p_b, p_a); }
+	void test8(Reg p_a, Reg p_b) { _reg(0, false, { 0x84 }, p_b, p_a); }
+	void setcc(Cond p_cond, Reg p_dst) { _reg(0, false, { 0x0F, uint8_t(0x90 + p_cond) }, 0, p_dst); }
+
+	void movsd(XMMReg p_dst, const Mem &p_src) { _mem(0xF2, false, { 0x0F, 0x10 }, p_dst, p_src); }
+	void movsd(const Mem &p_dst, XMMReg p_src) { _mem(0xF2, false, { 0x0F, 0x11 }, p_src, p_dst); }
+	void sse(SSEOp p_op, XMMReg p_dst, const Mem &p_src) { _mem(0xF2, false, { 0x0F, uint8_t(p_op) }, p_dst, p_src); }
+	void sse(SSEOp p_op, XMMReg p_dst, XMMReg p_src) { _reg(0xF2, false, { 0x0F, uint8_t(p_op) }, p_dst, p_src); }
+	void cvtsi2sd(XMMReg p_dst, const Mem &p_src) { _mem(0xF2, true, { 0x0F, 0x2A }, p_dst, p_src); }
+	void ucomisd(XMMReg p_a, XMMReg p_b) { _reg(0x66, false, { 0x0F, 0x2E }, p_a, p_b); }
+
+	void call(Reg p_reg) { _reg(0, false, { 0xFF }, 2, p_reg); }
+
+	void call(const void *p_function) {
+		mov_ptr(RAX, p_function);
+		call(RAX);
+	}
+
+	// Jumps return the position of their 32-bit displacement, to be patched once the target is known.
+	uint32_t jmp() {
+		_byte(0xE9);
+		_dword(0);
+		return position() - 4;
+	}
+
+	uint32_t jcc(Cond p_cond) {
+		_byte(0x0F);
+		_byte(0x80 + p_cond);
+		_dword(0);
+		return position() - 4;
+	}
+
+	void patch_dword(uint32_t p_position, int32_t p_dword) { memcpy(&code[p_position], &p_dword, sizeof(p_dword)); }
+	void patch(uint32_t p_jump, uint32_t p_target) { patch_dword(p_jump, int32_t(p_target) - int32_t(p_jump + 4)); }
+
+	void bind(uint32_t p_jump) { patch(p_jump, position()); }
+
+	Assembler(LocalVector<uint8_t> &r_code) :
+			code(r_code) {}
+};
+
+} // namespace
+
+// Slow paths called from compiled code. They mirror the corresponding instructions in the VM, and return `false`
+// instead of breaking on errors, so the VM executes the instruction again and reports the error.
+
+static void _assign(Variant *p_dst, const Variant *p_src) {
+	*p_dst = *p_src;
+}
+
+static void _assign_null(Variant *p_dst) {
+	*p_dst = Variant();
+}
+
+static void _assign_bool(Variant *p_dst, bool p_value) {
+	*p_dst = p_value;
+}
+
+static bool _assign_typed_builtin(Variant *p_dst, Variant *p_src, Variant::Type p_type) {
+	if (p_src->get_type() != p_type) {
+#ifdef DEBUG_ENABLED
+		if (!Variant::can_convert_strict(p_src->get_type(), p_type)) {
+			return false;
+		}
+#endif // DEBUG_ENABLED
+		Callable::CallError ce;
+		Variant::construct(p_type, *p_dst, const_cast<const Variant **>(&p_src), 1, ce);
+	} else {
+		*p_dst = *p_src;
+	}
+	return true;
+}
+
+static bool _return_typed_builtin(Variant *r_ret, Variant *p_value, Variant::Type p_type) {
+	if (p_value->get_type() != p_type) {
+		if (!Variant::can_convert_strict(p_value->get_type(), p_type)) {
+			return false;
+		}
+		Callable::CallError ce;
+		Variant::construct(p_type, *r_ret, const_cast<const Variant **>(&p_value), 1, ce);
+	} else {
+		*r_ret = *p_value;
+	}
+	return true;
+}
+
+static bool _booleanize(const Variant *p_value) {
+	return p_value->booleanize();
+}
+
+static void _initialize_int(Variant *p_dst, int64_t p_value) {
+	VariantInternal::initialize(p_dst, Variant::INT);
+	*VariantInternal::get_int(p_dst) = p_value;
+}
+
+#ifdef DEBUG_ENABLED
+static bool _get_keyed(Variant::ValidatedKeyedGetter p_getter, const Variant *p_src, const Variant *p_key, Variant *r_dst) {
+	// Like the VM, use a temporary so the source is left untouched on errors when it's also the destination.
+	Variant ret;
+	bool valid;
+	p_getter(p_src, p_key, &ret, &valid);
+	if (!valid) {
+		return false;
+	}
+	*r_dst = ret;
+	return true;
+}
+#endif // DEBUG_ENABLED
+
+static _FORCE_INLINE_ bool _get_method_base(Variant *p_base, Object *&r_object) {
+#ifdef DEBUG_ENABLED
+	bool freed = false;
+	r_object = p_base->get_validated_object_with_check(freed);
+	return !freed && r_object;
+#else
+	r_object = *VariantInternal::get_object(p_base);
+	return true;
+#endif // DEBUG_ENABLED
+}
+
+static bool _call_method_bind(MethodBind *p_method, Variant *p_base, const Variant **p_args, Variant *r_ret) {
+	Object *object;
+	if (!_get_method_base(p_base, object)) {
+		return false;
+	}
+	p_method->validated_call(object, p_args, r_ret);
+	return true;
+}
+
+static bool _call_method_bind_no_return(MethodBind *p_method, Variant *p_base, const Variant **p_args, Variant *r_ret) {
+	Object *object;
+	if (!_get_method_base(p_base, object)) {
+		return false;
+	}
+	VariantInternal::initialize(r_ret, Variant::NIL);
+	p_method->validated_call(object, p_args, nullptr);
+	return true;
+}
+
+static void _call_native_static(MethodBind *p_method, const Variant **p_args, Variant *r_ret) {
+	p_method->validated_call(nullptr, p_args, r_ret);
+}
+
+static void _call_native_static_no_return(MethodBind *p_method, const Variant **p_args, Variant *r_ret) {
+	VariantInternal::initialize(r_ret, Variant::NIL);
+	p_method->validated_call(nullptr, p_args, nullptr);
+}
+
+template <typename T>
+static void _type_adjust(Variant *p_value) {
+	VariantTypeAdjust<T>::adjust(p_value);
+}
+
+// In the same order as the `OPCODE_TYPE_ADJUST_*` opcodes.
+static void (*const type_adjust_funcs[])(Variant *) = {
+	_type_adjust<bool>,
+	_type_adjust<int64_t>,
+	_type_adjust<double>,
+	_type_adjust<String>,
+	_type_adjust<Vector2>,
+	_type_adjust<Vector2i>,
+	_type_adjust<Rect2>,
+	_type_adjust<Rect2i>,
+	_type_adjust<Vector3>,
+	_type_adjust<Vector3i>,
+	_type_adjust<Transform2D>,
+	_type_adjust<Vector4>,
+	_type_adjust<Vector4i>,
+	_type_adjust<Plane>,
+	_type_adjust<Quaternion>,
+	_type_adjust<AABB>,
+	_type_adjust<Basis>,
+	_type_adjust<Transform3D>,
+	_type_adjust<Projection>,
+	_type_adjust<Color>,
+	_type_adjust<StringName>,
+	_type_adjust<NodePath>,
+	_type_adjust<RID>,
+	_type_adjust<Object *>,
+	_type_adjust<Callable>,
+	_type_adjust<Signal>,
+	_type_adjust<Dictionary>,
+	_type_adjust<Array>,
+	_type_adjust<PackedByteArray>,
+	_type_adjust<PackedInt32Array>,
+	_type_adjust<PackedInt64Array>,
+	_type_adjust<PackedFloat32Array>,
+	_type_adjust<PackedFloat64Array>,
+	_type_adjust<PackedStringArray>,
+	_type_adjust<PackedVector2Array>,
+	_type_adjust<PackedVector3Array>,
+	_type_adjust<PackedColorArray>,
+	_type_adjust<PackedVector4Array>,
+};
+static_assert(std_size(type_adjust_funcs) == GDScriptFunction::OPCODE_TYPE_ADJUST_PACKED_VECTOR4_ARRAY - GDScriptFunction::OPCODE_TYPE_ADJUST_BOOL + 1);
+
+// Validated operators on int, float and bool which are emitted inline instead of calling the evaluator.
+struct InlineOperator {
+	Variant::Operator op = Variant::OP_MAX;
+	Variant::Type left = Variant::NIL;
+	Variant::Type right = Variant::NIL;
+};
+
+// Operators of the `OPCODE_ADD_INT` to `OPCODE_MULTIPLY_VECTOR3_FLOAT` opcodes, in the same order.
+static const InlineOperator typed_operators[] = {
+	{ Variant::OP_ADD, Variant::INT, Variant::INT },
+	{ Variant::OP_SUBTRACT, Variant::INT, Variant::INT },
+	{ Variant::OP_MULTIPLY, Variant::INT, Variant::INT },
+	{ Variant::OP_EQUAL, Variant::INT, Variant::INT },
+	{ Variant::OP_NOT_EQUAL, Variant::INT, Variant::INT },
+	{ Variant::OP_LESS, Variant::INT, Variant::INT },
+	{ Variant::OP_LESS_EQUAL, Variant::INT, Variant::INT },
+	{ Variant::OP_GREATER, Variant::INT, Variant::INT },
+	{ Variant::OP_GREATER_EQUAL, Variant::INT, Variant::INT },
+	{ Variant::OP_ADD, Variant::FLOAT, Variant::FLOAT },
+	{ Variant::OP_SUBTRACT, Variant::FLOAT, Variant::FLOAT },
+	{ Variant::OP_MULTIPLY, Variant::FLOAT, Variant::FLOAT },
+	{ Variant::OP_DIVIDE, Variant::FLOAT, Variant::FLOAT },
+	{ Variant::OP_LESS, Variant::FLOAT, Variant::FLOAT },
+	{ Variant::OP_LESS_EQUAL, Variant::FLOAT, Variant::FLOAT },
+	{ Variant::OP_GREATER, Variant::FLOAT, Variant::FLOAT },
+	{ Variant::OP_GREATER_EQUAL, Variant::FLOAT, Variant::FLOAT },
+	{ Variant::OP_ADD, Variant::VECTOR2, Variant::VECTOR2 },
+	{ Variant::OP_SUBTRACT, Variant::VECTOR2, Variant::VECTOR2 },
+	{ Variant::OP_MULTIPLY, Variant::VECTOR2, Variant::VECTOR2 },
+	{ Variant::OP_MULTIPLY, Variant::VECTOR2, Variant::FLOAT },
+	{ Variant::OP_ADD, Variant::VECTOR3, Variant::VECTOR3 },
+	{ Variant::OP_SUBTRACT, Variant::VECTOR3, Variant::VECTOR3 },
+	{ Variant::OP_MULTIPLY, Variant::VECTOR3, Variant::VECTOR3 },
+	{ Variant::OP_MULTIPLY, Variant::VECTOR3, Variant::FLOAT },
+};
+static_assert(std_size(typed_operators) == GDScriptFunction::OPCODE_MULTIPLY_VECTOR3_FLOAT - GDScriptFunction::OPCODE_ADD_INT + 1);
+
+struct InlineOperators {
+	HashMap<Variant::ValidatedOperatorEvaluator, InlineOperator> operators;
+
+	void add(Variant::Operator p_op, Variant::Type p_left, Variant::Type p_right, Variant::Type p_return) {
+		Variant::ValidatedOperatorEvaluator evaluator = Variant::get_validated_operator_evaluator(p_op, p_left, p_right);
+		if (evaluator && Variant::get_operator_return_type(p_op, p_left, p_right) == p_return && !operators.has(evaluator)) {
+			operators.insert(evaluator, { p_op, p_left, p_right });
+		}
+	}
+
+	InlineOperators() {
+		static const Variant::Operator int_ops[] = { Variant::OP_ADD, Variant::OP_SUBTRACT, Variant::OP_MULTIPLY, Variant::OP_BIT_AND, Variant::OP_BIT_OR, Variant::OP_BIT_XOR };
+		static const Variant::Operator float_ops[] = { Variant::OP_ADD, Variant::OP_SUBTRACT, Variant::OP_MULTIPLY, Variant::OP_DIVIDE };
+		static const Variant::Operator compare_ops[] = { Variant::OP_EQUAL, Variant::OP_NOT_EQUAL, Variant::OP_LESS, Variant::OP_LESS_EQUAL, Variant::OP_GREATER, Variant::OP_GREATER_EQUAL };
+
+		for (Variant::Operator op : int_ops) {
+			add(op, Variant::INT, Variant::INT, Variant::INT);
+		}
+		for (Variant::Operator op : float_ops) {
+			add(op, Variant::FLOAT, Variant::FLOAT, Variant::FLOAT);
+			add(op, Variant::INT, Variant::FLOAT, Variant::FLOAT);
+			add(op, Variant::FLOAT, Variant::INT, Variant::FLOAT);
+		}
+		for (Variant::Operator op : compare_ops) {
+			add(op, Variant::INT, Variant::INT, Variant::BOOL);
+			add(op, Variant::FLOAT, Variant::FLOAT, Variant::BOOL);
+			add(op, Variant::INT, Variant::FLOAT, Variant::BOOL);
+			add(op, Variant::FLOAT, Variant::INT, Variant::BOOL);
+		}
+		add(Variant::OP_NEGATE, Variant::INT, Variant::NIL, Variant::INT);
+		add(Variant::OP_NEGATE, Variant::FLOAT, Variant::NIL, Variant::FLOAT);
+		add(Variant::OP_NOT, Variant::BOOL, Variant::NIL, Variant::BOOL);
+	}
+};
+
+class GDScriptJIT::Compiler {
+	const GDScriptFunction *function = nullptr;
+	Assembler &as;
+	const InlineOperators &inline_operators;
+	int32_t data_offset = 0;
+	int end_ip = 0;
+
+	// Length of the instruction starting at each address, 0 if not reached, -1 if it's a side exit to the VM.
+	LocalVector<int> lengths;
+	// Position of the native code of each instruction.
+	LocalVector<int64_t> labels;
+
+	struct Fixup {
+		uint32_t jump = 0;
+		int ip = 0;
+	};
+	LocalVector<Fixup> fixups;
+	LocalVector<uint32_t> exits;
+
+	// Number of members accessed, checked against the instance once on entry.
+	int member_count = 0;
+	uint32_t member_count_check = 0;
+
+	int ip = 0;
+	bool failed = false;
+
+	int _code(int p_offset) const { return function->_code_ptr[ip + p_offset]; }
+	Mem _frame(size_t p_offset) const { return { REG_FRAME, int32_t(p_offset) }; }
+	Mem _data(const Mem &p_mem) const { return p_mem.offset(data_offset); }
+
+	int _decode(int p_ip, LocalVector<int> &r_targets, bool &r_falls_through) const;
+	bool _analyze();
+
+	Mem _address(int p_address);
+	Mem _operand(int p_index) { return _address(_code(1 + p_index)); }
+
+	void _exit(int p_ip);
+	void _exit_unless(Cond p_cond);
+	void _jump_to(int p_ip);
+	void _jump_to(Cond p_cond, int p_ip);
+
+	void _emit_prologue();
+	void _emit_epilogue();
+	void _emit_inline_operator(const InlineOperator &p_operator, const Mem &p_left, const Mem &p_right, const Mem &p_dst);
+	void _emit_call(int p_opcode);
+	void _emit_instruction();
+
+public:
+	bool compile();
+
+	Compiler(const GDScriptFunction *p_function, Assembler &p_assembler, const InlineOperators &p_inline_operators) :
+			function(p_function), as(p_assembler), inline_operators(p_inline_operators) {
+		Variant v = int64_t(0);
+		data_offset = (int32_t)((const uint8_t *)VariantInternal::get_int(&v) - (const uint8_t *)&v);
+		end_ip = function->_code_size - 1;
+	}
+};
+
+int GDScriptJIT::Compiler::_decode(int p_ip, LocalVector<int> &r_targets, bool &r_falls_through) const {
+	const int *code = function->_code_ptr + p_ip;
+	const int available = function->_code_size - p_ip;
+	int length = 0;
+	r_falls_through = true;
+
+	switch (code[0]) {
+		case GDScriptFunction::OPCODE_OPERATOR_VALIDATED:
+		case GDScriptFunction::OPCODE_SET_KEYED_VALIDATED:
+		case GDScriptFunction::OPCODE_SET_INDEXED_VALIDATED:
+		case GDScriptFunction::OPCODE_GET_KEYED_VALIDATED:
+		case GDScriptFunction::OPCODE_GET_INDEXED_VALIDATED: {
+			length = 5;
+		} break;
+		case GDScriptFunction::OPCODE_SET_NAMED_VALIDATED:
+		case GDScriptFunction::OPCODE_GET_NAMED_VALIDATED:
+		case GDScriptFunction::OPCODE_ASSIGN_TYPED_BUILTIN: {
+			length = 4;
+		} break;
+		case GDScriptFunction::OPCODE_ASSIGN:
+		case GDScriptFunction::OPCODE_ASSIGN_INT:
+		case GDScriptFunction::OPCODE_ASSIGN_FLOAT:
+		case GDScriptFunction::OPCODE_ASSIGN_VECTOR2:
+		case GDScriptFunction::OPCODE_ASSIGN_VECTOR3:
+		case GDScriptFunction::OPCODE_ASSERT: {
+			length = 3;
+		} break;
+		case GDScriptFunction::OPCODE_ASSIGN_NULL:
+		case GDScriptFunction::OPCODE_ASSIGN_TRUE:
+		case GDScriptFunction::OPCODE_ASSIGN_FALSE:
+		case GDScriptFunction::OPCODE_LINE: {
+			length = 2;
+		} break;
+		case GDScriptFunction::OPCODE_CONSTRUCT_VALIDATED:
+		case GDScriptFunction::OPCODE_CALL_NATIVE_STATIC_VALIDATED_RETURN:
+		case GDScriptFunction::OPCODE_CALL_NATIVE_STATIC_VALIDATED_NO_RETURN:
+		case GDScriptFunction::OPCODE_CALL_METHOD_BIND_VALIDATED_RETURN:
+		case GDScriptFunction::OPCODE_CALL_METHOD_BIND_VALIDATED_NO_RETURN:
+		case GDScriptFunction::OPCODE_CALL_BUILTIN_TYPE_VALIDATED:
+		case GDScriptFunction::OPCODE_CALL_UTILITY_VALIDATED: {
+			// Instruction argument count, arguments, call argument count and function index.
+			if (available < 2 || code[1] < 0) {
+				return 0;
+			}
+			length = code[1] + 4;
+		} break;
+		case GDScriptFunction::OPCODE_JUMP: {
+			length = 2;
+			r_targets.push_back(code[1]);
+			r_falls_through = false;
+		} break;
+		case GDScriptFunction::OPCODE_JUMP_IF:
+		case GDScriptFunction::OPCODE_JUMP_IF_NOT: {
+			length = 3;
+			r_targets.push_back(code[2]);
+		} break;
+		case GDScriptFunction::OPCODE_JUMP_TO_DEF_ARGUMENT: {
+			length = 2;
+			for (int i = 0; i <= function->_default_arg_count; i++) {
+				r_targets.push_back(function->_default_arg_ptr[i]);
+			}
+			r_falls_through = false;
+		} break;
+		case GDScriptFunction::OPCODE_RETURN: {
+			length = 2;
+			r_falls_through = false;
+		} break;
+		case GDScriptFunction::OPCODE_RETURN_TYPED_BUILTIN: {
+			length = 3;
+			r_falls_through = false;
+		} break;
+		case GDScriptFunction::OPCODE_ITERATE_BEGIN_INT:
+		case GDScriptFunction::OPCODE_ITERATE_INT: {
+			length = 5;
+			r_targets.push_back(code[4]);
+		} break;
+		case GDScriptFunction::OPCODE_ITERATE_BEGIN_RANGE: {
+			length = 7;
+			r_targets.push_back(code[6]);
+		} break;
+		case GDScriptFunction::OPCODE_ITERATE_RANGE: {
+			length = 6;
+			r_targets.push_back(code[5]);
+		} break;
+		case GDScriptFunction::OPCODE_END: {
+			length = 1;
+			r_falls_through = false;
+		} break;
+		default: {
+			if (code[0] >= GDScriptFunction::OPCODE_ADD_INT && code[0] <= GDScriptFunction::OPCODE_MULTIPLY_VECTOR3_FLOAT) {
+				length = 4;
+			} else if (code[0] >= GDScriptFunction::OPCODE_TYPE_ADJUST_BOOL && code[0] <= GDScriptFunction::OPCODE_TYPE_ADJUST_PACKED_VECTOR4_ARRAY) {
+				length = 2;
+			}
+		} break;
+	}
+
+	if (length == 0 || length > available || (r_falls_through && length == available)) {
+		return 0;
+	}
+	for (int target : r_targets) {
+		if (target < 0 || target >= function->_code_size) {
+			return 0;
+		}
+	}
+	return length;
+}
+
+bool GDScriptJIT::Compiler::_analyze() {
+	const int code_size = function->_code_size;
+	if (code_size <= 0 || function->_code_ptr[end_ip] != GDScriptFunction::OPCODE_END) {
+		return false;
+	}
+
+	lengths.resize(code_size);
+	for (int &length : lengths) {
+		length = 0;
+	}
+
+	// Only follow the instructions that can be compiled, the VM takes care of the rest.
+	LocalVector<int> worklist;
+	LocalVector<int> targets;
+	worklist.push_back(0);
+	while (!worklist.is_empty()) {
+		const int at = worklist[worklist.size() - 1];
+		worklist.resize(worklist.size() - 1);
+		if (lengths[at] != 0) {
+			continue;
+		}
+
+		targets.clear();
+		bool falls_through = false;
+		const int length = _decode(at, targets, falls_through);
+		if (length == 0) {
+			lengths[at] = -1;
+			continue;
+		}
+		lengths[at] = length;
+		if (falls_through) {
+			worklist.push_back(at + length);
+		}
+		for (int target : targets) {
+			worklist.push_back(target);
+		}
+	}
+
+	// Malformed bytecode, jumping into the middle of an instruction.
+	for (int at = 0; at < code_size; at++) {
+		for (int i = 1; i < lengths[at]; i++) {
+			if (lengths[at + i] != 0) {
+				return false;
+			}
+		}
+	}
+
+	// Not worth it if the function goes back to the VM right away.
+	return lengths[0] > 0;
+}
+
+Mem GDScriptJIT::Compiler::_address(int p_address) {
+	const int type = (p_address & GDScriptFunction::ADDR_TYPE_MASK) >> GDScriptFunction::ADDR_BITS;
+	const int index = p_address & GDScriptFunction::ADDR_MASK;
+	const int32_t disp = index * (int32_t)sizeof(Variant);
+
+	switch (type) {
+		case GDScriptFunction::ADDR_TYPE_STACK: {
+			if (index >= function->_stack_size) {
+				break;
+			}
+			return { REG_STACK, disp };
+		}
+		case GDScriptFunction::ADDR_TYPE_CONSTANT: {
+			if (index >= function->_constant_count) {
+				break;
+			}
+			return { REG_CONSTANTS, disp };
+		}
+		case GDScriptFunction::ADDR_TYPE_MEMBER: {
+			member_count = MAX(member_count, index + 1);
+			return { REG_MEMBERS, disp };
+		}
+		default: {
+		} break;
+	}
+
+	failed = true;
+	return { REG_STACK, 0 };
+}
+
+void GDScriptJIT::Compiler::_exit(int p_ip) {
+	as.mov_imm(RAX, p_ip);
+	exits.push_back(as.jmp());
+}
+
+void GDScriptJIT::Compiler::_exit_unless(Cond p_cond) {
+	const uint32_t skip = as.jcc(p_cond);
+	_exit(ip);
+	as.bind(skip);
+}
+
+void GDScriptJIT::Compiler::_jump_to(int p_ip) {
+	fixups.push_back({ as.jmp(), p_ip });
+}
+
+void GDScriptJIT::Compiler::_jump_to(Cond p_cond, int p_ip) {
+	fixups.push_back({ as.jcc(p_cond), p_ip });
+}
+
+void GDScriptJIT::Compiler::_emit_prologue() {
+	as.push(RBX);
+	as.push(R12);
+	as.push(R13);
+	as.push(R14);
+	as.push(R15);
+	as.sub_imm(RSP, STACK_FRAME_SIZE);
+
+	as.mov(REG_FRAME, ARG_REGS[0]);
+	as.load(REG_STACK, _frame(offsetof(Frame, stack)));
+	as.load(REG_MEMBERS, _frame(offsetof(Frame, members)));
+	as.load(REG_INSTRUCTION_ARGS, _frame(offsetof(Frame, instruction_args)));
+	as.mov_ptr(REG_CONSTANTS, function->_constants_ptr);
+
+	// Called without an instance, or on an instance with fewer members, let the VM report it.
+	as.load32(RAX, _frame(offsetof(Frame, member_count)));
+	as.cmp32_imm(RAX, 0);
+	member_count_check = as.position() - 4;
+	_exit_unless(COND_GE);
+}
+
+void GDScriptJIT::Compiler::_emit_epilogue() {
+	for (uint32_t exit : exits) {
+		as.bind(exit);
+	}
+	as.add_imm(RSP, STACK_FRAME_SIZE);
+	as.pop(R15);
+	as.pop(R14);
+	as.pop(R13);
+	as.pop(R12);
+	as.pop(RBX);
+	as.ret();
+}
+
+void GDScriptJIT::Compiler::_emit_inline_operator(const InlineOperator &p_operator, const Mem &p_left, const Mem &p_right, const Mem &p_dst) {
+	const Mem left = _data(p_left);
+	const Mem right = _data(p_right);
+	const Mem dst = _data(p_dst);
+
+	if (p_operator.op == Variant::OP_NOT) {
+		as.cmp8_imm(left, 0);
+		as.setcc(COND_E, RAX);
+		as.store8(dst, RAX);
+		return;
+	}
+
+	if (p_operator.op == Variant::OP_NEGATE) {
+		as.load(RAX, left);
+		if (p_operator.left == Variant::INT) {
+			as.neg(RAX);
+		} else {
+			as.btc(RAX, 63); // Flip the sign bit.
+		}
+		as.store(dst, RAX);
+		return;
+	}
+
+	const bool compare = p_operator.op >= Variant::OP_EQUAL && p_operator.op <= Variant::OP_GREATER_EQUAL;
+
+	if (p_operator.left == Variant::INT && p_operator.right == Variant::INT) {
+		as.load(RAX, left);
+		if (compare) {
+			static const Cond conditions[] = { COND_E, COND_NE, COND_L, COND_LE, COND_G, COND_GE };
+			as.alu(ALU_CMP, RAX, right);
+			as.setcc(conditions[p_operator.op - Variant::OP_EQUAL], RAX);
+			as.store8(dst, RAX);
+			return;
+		}
+		switch (p_operator.op) {
+			case Variant::OP_ADD: {
+				as.alu(ALU_ADD, RAX, right);
+			} break;
+			case Variant::OP_SUBTRACT: {
+				as.alu(ALU_SUB, RAX, right);
+			} break;
+			case Variant::OP_MULTIPLY: {
+				as.imul(RAX, right);
+			} break;
+			case Variant::OP_BIT_AND: {
+				as.alu(ALU_AND, RAX, right);
+			} break;
+			case Variant::OP_BIT_OR: {
+				as.alu(ALU_OR, RAX, right);
+			} break;
+			default: {
+				as.alu(ALU_XOR, RAX, right);
+			} break;
+		}
+		as.store(dst, RAX);
+		return;
+	}
+
+	// Float operations, converting int operands first.
+	if (p_operator.left == Variant::INT) {
+		as.cvtsi2sd(XMM0, left);
+	} else {
+		as.movsd(XMM0, left);
+	}
+
+	if (compare) {
+		if (p_operator.right == Variant::INT) {
+			as.cvtsi2sd(XMM1, right);
+		} else {
+			as.movsd(XMM1, right);
+		}
+		// Unordered comparisons (NaN) set ZF, PF and CF, only "not equal" is true then.
+		switch (p_operator.op) {
+			case Variant::OP_EQUAL: {
+				as.ucomisd(XMM0, XMM1);
+				as.setcc(COND_E, RAX);
+				as.setcc(COND_NP, RCX);
+				as.alu8(ALU_AND, RAX, RCX);
+			} break;
+			case Variant::OP_NOT_EQUAL: {
+				as.ucomisd(XMM0, XMM1);
+				as.setcc(COND_NE, RAX);
+				as.setcc(COND_P, RCX);
+				as.alu8(ALU_OR, RAX, RCX);
+			} break;
+			case Variant::OP_LESS: {
+				as.ucomisd(XMM1, XMM0);
+				as.setcc(COND_A, RAX);
+			} break;
+			case Variant::OP_LESS_EQUAL: {
+				as.ucomisd(XMM1, XMM0);
+				as.setcc(COND_AE, RAX);
+			} break;
+			case Variant::OP_GREATER: {
+				as.ucomisd(XMM0, XMM1);
+				as.setcc(COND_A, RAX);
+			} break;
+			default: {
+				as.ucomisd(XMM0, XMM1);
+				as.setcc(COND_AE, RAX);
+			} break;
+		}
+		as.store8(dst, RAX);
+		return;
+	}
+
+	SSEOp op = SSE_ADD;
+	switch (p_operator.op) {
+		case Variant::OP_SUBTRACT: {
+			op = SSE_SUB;
+		} break;
+		case Variant::OP_MULTIPLY: {
+			op = SSE_MUL;
+		} break;
+		case Variant::OP_DIVIDE: {
+			op = SSE_DIV;
+		} break;
+		default: {
+		} break;
+	}
+	if (p_operator.right == Variant::INT) {
+		as.cvtsi2sd(XMM1, right);
+		as.sse(op, XMM0, XMM1);
+	} else {
+		as.sse(op, XMM0, right);
+	}
+	as.movsd(dst, XMM0);
+}
+
+void GDScriptJIT::Compiler::_emit_call(int p_opcode) {
+	const int instr_arg_count = _code(1);
+	const int argc = _code(2 + instr_arg_count);
+	const int index = _code(3 + instr_arg_count);
+
+	// The base and the return value follow the arguments.
+	int extra_args = 1;
+	if (p_opcode == GDScriptFunction::OPCODE_CALL_METHOD_BIND_VALIDATED_RETURN || p_opcode == GDScriptFunction::OPCODE_CALL_METHOD_BIND_VALIDATED_NO_RETURN || p_opcode == GDScriptFunction::OPCODE_CALL_BUILTIN_TYPE_VALIDATED) {
+		extra_args = 2;
+	}
+	if (argc < 0 || argc + extra_args > instr_arg_count) {
+		failed = true;
+		return;
+	}
+
+	LocalVector<Mem> args;
+	args.resize(instr_arg_count);
+	for (int i = 0; i < instr_arg_count; i++) {
+		args[i] = _address(_code(2 + i));
+	}
+
+	// Same as `LOAD_INSTRUCTION_ARGS`, only the call arguments are read through the array.
+	for (int i = 0; i < argc; i++) {
+		as.lea(RAX, args[i]);
+		as.store({ REG_INSTRUCTION_ARGS, int32_t(i * sizeof(Variant *)) }, RAX);
+	}
+
+	switch (p_opcode) {
+		case GDScriptFunction::OPCODE_CONSTRUCT_VALIDATED: {
+			if (index < 0 || index >= function->_constructors_count) {
+				failed = true;
+				return;
+			}
+			as.lea(ARG_REGS[0], args[argc]);
+			as.mov(ARG_REGS[1], REG_INSTRUCTION_ARGS);
+			as.call((const void *)function->_constructors_ptr[index]);
+		} break;
+		case GDScriptFunction::OPCODE_CALL_BUILTIN_TYPE_VALIDATED: {
+			if (index < 0 || index >= function->_builtin_methods_count) {
+				failed = true;
+				return;
+			}
+			as.lea(ARG_REGS[0], args[argc]);
+			as.mov(ARG_REGS[1], REG_INSTRUCTION_ARGS);
+			as.mov_imm(ARG_REGS[2], argc);
+			as.lea(ARG_REGS[3], args[argc + 1]);
+			as.call((const void *)function->_builtin_methods_ptr[index]);
+		} break;
+		case GDScriptFunction::OPCODE_CALL_UTILITY_VALIDATED: {
+			if (index < 0 || index >= function->_utilities_count) {
+				failed = true;
+				return;
+			}
+			as.lea(ARG_REGS[0], args[argc]);
+			as.mov(ARG_REGS[1], REG_INSTRUCTION_ARGS);
+			as.mov_imm(ARG_REGS[2], argc);
+			as.call((const void *)function->_utilities_ptr[index]);
+		} break;
+		case GDScriptFunction::OPCODE_CALL_NATIVE_STATIC_VALIDATED_RETURN:
+		case GDScriptFunction::OPCODE_CALL_NATIVE_STATIC_VALIDATED_NO_RETURN: {
+			if (index < 0 || index >= function->_methods_count) {
+				failed = true;
+				return;
+			}
+			as.mov_ptr(ARG_REGS[0], function->_methods_ptr[index]);
+			as.mov(ARG_REGS[1], REG_INSTRUCTION_ARGS);
+			as.lea(ARG_REGS[2], args[argc]);
+			as.call(p_opcode == GDScriptFunction::OPCODE_CALL_NATIVE_STATIC_VALIDATED_RETURN ? (const void *)_call_native_static : (const void *)_call_native_static_no_return);
+		} break;
+		case GDScriptFunction::OPCODE_CALL_METHOD_BIND_VALIDATED_RETURN:
+		case GDScriptFunction::OPCODE_CALL_METHOD_BIND_VALIDATED_NO_RETURN: {
+			if (index < 0 || index >= function->_methods_count) {
+				failed = true;
+				return;
+			}
+			as.mov_ptr(ARG_REGS[0], function->_methods_ptr[index]);
+			as.lea(ARG_REGS[1], args[argc]);
+			as.mov(ARG_REGS[2], REG_INSTRUCTION_ARGS);
+			as.lea(ARG_REGS[3], args[argc + 1]);
+			as.call(p_opcode == GDScriptFunction::OPCODE_CALL_METHOD_BIND_VALIDATED_RETURN ? (const void *)_call_method_bind : (const void *)_call_method_bind_no_return);
+			// Null or freed base.
+			as.test8(RAX, RAX);
+			_exit_unless(COND_NE);
+		} break;
+		default: {
+			failed = true;
+		} break;
+	}
+}
+
+void GDScriptJIT::Compiler::_emit_instruction() {
+	const int opcode = _code(0);
+
+	switch (opcode) {
+		case GDScriptFunction::OPCODE_OPERATOR_VALIDATED: {
+			const int index = _code(4);
+			if (index < 0 || index >= function->_operator_funcs_count) {
+				failed = true;
+				return;
+			}
+			const Mem a = _operand(0);
+			const Mem b = _operand(1);
+			const Mem dst = _operand(2);
+
+			const Variant::ValidatedOperatorEvaluator evaluator = function->_operator_funcs_ptr[index];
+			const InlineOperator *inline_operator = inline_operators.operators.getptr(evaluator);
+			if (inline_operator) {
+				_emit_inline_operator(*inline_operator, a, b, dst);
+			} else {
+				as.lea(ARG_REGS[0], a);
+				as.lea(ARG_REGS[1], b);
+				as.lea(ARG_REGS[2], dst);
+				as.call((const void *)evaluator);
+			}
+		} break;
+		case GDScriptFunction::OPCODE_SET_KEYED_VALIDATED: {
+			const int index = _code(4);
+			if (index < 0 || index >= function->_keyed_setters_count) {
+				failed = true;
+				return;
+			}
+			const Mem dst = _operand(0);
+			const Mem key = _operand(1);
+			const Mem value = _operand(2);
+
+			const Mem valid = { RSP, STACK_SHADOW_SIZE };
+			as.lea(ARG_REGS[0], dst);
+			as.lea(ARG_REGS[1], key);
+			as.lea(ARG_REGS[2], value);
+			as.lea(ARG_REGS[3], valid);
+			as.call((const void *)function->_keyed_setters_ptr[index]);
+#ifdef DEBUG_ENABLED
+			as.cmp8_imm(valid, 0);
+			_exit_unless(COND_NE);
+#endif // DEBUG_ENABLED
+		} break;
+		case GDScriptFunction::OPCODE_SET_INDEXED_VALIDATED: {
+			const int index = _code(4);
+			if (index < 0 || index >= function->_indexed_setters_count) {
+				failed = true;
+				return;
+			}
+			const Mem dst = _operand(0);
+			const Mem int_index = _operand(1);
+			const Mem value = _operand(2);
+
+			const Mem oob = { RSP, STACK_SHADOW_SIZE };
+			as.lea(ARG_REGS[0], dst);
+			as.load(ARG_REGS[1], _data(int_index));
+			as.lea(ARG_REGS[2], value);
+			as.lea(ARG_REGS[3], oob);
+			as.call((const void *)function->_indexed_setters_ptr[index]);
+#ifdef DEBUG_ENABLED
+			as.cmp8_imm(oob, 0);
+			_exit_unless(COND_E);
+#endif // DEBUG_ENABLED
+		} break;
+		case GDScriptFunction::OPCODE_GET_KEYED_VALIDATED: {
+			const int index = _code(4);
+			if (index < 0 || index >= function->_keyed_getters_count) {
+				failed = true;
+				return;
+			}
+			const Mem src = _operand(0);
+			const Mem key = _operand(1);
+			const Mem dst = _operand(2);
+
+#ifdef DEBUG_ENABLED
+			as.mov_ptr(ARG_REGS[0], (const void *)function->_keyed_getters_ptr[index]);
+			as.lea(ARG_REGS[1], src);
+			as.lea(ARG_REGS[2], key);
+			as.lea(ARG_REGS[3], dst);
+			as.call((const void *)_get_keyed);
+			as.test8(RAX, RAX);
+			_exit_unless(COND_NE);
+#else
+			as.lea(ARG_REGS[0], src);
+			as.lea(ARG_REGS[1], key);
+			as.lea(ARG_REGS[2], dst);
+			as.lea(ARG_REGS[3], { RSP, STACK_SHADOW_SIZE });
+			as.call((const void *)function->_keyed_getters_ptr[index]);
+#endif // DEBUG_ENABLED
+		} break;
+		case GDScriptFunction::OPCODE_GET_INDEXED_VALIDATED: {
+			const int index = _code(4);
+			if (index < 0 || index >= function->_indexed_getters_count) {
+				failed = true;
+				return;
+			}
+			const Mem src = _operand(0);
+			const Mem int_index = _operand(1);
+			const Mem dst = _operand(2);
+
+			const Mem oob = { RSP, STACK_SHADOW_SIZE };
+			as.lea(ARG_REGS[0], src);
+			as.load(ARG_REGS[1], _data(int_index));
+			as.lea(ARG_REGS[2], dst);
+			as.lea(ARG_REGS[3], oob);
+			as.call((const void *)function->_indexed_getters_ptr[index]);
+#ifdef DEBUG_ENABLED
+			as.cmp8_imm(oob, 0);
+			_exit_unless(COND_E);
+#endif // DEBUG_ENABLED
+		} break;
+		case GDScriptFunction::OPCODE_SET_NAMED_VALIDATED: {
+			const int index = _code(3);
+			if (index < 0 || index >= function->_setters_count) {
+				failed = true;
+				return;
+			}
+			const Mem dst = _operand(0);
+			const Mem value = _operand(1);
+
+			as.lea(ARG_REGS[0], dst);
+			as.lea(ARG_REGS[1], value);
+			as.call((const void *)function->_setters_ptr[index]);
+		} break;
+		case GDScriptFunction::OPCODE_GET_NAMED_VALIDATED: {
+			const int index = _code(3);
+			if (index < 0 || index >= function->_getters_count) {
+				failed = true;
+				return;
+			}
+			const Mem src = _operand(0);
+			const Mem dst = _operand(1);
+
+			as.lea(ARG_REGS[0], src);
+			as.lea(ARG_REGS[1], dst);
+			as.call((const void *)function->_getters_ptr[index]);
+		} break;
+		case GDScriptFunction::OPCODE_ASSIGN: {
+			const Mem dst = _operand(0);
+			const Mem src = _operand(1);
+
+			// Copy bool, int and float values directly when the type doesn't change.
+			as.load32(RAX, src);
+			as.cmp32(RAX, dst);
+			const uint32_t different = as.jcc(COND_NE);
+			as.sub_imm(RAX, Variant::BOOL);
+			as.cmp32_imm(RAX, Variant::FLOAT - Variant::BOOL);
+			const uint32_t not_trivial = as.jcc(COND_A);
+			as.load(RAX, _data(src));
+			as.store(_data(dst), RAX);
+			const uint32_t done = as.jmp();
+
+			as.bind(different);
+			as.bind(not_trivial);
+			as.lea(ARG_REGS[0], dst);
+			as.lea(ARG_REGS[1], src);
+			as.call((const void *)_assign);
+			as.bind(done);
+		} break;
+		case GDScriptFunction::OPCODE_ASSIGN_INT:
+		case GDScriptFunction::OPCODE_ASSIGN_FLOAT: {
+			const Mem dst = _operand(0);
+			const Mem src = _operand(1);
+
+			// The source has the type already, only the destination may need to change.
+			as.cmp32_imm(dst, opcode == GDScriptFunction::OPCODE_ASSIGN_INT ? Variant::INT : Variant::FLOAT);
+			const uint32_t different = as.jcc(COND_NE);
+			as.load(RAX, _data(src));
+			as.store(_data(dst), RAX);
+			const uint32_t done = as.jmp();
+
+			as.bind(different);
+			as.lea(ARG_REGS[0], dst);
+			as.lea(ARG_REGS[1], src);
+			as.call((const void *)_assign);
+			as.bind(done);
+		} break;
+		case GDScriptFunction::OPCODE_ASSIGN_VECTOR2:
+		case GDScriptFunction::OPCODE_ASSIGN_VECTOR3: {
+			const Mem dst = _operand(0);
+			const Mem src = _operand(1);
+
+			as.lea(ARG_REGS[0], dst);
+			as.lea(ARG_REGS[1], src);
+			as.call((const void *)_assign);
+		} break;
+		case GDScriptFunction::OPCODE_ASSIGN_NULL: {
+			const Mem dst = _operand(0);
+
+			as.lea(ARG_REGS[0], dst);
+			as.call((const void *)_assign_null);
+		} break;
+		case GDScriptFunction::OPCODE_ASSIGN_TRUE:
+		case GDScriptFunction::OPCODE_ASSIGN_FALSE: {
+			const Mem dst = _operand(0);
+
+			as.lea(ARG_REGS[0], dst);
+			as.mov_imm(ARG_REGS[1], opcode == GDScriptFunction::OPCODE_ASSIGN_TRUE ? 1 : 0);
+			as.call((const void *)_assign_bool);
+		} break;
+		case GDScriptFunction::OPCODE_ASSIGN_TYPED_BUILTIN: {
+			const int type = _code(3);
+			if (type < 0 || type >= Variant::VARIANT_MAX) {
+				failed = true;
+				return;
+			}
+			const Mem dst = _operand(0);
+			const Mem src = _operand(1);
+
+			uint32_t done = 0;
+			const bool trivial = type == Variant::BOOL || type == Variant::INT || type == Variant::FLOAT;
+			if (trivial) {
+				as.cmp32_imm(src, type);
+				const uint32_t slow_src = as.jcc(COND_NE);
+				as.cmp32_imm(dst, type);
+				const uint32_t slow_dst = as.jcc(COND_NE);
+				as.load(RAX, _data(src));
+				as.store(_data(dst), RAX);
+				done = as.jmp();
+				as.bind(slow_src);
+				as.bind(slow_dst);
+			}
+			as.lea(ARG_REGS[0], dst);
+			as.lea(ARG_REGS[1], src);
+			as.mov_imm(ARG_REGS[2], type);
+			as.call((const void *)_assign_typed_builtin);
+			as.test8(RAX, RAX);
+			_exit_unless(COND_NE);
+			if (trivial) {
+				as.bind(done);
+			}
+		} break;
+		case GDScriptFunction::OPCODE_CONSTRUCT_VALIDATED:
+		case GDScriptFunction::OPCODE_CALL_NATIVE_STATIC_VALIDATED_RETURN:
+		case GDScriptFunction::OPCODE_CALL_NATIVE_STATIC_VALIDATED_NO_RETURN:
+		case GDScriptFunction::OPCODE_CALL_METHOD_BIND_VALIDATED_RETURN:
+		case GDScriptFunction::OPCODE_CALL_METHOD_BIND_VALIDATED_NO_RETURN:
+		case GDScriptFunction::OPCODE_CALL_BUILTIN_TYPE_VALIDATED:
+		case GDScriptFunction::OPCODE_CALL_UTILITY_VALIDATED: {
+			_emit_call(opcode);
+		} break;
+		case GDScriptFunction::OPCODE_JUMP: {
+			_jump_to(_code(1));
+		} break;
+		case GDScriptFunction::OPCODE_JUMP_IF:
+		case GDScriptFunction::OPCODE_JUMP_IF_NOT: {
+			const Mem test = _operand(0);
+			const Cond taken = opcode == GDScriptFunction::OPCODE_JUMP_IF ? COND_NE : COND_E;
+
+			as.cmp32_imm(test, Variant::BOOL);
+			const uint32_t not_bool = as.jcc(COND_NE);
+			as.cmp8_imm(_data(test), 0);
+			_jump_to(taken, _code(2));
+			const uint32_t done = as.jmp();
+
+			as.bind(not_bool);
+			as.lea(ARG_REGS[0], test);
+			as.call((const void *)_booleanize);
+			as.test8(RAX, RAX);
+			_jump_to(taken, _code(2));
+			as.bind(done);
+		} break;
+		case GDScriptFunction::OPCODE_JUMP_TO_DEF_ARGUMENT: {
+			as.load32(RAX, _frame(offsetof(Frame, defarg)));
+			for (int i = 0; i <= function->_default_arg_count; i++) {
+				as.cmp32_imm(RAX, i);
+				_jump_to(COND_E, function->_default_arg_ptr[i]);
+			}
+			_exit(ip);
+		} break;
+		case GDScriptFunction::OPCODE_RETURN: {
+			const Mem value = _operand(0);
+
+			as.load(ARG_REGS[0], _frame(offsetof(Frame, retvalue)));
+			as.lea(ARG_REGS[1], value);
+			as.call((const void *)_assign);
+			_exit(end_ip);
+		} break;
+		case GDScriptFunction::OPCODE_RETURN_TYPED_BUILTIN: {
+			const int type = _code(2);
+			if (type < 0 || type >= Variant::VARIANT_MAX) {
+				failed = true;
+				return;
+			}
+			const Mem value = _operand(0);
+
+			as.load(ARG_REGS[0], _frame(offsetof(Frame, retvalue)));
+			as.lea(ARG_REGS[1], value);
+			as.mov_imm(ARG_REGS[2], type);
+			as.call((const void *)_return_typed_builtin);
+			as.test8(RAX, RAX);
+			_exit_unless(COND_NE);
+			_exit(end_ip);
+		} break;
+		case GDScriptFunction::OPCODE_ITERATE_BEGIN_INT: {
+			const Mem counter = _operand(0);
+			const Mem container = _operand(1);
+			const Mem iterator = _operand(2);
+
+			as.lea(ARG_REGS[0], counter);
+			as.mov_imm(ARG_REGS[1], 0);
+			as.call((const void *)_initialize_int);
+			as.load(RAX, _data(container));
+			as.test(RAX, RAX);
+			_jump_to(COND_LE, _code(4));
+			as.lea(ARG_REGS[0], iterator);
+			as.mov_imm(ARG_REGS[1], 0);
+			as.call((const void *)_initialize_int);
+		} break;
+		case GDScriptFunction::OPCODE_ITERATE_INT: {
+			const Mem counter = _operand(0);
+			const Mem container = _operand(1);
+			const Mem iterator = _operand(2);
+
+			as.load(RAX, _data(counter));
+			as.add_imm(RAX, 1);
+			as.store(_data(counter), RAX);
+			as.alu(ALU_CMP, RAX, _data(container));
+			_jump_to(COND_GE, _code(4));
+			as.store(_data(iterator), RAX);
+		} break;
+		case GDScriptFunction::OPCODE_ITERATE_BEGIN_RANGE: {
+			const Mem counter = _operand(0);
+			const Mem from = _operand(1);
+			const Mem to = _operand(2);
+			const Mem step = _operand(3);
+			const Mem iterator = _operand(4);
+
+			as.lea(ARG_REGS[0], counter);
+			as.load(ARG_REGS[1], _data(from));
+			as.call((const void *)_initialize_int);
+
+			// Continue if the step goes from `from` towards `to`.
+			as.load(RAX, _data(from));
+			as.load(RCX, _data(to));
+			as.load(RDX, _data(step));
+			as.alu(ALU_CMP, RAX, RCX);
+			_jump_to(COND_E, _code(6));
+			const uint32_t backwards = as.jcc(COND_G);
+			as.test(RDX, RDX);
+			_jump_to(COND_LE, _code(6));
+			const uint32_t start = as.jmp();
+			as.bind(backwards);
+			as.test(RDX, RDX);
+			_jump_to(COND_GE, _code(6));
+
+			as.bind(start);
+			as.lea(ARG_REGS[0], iterator);
+			as.load(ARG_REGS[1], _data(from));
+			as.call((const void *)_initialize_int);
+		} break;
+		case GDScriptFunction::OPCODE_ITERATE_RANGE: {
+			const Mem counter = _operand(0);
+			const Mem to = _operand(1);
+			const Mem step = _operand(2);
+			const Mem iterator = _operand(3);
+
+			as.load(RCX, _data(step));
+			as.load(RAX, _data(counter));
+			as.alu(ALU_ADD, RAX, RCX);
+			as.store(_data(counter), RAX);
+			as.load(RDX, _data(to));
+			as.test(RCX, RCX);
+			const uint32_t zero_step = as.jcc(COND_E);
+			const uint32_t backwards = as.jcc(COND_S);
+			as.alu(ALU_CMP, RAX, RDX);
+			_jump_to(COND_GE, _code(5));
+			const uint32_t next = as.jmp();
+			as.bind(backwards);
+			as.alu(ALU_CMP, RAX, RDX);
+			_jump_to(COND_LE, _code(5));
+
+			as.bind(zero_step);
+			as.bind(next);
+			as.store(_data(iterator), RAX);
+		} break;
+		case GDScriptFunction::OPCODE_ASSERT: {
+#ifdef DEBUG_ENABLED
+			const Mem test = _operand(0);
+
+			as.lea(ARG_REGS[0], test);
+			as.call((const void *)_booleanize);
+			as.test8(RAX, RAX);
+			_exit_unless(COND_NE);
+#endif // DEBUG_ENABLED
+		} break;
+		case GDScriptFunction::OPCODE_LINE: {
+			as.load(RAX, _frame(offsetof(Frame, line)));
+			as.store32_imm({ RAX, 0 }, _code(1));
+		} break;
+		case GDScriptFunction::OPCODE_END: {
+			_exit(end_ip);
+		} break;
+		default: {
+			if (opcode >= GDScriptFunction::OPCODE_ADD_INT && opcode <= GDScriptFunction::OPCODE_MULTIPLY_VECTOR3_FLOAT) {
+				const InlineOperator &typed_operator = typed_operators[opcode - GDScriptFunction::OPCODE_ADD_INT];
+				const Mem a = _operand(0);
+				const Mem b = _operand(1);
+				const Mem dst = _operand(2);
+
+				if (typed_operator.left == Variant::INT || typed_operator.left == Variant::FLOAT) {
+					_emit_inline_operator(typed_operator, a, b, dst);
+				} else {
+					as.lea(ARG_REGS[0], a);
+					as.lea(ARG_REGS[1], b);
+					as.lea(ARG_REGS[2], dst);
+					as.call((const void *)Variant::get_validated_operator_evaluator(typed_operator.op, typed_operator.left, typed_operator.right));
+				}
+				break;
+			}
+
+			// Type adjustments, only change the type when it's different.
+			const Mem value = _operand(0);
+			const int type_index = opcode - GDScriptFunction::OPCODE_TYPE_ADJUST_BOOL;
+
+			uint32_t done = 0;
+			const bool trivial = opcode <= GDScriptFunction::OPCODE_TYPE_ADJUST_FLOAT;
+			if (trivial) {
+				as.cmp32_imm(value, Variant::BOOL + type_index);
+				done = as.jcc(COND_E);
+			}
+			as.lea(ARG_REGS[0], value);
+			as.call((const void *)type_adjust_funcs[type_index]);
+			if (trivial) {
+				as.bind(done);
+			}
+		} break;
+	}
+}
+
+bool GDScriptJIT::Compiler::compile() {
+	if (!_analyze()) {
+		return false;
+	}
+
+	_emit_prologue();
+
+	labels.resize(lengths.size());
+	for (int64_t &label : labels) {
+		label = -1;
+	}
+
+	// Instructions which fall through are always followed by the next one, as it was reached through them.
+	for (ip = 0; ip < (int)lengths.size(); ip++) {
+		if (lengths[ip] == 0) {
+			continue;
+		}
+		labels[ip] = as.position();
+		if (lengths[ip] < 0) {
+			_exit(ip);
+			continue;
+		}
+		_emit_instruction();
+		if (failed) {
+			return false;
+		}
+	}
+
+	for (const Fixup &fixup : fixups) {
+		ERR_FAIL_COND_V(labels[fixup.ip] < 0, false);
+		as.patch(fixup.jump, labels[fixup.ip]);
+	}
+	as.patch_dword(member_count_check, member_count);
+
+	_emit_epilogue();
+	return true;
+}
+
+// The memory is never writable and executable at the same time.
+static uint8_t *_allocate_executable(const LocalVector<uint8_t> &p_code) {
+#ifdef WINDOWS_ENABLED
+	uint8_t *memory = (uint8_t *)VirtualAlloc(nullptr, p_code.size(), MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+	ERR_FAIL_NULL_V(memory, nullptr);
+	memcpy(memory, p_code.ptr(), p_code.size());
+	DWORD old_protect;
+	if (!VirtualProtect(memory, p_code.size(), PAGE_EXECUTE_READ, &old_protect)) {
+		VirtualFree(memory, 0, MEM_RELEASE);
+		ERR_FAIL_V(nullptr);
+	}
+	FlushInstructionCache(GetCurrentProcess(), memory, p_code.size());
+#else
+	void *mapping = mmap(nullptr, p_code.size(), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	ERR_FAIL_COND_V(mapping == MAP_FAILED, nullptr);
+	uint8_t *memory = (uint8_t *)mapping;
+	memcpy(memory, p_code.ptr(), p_code.size());
+	if (mprotect(memory, p_code.size(), PROT_READ | PROT_EXEC) != 0) {
+		munmap(memory, p_code.size());
+		ERR_FAIL_V(nullptr);
+	}
+#endif // WINDOWS_ENABLED
+	return memory;
+}
+
+static void _free_executable(uint8_t *p_memory, size_t p_size) {
+#ifdef WINDOWS_ENABLED
+	VirtualFree(p_memory, 0, MEM_RELEASE);
+#else
+	munmap(p_memory, p_size);
+#endif // WINDOWS_ENABLED
+}
+#endif // GDSCRIPT_JIT_ENABLED
+
+bool GDScriptJIT::is_supported() {
+#ifdef GDSCRIPT_JIT_ENABLED
+	// The compiled code accesses the type and the data of variants directly.
+	static const bool layout_supported = []() {
+		static_assert(sizeof(Variant::Type) == sizeof(int32_t));
+		Variant v = 1.5;
+		int32_t type;
+		memcpy(&type, &v, sizeof(type));
+		return type == Variant::FLOAT && (void *)VariantInternal::get_bool(&v) == (void *)VariantInternal::get_float(&v) && (void *)VariantInternal::get_int(&v) == (void *)VariantInternal::get_float(&v);
+	}();
+	return layout_supported;
+#else
+	return false;
+#endif // GDSCRIPT_JIT_ENABLED
+}
+
+void GDScriptJIT::compile(const LocalVector<GDScriptFunction *> &p_functions) {
+#ifdef GDSCRIPT_JIT_ENABLED
+	if (p_functions.is_empty() || !is_supported()) {
+		return;
+	}
+
+	static const InlineOperators inline_operators;
+
+	LocalVector<uint8_t> code;
+	Assembler as(code);
+
+	struct Entry {
+		GDScriptFunction *function = nullptr;
+		uint32_t offset = 0;
+	};
+	LocalVector<Entry> entries;
+
+	for (GDScriptFunction *function : p_functions) {
+		ERR_CONTINUE(function->_jit_code);
+		as.align(16);
+		const uint32_t offset = as.position();
+		Compiler compiler(function, as, inline_operators);
+		if (compiler.compile()) {
+			entries.push_back({ function, offset });
+		} else {
+			code.resize(offset);
+		}
+	}
+
+	if (entries.is_empty()) {
+		return;
+	}
+
+	uint8_t *memory = _allocate_executable(code);
+	if (!memory) {
+		return;
+	}
+
+	CodeBlock *block = memnew(CodeBlock);
+	block->memory = memory;
+	block->size = code.size();
+	block->refcount.init(entries.size());
+
+	for (const Entry &entry : entries) {
+		entry.function->_jit_code = (Code)(memory + entry.offset);
+		entry.function->_jit_block = block;
+	}
+#endif // GDSCRIPT_JIT_ENABLED
+}
+
+void GDScriptJIT::release(CodeBlock *p_block) {
+	if (!p_block->refcount.unref()) {
+		return;
+	}
+#ifdef GDSCRIPT_JIT_ENABLED
+	_free_executable(p_block->memory, p_block->size);
+#endif // GDSCRIPT_JIT_ENABLED
+	memdelete(p_block);
+}
@@ -0,0 +1,80 @@
+/**************************************************************************/
+/*  gdscript_jit.h                                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
+
+class GDScriptFunction;
+class Variant;
+
+// Baseline compiler translating GDScript bytecode to native x86-64 code.
+// There is no AArch64 backend: is_supported() returns false on other architectures and in builds
+// without the `gdscript_jit` SCons option, and all functions are interpreted.
+//
+// Instructions whose operands were resolved by the analyzer (validated operators, getters, setters, constructors and
+// calls) become direct calls to the same functions the VM would call, with the common int, float and bool operations
+// and loops over integers inlined. Every other instruction is a side exit: the compiled code returns its address and
+// the VM interprets the rest of the function from there, so untyped code keeps working exactly as before.
+// Error checks work the same way, the instruction that failed is executed again by the VM so it reports the error.
+class GDScriptJIT {
+	class Compiler;
+
+public:
+	// State of the call passed from the VM to the compiled code. Everything else is baked into the code.
+	struct Frame {
+		Variant *stack = nullptr;
+		Variant *members = nullptr;
+		int member_count = 0;
+		Variant **instruction_args = nullptr;
+		Variant *retvalue = nullptr;
+		int *line = nullptr;
+		int defarg = 0;
+	};
+
+	// Returns the address of the instruction the VM continues with.
+	// When the function returned, this is the final `OPCODE_END` and `Frame::retvalue` holds the return value.
+	typedef int (*Code)(Frame *p_frame);
+
+	// Executable memory shared by the functions of a script, freed with the last of them.
+	struct CodeBlock {
+		SafeRefCount refcount;
+		uint8_t *memory = nullptr;
+		size_t size = 0;
+	};
+
+	static bool is_supported();
+
+	// Compiles the given functions into a single block of executable memory, setting their native code.
+	// Functions that would exit to the VM right away are left to the interpreter.
+	static void compile(const LocalVector<GDScriptFunction *> &p_functions);
+	static void release(CodeBlock *p_block);
+};
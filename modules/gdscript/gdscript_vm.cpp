@@ -256,6 +256,31 @@ void (*type_init_function_table[])(Variant *) = {
 	static const void *switch_table_ops[] = { \
 		&&OPCODE_OPERATOR, \
 		&&OPCODE_OPERATOR_VALIDATED, \
+		&&OPCODE_ADD_INT, \
+		&&OPCODE_SUBTRACT_INT, \
+		&&OPCODE_MULTIPLY_INT, \
+		&&OPCODE_EQUAL_INT, \
+		&&OPCODE_NOT_EQUAL_INT, \
+		&&OPCODE_LESS_INT, \
+		&&OPCODE_LESS_EQUAL_INT, \
+		&&OPCODE_GREATER_INT, \
+		&&OPCODE_GREATER_EQUAL_INT, \
+		&&OPCODE_ADD_FLOAT, \
+		&&OPCODE_SUBTRACT_FLOAT, \
+		&&OPCODE_MULTIPLY_FLOAT, \
+		&&OPCODE_DIVIDE_FLOAT, \
+		&&OPCODE_LESS_FLOAT, \
+		&&OPCODE_LESS_EQUAL_FLOAT, \
+		&&OPCODE_GREATER_FLOAT, \
+		&&OPCODE_GREATER_EQUAL_FLOAT, \
+		&&OPCODE_ADD_VECTOR2, \
+		&&OPCODE_SUBTRACT_VECTOR2, \
+		&&OPCODE_MULTIPLY_VECTOR2, \
+		&&OPCODE_MULTIPLY_VECTOR2_FLOAT, \
+		&&OPCODE_ADD_VECTOR3, \
+		&&OPCODE_SUBTRACT_VECTOR3, \
+		&&OPCODE_MULTIPLY_VECTOR3, \
+		&&OPCODE_MULTIPLY_VECTOR3_FLOAT, \
 		&&OPCODE_TYPE_TEST_BUILTIN, \
 		&&OPCODE_TYPE_TEST_ARRAY, \
 		&&OPCODE_TYPE_TEST_DICTIONARY, \
@@ -279,6 +304,10 @@ void (*type_init_function_table[])(Variant *) = {
 		&&OPCODE_ASSIGN_NULL, \
 		&&OPCODE_ASSIGN_TRUE, \
 		&&OPCODE_ASSIGN_FALSE, \
+		&&OPCODE_ASSIGN_INT, \
+		&&OPCODE_ASSIGN_FLOAT, \
+		&&OPCODE_ASSIGN_VECTOR2, \
+		&&OPCODE_ASSIGN_VECTOR3, \
 		&&OPCODE_ASSIGN_TYPED_BUILTIN, \
 		&&OPCODE_ASSIGN_TYPED_ARRAY, \
 		&&OPCODE_ASSIGN_TYPED_DICTIONARY, \
@@ -538,25 +567,28 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 	int defarg = 0;
 
 	uint32_t alloca_size = 0;
+	// Non-zero while this call owns a frame from the pool, which happens for functions that may suspend.
+	uint32_t frame_size = 0;
+	bool frame_handed_off = false;
 	GDScript *script;
 	int ip = 0;
 	int line = _initial_line;
 
 	if (p_state) {
 		// Use existing (supplied) state (awaited).
-		stack = (Variant *)p_state->stack.ptr();
-		instruction_args = (Variant **)&p_state->stack.ptr()[sizeof(Variant) * p_state->stack_size]; // `ptr()` to avoid bounds check.
+		stack = (Variant *)p_state->stack;
+		instruction_args = (Variant **)&p_state->stack[sizeof(Variant) * p_state->stack_size];
 		line = p_state->line;
 		ip = p_state->ip;
-		alloca_size = p_state->stack.size();
+		alloca_size = p_state->stack_alloc_size;
+		frame_size = p_state->stack_alloc_size;
 		script = p_state->script;
 		p_instance = p_state->instance;
 		defarg = p_state->defarg;
 
-		// Responsibility for the stack is moved from `GDScriptFunctionState` to this method. So, we reset `p_state->stack_size`
-		// to prevent `GDScriptFunctionState::_clear_stack()` from clearing the stack again.
-		// NOTE: Strictly speaking, ownership doesn't move. However, we can be sure that `p_state->stack` won't be cleared
-		// before the current call completes, and that `p_state` won't be resumed again.
+		// The frame is resumed in place, so its ownership moves from `GDScriptFunctionState` to this method.
+		// It either goes back to the pool when the call completes, or to the next state if it awaits again.
+		p_state->stack = nullptr;
 		p_state->stack_size = 0;
 	} else {
 		if (p_argcount != _argument_count) {
@@ -579,7 +611,13 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 		alloca_size = sizeof(Variant *) * FIXED_ADDRESSES_MAX + sizeof(Variant *) * _instruction_args_size + sizeof(Variant) * _stack_size;
 
-		uint8_t *aptr = (uint8_t *)alloca(alloca_size);
+		uint8_t *aptr = nullptr;
+		if (_is_coroutine) {
+			frame_size = alloca_size;
+			aptr = _alloc_frame(frame_size);
+		} else {
+			aptr = (uint8_t *)alloca(alloca_size);
+		}
 		stack = (Variant *)aptr;
 
 		const int non_vararg_arg_count = MIN(p_argcount, _argument_count);
@@ -598,6 +636,9 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				r_err.error = Callable::CallError::CALL_ERROR_INVALID_ARGUMENT;
 				r_err.argument = i;
 				r_err.expected = argument_types[i].builtin_type;
+				if (frame_size) {
+					_free_frame(aptr, frame_size);
+				}
 				call_depth--;
 				return _get_default_variant_for_data_type(return_type);
 			}
@@ -618,6 +659,9 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 						r_err.error = Callable::CallError::CALL_ERROR_INVALID_ARGUMENT;
 						r_err.argument = i;
 						r_err.expected = argument_types[i].builtin_type;
+						if (frame_size) {
+							_free_frame(aptr, frame_size);
+						}
 						call_depth--;
 						return _get_default_variant_for_data_type(return_type);
 					}
@@ -746,6 +790,24 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 	bool awaited = false;
 	Variant *variant_addresses[ADDR_TYPE_MAX] = { stack, _constants_ptr, p_instance ? p_instance->members.ptrw() : nullptr };
 
+	// Run the native code until it returns or reaches an instruction it doesn't handle. The debugger and the profiler
+	// need every instruction to go through the VM.
+#ifdef DEBUG_ENABLED
+	if (_jit_code && !p_state && !EngineDebugger::is_active() && !GDScriptLanguage::get_singleton()->profiling) {
+#else
+	if (_jit_code && !p_state && !EngineDebugger::is_active()) {
+#endif
+		GDScriptJIT::Frame frame;
+		frame.stack = stack;
+		frame.members = variant_addresses[ADDR_TYPE_MEMBER];
+		frame.member_count = p_instance ? (int)p_instance->members.size() : 0;
+		frame.instruction_args = instruction_args;
+		frame.retvalue = &retvalue;
+		frame.line = &line;
+		frame.defarg = defarg;
+		ip = _jit_code(&frame);
+	}
+
 #ifdef DEBUG_ENABLED
 	OPCODE_WHILE(ip < _code_size) {
 		int last_opcode = _code_ptr[ip];
@@ -858,6 +920,43 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+#define OPCODE_TYPED_OPERATOR(m_opcode, m_left_type, m_operator, m_right_type, m_return_type) \
+	OPCODE(OPCODE_##m_opcode) { \
+		CHECK_SPACE(4); \
+		GET_VARIANT_PTR(a, 0); \
+		GET_VARIANT_PTR(b, 1); \
+		GET_VARIANT_PTR(dst, 2); \
+		*VariantInternal::OP_GET_##m_return_type(dst) = *VariantInternal::OP_GET_##m_left_type(a) m_operator *VariantInternal::OP_GET_##m_right_type(b); \
+		ip += 4; \
+	} \
+	DISPATCH_OPCODE
+
+			OPCODE_TYPED_OPERATOR(ADD_INT, INT, +, INT, INT);
+			OPCODE_TYPED_OPERATOR(SUBTRACT_INT, INT, -, INT, INT);
+			OPCODE_TYPED_OPERATOR(MULTIPLY_INT, INT, *, INT, INT);
+			OPCODE_TYPED_OPERATOR(EQUAL_INT, INT, ==, INT, BOOL);
+			OPCODE_TYPED_OPERATOR(NOT_EQUAL_INT, INT, !=, INT, BOOL);
+			OPCODE_TYPED_OPERATOR(LESS_INT, INT, <, INT, BOOL);
+			OPCODE_TYPED_OPERATOR(LESS_EQUAL_INT, INT, <=, INT, BOOL);
+			OPCODE_TYPED_OPERATOR(GREATER_INT, INT, >, INT, BOOL);
+			OPCODE_TYPED_OPERATOR(GREATER_EQUAL_INT, INT, >=, INT, BOOL);
+			OPCODE_TYPED_OPERATOR(ADD_FLOAT, FLOAT, +, FLOAT, FLOAT);
+			OPCODE_TYPED_OPERATOR(SUBTRACT_FLOAT, FLOAT, -, FLOAT, FLOAT);
+			OPCODE_TYPED_OPERATOR(MULTIPLY_FLOAT, FLOAT, *, FLOAT, FLOAT);
+			OPCODE_TYPED_OPERATOR(DIVIDE_FLOAT, FLOAT, /, FLOAT, FLOAT);
+			OPCODE_TYPED_OPERATOR(LESS_FLOAT, FLOAT, <, FLOAT, BOOL);
+			OPCODE_TYPED_OPERATOR(LESS_EQUAL_FLOAT, FLOAT, <=, FLOAT, BOOL);
+			OPCODE_TYPED_OPERATOR(GREATER_FLOAT, FLOAT, >, FLOAT, BOOL);
+			OPCODE_TYPED_OPERATOR(GREATER_EQUAL_FLOAT, FLOAT, >=, FLOAT, BOOL);
+			OPCODE_TYPED_OPERATOR(ADD_VECTOR2, VECTOR2, +, VECTOR2, VECTOR2);
+			OPCODE_TYPED_OPERATOR(SUBTRACT_VECTOR2, VECTOR2, -, VECTOR2, VECTOR2);
+			OPCODE_TYPED_OPERATOR(MULTIPLY_VECTOR2, VECTOR2, *, VECTOR2, VECTOR2);
+			OPCODE_TYPED_OPERATOR(MULTIPLY_VECTOR2_FLOAT, VECTOR2, *, FLOAT, VECTOR2);
+			OPCODE_TYPED_OPERATOR(ADD_VECTOR3, VECTOR3, +, VECTOR3, VECTOR3);
+			OPCODE_TYPED_OPERATOR(SUBTRACT_VECTOR3, VECTOR3, -, VECTOR3, VECTOR3);
+			OPCODE_TYPED_OPERATOR(MULTIPLY_VECTOR3, VECTOR3, *, VECTOR3, VECTOR3);
+			OPCODE_TYPED_OPERATOR(MULTIPLY_VECTOR3_FLOAT, VECTOR3, *, FLOAT, VECTOR3);
+
 			OPCODE(OPCODE_TYPE_TEST_BUILTIN) {
 				CHECK_SPACE(4);
 
@@ -1418,6 +1517,22 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+#define OPCODE_ASSIGN_TYPED_VALUE(m_v_type, m_c_type) \
+	OPCODE(OPCODE_ASSIGN_##m_v_type) { \
+		CHECK_SPACE(3); \
+		GET_VARIANT_PTR(dst, 0); \
+		GET_VARIANT_PTR(src, 1); \
+		VariantTypeChanger<m_c_type>::change(dst); \
+		*VariantInternal::OP_GET_##m_v_type(dst) = *VariantInternal::OP_GET_##m_v_type(src); \
+		ip += 3; \
+	} \
+	DISPATCH_OPCODE
+
+			OPCODE_ASSIGN_TYPED_VALUE(INT, int64_t);
+			OPCODE_ASSIGN_TYPED_VALUE(FLOAT, double);
+			OPCODE_ASSIGN_TYPED_VALUE(VECTOR2, Vector2);
+			OPCODE_ASSIGN_TYPED_VALUE(VECTOR3, Vector3);
+
 			OPCODE(OPCODE_ASSIGN_TYPED_BUILTIN) {
 				CHECK_SPACE(4);
 				GET_VARIANT_PTR(dst, 0);
@@ -2600,11 +2715,20 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 					Ref<GDScriptFunctionState> gdfs = memnew(GDScriptFunctionState);
 					gdfs->function = this;
 
-					gdfs->state.stack.resize(alloca_size);
-
-					// First `FIXED_ADDRESSES_MAX` stack addresses are special, so we just skip them here.
-					for (int i = FIXED_ADDRESSES_MAX; i < _stack_size; i++) {
-						memnew_placement(&gdfs->state.stack.write[sizeof(Variant) * i], Variant(stack[i]));
+					// The state takes over the frame as is, so the locals are not copied. The first `FIXED_ADDRESSES_MAX`
+					// stack addresses are special and rebuilt on resume.
+					if (frame_size) {
+						gdfs->state.stack = (uint8_t *)stack;
+						gdfs->state.stack_alloc_size = frame_size;
+					} else {
+						// Only functions containing `await` get a pooled frame. Should another function get here,
+						// copy the locals out of the native stack. The originals are destroyed when this call exits.
+						gdfs->state.stack = _alloc_frame(alloca_size);
+						gdfs->state.stack_alloc_size = alloca_size;
+						Variant *state_stack = (Variant *)gdfs->state.stack;
+						for (int i = FIXED_ADDRESSES_MAX; i < _stack_size; i++) {
+							memnew_placement(&state_stack[i], Variant(stack[i]));
+						}
 					}
 					gdfs->state.stack_size = _stack_size;
 					gdfs->state.ip = ip + 2;
@@ -2636,8 +2760,33 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 
 					retvalue = gdfs;
 
+					if (frame_size) {
+						// Nothing may touch the frame once the signal is connected, since it could be resumed from another thread.
+						for (int i = 0; i < FIXED_ADDRESSES_MAX; i++) {
+							stack[i].~Variant();
+						}
+						frame_handed_off = true;
+					}
+
 					Error err = sig.connect(Callable(gdfs.ptr(), "_signal_callback").bind(retvalue), Object::CONNECT_ONE_SHOT);
 					if (err != OK) {
+						if (frame_handed_off) {
+							// Nothing can resume the state, so take the frame back. The error is reported with it,
+							// and it's released when this call exits.
+							{
+								MutexLock lock(GDScriptLanguage::get_singleton()->mutex);
+								gdfs->state.stack = nullptr;
+								gdfs->state.stack_size = 0;
+							}
+							frame_handed_off = false;
+							if (p_instance) {
+								memnew_placement(&stack[ADDR_STACK_SELF], Variant(p_instance->owner));
+							} else {
+								memnew_placement(&stack[ADDR_STACK_SELF], Variant);
+							}
+							memnew_placement(&stack[ADDR_STACK_CLASS], Variant(script));
+							memnew_placement(&stack[ADDR_STACK_NIL], Variant);
+						}
 						err_text = "Error connecting to signal: " + sig.get_name() + " during await.";
 						OPCODE_BREAK;
 					}
@@ -4007,8 +4156,14 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 		GDScriptLanguage::get_singleton()->exit_function();
 	}
 
-	for (int i = 0; i < _stack_size; i++) {
-		stack[i].~Variant();
+	// Once handed off to a suspended function state, the frame isn't ours to clear anymore.
+	if (!frame_handed_off) {
+		for (int i = 0; i < _stack_size; i++) {
+			stack[i].~Variant();
+		}
+		if (frame_size) {
+			_free_frame((uint8_t *)stack, frame_size);
+		}
 	}
 
 	call_depth--;
@@ -31,6 +31,7 @@
 #include "register_types.h"
 
 #include "gdscript.h"
+#include "gdscript_bytecode_cache.h"
 #include "gdscript_cache.h"
 #include "gdscript_parser.h"
 #include "gdscript_tokenizer_buffer.h"
@@ -83,15 +84,64 @@ class EditorExportGDScript : public EditorExportPlugin {
 
 	static constexpr EditorExportPreset::ScriptExportMode DEFAULT_SCRIPT_MODE = EditorExportPreset::MODE_SCRIPT_BINARY_TOKENS_COMPRESSED;
 	EditorExportPreset::ScriptExportMode script_mode = DEFAULT_SCRIPT_MODE;
+	bool export_debug = false;
+	GDScriptBytecodeCache *bytecode_cache = nullptr;
+
+	static bool _has_assert(const String &p_source) {
+		GDScriptTokenizerText tokenizer;
+		tokenizer.set_source_code(p_source);
+		for (GDScriptTokenizer::Token token = tokenizer.scan(); token.type != GDScriptTokenizer::Token::TK_EOF; token = tokenizer.scan()) {
+			if (token.type == GDScriptTokenizer::Token::ASSERT) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void _export_bytecode_cache(const String &p_path, const String &p_source, const Vector<uint8_t> &p_binary_tokens) {
+		// Asserts are compiled in the editor, but must not run in release builds.
+		if (!export_debug && _has_assert(p_source)) {
+			return;
+		}
+
+		Ref<GDScript> script = ResourceLoader::load(p_path);
+		if (script.is_null() || !script->is_valid() || script->get_source_code() != p_source) {
+			return;
+		}
+
+		String error;
+		Vector<uint8_t> cache = bytecode_cache->save(script, p_binary_tokens, &error);
+		if (cache.is_empty()) {
+			print_verbose(vformat(R"(GDScript: Not exporting the bytecode cache of "%s": %s)", p_path, error));
+			return;
+		}
+		add_file(GDScriptBytecodeCache::get_cache_path(p_path), cache, false);
+	}
 
 protected:
+	virtual void _get_export_options(const Ref<EditorExportPlatform> &p_export_platform, List<EditorExportPlatform::ExportOption> *r_options) const override {
+		r_options->push_back(EditorExportPlatform::ExportOption(PropertyInfo(Variant::BOOL, "gdscript/bytecode_cache"), false));
+	}
+
 	virtual void _export_begin(const HashSet<String> &p_features, bool p_debug, const String &p_path, int p_flags) override {
 		script_mode = DEFAULT_SCRIPT_MODE;
+		export_debug = p_debug;
 
 		const Ref<EditorExportPreset> &preset = get_export_preset();
 		if (preset.is_valid()) {
 			script_mode = preset->get_script_export_mode();
 		}
+
+		if (script_mode != EditorExportPreset::MODE_SCRIPT_TEXT && get_option("gdscript/bytecode_cache")) {
+			bytecode_cache = memnew(GDScriptBytecodeCache);
+		}
+	}
+
+	virtual void _export_end() override {
+		if (bytecode_cache) {
+			memdelete(bytecode_cache);
+			bytecode_cache = nullptr;
+		}
 	}
 
 	virtual void _export_file(const String &p_path, const String &p_type, const HashSet<String> &p_features) override {
@@ -112,10 +162,20 @@ protected:
 		}
 
 		add_file(p_path.get_basename() + ".gdc", file, true);
+
+		if (bytecode_cache) {
+			_export_bytecode_cache(p_path, source, file);
+		}
 	}
 
 public:
 	virtual String get_name() const override { return "GDScript"; }
+
+	~EditorExportGDScript() {
+		if (bytecode_cache) {
+			memdelete(bytecode_cache);
+		}
+	}
 };
 
 static void _editor_init() {
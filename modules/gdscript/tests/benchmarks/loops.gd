@@ -0,0 +1,30 @@
+extends RefCounted
+
+# Loop overhead: nested ranges with steps, while loops and branches with little work in their bodies.
+
+
+func nested(count: int) -> int:
+	var sum: int = 0
+	for i in range(count, 0, -1):
+		for j in range(0, i, 3):
+			if (i + j) % 7 == 0:
+				sum -= j
+			elif i > j:
+				sum += 1
+	return sum
+
+
+func fibonacci(count: int) -> int:
+	var a: int = 0
+	var b: int = 1
+	var i: int = 0
+	while i < count:
+		var next: int = (a + b) % 1000000007
+		a = b
+		b = next
+		i += 1
+	return a
+
+
+func run(n: int) -> float:
+	return float(nested(n) + fibonacci(n * 100))
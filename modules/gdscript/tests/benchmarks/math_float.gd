@@ -0,0 +1,35 @@
+extends RefCounted
+
+# Float arithmetic and comparisons: numerical integration and escape-time iteration.
+
+
+func integrate_pi(steps: int) -> float:
+	var step: float = 1.0 / steps
+	var sum: float = 0.0
+	for i in steps:
+		var x: float = (i + 0.5) * step
+		sum += 4.0 / (1.0 + x * x)
+	return sum * step
+
+
+func mandelbrot(size: int, max_iterations: int) -> int:
+	var inside: int = 0
+	for py in size:
+		var ci: float = 2.0 * py / size - 1.0
+		for px in size:
+			var cr: float = 2.5 * px / size - 2.0
+			var zr: float = 0.0
+			var zi: float = 0.0
+			var iteration: int = 0
+			while iteration < max_iterations and zr * zr + zi * zi <= 4.0:
+				var t: float = zr * zr - zi * zi + cr
+				zi = 2.0 * zr * zi + ci
+				zr = t
+				iteration += 1
+			if iteration == max_iterations:
+				inside += 1
+	return inside
+
+
+func run(n: int) -> float:
+	return integrate_pi(n * 100) + mandelbrot((n >> 2) + 8, 50)
@@ -0,0 +1,30 @@
+extends RefCounted
+
+# Integer arithmetic and bitwise operations: a linear congruential generator and Collatz sequences.
+
+
+func lcg(seed: int, count: int) -> int:
+	var state: int = seed
+	var result: int = 0
+	for i in count:
+		state = (state * 1103515245 + 12345) & 0x7FFFFFFF
+		result = result ^ (state >> 3)
+		result = (result * 31 + i) & 0xFFFFFFFF
+	return result
+
+
+func collatz_steps(limit: int) -> int:
+	var total: int = 0
+	for start in range(1, limit):
+		var value: int = start
+		while value != 1:
+			if value & 1 == 0:
+				value = value >> 1
+			else:
+				value = 3 * value + 1
+			total += 1
+	return total
+
+
+func run(n: int) -> float:
+	return float(lcg(12345, n * 100) + collatz_steps(n * 2))
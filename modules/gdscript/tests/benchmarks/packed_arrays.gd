@@ -0,0 +1,37 @@
+extends RefCounted
+
+# Indexed access to packed arrays: a prefix sum and a bubble sort.
+
+
+func prefix_sum(count: int) -> float:
+	var values := PackedFloat64Array()
+	values.resize(count)
+	for i in count:
+		values[i] = sqrt(float(i))
+	for i in range(1, count):
+		values[i] = values[i] + values[i - 1]
+	return values[count - 1]
+
+
+func bubble_sort(count: int) -> int:
+	var values := PackedInt64Array()
+	values.resize(count)
+	var state: int = 7
+	for i in count:
+		state = (state * 75 + 74) % 65537
+		values[i] = state
+	for i in count:
+		for j in range(0, count - i - 1):
+			var a: int = values[j]
+			var b: int = values[j + 1]
+			if a > b:
+				values[j] = b
+				values[j + 1] = a
+	var checksum: int = 0
+	for i in count:
+		checksum = (checksum * 31 + values[i]) % 1000000007
+	return checksum
+
+
+func run(n: int) -> float:
+	return prefix_sum(n * 10) + bubble_sort((n >> 2) + 2)
@@ -0,0 +1,41 @@
+extends RefCounted
+
+# Built-in math types: constructors, operators, properties and methods which the analyzer resolves statically.
+
+
+func simulate(count: int, steps: int) -> float:
+	var positions: Array[Vector3] = []
+	var velocities: Array[Vector3] = []
+	for i in count:
+		positions.push_back(Vector3(i, i * 0.5, -i))
+		velocities.push_back(Vector3(1.0, 0.0, 0.5 * (i % 3)))
+
+	var gravity := Vector3(0.0, -9.8, 0.0)
+	var delta: float = 1.0 / 60.0
+	for _step in steps:
+		for i in count:
+			var velocity: Vector3 = velocities[i] + gravity * delta
+			var position: Vector3 = positions[i] + velocity * delta
+			if position.y < 0.0:
+				position.y = -position.y
+				velocity.y = -velocity.y * 0.9
+			velocities[i] = velocity
+			positions[i] = position
+
+	var checksum: float = 0.0
+	for i in count:
+		checksum += positions[i].length() + velocities[i].dot(Vector3.ONE)
+	return checksum
+
+
+func rotate_points(count: int) -> float:
+	var point := Vector2(1.0, 0.0)
+	var sum := Vector2()
+	for i in count:
+		point = point.rotated(0.01)
+		sum += point * 0.5
+	return sum.x + sum.y
+
+
+func run(n: int) -> float:
+	return simulate((n >> 3) + 1, 60) + rotate_points(n * 10)
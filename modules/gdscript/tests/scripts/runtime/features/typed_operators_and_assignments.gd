@@ -0,0 +1,44 @@
+# Operators and assignments on int, float, Vector2 and Vector3 values of known types use dedicated opcodes.
+
+var member_int: int = 5
+var member_vector: Vector3 = Vector3(1, 2, 3)
+
+func test():
+	var a: int = 7
+	var b: int = -3
+	print(a + b, " ", a - b, " ", a * b)
+	print(a == b, " ", a != b, " ", a < b, " ", a <= b, " ", a > b, " ", a >= b)
+
+	var x: float = 2.5
+	var y: float = 0.5
+	print(x + y, " ", x - y, " ", x * y, " ", x / y)
+	print(x < y, " ", x <= y, " ", x > y, " ", x >= y)
+
+	var not_a_number: float = NAN
+	print(not_a_number < x, " ", not_a_number >= x)
+
+	var u: Vector2 = Vector2(1, 2)
+	var v: Vector2 = Vector2(0.5, -1)
+	print(u + v, " ", u - v, " ", u * v, " ", u * x)
+
+	var p: Vector3 = member_vector
+	var q: Vector3 = Vector3(2, 0, -1)
+	print(p + q, " ", p - q, " ", p * q, " ", p * y)
+
+	member_int = a
+	a = b
+	b = member_int
+	print(a, " ", b, " ", member_int)
+	x = y
+	print(x)
+	u = v
+	print(u)
+	p = q
+	print(p)
+
+	var sum: int = 0
+	var total: float = 0.0
+	for i: int in 10:
+		sum = sum + i * i
+		total = total + i * y
+	print(sum, " ", total)
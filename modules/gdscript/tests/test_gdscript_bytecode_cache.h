@@ -0,0 +1,222 @@
+/**************************************************************************/
+/*  test_gdscript_bytecode_cache.h                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "../gdscript.h"
+#include "../gdscript_bytecode_cache.h"
+#include "../gdscript_tokenizer_buffer.h"
+
+#include "core/os/os.h"
+#include "tests/test_macros.h"
+
+namespace TestGDScriptBytecodeCache {
+
+static const char *round_trip_source = R"(
+extends RefCounted
+
+signal changed(value: int)
+
+const SCALE = 3
+const NAMES = ["a", "b"]
+const TABLE = { "x": 1, "y": 2 }
+
+class Inner:
+	var base_value := 2
+
+	func twice() -> int:
+		return base_value * 2
+
+static var calls: int
+
+var health: int = 10:
+	set(value):
+		health = clampi(value, 0, 100)
+		changed.emit(health)
+var items: Array[int] = [1, 2, 3]
+
+func run() -> String:
+	calls += 1
+	health = 250
+	var inner := Inner.new()
+	var factor := SCALE
+	var scaled := items.map(func(item: int) -> int: return item * factor)
+	var offset := Vector2(1, 2) + Vector2(3, 4)
+	var text: String = NAMES[1].to_upper()
+	var total: int = TABLE["x"] + TABLE["y"] + max(inner.twice(), len(scaled))
+	var editor := Engine.is_editor_hint()
+	return "%d %s %s %s %d %s %d" % [health, scaled, offset, text, total, editor, calls]
+)";
+
+static Ref<GDScript> compile_script(const String &p_source) {
+	Ref<GDScript> script;
+	script.instantiate();
+	script->set_source_code(p_source);
+	ERR_PRINT_OFF;
+	const Error err = script->reload();
+	ERR_PRINT_ON;
+	return err == OK ? script : Ref<GDScript>();
+}
+
+// Same as an exported script, which only has its binary tokens and maybe a bytecode cache.
+static Ref<GDScript> load_script(const Vector<uint8_t> &p_binary_tokens, const Vector<uint8_t> &p_cache) {
+	Ref<GDScript> script;
+	script.instantiate();
+	script->set_binary_tokens_source(p_binary_tokens);
+	script->set_bytecode_cache(p_cache);
+	ERR_PRINT_OFF;
+	const Error err = script->reload();
+	ERR_PRINT_ON;
+	return err == OK ? script : Ref<GDScript>();
+}
+
+static Ref<RefCounted> instantiate(const Ref<GDScript> &p_script) {
+	Ref<RefCounted> object = memnew(RefCounted);
+	object->set_script(p_script);
+	return object;
+}
+
+TEST_CASE("[Modules][GDScript][BytecodeCache] Cached scripts behave like compiled ones") {
+	Ref<GDScript> compiled = compile_script(round_trip_source);
+	REQUIRE(compiled.is_valid());
+
+	const Vector<uint8_t> tokens = GDScriptTokenizerBuffer::parse_code_string(round_trip_source, GDScriptTokenizerBuffer::COMPRESS_NONE);
+	GDScriptBytecodeCache bytecode_cache;
+	String error;
+	const Vector<uint8_t> cache = bytecode_cache.save(compiled, tokens, &error);
+	INFO(error);
+	REQUIRE_FALSE(cache.is_empty());
+
+	Ref<GDScript> cached;
+	cached.instantiate();
+	cached->set_binary_tokens_source(tokens);
+	CHECK(GDScriptBytecodeCache::load(cached.ptr(), cache) == OK);
+	REQUIRE(cached->is_valid());
+
+	CHECK(cached->has_script_signal("changed"));
+	CHECK(cached->get_constants().size() == compiled->get_constants().size());
+	CHECK(cached->get_member_functions().has("run"));
+	CHECK(cached->get_subclasses().has("Inner"));
+
+	const String expected = instantiate(compiled)->call("run");
+	CHECK(expected == "100 [3, 6, 9] (4.0, 6.0) B 7 false 1");
+	CHECK(String(instantiate(cached)->call("run")) == expected);
+
+	// Saving a cached script gives the same cache.
+	CHECK(bytecode_cache.save(cached, tokens) == cache);
+}
+
+TEST_CASE("[Modules][GDScript][BytecodeCache] Invalid caches fall back to compiling") {
+	const String source = "extends RefCounted\n\nfunc run() -> int:\n\treturn 6 * 7\n";
+	Ref<GDScript> compiled = compile_script(source);
+	REQUIRE(compiled.is_valid());
+
+	const Vector<uint8_t> tokens = GDScriptTokenizerBuffer::parse_code_string(source, GDScriptTokenizerBuffer::COMPRESS_NONE);
+	const Vector<uint8_t> cache = GDScriptBytecodeCache().save(compiled, tokens);
+	REQUIRE_FALSE(cache.is_empty());
+
+	Vector<Vector<uint8_t>> invalid_caches;
+	Vector<uint8_t> invalid = cache;
+	invalid.write[4] += 1; // Format version.
+	invalid_caches.push_back(invalid);
+	invalid = cache;
+	invalid.write[8] += 1; // Engine hash.
+	invalid_caches.push_back(invalid);
+	invalid = cache;
+	invalid.resize(cache.size() / 2);
+	invalid_caches.push_back(invalid);
+	invalid = cache;
+	invalid.push_back(0);
+	invalid_caches.push_back(invalid);
+
+	for (int i = 0; i < invalid_caches.size(); i++) {
+		INFO(vformat("Invalid cache %d", i));
+		Ref<GDScript> script;
+		script.instantiate();
+		script->set_binary_tokens_source(tokens);
+		CHECK(GDScriptBytecodeCache::load(script.ptr(), invalid_caches[i]) != OK);
+
+		script = load_script(tokens, invalid_caches[i]);
+		REQUIRE(script.is_valid());
+		CHECK(script->get_bytecode_cache().is_empty());
+		CHECK(int(instantiate(script)->call("run")) == 42);
+	}
+
+	// The cache of another version of the script isn't used.
+	const Vector<uint8_t> other_tokens = GDScriptTokenizerBuffer::parse_code_string(source.replace("7", "8"), GDScriptTokenizerBuffer::COMPRESS_NONE);
+	Ref<GDScript> script;
+	script.instantiate();
+	script->set_binary_tokens_source(other_tokens);
+	CHECK(GDScriptBytecodeCache::load(script.ptr(), cache) == ERR_FILE_UNRECOGNIZED);
+
+	script = load_script(other_tokens, cache);
+	REQUIRE(script.is_valid());
+	CHECK(int(instantiate(script)->call("run")) == 48);
+}
+
+TEST_CASE_BENCHMARK("[Benchmark][Modules][GDScript][BytecodeCache] Loading scripts from tokens and from the cache") {
+	const int script_count = 300;
+	const int function_count = 20;
+
+	Vector<Vector<uint8_t>> tokens;
+	Vector<Vector<uint8_t>> caches;
+	uint64_t cache_size = 0;
+	GDScriptBytecodeCache bytecode_cache;
+	for (int i = 0; i < script_count; i++) {
+		String source = "extends RefCounted\n\nconst ID = " + itos(i) + "\nvar values: Array[float] = []\n";
+		for (int j = 0; j < function_count; j++) {
+			source += vformat("\nfunc function_%d(count: int, scale: float = 1.5) -> float:\n\tvar sum := 0.0\n\tfor k in count:\n\t\tsum += sqrt(float(k * ID + %d)) * scale\n\t\tvalues.push_back(sum)\n\tif sum > 1000.0:\n\t\tprint(\"large\", sum)\n\treturn sum\n", j, j);
+		}
+		Ref<GDScript> compiled = compile_script(source);
+		REQUIRE(compiled.is_valid());
+		tokens.push_back(GDScriptTokenizerBuffer::parse_code_string(source, GDScriptTokenizerBuffer::COMPRESS_NONE));
+		caches.push_back(bytecode_cache.save(compiled, tokens[i]));
+		REQUIRE_FALSE(caches[i].is_empty());
+		cache_size += caches[i].size();
+	}
+
+	const char *mode_names[] = { "compiled from tokens", "loaded from the bytecode cache" };
+	for (int mode = 0; mode < 2; mode++) {
+		Vector<Ref<GDScript>> scripts;
+		const uint64_t start = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < script_count; i++) {
+			scripts.push_back(load_script(tokens[i], mode == 0 ? Vector<uint8_t>() : caches[i]));
+		}
+		const uint64_t usec = OS::get_singleton()->get_ticks_usec() - start;
+
+		for (const Ref<GDScript> &script : scripts) {
+			REQUIRE(script.is_valid());
+		}
+		print_line(vformat("%d scripts %s in %d usec (%.1f usec per script).", script_count, mode_names[mode], usec, (double)usec / script_count));
+	}
+	print_line(vformat("Bytecode cache: %d bytes per script on average.", cache_size / script_count));
+}
+
+} // namespace TestGDScriptBytecodeCache
@@ -0,0 +1,129 @@
+/**************************************************************************/
+/*  test_gdscript_cache.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "../gdscript.h"
+#include "../gdscript_cache.h"
+
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "core/os/os.h"
+#include "tests/test_macros.h"
+#include "tests/test_utils.h"
+
+namespace TestGDScriptCache {
+
+static String write_script(const String &p_name, const String &p_source) {
+	const String path = TestUtils::get_temp_path(p_name);
+	Ref<FileAccess> fa = FileAccess::open(path, FileAccess::ModeFlags::WRITE);
+	fa->store_string(p_source);
+	fa->close();
+	return path;
+}
+
+TEST_CASE("[Modules][GDScript] Scripts are parsed ahead with their dependencies") {
+	const String base_path = write_script("gdscript_parse_base.gd", "extends RefCounted\n\nfunc value() -> int:\n\treturn 21\n");
+	const String helper_path = write_script("gdscript_parse_helper.gd", "extends RefCounted\n\nstatic func twice(x: int) -> int:\n\treturn x * 2\n");
+	const String main_path = write_script("gdscript_parse_main.gd", R"(extends "gdscript_parse_base.gd"
+
+const Helper = preload("gdscript_parse_helper.gd")
+
+func run() -> int:
+	return Helper.twice(value())
+)");
+
+	Vector<Ref<GDScriptParserRef>> parsers = GDScriptCache::parse_scripts({ main_path });
+	CHECK(parsers.size() == 3);
+	for (const Ref<GDScriptParserRef> &parser : parsers) {
+		CHECK(parser->get_status() == GDScriptParserRef::PARSED);
+	}
+	CHECK(GDScriptCache::has_parser(main_path));
+	CHECK(GDScriptCache::has_parser(base_path));
+	CHECK(GDScriptCache::has_parser(helper_path));
+
+	// Already parsed scripts are skipped.
+	CHECK(GDScriptCache::parse_scripts({ main_path }).is_empty());
+
+	Ref<GDScript> script = ResourceLoader::load(main_path);
+	REQUIRE(script.is_valid());
+	CHECK(script->is_valid());
+	Ref<RefCounted> object = memnew(RefCounted);
+	object->set_script(script);
+	CHECK(int(object->call("run")) == 42);
+
+	object.unref();
+	script.unref();
+	parsers.clear();
+	DirAccess::remove_file_or_error(main_path);
+	DirAccess::remove_file_or_error(base_path);
+	DirAccess::remove_file_or_error(helper_path);
+}
+
+TEST_CASE_BENCHMARK("[Benchmark][Modules][GDScript] Parsing scripts one by one and in parallel") {
+	const int script_count = 200;
+
+	Vector<String> paths;
+	String main_source = "extends RefCounted\n\n";
+	for (int i = 0; i < script_count; i++) {
+		String source = "extends RefCounted\n";
+		for (int j = 0; j < 40; j++) {
+			source += vformat("\nfunc function_%d(count: int, scale: float = 1.5) -> float:\n\tvar sum := 0.0\n\tfor k in count:\n\t\tif k %% 3 == 0:\n\t\t\tsum += sqrt(float(k)) * scale\n\t\telse:\n\t\t\tsum -= float(k) / (scale + %d)\n\treturn sum\n", j, j);
+		}
+		paths.push_back(write_script(vformat("gdscript_parse_benchmark_%d.gd", i), source));
+		main_source += vformat("const Script%d = preload(\"gdscript_parse_benchmark_%d.gd\")\n", i, i);
+	}
+	const String main_path = write_script("gdscript_parse_benchmark_main.gd", main_source);
+
+	for (int parallel = 0; parallel < 2; parallel++) {
+		Vector<Ref<GDScriptParserRef>> parsers;
+		const uint64_t start = OS::get_singleton()->get_ticks_usec();
+		if (parallel) {
+			parsers = GDScriptCache::parse_scripts({ main_path });
+		} else {
+			Error err = OK;
+			parsers.push_back(GDScriptCache::get_parser(main_path, GDScriptParserRef::PARSED, err));
+			for (const String &path : paths) {
+				parsers.push_back(GDScriptCache::get_parser(path, GDScriptParserRef::PARSED, err));
+			}
+		}
+		const uint64_t usec = OS::get_singleton()->get_ticks_usec() - start;
+
+		CHECK(parsers.size() == script_count + 1);
+		print_line(vformat("%d scripts parsed %s in %d usec.", script_count + 1, parallel ? "in parallel" : "one by one", usec));
+	}
+
+	DirAccess::remove_file_or_error(main_path);
+	for (const String &path : paths) {
+		DirAccess::remove_file_or_error(path);
+	}
+}
+
+} // namespace TestGDScriptCache
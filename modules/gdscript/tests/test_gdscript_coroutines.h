@@ -0,0 +1,165 @@
+/**************************************************************************/
+/*  test_gdscript_coroutines.h                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "../gdscript.h"
+
+#include "core/os/os.h"
+#include "tests/test_macros.h"
+
+namespace TestGDScriptCoroutines {
+
+static const char *coroutine_source = R"(
+extends RefCounted
+
+signal tick
+
+var results: Array = []
+var resumed: int = 0
+
+func plain(value: int) -> int:
+	return value + 1
+
+func inner(value: int) -> int:
+	await tick
+	return value * 2
+
+func outer(value: int) -> void:
+	var local: int = value + 1
+	var doubled: int = await inner(local)
+	await tick
+	results.append(doubled + local)
+
+func loop(times: int) -> void:
+	var sum: int = 0
+	for i in times:
+		await tick
+		sum += i
+	results.append(sum)
+
+func wait_once(value: int) -> void:
+	var local: String = str(value)
+	await tick
+	if local == str(value):
+		resumed += 1
+)";
+
+static Ref<RefCounted> instantiate_coroutines() {
+	Ref<GDScript> script;
+	script.instantiate();
+	script->set_source_code(coroutine_source);
+	ERR_PRINT_OFF;
+	const Error err = script->reload();
+	ERR_PRINT_ON;
+	if (err != OK) {
+		return Ref<RefCounted>();
+	}
+
+	Ref<RefCounted> object = memnew(RefCounted);
+	object->set_script(script);
+	return object;
+}
+
+static bool is_coroutine(const Ref<RefCounted> &p_object, const StringName &p_function) {
+	Ref<GDScript> script = p_object->get_script();
+	GDScriptFunction *const *function = script->get_member_functions().getptr(p_function);
+	return function && (*function)->is_coroutine();
+}
+
+TEST_CASE("[Modules][GDScript][Coroutines] Functions are resumed in place after await") {
+	Ref<RefCounted> object = instantiate_coroutines();
+	REQUIRE(object.is_valid());
+
+	CHECK_FALSE(is_coroutine(object, "plain"));
+	CHECK(is_coroutine(object, "inner"));
+	CHECK(is_coroutine(object, "outer"));
+
+	SUBCASE("Awaiting another coroutine") {
+		object->call("outer", 4);
+		object->call("outer", 10);
+		CHECK(((Array)object->get("results")).is_empty());
+
+		for (int i = 0; i < 3; i++) {
+			object->emit_signal("tick");
+		}
+		const Array results = object->get("results");
+		REQUIRE(results.size() == 2);
+		CHECK(results[0] == Variant(15));
+		CHECK(results[1] == Variant(33));
+	}
+
+	SUBCASE("Awaiting repeatedly in a loop") {
+		object->call("loop", 100);
+		for (int i = 0; i < 100; i++) {
+			CHECK(((Array)object->get("results")).is_empty());
+			object->emit_signal("tick");
+		}
+		const Array results = object->get("results");
+		REQUIRE(results.size() == 1);
+		CHECK(results[0] == Variant(4950));
+	}
+}
+
+TEST_CASE_BENCHMARK("[Benchmark][Modules][GDScript][Coroutines] Cost of await and resume") {
+	const int count = 100000;
+
+	Ref<RefCounted> object = instantiate_coroutines();
+	REQUIRE(object.is_valid());
+
+	// Suspends many coroutines at once, then resumes them all with a single signal.
+	const uint64_t mem_usage = Memory::get_mem_usage();
+	uint64_t start = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < count; i++) {
+		object->call("wait_once", i);
+	}
+	const uint64_t suspend_usec = OS::get_singleton()->get_ticks_usec() - start;
+	const uint64_t suspended_mem_usage = Memory::get_mem_usage() - mem_usage;
+
+	start = OS::get_singleton()->get_ticks_usec();
+	object->emit_signal("tick");
+	const uint64_t resume_usec = OS::get_singleton()->get_ticks_usec() - start;
+	CHECK((int)object->get("resumed") == count);
+
+	print_line(vformat("%d coroutines: suspended in %d usec, resumed in %d usec, %d bytes each while suspended.", count, suspend_usec, resume_usec, suspended_mem_usage / count));
+
+	// A single coroutine going through many await/resume cycles.
+	object->call("loop", count);
+	start = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < count; i++) {
+		object->emit_signal("tick");
+	}
+	const uint64_t cycle_usec = OS::get_singleton()->get_ticks_usec() - start;
+	REQUIRE(((Array)object->get("results")).size() == 1);
+
+	print_line(vformat("%d await/resume cycles in %d usec (%.3f usec each).", count, cycle_usec, (double)cycle_usec / count));
+}
+
+} // namespace TestGDScriptCoroutines
@@ -0,0 +1,183 @@
+/**************************************************************************/
+/*  test_gdscript_jit.h                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "../gdscript.h"
+
+#include "core/io/file_access.h"
+#include "core/os/os.h"
+#include "tests/test_macros.h"
+
+namespace TestGDScriptJIT {
+
+// Typed scripts doing math and loops, with a `run(n: int) -> float` function returning a checksum.
+static const char *benchmark_scripts[] = {
+	"loops.gd",
+	"math_float.gd",
+	"math_int.gd",
+	"packed_arrays.gd",
+	"vectors.gd",
+};
+
+static Ref<GDScript> compile_script(const String &p_source, bool p_jit) {
+	GDScriptLanguage *language = GDScriptLanguage::get_singleton();
+	const bool jit_enabled = language->is_jit_enabled();
+	language->set_jit_enabled(p_jit);
+
+	Ref<GDScript> script;
+	script.instantiate();
+	script->set_source_code(p_source);
+	ERR_PRINT_OFF;
+	const Error err = script->reload();
+	ERR_PRINT_ON;
+
+	language->set_jit_enabled(jit_enabled);
+	return err == OK ? script : Ref<GDScript>();
+}
+
+static Ref<GDScript> compile_benchmark(const String &p_name, bool p_jit) {
+	return compile_script(FileAccess::get_file_as_string(String("modules/gdscript/tests/benchmarks").path_join(p_name)), p_jit);
+}
+
+static Ref<RefCounted> instantiate(const Ref<GDScript> &p_script) {
+	Ref<RefCounted> object = memnew(RefCounted);
+	object->set_script(p_script);
+	return object;
+}
+
+static bool is_compiled(const Ref<GDScript> &p_script, const StringName &p_function) {
+	GDScriptFunction *const *function = p_script->get_member_functions().getptr(p_function);
+	return function && (*function)->is_jit_compiled();
+}
+
+TEST_CASE("[Modules][GDScript][JIT] Compiled benchmarks give the same results as the interpreter") {
+	for (const char *name : benchmark_scripts) {
+		INFO(name);
+		Ref<GDScript> interpreted = compile_benchmark(name, false);
+		Ref<GDScript> compiled = compile_benchmark(name, true);
+		REQUIRE(interpreted.is_valid());
+		REQUIRE(compiled.is_valid());
+
+		CHECK_FALSE(is_compiled(interpreted, "run"));
+		CHECK(is_compiled(compiled, "run") == GDScriptJIT::is_supported());
+
+		const Variant expected = instantiate(interpreted)->call("run", 40);
+		const Variant result = instantiate(compiled)->call("run", 40);
+		CHECK(expected.get_type() == Variant::FLOAT);
+		CHECK(result == expected);
+	}
+}
+
+TEST_CASE("[Modules][GDScript][JIT] Compiled code falls back to the interpreter") {
+	Ref<GDScript> script = compile_script(R"(
+extends RefCounted
+
+var offset: int = 3
+var untyped = 10
+
+func default_arguments(a: int, b: int = 2, c: float = 0.5) -> float:
+	return a * b + c
+
+func members(count: int) -> int:
+	var sum: int = 0
+	for i in count:
+		sum += i + offset
+	offset += 1
+	return sum
+
+func mixed(count: int) -> int:
+	var sum: int = 0
+	for i in count:
+		var value = i * 2 # Untyped, runs in the interpreter.
+		sum += value + untyped
+	return sum
+
+func nan_comparisons() -> Array:
+	var not_a_number: float = NAN
+	var one: float = 1.0
+	return [not_a_number == not_a_number, not_a_number != not_a_number, not_a_number < one, not_a_number >= one, one <= one, -0.0 == one - one]
+
+func negative_step() -> int:
+	var sum: int = 0
+	for i in range(10, -10, -3):
+		sum = sum * 3 + i
+	for i in range(5, 5):
+		sum += 1000
+	return sum
+
+func typed_return(value: int) -> float:
+	return value
+
+func inline_operators(a: int, b: float) -> Array:
+	return [a + 7, a - 7, a * -3, a & 6, a | 9, a ^ 12, -a, b + a, a - b, b * b, b / 4.0, -b, not (a > 2), a <= b]
+)",
+			true);
+	REQUIRE(script.is_valid());
+	Ref<RefCounted> object = instantiate(script);
+
+	CHECK(is_compiled(script, "default_arguments") == GDScriptJIT::is_supported());
+	CHECK(object->call("default_arguments", 3) == Variant(6.5));
+	CHECK(object->call("default_arguments", 3, 4) == Variant(12.5));
+	CHECK(object->call("default_arguments", 3, 4, 1.0) == Variant(13.0));
+
+	CHECK(object->call("members", 4) == Variant(18));
+	CHECK(object->call("members", 4) == Variant(22));
+	CHECK(object->call("mixed", 5) == Variant(70));
+	CHECK(object->call("nan_comparisons") == Variant(Array{ false, true, false, false, true, true }));
+	CHECK(object->call("negative_step") == Variant(9301));
+	CHECK(object->call("typed_return", 5).get_type() == Variant::FLOAT);
+	CHECK(object->call("inline_operators", 5, 2.5) == Variant(Array{ 12, -2, -15, 4, 13, 9, -5, 7.5, 2.5, 6.25, 0.625, -2.5, false, false }));
+}
+
+TEST_CASE_BENCHMARK("[Benchmark][Modules][GDScript][JIT] Speedup of compiled benchmarks") {
+	const int n = 2000;
+
+	for (const char *name : benchmark_scripts) {
+		Ref<GDScript> interpreted = compile_benchmark(name, false);
+		Ref<GDScript> compiled = compile_benchmark(name, true);
+		REQUIRE(interpreted.is_valid());
+		REQUIRE(compiled.is_valid());
+
+		uint64_t usec[2];
+		Variant results[2];
+		for (int i = 0; i < 2; i++) {
+			Ref<RefCounted> object = instantiate(i == 0 ? interpreted : compiled);
+			const uint64_t start = OS::get_singleton()->get_ticks_usec();
+			results[i] = object->call("run", n);
+			usec[i] = OS::get_singleton()->get_ticks_usec() - start;
+		}
+
+		CHECK(results[0] == results[1]);
+		print_line(vformat("%s: interpreted %d usec, compiled %d usec (%.2fx).", name, usec[0], usec[1], (double)usec[0] / MAX(usec[1], (uint64_t)1)));
+	}
+}
+
+} // namespace TestGDScriptJIT
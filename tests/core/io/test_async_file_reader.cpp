@@ -0,0 +1,240 @@
+/**************************************************************************/
+/*  test_async_file_reader.cpp                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "tests/test_macros.h"
+
+TEST_FORCE_LINK(test_async_file_reader)
+
+#include "core/io/async_file_reader.h"
+#include "core/io/dir_access.h"
+#include "core/io/file_access_pack.h"
+#include "core/io/pck_packer.h"
+#include "core/os/os.h"
+#include "tests/test_utils.h"
+
+namespace TestAsyncFileReader {
+
+static Vector<uint8_t> make_test_data(int p_size) {
+	Vector<uint8_t> data;
+	data.resize(p_size);
+	uint8_t *w = data.ptrw();
+	for (int i = 0; i < p_size; i++) {
+		w[i] = (i * 7 + (i >> 8)) & 0xFF;
+	}
+	return data;
+}
+
+static String write_test_file(const String &p_name, const Vector<uint8_t> &p_data) {
+	const String path = TestUtils::get_temp_path(p_name);
+	Ref<FileAccess> f = FileAccess::open(path, FileAccess::WRITE);
+	if (f.is_valid()) {
+		f->store_buffer(p_data);
+	}
+	return path;
+}
+
+// Reads the file in pieces asynchronously, and checks them against the data.
+static void check_async_reads(const Ref<FileAccess> &p_file, const Vector<uint8_t> &p_data) {
+	const int count = 200;
+	LocalVector<Vector<uint8_t>> buffers;
+	LocalVector<FileAccess::AsyncReadID> ids;
+	LocalVector<uint64_t> positions;
+	buffers.resize(count);
+	ids.resize(count);
+	positions.resize(count);
+
+	uint32_t state = 1;
+	for (int i = 0; i < count; i++) {
+		state = state * 1103515245 + 12345;
+		positions[i] = (state >> 8) % p_data.size();
+		buffers[i].resize(1 + state % 5000);
+		ids[i] = p_file->read_async(positions[i], buffers[i].ptrw(), buffers[i].size());
+		REQUIRE(ids[i] != 0);
+	}
+
+	// The file can still be used meanwhile.
+	p_file->seek(10);
+	CHECK(p_file->get_8() == p_data[10]);
+
+	bool matches = true;
+	for (int i = 0; i < count; i++) {
+		uint64_t read = 0;
+		matches = matches && FileAccess::wait_for_async_read(ids[i], &read) == OK;
+		const uint64_t expected = MIN((uint64_t)buffers[i].size(), p_data.size() - positions[i]);
+		matches = matches && read == expected;
+		matches = matches && memcmp(buffers[i].ptr(), p_data.ptr() + positions[i], expected) == 0;
+	}
+	CHECK(matches);
+}
+
+TEST_CASE("[AsyncFileReader] Read a file asynchronously") {
+	REQUIRE(AsyncFileReader::get_singleton() != nullptr);
+
+	const Vector<uint8_t> data = make_test_data(200000);
+	const String path = write_test_file("async.bin", data);
+	Ref<FileAccess> f = FileAccess::open(path, FileAccess::READ);
+	REQUIRE(f.is_valid());
+
+	SUBCASE("Many reads in flight") {
+		check_async_reads(f, data);
+	}
+
+	SUBCASE("Past the end") {
+		uint8_t buffer[100];
+		FileAccess::AsyncReadID id = f->read_async(data.size() - 10, buffer, 100);
+		uint64_t read = 0;
+		CHECK(FileAccess::wait_for_async_read(id, &read) == OK);
+		CHECK(read == 10);
+		CHECK(memcmp(buffer, data.ptr() + data.size() - 10, 10) == 0);
+
+		id = f->read_async(data.size() + 10, buffer, 100);
+		CHECK(FileAccess::wait_for_async_read(id, &read) == OK);
+		CHECK(read == 0);
+	}
+
+	SUBCASE("Callbacks") {
+		struct Result {
+			SafeNumeric<uint64_t> read;
+			SafeNumeric<uint32_t> calls;
+		} result;
+		FileAccess::AsyncReadCallback callback = [](void *p_userdata, Error p_error, uint64_t p_read) {
+			Result *r = (Result *)p_userdata;
+			if (p_error == OK) {
+				r->read.add(p_read);
+			}
+			r->calls.increment();
+		};
+
+		Vector<uint8_t> buffer;
+		buffer.resize(data.size());
+		for (int i = 0; i < 10; i++) {
+			const uint64_t from = data.size() * i / 10;
+			const uint64_t to = data.size() * (i + 1) / 10;
+			CHECK(f->read_async(from, buffer.ptrw() + from, to - from, callback, &result) != 0);
+		}
+		while (result.calls.get() < 10) {
+			OS::get_singleton()->delay_usec(100);
+		}
+		CHECK(result.read.get() == (uint64_t)data.size());
+		CHECK(buffer == data);
+	}
+
+	SUBCASE("Waiting twice") {
+		uint8_t byte;
+		FileAccess::AsyncReadID id = f->read_async(0, &byte, 1);
+		CHECK(FileAccess::wait_for_async_read(id) == OK);
+		ERR_PRINT_OFF;
+		CHECK(FileAccess::wait_for_async_read(id) == ERR_INVALID_PARAMETER);
+		CHECK_FALSE(FileAccess::is_async_read_completed(id));
+		ERR_PRINT_ON;
+	}
+
+	f.unref();
+	DirAccess::remove_file_or_error(path);
+}
+
+TEST_CASE("[AsyncFileReader] Read files from a pack asynchronously") {
+	const Vector<uint8_t> data = make_test_data(100000);
+	const String pck_path = TestUtils::get_temp_path("async.pck");
+
+	PCKPacker pck_packer;
+	REQUIRE(pck_packer.pck_start(pck_path) == OK);
+	REQUIRE(pck_packer.add_file_from_buffer("async_test/before.bin", make_test_data(1000)) == OK);
+	REQUIRE(pck_packer.add_file_from_buffer("async_test/data.bin", data) == OK);
+	REQUIRE(pck_packer.add_file_from_buffer("async_test/after.bin", make_test_data(1000)) == OK);
+	REQUIRE(pck_packer.flush() == OK);
+
+	PackedData *packed_data = PackedData::get_singleton();
+	REQUIRE(packed_data->add_pack(pck_path, true, 0) == OK);
+	const bool memory_mapping = packed_data->is_memory_mapping_enabled();
+
+	for (bool mapped : { false, true }) {
+		packed_data->set_memory_mapping_enabled(mapped);
+		Ref<FileAccess> f = FileAccess::open("res://async_test/data.bin", FileAccess::READ);
+		REQUIRE(f.is_valid());
+		check_async_reads(f, data);
+
+		// Reads stop at the end of the file, not of the pack.
+		Vector<uint8_t> buffer;
+		buffer.resize(2000);
+		uint64_t read = 0;
+		CHECK(FileAccess::wait_for_async_read(f->read_async(data.size() - 1000, buffer.ptrw(), 2000), &read) == OK);
+		CHECK(read == 1000);
+	}
+
+	packed_data->set_memory_mapping_enabled(memory_mapping);
+	packed_data->remove_path("res://async_test/before.bin");
+	packed_data->remove_path("res://async_test/data.bin");
+	packed_data->remove_path("res://async_test/after.bin");
+	DirAccess::remove_file_or_error(pck_path);
+}
+
+TEST_CASE_BENCHMARK("[Benchmark][AsyncFileReader] Many small reads") {
+	const int file_count = 500;
+	const int file_size = 16 * 1024;
+	const Vector<uint8_t> data = make_test_data(file_size);
+
+	Vector<String> paths;
+	for (int i = 0; i < file_count; i++) {
+		paths.push_back(write_test_file(vformat("async_benchmark_%d.bin", i), data));
+	}
+
+	Vector<uint8_t> buffer;
+	buffer.resize(file_count * file_size);
+
+	// NOTE: Files are likely in the OS cache, drop it between runs (e.g. `echo 3 > /proc/sys/vm/drop_caches` on Linux) to measure disk reads.
+	uint64_t start = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < file_count; i++) {
+		Ref<FileAccess> f = FileAccess::open(paths[i], FileAccess::READ);
+		REQUIRE(f.is_valid());
+		f->get_buffer(buffer.ptrw() + i * file_size, file_size);
+	}
+	const uint64_t sync_usec = OS::get_singleton()->get_ticks_usec() - start;
+
+	start = OS::get_singleton()->get_ticks_usec();
+	LocalVector<FileAccess::AsyncReadID> ids;
+	for (int i = 0; i < file_count; i++) {
+		Ref<FileAccess> f = FileAccess::open(paths[i], FileAccess::READ);
+		REQUIRE(f.is_valid());
+		ids.push_back(f->read_async(0, buffer.ptrw() + i * file_size, file_size));
+	}
+	for (FileAccess::AsyncReadID id : ids) {
+		CHECK(FileAccess::wait_for_async_read(id) == OK);
+	}
+	const uint64_t async_usec = OS::get_singleton()->get_ticks_usec() - start;
+
+	print_line(vformat("%d reads of %d KiB: synchronous %d usec, asynchronous %d usec.", file_count, file_size / 1024, sync_usec, async_usec));
+
+	for (const String &path : paths) {
+		DirAccess::remove_file_or_error(path);
+	}
+}
+
+} // namespace TestAsyncFileReader
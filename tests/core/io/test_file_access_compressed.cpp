@@ -0,0 +1,221 @@
+/**************************************************************************/
+/*  test_file_access_compressed.cpp                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "tests/test_macros.h"
+
+TEST_FORCE_LINK(test_file_access_compressed)
+
+#include "core/io/dir_access.h"
+#include "core/io/file_access_compressed.h"
+#include "core/os/os.h"
+#include "tests/test_utils.h"
+
+namespace TestFileAccessCompressed {
+
+// Compressible, but not repeating within a block.
+static Vector<uint8_t> make_test_data(int p_size) {
+	Vector<uint8_t> data;
+	data.resize(p_size);
+	uint8_t *w = data.ptrw();
+	uint32_t state = 1;
+	for (int i = 0; i < p_size; i++) {
+		state = state * 1103515245 + 12345;
+		w[i] = (state >> 16) & 0x0F;
+	}
+	return data;
+}
+
+static bool write_compressed(const String &p_path, const Vector<uint8_t> &p_data, Compression::Mode p_mode, uint32_t p_block_size, const Vector<uint8_t> &p_dictionary = Vector<uint8_t>()) {
+	Ref<FileAccessCompressed> f;
+	f.instantiate();
+	f->configure("GCPF", p_mode, p_block_size);
+	f->set_dictionary(p_dictionary);
+	if (f->open_internal(p_path, FileAccess::WRITE) != OK) {
+		return false;
+	}
+	f->store_buffer(p_data.ptr(), p_data.size());
+	f->close();
+	return true;
+}
+
+static Ref<FileAccessCompressed> open_compressed(const String &p_path, uint32_t p_cache_size, uint32_t p_read_ahead, const Vector<uint8_t> &p_dictionary = Vector<uint8_t>()) {
+	Ref<FileAccessCompressed> f;
+	f.instantiate();
+	f->configure("GCPF");
+	f->set_block_cache_size(p_cache_size);
+	f->set_read_ahead(p_read_ahead);
+	f->set_dictionary(p_dictionary);
+	if (f->open_internal(p_path, FileAccess::READ) != OK) {
+		return Ref<FileAccessCompressed>();
+	}
+	return f;
+}
+
+TEST_CASE("[FileAccessCompressed] Random access with a block cache") {
+	// Not a multiple of the block size.
+	const Vector<uint8_t> data = make_test_data(100 * 1024 + 123);
+	const String path = TestUtils::get_temp_path("compressed_random.bin");
+
+	const Compression::Mode modes[] = { Compression::MODE_ZSTD, Compression::MODE_FASTLZ, Compression::MODE_DEFLATE };
+	for (Compression::Mode mode : modes) {
+		REQUIRE(write_compressed(path, data, mode, 4096));
+
+		for (uint32_t read_ahead : { 0, 1, 8, 64 }) {
+			Ref<FileAccessCompressed> f = open_compressed(path, 4, read_ahead);
+			REQUIRE(f.is_valid());
+			CHECK(f->get_block_cache_size() == 4);
+			CHECK(f->get_length() == (uint64_t)data.size());
+
+			// Sequential, crossing blocks.
+			CHECK(Ref<FileAccess>(f)->get_buffer(data.size()) == data);
+			CHECK_FALSE(f->eof_reached());
+			uint8_t byte;
+			CHECK(f->get_buffer(&byte, 1) == 0);
+			CHECK(f->eof_reached());
+
+			// Random, going back to cached and evicted blocks.
+			uint32_t state = 7;
+			uint8_t buffer[10000];
+			bool matches = true;
+			for (int i = 0; i < 200; i++) {
+				state = state * 1103515245 + 12345;
+				const uint64_t position = (state >> 8) % data.size();
+				const uint64_t length = MIN((uint64_t)(state % 10000), data.size() - position);
+				f->seek(position);
+				matches = matches && f->get_position() == position;
+				matches = matches && f->get_buffer(buffer, length) == length;
+				matches = matches && memcmp(buffer, data.ptr() + position, length) == 0;
+			}
+			CHECK_MESSAGE(matches, vformat("Random reads don't match with mode %d and read-ahead %d.", mode, read_ahead));
+
+			f->seek_end(-10);
+			CHECK(f->get_buffer(buffer, 100) == 10);
+			CHECK(memcmp(buffer, data.ptr() + data.size() - 10, 10) == 0);
+		}
+	}
+
+	// Empty and exactly one block.
+	for (int size : { 0, 4096 }) {
+		const Vector<uint8_t> small_data = make_test_data(size);
+		REQUIRE(write_compressed(path, small_data, Compression::MODE_ZSTD, 4096));
+		Ref<FileAccessCompressed> f = open_compressed(path, 1, 8);
+		REQUIRE(f.is_valid());
+		CHECK(f->get_length() == (uint64_t)size);
+		CHECK(Ref<FileAccess>(f)->get_buffer(size + 1) == small_data);
+		CHECK(f->eof_reached());
+	}
+
+	DirAccess::remove_file_or_error(path);
+}
+
+TEST_CASE("[FileAccessCompressed] Zstandard dictionary") {
+	// Raw content dictionary, the data is made of pieces of it.
+	const Vector<uint8_t> dictionary = make_test_data(16 * 1024);
+	Vector<uint8_t> data;
+	for (int i = 0; i < 64; i++) {
+		data.append_array(dictionary.slice((i * 977) % 8192, (i * 977) % 8192 + 4096));
+	}
+
+	const String path = TestUtils::get_temp_path("compressed_dictionary.bin");
+	const String plain_path = TestUtils::get_temp_path("compressed_no_dictionary.bin");
+	REQUIRE(write_compressed(path, data, Compression::MODE_ZSTD, 4096, dictionary));
+	REQUIRE(write_compressed(plain_path, data, Compression::MODE_ZSTD, 4096));
+
+	Ref<FileAccess> compressed_file = FileAccess::open(path, FileAccess::READ);
+	Ref<FileAccess> plain_file = FileAccess::open(plain_path, FileAccess::READ);
+	REQUIRE(compressed_file.is_valid());
+	REQUIRE(plain_file.is_valid());
+	CHECK(compressed_file->get_length() * 4 < plain_file->get_length());
+	compressed_file.unref();
+	plain_file.unref();
+
+	Ref<FileAccessCompressed> f = open_compressed(path, 16, 8, dictionary);
+	REQUIRE(f.is_valid());
+	CHECK(Ref<FileAccess>(f)->get_buffer(data.size()) == data);
+	f->seek(100000);
+	CHECK(f->get_8() == data[100000]);
+
+	ERR_PRINT_OFF;
+	f = open_compressed(path, 16, 8);
+	ERR_PRINT_ON;
+	CHECK(f.is_null());
+
+	DirAccess::remove_file_or_error(path);
+	DirAccess::remove_file_or_error(plain_path);
+}
+
+TEST_CASE_BENCHMARK("[Benchmark][FileAccessCompressed] Sequential and random reads") {
+	const int size = 256 * 1024 * 1024;
+	const Vector<uint8_t> data = make_test_data(size);
+	const String path = TestUtils::get_temp_path("compressed_benchmark.bin");
+	REQUIRE(write_compressed(path, data, Compression::MODE_ZSTD, 64 * 1024));
+
+	Vector<uint8_t> buffer;
+	buffer.resize(size);
+
+	struct Config {
+		const char *name;
+		uint32_t cache_size;
+		uint32_t read_ahead;
+	};
+	const Config configs[] = {
+		{ "no cache, no read-ahead", 1, 0 },
+		{ "cache of 64 blocks, no read-ahead", 64, 0 },
+		{ "cache of 64 blocks, read-ahead of 32", 64, 32 },
+	};
+
+	for (const Config &config : configs) {
+		Ref<FileAccessCompressed> f = open_compressed(path, config.cache_size, config.read_ahead);
+		REQUIRE(f.is_valid());
+
+		uint64_t start = OS::get_singleton()->get_ticks_usec();
+		CHECK(f->get_buffer(buffer.ptrw(), size) == (uint64_t)size);
+		const uint64_t sequential_usec = OS::get_singleton()->get_ticks_usec() - start;
+
+		// Reads of 1 KiB moving forward by up to 256 KiB, like a streaming system would do.
+		uint32_t state = 1;
+		uint64_t position = 0;
+		start = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < 100000; i++) {
+			state = state * 1103515245 + 12345;
+			position = (position + (state >> 8) % (256 * 1024)) % (size - 1024);
+			f->seek(position);
+			f->get_buffer(buffer.ptrw(), 1024);
+		}
+		const uint64_t random_usec = OS::get_singleton()->get_ticks_usec() - start;
+
+		const double mib = size / (1024.0 * 1024.0);
+		print_line(vformat("%s: sequential %.2f MiB/s, 100000 random reads in %d usec.", config.name, mib / (sequential_usec / 1000000.0), random_usec));
+	}
+
+	DirAccess::remove_file_or_error(path);
+}
+
+} // namespace TestFileAccessCompressed
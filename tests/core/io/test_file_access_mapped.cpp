@@ -0,0 +1,271 @@
+/**************************************************************************/
+/*  test_file_access_mapped.cpp                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "tests/test_macros.h"
+
+TEST_FORCE_LINK(test_file_access_mapped)
+
+#include "core/io/dir_access.h"
+#include "core/io/file_access_mapped.h"
+#include "core/io/file_access_pack.h"
+#include "core/io/pck_packer.h"
+#include "core/os/os.h"
+#include "tests/test_utils.h"
+
+namespace TestFileAccessMapped {
+
+static Vector<uint8_t> make_test_data(int p_size) {
+	Vector<uint8_t> data;
+	data.resize(p_size);
+	uint8_t *w = data.ptrw();
+	for (int i = 0; i < p_size; i++) {
+		w[i] = (i * 7) & 0xFF;
+	}
+	return data;
+}
+
+static String write_test_file(const String &p_name, const Vector<uint8_t> &p_data) {
+	const String path = TestUtils::get_temp_path(p_name);
+	Ref<FileAccess> f = FileAccess::open(path, FileAccess::WRITE);
+	if (f.is_valid()) {
+		f->store_buffer(p_data);
+	}
+	return path;
+}
+
+TEST_CASE("[FileAccessMapped] Read a mapped file") {
+	if (!FileAccessMapped::is_supported()) {
+		MESSAGE("Memory mapped files aren't supported on this platform.");
+		return;
+	}
+
+	const Vector<uint8_t> data = make_test_data(10000);
+	const String path = write_test_file("mapped.bin", data);
+
+	Error err;
+	Ref<FileAccessMapped> f = FileAccessMapped::open_range(path, 0, -1, &err);
+	REQUIRE(err == OK);
+	REQUIRE(f.is_valid());
+	CHECK(f->is_open());
+	CHECK(f->get_length() == 10000);
+
+	CHECK(f->get_8() == data[0]);
+	CHECK(f->get_32() == (uint32_t)(data[1] | data[2] << 8 | data[3] << 16 | data[4] << 24));
+	CHECK(f->get_position() == 5);
+
+	f->seek(100);
+	Span<uint8_t> view = f->get_buffer_view(50);
+	REQUIRE(view.size() == 50);
+	CHECK(memcmp(view.ptr(), data.ptr() + 100, 50) == 0);
+	CHECK(f->get_position() == 150);
+	CHECK_FALSE(f->eof_reached());
+
+	f->seek_end(-10);
+	uint8_t buffer[100];
+	CHECK(f->get_buffer(buffer, 100) == 10);
+	CHECK(memcmp(buffer, data.ptr() + 9990, 10) == 0);
+	CHECK(f->eof_reached());
+	CHECK(f->get_error() == ERR_FILE_EOF);
+	CHECK(f->get_buffer_view(10).is_empty());
+
+	f->seek(0);
+	CHECK_FALSE(f->eof_reached());
+	CHECK(Ref<FileAccess>(f)->get_buffer(10000) == data);
+
+	ERR_PRINT_OFF;
+	CHECK_FALSE(f->store_8(1));
+	ERR_PRINT_ON;
+
+	f->close();
+	CHECK_FALSE(f->is_open());
+
+	DirAccess::remove_file_or_error(path);
+}
+
+TEST_CASE("[FileAccessMapped] Map a range of a file") {
+	if (!FileAccessMapped::is_supported()) {
+		MESSAGE("Memory mapped files aren't supported on this platform.");
+		return;
+	}
+
+	const Vector<uint8_t> data = make_test_data(10000);
+	const String path = write_test_file("mapped_range.bin", data);
+
+	// Not aligned to a page.
+	Ref<FileAccessMapped> f = FileAccessMapped::open_range(path, 4097, 1000);
+	REQUIRE(f.is_valid());
+	CHECK(f->get_length() == 1000);
+	Span<uint8_t> view = f->get_buffer_view(2000);
+	REQUIRE(view.size() == 1000);
+	CHECK(memcmp(view.ptr(), data.ptr() + 4097, 1000) == 0);
+	CHECK(f->eof_reached());
+
+	f = FileAccessMapped::open_range(path, 10000, 0);
+	REQUIRE(f.is_valid());
+	CHECK(f->get_length() == 0);
+
+	Error err;
+	ERR_PRINT_OFF;
+	f = FileAccessMapped::open_range(path, 9000, 2000, &err);
+	ERR_PRINT_ON;
+	CHECK(f.is_null());
+	CHECK(err == ERR_INVALID_PARAMETER);
+
+	f = FileAccessMapped::open_range(TestUtils::get_temp_path("mapped_missing.bin"), 0, -1, &err);
+	CHECK(f.is_null());
+	CHECK(err == ERR_FILE_NOT_FOUND);
+
+	DirAccess::remove_file_or_error(path);
+}
+
+TEST_CASE("[FileAccessMapped] Read files from a pack") {
+	const Vector<uint8_t> data = make_test_data(100000);
+	const String pck_path = TestUtils::get_temp_path("mapped.pck");
+
+	PCKPacker pck_packer;
+	REQUIRE(pck_packer.pck_start(pck_path) == OK);
+	REQUIRE(pck_packer.add_file_from_buffer("mapped_test/data.bin", data) == OK);
+	REQUIRE(pck_packer.add_file_from_buffer("mapped_test/empty.bin", Vector<uint8_t>()) == OK);
+	REQUIRE(pck_packer.flush() == OK);
+
+	PackedData *packed_data = PackedData::get_singleton();
+	REQUIRE(packed_data != nullptr);
+	REQUIRE(packed_data->add_pack(pck_path, true, 0) == OK);
+	const bool memory_mapping = packed_data->is_memory_mapping_enabled();
+
+	SUBCASE("Memory mapped") {
+		packed_data->set_memory_mapping_enabled(true);
+		Ref<FileAccess> f = FileAccess::open("res://mapped_test/data.bin", FileAccess::READ);
+		REQUIRE(f.is_valid());
+		CHECK(f->get_length() == 100000);
+
+		f->seek(10);
+		Span<uint8_t> view = f->get_buffer_view(200000);
+		if (FileAccessMapped::is_supported()) {
+			REQUIRE(view.size() == 100000 - 10);
+			CHECK(memcmp(view.ptr(), data.ptr() + 10, view.size()) == 0);
+			CHECK(f->eof_reached());
+		} else {
+			CHECK(view.is_empty());
+		}
+
+		f->seek(0);
+		CHECK(f->get_buffer(100000) == data);
+
+		f = FileAccess::open("res://mapped_test/empty.bin", FileAccess::READ);
+		REQUIRE(f.is_valid());
+		CHECK(f->get_length() == 0);
+		CHECK(f->get_buffer_view(10).is_empty());
+	}
+
+	SUBCASE("Buffered") {
+		packed_data->set_memory_mapping_enabled(false);
+		Ref<FileAccess> f = FileAccess::open("res://mapped_test/data.bin", FileAccess::READ);
+		REQUIRE(f.is_valid());
+		CHECK(f->get_buffer_view(100).is_empty());
+		CHECK(f->get_position() == 0);
+		CHECK(f->get_buffer(100000) == data);
+	}
+
+	packed_data->set_memory_mapping_enabled(memory_mapping);
+	packed_data->remove_path("res://mapped_test/data.bin");
+	packed_data->remove_path("res://mapped_test/empty.bin");
+	DirAccess::remove_file_or_error(pck_path);
+}
+
+TEST_CASE_BENCHMARK("[Benchmark][FileAccessMapped] Reading a large pack") {
+	// 2 GiB in total.
+	const int file_count = 64;
+	const int file_size = 32 * 1024 * 1024;
+
+	const String source_path = write_test_file("mapped_benchmark_source.bin", make_test_data(file_size));
+	const String pck_path = TestUtils::get_temp_path("mapped_benchmark.pck");
+
+	PCKPacker pck_packer;
+	REQUIRE(pck_packer.pck_start(pck_path) == OK);
+	for (int i = 0; i < file_count; i++) {
+		REQUIRE(pck_packer.add_file(vformat("mapped_benchmark/%d.bin", i), source_path) == OK);
+	}
+	REQUIRE(pck_packer.flush() == OK);
+
+	PackedData *packed_data = PackedData::get_singleton();
+	REQUIRE(packed_data->add_pack(pck_path, true, 0) == OK);
+	const bool memory_mapping = packed_data->is_memory_mapping_enabled();
+
+	Vector<uint8_t> buffer;
+	buffer.resize(file_size);
+
+	enum Mode {
+		MODE_BUFFERED,
+		MODE_MAPPED_COPY,
+		MODE_MAPPED_VIEW,
+	};
+	const char *mode_names[] = { "buffered get_buffer()", "mapped get_buffer()", "mapped get_buffer_view()" };
+
+	for (int mode = MODE_BUFFERED; mode <= MODE_MAPPED_VIEW; mode++) {
+		packed_data->set_memory_mapping_enabled(mode != MODE_BUFFERED);
+		uint64_t checksum = 0;
+
+		const uint64_t start = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < file_count; i++) {
+			Ref<FileAccess> f = FileAccess::open(vformat("res://mapped_benchmark/%d.bin", i), FileAccess::READ);
+			REQUIRE(f.is_valid());
+
+			const uint8_t *ptr = nullptr;
+			uint64_t size = 0;
+			if (mode == MODE_MAPPED_VIEW) {
+				Span<uint8_t> view = f->get_buffer_view(f->get_length());
+				ptr = view.ptr();
+				size = view.size();
+			} else {
+				size = f->get_buffer(buffer.ptrw(), f->get_length());
+				ptr = buffer.ptr();
+			}
+
+			// Use the data, so mapped pages are actually read.
+			for (uint64_t j = 0; j + sizeof(uint64_t) <= size; j += sizeof(uint64_t)) {
+				checksum += *(const uint64_t *)(ptr + j);
+			}
+		}
+		const uint64_t usec = OS::get_singleton()->get_ticks_usec() - start;
+
+		const double gib = (double)file_count * file_size / (1024.0 * 1024.0 * 1024.0);
+		print_line(vformat("%s: %.2f GiB in %d usec (%.2f GiB/s), checksum %d.", mode_names[mode], gib, usec, gib / (usec / 1000000.0), checksum));
+	}
+
+	packed_data->set_memory_mapping_enabled(memory_mapping);
+	for (int i = 0; i < file_count; i++) {
+		packed_data->remove_path(vformat("res://mapped_benchmark/%d.bin", i));
+	}
+	DirAccess::remove_file_or_error(pck_path);
+	DirAccess::remove_file_or_error(source_path);
+}
+
+} // namespace TestFileAccessMapped
@@ -34,6 +34,8 @@ TEST_FORCE_LINK(test_image)
 
 #include "core/io/file_access.h"
 #include "core/io/image.h"
+#include "core/object/worker_thread_pool.h"
+#include "core/os/os.h"
 #include "tests/test_utils.h"
 
 #include "modules/modules_enabled.gen.h" // For bmp, jpg, svg, webp, tga.
@@ -487,4 +489,239 @@ TEST_CASE("[Image] Convert image") {
 	CHECK_MESSAGE(image2->get_data() == image_data, "Image conversion to invalid type (Image::FORMAT_MAX + 1) should not alter image.");
 }
 
+static Ref<Image> make_noise_image(int p_width, int p_height, Image::Format p_format) {
+	Ref<Image> image = Image::create_empty(p_width, p_height, false, Image::FORMAT_RGBA8);
+	uint32_t seed = 12345;
+	for (int y = 0; y < p_height; y++) {
+		for (int x = 0; x < p_width; x++) {
+			seed = seed * 1103515245 + 12345;
+			image->set_pixel(x, y, Color::from_rgba8(seed >> 24, (seed >> 16) & 0xFF, (seed >> 8) & 0xFF, seed & 0xFF));
+		}
+	}
+	image->convert(p_format);
+	return image;
+}
+
+struct ImageSerialTask {
+	Ref<Image> image;
+	int width = 0;
+	int height = 0;
+	Image::Interpolation interpolation = Image::INTERPOLATE_NEAREST;
+	bool compress = false;
+	Image::CompressMode compress_mode = Image::COMPRESS_S3TC;
+	Image::UsedChannels channels = Image::USED_CHANNELS_RGBA;
+
+	// Threads of the pool always process images serially.
+	static void run(void *p_userdata) {
+		ImageSerialTask *task = (ImageSerialTask *)p_userdata;
+		if (task->compress) {
+			task->image->compress_from_channels(task->compress_mode, task->channels);
+		} else if (task->width == 0) {
+			task->image->generate_mipmaps();
+		} else {
+			task->image->resize(task->width, task->height, task->interpolation);
+		}
+	}
+
+	void process_in_pool() {
+		WorkerThreadPool::TaskID id = WorkerThreadPool::get_singleton()->add_native_task(&ImageSerialTask::run, this);
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(id);
+	}
+};
+
+TEST_CASE("[Image] Resizing and generating mipmaps of large images in parallel") {
+	const Image::Format formats[] = { Image::FORMAT_RGBA8, Image::FORMAT_RGB8, Image::FORMAT_RGBAF, Image::FORMAT_RGBAH, Image::FORMAT_RF };
+	const Size2i sizes[] = { Size2i(700, 500), Size2i(211, 133) };
+
+	for (Image::Format format : formats) {
+		const Ref<Image> source = make_noise_image(413, 377, format);
+
+		for (int interpolation = Image::INTERPOLATE_NEAREST; interpolation <= Image::INTERPOLATE_LANCZOS; interpolation++) {
+			for (const Size2i &size : sizes) {
+				Ref<Image> parallel = source->duplicate();
+				parallel->resize(size.width, size.height, (Image::Interpolation)interpolation);
+
+				ImageSerialTask serial;
+				serial.image = source->duplicate();
+				serial.width = size.width;
+				serial.height = size.height;
+				serial.interpolation = (Image::Interpolation)interpolation;
+				serial.process_in_pool();
+
+				CHECK_MESSAGE(parallel->get_data() == serial.image->get_data(),
+						vformat("Resizing %s to %v with interpolation %d should give the same result on any number of threads.", Image::format_names[format], size, interpolation));
+			}
+		}
+
+		Ref<Image> parallel = make_noise_image(1024, 512, format);
+		parallel->generate_mipmaps();
+
+		ImageSerialTask serial;
+		serial.image = make_noise_image(1024, 512, format);
+		serial.process_in_pool();
+
+		CHECK_MESSAGE(parallel->get_data() == serial.image->get_data(),
+				vformat("Mipmaps of %s should be the same on any number of threads.", Image::format_names[format]));
+	}
+
+	// Known values of the vectorized RGBA8 paths.
+	Ref<Image> image = Image::create_empty(4, 2, false, Image::FORMAT_RGBA8);
+	image->fill(Color::from_rgba8(10, 20, 30, 40));
+	image->set_pixel(1, 0, Color::from_rgba8(11, 21, 31, 41));
+	image->set_pixel(0, 1, Color::from_rgba8(250, 0, 255, 1));
+	image->generate_mipmaps();
+	Ref<Image> mipmap = image->get_image_from_mipmap(1);
+	CHECK(mipmap->get_pixel(0, 0).to_rgba32() == Color::from_rgba8(70, 15, 87, 31).to_rgba32());
+	CHECK(mipmap->get_pixel(1, 0).to_rgba32() == Color::from_rgba8(10, 20, 30, 40).to_rgba32());
+
+	image = Image::create_empty(2, 1, false, Image::FORMAT_RGBA8);
+	image->set_pixel(0, 0, Color::from_rgba8(0, 255, 100, 255));
+	image->set_pixel(1, 0, Color::from_rgba8(255, 0, 200, 255));
+	image->resize(4, 1, Image::INTERPOLATE_BILINEAR);
+	CHECK(image->get_pixel(0, 0).to_rgba32() == Color::from_rgba8(0, 255, 100, 255).to_rgba32());
+	CHECK(image->get_pixel(1, 0).to_rgba32() == Color::from_rgba8(63, 191, 125, 255).to_rgba32());
+	CHECK(image->get_pixel(2, 0).to_rgba32() == Color::from_rgba8(191, 63, 175, 255).to_rgba32());
+	CHECK(image->get_pixel(3, 0).to_rgba32() == Color::from_rgba8(255, 0, 200, 255).to_rgba32());
+}
+
+TEST_CASE_BENCHMARK("[Benchmark][Image] Resizing and generating mipmaps") {
+	const Image::Format formats[] = { Image::FORMAT_RGBA8, Image::FORMAT_RGBAF, Image::FORMAT_RGBAH };
+	const char *interpolation_names[] = { "nearest", "bilinear", "cubic", "trilinear", "lanczos" };
+
+	for (Image::Format format : formats) {
+		const Ref<Image> source = make_noise_image(4096, 4096, format);
+
+		for (int interpolation = Image::INTERPOLATE_NEAREST; interpolation <= Image::INTERPOLATE_LANCZOS; interpolation++) {
+			if (interpolation == Image::INTERPOLATE_TRILINEAR) {
+				continue;
+			}
+
+			for (int thread_mode = 0; thread_mode < 2; thread_mode++) {
+				ImageSerialTask task;
+				task.image = source->duplicate();
+				task.width = 2731;
+				task.height = 2731;
+				task.interpolation = (Image::Interpolation)interpolation;
+
+				const uint64_t start = OS::get_singleton()->get_ticks_usec();
+				if (thread_mode == 0) {
+					task.process_in_pool();
+				} else {
+					ImageSerialTask::run(&task);
+				}
+				const uint64_t usec = OS::get_singleton()->get_ticks_usec() - start;
+
+				print_line(vformat("%s 4096x4096 -> 2731x2731, %s, %s: %d usec.", Image::format_names[format], interpolation_names[interpolation], thread_mode == 0 ? "single thread" : "worker pool", usec));
+			}
+		}
+
+		for (int thread_mode = 0; thread_mode < 2; thread_mode++) {
+			ImageSerialTask task;
+			task.image = source->duplicate();
+
+			const uint64_t start = OS::get_singleton()->get_ticks_usec();
+			if (thread_mode == 0) {
+				task.process_in_pool();
+			} else {
+				ImageSerialTask::run(&task);
+			}
+			const uint64_t usec = OS::get_singleton()->get_ticks_usec() - start;
+
+			print_line(vformat("%s 4096x4096 mipmaps, %s: %d usec.", Image::format_names[format], thread_mode == 0 ? "single thread" : "worker pool", usec));
+		}
+	}
+}
+
+struct ImageCompression {
+	const char *name = nullptr;
+	Image::CompressMode mode = Image::COMPRESS_S3TC;
+	Image::UsedChannels channels = Image::USED_CHANNELS_RGBA;
+};
+
+static const ImageCompression image_compressions[] = {
+	{ "DXT1", Image::COMPRESS_S3TC, Image::USED_CHANNELS_RGB },
+	{ "DXT5", Image::COMPRESS_S3TC, Image::USED_CHANNELS_RGBA },
+	{ "RGTC RG", Image::COMPRESS_S3TC, Image::USED_CHANNELS_RG },
+	{ "ETC1", Image::COMPRESS_ETC, Image::USED_CHANNELS_RGB },
+	{ "ETC2 RGBA", Image::COMPRESS_ETC2, Image::USED_CHANNELS_RGBA },
+	{ "EAC R", Image::COMPRESS_ETC2, Image::USED_CHANNELS_R },
+	{ "BPTC", Image::COMPRESS_BPTC, Image::USED_CHANNELS_RGBA },
+	{ "ASTC 4x4", Image::COMPRESS_ASTC, Image::USED_CHANNELS_RGBA },
+};
+
+static bool is_compression_available(Image::CompressMode p_mode) {
+	switch (p_mode) {
+		case Image::COMPRESS_S3TC:
+			return Image::_image_compress_bc_func != nullptr;
+		case Image::COMPRESS_ETC:
+			return Image::_image_compress_etc1_func != nullptr;
+		case Image::COMPRESS_ETC2:
+			return Image::_image_compress_etc2_func != nullptr;
+		case Image::COMPRESS_BPTC:
+			return Image::_image_compress_bptc_func != nullptr;
+		case Image::COMPRESS_ASTC:
+			return Image::_image_compress_astc_func != nullptr;
+		default:
+			return false;
+	}
+}
+
+TEST_CASE("[Image] Compressing images in parallel") {
+	// Not a multiple of the block size, so the smaller mipmaps are padded.
+	Ref<Image> source = make_noise_image(517, 301, Image::FORMAT_RGBA8);
+	source->generate_mipmaps();
+
+	for (const ImageCompression &compression : image_compressions) {
+		if (!is_compression_available(compression.mode)) {
+			MESSAGE(vformat("%s compression isn't available in this build.", compression.name));
+			continue;
+		}
+
+		Ref<Image> parallel = source->duplicate();
+		parallel->compress_from_channels(compression.mode, compression.channels);
+		REQUIRE(parallel->is_compressed());
+		CHECK(parallel->has_mipmaps());
+
+		ImageSerialTask serial;
+		serial.image = source->duplicate();
+		serial.compress = true;
+		serial.compress_mode = compression.mode;
+		serial.channels = compression.channels;
+		serial.process_in_pool();
+
+		CHECK(parallel->get_format() == serial.image->get_format());
+		CHECK_MESSAGE(parallel->get_data() == serial.image->get_data(),
+				vformat("%s compression should give the same result on any number of threads.", compression.name));
+	}
+}
+
+TEST_CASE_BENCHMARK("[Benchmark][Image] Compressing textures") {
+	Ref<Image> source = make_noise_image(2048, 2048, Image::FORMAT_RGBA8);
+	source->generate_mipmaps();
+
+	for (const ImageCompression &compression : image_compressions) {
+		if (!is_compression_available(compression.mode)) {
+			continue;
+		}
+
+		for (int thread_mode = 0; thread_mode < 2; thread_mode++) {
+			ImageSerialTask task;
+			task.image = source->duplicate();
+			task.compress = true;
+			task.compress_mode = compression.mode;
+			task.channels = compression.channels;
+
+			const uint64_t start = OS::get_singleton()->get_ticks_usec();
+			if (thread_mode == 0) {
+				task.process_in_pool();
+			} else {
+				ImageSerialTask::run(&task);
+			}
+			const uint64_t usec = OS::get_singleton()->get_ticks_usec() - start;
+
+			print_line(vformat("%s 2048x2048 with mipmaps, %s: %d usec.", compression.name, thread_mode == 0 ? "single thread" : "worker pool", usec));
+		}
+	}
+}
+
 } // namespace TestImage
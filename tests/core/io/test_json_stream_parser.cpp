@@ -0,0 +1,355 @@
+/**************************************************************************/
+/*  test_json_stream_parser.cpp                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "tests/test_macros.h"
+
+TEST_FORCE_LINK(test_json_stream_parser)
+
+#include "core/io/dir_access.h"
+#include "core/io/json.h"
+#include "core/io/json_stream_parser.h"
+#include "core/os/os.h"
+#include "tests/test_utils.h"
+
+namespace TestJSONStreamParser {
+
+static Span<uint8_t> utf8_span(const CharString &p_utf8) {
+	return Span<uint8_t>((const uint8_t *)p_utf8.get_data(), p_utf8.length());
+}
+
+static Error parse_in_chunks(const String &p_json, int p_chunk_size, Variant &r_value, uint32_t p_flags = 0, String *r_err_str = nullptr, int *r_err_line = nullptr) {
+	const CharString utf8 = p_json.utf8();
+	JSONStreamParser parser;
+	int offset = 0;
+	bool has_value = false;
+	while (true) {
+		// Use a temporary copy, as the parser must not rely on previous chunks.
+		Vector<uint8_t> chunk;
+		const int size = MIN(p_chunk_size, utf8.length() - offset);
+		chunk.resize(size);
+		memcpy(chunk.ptrw(), utf8.ptr() + offset, size);
+		offset += size;
+		parser.feed(chunk);
+		if (offset == utf8.length()) {
+			parser.finish();
+		}
+
+		Error err = OK;
+		if (!has_value) {
+			err = parser.read_value(r_value, p_flags);
+			has_value = err == OK;
+		}
+		if (has_value) {
+			err = parser.read();
+		}
+		if (err != ERR_UNAVAILABLE) {
+			if (r_err_str) {
+				*r_err_str = parser.get_error_message();
+			}
+			if (r_err_line) {
+				*r_err_line = parser.get_error_line();
+			}
+			return err;
+		}
+	}
+}
+
+static void check_same_as_json(const String &p_json) {
+	Ref<JSON> json;
+	json.instantiate();
+	const Error expected_err = json->parse(p_json);
+
+	const CharString utf8 = p_json.utf8();
+	for (int chunk_size : { 1, 3, utf8.length() + 1 }) {
+		Variant value;
+		String err_str;
+		int err_line = 0;
+		const Error err = parse_in_chunks(p_json, chunk_size, value, 0, &err_str, &err_line);
+		CHECK_MESSAGE(err == expected_err, vformat("Unexpected result for '%s' in chunks of %d bytes.", p_json, chunk_size));
+		if (expected_err == OK) {
+			CHECK_MESSAGE(value == json->get_data(), vformat("Unexpected value for '%s' in chunks of %d bytes.", p_json, chunk_size));
+		} else {
+			CHECK_MESSAGE(err_str == json->get_error_message(), vformat("Unexpected error for '%s' in chunks of %d bytes.", p_json, chunk_size));
+			CHECK_MESSAGE(err_line == json->get_error_line(), vformat("Unexpected error line for '%s' in chunks of %d bytes.", p_json, chunk_size));
+		}
+	}
+}
+
+TEST_CASE("[JSONStreamParser] Events") {
+	const String json = "{\"a\": [1, 2.5, \"text\", true, null], \"b\": {}}";
+	const CharString utf8 = json.utf8();
+
+	JSONStreamParser parser;
+	parser.feed(utf8_span(utf8));
+	parser.finish();
+
+	const JSONStreamParser::Event expected[] = {
+		JSONStreamParser::EVENT_OBJECT_BEGIN,
+		JSONStreamParser::EVENT_KEY,
+		JSONStreamParser::EVENT_ARRAY_BEGIN,
+		JSONStreamParser::EVENT_NUMBER,
+		JSONStreamParser::EVENT_NUMBER,
+		JSONStreamParser::EVENT_STRING,
+		JSONStreamParser::EVENT_BOOL,
+		JSONStreamParser::EVENT_NULL,
+		JSONStreamParser::EVENT_ARRAY_END,
+		JSONStreamParser::EVENT_KEY,
+		JSONStreamParser::EVENT_OBJECT_BEGIN,
+		JSONStreamParser::EVENT_OBJECT_END,
+		JSONStreamParser::EVENT_OBJECT_END,
+		JSONStreamParser::EVENT_END,
+	};
+	for (JSONStreamParser::Event event : expected) {
+		REQUIRE(parser.read() == OK);
+		CHECK(parser.get_event() == event);
+
+		if (parser.get_event() == JSONStreamParser::EVENT_KEY) {
+			CHECK(parser.get_depth() == 1);
+			CHECK((parser.get_string() == "a" || parser.get_string() == "b"));
+		} else if (parser.get_event() == JSONStreamParser::EVENT_STRING) {
+			CHECK(parser.get_depth() == 2);
+			CHECK(parser.get_string() == "text");
+		} else if (parser.get_event() == JSONStreamParser::EVENT_BOOL) {
+			CHECK(parser.get_bool());
+		}
+	}
+	CHECK(parser.read() == ERR_FILE_EOF);
+}
+
+TEST_CASE("[JSONStreamParser] Waiting for more input") {
+	JSONStreamParser parser;
+	CHECK(parser.read() == ERR_UNAVAILABLE);
+
+	const char *first = "[12";
+	parser.feed((const uint8_t *)first, strlen(first));
+	REQUIRE(parser.read() == OK);
+	CHECK(parser.get_event() == JSONStreamParser::EVENT_ARRAY_BEGIN);
+	// The number may not be complete yet.
+	CHECK(parser.read() == ERR_UNAVAILABLE);
+
+	const char *second = "34, \"long";
+	parser.feed((const uint8_t *)second, strlen(second));
+	REQUIRE(parser.read() == OK);
+	CHECK(parser.get_event() == JSONStreamParser::EVENT_NUMBER);
+	CHECK(parser.is_integer());
+	CHECK(parser.get_integer() == 1234);
+	CHECK(parser.read() == ERR_UNAVAILABLE);
+
+	const char *third = " string\\";
+	parser.feed((const uint8_t *)third, strlen(third));
+	CHECK(parser.read() == ERR_UNAVAILABLE);
+
+	const char *fourth = "n\"]";
+	parser.feed((const uint8_t *)fourth, strlen(fourth));
+	REQUIRE(parser.read() == OK);
+	CHECK(parser.get_event() == JSONStreamParser::EVENT_STRING);
+	CHECK(parser.get_string() == "long string\n");
+	REQUIRE(parser.read() == OK);
+	CHECK(parser.get_event() == JSONStreamParser::EVENT_ARRAY_END);
+	// The end of the input isn't known yet.
+	CHECK(parser.read() == ERR_UNAVAILABLE);
+
+	parser.finish();
+	REQUIRE(parser.read() == OK);
+	CHECK(parser.get_event() == JSONStreamParser::EVENT_END);
+}
+
+TEST_CASE("[JSONStreamParser] Same results as JSON") {
+	check_same_as_json("null");
+	check_same_as_json("true");
+	check_same_as_json("  false  ");
+	check_same_as_json("0");
+	check_same_as_json("-0");
+	check_same_as_json("123456789");
+	check_same_as_json("-9223372036854775808");
+	check_same_as_json("123456789012345678901234567890");
+	check_same_as_json("-12.5e-3");
+	check_same_as_json("1e99999");
+	check_same_as_json("\"\"");
+	check_same_as_json("\"Hello\\tworld\\n\"");
+	check_same_as_json("\"\\u00e9t\\u00E9 \\ud83d\\ude00 \\\" \\\\ \\/\"");
+	check_same_as_json(String::utf8("\"été 😀 日本語\""));
+	check_same_as_json("[]");
+	check_same_as_json("[1, 2, 3,]");
+	check_same_as_json("[[1, \"a\"], [], {\"b\": [true, false, null]}]");
+	check_same_as_json("{}");
+	check_same_as_json("{\"key\": \"value\", \"number\": 1.5, \"nested\": {\"array\": [0.25]},}");
+	check_same_as_json("\n{\n\t\"multi\": \"line\n string\",\n\t\"value\": 1\n}\n");
+
+	ERR_PRINT_OFF;
+	check_same_as_json("[1, 2");
+	check_same_as_json("[1 2]");
+	check_same_as_json("{\"a\" 1}");
+	check_same_as_json("{\"a\": 1 \"b\": 2}");
+	check_same_as_json("{1: 2}");
+	check_same_as_json("{\"a\": }");
+	check_same_as_json("[,]");
+	check_same_as_json("nul");
+	check_same_as_json("\"unterminated");
+	check_same_as_json("\"bad \\x escape\"");
+	check_same_as_json("\"bad \\u12G4 hex\"");
+	check_same_as_json("\"\\ud83d alone\"");
+	check_same_as_json("\"\\ude00 alone\"");
+	check_same_as_json("[1]\n\n]");
+	check_same_as_json("\n\n@");
+	ERR_PRINT_ON;
+}
+
+TEST_CASE("[JSONStreamParser] Byte order mark") {
+	// Skipped at the start of the input, even when split between chunks.
+	const uint8_t json[] = { 0xef, 0xbb, 0xbf, '[', '1', ']' };
+	JSONStreamParser parser;
+	for (uint32_t i = 0; i < std::size(json); i++) {
+		parser.feed(json + i, 1);
+	}
+	parser.finish();
+	Variant value;
+	REQUIRE(parser.read_value(value) == OK);
+	CHECK(value == Variant(Array({ 1.0 })));
+	CHECK(parser.read() == OK);
+	CHECK(parser.get_event() == JSONStreamParser::EVENT_END);
+}
+
+TEST_CASE("[JSONStreamParser] Maximum depth") {
+	String deep;
+	for (int i = 0; i < Variant::MAX_RECURSION_DEPTH + 2; i++) {
+		deep += "[";
+	}
+
+	Variant value;
+	String err_str;
+	ERR_PRINT_OFF;
+	CHECK(JSONStreamParser::parse_utf8(utf8_span(deep.utf8()), value, 0, &err_str) == ERR_OUT_OF_MEMORY);
+	ERR_PRINT_ON;
+	CHECK(err_str == "JSON structure is too deep");
+	CHECK(value.get_type() == Variant::NIL);
+}
+
+TEST_CASE("[JSONStreamParser] Typed arrays and integers") {
+	const String json = "{\"floats\": [1, 2.5, -3], \"ints\": [1, 2, -3], \"mixed\": [1, \"a\", 2.5], \"nested\": [[1, 2], [0.5]], \"empty\": [], \"int\": 7}";
+
+	Variant value;
+	REQUIRE(parse_in_chunks(json, 5, value) == OK);
+	Dictionary dict = value;
+	CHECK(dict["floats"].get_type() == Variant::ARRAY);
+	CHECK(dict["int"].get_type() == Variant::FLOAT);
+
+	REQUIRE(parse_in_chunks(json, 5, value, JSONStreamParser::PARSE_TYPED_ARRAYS) == OK);
+	dict = value;
+	CHECK(dict["floats"] == Variant(PackedFloat64Array({ 1.0, 2.5, -3.0 })));
+	CHECK(dict["ints"] == Variant(PackedFloat64Array({ 1.0, 2.0, -3.0 })));
+	CHECK(dict["mixed"].get_type() == Variant::ARRAY);
+	CHECK(dict["mixed"] == Variant(Array({ 1.0, "a", 2.5 })));
+	CHECK(dict["nested"] == Variant(Array({ PackedFloat64Array({ 1.0, 2.0 }), PackedFloat64Array({ 0.5 }) })));
+	CHECK(dict["empty"] == Variant(Array()));
+	CHECK(dict["int"].get_type() == Variant::FLOAT);
+
+	REQUIRE(parse_in_chunks(json, 5, value, JSONStreamParser::PARSE_TYPED_ARRAYS | JSONStreamParser::PARSE_INTEGERS) == OK);
+	dict = value;
+	CHECK(dict["floats"] == Variant(PackedFloat64Array({ 1.0, 2.5, -3.0 })));
+	CHECK(dict["ints"] == Variant(PackedInt64Array({ 1, 2, -3 })));
+	CHECK(dict["mixed"] == Variant(Array({ 1, "a", 2.5 })));
+	CHECK(dict["nested"] == Variant(Array({ PackedInt64Array({ 1, 2 }), PackedFloat64Array({ 0.5 }) })));
+	CHECK(dict["int"] == Variant(7));
+
+	REQUIRE(parse_in_chunks("[9223372036854775807, 9223372036854775808]", 7, value, JSONStreamParser::PARSE_INTEGERS) == OK);
+	Array array = value;
+	CHECK(array[0] == Variant(INT64_MAX));
+	CHECK(array[1].get_type() == Variant::FLOAT);
+}
+
+TEST_CASE("[JSONStreamParser] Parsing a file") {
+	Array array;
+	for (int i = 0; i < 20000; i++) {
+		Dictionary entry;
+		entry["id"] = i;
+		entry["name"] = vformat(String::utf8("entrée %d"), i);
+		entry["position"] = Array({ i * 0.5, -i, 1.0 });
+		array.push_back(entry);
+	}
+	const String json = JSON::stringify(array, "\t");
+
+	const String path = TestUtils::get_temp_path("stream_parser.json");
+	{
+		Ref<FileAccess> f = FileAccess::open(path, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_string(json);
+	}
+
+	Ref<FileAccess> f = FileAccess::open(path, FileAccess::READ);
+	REQUIRE(f.is_valid());
+	Variant value;
+	REQUIRE(JSONStreamParser::parse_file(f, value) == OK);
+	CHECK(value == JSON::parse_string(json));
+
+	DirAccess::remove_file_or_error(path);
+}
+
+TEST_CASE_BENCHMARK("[Benchmark][JSONStreamParser] Parsing a large document") {
+	// About 100 MB of records with numeric arrays and text.
+	String json = "[";
+	for (int i = 0; i < 200000; i++) {
+		if (i > 0) {
+			json += ",";
+		}
+		json += vformat("{\"id\": %d, \"name\": \"record %d\", \"weights\": [", i, i);
+		for (int j = 0; j < 64; j++) {
+			json += j > 0 ? ", " : "";
+			json += rtos(i * 0.001 + j);
+		}
+		json += "]}";
+	}
+	json += "]";
+	const CharString utf8 = json.utf8();
+	json = String();
+
+	const double mb = utf8.length() / (1024.0 * 1024.0);
+
+	uint64_t start = OS::get_singleton()->get_ticks_usec();
+	{
+		Ref<JSON> parser;
+		parser.instantiate();
+		REQUIRE(parser->parse(String::utf8(utf8.get_data(), utf8.length())) == OK);
+	}
+	uint64_t usec = OS::get_singleton()->get_ticks_usec() - start;
+	print_line(vformat("JSON::parse() with UTF-8 decoding: %.1f MB in %d usec (%.1f MB/s).", mb, usec, mb / (usec / 1000000.0)));
+
+	const char *mode_names[] = { "JSONStreamParser", "JSONStreamParser with typed arrays" };
+	const uint32_t mode_flags[] = { 0, JSONStreamParser::PARSE_TYPED_ARRAYS };
+	for (int mode = 0; mode < 2; mode++) {
+		start = OS::get_singleton()->get_ticks_usec();
+		Variant value;
+		REQUIRE(JSONStreamParser::parse_utf8(utf8_span(utf8), value, mode_flags[mode]) == OK);
+		usec = OS::get_singleton()->get_ticks_usec() - start;
+		print_line(vformat("%s: %.1f MB in %d usec (%.1f MB/s).", mode_names[mode], mb, usec, mb / (usec / 1000000.0)));
+	}
+}
+
+} // namespace TestJSONStreamParser
@@ -34,6 +34,7 @@ TEST_FORCE_LINK(test_marshalls)
 
 #include "core/io/marshalls.h"
 #include "core/object/script_language.h"
+#include "core/os/os.h"
 
 namespace TestMarshalls {
 
@@ -490,4 +491,232 @@ TEST_CASE("[Marshalls] Typed dictionary decoding") {
 	CHECK(dictionary[Variant(uint64_t(0x0f123456789abcdef))] == Variant(uint64_t(0x0f123456789abcdef)));
 }
 
+static Vector<Variant> make_variants_of_every_type() {
+	Vector<Variant> variants;
+	variants.push_back(Variant());
+	variants.push_back(true);
+	variants.push_back(-1234);
+	variants.push_back(0.625);
+	variants.push_back("Hello, world! ñ");
+	variants.push_back(Vector2(1.5, -2.25));
+	variants.push_back(Vector2i(3, -4));
+	variants.push_back(Rect2(1, 2, 3.5, 4.5));
+	variants.push_back(Rect2i(-1, -2, 3, 4));
+	variants.push_back(Vector3(1.5, 2.5, -3.5));
+	variants.push_back(Vector3i(7, -8, 9));
+	variants.push_back(Transform2D(1, 2, 3, 4, 5, 6));
+	variants.push_back(Vector4(1, 2.5, 3, -4.5));
+	variants.push_back(Vector4i(1, 2, -3, 4));
+	variants.push_back(Plane(0, 1, 0, 2.5));
+	variants.push_back(Quaternion(0, 0, 0.5, 0.75));
+	variants.push_back(AABB(Vector3(1, 2, 3), Vector3(4, 5, 6)));
+	variants.push_back(Basis(1, 2, 3, 4, 5, 6, 7, 8, 9));
+	variants.push_back(Transform3D(Basis(1, 2, 3, 4, 5, 6, 7, 8, 9), Vector3(10, 11, 12)));
+	variants.push_back(Projection(Vector4(1, 2, 3, 4), Vector4(5, 6, 7, 8), Vector4(9, 10, 11, 12), Vector4(13, 14, 15, 16)));
+	variants.push_back(Color(0.25, 0.5, 0.75, 1));
+	variants.push_back(StringName("string_name"));
+	variants.push_back(NodePath("Node/Child:property:x"));
+	variants.push_back(RID::from_uint64(0x123456789abcdef));
+	// Objects need to be instantiated again, so they don't round-trip.
+	variants.push_back(Callable());
+	variants.push_back(Signal(ObjectID(uint64_t(1234)), "changed"));
+
+	Dictionary dictionary;
+	dictionary["key"] = Vector3(1, 2, 3);
+	dictionary[5] = PackedStringArray({ "a", "b" });
+	variants.push_back(dictionary);
+
+	Array array;
+	array.push_back(1);
+	array.push_back("two");
+	array.push_back(PackedInt64Array({ 3, INT64_MAX }));
+	variants.push_back(array);
+
+	variants.push_back(PackedByteArray({ 1, 2, 3, 255, 0 }));
+	variants.push_back(PackedInt32Array({ 0, 1, -1, INT32_MAX, INT32_MIN }));
+	variants.push_back(PackedInt64Array({ 0, 1, -1, INT64_MAX, INT64_MIN }));
+	variants.push_back(PackedFloat32Array({ 0.5, -1.25, 1e10 }));
+	variants.push_back(PackedFloat64Array({ 0.1, -1e300, 3.0 }));
+	variants.push_back(PackedStringArray({ "one", "", "three" }));
+	variants.push_back(PackedVector2Array({ Vector2(1, 2), Vector2(-3.5, 4) }));
+	variants.push_back(PackedVector3Array({ Vector3(1, 2, 3), Vector3(-4, 5.5, 6) }));
+	variants.push_back(PackedColorArray({ Color(1, 0, 0), Color(0.5, 0.25, 0.125, 0.5) }));
+	variants.push_back(PackedVector4Array({ Vector4(1, 2, 3, 4), Vector4(-5, 6, 7.5, 8) }));
+	return variants;
+}
+
+TEST_CASE("[Marshalls] Round-trip of every Variant type") {
+	const Vector<Variant> variants = make_variants_of_every_type();
+
+	for (int compact = 0; compact < 2; compact++) {
+		for (const Variant &variant : variants) {
+			int len = 0;
+			REQUIRE(encode_variant(variant, nullptr, len, false, 0, compact) == OK);
+			CHECK(len % 4 == 0);
+
+			Vector<uint8_t> buffer;
+			buffer.resize(len);
+			int written = 0;
+			REQUIRE(encode_variant(variant, buffer.ptrw(), written, false, 0, compact) == OK);
+			CHECK(written == len);
+
+			Variant decoded;
+			int read = 0;
+			CHECK(decode_variant(decoded, buffer.ptr(), len, &read) == OK);
+			CHECK_MESSAGE(read == len, vformat("All the bytes of a %s should be read.", Variant::get_type_name(variant.get_type())));
+			CHECK_MESSAGE(decoded.get_type() == variant.get_type(), vformat("%s should decode to the same type.", Variant::get_type_name(variant.get_type())));
+			CHECK_MESSAGE(decoded == variant, vformat("%s should decode to the same value.", Variant::get_type_name(variant.get_type())));
+		}
+	}
+
+	bool has_type[Variant::VARIANT_MAX] = {};
+	for (const Variant &variant : variants) {
+		has_type[variant.get_type()] = true;
+	}
+	for (int i = 0; i < Variant::VARIANT_MAX; i++) {
+		CHECK_MESSAGE(has_type[i] == (i != Variant::OBJECT), vformat("%s should be tested.", Variant::get_type_name(Variant::Type(i))));
+	}
+}
+
+TEST_CASE("[Marshalls] Packed arrays are stored as little-endian elements") {
+	int r_len;
+	uint8_t buffer[24];
+
+	CHECK(encode_variant(PackedFloat32Array({ 0.15625, -2 }), buffer, r_len) == OK);
+	CHECK(r_len == 16);
+	CHECK_MESSAGE(buffer[0] == 0x20, "Variant::PACKED_FLOAT32_ARRAY");
+	CHECK(buffer[4] == 0x02);
+	CHECK(buffer[8] == 0x00);
+	CHECK(buffer[9] == 0x00);
+	CHECK(buffer[10] == 0x20);
+	CHECK(buffer[11] == 0x3e);
+	CHECK(buffer[15] == 0xc0);
+
+	CHECK(encode_variant(PackedInt64Array({ 0x0102030405060708 }), buffer, r_len) == OK);
+	CHECK(r_len == 16);
+	CHECK(buffer[8] == 0x08);
+	CHECK(buffer[15] == 0x01);
+
+	CHECK(encode_variant(PackedColorArray({ Color(0.15625, 0, 0, 0) }), buffer, r_len) == OK);
+	CHECK(r_len == 24);
+	CHECK(buffer[8] == 0x00);
+	CHECK(buffer[11] == 0x3e);
+}
+
+TEST_CASE("[Marshalls] Compact encoding of packed int arrays") {
+	PackedInt32Array small32;
+	PackedInt64Array small64;
+	for (int i = -100; i < 100; i++) {
+		small32.push_back(i);
+		small64.push_back(i * 1000);
+	}
+
+	int raw_len = 0;
+	int len = 0;
+	CHECK(encode_variant(small32, nullptr, raw_len) == OK);
+	CHECK(encode_variant(small32, nullptr, len, false, 0, true) == OK);
+	CHECK(raw_len == 4 + 4 + 200 * 4);
+	CHECK_MESSAGE(len == 4 + 8 + 128 + 72 * 2, "Values between -64 and 63 take one byte, the others two.");
+
+	Vector<uint8_t> buffer;
+	buffer.resize(len);
+	CHECK(encode_variant(small32, buffer.ptrw(), len, false, 0, true) == OK);
+	CHECK_MESSAGE(buffer[2] == 0x01, "HEADER_DATA_FLAG_VARINT");
+	CHECK_MESSAGE(buffer[12] == 199, "Zigzag encoding of -100, low 7 bits.");
+	CHECK(buffer[13] == 0x01);
+
+	Variant decoded;
+	int read = 0;
+	CHECK(decode_variant(decoded, buffer.ptr(), len, &read) == OK);
+	CHECK(read == len);
+	CHECK(decoded == Variant(small32));
+
+	CHECK(encode_variant(small64, nullptr, raw_len) == OK);
+	CHECK(encode_variant(small64, nullptr, len, false, 0, true) == OK);
+	CHECK(len < raw_len / 2);
+
+	// Large values aren't worth it, so they keep the plain encoding.
+	const PackedInt64Array large = { INT64_MIN, INT64_MAX, -INT64_MAX };
+	CHECK(encode_variant(large, nullptr, raw_len) == OK);
+	CHECK(encode_variant(large, nullptr, len, false, 0, true) == OK);
+	CHECK(len == raw_len);
+
+	// Truncated or inconsistent data.
+	buffer.resize(64);
+	CHECK(encode_variant(PackedInt32Array({ 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12 }), buffer.ptrw(), len, false, 0, true) == OK);
+	CHECK(len == 4 + 8 + 12);
+
+	ERR_PRINT_OFF;
+	CHECK(decode_variant(decoded, buffer.ptr(), len - 4) == ERR_INVALID_DATA);
+	buffer.write[4] = 13; // One more element than encoded.
+	CHECK(decode_variant(decoded, buffer.ptr(), len) == ERR_INVALID_DATA);
+	buffer.write[4] = 11; // One less.
+	CHECK(decode_variant(decoded, buffer.ptr(), len) == ERR_INVALID_DATA);
+	buffer.write[4] = 12;
+	buffer.write[12] = 0xff; // Unterminated varint.
+	buffer.write[13] = 0xff;
+	buffer.write[14] = 0xff;
+	buffer.write[15] = 0xff;
+	buffer.write[16] = 0xff;
+	CHECK(decode_variant(decoded, buffer.ptr(), len) == ERR_INVALID_DATA);
+	ERR_PRINT_ON;
+}
+
+TEST_CASE_BENCHMARK("[Benchmark][Marshalls] Encoding and decoding packed arrays") {
+	const int count = 4 * 1024 * 1024;
+	const int iterations = 8;
+
+	PackedByteArray bytes;
+	PackedInt32Array int32s;
+	PackedInt64Array int64s;
+	PackedFloat32Array float32s;
+	PackedFloat64Array float64s;
+	PackedVector2Array vector2s;
+	PackedVector3Array vector3s;
+	PackedColorArray colors;
+	PackedVector4Array vector4s;
+	for (int i = 0; i < count; i++) {
+		bytes.push_back(i);
+		int32s.push_back(i % 1000 - 500);
+		int64s.push_back(int64_t(i) * 3);
+		float32s.push_back(i * 0.5f);
+		float64s.push_back(i * 0.25);
+		vector2s.push_back(Vector2(i, -i));
+		vector3s.push_back(Vector3(i, -i, i * 2));
+		colors.push_back(Color(i, 0.5, 0.25, 1));
+		vector4s.push_back(Vector4(i, -i, i * 2, 1));
+	}
+	const Variant arrays[] = { bytes, int32s, int64s, float32s, float64s, vector2s, vector3s, colors, vector4s };
+
+	for (const Variant &array : arrays) {
+		for (int compact = 0; compact < 2; compact++) {
+			if (compact && array.get_type() != Variant::PACKED_INT32_ARRAY && array.get_type() != Variant::PACKED_INT64_ARRAY) {
+				continue;
+			}
+
+			int len = 0;
+			REQUIRE(encode_variant(array, nullptr, len, false, 0, compact) == OK);
+			Vector<uint8_t> buffer;
+			buffer.resize(len);
+
+			uint64_t start = OS::get_singleton()->get_ticks_usec();
+			for (int i = 0; i < iterations; i++) {
+				encode_variant(array, buffer.ptrw(), len, false, 0, compact);
+			}
+			const uint64_t encode_usec = OS::get_singleton()->get_ticks_usec() - start;
+
+			Variant decoded;
+			start = OS::get_singleton()->get_ticks_usec();
+			for (int i = 0; i < iterations; i++) {
+				decode_variant(decoded, buffer.ptr(), len);
+			}
+			const uint64_t decode_usec = OS::get_singleton()->get_ticks_usec() - start;
+			CHECK(decoded == array);
+
+			const double mib = double(len) * iterations / (1024.0 * 1024.0);
+			print_line(vformat("%s%s, %.1f MiB: encoding %.0f MiB/s, decoding %.0f MiB/s.", Variant::get_type_name(array.get_type()), compact ? " (compact)" : "", len / (1024.0 * 1024.0), mib / (MAX(encode_usec, 1u) / 1000000.0), mib / (MAX(decode_usec, 1u) / 1000000.0)));
+		}
+	}
+}
+
 } // namespace TestMarshalls
@@ -32,7 +32,9 @@
 
 TEST_FORCE_LINK(test_pck_packer)
 
+#include "core/io/dir_access.h"
 #include "core/io/file_access.h"
+#include "core/io/file_access_pack.h"
 #include "core/io/pck_packer.h"
 #include "core/os/os.h"
 #include "tests/test_utils.h"
@@ -120,4 +122,143 @@ TEST_CASE("[PCKPacker] Pack a PCK file with some files and directories") {
 			"The generated non-empty PCK file shouldn't be too large.");
 }
 
+static Vector<uint8_t> make_random_data(int p_size, uint32_t p_seed) {
+	Vector<uint8_t> data;
+	data.resize(p_size);
+	uint8_t *w = data.ptrw();
+	for (int i = 0; i < p_size; i++) {
+		p_seed = p_seed * 1664525 + 1013904223;
+		w[i] = p_seed >> 24;
+	}
+	return data;
+}
+
+static void check_pack_file(const String &p_path, const Vector<uint8_t> &p_data) {
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::READ);
+	REQUIRE_MESSAGE(f.is_valid(), vformat("'%s' should be in the loaded packs.", p_path));
+	CHECK(f->get_length() == (uint64_t)p_data.size());
+	CHECK_MESSAGE(f->get_buffer(p_data.size()) == p_data, vformat("'%s' should be assembled from its chunks.", p_path));
+	CHECK(f->get_buffer(1).is_empty());
+	CHECK(f->eof_reached());
+
+	// Reads across chunk boundaries.
+	for (int i = 0; i < 10; i++) {
+		const int ofs = p_data.size() * i / 10;
+		const int length = MIN(100000, p_data.size() - ofs);
+		f->seek(ofs);
+		CHECK(f->get_buffer(length) == p_data.slice(ofs, ofs + length));
+	}
+}
+
+TEST_CASE("[PCKPacker] Chunked pack with duplicated data") {
+	const Vector<uint8_t> data = make_random_data(2 * 1024 * 1024, 1);
+	Vector<uint8_t> edited = data.slice(0, 1000000);
+	edited.append_array(String("Some text inserted in the middle of the file.").to_utf8_buffer());
+	edited.append_array(data.slice(1000000));
+	const Vector<uint8_t> small = String("Hello world!").to_utf8_buffer();
+
+	PCKPacker pck_packer;
+	const String pck_path = TestUtils::get_temp_path("chunked.pck");
+	pck_packer.set_chunking_enabled(true);
+	REQUIRE(pck_packer.pck_start(pck_path) == OK);
+	REQUIRE(pck_packer.add_file_from_buffer("chunk_test/data.bin", data) == OK);
+	REQUIRE(pck_packer.add_file_from_buffer("chunk_test/copy.bin", data) == OK);
+	REQUIRE(pck_packer.add_file_from_buffer("chunk_test/edited.bin", edited) == OK);
+	REQUIRE(pck_packer.add_file_from_buffer("chunk_test/small.txt", small) == OK);
+	REQUIRE(pck_packer.add_file_from_buffer("chunk_test/empty.bin", Vector<uint8_t>()) == OK);
+	REQUIRE(pck_packer.add_file_from_buffer("chunk_test/encrypted.bin", small, true) == OK);
+	REQUIRE(pck_packer.flush() == OK);
+
+	// Identical chunks are only stored once.
+	Ref<FileAccess> f = FileAccess::open(pck_path, FileAccess::READ);
+	REQUIRE(f.is_valid());
+	CHECK_MESSAGE(f->get_length() < (uint64_t)data.size() + 600 * 1024, "Identical data should only be stored once.");
+	f.unref();
+
+	PackedData *packed_data = PackedData::get_singleton();
+	REQUIRE(packed_data != nullptr);
+	REQUIRE(packed_data->add_pack(pck_path, true, 0) == OK);
+	const bool memory_mapping = packed_data->is_memory_mapping_enabled();
+
+	for (int mapped = 0; mapped < 2; mapped++) {
+		packed_data->set_memory_mapping_enabled(mapped);
+		check_pack_file("res://chunk_test/data.bin", data);
+		check_pack_file("res://chunk_test/copy.bin", data);
+		check_pack_file("res://chunk_test/edited.bin", edited);
+		check_pack_file("res://chunk_test/small.txt", small);
+		check_pack_file("res://chunk_test/empty.bin", Vector<uint8_t>());
+	}
+
+	packed_data->set_memory_mapping_enabled(memory_mapping);
+	CHECK(FileAccess::exists("res://chunk_test/encrypted.bin"));
+	packed_data->remove_path("res://chunk_test/data.bin");
+	packed_data->remove_path("res://chunk_test/copy.bin");
+	packed_data->remove_path("res://chunk_test/edited.bin");
+	packed_data->remove_path("res://chunk_test/small.txt");
+	packed_data->remove_path("res://chunk_test/empty.bin");
+	packed_data->remove_path("res://chunk_test/encrypted.bin");
+	DirAccess::remove_file_or_error(pck_path);
+}
+
+TEST_CASE("[PCKPacker] Chunked patch pack") {
+	const Vector<uint8_t> data = make_random_data(2 * 1024 * 1024, 2);
+	Vector<uint8_t> edited = data;
+	for (int i = 0; i < 100; i++) {
+		edited.write[1500000 + i] = i;
+	}
+
+	PCKPacker pck_packer;
+	pck_packer.set_chunking_enabled(true);
+	const String base_path = TestUtils::get_temp_path("chunked_base.pck");
+	REQUIRE(pck_packer.pck_start(base_path) == OK);
+	REQUIRE(pck_packer.add_file_from_buffer("chunk_patch_test/data.bin", data) == OK);
+	REQUIRE(pck_packer.add_file_from_buffer("chunk_patch_test/removed.bin", data.slice(0, 1000)) == OK);
+	REQUIRE(pck_packer.flush() == OK);
+
+	const String patch_path = TestUtils::get_temp_path("chunked_patch.pck");
+	REQUIRE(pck_packer.pck_start(patch_path) == OK);
+	REQUIRE(pck_packer.add_base_pack(base_path) == OK);
+	REQUIRE(pck_packer.add_file_from_buffer("chunk_patch_test/data.bin", edited) == OK);
+	REQUIRE(pck_packer.add_file_removal("chunk_patch_test/removed.bin") == OK);
+	REQUIRE(pck_packer.flush() == OK);
+
+	// Only the chunks around the change are in the patch.
+	Ref<FileAccess> f = FileAccess::open(patch_path, FileAccess::READ);
+	REQUIRE(f.is_valid());
+	CHECK_MESSAGE(f->get_length() < 600 * 1024, "The patch should only hold the changed chunks.");
+	f.unref();
+
+	// A patch whose base pack isn't loaded can't provide its files.
+	const String other_base_path = TestUtils::get_temp_path("chunked_other_base.pck");
+	REQUIRE(pck_packer.pck_start(other_base_path) == OK);
+	REQUIRE(pck_packer.add_file_from_buffer("chunk_patch_test/other.bin", make_random_data(100000, 3)) == OK);
+	REQUIRE(pck_packer.flush() == OK);
+
+	const String other_patch_path = TestUtils::get_temp_path("chunked_other_patch.pck");
+	REQUIRE(pck_packer.pck_start(other_patch_path) == OK);
+	REQUIRE(pck_packer.add_base_pack(other_base_path) == OK);
+	REQUIRE(pck_packer.add_file_from_buffer("chunk_patch_test/other.bin", make_random_data(100000, 3)) == OK);
+	REQUIRE(pck_packer.flush() == OK);
+
+	PackedData *packed_data = PackedData::get_singleton();
+	REQUIRE(packed_data->add_pack(base_path, true, 0) == OK);
+	check_pack_file("res://chunk_patch_test/data.bin", data);
+	CHECK(FileAccess::exists("res://chunk_patch_test/removed.bin"));
+
+	REQUIRE(packed_data->add_pack(patch_path, true, 0) == OK);
+	check_pack_file("res://chunk_patch_test/data.bin", edited);
+	CHECK_FALSE(FileAccess::exists("res://chunk_patch_test/removed.bin"));
+
+	ERR_PRINT_OFF;
+	CHECK(packed_data->add_pack(other_patch_path, true, 0) == OK);
+	ERR_PRINT_ON;
+	CHECK_FALSE(FileAccess::exists("res://chunk_patch_test/other.bin"));
+
+	packed_data->remove_path("res://chunk_patch_test/data.bin");
+	DirAccess::remove_file_or_error(base_path);
+	DirAccess::remove_file_or_error(patch_path);
+	DirAccess::remove_file_or_error(other_base_path);
+	DirAccess::remove_file_or_error(other_patch_path);
+}
+
 } // namespace TestPCKPacker
@@ -32,6 +32,9 @@
 
 TEST_FORCE_LINK(test_resource)
 
+#include "core/io/dir_access.h"
+#include "core/io/file_access_pack.h"
+#include "core/io/pck_packer.h"
 #include "core/io/resource.h"
 #include "core/io/resource_loader.h"
 #include "core/io/resource_saver.h"
@@ -573,6 +576,91 @@ TEST_CASE("[Resource] Saving and loading") {
 			"The loaded child resource name should be equal to the expected value.");
 }
 
+TEST_CASE("[Resource] Saving and loading large packed arrays") {
+	// Large arrays are padded in binary resources, so they can be used in place when loaded from a memory mapped pack.
+	PackedByteArray bytes;
+	PackedFloat32Array floats;
+	PackedVector3Array vectors;
+	for (int i = 0; i < 10000; i++) {
+		bytes.push_back(i * 7);
+		floats.push_back(i * 0.5f);
+		vectors.push_back(Vector3(i, -i, i * 2));
+	}
+
+	Ref<Resource> resource = memnew(Resource);
+	resource->set_meta("bytes", bytes);
+	resource->set_meta("floats", floats);
+	resource->set_meta("vectors", vectors);
+	// Small arrays aren't padded.
+	resource->set_meta("small", PackedInt32Array({ 1, 2, 3 }));
+	// Only exports pad arrays, other saves keep the previous format version.
+	const String unpadded_path = TestUtils::get_temp_path("resource_arrays_unpadded.res");
+	REQUIRE(ResourceSaver::save(resource, unpadded_path) == OK);
+	const String save_path = TestUtils::get_temp_path("resource_arrays.res");
+	REQUIRE(ResourceSaver::save(resource, save_path, ResourceSaver::FLAG_ALIGN_PACKED_ARRAYS) == OK);
+
+	// The format version follows the magic, the endianness, the 64-bit flag and the engine version.
+	const uint64_t format_version_offset = 20;
+	Ref<FileAccess> f = FileAccess::open(unpadded_path, FileAccess::READ);
+	REQUIRE(f.is_valid());
+	f->seek(format_version_offset);
+	CHECK(f->get_32() == 6);
+	f = FileAccess::open(save_path, FileAccess::READ);
+	REQUIRE(f.is_valid());
+	f->seek(format_version_offset);
+	CHECK(f->get_32() == 7);
+	f.unref();
+
+	const Ref<Resource> unpadded_resource = ResourceLoader::load(unpadded_path, "", ResourceFormatLoader::CACHE_MODE_IGNORE);
+	REQUIRE(unpadded_resource.is_valid());
+	CHECK(unpadded_resource->get_meta("bytes") == Variant(bytes));
+	CHECK(unpadded_resource->get_meta("vectors") == Variant(vectors));
+
+	const Ref<Resource> loaded_resource = ResourceLoader::load(save_path, "", ResourceFormatLoader::CACHE_MODE_IGNORE);
+	REQUIRE(loaded_resource.is_valid());
+	CHECK(loaded_resource->get_meta("bytes") == Variant(bytes));
+	CHECK(loaded_resource->get_meta("floats") == Variant(floats));
+	CHECK(loaded_resource->get_meta("vectors") == Variant(vectors));
+	CHECK(loaded_resource->get_meta("small") == Variant(PackedInt32Array({ 1, 2, 3 })));
+
+	const String pck_path = TestUtils::get_temp_path("resource_arrays.pck");
+	PCKPacker pck_packer;
+	REQUIRE(pck_packer.pck_start(pck_path) == OK);
+	REQUIRE(pck_packer.add_file("resource_arrays_test/arrays.res", save_path) == OK);
+	REQUIRE(pck_packer.flush() == OK);
+
+	PackedData *packed_data = PackedData::get_singleton();
+	REQUIRE(packed_data != nullptr);
+	REQUIRE(packed_data->add_pack(pck_path, true, 0) == OK);
+
+	const String packed_path = "res://resource_arrays_test/arrays.res";
+	Ref<Resource> packed_resource = ResourceLoader::load(packed_path, "", ResourceFormatLoader::CACHE_MODE_IGNORE);
+	REQUIRE(packed_resource.is_valid());
+	CHECK(packed_resource->get_meta("bytes") == Variant(bytes));
+	CHECK(packed_resource->get_meta("floats") == Variant(floats));
+	CHECK(packed_resource->get_meta("vectors") == Variant(vectors));
+	CHECK(packed_resource->get_meta("small") == Variant(PackedInt32Array({ 1, 2, 3 })));
+
+	// Modifying loaded arrays must not affect the pack, nor other resources loaded from it.
+	PackedFloat32Array loaded_floats = packed_resource->get_meta("floats");
+	loaded_floats.set(0, 42.0f);
+	packed_resource->set_meta("floats", loaded_floats);
+	PackedVector3Array loaded_vectors = packed_resource->get_meta("vectors");
+	loaded_vectors.push_back(Vector3());
+	packed_resource->set_meta("vectors", loaded_vectors);
+
+	const Ref<Resource> reloaded_resource = ResourceLoader::load(packed_path, "", ResourceFormatLoader::CACHE_MODE_IGNORE);
+	REQUIRE(reloaded_resource.is_valid());
+	CHECK(reloaded_resource->get_meta("floats") == Variant(floats));
+	CHECK(reloaded_resource->get_meta("vectors") == Variant(vectors));
+	CHECK(packed_resource->get_meta("floats") == Variant(loaded_floats));
+
+	packed_data->remove_path(packed_path);
+	DirAccess::remove_file_or_error(pck_path);
+	DirAccess::remove_file_or_error(save_path);
+	DirAccess::remove_file_or_error(unpadded_path);
+}
+
 TEST_CASE("[Resource] Breaking circular references on save") {
 	Ref<Resource> resource_a = memnew(Resource);
 	resource_a->set_name("A");
@@ -0,0 +1,145 @@
+/**************************************************************************/
+/*  test_resource_loader.cpp                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "tests/test_macros.h"
+
+TEST_FORCE_LINK(test_resource_loader)
+
+#include "core/io/dir_access.h"
+#include "core/io/resource.h"
+#include "core/io/resource_loader.h"
+#include "core/io/resource_saver.h"
+#include "core/os/os.h"
+#include "tests/test_utils.h"
+
+namespace TestResourceLoader {
+
+// A main resource referencing many external ones, like a scene with many meshes and textures.
+struct DependencyGraph {
+	String main_path;
+	Vector<String> paths;
+
+	DependencyGraph(const String &p_name, const String &p_extension, int p_dependency_count, int p_dependency_size) {
+		PackedByteArray data;
+		data.resize(p_dependency_size);
+		for (int i = 0; i < p_dependency_size; i++) {
+			data.set(i, i * 7);
+		}
+
+		Array dependencies;
+		for (int i = 0; i < p_dependency_count; i++) {
+			Ref<Resource> dependency = memnew(Resource);
+			dependency->set_name(itos(i));
+			dependency->set_meta("data", data);
+			const String path = TestUtils::get_temp_path(vformat("%s_%d.res", p_name, i));
+			REQUIRE(ResourceSaver::save(dependency, path, ResourceSaver::FLAG_CHANGE_PATH) == OK);
+			dependencies.push_back(dependency);
+			paths.push_back(path);
+		}
+
+		Ref<Resource> main = memnew(Resource);
+		main->set_meta("dependencies", dependencies);
+		main_path = TestUtils::get_temp_path(p_name + "." + p_extension);
+		REQUIRE(ResourceSaver::save(main, main_path) == OK);
+		paths.push_back(main_path);
+	}
+
+	~DependencyGraph() {
+		for (const String &path : paths) {
+			DirAccess::remove_file_or_error(path);
+		}
+	}
+};
+
+static Ref<Resource> load_threaded(const String &p_path, HashMap<String, uint64_t> *r_load_times = nullptr) {
+	if (ResourceLoader::load_threaded_request(p_path, "", true, ResourceFormatLoader::CACHE_MODE_IGNORE_DEEP) != OK) {
+		return Ref<Resource>();
+	}
+	while (ResourceLoader::load_threaded_get_status(p_path) == ResourceLoader::THREAD_LOAD_IN_PROGRESS) {
+		OS::get_singleton()->delay_usec(100);
+	}
+	if (r_load_times) {
+		ResourceLoader::load_threaded_get_status(p_path, nullptr, r_load_times);
+	}
+	return ResourceLoader::load_threaded_get(p_path);
+}
+
+TEST_CASE("[SceneTree][ResourceLoader] Dependency load times") {
+	for (const String extension : { "res", "tres" }) {
+		DependencyGraph graph("load_times", extension, 16, 1024);
+
+		HashMap<String, uint64_t> load_times;
+		Ref<Resource> loaded = load_threaded(graph.main_path, &load_times);
+		REQUIRE(loaded.is_valid());
+		CHECK(Array(loaded->get_meta("dependencies")).size() == 16);
+
+		// The main resource and all of its dependencies.
+		CHECK(load_times.size() == graph.paths.size());
+		for (const String &path : graph.paths) {
+			CHECK_MESSAGE(load_times.has(path), vformat("The load time of '%s' should be reported.", path));
+		}
+		// The main resource waits for its dependencies.
+		for (const KeyValue<String, uint64_t> &E : load_times) {
+			CHECK(E.value <= load_times[graph.main_path]);
+		}
+	}
+}
+
+TEST_CASE_BENCHMARK("[SceneTree][Benchmark][ResourceLoader] Loading many dependencies") {
+	for (const String extension : { "res", "tres" }) {
+		// 256 dependencies of 1 MiB each.
+		DependencyGraph graph("load_benchmark", extension, 256, 1024 * 1024);
+
+		uint64_t start = OS::get_singleton()->get_ticks_usec();
+		Ref<Resource> loaded = ResourceLoader::load(graph.main_path, "", ResourceFormatLoader::CACHE_MODE_IGNORE_DEEP);
+		const uint64_t serial_usec = OS::get_singleton()->get_ticks_usec() - start;
+		REQUIRE(loaded.is_valid());
+		loaded.unref();
+
+		HashMap<String, uint64_t> load_times;
+		start = OS::get_singleton()->get_ticks_usec();
+		loaded = load_threaded(graph.main_path, &load_times);
+		const uint64_t threaded_usec = OS::get_singleton()->get_ticks_usec() - start;
+		REQUIRE(loaded.is_valid());
+
+		uint64_t dependencies_usec = 0;
+		uint64_t slowest_usec = 0;
+		for (const KeyValue<String, uint64_t> &E : load_times) {
+			if (E.key != graph.main_path) {
+				dependencies_usec += E.value;
+				slowest_usec = MAX(slowest_usec, E.value);
+			}
+		}
+
+		print_line(vformat(".%s: serial load %d usec, threaded load %d usec (%.2fx). Dependencies took %d usec in total, %d usec at most.", extension, serial_usec, threaded_usec, (double)serial_usec / threaded_usec, dependencies_usec, slowest_usec));
+	}
+}
+
+} // namespace TestResourceLoader
@@ -0,0 +1,250 @@
+/**************************************************************************/
+/*  test_message_queue.cpp                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "tests/test_macros.h"
+
+TEST_FORCE_LINK(test_message_queue)
+
+#include "core/object/callable_mp.h"
+#include "core/object/message_queue.h"
+#include "core/object/worker_thread_pool.h"
+#include "core/os/os.h"
+#include "core/os/thread.h"
+
+namespace TestMessageQueue {
+
+struct ReceivedCalls {
+	LocalVector<int> last_sequence;
+	uint32_t count = 0;
+	uint32_t out_of_order = 0;
+
+	void reset(uint32_t p_producers) {
+		last_sequence.resize(p_producers);
+		for (int &sequence : last_sequence) {
+			sequence = -1;
+		}
+		count = 0;
+		out_of_order = 0;
+	}
+};
+
+static ReceivedCalls received;
+static CallQueue *reentrant_queue = nullptr;
+
+static void _record_call(int p_producer, int p_sequence) {
+	if (p_sequence <= received.last_sequence[p_producer]) {
+		received.out_of_order++;
+	}
+	received.last_sequence[p_producer] = p_sequence;
+	received.count++;
+}
+
+static void _push_again(int p_remaining) {
+	received.count++;
+	if (p_remaining > 0) {
+		reentrant_queue->push_callable(callable_mp_static(&_push_again), p_remaining - 1);
+	}
+}
+
+TEST_CASE("[MessageQueue] Calls are flushed in push order") {
+	for (int multi_producer = 0; multi_producer < 2; multi_producer++) {
+		CallQueue queue(nullptr, 8192, String(), multi_producer);
+		CHECK(queue.is_multi_producer() == bool(multi_producer));
+		CHECK_FALSE(queue.has_messages());
+
+		received.reset(1);
+		// Enough calls to span several pages.
+		for (int i = 0; i < 1000; i++) {
+			queue.push_callable(callable_mp_static(&_record_call), 0, i);
+		}
+		CHECK(queue.has_messages());
+		CHECK(queue.flush() == OK);
+		CHECK_FALSE(queue.has_messages());
+
+		CHECK(received.count == 1000);
+		CHECK(received.out_of_order == 0);
+		CHECK(received.last_sequence[0] == 999);
+
+		const CallQueue::Statistics statistics = queue.get_statistics();
+		CHECK(statistics.pushed_messages == 1000);
+		CHECK(statistics.flushed_messages == 1000);
+		CHECK(statistics.pushed_bytes > 1000 * sizeof(Variant) * 2);
+	}
+}
+
+TEST_CASE("[MessageQueue] Calls pushed while flushing are processed in the same flush") {
+	for (int multi_producer = 0; multi_producer < 2; multi_producer++) {
+		CallQueue queue(nullptr, 8192, String(), multi_producer);
+		reentrant_queue = &queue;
+
+		received.reset(0);
+		queue.push_callable(callable_mp_static(&_push_again), 499);
+		CHECK(queue.flush() == OK);
+
+		CHECK(received.count == 500);
+		CHECK_FALSE(queue.has_messages());
+		reentrant_queue = nullptr;
+	}
+}
+
+TEST_CASE("[MessageQueue] Cleared messages are not flushed") {
+	for (int multi_producer = 0; multi_producer < 2; multi_producer++) {
+		CallQueue queue(nullptr, 8192, String(), multi_producer);
+
+		received.reset(1);
+		for (int i = 0; i < 100; i++) {
+			queue.push_callable(callable_mp_static(&_record_call), 0, i);
+		}
+		queue.clear();
+		CHECK_FALSE(queue.has_messages());
+		CHECK(queue.flush() == OK);
+		CHECK(received.count == 0);
+	}
+}
+
+TEST_CASE("[MessageQueue] Frame statistics") {
+	CallQueue queue(nullptr, 8192, String(), true);
+
+	received.reset(1);
+	for (int i = 0; i < 10; i++) {
+		queue.push_callable(callable_mp_static(&_record_call), 0, i);
+	}
+	queue.update_frame_statistics();
+	CHECK(queue.get_frame_statistics().pushed_messages == 10);
+	CHECK(queue.get_frame_statistics().flushed_messages == 0);
+
+	queue.flush();
+	queue.update_frame_statistics();
+	CHECK(queue.get_frame_statistics().pushed_messages == 0);
+	CHECK(queue.get_frame_statistics().pushed_bytes == 0);
+	CHECK(queue.get_frame_statistics().flushed_messages == 10);
+}
+
+struct PushData {
+	CallQueue *queue = nullptr;
+	uint32_t calls_per_producer = 0;
+
+	void push(uint32_t p_index, void *p_userdata) {
+		for (uint32_t i = 0; i < calls_per_producer; i++) {
+			queue->push_callable(callable_mp_static(&_record_call), int(p_index), int(i));
+		}
+	}
+};
+
+static void _push_from_thread(void *p_userdata) {
+	static_cast<PushData *>(p_userdata)->push(0, nullptr);
+}
+
+TEST_CASE("[MessageQueue] Producers of exited threads are released once flushed") {
+	CallQueue queue(nullptr, 8192, String(), true);
+	PushData data;
+	data.queue = &queue;
+	data.calls_per_producer = 100;
+
+	received.reset(1);
+	for (int i = 0; i < 10; i++) {
+		Thread thread;
+		thread.start(&_push_from_thread, &data);
+		thread.wait_to_finish();
+	}
+	CHECK(queue.has_messages());
+	CHECK(queue.get_max_buffer_usage() > 0);
+
+	CHECK(queue.flush() == OK);
+	CHECK(received.count == 10 * data.calls_per_producer);
+	CHECK_FALSE(queue.has_messages());
+	// Their pages were given back, but their statistics are kept.
+	CHECK(queue.get_max_buffer_usage() == 0);
+	CHECK(queue.get_statistics().pushed_messages == 10 * data.calls_per_producer);
+}
+
+static uint64_t run_producers(WorkerThreadPool *p_pool, PushData &p_data, uint32_t p_producers, bool p_flush_while_pushing) {
+	const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	WorkerThreadPool::GroupID group = p_pool->add_template_group_task(&p_data, &PushData::push, (void *)nullptr, p_producers, p_producers, true);
+	if (p_flush_while_pushing) {
+		while (!p_pool->is_group_task_completed(group)) {
+			p_data.queue->flush();
+		}
+	}
+	p_pool->wait_for_group_task_completion(group);
+	const uint64_t usec = OS::get_singleton()->get_ticks_usec() - begin;
+	p_data.queue->flush();
+	return usec;
+}
+
+TEST_CASE("[MessageQueue] Concurrent producers keep their own order") {
+	WorkerThreadPool *pool = memnew(WorkerThreadPool(false));
+	pool->init(MAX(4, OS::get_singleton()->get_processor_count()));
+	const uint32_t producers = 8;
+
+	for (int multi_producer = 0; multi_producer < 2; multi_producer++) {
+		CallQueue queue(nullptr, 8192, String(), multi_producer);
+		PushData data;
+		data.queue = &queue;
+		data.calls_per_producer = 5000;
+
+		received.reset(producers);
+		run_producers(pool, data, producers, true);
+
+		CHECK(received.count == producers * data.calls_per_producer);
+		CHECK(received.out_of_order == 0);
+		CHECK_FALSE(queue.has_messages());
+		CHECK(queue.get_statistics().flushed_messages == producers * data.calls_per_producer);
+	}
+
+	memdelete(pool);
+}
+
+TEST_CASE_BENCHMARK("[Benchmark][MessageQueue] Concurrent push throughput, shared vs. multi-producer") {
+	const int max_threads = OS::get_singleton()->get_processor_count();
+
+	for (int thread_count = 1; thread_count <= max_threads; thread_count *= 2) {
+		WorkerThreadPool *pool = memnew(WorkerThreadPool(false));
+		pool->init(thread_count);
+
+		for (int multi_producer = 0; multi_producer < 2; multi_producer++) {
+			CallQueue queue(nullptr, 65536, String(), multi_producer);
+			PushData data;
+			data.queue = &queue;
+			data.calls_per_producer = 20000;
+
+			received.reset(thread_count);
+			const uint64_t usec = run_producers(pool, data, thread_count, false);
+			CHECK(received.count == thread_count * data.calls_per_producer);
+
+			const double pushes_per_sec = double(thread_count) * data.calls_per_producer / MAX(usec / 1000000.0, 0.000001);
+			print_line(vformat("%2d threads, %-14s: %.3f ms, %.0f pushes/s", thread_count, multi_producer ? "multi-producer" : "shared", usec / 1000.0, pushes_per_sec));
+		}
+
+		memdelete(pool);
+	}
+}
+
+} // namespace TestMessageQueue
@@ -36,6 +36,7 @@ TEST_FORCE_LINK(test_object)
 #include "core/object/class_db.h"
 #include "core/object/object.h"
 #include "core/object/script_language.h"
+#include "core/os/os.h"
 #include "tests/signal_watcher.h"
 
 namespace TestObject {
@@ -57,6 +58,16 @@ public:
 	int get_property() const { return property_value; }
 };
 
+class _TestShadowingObject : public _TestDerivedObject {
+	GDCLASS(_TestShadowingObject, _TestDerivedObject);
+
+protected:
+	static void _bind_methods() {
+		// Shadows the inherited property when getting, but not when setting.
+		ClassDB::bind_integer_constant(get_class_static(), StringName(), "property", 42);
+	}
+};
+
 class _MockScriptInstance : public ScriptInstance {
 	StringName property_name = "NO_NAME";
 	Variant property_value;
@@ -261,6 +272,89 @@ TEST_CASE("[Object] Built-in property getter") {
 			"The returned value should equal the one which was set with built-in setter.");
 }
 
+TEST_CASE("[Object] Built-in property access with a property cache") {
+	GDREGISTER_CLASS(_TestDerivedObject);
+	GDREGISTER_CLASS(_TestShadowingObject);
+	_TestDerivedObject derived_object;
+	_TestShadowingObject shadowing_object;
+
+	ClassDB::PropertyCache set_cache;
+	ClassDB::PropertyCache get_cache;
+	bool valid = false;
+
+	SUBCASE("Repeated accesses to the same class") {
+		for (int i = 0; i < 3; i++) {
+			derived_object.set("property", i, set_cache, &valid);
+			CHECK(valid);
+			CHECK(derived_object.get_property() == i);
+			CHECK(derived_object.get("property", get_cache, &valid) == Variant(i));
+			CHECK(valid);
+		}
+	}
+
+	SUBCASE("Accesses to different classes with the same cache") {
+		derived_object.set("property", 1, set_cache, &valid);
+		CHECK(valid);
+		shadowing_object.set("property", 2, set_cache, &valid);
+		CHECK(valid);
+		CHECK(derived_object.get_property() == 1);
+		CHECK(shadowing_object.get_property() == 2);
+
+		CHECK(derived_object.get("property", get_cache) == Variant(1));
+		CHECK_MESSAGE(
+				shadowing_object.get("property", get_cache) == Variant(42),
+				"The constant should shadow the inherited property when getting.");
+		CHECK(derived_object.get("property", get_cache) == Variant(1));
+	}
+
+	SUBCASE("Methods and missing members") {
+		const Variant method = derived_object.get("get_property", get_cache, &valid);
+		CHECK(valid);
+		CHECK(method == Variant(Callable(&derived_object, "get_property")));
+
+		derived_object.get("missing_property", get_cache, &valid);
+		CHECK_FALSE(valid);
+		derived_object.set("missing_property", 1, set_cache, &valid);
+		CHECK_FALSE(valid);
+	}
+
+	SUBCASE("Members added after the lookup was cached") {
+		shadowing_object.get("late_constant", get_cache, &valid);
+		CHECK_FALSE(valid);
+
+		ClassDB::bind_integer_constant(_TestShadowingObject::get_class_static(), StringName(), "late_constant", 7);
+		CHECK(shadowing_object.get("late_constant", get_cache, &valid) == Variant(7));
+		CHECK(valid);
+		CHECK(shadowing_object.get("late_constant", get_cache, &valid) == Variant(7));
+		CHECK(valid);
+	}
+}
+
+TEST_CASE_BENCHMARK("[Benchmark][Object] Built-in property access") {
+	GDREGISTER_CLASS(_TestDerivedObject);
+	GDREGISTER_CLASS(_TestShadowingObject);
+	_TestShadowingObject object;
+	const StringName property = "property";
+	const int iterations = 1000000;
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < iterations; i++) {
+		object.set(property, i);
+	}
+	uint64_t usec = OS::get_singleton()->get_ticks_usec() - begin;
+	print_line(vformat("set(): %.3f ms, %.0f sets/s", usec / 1000.0, iterations / MAX(usec / 1000000.0, 0.000001)));
+
+	ClassDB::PropertyCache cache;
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < iterations; i++) {
+		object.set(property, i, cache);
+	}
+	usec = OS::get_singleton()->get_ticks_usec() - begin;
+	print_line(vformat("set() with cache: %.3f ms, %.0f sets/s", usec / 1000.0, iterations / MAX(usec / 1000000.0, 0.000001)));
+
+	CHECK(object.get_property() == iterations - 1);
+}
+
 TEST_CASE("[Object] Script property setter") {
 	Object object;
 	Variant script;
@@ -514,6 +608,133 @@ TEST_CASE("[Object] Signals") {
 	}
 }
 
+class SignalCounter : public Object {
+	GDCLASS(SignalCounter, Object);
+
+public:
+	int calls = 0;
+	Object *emitter = nullptr;
+	Callable to_connect;
+	Callable to_disconnect;
+	Object *to_delete = nullptr;
+
+	void count(int p_value) {
+		calls++;
+	}
+
+	void count_and_modify(int p_value) {
+		calls++;
+		if (to_connect.is_valid() && !emitter->is_connected("my_custom_signal", to_connect)) {
+			emitter->connect("my_custom_signal", to_connect);
+		}
+		if (to_disconnect.is_valid() && emitter->is_connected("my_custom_signal", to_disconnect)) {
+			emitter->disconnect("my_custom_signal", to_disconnect);
+		}
+		if (to_delete) {
+			memdelete(to_delete);
+			to_delete = nullptr;
+		}
+	}
+};
+
+TEST_CASE("[Object] Connections changed during emission") {
+	Object object;
+	object.add_user_signal(MethodInfo("my_custom_signal", PropertyInfo(Variant::INT, "value")));
+
+	SignalCounter modifier;
+	SignalCounter other;
+	modifier.emitter = &object;
+
+	SUBCASE("Connections removed while emitting are still called by that emission") {
+		modifier.to_disconnect = callable_mp(&other, &SignalCounter::count);
+		object.connect("my_custom_signal", callable_mp(&modifier, &SignalCounter::count_and_modify));
+		object.connect("my_custom_signal", callable_mp(&other, &SignalCounter::count));
+
+		object.emit_signal("my_custom_signal", 1);
+		CHECK(modifier.calls == 1);
+		CHECK(other.calls == 1);
+		CHECK_FALSE(object.is_connected("my_custom_signal", callable_mp(&other, &SignalCounter::count)));
+
+		object.emit_signal("my_custom_signal", 2);
+		CHECK(modifier.calls == 2);
+		CHECK(other.calls == 1);
+	}
+
+	SUBCASE("Connections added while emitting are only called by later emissions") {
+		modifier.to_connect = callable_mp(&other, &SignalCounter::count);
+		object.connect("my_custom_signal", callable_mp(&modifier, &SignalCounter::count_and_modify));
+
+		object.emit_signal("my_custom_signal", 1);
+		CHECK(modifier.calls == 1);
+		CHECK(other.calls == 0);
+
+		object.emit_signal("my_custom_signal", 2);
+		CHECK(modifier.calls == 2);
+		CHECK(other.calls == 1);
+	}
+
+	SUBCASE("One-shot connections are called once") {
+		object.connect("my_custom_signal", callable_mp(&other, &SignalCounter::count), Object::CONNECT_ONE_SHOT);
+		object.connect("my_custom_signal", callable_mp(&modifier, &SignalCounter::count));
+
+		object.emit_signal("my_custom_signal", 1);
+		object.emit_signal("my_custom_signal", 2);
+		CHECK(other.calls == 1);
+		CHECK(modifier.calls == 2);
+	}
+
+	SUBCASE("Deleting a target while emitting skips it") {
+		SignalCounter *deleted = memnew(SignalCounter);
+		modifier.to_delete = deleted;
+		object.connect("my_custom_signal", callable_mp(&modifier, &SignalCounter::count_and_modify));
+		object.connect("my_custom_signal", callable_mp(deleted, &SignalCounter::count));
+		object.connect("my_custom_signal", callable_mp(&other, &SignalCounter::count));
+
+		ERR_PRINT_OFF;
+		object.emit_signal("my_custom_signal", 1);
+		ERR_PRINT_ON;
+		CHECK(modifier.calls == 1);
+		CHECK(other.calls == 1);
+
+		List<Object::Connection> signal_connections;
+		object.get_signal_connection_list("my_custom_signal", &signal_connections);
+		CHECK(signal_connections.size() == 2);
+
+		object.emit_signal("my_custom_signal", 2);
+		CHECK(modifier.calls == 2);
+		CHECK(other.calls == 2);
+	}
+}
+
+TEST_CASE_BENCHMARK("[Benchmark][Object] Signal emission by connection count") {
+	const int emits = 100000;
+	const int connection_counts[] = { 0, 1, 10, 100 };
+
+	for (int connection_count : connection_counts) {
+		Object object;
+		object.add_user_signal(MethodInfo("my_custom_signal", PropertyInfo(Variant::INT, "value")));
+
+		LocalVector<SignalCounter> receivers;
+		receivers.resize(connection_count);
+		for (SignalCounter &receiver : receivers) {
+			object.connect("my_custom_signal", callable_mp(&receiver, &SignalCounter::count));
+		}
+
+		const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < emits; i++) {
+			object.emit_signal("my_custom_signal", i);
+		}
+		const uint64_t usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+		for (const SignalCounter &receiver : receivers) {
+			CHECK(receiver.calls == emits);
+		}
+
+		const double emits_per_sec = emits / MAX(usec / 1000000.0, 0.000001);
+		print_line(vformat("%3d connections: %.3f ms, %.0f emits/s, %.0f calls/s", connection_count, usec / 1000.0, emits_per_sec, emits_per_sec * connection_count));
+	}
+}
+
 class NotificationObjectSuperclass : public Object {
 	GDCLASS(NotificationObjectSuperclass, Object);
 
@@ -0,0 +1,200 @@
+/**************************************************************************/
+/*  test_frame_arena.cpp                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "tests/test_macros.h"
+
+TEST_FORCE_LINK(test_frame_arena)
+
+#include "core/os/memory.h"
+#include "core/os/os.h"
+#include "core/string/print_string.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/list.h"
+#include "core/templates/local_vector.h"
+
+namespace TestFrameArena {
+
+TEST_CASE("[FrameArena] Allocations") {
+	FrameArena::next_frame();
+
+	uint8_t *a = (uint8_t *)FrameArena::alloc(10);
+	uint8_t *b = (uint8_t *)FrameArena::alloc(100);
+	REQUIRE(a != nullptr);
+	REQUIRE(b != nullptr);
+	CHECK(a != b);
+	CHECK((uintptr_t)a % Memory::MAX_ALIGN == 0);
+	CHECK((uintptr_t)b % Memory::MAX_ALIGN == 0);
+
+	memset(a, 0xAA, 10);
+	memset(b, 0xBB, 100);
+	CHECK(a[9] == 0xAA);
+	CHECK(b[0] == 0xBB);
+
+	// Larger than a block.
+	uint8_t *large = (uint8_t *)FrameArena::alloc(1024 * 1024);
+	REQUIRE(large != nullptr);
+	memset(large, 0xCC, 1024 * 1024);
+	CHECK(large[1024 * 1024 - 1] == 0xCC);
+	CHECK(a[0] == 0xAA);
+	CHECK(b[99] == 0xBB);
+}
+
+TEST_CASE("[FrameArena] Reallocating and freeing the latest allocation") {
+	FrameArena::next_frame();
+
+	uint8_t *a = (uint8_t *)FrameArena::alloc(16);
+	memset(a, 1, 16);
+	uint8_t *grown = (uint8_t *)FrameArena::realloc(a, 256);
+	CHECK_MESSAGE(grown == a, "The latest allocation should grow in place.");
+	CHECK(grown[15] == 1);
+
+	uint8_t *b = (uint8_t *)FrameArena::alloc(16);
+	memset(b, 2, 16);
+	uint8_t *moved = (uint8_t *)FrameArena::realloc(a, 512);
+	CHECK_MESSAGE(moved != a, "Older allocations should be moved when grown.");
+	CHECK(moved[0] == 1);
+	CHECK(moved[15] == 1);
+	CHECK(b[15] == 2);
+
+	uint8_t *shrunk = (uint8_t *)FrameArena::realloc(b, 8);
+	CHECK_MESSAGE(shrunk == b, "Shrinking should never move an allocation.");
+
+	void *c = FrameArena::alloc(64);
+	FrameArena::free(c);
+	void *d = FrameArena::alloc(64);
+	CHECK_MESSAGE(c == d, "Freeing the latest allocation should give its memory back.");
+
+	// Freeing anything else is a no-op.
+	FrameArena::free(b);
+	FrameArena::free(nullptr);
+}
+
+TEST_CASE("[FrameArena] Memory stays valid during the next frame") {
+	FrameArena::next_frame();
+
+	uint32_t *values = (uint32_t *)FrameArena::alloc(sizeof(uint32_t) * 1000);
+	for (uint32_t i = 0; i < 1000; i++) {
+		values[i] = i;
+	}
+
+	FrameArena::next_frame();
+
+	// Enough to need new blocks in the current frame.
+	for (int i = 0; i < 16; i++) {
+		memset(FrameArena::alloc(32 * 1024), 0xFF, 32 * 1024);
+	}
+
+	bool intact = true;
+	for (uint32_t i = 0; i < 1000; i++) {
+		intact = intact && values[i] == i;
+	}
+	CHECK(intact);
+
+	// Growing memory from the previous frame must not reuse it in place.
+	uint32_t *grown = (uint32_t *)FrameArena::realloc(values, sizeof(uint32_t) * 2000);
+	CHECK(grown != values);
+	CHECK(grown[999] == 999);
+}
+
+TEST_CASE("[FrameArena] Containers") {
+	FrameArena::next_frame();
+
+	FrameLocalVector<int> vector;
+	for (int i = 0; i < 10000; i++) {
+		vector.push_back(i);
+	}
+	REQUIRE(vector.size() == 10000);
+	CHECK(vector[0] == 0);
+	CHECK(vector[9999] == 9999);
+	vector.erase(5);
+	CHECK(vector.size() == 9999);
+	CHECK(vector[5] == 6);
+
+	FrameHashMap<int, int> map;
+	for (int i = 0; i < 1000; i++) {
+		map.insert(i, i * 2);
+	}
+	CHECK(map.size() == 1000);
+	CHECK(map[500] == 1000);
+	map.erase(500);
+	CHECK_FALSE(map.has(500));
+	CHECK(map.has(999));
+
+	List<int, FrameArena> list;
+	for (int i = 0; i < 100; i++) {
+		list.push_back(i);
+	}
+	CHECK(list.size() == 100);
+	CHECK(list.front()->get() == 0);
+	CHECK(list.back()->get() == 99);
+	list.erase(50);
+	CHECK(list.size() == 99);
+}
+
+TEST_CASE("[FrameArena] Statistics") {
+	FrameArena::next_frame();
+	FrameArena::alloc(1000);
+	FrameArena::next_frame();
+
+	CHECK(FrameArena::get_frame_bytes() >= 1000);
+	CHECK(FrameArena::get_peak_frame_bytes() >= FrameArena::get_frame_bytes());
+}
+
+TEST_CASE_BENCHMARK("[Benchmark][FrameArena] Temporary vectors") {
+	const int frames = 100;
+	const int vectors_per_frame = 1000;
+
+	uint64_t start = OS::get_singleton()->get_ticks_usec();
+	for (int frame = 0; frame < frames; frame++) {
+		for (int i = 0; i < vectors_per_frame; i++) {
+			LocalVector<int> vector;
+			for (int j = 0; j < 32; j++) {
+				vector.push_back(j);
+			}
+		}
+	}
+	const uint64_t heap_usec = OS::get_singleton()->get_ticks_usec() - start;
+
+	start = OS::get_singleton()->get_ticks_usec();
+	for (int frame = 0; frame < frames; frame++) {
+		for (int i = 0; i < vectors_per_frame; i++) {
+			FrameLocalVector<int> vector;
+			for (int j = 0; j < 32; j++) {
+				vector.push_back(j);
+			}
+		}
+		FrameArena::next_frame();
+	}
+	const uint64_t arena_usec = OS::get_singleton()->get_ticks_usec() - start;
+
+	print_line(vformat("%d frames of %d temporary vectors: heap %d usec, frame arena %d usec.", frames, vectors_per_frame, heap_usec, arena_usec));
+}
+
+} // namespace TestFrameArena
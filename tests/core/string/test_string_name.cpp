@@ -0,0 +1,174 @@
+/**************************************************************************/
+/*  test_string_name.cpp                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "tests/test_macros.h"
+
+TEST_FORCE_LINK(test_string_name)
+
+#include "core/object/worker_thread_pool.h"
+#include "core/os/os.h"
+#include "core/string/string_name.h"
+
+namespace TestStringName {
+
+TEST_CASE("[StringName] Interning") {
+	const StringName a = StringName("test_string_name_interning");
+	const StringName b = StringName(String("test_string_name_interning"));
+	const StringName c = StringName("test_string_name_interning_other");
+
+	CHECK(a == b);
+	CHECK(a.data_unique_pointer() == b.data_unique_pointer());
+	CHECK(a != c);
+	CHECK(a == "test_string_name_interning");
+	CHECK(a.hash() == String("test_string_name_interning").hash());
+
+	CHECK(StringName("").is_empty());
+	CHECK(StringName(String()).is_empty());
+	CHECK(StringName().hash() == String().hash());
+}
+
+TEST_CASE("[StringName] Released names can be interned again") {
+	const String name = "test_string_name_released";
+	{
+		StringName a = StringName(name);
+		CHECK(a == name);
+	}
+	StringName b = StringName(name);
+	CHECK(b == name);
+	CHECK(b.length() == name.length());
+
+	StringName c = b;
+	b = StringName();
+	CHECK(c == name);
+	CHECK(c.data_unique_pointer() == StringName(name).data_unique_pointer());
+}
+
+struct InternData {
+	Vector<String> names;
+	uint32_t iterations = 0;
+	bool keep = false;
+	// One slot per (task, name), filled with the interned pointers when keep is set.
+	Vector<const void *> pointers;
+	SafeNumeric<uint32_t> mismatches;
+
+	void intern(uint32_t p_index, void *p_userdata) {
+		const int count = names.size();
+		const void **out = keep ? pointers.ptrw() + p_index * count : nullptr;
+		for (uint32_t i = 0; i < iterations; i++) {
+			// Each task walks the names from a different offset so threads keep colliding on different entries.
+			for (int j = 0; j < count; j++) {
+				const int k = (j + p_index * 7) % count;
+				StringName sn = StringName(names[k]);
+				if (unlikely(sn != names[k])) {
+					mismatches.increment();
+				}
+				if (out) {
+					out[k] = sn.data_unique_pointer();
+				}
+			}
+		}
+	}
+};
+
+static uint64_t run_intern_tasks(WorkerThreadPool *p_pool, InternData &p_data, uint32_t p_tasks) {
+	const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	WorkerThreadPool::GroupID group = p_pool->add_template_group_task(&p_data, &InternData::intern, (void *)nullptr, p_tasks, p_tasks, true);
+	p_pool->wait_for_group_task_completion(group);
+	return OS::get_singleton()->get_ticks_usec() - begin;
+}
+
+TEST_CASE("[StringName] Concurrent interning and releasing") {
+	WorkerThreadPool *pool = memnew(WorkerThreadPool(false));
+	pool->init(MAX(4, OS::get_singleton()->get_processor_count()));
+	const uint32_t tasks = 16;
+
+	InternData data;
+	for (int i = 0; i < 256; i++) {
+		data.names.push_back(vformat("test_string_name_concurrent_%d", i));
+	}
+
+	SUBCASE("Names are created and released concurrently") {
+		// None of the names outlive a single iteration, so the entries are constantly freed and recycled.
+		data.iterations = 200;
+		run_intern_tasks(pool, data, tasks);
+		CHECK(data.mismatches.get() == 0);
+	}
+
+	SUBCASE("All threads get the same entry") {
+		Vector<StringName> held;
+		for (int i = 0; i < data.names.size(); i += 2) {
+			held.push_back(StringName(data.names[i]));
+		}
+
+		data.iterations = 20;
+		data.keep = true;
+		data.pointers.resize(tasks * data.names.size());
+		run_intern_tasks(pool, data, tasks);
+		CHECK(data.mismatches.get() == 0);
+
+		// Names held across the whole run must have been resolved to the same entry by every task.
+		for (int i = 0; i < held.size(); i++) {
+			const int k = i * 2;
+			for (uint32_t t = 0; t < tasks; t++) {
+				CHECK(data.pointers[t * data.names.size() + k] == held[i].data_unique_pointer());
+			}
+		}
+	}
+
+	memdelete(pool);
+}
+
+TEST_CASE_BENCHMARK("[Benchmark][StringName] Interning throughput by thread count") {
+	const int max_threads = OS::get_singleton()->get_processor_count();
+
+	InternData data;
+	// Roughly the mix seen during threaded resource loads: property, method and class names that mostly already exist.
+	Vector<StringName> held;
+	for (int i = 0; i < 4096; i++) {
+		data.names.push_back(vformat("benchmark_string_name_%d", i));
+		held.push_back(StringName(data.names[i]));
+	}
+	data.iterations = 50;
+
+	for (int thread_count = 1; thread_count <= max_threads; thread_count *= 2) {
+		WorkerThreadPool *pool = memnew(WorkerThreadPool(false));
+		pool->init(thread_count);
+
+		uint64_t usec = run_intern_tasks(pool, data, thread_count);
+		CHECK(data.mismatches.get() == 0);
+
+		const double lookups = double(data.names.size()) * data.iterations * thread_count;
+		print_line(vformat("%2d threads: %.3f ms, %.2f M lookups/s", thread_count, usec / 1000.0, lookups / MAX(usec, uint64_t(1))));
+
+		memdelete(pool);
+	}
+}
+
+} // namespace TestStringName
@@ -32,6 +32,7 @@
 
 TEST_FORCE_LINK(test_rid)
 
+#include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
 #include "core/os/thread.h"
 #include "core/templates/local_vector.h"
@@ -243,4 +244,55 @@ TEST_CASE("[RID_Owner] Thread safety") {
 }
 #endif // THREADS_ENABLED
 
+TEST_CASE_BENCHMARK("[Benchmark][RID_Owner] Concurrent lookups by thread count") {
+	struct LookupData {
+		RID_Owner<uint64_t, true> rid_owner;
+		LocalVector<RID> rids;
+		uint32_t lookups_per_task = 1 << 20;
+		SafeNumeric<uint64_t> misses;
+
+		void lookup(uint32_t p_index, void *p_userdata) {
+			uint64_t local_misses = 0;
+			uint32_t rid_index = p_index * 7919;
+			for (uint32_t i = 0; i < lookups_per_task; i++) {
+				const RID &rid = rids[rid_index++ % rids.size()];
+				if (!rid_owner.owns(rid) || !rid_owner.get_or_null(rid)) {
+					local_misses++;
+				}
+				// Keep a writer busy, like a server creating and freeing resources while others look them up.
+				if (p_index == 0 && (i & 63) == 0) {
+					rid_owner.free(rid_owner.make_rid(i));
+				}
+			}
+			misses.add(local_misses);
+		}
+	};
+
+	LookupData data;
+	for (uint64_t i = 0; i < 4096; i++) {
+		data.rids.push_back(data.rid_owner.make_rid(i));
+	}
+
+	for (uint32_t thread_count = 1; thread_count <= 64; thread_count *= 2) {
+		WorkerThreadPool *pool = memnew(WorkerThreadPool(false));
+		pool->init(thread_count);
+
+		const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		WorkerThreadPool::GroupID group = pool->add_template_group_task(&data, &LookupData::lookup, (void *)nullptr, thread_count, thread_count, true);
+		pool->wait_for_group_task_completion(group);
+		const uint64_t usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+		CHECK(data.misses.get() == 0);
+
+		const double lookups = double(data.lookups_per_task) * thread_count;
+		print_line(vformat("%2d threads: %.3f ms, %.2f M lookups/s", thread_count, usec / 1000.0, lookups / MAX(usec, uint64_t(1))));
+
+		memdelete(pool);
+	}
+
+	for (const RID &rid : data.rids) {
+		data.rid_owner.free(rid);
+	}
+}
+
 } // namespace TestRID
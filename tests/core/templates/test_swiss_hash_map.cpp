@@ -0,0 +1,462 @@
+/**************************************************************************/
+/*  test_swiss_hash_map.cpp                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "tests/test_macros.h"
+
+TEST_FORCE_LINK(test_swiss_hash_map)
+
+#include "core/os/os.h"
+#include "core/templates/a_hash_map.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/rb_map.h"
+#include "core/templates/rid.h"
+#include "core/templates/swiss_hash_map.h"
+
+namespace TestSwissHashMap {
+
+TEST_CASE("[SwissHashMap] List initialization") {
+	SwissHashMap<int, String> map{ { 0, "A" }, { 1, "B" }, { 2, "C" }, { 3, "D" }, { 4, "E" } };
+
+	CHECK(map.size() == 5);
+	CHECK(map[0] == "A");
+	CHECK(map[1] == "B");
+	CHECK(map[2] == "C");
+	CHECK(map[3] == "D");
+	CHECK(map[4] == "E");
+}
+
+TEST_CASE("[SwissHashMap] List initialization with existing elements") {
+	SwissHashMap<int, String> map{ { 0, "A" }, { 0, "B" }, { 0, "C" }, { 0, "D" }, { 0, "E" } };
+
+	CHECK(map.size() == 1);
+	CHECK(map[0] == "E");
+}
+
+TEST_CASE("[SwissHashMap] Insert element") {
+	SwissHashMap<int, int> map;
+	SwissHashMap<int, int>::Iterator e = map.insert(42, 84);
+
+	CHECK(e);
+	CHECK(e->key == 42);
+	CHECK(e->value == 84);
+	CHECK(map[42] == 84);
+	CHECK(map.has(42));
+	CHECK(map.find(42));
+}
+
+TEST_CASE("[SwissHashMap] Overwrite element") {
+	SwissHashMap<int, int> map;
+	map.insert(42, 84);
+	map.insert(42, 1234);
+
+	CHECK(map[42] == 1234);
+}
+
+TEST_CASE("[SwissHashMap] Erase via element") {
+	SwissHashMap<int, int> map;
+	SwissHashMap<int, int>::Iterator e = map.insert(42, 84);
+	map.remove(e);
+	CHECK(!map.has(42));
+	CHECK(!map.find(42));
+}
+
+TEST_CASE("[SwissHashMap] Erase via key") {
+	SwissHashMap<int, int> map;
+	map.insert(42, 84);
+	map.erase(42);
+	CHECK(!map.has(42));
+	CHECK(!map.find(42));
+}
+
+TEST_CASE("[SwissHashMap] Size") {
+	SwissHashMap<int, int> map;
+	map.insert(42, 84);
+	map.insert(123, 84);
+	map.insert(123, 84);
+	map.insert(0, 84);
+	map.insert(123485, 84);
+
+	CHECK(map.size() == 4);
+}
+
+TEST_CASE("[SwissHashMap] Iteration") {
+	SwissHashMap<int, int> map;
+
+	map.insert(42, 84);
+	map.insert(123, 12385);
+	map.insert(0, 12934);
+	map.insert(123485, 1238888);
+	map.insert(123, 111111);
+
+	Vector<Pair<int, int>> expected;
+	expected.push_back(Pair<int, int>(42, 84));
+	expected.push_back(Pair<int, int>(123, 111111));
+	expected.push_back(Pair<int, int>(0, 12934));
+	expected.push_back(Pair<int, int>(123485, 1238888));
+
+	int idx = 0;
+	for (const KeyValue<int, int> &E : map) {
+		CHECK(expected[idx] == Pair<int, int>(E.key, E.value));
+		idx++;
+	}
+
+	idx--;
+	for (SwissHashMap<int, int>::Iterator it = map.last(); it; --it) {
+		CHECK(expected[idx] == Pair<int, int>(it->key, it->value));
+		idx--;
+	}
+}
+
+TEST_CASE("[SwissHashMap] Const iteration") {
+	SwissHashMap<int, int> map;
+	map.insert(42, 84);
+	map.insert(123, 12385);
+	map.insert(0, 12934);
+	map.insert(123485, 1238888);
+	map.insert(123, 111111);
+
+	const SwissHashMap<int, int> const_map(map);
+
+	Vector<Pair<int, int>> expected;
+	expected.push_back(Pair<int, int>(42, 84));
+	expected.push_back(Pair<int, int>(123, 111111));
+	expected.push_back(Pair<int, int>(0, 12934));
+	expected.push_back(Pair<int, int>(123485, 1238888));
+	expected.push_back(Pair<int, int>(123, 111111));
+
+	int idx = 0;
+	for (const KeyValue<int, int> &E : const_map) {
+		CHECK(expected[idx] == Pair<int, int>(E.key, E.value));
+		idx++;
+	}
+
+	idx--;
+	for (SwissHashMap<int, int>::ConstIterator it = const_map.last(); it; --it) {
+		CHECK(expected[idx] == Pair<int, int>(it->key, it->value));
+		idx--;
+	}
+}
+
+TEST_CASE("[SwissHashMap] Replace key") {
+	SwissHashMap<int, int> map;
+	map.insert(42, 84);
+	map.insert(0, 12934);
+	CHECK(map.replace_key(0, 1));
+	CHECK(map.has(1));
+	CHECK(map[1] == 12934);
+}
+
+TEST_CASE("[SwissHashMap] Clear") {
+	SwissHashMap<int, int> map;
+	map.insert(42, 84);
+	map.insert(123, 12385);
+	map.insert(0, 12934);
+
+	map.clear();
+	CHECK(!map.has(42));
+	CHECK(map.size() == 0);
+	CHECK(map.is_empty());
+}
+
+TEST_CASE("[SwissHashMap] Get") {
+	SwissHashMap<int, int> map;
+	map.insert(42, 84);
+	map.insert(123, 12385);
+	map.insert(0, 12934);
+
+	CHECK(map.get(123) == 12385);
+	map.get(123) = 10;
+	CHECK(map.get(123) == 10);
+
+	CHECK(*map.getptr(0) == 12934);
+	*map.getptr(0) = 1;
+	CHECK(*map.getptr(0) == 1);
+
+	CHECK(map.get(42) == 84);
+	CHECK(map.getptr(-10) == nullptr);
+}
+
+TEST_CASE("[SwissHashMap] Insert, iterate and remove many elements") {
+	const int elem_max = 1234;
+	SwissHashMap<int, int> map;
+	for (int i = 0; i < elem_max; i++) {
+		map.insert(i, i);
+	}
+
+	//insert order should have been kept
+	int idx = 0;
+	for (const KeyValue<int, int> &K : map) {
+		CHECK(idx == K.key);
+		CHECK(idx == K.value);
+		CHECK(map.has(idx));
+		idx++;
+	}
+
+	Vector<int> elems_still_valid;
+
+	for (int i = 0; i < elem_max; i++) {
+		if ((i % 5) == 0) {
+			map.erase(i);
+		} else {
+			elems_still_valid.push_back(i);
+		}
+	}
+
+	CHECK(elems_still_valid.size() == map.size());
+
+	for (int i = 0; i < elems_still_valid.size(); i++) {
+		CHECK(map.has(elems_still_valid[i]));
+	}
+}
+
+TEST_CASE("[SwissHashMap] Insert, iterate and remove many strings") {
+	const int elem_max = 432;
+	SwissHashMap<String, String> map;
+
+	// To not print WARNING: Excessive collision count (NN), is the right hash function being used?
+	ERR_PRINT_OFF;
+	for (int i = 0; i < elem_max; i++) {
+		map.insert(itos(i), itos(i));
+	}
+	ERR_PRINT_ON;
+
+	//insert order should have been kept
+	int idx = 0;
+	for (auto &K : map) {
+		CHECK(itos(idx) == K.key);
+		CHECK(itos(idx) == K.value);
+		CHECK(map.has(itos(idx)));
+		idx++;
+	}
+
+	Vector<String> elems_still_valid;
+
+	for (int i = 0; i < elem_max; i++) {
+		if ((i % 5) == 0) {
+			map.erase(itos(i));
+		} else {
+			elems_still_valid.push_back(itos(i));
+		}
+	}
+
+	CHECK(elems_still_valid.size() == map.size());
+
+	for (int i = 0; i < elems_still_valid.size(); i++) {
+		CHECK(map.has(elems_still_valid[i]));
+	}
+
+	elems_still_valid.clear();
+}
+
+TEST_CASE("[SwissHashMap] Copy constructor") {
+	SwissHashMap<int, int> map0;
+	const uint32_t count = 5;
+	for (uint32_t i = 0; i < count; i++) {
+		map0.insert(i, i);
+	}
+	SwissHashMap<int, int> map1(map0);
+	CHECK(map0.size() == map1.size());
+	CHECK(map0.get_capacity() == map1.get_capacity());
+	CHECK(*map0.getptr(0) == *map1.getptr(0));
+}
+
+TEST_CASE("[SwissHashMap] Operator =") {
+	SwissHashMap<int, int> map0;
+	SwissHashMap<int, int> map1;
+	const uint32_t count = 5;
+	map1.insert(1234, 1234);
+	for (uint32_t i = 0; i < count; i++) {
+		map0.insert(i, i);
+	}
+	map1 = map0;
+	CHECK(map0.size() == map1.size());
+	CHECK(map0.get_capacity() == map1.get_capacity());
+	CHECK(*map0.getptr(0) == *map1.getptr(0));
+}
+
+TEST_CASE("[SwissHashMap] Array methods") {
+	SwissHashMap<int, int> map;
+	for (int i = 0; i < 100; i++) {
+		map.insert(100 - i, i);
+	}
+	for (int i = 0; i < 100; i++) {
+		CHECK(map.get_by_index(i).value == i);
+	}
+	int index = map.get_index(1);
+	CHECK(map.get_by_index(index).value == 99);
+	CHECK(map.erase_by_index(index));
+	CHECK(!map.erase_by_index(index));
+	CHECK(map.get_index(1) == -1);
+}
+
+struct CollidingHasher {
+	// Only a few distinct hashes, and all of them share the same home group in small tables,
+	// so elements pile up across several groups.
+	static _FORCE_INLINE_ uint32_t hash(const int p_key) { return (uint32_t(p_key) % 7) << 7; }
+};
+
+TEST_CASE("[SwissHashMap] Erase keeps colliding elements reachable") {
+	SwissHashMap<int, int, CollidingHasher> map;
+	HashMap<int, int> reference;
+
+	ERR_PRINT_OFF; // Excessive collision warnings are expected.
+	for (int i = 0; i < 2000; i++) {
+		int key = (i * 7919) % 500;
+		if (i % 3 == 2) {
+			CHECK(map.erase(key) == reference.erase(key));
+		} else {
+			map.insert(key, i);
+			reference.insert(key, i);
+		}
+	}
+	ERR_PRINT_ON;
+
+	CHECK(map.size() == reference.size());
+	for (int key = 0; key < 500; key++) {
+		const int *value = map.getptr(key);
+		const int *expected = reference.getptr(key);
+		REQUIRE((value == nullptr) == (expected == nullptr));
+		if (value) {
+			CHECK(*value == *expected);
+		}
+	}
+}
+
+TEST_CASE("[SwissHashMap] Reserve avoids rehashing") {
+	SwissHashMap<int, int> map;
+	map.reserve(1000);
+	map.insert(0, 0);
+	const uint32_t capacity = map.get_capacity();
+	for (int i = 1; i < 1000; i++) {
+		map.insert(i, i);
+	}
+	CHECK(map.get_capacity() == capacity);
+	CHECK(map.size() == 1000);
+}
+
+// Benchmarks.
+
+template <typename TKey>
+static TKey make_benchmark_key(int p_index);
+
+template <>
+StringName make_benchmark_key<StringName>(int p_index) {
+	return StringName("key_" + itos(p_index));
+}
+
+template <>
+String make_benchmark_key<String>(int p_index) {
+	return "key_" + itos(p_index);
+}
+
+template <>
+ObjectID make_benchmark_key<ObjectID>(int p_index) {
+	return ObjectID(uint64_t(uint64_t(p_index) * 0x9E3779B97F4A7C15ull));
+}
+
+template <>
+RID make_benchmark_key<RID>(int p_index) {
+	return RID::from_uint64((uint64_t(p_index) << 32) | uint64_t(p_index & 0xFFFF));
+}
+
+template <typename TMap, typename TKey>
+static void benchmark_map(const char *p_map_name, const char *p_key_name, const LocalVector<TKey> &p_keys, const LocalVector<TKey> &p_missing_keys) {
+	const uint32_t lookup_rounds = 10;
+	OS *os = OS::get_singleton();
+	TMap map;
+
+	uint64_t begin = os->get_ticks_usec();
+	for (uint32_t i = 0; i < p_keys.size(); i++) {
+		map.insert(p_keys[i], i);
+	}
+	const uint64_t insert_usec = os->get_ticks_usec() - begin;
+
+	const TMap &const_map = map;
+	uint64_t checksum = 0;
+	begin = os->get_ticks_usec();
+	for (uint32_t round = 0; round < lookup_rounds; round++) {
+		for (const TKey &key : p_keys) {
+			checksum += const_map[key];
+		}
+		for (const TKey &key : p_missing_keys) {
+			checksum += const_map.has(key);
+		}
+	}
+	const uint64_t lookup_usec = os->get_ticks_usec() - begin;
+
+	begin = os->get_ticks_usec();
+	for (uint32_t round = 0; round < lookup_rounds; round++) {
+		for (const KeyValue<TKey, int> &E : map) {
+			checksum += E.value;
+		}
+	}
+	const uint64_t iterate_usec = os->get_ticks_usec() - begin;
+
+	begin = os->get_ticks_usec();
+	for (const TKey &key : p_keys) {
+		map.erase(key);
+	}
+	const uint64_t erase_usec = os->get_ticks_usec() - begin;
+
+	CHECK(map.is_empty());
+	CHECK(checksum > 0);
+
+	print_line(vformat("%-12s %-10s insert: %6d us, lookup x%d: %7d us, iterate x%d: %6d us, erase: %6d us",
+			p_map_name, p_key_name, insert_usec, lookup_rounds, lookup_usec, lookup_rounds, iterate_usec, erase_usec));
+}
+
+template <typename TKey>
+static void benchmark_maps(const char *p_key_name, uint32_t p_count) {
+	LocalVector<TKey> keys;
+	LocalVector<TKey> missing_keys;
+	keys.resize(p_count);
+	missing_keys.resize(p_count);
+	for (uint32_t i = 0; i < p_count; i++) {
+		keys[i] = make_benchmark_key<TKey>(i + 1);
+		missing_keys[i] = make_benchmark_key<TKey>(p_count + i + 1);
+	}
+
+	benchmark_map<HashMap<TKey, int>>("HashMap", p_key_name, keys, missing_keys);
+	benchmark_map<AHashMap<TKey, int>>("AHashMap", p_key_name, keys, missing_keys);
+	benchmark_map<RBMap<TKey, int>>("RBMap", p_key_name, keys, missing_keys);
+	benchmark_map<SwissHashMap<TKey, int>>("SwissHashMap", p_key_name, keys, missing_keys);
+}
+
+TEST_CASE_BENCHMARK("[Benchmark][SwissHashMap] Compare with other maps") {
+	for (uint32_t count : { 100u, 10000u, 200000u }) {
+		print_line(vformat("%d elements:", count));
+		benchmark_maps<StringName>("StringName", count);
+		benchmark_maps<ObjectID>("ObjectID", count);
+		benchmark_maps<RID>("RID", count);
+		benchmark_maps<String>("String", count);
+	}
+}
+
+} // namespace TestSwissHashMap
@@ -679,6 +679,61 @@ TEST_CASE("[Vector] Operators") {
 	CHECK(vector != vector_other);
 }
 
+TEST_CASE("[Vector] External elements") {
+	// Memory owned outside of the vector, with room for the header in front of the elements.
+	alignas(Memory::MAX_ALIGN) uint8_t memory[Vector<int>::EXTERNAL_HEADER_SIZE + 8 * sizeof(int)] = {};
+	int *external = reinterpret_cast<int *>(memory + Vector<int>::EXTERNAL_HEADER_SIZE);
+	for (int i = 0; i < 8; i++) {
+		external[i] = i;
+	}
+
+	Vector<int> vector;
+	REQUIRE(vector.use_external(external, 8) == OK);
+	CHECK(vector.ptr() == external);
+	CHECK(vector.size() == 8);
+	CHECK(vector[5] == 5);
+
+	Vector<int> copy = vector;
+	CHECK(copy.ptr() == external);
+
+	// Modifications fork the elements, external memory is never written to.
+	copy.write[0] = 10;
+	CHECK(copy.ptr() != external);
+	CHECK(copy[0] == 10);
+	CHECK(vector[0] == 0);
+	CHECK(external[0] == 0);
+
+	vector.push_back(8);
+	CHECK(vector.ptr() != external);
+	CHECK(vector.size() == 9);
+	CHECK(vector[8] == 8);
+	CHECK(external[0] == 0);
+
+	// The same elements can be referenced again while in use.
+	Vector<int> other;
+	REQUIRE(other.use_external(external, 8) == OK);
+	Vector<int> other_copy = other;
+	Vector<int> again;
+	REQUIRE(again.use_external(external, 8) == OK);
+	CHECK(again.ptr() == external);
+	CHECK(again == other_copy);
+
+	other.clear();
+	other_copy.clear();
+	again.remove_at(0);
+	CHECK(again.size() == 7);
+	CHECK(again[0] == 1);
+	CHECK(external[0] == 0);
+
+	ERR_PRINT_OFF;
+	// The size must match the existing header.
+	CHECK(other.use_external(external, 7) == ERR_INVALID_DATA);
+	// Elements must be aligned.
+	CHECK(other.use_external(external + 1, 7) == ERR_INVALID_PARAMETER);
+	ERR_PRINT_ON;
+	CHECK(other.is_empty());
+}
+
 struct CyclicVectorHolder {
 	Vector<CyclicVectorHolder> *vector = nullptr;
 	bool is_destructing = false;
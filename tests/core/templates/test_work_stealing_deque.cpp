@@ -0,0 +1,151 @@
+/**************************************************************************/
+/*  test_work_stealing_deque.cpp                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "tests/test_macros.h"
+
+TEST_FORCE_LINK(test_work_stealing_deque)
+
+#include "core/os/thread.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
+#include "core/templates/work_stealing_deque.h"
+
+namespace TestWorkStealingDeque {
+
+TEST_CASE("[WorkStealingDeque] Owner pops in LIFO order, thieves steal in FIFO order") {
+	WorkStealingDeque<uint32_t, 8> deque;
+	CHECK(deque.is_empty());
+
+	for (uint32_t i = 0; i < 4; i++) {
+		CHECK(deque.push(i));
+	}
+	CHECK_FALSE(deque.is_empty());
+
+	uint32_t value = 0;
+	CHECK(deque.steal(value));
+	CHECK(value == 0);
+	CHECK(deque.pop(value));
+	CHECK(value == 3);
+	CHECK(deque.steal(value));
+	CHECK(value == 1);
+	CHECK(deque.pop(value));
+	CHECK(value == 2);
+
+	CHECK(deque.is_empty());
+	CHECK_FALSE(deque.pop(value));
+	CHECK_FALSE(deque.steal(value));
+}
+
+TEST_CASE("[WorkStealingDeque] Push fails when full") {
+	WorkStealingDeque<uint32_t, 4> deque;
+	CHECK(deque.get_capacity() == 4);
+	for (uint32_t i = 0; i < 4; i++) {
+		CHECK(deque.push(i));
+	}
+	CHECK_FALSE(deque.push(4));
+
+	uint32_t value = 0;
+	CHECK(deque.steal(value));
+	CHECK(deque.push(4));
+
+	// Wrapping around the buffer must keep the order.
+	for (uint32_t i = 1; i <= 4; i++) {
+		CHECK(deque.steal(value));
+		CHECK(value == i);
+	}
+	CHECK(deque.is_empty());
+}
+
+#ifdef THREADS_ENABLED
+struct StealData {
+	WorkStealingDeque<uint32_t, 64> deque;
+	SafeFlag done;
+	SafeNumeric<uint64_t> sum;
+	SafeNumeric<uint32_t> count;
+};
+
+static void thief_function(void *p_userdata) {
+	StealData *data = (StealData *)p_userdata;
+	uint32_t value = 0;
+	while (!data->done.is_set()) {
+		if (data->deque.steal(value)) {
+			data->sum.add(value);
+			data->count.increment();
+		}
+	}
+	while (data->deque.steal(value)) {
+		data->sum.add(value);
+		data->count.increment();
+	}
+}
+
+TEST_CASE("[WorkStealingDeque] Every item is taken exactly once with concurrent thieves") {
+	StealData data;
+	data.sum.set(0);
+	data.count.set(0);
+
+	LocalVector<Thread> thieves;
+	thieves.resize(3);
+	for (Thread &thief : thieves) {
+		thief.start(thief_function, &data);
+	}
+
+	const uint32_t items = 100000;
+	uint64_t expected_sum = 0;
+	uint32_t value = 0;
+	for (uint32_t i = 1; i <= items; i++) {
+		expected_sum += i;
+		while (!data.deque.push(i)) {
+			if (data.deque.pop(value)) {
+				data.sum.add(value);
+				data.count.increment();
+			}
+		}
+		if (i % 3 == 0 && data.deque.pop(value)) {
+			data.sum.add(value);
+			data.count.increment();
+		}
+	}
+	while (data.deque.pop(value)) {
+		data.sum.add(value);
+		data.count.increment();
+	}
+
+	data.done.set();
+	for (Thread &thief : thieves) {
+		thief.wait_to_finish();
+	}
+
+	CHECK(data.count.get() == items);
+	CHECK(data.sum.get() == expected_sum);
+}
+#endif // THREADS_ENABLED
+
+} // namespace TestWorkStealingDeque
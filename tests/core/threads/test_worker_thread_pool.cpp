@@ -174,4 +174,203 @@ TEST_CASE("[WorkerThreadPool] Run a yielding daemon as the only hope for other t
 	CHECK_MESSAGE(all_needed_yield, "All legit tasks should have needed the daemon yielding to run.");
 }
 
+struct NestedTasksData {
+	WorkerThreadPool *pool = nullptr;
+	uint32_t children = 0;
+	SafeNumeric<uint32_t> processed;
+};
+
+static void static_nested_child_task(void *p_arg) {
+	NestedTasksData *data = (NestedTasksData *)p_arg;
+	data->processed.increment();
+}
+
+static void static_nested_parent_task(void *p_arg) {
+	NestedTasksData *data = (NestedTasksData *)p_arg;
+	WorkerThreadPool::TaskID *child_ids = (WorkerThreadPool::TaskID *)alloca(sizeof(WorkerThreadPool::TaskID) * data->children);
+	for (uint32_t i = 0; i < data->children; i++) {
+		child_ids[i] = data->pool->add_native_task(static_nested_child_task, data, true);
+	}
+	for (uint32_t i = 0; i < data->children; i++) {
+		data->pool->wait_for_task_completion(child_ids[i]);
+	}
+	data->processed.increment();
+}
+
+struct CounterGroupData {
+	WorkerThreadPool *pool = nullptr;
+	SafeNumeric<uint32_t> processed;
+};
+
+static void static_counter_task(void *p_arg) {
+	CounterGroupData *data = (CounterGroupData *)p_arg;
+	data->processed.increment();
+}
+
+static void static_group_spawning_task(void *p_arg, uint32_t p_index) {
+	CounterGroupData *data = (CounterGroupData *)p_arg;
+	WorkerThreadPool::TaskID ids[8];
+	for (uint32_t i = 0; i < 8; i++) {
+		ids[i] = data->pool->add_native_task(static_counter_task, data, true);
+	}
+	for (uint32_t i = 0; i < 8; i++) {
+		data->pool->wait_for_task_completion(ids[i]);
+	}
+	data->processed.increment();
+}
+
+// Returns the time taken, in microseconds.
+static uint64_t run_nested_tasks(WorkerThreadPool *p_pool, uint32_t p_parents, uint32_t p_children, uint32_t &r_processed) {
+	NestedTasksData data;
+	data.pool = p_pool;
+	data.children = p_children;
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	LocalVector<WorkerThreadPool::TaskID> parent_ids;
+	parent_ids.resize(p_parents);
+	for (uint32_t i = 0; i < p_parents; i++) {
+		parent_ids[i] = p_pool->add_native_task(static_nested_parent_task, &data, true);
+	}
+	for (uint32_t i = 0; i < p_parents; i++) {
+		p_pool->wait_for_task_completion(parent_ids[i]);
+	}
+	uint64_t end = OS::get_singleton()->get_ticks_usec();
+
+	r_processed = data.processed.get();
+	return end - begin;
+}
+
+TEST_CASE("[WorkerThreadPool] Work-stealing mode runs nested tasks") {
+	WorkerThreadPool *pool = memnew(WorkerThreadPool(false));
+	pool->init(4, 0.3, true);
+	CHECK(pool->is_work_stealing());
+
+	const uint32_t parents = 64;
+	const uint32_t children = 600; // More than fits in a local queue, to exercise spilling over to the global one.
+	uint32_t processed = 0;
+	run_nested_tasks(pool, parents, children, processed);
+	CHECK_MESSAGE(processed == parents * (children + 1), "All parent and child tasks should have run exactly once.");
+
+	CounterGroupData group_data;
+	group_data.pool = pool;
+	WorkerThreadPool::GroupID group = pool->add_native_group_task(static_group_spawning_task, &group_data, 32, -1, true);
+	pool->wait_for_group_task_completion(group);
+	CHECK_MESSAGE(group_data.processed.get() == 32 * 9, "All group elements and the tasks they posted should have run exactly once.");
+
+	memdelete(pool);
+}
+
+struct GraphOrderData {
+	SafeNumeric<uint32_t> sequence;
+	uint32_t order[4] = {};
+};
+
+template <uint32_t Index>
+static void static_graph_node(void *p_arg) {
+	GraphOrderData *data = (GraphOrderData *)p_arg;
+	data->order[Index] = data->sequence.increment();
+}
+
+TEST_CASE("[WorkerThreadPool] Task graph runs nodes after their dependencies") {
+	GraphOrderData data;
+
+	// Diamond: 0 -> (1, 2) -> 3.
+	WorkerThreadPool::TaskGraph graph;
+	WorkerThreadPool::TaskGraph::NodeID a = graph.add_native_node(static_graph_node<0>, &data, "A");
+	WorkerThreadPool::TaskGraph::NodeID b = graph.add_native_node(static_graph_node<1>, &data, "B");
+	WorkerThreadPool::TaskGraph::NodeID c = graph.add_native_node(static_graph_node<2>, &data, "C");
+	WorkerThreadPool::TaskGraph::NodeID d = graph.add_native_node(static_graph_node<3>, &data, "D");
+	graph.depends_on(b, a);
+	graph.depends_on(c, a);
+	graph.depends_on(d, b);
+	graph.depends_on(d, c);
+	CHECK(graph.get_node_count() == 4);
+	CHECK(graph.get_node_description(c) == "C");
+
+	for (int run = 0; run < 100; run++) {
+		data.sequence.set(0);
+		graph.submit(run % 2);
+		graph.wait();
+		CHECK(graph.is_completed());
+
+		CHECK(data.sequence.get() == 4);
+		CHECK(data.order[a] == 1);
+		CHECK(data.order[b] < data.order[d]);
+		CHECK(data.order[c] < data.order[d]);
+		CHECK(data.order[d] == 4);
+		CHECK(graph.get_node_start_usec(d) >= graph.get_node_start_usec(a) + graph.get_node_time_usec(a));
+	}
+}
+
+TEST_CASE("[WorkerThreadPool] Task graph rejects cycles") {
+	GraphOrderData data;
+	WorkerThreadPool::TaskGraph graph;
+	WorkerThreadPool::TaskGraph::NodeID a = graph.add_native_node(static_graph_node<0>, &data);
+	WorkerThreadPool::TaskGraph::NodeID b = graph.add_native_node(static_graph_node<1>, &data);
+	WorkerThreadPool::TaskGraph::NodeID c = graph.add_native_node(static_graph_node<2>, &data);
+	graph.depends_on(b, a);
+	graph.depends_on(c, b);
+
+	ERR_PRINT_OFF;
+	graph.depends_on(a, c);
+	graph.depends_on(a, a);
+	ERR_PRINT_ON;
+
+	graph.submit();
+	graph.wait();
+	CHECK(data.sequence.get() == 3);
+	CHECK(data.order[a] == 1);
+	CHECK(data.order[b] == 2);
+	CHECK(data.order[c] == 3);
+}
+
+static void static_subgraph_node(void *p_arg) {
+	GraphOrderData *data = (GraphOrderData *)p_arg;
+
+	// Waiting from a pool thread must be collaborative.
+	WorkerThreadPool::TaskGraph subgraph;
+	WorkerThreadPool::TaskGraph::NodeID first = subgraph.add_native_node(static_graph_node<1>, data);
+	WorkerThreadPool::TaskGraph::NodeID second = subgraph.add_native_node(static_graph_node<2>, data);
+	subgraph.depends_on(second, first);
+	subgraph.submit();
+	subgraph.wait();
+}
+
+TEST_CASE("[WorkerThreadPool] Task graph can be awaited from a node") {
+	GraphOrderData data;
+	WorkerThreadPool::TaskGraph graph;
+	WorkerThreadPool::TaskGraph::NodeID outer = graph.add_native_node(static_subgraph_node, &data);
+	WorkerThreadPool::TaskGraph::NodeID last = graph.add_native_node(static_graph_node<3>, &data);
+	graph.depends_on(last, outer);
+	graph.submit();
+	graph.wait();
+
+	CHECK(data.sequence.get() == 3);
+	CHECK(data.order[1] == 1);
+	CHECK(data.order[2] == 2);
+	CHECK(data.order[3] == 3);
+}
+
+TEST_CASE_BENCHMARK("[Benchmark][WorkerThreadPool] Nested task throughput, shared queue vs. work stealing") {
+	const uint32_t parents = 64;
+	const uint32_t children = 512;
+	const int max_threads = OS::get_singleton()->get_processor_count();
+
+	for (int thread_count = 1; thread_count <= max_threads; thread_count *= 2) {
+		for (int work_stealing = 0; work_stealing < 2; work_stealing++) {
+			WorkerThreadPool *pool = memnew(WorkerThreadPool(false));
+			pool->init(thread_count, 0.3, work_stealing);
+
+			uint32_t processed = 0;
+			uint64_t usec = run_nested_tasks(pool, parents, children, processed);
+			CHECK(processed == parents * (children + 1));
+
+			double tasks_per_sec = processed / MAX(usec / 1000000.0, 0.000001);
+			print_line(vformat("%2d threads, %-13s: %.3f ms, %.0f tasks/s", thread_count, work_stealing ? "work stealing" : "shared queue", usec / 1000.0, tasks_per_sec));
+
+			memdelete(pool);
+		}
+	}
+}
+
 } // namespace TestWorkerThreadPool
@@ -32,6 +32,8 @@
 
 TEST_FORCE_LINK(test_variant)
 
+#include "core/object/worker_thread_pool.h"
+#include "core/os/os.h"
 #include "core/variant/variant.h"
 #include "core/variant/variant_parser.h"
 
@@ -2246,4 +2248,147 @@ TEST_CASE("[Variant] Operator NOT") {
 	}
 }
 
+struct BoxedVariantData {
+	// One vector per task, filled by that task and destroyed on another thread.
+	LocalVector<LocalVector<Variant>> values;
+	uint32_t count = 0;
+
+	static Variant make_boxed(uint32_t p_task, uint32_t p_index) {
+		const real_t f = p_task * 100000 + p_index;
+		switch (p_index % 5) {
+			case 0:
+				return Transform2D(f, Vector2(f, -f));
+			case 1:
+				return AABB(Vector3(f, f, f), Vector3(1, 2, 3));
+			case 2:
+				return Basis(Vector3(f, 0, 0), Vector3(0, f, 0), Vector3(0, 0, f));
+			case 3:
+				return Transform3D(Basis(), Vector3(f, -f, f));
+			default:
+				return Projection(Vector4(f, 0, 0, 0), Vector4(0, f, 0, 0), Vector4(0, 0, f, 0), Vector4(0, 0, 0, f));
+		}
+	}
+
+	void fill(uint32_t p_task, void *p_userdata) {
+		LocalVector<Variant> &task_values = values[p_task];
+		// Free the values another task created in the previous round.
+		task_values.clear();
+		for (uint32_t i = 0; i < count; i++) {
+			task_values.push_back(make_boxed(p_task, i));
+		}
+	}
+};
+
+TEST_CASE("[Variant] Boxed math types allocated and freed on different threads") {
+	WorkerThreadPool *pool = memnew(WorkerThreadPool(false));
+	pool->init(MAX(4, OS::get_singleton()->get_processor_count()));
+	const uint32_t tasks = 8;
+
+	BoxedVariantData data;
+	data.values.resize(tasks);
+	data.count = 1000;
+
+	for (int round = 0; round < 4; round++) {
+		WorkerThreadPool::GroupID group = pool->add_template_group_task(&data, &BoxedVariantData::fill, (void *)nullptr, tasks, tasks, true);
+		pool->wait_for_group_task_completion(group);
+
+		bool all_equal = true;
+		for (uint32_t t = 0; t < tasks; t++) {
+			for (uint32_t i = 0; i < data.count; i++) {
+				all_equal = all_equal && data.values[t][i] == BoxedVariantData::make_boxed(t, i);
+			}
+		}
+		CHECK(all_equal);
+
+		// Rotate ownership so the next round frees the values on different threads than they were created on.
+		LocalVector<Variant> first = std::move(data.values[0]);
+		for (uint32_t t = 0; t < tasks - 1; t++) {
+			data.values[t] = std::move(data.values[t + 1]);
+		}
+		data.values[tasks - 1] = std::move(first);
+	}
+
+	data.values.clear();
+	memdelete(pool);
+}
+
+TEST_CASE_BENCHMARK("[Benchmark][Variant] Construct, copy and destroy by type") {
+	const uint32_t count = 100000;
+	LocalVector<Variant> values;
+	LocalVector<Variant> copies;
+	values.resize(count);
+	copies.resize(count);
+
+	for (int type = 0; type < Variant::VARIANT_MAX; type++) {
+		Callable::CallError ce;
+
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (uint32_t i = 0; i < count; i++) {
+			Variant::construct(Variant::Type(type), values[i], nullptr, 0, ce);
+		}
+		const uint64_t construct_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+		begin = OS::get_singleton()->get_ticks_usec();
+		for (uint32_t i = 0; i < count; i++) {
+			copies[i] = values[i];
+		}
+		const uint64_t copy_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+		begin = OS::get_singleton()->get_ticks_usec();
+		for (uint32_t i = 0; i < count; i++) {
+			values[i] = Variant();
+			copies[i] = Variant();
+		}
+		const uint64_t destroy_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+		print_line(vformat("%-20s construct: %6.2f ns, copy: %6.2f ns, destroy: %6.2f ns", Variant::get_type_name(Variant::Type(type)),
+				construct_usec * 1000.0 / count, copy_usec * 1000.0 / count, destroy_usec * 500.0 / count));
+	}
+}
+
+struct BoxedChurnData {
+	uint32_t iterations = 0;
+
+	void churn(uint32_t p_index, void *p_userdata) {
+		Variant values[16];
+		for (uint32_t i = 0; i < iterations; i++) {
+			Variant &v = values[i & 15];
+			switch (i % 3) {
+				case 0:
+					v = Transform3D(Basis(), Vector3(i, 0, 0));
+					break;
+				case 1:
+					v = AABB(Vector3(i, 0, 0), Vector3(1, 1, 1));
+					break;
+				default:
+					v = Projection();
+					break;
+			}
+			Variant copy = v;
+		}
+	}
+};
+
+TEST_CASE_BENCHMARK("[Benchmark][Variant] Boxed math type churn by thread count") {
+	const int max_threads = OS::get_singleton()->get_processor_count();
+	BoxedChurnData data;
+	data.iterations = 1000000;
+
+	for (int thread_count = 1; thread_count <= max_threads; thread_count *= 2) {
+		WorkerThreadPool *pool = memnew(WorkerThreadPool(false));
+		pool->init(thread_count);
+
+		const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		WorkerThreadPool::GroupID group = pool->add_template_group_task(&data, &BoxedChurnData::churn, (void *)nullptr, thread_count, thread_count, true);
+		pool->wait_for_group_task_completion(group);
+		const uint64_t usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+		// Each iteration allocates two blocks (the value and its copy).
+		const double allocs = 2.0 * data.iterations * thread_count;
+		print_line(vformat("%2d threads: %.3f ms, %.2f M allocations/s", thread_count, usec / 1000.0, allocs / MAX(usec, uint64_t(1))));
+
+		memdelete(pool);
+	}
+}
+
 } // namespace TestVariant